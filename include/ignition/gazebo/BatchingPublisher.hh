@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_BATCHINGPUBLISHER_HH_
+#define IGNITION_GAZEBO_BATCHINGPUBLISHER_HH_
+
+#include <google/protobuf/message.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <ignition/transport/Node.hh>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class BatchingPublisherPrivate;
+    class BatchSubscriberPrivate;
+
+    /// \brief A publisher that coalesces messages within a time window
+    /// into one envelope, amortizing per-publish serialization and
+    /// syscall overhead for systems that publish many small messages
+    /// per step, such as joint states or odometry. The envelope goes
+    /// out on `<topic>/batched` and is split back into individual
+    /// messages by BatchSubscriber on the receiving side.
+    ///
+    /// The window is checked on each call to Publish, so messages are
+    /// delayed by at most one window as long as publishing continues.
+    /// Remaining messages are flushed on destruction.
+    class IGNITION_GAZEBO_VISIBLE BatchingPublisher
+    {
+      /// \brief Constructor. The publisher is inactive until Init is
+      /// called.
+      public: BatchingPublisher();
+
+      /// \brief Destructor. Flushes any batched messages.
+      public: ~BatchingPublisher();
+
+      /// \brief Advertise the batch topic.
+      /// \param[in] _node Node to advertise on. Must outlive this
+      /// publisher.
+      /// \param[in] _topic Base topic; the envelope is published on
+      /// `<topic>/batched`.
+      /// \param[in] _msgType Fully qualified type of the batched
+      /// messages, e.g. "ignition.msgs.Model".
+      /// \param[in] _window How long messages may wait before the
+      /// batch is flushed.
+      /// \return True if the topic was advertised.
+      public: bool Init(transport::Node &_node, const std::string &_topic,
+                  const std::string &_msgType,
+                  const std::chrono::steady_clock::duration &_window);
+
+      /// \brief Append a message to the current batch, flushing the
+      /// batch first if the window has expired.
+      /// \param[in] _msg Message to publish.
+      public: void Publish(const google::protobuf::Message &_msg);
+
+      /// \brief Publish the current batch, if any.
+      public: void Flush();
+
+      /// \brief Get whether Init succeeded.
+      /// \return True if the batch topic was advertised.
+      public: bool Valid() const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<BatchingPublisherPrivate> dataPtr;
+    };
+
+    /// \brief Splits the envelopes published by BatchingPublisher back
+    /// into individual messages. The callback receives the messages in
+    /// publish order; use msgs::Factory or a dynamic_cast to recover
+    /// the concrete type.
+    class IGNITION_GAZEBO_VISIBLE BatchSubscriber
+    {
+      /// \brief Callback invoked once per batched message.
+      public: using Callback =
+          std::function<void(const google::protobuf::Message &)>;
+
+      /// \brief Constructor. The subscriber is inactive until Init is
+      /// called.
+      public: BatchSubscriber();
+
+      /// \brief Destructor.
+      public: ~BatchSubscriber();
+
+      /// \brief Subscribe to a batch topic.
+      /// \param[in] _node Node to subscribe on. Must outlive this
+      /// subscriber.
+      /// \param[in] _topic Base topic; subscribes to `<topic>/batched`.
+      /// \param[in] _cb Callback invoked once per batched message, from
+      /// the transport callback thread.
+      /// \return True if the subscription succeeded.
+      public: bool Init(transport::Node &_node, const std::string &_topic,
+                  Callback _cb);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<BatchSubscriberPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_BOUNDEDPUBLISHER_HH_
+#define IGNITION_GAZEBO_BOUNDEDPUBLISHER_HH_
+
+#include <google/protobuf/message.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <ignition/transport/AdvertiseOptions.hh>
+#include <ignition/transport/Node.hh>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class BoundedPublisherPrivate;
+
+    /// \brief A publisher with a bounded queue between the producer
+    /// and the transport write, so a stalled or slow subscriber costs
+    /// a fixed amount of memory instead of growing buffers without
+    /// limit. Publish copies the message into the queue and returns; a
+    /// worker thread hands the queued messages to the transport in
+    /// order. When the queue is full, messages are dropped according
+    /// to the configured policy and counted, trading completeness for
+    /// memory stability on live topics.
+    class IGNITION_GAZEBO_VISIBLE BoundedPublisher
+    {
+      /// \brief What to do with queued messages when the queue is
+      /// full.
+      public: enum class DropPolicy
+      {
+        /// \brief Drop the oldest queued message to make room. Suits
+        /// streams where every sample has some value but fresh ones
+        /// matter more, such as images.
+        kDropOldest,
+
+        /// \brief Drop every queued message and keep only the new
+        /// one. Suits streams where only the latest value matters,
+        /// such as poses.
+        kCoalesce,
+      };
+
+      /// \brief Constructor. The publisher is inactive until Init is
+      /// called.
+      public: BoundedPublisher();
+
+      /// \brief Destructor. Queued messages are handed to the
+      /// transport before the worker stops.
+      public: ~BoundedPublisher();
+
+      /// \brief Advertise the topic and start the worker.
+      /// \param[in] _node Node to advertise on. Must outlive this
+      /// publisher.
+      /// \param[in] _topic Topic to advertise.
+      /// \param[in] _depth Maximum number of queued messages; at
+      /// least one.
+      /// \param[in] _policy What to do when the queue is full.
+      /// \param[in] _opts Advertise options.
+      /// \return True if the topic was advertised.
+      public: template <typename MsgT>
+              bool Init(transport::Node &_node, const std::string &_topic,
+                  std::size_t _depth, DropPolicy _policy,
+                  const transport::AdvertiseMessageOptions &_opts =
+                      transport::AdvertiseMessageOptions())
+      {
+        return this->InitImpl(_node.Advertise<MsgT>(_topic, _opts),
+            _depth, _policy);
+      }
+
+      /// \brief Queue a message for publication. The message is
+      /// copied; the caller keeps ownership of _msg. Never blocks on
+      /// the transport.
+      /// \param[in] _msg Message to publish. Must be of the type the
+      /// topic was advertised with.
+      public: void Publish(const google::protobuf::Message &_msg);
+
+      /// \brief Get whether the topic has subscribers.
+      /// \return True if there is at least one subscriber.
+      public: bool HasConnections() const;
+
+      /// \brief Get whether Init succeeded.
+      /// \return True if the topic was advertised.
+      public: bool Valid() const;
+
+      /// \brief Get the number of messages this publisher dropped.
+      /// \return The drop count.
+      public: uint64_t DroppedCount() const;
+
+      /// \brief Get the number of messages dropped by every
+      /// BoundedPublisher in the process, including destroyed ones.
+      /// \return The process-wide drop count.
+      public: static uint64_t TotalDroppedCount();
+
+      /// \brief Advertise the topic and start the worker.
+      /// \param[in] _pub The advertised publisher.
+      /// \param[in] _depth Maximum number of queued messages.
+      /// \param[in] _policy What to do when the queue is full.
+      /// \return True if the topic was advertised.
+      private: bool InitImpl(transport::Node::Publisher _pub,
+          std::size_t _depth, DropPolicy _policy);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<BoundedPublisherPrivate> dataPtr;
+    };
+    }  // namespace IGNITION_GAZEBO_VERSION_NAMESPACE
+  }  // namespace gazebo
+}  // namespace ignition
+
+#endif  // IGNITION_GAZEBO_BOUNDEDPUBLISHER_HH_
@@ -78,6 +78,20 @@ namespace ignition
     /// \param[in] _in Chrono duration object.
     void set(msgs::Time *_msg, const std::chrono::steady_clock::duration &_in);
 
+    /// \brief Helper function that sets a mutable msgs::Geometry object
+    /// to the values contained in a sdf::Geometry object. Useful to fill
+    /// a preallocated message in place instead of copying a temporary.
+    /// \param[out] _msg Geometry message to set.
+    /// \param[in] _in SDF geometry object.
+    void set(msgs::Geometry *_msg, const sdf::Geometry &_in);
+
+    /// \brief Helper function that sets a mutable msgs::Inertial object
+    /// to the values contained in a math::Inertiald object. Useful to fill
+    /// a preallocated message in place instead of copying a temporary.
+    /// \param[out] _msg Inertial message to set.
+    /// \param[in] _in Math inertial object.
+    void set(msgs::Inertial *_msg, const math::Inertiald &_in);
+
     /// \brief Generic conversion from an SDF geometry to another type.
     /// \param[in] _in SDF geometry.
     /// \return Conversion result.
@@ -20,8 +20,10 @@
 #include <ignition/msgs/serialized.pb.h>
 #include <ignition/msgs/serialized_map.pb.h>
 
+#include <chrono>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <typeinfo>
@@ -32,6 +34,7 @@
 
 #include <ignition/common/Console.hh>
 #include <ignition/math/graph/Graph.hh>
+#include <ignition/math/Pose3.hh>
 #include "ignition/gazebo/Entity.hh"
 #include "ignition/gazebo/Export.hh"
 #include "ignition/gazebo/Types.hh"
@@ -77,6 +80,17 @@ namespace ignition
       /// \return Entity count.
       public: size_t EntityCount() const;
 
+      /// \brief Get the generation of an entity slot. Entity ids are
+      /// recycled after removal, and a slot's generation is incremented
+      /// each time its id is reused. A system that holds an entity id
+      /// across simulation steps can compare generations to detect that
+      /// the id now refers to a different entity.
+      /// \param[in] _entity The entity.
+      /// \return The slot's current generation. The generation starts at
+      /// zero the first time an id is used; zero is also returned for ids
+      /// that have never been used.
+      public: uint64_t EntityGeneration(const Entity _entity) const;
+
       /// \brief Request an entity deletion. This will insert the request
       /// into a queue. The queue is processed toward the end of a simulation
       /// update step.
@@ -96,6 +110,20 @@ namespace ignition
       /// update step.
       public: void RequestRemoveEntities();
 
+      /// \brief Set the maximum number of removed entities that are
+      /// destroyed per update step. Entities over the budget are hidden
+      /// from Each views immediately but keep their storage until a later
+      /// step, so large removals (e.g. a level unloading) don't spike a
+      /// single step.
+      /// \param[in] _budget Entities destroyed per step. Zero, the
+      /// default, destroys all removed entities in the same step.
+      public: void SetRemovalBudget(uint64_t _budget);
+
+      /// \brief Get the maximum number of removed entities that are
+      /// destroyed per update step.
+      /// \return Entities destroyed per step, zero meaning unlimited.
+      public: uint64_t RemovalBudget() const;
+
       /// \brief Get whether an Entity exists.
       /// \param[in] _entity Entity to confirm.
       /// \return True if the Entity exists.
@@ -184,6 +212,18 @@ namespace ignition
               ComponentKey CreateComponent(const Entity _entity,
                   const ComponentTypeT &_data);
 
+      /// \brief Create several components for an entity in one call. Each
+      /// _data parameter is copied, like with CreateComponent. The views
+      /// are updated once for the whole batch rather than once per
+      /// component, which makes this the preferred way to attach an
+      /// entity's initial set of components during world loading.
+      /// \param[in] _entity The entity that will be associated with
+      /// the components.
+      /// \param[in] _data Data used to construct the components.
+      public: template<typename... ComponentTypeTs>
+              void CreateComponents(const Entity _entity,
+                  const ComponentTypeTs &..._data);
+
       /// \brief Get a component assigned to an entity based on a
       /// component type.
       /// \param[in] _entity The entity.
@@ -263,6 +303,32 @@ namespace ignition
               std::vector<Entity> EntitiesByComponents(
                    const ComponentTypeTs &..._desiredComponents) const;
 
+      /// \brief Get all entities which have a name component equal to the
+      /// given name. The lookup goes through a hash index maintained by
+      /// the component create/remove paths, so it is constant time in the
+      /// number of entities. Names are not unique across scopes, so more
+      /// than one entity can match; the result is unordered.
+      /// \param[in] _name The name to look up.
+      /// \return All matching entities, or an empty vector if no entity
+      /// has a name component with that value.
+      public: std::vector<Entity> EntitiesByName(
+                  const std::string &_name) const;
+
+      /// \brief Get the scoped name chain of an entity: the (type prefix,
+      /// name) pairs from the root of the tree down to the entity itself,
+      /// where the type prefix is one of "world", "model", "light", "link",
+      /// "collision", "visual", "joint" or "sensor". Chains are cached, so
+      /// repeated lookups cost a single hash probe; the cache is
+      /// invalidated when entities are renamed, reparented or removed.
+      /// Levels whose entity type is not known are skipped, and the walk
+      /// up the tree stops at the first entity without a name component.
+      /// \param[in] _entity Entity to get the chain for.
+      /// \return Pairs of type prefix and entity name, ordered from the
+      /// root of the tree down to _entity. The reference stays valid until
+      /// the next invalidating change to the manager.
+      public: const std::vector<std::pair<std::string, std::string>>
+              &ScopedNameChain(const Entity _entity) const;
+
       /// \brief Get all entities which match the value of all the given
       /// components and are immediate children of a given parent entity.
       /// For example, the following will return a child of entity `parent`
@@ -354,6 +420,119 @@ namespace ignition
                   bool(const Entity &_entity,
                        ComponentTypeTs *...)>>::type _f);
 
+      /// \brief A version of Each() that skips entities belonging to
+      /// levels which are loaded only as buffer zones. Systems opt in by
+      /// calling this instead of Each() when buffered entities don't need
+      /// to be updated at full rate, e.g. force generators like wind.
+      /// When level streaming is not used, this behaves exactly like
+      /// Each().
+      /// \param[in] _f Callback function to be called for each matching
+      /// entity. The callback function can return false to stop
+      /// subsequent calls to the callback, otherwise a true value should
+      /// be returned.
+      /// \tparam ComponentTypeTs All the desired component types.
+      /// \warning This function should not be called outside of System's
+      /// PreUpdate, Update, or PostUpdate callbacks.
+      /// \sa SetEntityLevelBuffered
+      public: template<typename ...ComponentTypeTs>
+              void EachActive(typename identity<std::function<
+                  bool(const Entity &_entity,
+                       const ComponentTypeTs *...)>>::type _f) const;
+
+      /// \brief A version of Each() with mutable component access that
+      /// skips entities belonging to levels which are loaded only as
+      /// buffer zones. See the const overload for details.
+      /// \param[in] _f Callback function to be called for each matching
+      /// entity.
+      /// \tparam ComponentTypeTs All the desired mutable component types.
+      /// \warning This function should not be called outside of System's
+      /// PreUpdate, Update, or PostUpdate callbacks.
+      public: template<typename ...ComponentTypeTs>
+              void EachActive(typename identity<std::function<
+                  bool(const Entity &_entity,
+                       ComponentTypeTs *...)>>::type _f);
+
+      /// \brief Flag an entity as belonging only to levels that are
+      /// loaded as buffer zones. Buffered entities are still part of the
+      /// simulation and are visited by Each(), but they are skipped by
+      /// EachActive(). The level manager maintains this flag as
+      /// performers move between levels.
+      /// \param[in] _entity Entity to flag.
+      /// \param[in] _buffered True if the entity is only reachable
+      /// through level buffers, false once a performer's level contains
+      /// it again.
+      public: void SetEntityLevelBuffered(Entity _entity, bool _buffered);
+
+      /// \brief Get whether an entity belongs only to levels loaded as
+      /// buffer zones.
+      /// \param[in] _entity Entity to check.
+      /// \return True if the entity is currently flagged as buffered.
+      public: bool EntityLevelBuffered(Entity _entity) const;
+
+      /// \brief Bulk iteration over every component of a single type, in
+      /// the order the components are laid out in the type's contiguous
+      /// storage. This is the cache-friendly path for passes that touch
+      /// one hot component type on most entities, such as pose write-back
+      /// and pose message assembly: the components are visited as a
+      /// linear sweep of one array instead of per-entity lookups.
+      /// \param[in] _f Callback function called with the owning entity
+      /// and the component. The callback can return false to stop
+      /// subsequent calls, otherwise a true value should be returned.
+      /// \tparam ComponentTypeT The desired component type.
+      /// \note Unlike Each(), components are visited in storage order,
+      /// not entity order.
+      public: template<typename ComponentTypeT>
+              void EachComponent(typename identity<std::function<
+                  bool(const Entity &_entity,
+                       const ComponentTypeT &)>>::type _f) const;
+
+      /// \brief Bulk iteration over every component of a single type,
+      /// with mutable access. See the const overload for details. The
+      /// caller is responsible for calling SetChanged on entities whose
+      /// component it modifies.
+      /// \param[in] _f Callback function called with the owning entity
+      /// and the component.
+      /// \tparam ComponentTypeT The desired mutable component type.
+      public: template<typename ComponentTypeT>
+              void EachComponent(typename identity<std::function<
+                  bool(const Entity &_entity,
+                       ComponentTypeT &)>>::type _f);
+
+      /// \brief A parallel version of Each(). The set of entities that
+      /// contain the given component types is partitioned into roughly
+      /// equal ranges, and the ranges are processed concurrently on a
+      /// worker pool.
+      /// \param[in] _f Callback function to be called for each matching
+      /// entity. Unlike Each(), the callback cannot stop iteration early,
+      /// so it returns void.
+      /// \tparam ComponentTypeTs All the desired component types.
+      /// \warning The callback is invoked concurrently from multiple
+      /// threads. It must not create or remove entities or components, and
+      /// it must not read or write components of entities other than the
+      /// one it was invoked with. Read-only access to the components passed
+      /// to the callback is always safe; writes are safe because each
+      /// entity is visited by exactly one thread.
+      /// \warning This function should not be called outside of System's
+      /// PreUpdate, Update, or PostUpdate callbacks.
+      public: template<typename ...ComponentTypeTs>
+              void EachParallel(typename identity<std::function<
+                  void(const Entity &_entity,
+                       const ComponentTypeTs *...)>>::type _f) const;
+
+      /// \brief A parallel version of Each() with mutable component access.
+      /// See the const overload for the threading contract. Use
+      /// SetChangedParallel to flag modified components from inside the
+      /// callback; SetChanged itself is not safe to call concurrently.
+      /// \param[in] _f Callback function to be called for each matching
+      /// entity.
+      /// \tparam ComponentTypeTs All the desired mutable component types.
+      /// \warning This function should not be called outside of System's
+      /// PreUpdate, Update, or PostUpdate callbacks.
+      public: template<typename ...ComponentTypeTs>
+              void EachParallel(typename identity<std::function<
+                  void(const Entity &_entity,
+                       ComponentTypeTs *...)>>::type _f);
+
       /// \brief Call a function for each parameter in a pack.
       /// \param[in] _f Function to be called.
       /// \param[in] _components Parameters which should be passed to the
@@ -448,10 +627,83 @@ namespace ignition
       /// responsibility of the caller to timestamp it before use.
       public: msgs::SerializedState ChangedState() const;
 
+      /// \brief Get the approximate number of bytes held by each component
+      /// storage, including reserved capacity and id map overhead. Heap
+      /// memory owned by individual components (strings, messages) is not
+      /// counted.
+      /// \return Map of component type id to bytes held, and number of
+      /// component instances, for that type.
+      public: std::map<ComponentTypeId, std::pair<std::size_t, std::size_t>>
+          StorageMemory() const;
+
+      /// \brief Get the approximate number of bytes held by each Each
+      /// query view, keyed by the set of component types the view matches.
+      /// \return Map of view key to bytes held by that view.
+      public: std::map<std::set<ComponentTypeId>, std::size_t>
+          ViewMemory() const;
+
+      /// \brief Cumulative counts of structural change processed by
+      /// this manager since construction. The counters only ever grow;
+      /// consumers interested in per-step churn keep the previous
+      /// totals and subtract.
+      public: struct ChurnCounters
+      {
+        /// \brief Number of entities created.
+        public: uint64_t entitiesCreated{0};
+
+        /// \brief Number of entities destroyed, counted when their
+        /// removal request is processed.
+        public: uint64_t entitiesRemoved{0};
+
+        /// \brief Number of components created.
+        public: uint64_t componentsCreated{0};
+
+        /// \brief Number of components removed.
+        public: uint64_t componentsRemoved{0};
+
+        /// \brief Number of view membership refreshes: one per view
+        /// examined for an entity change or during a full rebuild.
+        public: uint64_t viewsUpdated{0};
+      };
+
+      /// \brief Get the cumulative churn counters, so RTF dips can be
+      /// correlated with level loads, spawn bursts or component churn
+      /// without attaching a profiler.
+      /// \return Snapshot of the counters.
+      public: ChurnCounters Churn() const;
+
+      /// \brief Get cumulative component churn by type.
+      /// \return Map of component type id to number of components of
+      /// that type created and removed.
+      public: std::map<ComponentTypeId, std::pair<uint64_t, uint64_t>>
+          ComponentChurn() const;
+
       /// \brief Get whether there are new entities.
       /// \return True if there are new entities.
       public: bool HasNewEntities() const;
 
+      /// \brief Get the number of entities created since the newly
+      /// created entity list was last cleared, i.e. during the current
+      /// simulation step.
+      /// \return Number of new entities.
+      public: size_t NewEntityCount() const;
+
+      /// \brief Get the entities created since the newly created entity
+      /// list was last cleared, i.e. during the current simulation step.
+      /// \return The new entities.
+      public: std::set<Entity> NewEntities() const;
+
+      /// \brief Get the entities currently marked to be removed. When
+      /// removal of all entities was requested, every current entity is
+      /// returned.
+      /// \return The entities marked for removal.
+      public: std::set<Entity> EntitiesMarkedForRemoval() const;
+
+      /// \brief Get the number of entities currently marked to be
+      /// removed.
+      /// \return Number of entities marked for removal.
+      public: size_t MarkedForRemovalCount() const;
+
       /// \brief Get whether there are any entities marked to be removed.
       /// \return True if there are entities marked to be removed.
       public: bool HasEntitiesMarkedForRemoval() const;
@@ -481,6 +733,9 @@ namespace ignition
       /// to get all components.
       /// \param[in] _full True to get all the entities and components.
       /// False will get only components and entities that have changed.
+      /// \detail When _full is false, _entities is empty and _types is
+      /// given, only the entities flagged by the dirty trackers are
+      /// visited, so the cost is proportional to the amount of change.
       public: void State(
                   msgs::SerializedStateMap &_state,
                   const std::unordered_set<Entity> &_entities = {},
@@ -493,11 +748,13 @@ namespace ignition
       /// Currently supported:
       /// * New entities and all of their components
       /// * Removed entities and all of their components
+      /// * Entities whose components were changed, with only the changed
+      ///   components serialized
       ///
-      /// Future work:
-      /// * Entities which had a component added
-      /// * Entities which had a component removed
-      /// * Entities which had a component modified
+      /// \detail Entities are enumerated from the dirty trackers, so the
+      /// cost is proportional to the amount of change, not to the size of
+      /// the world. Existing entries in _state are updated in place, which
+      /// lets the caller keep reusing one message across iterations.
       ///
       /// \param[in] _state New serialized state.
       /// \detail The header of the message will not be populated, it is the
@@ -514,6 +771,49 @@ namespace ignition
       /// \param[in] _stateMsg Message containing state to be set.
       public: void SetState(const msgs::SerializedStateMap &_stateMsg);
 
+      /// \brief Capture the dynamic state of the world — every entity's
+      /// pose plus link velocities and joint positions and velocities —
+      /// into a compact binary blob. Together with RestoreState this
+      /// turns an episode reset into one call instead of one service
+      /// request per model.
+      /// \return Opaque blob; pass it to RestoreState on the same world.
+      public: std::string SnapshotState() const;
+
+      /// \brief Restore a snapshot taken with SnapshotState in one
+      /// batched pass. Components are written directly, and the pose and
+      /// joint write-through commands (WorldPoseCmd, JointPositionReset,
+      /// JointVelocityReset) are created so physics applies the restored
+      /// state to its existing engine objects on the next step.
+      /// \param[in] _blob Blob returned by SnapshotState.
+      /// \return True if the blob was well formed and applied.
+      public: bool RestoreState(const std::string &_blob);
+
+      /// \brief Fork the current world state into an independent manager.
+      /// The entity bookkeeping is copied, but the per-type component
+      /// storages are shared between the two managers and only
+      /// deep-copied lazily, when either manager first writes to a type.
+      /// Branching rollouts that fork a large world and then touch a
+      /// handful of component types therefore pay for what diverges
+      /// instead of for a full copy.
+      ///
+      /// Call at a step boundary: component pointers handed out before
+      /// the fork may be invalidated by either manager's next write.
+      /// \return A new manager holding the same world state.
+      public: std::unique_ptr<EntityComponentManager> Clone();
+
+      /// \brief Serialize the difference between this manager's state
+      /// and another manager's: components added, changed or removed
+      /// relative to the base, and entities created or removed. Applying
+      /// the message to a manager holding the base state with SetState
+      /// reproduces this manager's state. Component types whose storage
+      /// is still shared with the base after a Clone are skipped without
+      /// comparison, so diffing a fork costs proportional to its
+      /// divergence.
+      /// \param[in] _base Manager holding the state to diff against.
+      /// \param[out] _state Message to fill with the divergent state.
+      public: void Diff(const EntityComponentManager &_base,
+          msgs::SerializedStateMap &_state) const;
+
       /// \brief Set the changed state of a component.
       /// \param[in] _entity The entity.
       /// \param[in] _type Type of the component.
@@ -522,6 +822,32 @@ namespace ignition
           const Entity _entity, const ComponentTypeId _type,
           gazebo::ComponentState _c = ComponentState::OneTimeChange);
 
+      /// \brief Set the changed state of one component type on a batch
+      /// of entities. This is equivalent to calling the single-entity
+      /// overload for each entity, but the change bookkeeping is done
+      /// in bulk, which is considerably cheaper when a system touches
+      /// most entities every step, e.g. the physics pose write-back.
+      /// Entities without a component of the given type are skipped.
+      /// \param[in] _entities The entities whose components changed.
+      /// \param[in] _type Type of the component.
+      /// \param[in] _c Changed state value, defaults to one-time-change.
+      public: void SetChanged(
+          const std::vector<Entity> &_entities, const ComponentTypeId _type,
+          gazebo::ComponentState _c = ComponentState::OneTimeChange);
+
+      /// \brief Set the changed state of a component from inside an
+      /// EachParallel callback. The flag is buffered in a shard owned by
+      /// the calling worker thread and merged into the regular change
+      /// trackers on the dispatching thread when the parallel pass
+      /// completes, so concurrent callers never touch shared state.
+      /// Outside a parallel pass this is equivalent to SetChanged.
+      /// \param[in] _entity The entity.
+      /// \param[in] _type Type of the component.
+      /// \param[in] _c Changed state value, defaults to one-time-change.
+      public: void SetChangedParallel(
+          const Entity _entity, const ComponentTypeId _type,
+          gazebo::ComponentState _c = ComponentState::OneTimeChange);
+
       /// \brief Get a component's state.
       /// \param[in] _entity Entity that contains the component.
       /// \param[in] _typeId Component type ID.
@@ -529,6 +855,82 @@ namespace ignition
       public: gazebo::ComponentState ComponentState(const Entity _entity,
           const ComponentTypeId _typeId) const;
 
+      /// \brief Get all entities whose component of the given type was
+      /// marked changed (one-time or periodic) during the current
+      /// iteration. The cost is proportional to the number of changed
+      /// components of that type, not the total entity count.
+      /// \param[in] _typeId Component type ID.
+      /// \return Entities with a changed component of the given type.
+      public: std::vector<Entity> ChangedEntities(
+          const ComponentTypeId _typeId) const;
+
+      /// \brief Iterate over the entities whose component of the given
+      /// type was marked changed (one-time or periodic) during the
+      /// current iteration. Only changed entities are visited, so
+      /// enumeration is O(changed) rather than a scan of all entities.
+      /// \param[in] _f Callback function to be called for each changed
+      /// entity, with the entity and its changed component. The callback
+      /// can return false to stop subsequent calls, otherwise a true
+      /// value should be returned.
+      /// \tparam ComponentTypeT The desired component type.
+      public: template<typename ComponentTypeT>
+              void ForEachChanged(typename identity<std::function<
+                  bool(const Entity &_entity,
+                       const ComponentTypeT *)>>::type _f) const;
+
+      /// \brief Start recording a short world pose history for an
+      /// entity. One sample is recorded per simulation step, and once
+      /// the ring holds _depth samples the oldest is overwritten.
+      /// Consumers that sample at a different rate than physics, such
+      /// as rendering sensors aligning to an exposure time, can then
+      /// interpolate the pose at an arbitrary time with PoseAt.
+      ///
+      /// Tracking may be requested from a const manager, e.g. from a
+      /// system's PostUpdate, since it only affects bookkeeping.
+      /// \param[in] _entity Entity to track. Must have a pose.
+      /// \param[in] _depth Number of samples to keep, at least 2.
+      public: void TrackPoseHistory(const Entity _entity,
+                  const std::size_t _depth = 16) const;
+
+      /// \brief Stop recording pose history for an entity and discard
+      /// its samples.
+      /// \param[in] _entity Entity to stop tracking.
+      public: void UntrackPoseHistory(const Entity _entity) const;
+
+      /// \brief Record the current world pose of every tracked entity.
+      /// Called by the simulation runner once per step, after the
+      /// systems have updated, so the samples hold end-of-step poses.
+      /// \param[in] _time Current simulation time.
+      public: void RecordPoseHistories(
+                  const std::chrono::steady_clock::duration &_time);
+
+      /// \brief Get the world pose of a tracked entity at an arbitrary
+      /// time by interpolating between the recorded samples, with the
+      /// position interpolated linearly and the rotation spherically.
+      /// Times outside the recorded range clamp to the oldest or
+      /// newest sample.
+      /// \param[in] _entity Entity to query.
+      /// \param[in] _time Simulation time to interpolate at.
+      /// \return The interpolated pose, or nullopt if the entity isn't
+      /// tracked or no sample has been recorded yet.
+      public: std::optional<math::Pose3d> PoseAt(const Entity _entity,
+                  const std::chrono::steady_clock::duration &_time) const;
+
+      /// \brief Get the world pose of an entity from the batched
+      /// per-step sweep. The first query after a step's component
+      /// writes walks the entity tree once in parent-before-child
+      /// order, composing every local pose on the way down, so each
+      /// world pose is computed exactly once no matter how many
+      /// entities share ancestors or how many callers ask. Later
+      /// queries, from any thread, are lookups into the shared cache.
+      /// The cache is invalidated when the step's change tracking
+      /// resets and on bulk state changes.
+      /// \param[in] _entity Entity to query.
+      /// \return The world pose, or nullopt if the entity has no pose
+      /// component or was created after the sweep.
+      public: std::optional<math::Pose3d> WorldPose(
+                  const Entity _entity) const;
+
       /// \brief Clear the list of newly added entities so that a call to
       /// EachAdded after this will have no entities to iterate. This function
       /// is protected to facilitate testing.
@@ -542,6 +944,10 @@ namespace ignition
       /// \brief Mark all components as not changed.
       protected: void SetAllComponentsUnchanged();
 
+      /// \brief Walk the entity tree from its roots and fill the world
+      /// pose cache. Callers hold the cache mutex.
+      private: void ComputeWorldPoses() const;
+
       /// \brief Get whether an Entity exists and is new.
       ///
       /// Entities are considered new in the time between their creation and a
@@ -555,6 +961,13 @@ namespace ignition
       /// \return True if the Entity has been marked to be removed.
       private: bool IsMarkedForRemoval(const Entity _entity) const;
 
+      /// \brief Get whether an Entity has been removed from all views but
+      /// still awaits storage destruction under the removal budget. Such
+      /// entities must not be re-added when views are created or rebuilt.
+      /// \param[in] _entity Entity id to check.
+      /// \return True if the Entity is awaiting destruction.
+      private: bool IsTombstoned(const Entity _entity) const;
+
       /// \brief Delete an existing Entity.
       /// \param[in] _entity The entity to remove.
       /// \returns True if the Entity existed and was deleted.
@@ -577,6 +990,23 @@ namespace ignition
                    const ComponentTypeId _componentTypeId,
                    const components::BaseComponent *_data);
 
+      /// \brief Implementation of CreateComponent that leaves view
+      /// maintenance to the caller, so that a batch of components can be
+      /// created with a single view update at the end.
+      /// \param[in] _entity The entity that will be associated with
+      /// the component.
+      /// \param[in] _componentTypeId Id of the component type.
+      /// \param[in] _data Data used to construct the component.
+      /// \param[in, out] _rebuildViews Set to true if the component's
+      /// storage was expanded and the views have to be rebuilt. Left
+      /// untouched otherwise.
+      /// \return Key that uniquely identifies the component.
+      private: ComponentKey CreateComponentImplementation(
+                   const Entity _entity,
+                   const ComponentTypeId _componentTypeId,
+                   const components::BaseComponent *_data,
+                   bool &_rebuildViews);
+
       /// \brief Get a component based on a component type.
       /// \param[in] _entity The entity.
       /// \param[in] _type Id of the component type.
@@ -609,6 +1039,36 @@ namespace ignition
       private: components::BaseComponent *ComponentImplementation(
                    const ComponentKey &_key);
 
+      /// \brief Get the storage that holds all the components of a given
+      /// type. Storages are created on first use and kept for the lifetime
+      /// of the manager, so the returned pointer remains valid.
+      /// \param[in] _typeId Id of the component type.
+      /// \return Pointer to the storage, or nullptr if the component type
+      /// has never been created.
+      private: ComponentStorageBase *Storage(
+                   const ComponentTypeId _typeId) const;
+
+      /// \brief Get writable access to the storage of a given component
+      /// type. If the storage is still shared with a cloned manager it
+      /// is detached first, so writes never reach the other manager.
+      /// \param[in] _typeId Id of the component type.
+      /// \return Pointer to the storage, or nullptr if the component type
+      /// has never been created.
+      private: ComponentStorageBase *Storage(const ComponentTypeId _typeId);
+
+      /// \brief Get whether any component storage may still be shared
+      /// with a cloned manager. Mutable iteration uses this to decide
+      /// whether storages have to be detached before handing out
+      /// writable component pointers.
+      /// \return True if this manager was involved in a Clone.
+      private: bool HasSharedStorages() const;
+
+      /// \brief Run a set of tasks on the worker pool and wait for all of
+      /// them to complete. Used by EachParallel to dispatch entity ranges.
+      /// \param[in] _tasks Tasks to be executed.
+      private: void RunParallel(
+                   const std::vector<std::function<void()>> &_tasks) const;
+
       /// \brief End of the AddComponentToView recursion. This function is
       /// called when Rest is empty.
       /// \param[in, out] _view The FirstComponent will be added to the
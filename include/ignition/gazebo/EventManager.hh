@@ -17,8 +17,11 @@
 #ifndef IGNITION_GAZEBO_EVENTMANAGER_HH_
 #define IGNITION_GAZEBO_EVENTMANAGER_HH_
 
+#include <cstddef>
 #include <functional>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <typeinfo>
 #include <unordered_map>
 #include <utility>
@@ -115,6 +118,52 @@ namespace ignition
               }
 
 
+      /// \brief Queue an event emission to be dispatched later by
+      /// ProcessDeferred(). Use this from emitters that must not block on
+      /// subscriber latency: this call only stores the arguments, and the
+      /// connected callbacks run when the owner of the manager drains the
+      /// queue. Queued emissions are dispatched in the order they were
+      /// queued, regardless of event type.
+      /// \param[in] _args function arguments to be passed to the event
+      /// callbacks. Must match the signature of the event type E.
+      public: template <typename E, typename ... Args>
+              void EmitDeferred(Args && ... _args)
+              {
+                if (this->events.find(typeid(E)) == this->events.end())
+                {
+                  // If there are no events of type E in the map, create it.
+                  // But it also means there is nothing to signal, so there
+                  // is no emission to queue.
+                  this->events[typeid(E)] = std::make_unique<E>();
+                  return;
+                }
+
+                E *eventPtr = dynamic_cast<E *>(this->events[typeid(E)].get());
+                if (eventPtr == nullptr)
+                {
+                  ignerr << "Failed to queue event: "
+                    << typeid(E).name() << std::endl;
+                  return;
+                }
+
+                // The event outlives the queue entry; it is only removed
+                // when this manager is destroyed.
+                std::lock_guard<std::mutex> lock(this->deferredMutex);
+                this->deferredEmissions.push_back(std::bind(
+                    [eventPtr](auto &... _boundArgs)
+                    {
+                      eventPtr->Signal(_boundArgs ...);
+                    }, std::forward<Args>(_args) ...));
+              }
+
+      /// \brief Dispatch emissions queued by EmitDeferred().
+      /// \param[in] _budget Maximum number of queued emissions to dispatch
+      /// in this call, or 0 to dispatch all of them. Emissions over the
+      /// budget stay queued for a later call, bounding the time spent in
+      /// subscriber callbacks.
+      /// \return Number of emissions still queued.
+      public: std::size_t ProcessDeferred(std::size_t _budget = 0u);
+
       /// \brief Convenience type for storing typeinfo references.
       private: using TypeInfoRef = std::reference_wrapper<const std::type_info>;
 
@@ -140,6 +189,13 @@ namespace ignition
       private: std::unordered_map<TypeInfoRef,
                                   std::unique_ptr<ignition::common::Event>,
                                   Hasher, EqualTo> events;
+
+      /// \brief Protects deferredEmissions. Emitters may queue from any
+      /// thread.
+      private: std::mutex deferredMutex;
+
+      /// \brief Emissions queued by EmitDeferred, in queueing order.
+      private: std::list<std::function<void()>> deferredEmissions;
     };
     }
   }
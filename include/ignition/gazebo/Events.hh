@@ -17,6 +17,9 @@
 #ifndef IGNITION_GAZEBO_EVENTS_HH_
 #define IGNITION_GAZEBO_EVENTS_HH_
 
+#include <cstdint>
+#include <set>
+
 #include <sdf/Element.hh>
 
 #include <ignition/common/Event.hh>
@@ -58,6 +61,35 @@ namespace ignition
       /// the entity, which may contain multiple <plugin> tags.
       using LoadPlugins = common::EventT<void(Entity, sdf::ElementPtr),
           struct LoadPluginsTag>;
+
+      /// \brief Event emitted while entities are created from an SDF world
+      /// at startup. The first argument is the number of model subtrees
+      /// committed to the ECM so far and the second is the total number of
+      /// models in the world, so orchestration can track load readiness.
+      ///
+      /// For example:
+      /// \code
+      /// eventManager.Connect<ignition::gazebo::events::WorldLoadProgress>(
+      ///     [](uint64_t _done, uint64_t _total){});
+      /// \endcode
+      using WorldLoadProgress = common::EventT<void(uint64_t, uint64_t),
+          struct WorldLoadProgressTag>;
+
+      /// \brief Event emitted once per simulation step with every entity
+      /// created during that step, e.g. a whole level load arrives as one
+      /// batch. Emitted just before the newly-created list is cleared, so
+      /// the entities' components can still be queried from the callback.
+      /// Not emitted on steps where no entity was created.
+      using EntitiesAdded = common::EventT<void(const std::set<Entity> &),
+          struct EntitiesAddedTag>;
+
+      /// \brief Event emitted once per simulation step with every entity
+      /// marked for removal during that step, e.g. a whole level unload
+      /// arrives as one batch. Emitted just before the removals are
+      /// processed, so the entities' components can still be queried from
+      /// the callback. Not emitted on steps where no entity was removed.
+      using EntitiesRemoved = common::EventT<void(const std::set<Entity> &),
+          struct EntitiesRemovedTag>;
       }
     }  // namespace events
   }  // namespace gazebo
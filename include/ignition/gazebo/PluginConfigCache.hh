@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_PLUGINCONFIGCACHE_HH_
+#define IGNITION_GAZEBO_PLUGINCONFIGCACHE_HH_
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <utility>
+
+#include <sdf/Element.hh>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Export.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \class PluginConfigCache PluginConfigCache.hh
+    /// ignition/gazebo/PluginConfigCache.hh
+    /// \brief Process-wide memoization of parsed plugin configurations.
+    ///
+    /// A world with a fleet of identical robots configures the same
+    /// system plugin once per robot, and every Configure call walks the
+    /// same SDF element tree for the same parameter values. This cache
+    /// lets a system parse its configuration once per distinct plugin
+    /// element and hand every later instance the same immutable object.
+    /// The key combines the configuration type with the canonical text
+    /// form of the element, so two plugin elements that differ in any
+    /// attribute or child are parsed separately, and unrelated systems
+    /// can never collide.
+    ///
+    /// Typical use in a system's Configure:
+    ///
+    /// \code
+    ///   auto params = PluginConfigCache::Get<MyParams>(_sdf, [&_sdf]()
+    ///   {
+    ///     MyParams p;
+    ///     p.gain = _sdf->Get<double>("gain", p.gain).first;
+    ///     return p;
+    ///   });
+    /// \endcode
+    ///
+    /// Cached objects are shared between system instances and must stay
+    /// immutable; anything stateful belongs in the system, initialized
+    /// from the cached values. Entries live for the lifetime of the
+    /// process.
+    class IGNITION_GAZEBO_VISIBLE PluginConfigCache
+    {
+      /// \brief Get the parsed configuration for a plugin element,
+      /// parsing and caching it on the first call for each distinct
+      /// element.
+      /// \param[in] _sdf The plugin element handed to Configure.
+      /// \param[in] _parse Callable returning a ConfigT; invoked only
+      /// on a cache miss. It may run concurrently on different threads
+      /// for the same element, in which case one result wins and the
+      /// others are discarded.
+      /// \return Shared immutable configuration object.
+      public: template <typename ConfigT, typename ParserT>
+              static std::shared_ptr<const ConfigT> Get(
+                  const std::shared_ptr<const sdf::Element> &_sdf,
+                  ParserT &&_parse)
+      {
+        const std::string key = PluginConfigCache::Key(
+            typeid(ConfigT).name(), _sdf);
+
+        if (auto cached = PluginConfigCache::Lookup(key))
+          return std::static_pointer_cast<const ConfigT>(cached);
+
+        auto config = std::make_shared<const ConfigT>(
+            std::forward<ParserT>(_parse)());
+        return std::static_pointer_cast<const ConfigT>(
+            PluginConfigCache::Store(key, config));
+      }
+
+      /// \brief Remove all cached configurations.
+      public: static void Clear();
+
+      /// \brief Build the cache key for a configuration type and
+      /// element.
+      /// \param[in] _type Mangled name of the configuration type.
+      /// \param[in] _sdf The plugin element.
+      /// \return The cache key.
+      private: static std::string Key(const char *_type,
+          const std::shared_ptr<const sdf::Element> &_sdf);
+
+      /// \brief Look up a cached configuration.
+      /// \param[in] _key The cache key.
+      /// \return The cached object, or nullptr.
+      private: static std::shared_ptr<const void> Lookup(
+          const std::string &_key);
+
+      /// \brief Store a configuration, keeping the existing entry if
+      /// two threads raced to parse the same element.
+      /// \param[in] _key The cache key.
+      /// \param[in] _config The parsed configuration.
+      /// \return The entry that ended up in the cache.
+      private: static std::shared_ptr<const void> Store(
+          const std::string &_key, std::shared_ptr<const void> _config);
+    };
+    }  // namespace IGNITION_GAZEBO_VERSION_NAMESPACE
+  }  // namespace gazebo
+}  // namespace ignition
+
+#endif  // IGNITION_GAZEBO_PLUGINCONFIGCACHE_HH_
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_RNG_HH_
+#define IGNITION_GAZEBO_RNG_HH_
+
+#include <cstdint>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Entity.hh>
+#include <ignition/gazebo/Export.hh>
+#include <ignition/gazebo/Types.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \class Rng Rng.hh ignition/gazebo/Rng.hh
+    /// \brief Deterministic, counter-based random number source for
+    /// systems.
+    ///
+    /// Classic generators carry mutable state, so the numbers a system
+    /// draws depend on how many draws happened before, and therefore on
+    /// system execution order and threading. Rng instead derives every
+    /// draw purely from the world seed (see ServerConfig::SetSeed), an
+    /// entity, the current iteration and a draw counter. Randomized
+    /// systems using it become pure functions of those inputs: running
+    /// systems in a different order or concurrently cannot change the
+    /// numbers an entity sees, and two runs with the same seed produce
+    /// identical noise.
+    ///
+    /// Typical use is to construct one generator per entity per update:
+    ///
+    /// \code
+    ///   Rng rng(_info, entity);
+    ///   const double noise = rng.DblNormal(0.0, stdDev);
+    /// \endcode
+    ///
+    /// Every call advances the draw counter, so consecutive draws are
+    /// independent; constructing the same generator again replays the
+    /// same sequence. Generators are cheap value types; there is no
+    /// shared state and nothing to contend on across threads.
+    class IGNITION_GAZEBO_VISIBLE Rng
+    {
+      /// \brief Create a generator for an entity on the current
+      /// iteration. The world seed is taken from
+      /// ignition::math::Rand::Seed(), which ServerConfig::SetSeed
+      /// configures.
+      /// \param[in] _info Current update info, provides the iteration.
+      /// \param[in] _entity The entity the numbers are drawn for.
+      public: Rng(const UpdateInfo &_info, const Entity _entity);
+
+      /// \brief Create a generator from explicit inputs.
+      /// \param[in] _seed The world seed.
+      /// \param[in] _entity The entity the numbers are drawn for.
+      /// \param[in] _iteration The simulation iteration.
+      public: Rng(const uint64_t _seed, const Entity _entity,
+                  const uint64_t _iteration);
+
+      /// \brief Get the next raw draw.
+      /// \return A uniformly distributed 64-bit value.
+      public: uint64_t NextUInt64();
+
+      /// \brief Get a uniformly distributed double.
+      /// \param[in] _min Minimum value, inclusive.
+      /// \param[in] _max Maximum value, exclusive.
+      /// \return A value in [_min, _max).
+      public: double DblUniform(const double _min = 0, const double _max = 1);
+
+      /// \brief Get a normally distributed double.
+      /// \param[in] _mean The mean of the distribution.
+      /// \param[in] _stdDev The standard deviation of the distribution.
+      /// \return A normally distributed value.
+      public: double DblNormal(const double _mean = 0,
+                  const double _stdDev = 1);
+
+      /// \brief Get a uniformly distributed integer.
+      /// \param[in] _min Minimum value, inclusive.
+      /// \param[in] _max Maximum value, inclusive.
+      /// \return A value in [_min, _max].
+      public: int IntUniform(const int _min, const int _max);
+
+      /// \brief Key derived from seed, entity and iteration. Every draw
+      /// mixes this key with the draw counter.
+      private: uint64_t key{0};
+
+      /// \brief Number of draws taken so far.
+      private: uint64_t drawCount{0};
+    };
+    }
+  }
+}
+#endif
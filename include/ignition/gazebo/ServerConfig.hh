@@ -22,7 +22,9 @@
 #include <memory>
 #include <optional> // NOLINT(*)
 #include <string>
+#include <vector>
 #include <sdf/Element.hh>
+#include <sdf/Root.hh>
 #include <ignition/gazebo/config.hh>
 #include <ignition/gazebo/Export.hh>
 
@@ -174,6 +176,22 @@ namespace ignition
       /// \return The full contents of the SDF string, or empty string.
       public: std::string SdfString() const;
 
+      /// \brief Set an SDF Root DOM object to be used by the server,
+      /// so worlds built programmatically can be handed over without
+      /// serializing them to XML and parsing them back.
+      ///
+      /// The object is shared, not copied; the caller must not modify it
+      /// once the server has been constructed. Setting the Root object
+      /// will override any value set by `SetSdfFile` or `SetSdfString`.
+      ///
+      /// \param[in] _root SDF Root DOM object with at least one world.
+      /// \return (reserved for future use)
+      public: bool SetSdfRoot(std::shared_ptr<sdf::Root> _root);
+
+      /// \brief Get the SDF Root DOM object that has been set.
+      /// \return The SDF Root object, or nullptr if one has not been set.
+      public: std::shared_ptr<sdf::Root> SdfRoot() const;
+
       /// \brief Set the update rate in Hertz. Value <=0 are ignored.
       /// \param[in] _hz The desired update rate of the server in Hertz.
       public: void SetUpdateRate(const double &_hz);
@@ -183,6 +201,238 @@ namespace ignition
       /// an UpdateRate has not been set.
       public: std::optional<double> UpdateRate() const;
 
+      /// \brief Set the number of simulation steps batched into one full
+      /// system sweep. With a batch size of N, only the PreUpdate and
+      /// Update phases run on every step, so physics and controllers
+      /// integrate at full rate, while the PostUpdate phase (sensors,
+      /// state broadcasting, logging) runs once every N steps with a dt
+      /// covering the whole batch. This trades output granularity for
+      /// faster-than-realtime throughput, e.g. for headless training
+      /// runs. Values <= 1 are ignored.
+      /// \param[in] _substeps Number of steps per full sweep.
+      public: void SetUpdateBatchSize(unsigned int _substeps);
+
+      /// \brief Get the number of simulation steps batched into one full
+      /// system sweep.
+      /// \return The batch size. The default of 1 runs every phase on
+      /// every step.
+      public: unsigned int UpdateBatchSize() const;
+
+      /// \brief Set the number of steps the server simulates ahead of
+      /// confirmed time, speculatively, with commands held at their
+      /// latest values. Each paced step rolls the world back to the
+      /// confirmed frontier, integrates the commands that actually
+      /// arrived, and re-speculates, so published state leads real time
+      /// by the full depth and operators see their inputs reflected
+      /// after one step instead of the whole step+publish+render
+      /// pipeline. Each paced step simulates the depth plus one steps,
+      /// so the world must run that much faster than real time. Ignored
+      /// under distributed simulation.
+      /// \param[in] _steps Speculative depth in steps. Zero, the
+      /// default, disables run-ahead.
+      public: void SetRunAheadSteps(unsigned int _steps);
+
+      /// \brief Get the number of speculative run-ahead steps.
+      /// \return The run-ahead depth, zero when disabled.
+      public: unsigned int RunAheadSteps() const;
+
+      /// \brief Set the maximum number of removed entities destroyed per
+      /// simulation step. Entities over the budget stop being visible to
+      /// systems immediately, but their memory is reclaimed over the
+      /// following steps, so bulk removals such as a level unloading don't
+      /// spike a single step.
+      /// \param[in] _budget Entities destroyed per step. Zero, the
+      /// default, destroys all removed entities in the same step.
+      public: void SetEntityRemovalBudget(uint64_t _budget);
+
+      /// \brief Get the maximum number of removed entities destroyed per
+      /// simulation step.
+      /// \return The budget, zero meaning unlimited.
+      public: uint64_t EntityRemovalBudget() const;
+
+      /// \brief Set whether the real time factor governor is enabled.
+      /// When enabled, the simulation runner tracks per-step deadline
+      /// misses and, after repeated overruns, sheds systems that
+      /// implement ISystemSheddable until steps fit their deadline
+      /// again. Deadline diagnostics are published on the world's
+      /// step_diagnostics topic whether or not the governor is enabled.
+      /// \param[in] _enabled True to enable the governor.
+      public: void SetRtfGovernorEnabled(bool _enabled);
+
+      /// \brief Get whether the real time factor governor is enabled.
+      /// \return True if the governor is enabled. Default is false.
+      public: bool RtfGovernorEnabled() const;
+
+      /// \brief Set the path of the state checksum log. When non-empty,
+      /// the simulation runner appends one line per unpaused step with a
+      /// checksum of every component type that changed during the step,
+      /// computed from the change-tracking data. Two logs from identical
+      /// runs are byte-identical, so diffing them pinpoints the first
+      /// divergent step and the component type that drifted. See
+      /// tools/diff_state_checksums.py. The
+      /// IGN_GAZEBO_STATE_CHECKSUM_PATH environment variable provides the
+      /// path when none is set here.
+      /// \param[in] _path Path of the log file to write. An empty
+      /// string, the default, disables checksumming.
+      public: void SetStateChecksumPath(const std::string &_path);
+
+      /// \brief Get the path of the state checksum log.
+      /// \return The log path, empty when checksumming is disabled.
+      public: const std::string &StateChecksumPath() const;
+
+      /// \brief Set the path of a checkpoint file to restore on
+      /// startup. Each world loads its SDF as usual and then lays the
+      /// checkpointed entity and system state over it, so a
+      /// long-running simulation continues where the checkpoint was
+      /// taken instead of re-simulating to steady state. Checkpoints
+      /// are written through the world's `checkpoint` service and only
+      /// apply to the world they were taken from.
+      /// \param[in] _path Path of the checkpoint file. An empty
+      /// string, the default, starts from the SDF state.
+      public: void SetCheckpointRestorePath(const std::string &_path);
+
+      /// \brief Get the path of the checkpoint file to restore.
+      /// \return The checkpoint path, empty when none is set.
+      public: const std::string &CheckpointRestorePath() const;
+
+      /// \brief Set the CPUs the server's worlds run on. The list is
+      /// split into one contiguous chunk per world, and each world pins
+      /// its step thread and worker pool to its chunk. On NUMA machines,
+      /// list the CPUs grouped by node so every world stays within one
+      /// node; its memory then follows through first-touch allocation,
+      /// avoiding cross-node traffic on hot paths such as `Each` sweeps.
+      /// Only supported on Linux.
+      /// \param[in] _cpus CPU indices to run on. An empty list, the
+      /// default, leaves placement to the operating system.
+      public: void SetCpuAffinity(const std::vector<unsigned int> &_cpus);
+
+      /// \brief Get the CPUs the server's worlds run on.
+      /// \return The CPU indices, empty when placement is left to the
+      /// operating system.
+      public: const std::vector<unsigned int> &CpuAffinity() const;
+
+      /// \brief Set the number of worker threads each world's
+      /// simulation runner creates for its system update pool. With
+      /// several worlds in one process, the default of one thread per
+      /// hardware thread per world oversubscribes the machine.
+      /// \param[in] _count Threads per world. Zero, the default,
+      /// creates one per hardware thread.
+      public: void SetWorkerThreadCount(unsigned int _count);
+
+      /// \brief Get the number of worker threads per world.
+      /// \return The thread count, zero meaning one per hardware
+      /// thread.
+      public: unsigned int WorkerThreadCount() const;
+
+      /// \brief Set the CPU budget of one world, overriding the
+      /// process-wide settings for it. Use this when worlds have known,
+      /// uneven weights and the even split made by SetCpuAffinity
+      /// would be wrong.
+      /// \param[in] _worldName Name of the world.
+      /// \param[in] _threads Worker threads for the world's runner.
+      /// Zero falls back to WorkerThreadCount.
+      /// \param[in] _cpus CPUs the world runs on. An empty list falls
+      /// back to the world's chunk of CpuAffinity.
+      public: void SetWorldCpuBudget(const std::string &_worldName,
+                  unsigned int _threads,
+                  const std::vector<unsigned int> &_cpus);
+
+      /// \brief Get the number of worker threads for one world,
+      /// resolving to WorkerThreadCount when the world has no budget of
+      /// its own.
+      /// \param[in] _worldName Name of the world.
+      /// \return The thread count, zero meaning one per hardware
+      /// thread.
+      public: unsigned int WorldWorkerThreadCount(
+                  const std::string &_worldName) const;
+
+      /// \brief Get the CPUs one world runs on, as set with
+      /// SetWorldCpuBudget.
+      /// \param[in] _worldName Name of the world.
+      /// \return The CPU indices, empty when the world has no cpuset of
+      /// its own.
+      public: std::vector<unsigned int> WorldCpuAffinity(
+                  const std::string &_worldName) const;
+
+      /// \brief Set whether the step loops of the worlds in this
+      /// process are coordinated. When enabled, runners take turns
+      /// stepping in round-robin order with deadline accounting: a
+      /// world whose steps overrun its update period accumulates debt
+      /// and sits out one rotation per period of debt, so a heavy
+      /// world is throttled predictably instead of starving the others
+      /// through the OS scheduler. Only takes effect with more than one
+      /// world.
+      /// \param[in] _enabled True to coordinate the step loops.
+      public: void SetStepCoordination(bool _enabled);
+
+      /// \brief Get whether the step loops of the worlds are
+      /// coordinated.
+      /// \return True if coordinated. Default is false.
+      public: bool StepCoordination() const;
+
+      /// \brief Set whether the PostUpdate phase overlaps the next
+      /// simulation step. When enabled, the simulation runner keeps a
+      /// snapshot entity component manager that is refreshed after each
+      /// Update phase with that step's changed components, and PostUpdate
+      /// systems (sensors, state broadcasting, logging) read the snapshot
+      /// on worker threads while the next step's PreUpdate and Update
+      /// phases mutate the live manager. On worlds where PostUpdate and
+      /// the stepping phases are comparable in cost, the overlap hides
+      /// one behind the other. Output lags the live state by at most one
+      /// step.
+      /// \param[in] _enabled True to overlap PostUpdate with the next
+      /// step.
+      public: void SetPostUpdatePipelined(bool _enabled);
+
+      /// \brief Get whether the PostUpdate phase overlaps the next
+      /// simulation step.
+      /// \return True if PostUpdate is pipelined. Default is false.
+      public: bool PostUpdatePipelined() const;
+
+      /// \brief Set whether pipelined PostUpdate work is best effort.
+      /// When enabled together with SetPostUpdatePipelined, a step
+      /// whose previous PostUpdate batch is still running skips that
+      /// cycle instead of waiting it out: the step's changed-component
+      /// delta is buffered, and once the workers catch up one batch
+      /// runs with its dt widened over the skipped cycles. Physics and
+      /// controllers then never stall on a slow consumer, such as a
+      /// disk flush in a logging system, at the cost of output systems
+      /// dropping cycles under load. A bounded backlog keeps memory in
+      /// check; past it the step falls back to waiting.
+      /// \param[in] _enabled True to let PostUpdate skip cycles.
+      public: void SetPostUpdateBestEffort(bool _enabled);
+
+      /// \brief Get whether pipelined PostUpdate work is best effort.
+      /// \return True if PostUpdate may skip cycles. Default is false.
+      public: bool PostUpdateBestEffort() const;
+
+      /// \brief Set whether the step thread spins briefly before
+      /// sleeping while waiting for PostUpdate systems to finish. The
+      /// spin polls the outstanding-work counter with exponential
+      /// backoff, bounded by a fraction of the world's update period,
+      /// before falling back to the worker pool's blocking wait. At
+      /// kilohertz step rates this trades a little step-thread CPU for
+      /// the wake latency of being signalled by the last PostUpdate
+      /// worker, which is otherwise paid on every step.
+      /// \param[in] _enabled True to spin before sleeping.
+      public: void SetPostUpdateSpinWait(bool _enabled);
+
+      /// \brief Get whether the step thread spins while waiting for
+      /// PostUpdate systems to finish.
+      /// \return True if spinning. Default is false.
+      public: bool PostUpdateSpinWait() const;
+
+      /// \brief Set whether render-dependent system plugins are refused.
+      /// When true, plugins that load a render engine, such as the
+      /// sensors system, are skipped at load time so a headless server
+      /// never pays their startup and memory cost.
+      /// \param[in] _disabled True to refuse render-dependent plugins.
+      public: void SetRenderPluginsDisabled(bool _disabled);
+
+      /// \brief Get whether render-dependent system plugins are refused.
+      /// \return True if render-dependent plugins are skipped.
+      public: bool RenderPluginsDisabled() const;
+
       /// \brief Get whether the server is using the level system
       /// \return True if the server is set to use the level system
       public: bool UseLevels() const;
@@ -305,6 +555,23 @@ namespace ignition
       /// ~/.ignition/fuel.
       public: void SetResourceCache(const std::string &_path);
 
+      /// \brief Get whether the server stores fully-resolved worlds in an
+      /// on-disk cache and loads from that cache when the world file is
+      /// unchanged.
+      /// \return True if the world cache is enabled.
+      /// \sa SetUseWorldCache(bool _cache)
+      public: bool UseWorldCache() const;
+
+      /// \brief Set whether the server stores fully-resolved worlds in an
+      /// on-disk cache. After the first load of an SDF world file, the
+      /// include-expanded document is stored under
+      /// ~/.ignition/gazebo/worldcache, keyed by a hash of the file
+      /// contents. Subsequent startups with an unchanged file load the
+      /// cached copy, skipping include resolution and remote resource
+      /// fetching.
+      /// \param[in] _cache Value to set.
+      public: void SetUseWorldCache(bool _cache);
+
       /// \brief Physics engine plugin library to load.
       /// \return File containing physics engine library.
       public: const std::string &PhysicsEngine() const;
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_GAZEBO_SHMSTATECHANNEL_HH_
+#define IGNITION_GAZEBO_SHMSTATECHANNEL_HH_
+
+#include <google/protobuf/message.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Export.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \class ShmStateChannel ShmStateChannel.hh
+    ///   ignition/gazebo/ShmStateChannel.hh
+    /// \brief Single-writer, single-reader shared memory channel used to
+    /// exchange serialized state messages between two simulation processes
+    /// running on the same host, such as a distributed secondary and its
+    /// primary, or a server and the GUI it was launched with.
+    ///
+    /// The writer serializes a message directly into the mapped region and
+    /// the reader parses it directly from there, so the payload never goes
+    /// through the transport layer or intermediate buffers. A sequence
+    /// counter in the mapped header versions the payload: it is odd while a
+    /// write is in progress, and the reader retries if the counter changed
+    /// underneath it.
+    ///
+    /// The channel holds a single message, so a reader that falls behind
+    /// only sees the newest one. Peers that stream deltas should carry
+    /// their own sequence numbers in the payload to detect skipped
+    /// messages.
+    ///
+    /// Shared memory is only available on POSIX platforms; on Windows
+    /// Create and Attach return nullptr and peers fall back to transport.
+    class IGNITION_GAZEBO_VISIBLE ShmStateChannel
+    {
+      /// \brief Create a channel as the writer. The backing shared memory
+      /// object is created and removed again when the channel is destroyed.
+      /// \param[in] _name Shared memory object name, must start with '/'
+      /// and be unique on the host.
+      /// \param[in] _capacity Maximum serialized message size in bytes.
+      /// \return The channel, or nullptr if the shared memory object could
+      /// not be created.
+      public: static std::unique_ptr<ShmStateChannel> Create(
+          const std::string &_name, uint64_t _capacity = 64u << 20);
+
+      /// \brief Attach to an existing channel as the reader. Marks the
+      /// channel as attached so the writer knows the payload is consumed
+      /// through shared memory.
+      /// \param[in] _name Shared memory object name used by the writer.
+      /// \return The channel, or nullptr if the shared memory object does
+      /// not exist.
+      public: static std::unique_ptr<ShmStateChannel> Attach(
+          const std::string &_name);
+
+      /// \brief Destructor. Unmaps the region and, on the writer side,
+      /// removes the shared memory object.
+      public: ~ShmStateChannel();
+
+      /// \brief Check whether a reader has attached to this channel.
+      /// \return True if a reader attached.
+      public: bool ReaderAttached() const;
+
+      /// \brief Serialize a message into the channel. Writer side only.
+      /// \param[in] _msg Message to write.
+      /// \return False if the serialized size exceeds the channel capacity,
+      /// in which case the caller should fall back to transport.
+      public: bool Write(const google::protobuf::Message &_msg);
+
+      /// \brief Check whether a message is available that this reader has
+      /// not consumed yet. Does not consume the message.
+      /// \return True if Read would return a new message.
+      public: bool HasNewData() const;
+
+      /// \brief Parse the latest message out of the channel. Reader side
+      /// only.
+      /// \param[out] _msg Message to parse into.
+      /// \return True if a new message was read, false if there is no new
+      /// message or parsing failed.
+      public: bool Read(google::protobuf::Message &_msg);
+
+      /// \brief Private constructor, use Create or Attach.
+      private: ShmStateChannel() = default;
+
+      /// \brief Mapped shared memory region, starting with the header.
+      private: void *mapping{nullptr};
+
+      /// \brief Payload capacity in bytes, excluding the header.
+      private: uint64_t capacity{0};
+
+      /// \brief True on the writer side, which owns the shared memory
+      /// object.
+      private: bool owner{false};
+
+      /// \brief Shared memory object name.
+      private: std::string name;
+
+      /// \brief Sequence number of the last message consumed by Read.
+      private: uint64_t lastReadSequence{0};
+    };
+    }
+  }  // namespace gazebo
+}  // namespace ignition
+
+#endif  // IGNITION_GAZEBO_SHMSTATECHANNEL_HH_
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_STATICSYSTEMREGISTRY_HH_
+#define IGNITION_GAZEBO_STATICSYSTEMREGISTRY_HH_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Export.hh>
+#include <ignition/gazebo/System.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \class StaticSystemRegistry StaticSystemRegistry.hh
+    /// ignition/gazebo/StaticSystemRegistry.hh
+    /// \brief Process-wide registry of factories for systems linked
+    /// into the executable.
+    ///
+    /// SystemLoader reaches every system through a shared library:
+    /// resolving the filename against the plugin search paths, opening
+    /// the library and querying the plugin registry, even for the
+    /// first-party systems almost every simulation loads. A binary that
+    /// links a system library directly can register a plain factory
+    /// here at static initialization time instead; SimulationRunner
+    /// consults the registry by plugin class name before falling back
+    /// to the loader, so those systems cost one factory call instead of
+    /// a path search and a library load.
+    ///
+    /// System libraries compiled with IGN_GAZEBO_STATIC_SYSTEMS defined
+    /// (the IGN_GAZEBO_STATIC_SYSTEMS CMake option) register themselves
+    /// through IGNITION_GAZEBO_ADD_STATIC_SYSTEM. The registry stores
+    /// factories, not libraries: it is meant for code linked into the
+    /// executable, which is never unloaded. Systems instantiated this
+    /// way carry no library filename and cannot be hot reloaded.
+    class IGNITION_GAZEBO_VISIBLE StaticSystemRegistry
+    {
+      /// \brief Factory producing a new system instance per call.
+      public: using SystemFactoryFn =
+              std::function<std::shared_ptr<System>()>;
+
+      /// \brief Register a factory under a plugin class name. A later
+      /// registration for the same name replaces the earlier one, so a
+      /// reopened library always serves its current code.
+      /// \param[in] _name Fully qualified plugin class name, as written
+      /// in the name attribute of a plugin element.
+      /// \param[in] _factory Factory invoked once per instantiation.
+      /// \return True, so the call can seed a static initializer.
+      public: static bool Register(const std::string &_name,
+                  SystemFactoryFn _factory);
+
+      /// \brief Create a new instance of a registered system.
+      /// \param[in] _name Fully qualified plugin class name.
+      /// \return New system instance, or nullptr if no factory is
+      /// registered under the name.
+      public: static std::shared_ptr<System> Instantiate(
+                  const std::string &_name);
+
+      /// \brief Get the registered plugin class names.
+      /// \return Names in sorted order.
+      public: static std::vector<std::string> Names();
+
+      /// \brief Forget every registered factory. Test support.
+      public: static void Clear();
+    };
+    }
+  }
+}
+
+#define IGN_GAZEBO_DETAIL_STATIC_SYSTEM_PASTE2(_a, _b) _a##_b
+#define IGN_GAZEBO_DETAIL_STATIC_SYSTEM_PASTE(_a, _b) \
+  IGN_GAZEBO_DETAIL_STATIC_SYSTEM_PASTE2(_a, _b)
+
+#ifdef IGN_GAZEBO_STATIC_SYSTEMS
+/// \brief Register a system class in the StaticSystemRegistry under
+/// its stringified name. Place it next to IGNITION_ADD_PLUGIN_ALIAS
+/// and pass the same fully qualified class. Expands to nothing unless
+/// the translation unit is compiled with IGN_GAZEBO_STATIC_SYSTEMS
+/// defined.
+#define IGNITION_GAZEBO_ADD_STATIC_SYSTEM(SystemClass) \
+  namespace \
+  { \
+    const bool IGN_GAZEBO_DETAIL_STATIC_SYSTEM_PASTE( \
+        ignGazeboStaticSystemRegistered, __LINE__) = \
+        ignition::gazebo::StaticSystemRegistry::Register(#SystemClass, \
+            []() -> std::shared_ptr<ignition::gazebo::System> \
+            { \
+              return std::make_shared<SystemClass>(); \
+            }); \
+  }
+#else
+#define IGNITION_GAZEBO_ADD_STATIC_SYSTEM(SystemClass)
+#endif
+
+#endif  // IGNITION_GAZEBO_STATICSYSTEMREGISTRY_HH_
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_STEPARENA_HH_
+#define IGNITION_GAZEBO_STEPARENA_HH_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class StepArenaPrivate;
+
+    /// \brief Bump allocator for transient allocations that only live
+    /// within one update phase. Allocation is a single atomic add on a
+    /// preallocated buffer, safe from any number of threads, and nothing
+    /// is freed individually: the owner of the arena releases everything
+    /// at once with Reset when the phase completes.
+    ///
+    /// Systems reach the arena of the current phase through
+    /// UpdateInfo::arena and typically use it through StepArenaAllocator
+    /// rather than calling Allocate directly. Nothing allocated from the
+    /// arena may outlive the update call it was made in.
+    ///
+    /// The arena sizes itself: requests past the buffer's capacity fall
+    /// back to the heap for the rest of the phase, and the next Reset
+    /// grows the buffer to what the phase actually used, so steady-state
+    /// phases stop touching the heap entirely.
+    class IGNITION_GAZEBO_VISIBLE StepArena
+    {
+      /// \brief Constructor.
+      /// \param[in] _capacity Initial buffer capacity in bytes.
+      public: explicit StepArena(std::size_t _capacity = 1u << 20);
+
+      /// \brief Destructor.
+      public: ~StepArena();
+
+      /// \brief Allocate a block. Safe to call from any number of
+      /// threads concurrently. Blocks are aligned for any standard type;
+      /// over-aligned types come from the heap.
+      /// \param[in] _bytes Number of bytes to allocate.
+      /// \return The block. Heap-allocated when the arena is exhausted,
+      /// which Owns distinguishes.
+      public: void *Allocate(std::size_t _bytes);
+
+      /// \brief Check whether a pointer came out of the arena buffer.
+      /// Pointers that did not were heap fallbacks and must be returned
+      /// with operator delete.
+      /// \param[in] _ptr Pointer to check.
+      /// \return True if the pointer is inside the arena buffer.
+      public: bool Owns(const void *_ptr) const;
+
+      /// \brief Release everything allocated since the last Reset and
+      /// grow the buffer if the phase overflowed it. Only the owner may
+      /// call this, after every user of the arena has finished.
+      public: void Reset();
+
+      /// \brief Get the buffer capacity.
+      /// \return Capacity in bytes.
+      public: std::size_t Capacity() const;
+
+      /// \brief Get the number of bytes requested since the last Reset,
+      /// including any heap fallbacks. Exact only once every user of the
+      /// arena has finished.
+      /// \return Bytes requested this phase.
+      public: std::size_t Used() const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StepArenaPrivate> dataPtr;
+    };
+
+    /// \brief Standard allocator backed by a StepArena, for containers
+    /// holding per-phase temporaries. Deallocation of arena memory is a
+    /// no-op; the memory comes back when the arena owner resets it. With
+    /// a null arena — UpdateInfo::arena is null when the host provides
+    /// none, such as in the GUI — the allocator degrades to the heap, so
+    /// containers can be declared unconditionally.
+    template <typename T>
+    class StepArenaAllocator
+    {
+      /// \brief The allocated type.
+      public: using value_type = T;
+
+      /// \brief Constructor.
+      /// \param[in] _arena Arena to allocate from, or nullptr to use the
+      /// heap.
+      public: explicit StepArenaAllocator(StepArena *_arena = nullptr)
+        : arena(_arena)
+      {
+      }
+
+      /// \brief Converting copy constructor, required of allocators.
+      /// \param[in] _other Allocator to share an arena with.
+      public: template <typename U>
+      StepArenaAllocator(const StepArenaAllocator<U> &_other)
+        : arena(_other.arena)
+      {
+      }
+
+      /// \brief Allocate storage for _count elements.
+      /// \param[in] _count Number of elements.
+      /// \return The storage.
+      public: T *allocate(std::size_t _count)
+      {
+        if (nullptr == this->arena)
+        {
+          return static_cast<T *>(::operator new(_count * sizeof(T)));
+        }
+        return static_cast<T *>(this->arena->Allocate(_count * sizeof(T)));
+      }
+
+      /// \brief Release storage. A no-op for arena blocks, which are
+      /// released in bulk by the arena owner's Reset.
+      /// \param[in] _ptr The storage.
+      /// \param[in] _count Number of elements, unused.
+      public: void deallocate(T *_ptr, std::size_t _count)
+      {
+        (void)_count;
+        if (nullptr == this->arena || !this->arena->Owns(_ptr))
+          ::operator delete(_ptr);
+      }
+
+      /// \brief Arena backing this allocator, or nullptr for the heap.
+      public: StepArena *arena{nullptr};
+    };
+
+    /// \brief Two allocators are interchangeable when they draw from the
+    /// same arena.
+    /// \param[in] _a First allocator.
+    /// \param[in] _b Second allocator.
+    /// \return True if both use the same arena.
+    template <typename T, typename U>
+    bool operator==(const StepArenaAllocator<T> &_a,
+        const StepArenaAllocator<U> &_b)
+    {
+      return _a.arena == _b.arena;
+    }
+
+    /// \brief Counterpart of the allocator equality operator.
+    /// \param[in] _a First allocator.
+    /// \param[in] _b Second allocator.
+    /// \return True if the allocators use different arenas.
+    template <typename T, typename U>
+    bool operator!=(const StepArenaAllocator<T> &_a,
+        const StepArenaAllocator<U> &_b)
+    {
+      return _a.arena != _b.arena;
+    }
+
+    /// \brief Vector of per-phase temporaries backed by a StepArena.
+    template <typename T>
+    using ArenaVector = std::vector<T, StepArenaAllocator<T>>;
+    }
+  }
+}
+#endif
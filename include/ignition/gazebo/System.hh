@@ -17,7 +17,10 @@
 #ifndef IGNITION_GAZEBO_SYSTEM_HH_
 #define IGNITION_GAZEBO_SYSTEM_HH_
 
+#include <chrono>
 #include <memory>
+#include <string>
+#include <unordered_set>
 
 #include <ignition/gazebo/config.hh>
 #include <ignition/gazebo/EntityComponentManager.hh>
@@ -89,6 +92,90 @@ namespace ignition
                   EventManager &_eventMgr) = 0;
     };
 
+    /// \class ISystemConfigureParallel ISystem.hh ignition/gazebo/System.hh
+    /// \brief Interface marking a system whose Configure may run
+    /// concurrently with other marked systems.
+    ///
+    /// World load dispatches the Configure callbacks of marked systems
+    /// onto the runner's worker pool so expensive initializations, such
+    /// as bringing up a render engine, overlap instead of adding up. An
+    /// unmarked system acts as a barrier in the load order: every
+    /// Configure dispatched before it completes first, then the
+    /// system's Configure runs alone, and only then does dispatching
+    /// resume. Systems predate this interface, so sequencing is the
+    /// default.
+    ///
+    /// Only opt in when Configure confines its writes to the system's
+    /// own state and thread-safe facilities. Creating entities or
+    /// components, or otherwise mutating shared simulation state,
+    /// requires staying sequenced: the EntityComponentManager is not
+    /// synchronized for concurrent writers.
+    class IGNITION_GAZEBO_VISIBLE ISystemConfigureParallel {
+    };
+
+    /// \class ISystemUpdatePeriod ISystem.hh ignition/gazebo/System.hh
+    /// \brief Interface for a system that declares a minimum period
+    /// between its updates.
+    ///
+    /// The simulation runner skips the system's PreUpdate, Update and
+    /// PostUpdate callbacks until the declared amount of simulation time
+    /// has accumulated since the system last ran. When the system does
+    /// run, the UpdateInfo it receives carries the accumulated dt, so
+    /// integrating over `_info.dt` stays exact across the skipped steps.
+    /// While simulation is paused the system runs every step so it keeps
+    /// responding to user interaction.
+    ///
+    /// Systems that act at a rate well below the physics rate, such as a
+    /// pose publisher emitting at 60Hz in a 1kHz world, can declare their
+    /// period here instead of scanning entities and returning early on
+    /// every step. The period is queried once when the system is added.
+    class IGNITION_GAZEBO_VISIBLE ISystemUpdatePeriod {
+      /// \brief Minimum simulation time between updates.
+      /// \return The period. Zero means update on every step.
+      public: virtual std::chrono::steady_clock::duration
+                  UpdatePeriod() const = 0;
+    };
+
+    /// \class ISystemSheddable ISystem.hh ignition/gazebo/System.hh
+    /// \brief Interface marking a system as low priority for the real
+    /// time factor governor.
+    ///
+    /// When the governor is enabled (see
+    /// ServerConfig::SetRtfGovernorEnabled) and steps repeatedly overrun
+    /// their real time deadline, systems implementing this interface are
+    /// skipped until steps fit the deadline again, so the world slows
+    /// down predictably instead of dragging every system with it.
+    ///
+    /// Only systems whose absence doesn't change the dynamics should
+    /// implement this: visualization aids, diagnostics, loggers. Shed
+    /// systems are not notified; a throttled system's accumulated dt
+    /// keeps growing while it's shed, so integration stays exact once it
+    /// resumes.
+    class IGNITION_GAZEBO_VISIBLE ISystemSheddable {
+    };
+
+    /// \class ISystemStateHandoff ISystem.hh ignition/gazebo/System.hh
+    /// \brief Interface for a system that can hand its internal state
+    /// across a hot reload of its shared library.
+    ///
+    /// When a reload is requested through the world's `systems/reload`
+    /// service, the runner quiesces the system at a step boundary, asks
+    /// it to serialize its state, destroys the instance, reopens the
+    /// library from disk so a rebuilt binary is picked up, configures a
+    /// fresh instance and hands the buffer back. The buffer format is
+    /// owned entirely by the system; the old and new builds only have to
+    /// agree on it. Systems without this interface can still be
+    /// reloaded, but restart from their Configure state.
+    class IGNITION_GAZEBO_VISIBLE ISystemStateHandoff {
+      /// \brief Serialize the system's internal state before a reload.
+      /// \return An opaque buffer in a format of the system's choosing.
+      public: virtual std::string SaveState() const = 0;
+
+      /// \brief Restore state serialized by an earlier build.
+      /// \param[in] _state Buffer returned by SaveState.
+      public: virtual void RestoreState(const std::string &_state) = 0;
+    };
+
     /// \class ISystemPreUpdate ISystem.hh ignition/gazebo/System.hh
     /// \brief Interface for a system that uses the PreUpdate phase
     class IGNITION_GAZEBO_VISIBLE ISystemPreUpdate {
@@ -103,6 +190,33 @@ namespace ignition
                                   EntityComponentManager &_ecm) = 0;
     };
 
+    /// \class ISystemUpdateAccess ISystem.hh ignition/gazebo/System.hh
+    /// \brief Interface for a system that declares which component types
+    /// its Update callback reads and writes.
+    ///
+    /// Systems implementing this interface may be executed concurrently
+    /// with other declaring systems during the Update phase when their
+    /// access sets are compatible: a system's writes may not overlap
+    /// another system's reads or writes. Systems that do not implement
+    /// the interface always run exclusively, in the order they were
+    /// added.
+    ///
+    /// A declaring system must restrict its Update to the declared
+    /// component types, and must not create or remove entities or
+    /// components during Update. The declared sets are queried once when
+    /// the system is added and are expected to stay constant.
+    class IGNITION_GAZEBO_VISIBLE ISystemUpdateAccess {
+      /// \brief Component types read during Update.
+      /// \return The set of component type ids.
+      public: virtual std::unordered_set<ComponentTypeId>
+                  UpdateReadSet() const = 0;
+
+      /// \brief Component types written during Update.
+      /// \return The set of component type ids.
+      public: virtual std::unordered_set<ComponentTypeId>
+                  UpdateWriteSet() const = 0;
+    };
+
     /// \class ISystemPostUpdate ISystem.hh ignition/gazebo/System.hh
     /// \brief Interface for a system that uses the PostUpdate phase
     class IGNITION_GAZEBO_VISIBLE ISystemPostUpdate{
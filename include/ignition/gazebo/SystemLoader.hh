@@ -17,9 +17,12 @@
 #ifndef IGNITION_GAZEBO_SYSTEMLOADER_HH_
 #define IGNITION_GAZEBO_SYSTEMLOADER_HH_
 
+#include <chrono>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <sdf/Element.hh>
 
@@ -66,6 +69,31 @@ namespace ignition
                   const std::string &_name,
                   const sdf::ElementPtr &_sdf);
 
+      /// \brief Resolve and open the shared libraries for the given plugin
+      /// filenames without instantiating any system. Libraries are cached
+      /// process-wide, so later LoadPlugin calls for these plugins reduce
+      /// to a factory call. The IGN_GAZEBO_PRELOAD_PLUGINS environment
+      /// variable, a colon-separated list of filenames, triggers the same
+      /// preload when the first SystemLoader is created.
+      /// \param[in] _filenames Shared library filenames to preload.
+      public: void PreloadPlugins(const std::vector<std::string> &_filenames);
+
+      /// \brief Drop a shared library from the process-wide cache so the
+      /// next LoadPlugin for it resolves and opens the file on disk
+      /// again, picking up a rebuilt binary. The library is actually
+      /// closed only once every plugin instance created from it has been
+      /// destroyed, so callers must drop their SystemPluginPtrs first.
+      /// \param[in] _filename Plugin filename whose library to drop.
+      /// \return True if the library was cached and is now forgotten.
+      public: bool UnloadLibrary(const std::string &_filename);
+
+      /// \brief Get the time spent loading each plugin shared library in
+      /// this process, for startup profiling. Only the initial load of a
+      /// library is timed; cache hits cost nothing and are not recorded.
+      /// \return Map of plugin filename to load duration.
+      public: std::map<std::string, std::chrono::steady_clock::duration>
+                  PluginLoadTimes() const;
+
       /// \brief Makes a printable string with info about systems
       /// \returns A pretty string
       public: std::string PrettyStr() const;
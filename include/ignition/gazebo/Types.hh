@@ -31,6 +31,7 @@ namespace ignition
     inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     // Forward declarations.
     class EntityComponentManager;
+    class StepArena;
 
     /// \brief Information passed to systems on the update callback.
     /// \todo(louise) Update descriptions once reset is supported.
@@ -58,6 +59,13 @@ namespace ignition
       /// update state when paused is true.
       // cppcheck-suppress unusedStructMember
       bool paused{true};
+
+      /// \brief Arena for allocations that only live within the current
+      /// update phase. They are released in bulk when the phase
+      /// completes, so nothing allocated from it may outlive the update
+      /// call. Null when the host provides no arena, in which case
+      /// StepArenaAllocator degrades to the heap.
+      StepArena *arena{nullptr};
     };
 
     /// \brief Possible states for a component.
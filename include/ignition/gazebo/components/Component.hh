@@ -17,15 +17,19 @@
 #ifndef IGNITION_GAZEBO_COMPONENTS_COMPONENT_HH_
 #define IGNITION_GAZEBO_COMPONENTS_COMPONENT_HH_
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <sstream>
+#include <type_traits>
 #include <utility>
 
 #include <ignition/common/Console.hh>
 
 #include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/detail/ComponentPool.hh>
 #include <ignition/gazebo/Export.hh>
 #include <ignition/gazebo/Types.hh>
 
@@ -198,6 +202,24 @@ namespace serializers
   };
 }
 
+namespace traits
+{
+  /// \brief Type trait that determines whether a component's data can be
+  /// serialized as a raw copy of its bytes. This is the case for trivially
+  /// copyable data types that use the default serializer; a custom
+  /// serializer implies a custom wire format, so such types keep the
+  /// stream path.
+  /// \tparam DataType Type of the data wrapped by the component.
+  /// \tparam Serializer Serializer class used by the component.
+  template <typename DataType, typename Serializer>
+  struct IsRawCopyable
+  {
+    public: static constexpr bool value =  // NOLINT
+        std::is_trivially_copyable_v<DataType> &&
+        std::is_same_v<Serializer, serializers::DefaultSerializer<DataType>>;
+  };
+}
+
 namespace components
 {
   /// \brief Convenient type to be used by components that don't wrap any data.
@@ -270,6 +292,34 @@ namespace components
       }
     };
 
+    /// \brief Fills a string with a raw copy of the component's data bytes.
+    /// Only supported by components whose data satisfies
+    /// traits::IsRawCopyable; callers should fall back to Serialize when
+    /// this returns false.
+    /// \param[out] _out String to fill with the component's bytes.
+    /// \return True if the component supports raw serialization.
+    public: virtual bool SerializeRaw(std::string &/*_out*/) const
+    {
+      return false;
+    }
+
+    /// \brief Fills the component's data from a raw byte copy previously
+    /// produced by SerializeRaw. Callers should fall back to Deserialize
+    /// when this returns false, and must know from context that the
+    /// payload is a raw copy — such as the "raw_components" header tag
+    /// on state messages — since a text payload can coincidentally match
+    /// the data type's size.
+    /// \param[in] _data Pointer to the serialized bytes.
+    /// \param[in] _size Number of serialized bytes.
+    /// \return True if the data was consumed. False if the component
+    /// doesn't support raw serialization or if _size doesn't match the
+    /// data type's size.
+    public: virtual bool DeserializeRaw(const char * /*_data*/,
+                std::size_t /*_size*/)
+    {
+      return false;
+    }
+
     /// \brief Returns the unique ID for the component's type.
     /// The ID is derived from the name that is manually chosen during the
     /// Factory registration and is guaranteed to be the same across compilers
@@ -347,6 +397,13 @@ namespace components
     // Documentation inherited
     public: void Deserialize(std::istream &_in) override;
 
+    // Documentation inherited
+    public: bool SerializeRaw(std::string &_out) const override;
+
+    // Documentation inherited
+    public: bool DeserializeRaw(const char *_data,
+                std::size_t _size) override;
+
     /// \brief Get the mutable component data. This function will be
     /// deprecated in Gazebo 3, replaced by const DataType &Data() const.
     /// Use void SetData(const DataType &) to modify data.
@@ -368,6 +425,19 @@ namespace components
     /// \return Immutable reference to the actual component information.
     public: const DataType &Data() const;
 
+    /// \brief Allocate an instance from this component type's slab pool
+    /// instead of the global heap. Instances of a type are created in
+    /// bulk when worlds load, so pooling makes creation a free-list pop
+    /// and keeps allocator contention per-type.
+    public: static void *operator new(std::size_t _size);
+
+    /// \brief Return an instance to this component type's slab pool.
+    public: static void operator delete(void *_ptr,
+                std::size_t _size) noexcept;
+
+    /// \brief Get the slab pool shared by all instances of this type.
+    private: static detail::ComponentPool &Pool();
+
     /// \brief Private data pointer.
     private: DataType data;
 
@@ -414,6 +484,17 @@ namespace components
     // Documentation inherited
     public: void Deserialize(std::istream &_in) override;
 
+    /// \brief Allocate an instance from this component type's slab pool.
+    /// See the primary template for details.
+    public: static void *operator new(std::size_t _size);
+
+    /// \brief Return an instance to this component type's slab pool.
+    public: static void operator delete(void *_ptr,
+                std::size_t _size) noexcept;
+
+    /// \brief Get the slab pool shared by all instances of this type.
+    private: static detail::ComponentPool &Pool();
+
     /// \brief Unique ID for this component type. This is set through the
     /// Factory registration.
     public: inline static ComponentTypeId typeId{0};
@@ -430,6 +511,40 @@ namespace components
   {
   }
 
+  //////////////////////////////////////////////////
+  template <typename DataType, typename Identifier, typename Serializer>
+  void *Component<DataType, Identifier, Serializer>::operator new(
+      std::size_t _size)
+  {
+    // A derived type with a different size can't live in this type's
+    // slots, so let it use the global heap.
+    if (_size != sizeof(Component))
+      return ::operator new(_size);
+    return Pool().Allocate();
+  }
+
+  //////////////////////////////////////////////////
+  template <typename DataType, typename Identifier, typename Serializer>
+  void Component<DataType, Identifier, Serializer>::operator delete(
+      void *_ptr, std::size_t _size) noexcept
+  {
+    if (_size != sizeof(Component))
+    {
+      ::operator delete(_ptr);
+      return;
+    }
+    Pool().Deallocate(_ptr);
+  }
+
+  //////////////////////////////////////////////////
+  template <typename DataType, typename Identifier, typename Serializer>
+  detail::ComponentPool &
+  Component<DataType, Identifier, Serializer>::Pool()
+  {
+    static detail::ComponentPool pool(sizeof(Component));
+    return pool;
+  }
+
   //////////////////////////////////////////////////
   template <typename DataType, typename Identifier, typename Serializer>
   DataType &Component<DataType, Identifier, Serializer>::Data()
@@ -487,6 +602,41 @@ namespace components
     Serializer::Deserialize(_in, this->Data());
   }
 
+  //////////////////////////////////////////////////
+  template <typename DataType, typename Identifier, typename Serializer>
+  bool Component<DataType, Identifier, Serializer>::SerializeRaw(
+      std::string &_out) const
+  {
+    if constexpr (traits::IsRawCopyable<DataType, Serializer>::value)
+    {
+      _out.resize(sizeof(DataType));
+      std::memcpy(_out.data(), &this->data, sizeof(DataType));
+      return true;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  //////////////////////////////////////////////////
+  template <typename DataType, typename Identifier, typename Serializer>
+  bool Component<DataType, Identifier, Serializer>::DeserializeRaw(
+      const char *_data, std::size_t _size)
+  {
+    if constexpr (traits::IsRawCopyable<DataType, Serializer>::value)
+    {
+      if (_size != sizeof(DataType))
+        return false;
+      std::memcpy(&this->data, _data, sizeof(DataType));
+      return true;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
   //////////////////////////////////////////////////
   template <typename DataType, typename Identifier, typename Serializer>
   ComponentTypeId Component<DataType, Identifier, Serializer>::TypeId() const
@@ -494,6 +644,38 @@ namespace components
     return typeId;
   }
 
+  //////////////////////////////////////////////////
+  template <typename Identifier, typename Serializer>
+  void *Component<NoData, Identifier, Serializer>::operator new(
+      std::size_t _size)
+  {
+    if (_size != sizeof(Component))
+      return ::operator new(_size);
+    return Pool().Allocate();
+  }
+
+  //////////////////////////////////////////////////
+  template <typename Identifier, typename Serializer>
+  void Component<NoData, Identifier, Serializer>::operator delete(
+      void *_ptr, std::size_t _size) noexcept
+  {
+    if (_size != sizeof(Component))
+    {
+      ::operator delete(_ptr);
+      return;
+    }
+    Pool().Deallocate(_ptr);
+  }
+
+  //////////////////////////////////////////////////
+  template <typename Identifier, typename Serializer>
+  detail::ComponentPool &
+  Component<NoData, Identifier, Serializer>::Pool()
+  {
+    static detail::ComponentPool pool(sizeof(Component));
+    return pool;
+  }
+
   //////////////////////////////////////////////////
   template <typename Identifier, typename Serializer>
   bool Component<NoData, Identifier, Serializer>::operator==(
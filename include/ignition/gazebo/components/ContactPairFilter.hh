@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_GAZEBO_COMPONENTS_CONTACTPAIRFILTER_HH_
+#define IGNITION_GAZEBO_COMPONENTS_CONTACTPAIRFILTER_HH_
+
+#include <iterator>
+#include <vector>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Export.hh>
+
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/components/Factory.hh"
+#include "ignition/gazebo/components/Component.hh"
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace serializers
+{
+  class ContactPairFilterSerializer
+  {
+    /// \brief Serialization for `std::vector<Entity>`.
+    /// \param[in] _out Output stream.
+    /// \param[in] _entities Entities to stream
+    /// \return The stream.
+    public: static std::ostream &Serialize(std::ostream &_out,
+                                           const std::vector<Entity> &_entities)
+    {
+      for (const auto &entity : _entities)
+      {
+        _out << entity << " ";
+      }
+      return _out;
+    }
+
+    /// \brief Deserialization for `std::vector<Entity>`.
+    /// \param[in] _in Input stream.
+    /// \param[out] _entities Entities to populate
+    /// \return The stream.
+    public: static std::istream &Deserialize(std::istream &_in,
+                                             std::vector<Entity> &_entities)
+    {
+      _in.setf(std::ios_base::skipws);
+
+      _entities.clear();
+
+      for (auto it = std::istream_iterator<Entity>(_in);
+           it != std::istream_iterator<Entity>(); ++it)
+      {
+        _entities.push_back(*it);
+      }
+      return _in;
+    }
+  };
+}
+
+namespace components
+{
+  /// \brief Sorted list of collision entities whose contacts against the
+  /// collision holding this component should be reported in its
+  /// ContactSensorData. Contacts with any other collision are dropped by
+  /// the physics system, so systems that only care about a few pairs can
+  /// skip the cost of copying every manifold. Collisions without this
+  /// component keep reporting all of their contacts.
+  using ContactPairFilter = Component<std::vector<Entity>,
+                                      class ContactPairFilterTag,
+                                      serializers::ContactPairFilterSerializer>;
+  IGN_GAZEBO_REGISTER_COMPONENT("ign_gazebo_components.ContactPairFilter",
+      ContactPairFilter)
+}
+}
+}
+}
+#endif
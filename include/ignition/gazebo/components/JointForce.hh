@@ -17,12 +17,11 @@
 #ifndef IGNITION_GAZEBO_COMPONENTS_JOINTFORCE_HH_
 #define IGNITION_GAZEBO_COMPONENTS_JOINTFORCE_HH_
 
-#include <vector>
-
 #include <ignition/gazebo/components/Factory.hh>
 #include <ignition/gazebo/components/Component.hh>
 #include <ignition/gazebo/components/Serialization.hh>
 #include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/detail/SmallVector.hh>
 
 namespace ignition
 {
@@ -33,8 +32,10 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
 namespace components
 {
   /// \brief Force applied to a joint  in SI units (Nm for revolute, N for
-  /// prismatic).
-  using JointForce = Component<std::vector<double>, class JointForceTag,
+  /// prismatic). The component wraps a vector of size equal to the degrees
+  /// of freedom of the joint, stored inline for up to 6 DOF.
+  using JointForce = Component<detail::SmallVector<double, 6>,
+                               class JointForceTag,
                                serializers::VectorDoubleSerializer>;
   IGN_GAZEBO_REGISTER_COMPONENT(
       "ign_gazebo_components.JointForce", JointForce)
@@ -17,11 +17,10 @@
 #ifndef IGNITION_GAZEBO_COMPONENTS_JOINTFORCECMD_HH_
 #define IGNITION_GAZEBO_COMPONENTS_JOINTFORCECMD_HH_
 
-#include <vector>
-
 #include <ignition/gazebo/components/Factory.hh>
 #include <ignition/gazebo/components/Component.hh>
 #include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/detail/SmallVector.hh>
 
 namespace ignition
 {
@@ -33,9 +32,11 @@ namespace components
 {
   /// \brief Commanded joint forces (or torques) to be applied to a joint
   /// in SI units (Nm for revolute, N for prismatic). The component wraps a
-  /// std::vector and systems that set this component need to ensure that the
-  /// vector has the same size as the degrees of freedom of the joint.
-  using JointForceCmd = Component<std::vector<double>, class JointForceCmdTag>;
+  /// vector, stored inline for up to 6 DOF, and systems that set this
+  /// component need to ensure that the vector has the same size as the
+  /// degrees of freedom of the joint.
+  using JointForceCmd = Component<detail::SmallVector<double, 6>,
+                                  class JointForceCmdTag>;
   IGN_GAZEBO_REGISTER_COMPONENT("ign_gazebo_components.JointForceCmd",
                                 JointForceCmd)
 }
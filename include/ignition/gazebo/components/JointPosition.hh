@@ -17,12 +17,11 @@
 #ifndef IGNITION_GAZEBO_COMPONENTS_JOINTPOSITION_HH_
 #define IGNITION_GAZEBO_COMPONENTS_JOINTPOSITION_HH_
 
-#include <vector>
-
 #include <ignition/gazebo/components/Factory.hh>
 #include <ignition/gazebo/components/Component.hh>
 #include <ignition/gazebo/components/Serialization.hh>
 #include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/detail/SmallVector.hh>
 
 namespace ignition
 {
@@ -33,9 +32,11 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
 namespace components
 {
   /// \brief Joint positions in SI units (rad for revolute, m for prismatic).
-  /// The component wraps a std::vector of size equal to the degrees of freedom
-  /// of the joint.
-  using JointPosition = Component<std::vector<double>, class JointPositionTag,
+  /// The component wraps a vector of size equal to the degrees of freedom of
+  /// the joint, stored inline for up to 6 DOF so sweeps over joint state
+  /// don't chase a heap pointer per entity.
+  using JointPosition = Component<detail::SmallVector<double, 6>,
+                                  class JointPositionTag,
                                   serializers::VectorDoubleSerializer>;
   IGN_GAZEBO_REGISTER_COMPONENT(
       "ign_gazebo_components.JointPosition", JointPosition)
@@ -17,12 +17,11 @@
 #ifndef IGNITION_GAZEBO_COMPONENTS_JOINTVELOCITYCMD_HH_
 #define IGNITION_GAZEBO_COMPONENTS_JOINTVELOCITYCMD_HH_
 
-#include <vector>
-
 #include <ignition/gazebo/components/Component.hh>
 #include <ignition/gazebo/components/Factory.hh>
 #include <ignition/gazebo/components/Serialization.hh>
 #include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/detail/SmallVector.hh>
 #include <ignition/gazebo/Export.hh>
 
 namespace ignition
@@ -33,9 +32,12 @@ namespace gazebo
 inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
 namespace components
 {
-  /// \brief Base class which can be extended to add serialization
+  /// \brief Commanded joint velocities in SI units
+  ///        (rad/s for revolute, m/s for prismatic).
+  /// The component wraps a vector of size equal to the degrees of freedom of
+  /// the joint, stored inline for up to 6 DOF.
   using JointVelocityCmd =
-      Component<std::vector<double>, class JointVelocityCmdTag,
+      Component<detail::SmallVector<double, 6>, class JointVelocityCmdTag,
                 serializers::VectorDoubleSerializer>;
 
   IGN_GAZEBO_REGISTER_COMPONENT(
@@ -17,12 +17,11 @@
 #ifndef IGNITION_GAZEBO_COMPONENTS_JOINTVELOCITYRESET_HH_
 #define IGNITION_GAZEBO_COMPONENTS_JOINTVELOCITYRESET_HH_
 
-#include <vector>
-
 #include <ignition/gazebo/components/Component.hh>
 #include <ignition/gazebo/components/Factory.hh>
 #include <ignition/gazebo/components/Serialization.hh>
 #include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/detail/SmallVector.hh>
 
 namespace ignition
 {
@@ -35,9 +34,9 @@ namespace components
   /// \brief Joint velocities in SI units
   ///        (rad/s for revolute, m/s for prismatic).
   ///
-  /// The component wraps a std::vector of size equal to the degrees of freedom
-  /// of the joint.
-  using JointVelocityReset = Component<std::vector<double>,
+  /// The component wraps a vector of size equal to the degrees of freedom
+  /// of the joint, stored inline for up to 6 DOF.
+  using JointVelocityReset = Component<detail::SmallVector<double, 6>,
                                        class JointVelocityResetTag,
                                        serializers::VectorDoubleSerializer>;
   IGN_GAZEBO_REGISTER_COMPONENT(
@@ -101,15 +101,18 @@ namespace serializers
   /// \brief Common serializer for sensors
   using SensorSerializer = ComponentToMsgSerializer<sdf::Sensor, msgs::Sensor>;
 
-  /// \brief Serializer for components that hold `std::vector<double>`.
+  /// \brief Serializer for components that hold a vector of doubles,
+  /// either a `std::vector<double>` or a fixed-inline-capacity
+  /// `detail::SmallVector<double, N>`.
   class VectorDoubleSerializer
   {
     /// \brief Serialization
     /// \param[in] _out Output stream.
     /// \param[in] _vec Vector to stream
     /// \return The stream.
-    public: static std::ostream &Serialize(std::ostream &_out,
-                                           const std::vector<double> &_vec)
+    public: template <typename VectorT>
+            static std::ostream &Serialize(std::ostream &_out,
+                                           const VectorT &_vec)
     {
       ignition::msgs::Double_V msg;
       *msg.mutable_data() = {_vec.begin(), _vec.end()};
@@ -121,13 +124,14 @@ namespace serializers
     /// \param[in] _in Input stream.
     /// \param[in] _vec Vector to populate
     /// \return The stream.
-    public: static std::istream &Deserialize(std::istream &_in,
-                                             std::vector<double> &_vec)
+    public: template <typename VectorT>
+            static std::istream &Deserialize(std::istream &_in,
+                                             VectorT &_vec)
     {
       ignition::msgs::Double_V msg;
       msg.ParseFromIstream(&_in);
 
-      _vec = {msg.data().begin(), msg.data().end()};
+      _vec.assign(msg.data().begin(), msg.data().end());
       return _in;
     }
   };
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_DETAIL_COMPONENTPOOL_HH_
+#define IGNITION_GAZEBO_DETAIL_COMPONENTPOOL_HH_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ignition/gazebo/config.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    namespace detail
+    {
+    /// \brief A slab allocator for component instances of a single type.
+    /// Components created through components::Factory::New() are allocated
+    /// individually on the heap, which dominates large world loads. This
+    /// pool hands out fixed-size slots carved from larger slabs, so
+    /// allocation is popping a free-list head and deallocation pushes the
+    /// slot back. Slabs are only returned to the operating system when the
+    /// pool is destroyed.
+    class ComponentPool
+    {
+      /// \brief Constructor.
+      /// \param[in] _slotSize Size of each slot, typically
+      /// sizeof(ComponentTypeT). Slots are rounded up so that every slot
+      /// in a slab is suitably aligned.
+      public: explicit ComponentPool(std::size_t _slotSize)
+      {
+        const std::size_t align = alignof(std::max_align_t);
+        if (_slotSize < sizeof(void *))
+          _slotSize = sizeof(void *);
+        this->slotSize = (_slotSize + align - 1) / align * align;
+      }
+
+      /// \brief Allocate one slot.
+      /// \return Pointer to an uninitialized slot of the configured size.
+      public: void *Allocate()
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (nullptr == this->freeList)
+          this->AllocateSlab();
+
+        void *slot = this->freeList;
+        this->freeList = *static_cast<void **>(slot);
+        return slot;
+      }
+
+      /// \brief Return a slot to the pool.
+      /// \param[in] _ptr Pointer previously obtained from Allocate().
+      public: void Deallocate(void *_ptr)
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        *static_cast<void **>(_ptr) = this->freeList;
+        this->freeList = _ptr;
+      }
+
+      /// \brief Carve a new slab into free slots. The caller must hold
+      /// the mutex.
+      private: void AllocateSlab()
+      {
+        auto slab = std::make_unique<char[]>(this->slotSize * kSlabSlots);
+        char *base = slab.get();
+        for (std::size_t i = 0; i < kSlabSlots; ++i)
+        {
+          void *slot = base + i * this->slotSize;
+          *static_cast<void **>(slot) = this->freeList;
+          this->freeList = slot;
+        }
+        this->slabs.push_back(std::move(slab));
+      }
+
+      /// \brief Number of slots carved from each slab.
+      private: static constexpr std::size_t kSlabSlots{256};
+
+      /// \brief Size of each slot, rounded up for alignment.
+      private: std::size_t slotSize{0};
+
+      /// \brief Head of the intrusive free list. Each free slot stores the
+      /// pointer to the next free slot in its first bytes.
+      private: void *freeList{nullptr};
+
+      /// \brief All the slabs owned by this pool.
+      private: std::vector<std::unique_ptr<char[]>> slabs;
+
+      /// \brief Protects the free list. Contention is limited to this
+      /// component type instead of the global allocator lock.
+      private: std::mutex mutex;
+    };
+    }
+    }
+  }
+}
+
+#endif
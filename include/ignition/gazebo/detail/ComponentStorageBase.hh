@@ -17,10 +17,13 @@
 #ifndef IGNITION_GAZEBO_DETAIL_COMPONENTSTORAGEBASE_HH_
 #define IGNITION_GAZEBO_DETAIL_COMPONENTSTORAGEBASE_HH_
 
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <utility>
 #include <vector>
 #include "ignition/gazebo/components/Component.hh"
+#include "ignition/gazebo/Entity.hh"
 #include "ignition/gazebo/Export.hh"
 #include "ignition/gazebo/Types.hh"
 
@@ -43,11 +46,13 @@ namespace ignition
       public: virtual ~ComponentStorageBase() = default;
 
       /// \brief Create a new component using the provided data.
+      /// \param[in] _entity Entity that will own the component.
       /// \param[in] _data Data used to construct the component.
       /// \return Id of the new component, and whether the components array
       /// was expanded. kComponentIdInvalid is returned
       /// if the component could not be created.
       public: virtual std::pair<ComponentId, bool> Create(
+                  const Entity _entity,
                   const components::BaseComponent *_data) = 0;
 
       /// \brief Remove a component based on an id.
@@ -76,6 +81,24 @@ namespace ignition
       /// \return First component or nullptr if there are no components.
       public: virtual components::BaseComponent *First() = 0;
 
+      /// \brief Get the approximate number of bytes held by this storage,
+      /// including reserved vector capacity and id map overhead. Heap
+      /// memory owned by individual components (strings, messages) is not
+      /// counted.
+      /// \return Approximate bytes held by this storage.
+      public: virtual std::size_t MemoryUsage() const = 0;
+
+      /// \brief Get the number of components in this storage.
+      /// \return Number of components.
+      public: virtual std::size_t Size() const = 0;
+
+      /// \brief Deep-copy this storage, including removed slots awaiting
+      /// compaction, so handed-out component ids stay valid in the copy.
+      /// Used by EntityComponentManager::Clone to detach storages that
+      /// are shared between a manager and its clone.
+      /// \return A new storage holding copies of all components.
+      public: virtual std::unique_ptr<ComponentStorageBase> Clone() const = 0;
+
       /// \brief Mutex used to prevent data corruption.
       protected: mutable std::mutex mutex;
     };
@@ -112,32 +135,25 @@ namespace ignition
         // Make sure the component exists.
         if (iter != this->idMap.end())
         {
-          // Handle the case where there are more components than the
-          // component to be removed
-          if (this->components.size() > 1)
-          {
-            // Swap the component to be removed with the component at the
-            // back of the vector.
-            std::swap(this->components[iter->second],
-                      this->components.back());
-
-            // After the swap, we have to fix all the id mappings.
-            for (auto idIter =this->idMap.begin();
-                idIter != this->idMap.end(); ++idIter)
-            {
-              if (static_cast<unsigned int>(idIter->second) ==
-                  this->components.size()-1)
-              {
-                idIter->second = iter->second;
-              }
-            }
-          }
-
-          // Remove the component.
-          this->components.pop_back();
+          // Tombstone the slot instead of compacting the vector on every
+          // removal: a null owner marks the slot dead, so live components
+          // keep their indexes and removal stays cheap under churn, e.g.
+          // from command components created and removed every step. The
+          // dead slot keeps its value until compaction reclaims it.
+          this->owners[iter->second] = kNullEntity;
+          ++this->tombstones;
 
           // Remove the id mapping.
           this->idMap.erase(iter);
+
+          // Batch-compact once fragmentation passes a threshold, so the
+          // cost of moving live components is amortized over many
+          // removals and sweeps don't degrade into skipping dead slots.
+          if (this->tombstones >= 64 &&
+              this->tombstones * 4 >= this->components.size())
+          {
+            this->Compact();
+          }
           return true;
         }
         return false;
@@ -147,12 +163,15 @@ namespace ignition
       public: void RemoveAll() final
       {
         this->idCounter = 0;
+        this->tombstones = 0;
         this->idMap.clear();
         this->components.clear();
+        this->owners.clear();
       }
 
       // Documentation inherited.
       public: std::pair<ComponentId, bool> Create(
+                  const Entity _entity,
                   const components::BaseComponent *_data) final
       {
         ComponentId result;  // = kComponentIdInvalid;
@@ -171,6 +190,7 @@ namespace ignition
         // Copy the component
         this->components.push_back(std::move(
               ComponentTypeT(*static_cast<const ComponentTypeT *>(_data))));
+        this->owners.push_back(_entity);
 
         return {result, expanded};
       }
@@ -202,20 +222,100 @@ namespace ignition
       public: components::BaseComponent *First() final
       {
         std::lock_guard<std::mutex> lock(this->mutex);
-        if (!this->components.empty())
-          return static_cast<components::BaseComponent *>(&this->components[0]);
+        for (std::size_t i = 0; i < this->components.size(); ++i)
+        {
+          if (this->owners[i] != kNullEntity)
+          {
+            return static_cast<components::BaseComponent *>(
+                &this->components[i]);
+          }
+        }
         return nullptr;
       }
 
+      // Documentation inherited.
+      public: std::size_t MemoryUsage() const final
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        // Count capacity rather than size, since reserved slots are
+        // resident memory too. Map nodes carry roughly four pointers of
+        // bookkeeping on top of their value.
+        return sizeof(*this) +
+            this->components.capacity() * sizeof(ComponentTypeT) +
+            this->owners.capacity() * sizeof(Entity) +
+            this->idMap.size() * (sizeof(std::pair<const ComponentId, int>) +
+            4 * sizeof(void *));
+      }
+
+      // Documentation inherited.
+      public: std::size_t Size() const final
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->components.size() - this->tombstones;
+      }
+
+      // Documentation inherited.
+      public: std::unique_ptr<ComponentStorageBase> Clone() const final
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto clone = std::make_unique<ComponentStorage<ComponentTypeT>>();
+        clone->idCounter = this->idCounter;
+        clone->tombstones = this->tombstones;
+        clone->idMap = this->idMap;
+        clone->components = this->components;
+        clone->owners = this->owners;
+        return clone;
+      }
+
+      /// \brief Move live components down over the dead slots, drop the
+      /// tail, and remap the id mappings to the new indexes. Ids handed
+      /// out by Create stay valid since they only resolve through the id
+      /// map. Must be called with the mutex held.
+      private: void Compact()
+      {
+        std::vector<int> newIndex(this->components.size(), -1);
+        std::size_t dst = 0;
+        for (std::size_t src = 0; src < this->components.size(); ++src)
+        {
+          if (kNullEntity == this->owners[src])
+            continue;
+          if (dst != src)
+          {
+            this->components[dst] = std::move(this->components[src]);
+            this->owners[dst] = this->owners[src];
+          }
+          newIndex[src] = static_cast<int>(dst);
+          ++dst;
+        }
+        this->components.resize(dst);
+        this->owners.resize(dst);
+
+        for (auto &entry : this->idMap)
+          entry.second = newIndex[entry.second];
+
+        this->tombstones = 0;
+      }
+
       /// \brief The id counter is used to get unique ids within this
       /// storage class.
       private: ComponentId idCounter = 0;
 
+      /// \brief Number of dead slots in the components vector. See
+      /// Remove and Compact.
+      private: std::size_t tombstones = 0;
+
       /// \brief Map of ComponentId to Components (see the components vector).
       private: std::map<ComponentId, int> idMap;
 
       /// \brief Sequential storage of components.
       public: std::vector<ComponentTypeT> components;
+
+      /// \brief Entity that owns each component, parallel to the
+      /// components vector. This allows bulk passes over the contiguous
+      /// component array to report the owning entity without going back
+      /// through the per-entity bookkeeping. A null entity marks a dead
+      /// slot awaiting compaction; bulk passes must skip those.
+      public: std::vector<Entity> owners;
     };
     }
   }
@@ -17,12 +17,17 @@
 #ifndef IGNITION_GAZEBO_DETAIL_ENTITYCOMPONENTMANAGER_HH_
 #define IGNITION_GAZEBO_DETAIL_ENTITYCOMPONENTMANAGER_HH_
 
+#include <algorithm>
 #include <cstring>
+#include <functional>
 #include <map>
 #include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/detail/ComponentStorageBase.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 
 namespace ignition
@@ -38,6 +43,23 @@ ComponentKey EntityComponentManager::CreateComponent(const Entity _entity,
       &_data);
 }
 
+//////////////////////////////////////////////////
+template<typename... ComponentTypeTs>
+void EntityComponentManager::CreateComponents(const Entity _entity,
+    const ComponentTypeTs &..._data)
+{
+  // Create all the components first, then reconcile the views once for
+  // the whole batch.
+  bool rebuildViews{false};
+  (this->CreateComponentImplementation(_entity, ComponentTypeTs::typeId,
+      &_data, rebuildViews), ...);
+
+  if (rebuildViews)
+    this->RebuildViews();
+  else
+    this->UpdateViews(_entity);
+}
+
 //////////////////////////////////////////////////
 template<typename ComponentTypeT>
 const ComponentTypeT *EntityComponentManager::Component(
@@ -99,6 +121,48 @@ template<typename ...ComponentTypeTs>
 Entity EntityComponentManager::EntityByComponents(
     const ComponentTypeTs &..._desiredComponents) const
 {
+  // When a name component is part of the query, start from the name
+  // index instead of scanning a view: the index narrows the candidates
+  // to the handful of entities sharing the name, typically one.
+  if constexpr ((std::is_same_v<ComponentTypeTs, components::Name> || ...))
+  {
+    const components::Name *desiredName{nullptr};
+    ForEach([&](const auto &_desiredComponent)
+    {
+      if constexpr (std::is_same_v<std::remove_cv_t<std::remove_reference_t<
+          decltype(_desiredComponent)>>, components::Name>)
+      {
+        desiredName = &_desiredComponent;
+      }
+    }, _desiredComponents...);
+
+    static const auto types =
+        std::set<ComponentTypeId>{ComponentTypeTs::typeId...};
+    for (const Entity entity : this->EntitiesByName(desiredName->Data()))
+    {
+      // The candidate must also hold the other queried component types.
+      if (this->IsTombstoned(entity) || !this->EntityMatches(entity, types))
+        continue;
+
+      bool different{false};
+      ForEach([&](const auto &_desiredComponent)
+      {
+        auto entityComponent = this->Component<
+            std::remove_cv_t<std::remove_reference_t<
+                decltype(_desiredComponent)>>>(entity);
+
+        if (*entityComponent != _desiredComponent)
+        {
+          different = true;
+        }
+      }, _desiredComponents...);
+
+      if (!different)
+        return entity;
+    }
+    return kNullEntity;
+  }
+
   // Get all entities which have components of the desired types
   const auto &view = this->FindView<ComponentTypeTs...>();
 
@@ -225,12 +289,14 @@ template<typename ...ComponentTypeTs>
 void EntityComponentManager::EachNoCache(typename identity<std::function<
     bool(const Entity &_entity, const ComponentTypeTs *...)>>::type _f) const
 {
+  static const auto types =
+      std::set<ComponentTypeId>{ComponentTypeTs::typeId...};
+
   for (const auto &vertex : this->Entities().Vertices())
   {
     Entity entity = vertex.first;
-    auto types = std::set<ComponentTypeId>{ComponentTypeTs::typeId...};
 
-    if (this->EntityMatches(entity, types))
+    if (!this->IsTombstoned(entity) && this->EntityMatches(entity, types))
     {
       if (!_f(entity,
               this->Component<ComponentTypeTs>(entity)...))
@@ -246,12 +312,14 @@ template<typename ...ComponentTypeTs>
 void EntityComponentManager::EachNoCache(typename identity<std::function<
     bool(const Entity &_entity, ComponentTypeTs *...)>>::type _f)
 {
+  static const auto types =
+      std::set<ComponentTypeId>{ComponentTypeTs::typeId...};
+
   for (const auto &vertex : this->Entities().Vertices())
   {
     Entity entity = vertex.first;
-    auto types = std::set<ComponentTypeId>{ComponentTypeTs::typeId...};
 
-    if (this->EntityMatches(entity, types))
+    if (!this->IsTombstoned(entity) && this->EntityMatches(entity, types))
     {
       if (!_f(entity,
               this->Component<ComponentTypeTs>(entity)...))
@@ -291,6 +359,11 @@ void EntityComponentManager::Each(typename identity<std::function<
   // exist.
   detail::View &view = this->FindView<ComponentTypeTs...>();
 
+  // Writable iteration: detach any storage still shared with a cloned
+  // manager before handing out mutable component pointers.
+  if (this->HasSharedStorages())
+    (this->Storage(ComponentTypeTs::typeId), ...);
+
   // Iterate over the entities in the view, and invoke the callback
   // function.
   for (const Entity entity : view.entities)
@@ -302,6 +375,172 @@ void EntityComponentManager::Each(typename identity<std::function<
   }
 }
 
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachActive(typename identity<std::function<
+    bool(const Entity &_entity, const ComponentTypeTs *...)>>::type _f) const
+{
+  // Get the view. This will create a new view if one does not already
+  // exist.
+  detail::View &view = this->FindView<ComponentTypeTs...>();
+
+  // Iterate over the entities in the view, skipping the partition of
+  // entities that belong only to buffered levels. The partition is
+  // empty unless level streaming is in use.
+  for (const Entity entity : view.entities)
+  {
+    if (!view.bufferedEntities.empty() &&
+        view.bufferedEntities.find(entity) != view.bufferedEntities.end())
+    {
+      continue;
+    }
+    if (!_f(entity, view.Component<ComponentTypeTs>(entity, this)...))
+    {
+      break;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachActive(typename identity<std::function<
+    bool(const Entity &_entity, ComponentTypeTs *...)>>::type _f)
+{
+  // Get the view. This will create a new view if one does not already
+  // exist.
+  detail::View &view = this->FindView<ComponentTypeTs...>();
+
+  // Writable iteration: detach any storage still shared with a cloned
+  // manager before handing out mutable component pointers.
+  if (this->HasSharedStorages())
+    (this->Storage(ComponentTypeTs::typeId), ...);
+
+  // Iterate over the entities in the view, skipping the partition of
+  // entities that belong only to buffered levels. The partition is
+  // empty unless level streaming is in use.
+  for (const Entity entity : view.entities)
+  {
+    if (!view.bufferedEntities.empty() &&
+        view.bufferedEntities.find(entity) != view.bufferedEntities.end())
+    {
+      continue;
+    }
+    if (!_f(entity, view.Component<ComponentTypeTs>(entity, this)...))
+    {
+      break;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachParallel(typename identity<std::function<
+    void(const Entity &_entity, const ComponentTypeTs *...)>>::type _f) const
+{
+  // Get the view. This will create a new view if one does not already
+  // exist.
+  detail::View &view = this->FindView<ComponentTypeTs...>();
+
+  // Copy the entities into a vector so that ranges of them can be
+  // partitioned across workers.
+  const std::vector<Entity> entities(view.entities.begin(),
+      view.entities.end());
+  if (entities.empty())
+    return;
+
+  size_t workers = std::thread::hardware_concurrency();
+  workers = std::min(std::max<size_t>(workers, 1u), entities.size());
+
+  // Fall back to sequential iteration when there's nothing to be gained
+  // from dispatching to the pool.
+  if (workers < 2)
+  {
+    for (const Entity entity : entities)
+      _f(entity, view.Component<ComponentTypeTs>(entity, this)...);
+    return;
+  }
+
+  // Resolve the view's storage caches on this thread before dispatching,
+  // so that the workers only perform read accesses on the view.
+  std::initializer_list<const void *>{
+      view.Component<ComponentTypeTs>(entities.front(), this)...};
+
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(workers);
+  const size_t chunkSize = (entities.size() + workers - 1) / workers;
+  for (size_t start = 0; start < entities.size(); start += chunkSize)
+  {
+    const size_t end = std::min(start + chunkSize, entities.size());
+    tasks.push_back([this, &_f, &entities, &view, start, end] ()
+    {
+      for (size_t i = start; i < end; ++i)
+      {
+        _f(entities[i],
+           view.Component<ComponentTypeTs>(entities[i], this)...);
+      }
+    });
+  }
+
+  this->RunParallel(tasks);
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachParallel(typename identity<std::function<
+    void(const Entity &_entity, ComponentTypeTs *...)>>::type _f)
+{
+  // Get the view. This will create a new view if one does not already
+  // exist.
+  detail::View &view = this->FindView<ComponentTypeTs...>();
+
+  // Writable iteration: detach any storage still shared with a cloned
+  // manager before handing out mutable component pointers.
+  if (this->HasSharedStorages())
+    (this->Storage(ComponentTypeTs::typeId), ...);
+
+  // Copy the entities into a vector so that ranges of them can be
+  // partitioned across workers.
+  const std::vector<Entity> entities(view.entities.begin(),
+      view.entities.end());
+  if (entities.empty())
+    return;
+
+  size_t workers = std::thread::hardware_concurrency();
+  workers = std::min(std::max<size_t>(workers, 1u), entities.size());
+
+  // Fall back to sequential iteration when there's nothing to be gained
+  // from dispatching to the pool.
+  if (workers < 2)
+  {
+    for (const Entity entity : entities)
+      _f(entity, view.Component<ComponentTypeTs>(entity, this)...);
+    return;
+  }
+
+  // Resolve the view's storage caches on this thread before dispatching,
+  // so that the workers only perform read accesses on the view.
+  std::initializer_list<const void *>{
+      view.Component<ComponentTypeTs>(entities.front(), this)...};
+
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(workers);
+  const size_t chunkSize = (entities.size() + workers - 1) / workers;
+  for (size_t start = 0; start < entities.size(); start += chunkSize)
+  {
+    const size_t end = std::min(start + chunkSize, entities.size());
+    tasks.push_back([this, &_f, &entities, &view, start, end] ()
+    {
+      for (size_t i = start; i < end; ++i)
+      {
+        _f(entities[i],
+           view.Component<ComponentTypeTs>(entities[i], this)...);
+      }
+    });
+  }
+
+  this->RunParallel(tasks);
+}
+
 //////////////////////////////////////////////////
 template <class Function, class... ComponentTypeTs>
 void EntityComponentManager::ForEach(Function _f,
@@ -319,6 +558,15 @@ void EntityComponentManager::EachNew(typename identity<std::function<
   // exist.
   detail::View &view = this->FindView<ComponentTypeTs...>();
 
+  // Writable iteration: detach any storage still shared with a cloned
+  // manager before handing out mutable component pointers.
+  if (this->HasSharedStorages())
+    (this->Storage(ComponentTypeTs::typeId), ...);
+
+  // Delta tracking is subscription based; the first call turns it on for
+  // this view.
+  view.SubscribeNewRemoved(this);
+
   // Iterate over the entities in the view and in the newly created
   // entities list, and invoke the callback
   // function.
@@ -340,6 +588,10 @@ void EntityComponentManager::EachNew(typename identity<std::function<
   // exist.
   detail::View &view = this->FindView<ComponentTypeTs...>();
 
+  // Delta tracking is subscription based; the first call turns it on for
+  // this view.
+  view.SubscribeNewRemoved(this);
+
   // Iterate over the entities in the view and in the newly created
   // entities list, and invoke the callback
   // function.
@@ -361,6 +613,10 @@ void EntityComponentManager::EachRemoved(typename identity<std::function<
   // exist.
   detail::View &view = this->FindView<ComponentTypeTs...>();
 
+  // Delta tracking is subscription based; the first call turns it on for
+  // this view.
+  view.SubscribeNewRemoved(this);
+
   // Iterate over the entities in the view and in the newly created
   // entities list, and invoke the callback
   // function.
@@ -373,6 +629,69 @@ void EntityComponentManager::EachRemoved(typename identity<std::function<
   }
 }
 
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+void EntityComponentManager::EachComponent(typename identity<std::function<
+    bool(const Entity &_entity, const ComponentTypeT &)>>::type _f) const
+{
+  auto *storage = static_cast<ComponentStorage<ComponentTypeT> *>(
+      this->Storage(ComponentTypeT::typeId));
+  if (nullptr == storage)
+    return;
+
+  // Sweep the contiguous component array directly. The owners vector is
+  // kept parallel to the components vector by the storage class; a null
+  // owner marks a removed component whose slot awaits compaction.
+  for (size_t i = 0; i < storage->components.size(); ++i)
+  {
+    if (kNullEntity == storage->owners[i])
+      continue;
+    if (!_f(storage->owners[i],
+            static_cast<const ComponentTypeT &>(storage->components[i])))
+    {
+      break;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+void EntityComponentManager::EachComponent(typename identity<std::function<
+    bool(const Entity &_entity, ComponentTypeT &)>>::type _f)
+{
+  auto *storage = static_cast<ComponentStorage<ComponentTypeT> *>(
+      this->Storage(ComponentTypeT::typeId));
+  if (nullptr == storage)
+    return;
+
+  // Sweep the contiguous component array directly. The owners vector is
+  // kept parallel to the components vector by the storage class; a null
+  // owner marks a removed component whose slot awaits compaction.
+  for (size_t i = 0; i < storage->components.size(); ++i)
+  {
+    if (kNullEntity == storage->owners[i])
+      continue;
+    if (!_f(storage->owners[i], storage->components[i]))
+      break;
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+void EntityComponentManager::ForEachChanged(typename identity<std::function<
+    bool(const Entity &_entity, const ComponentTypeT *)>>::type _f) const
+{
+  for (const Entity entity : this->ChangedEntities(ComponentTypeT::typeId))
+  {
+    const ComponentTypeT *comp = this->Component<ComponentTypeT>(entity);
+    if (nullptr == comp)
+      continue;
+
+    if (!_f(entity, comp))
+      break;
+  }
+}
+
 //////////////////////////////////////////////////
 template<typename FirstComponent,
          typename ...RemainingComponents,
@@ -427,7 +746,12 @@ void EntityComponentManager::AddComponentsToView(detail::View &_view,
 template<typename ...ComponentTypeTs>
 detail::View &EntityComponentManager::FindView() const
 {
-  auto types = std::set<ComponentTypeId>{ComponentTypeTs::typeId...};
+  // Component type ids are assigned during static registration, before
+  // any view can be requested, so the key set for this combination of
+  // component types only has to be built once per template
+  // instantiation instead of on every call.
+  static const auto types =
+      std::set<ComponentTypeId>{ComponentTypeTs::typeId...};
 
   std::map<detail::ComponentTypeKey, detail::View>::iterator viewIter;
 
@@ -440,6 +764,10 @@ detail::View &EntityComponentManager::FindView() const
     for (const auto &vertex : this->Entities().Vertices())
     {
       Entity entity = vertex.first;
+      // Entities awaiting budgeted destruction stay out of views.
+      if (this->IsTombstoned(entity))
+        continue;
+
       if (this->EntityMatches(entity, types))
       {
         view.AddEntity(entity, this->IsNewEntity(entity));
@@ -449,6 +777,10 @@ detail::View &EntityComponentManager::FindView() const
         {
           view.AddEntityToRemoved(entity);
         }
+        if (this->EntityLevelBuffered(entity))
+        {
+          view.bufferedEntities.insert(entity);
+        }
 
         // Store pointers to all the components. This recursively adds
         // all the ComponentTypeTs that belong to the entity to the view.
@@ -456,10 +788,17 @@ detail::View &EntityComponentManager::FindView() const
       }
     }
 
+    // Merge the buffered entity insertions before the view is iterated.
+    view.ApplyPendingChanges();
+
     // Store the view.
     return this->AddView(types, std::move(view))->second;
   }
 
+  // Merge any entity churn buffered since the last time this view was
+  // fetched, so iteration sees an up-to-date entity vector.
+  viewIter->second.ApplyPendingChanges();
+
   return viewIter->second;
 }
 
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_DETAIL_GAUSSIANNOISEKERNEL_HH_
+#define IGNITION_GAZEBO_DETAIL_GAUSSIANNOISEKERNEL_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <sdf/Noise.hh>
+
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Rand.hh>
+
+#include <ignition/gazebo/Rng.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    namespace detail
+    {
+    /// \brief Batched Gaussian noise generation for sensor systems.
+    ///
+    /// ign-sensors configures noise per sensor from SDF and applies it
+    /// through a virtual call per sample, so a fleet of identical sensors
+    /// pays one dispatch and one scattered load per axis per update. This
+    /// kernel instead keeps the parameters of every noise channel of every
+    /// sensor of a system in one flat array and draws all of them in a
+    /// single sweep; Gaussian noise is the only model ign-sensors
+    /// implements, so folding it out of the virtual interface loses no
+    /// generality. Each Box-Muller transform yields two standard normal
+    /// draws, consumed by adjacent channels.
+    ///
+    /// A sensor occupies one row of a fixed number of channels. Draws go
+    /// through Rng, so the noise an entity sees is a pure function of the
+    /// world seed, the entity and the iteration, independent of how many
+    /// sensors share the kernel. The kernel is not thread safe; it is
+    /// meant to be owned and used by one system.
+    class GaussianNoiseKernel
+    {
+      /// \brief One noise channel, e.g. one axis of one sensor.
+      public: struct Channel
+      {
+        /// \brief Mean added to every sample.
+        double mean{0.0};
+
+        /// \brief Standard deviation of the white noise.
+        double stdDev{0.0};
+
+        /// \brief Fixed bias, sampled once when the channel is added.
+        double bias{0.0};
+
+        /// \brief Quantization step, zero to disable.
+        double precision{0.0};
+      };
+
+      /// \brief Constructor
+      /// \param[in] _channelsPerRow Number of noise channels per sensor.
+      public: explicit GaussianNoiseKernel(std::size_t _channelsPerRow)
+        : channelsPerRow(_channelsPerRow)
+      {
+      }
+
+      /// \brief Check whether an SDF noise model can be folded into the
+      /// kernel. Custom noise types registered by the user keep the
+      /// sensor-side path.
+      /// \param[in] _noise The SDF noise DOM.
+      /// \return True if the noise is absent or Gaussian.
+      public: static bool Supported(const sdf::Noise &_noise)
+      {
+        return _noise.Type() == sdf::NoiseType::NONE ||
+               _noise.Type() == sdf::NoiseType::GAUSSIAN ||
+               _noise.Type() == sdf::NoiseType::GAUSSIAN_QUANTIZED;
+      }
+
+      /// \brief Add a sensor's row of channels.
+      /// \param[in] _entity Entity the row's draws are keyed by.
+      /// \param[in] _noises SDF noise of each channel, in row order.
+      /// Missing or NONE entries become silent channels.
+      /// \return Index of the row.
+      public: std::size_t AddRow(const Entity _entity,
+                  const std::vector<sdf::Noise> &_noises)
+      {
+        const std::size_t row = this->rowEntities.size();
+        this->rowEntities.push_back(_entity);
+        for (std::size_t i = 0; i < this->channelsPerRow; ++i)
+        {
+          Channel channel;
+          if (i < _noises.size() &&
+              _noises[i].Type() != sdf::NoiseType::NONE)
+          {
+            const sdf::Noise &noise = _noises[i];
+            channel.mean = noise.Mean();
+            channel.stdDev = noise.StdDev();
+            if (noise.Type() == sdf::NoiseType::GAUSSIAN_QUANTIZED)
+              channel.precision = noise.Precision();
+
+            // Sample the fixed bias once with a random sign, matching
+            // the sensor-side Gaussian noise model.
+            if (noise.BiasMean() != 0.0 || noise.BiasStdDev() != 0.0)
+            {
+              channel.bias = math::Rand::DblNormal(noise.BiasMean(),
+                  noise.BiasStdDev());
+              if (math::Rand::DblUniform() < 0.5)
+                channel.bias = -channel.bias;
+            }
+          }
+          this->channels.push_back(channel);
+        }
+        return row;
+      }
+
+      /// \brief Remove a row by swapping the last row into its place, so
+      /// the rows stay dense. The caller is responsible for updating its
+      /// own bookkeeping of the moved row's index.
+      /// \param[in] _row Index of the row to remove.
+      public: void SwapRemoveRow(std::size_t _row)
+      {
+        const std::size_t last = this->rowEntities.size() - 1;
+        if (_row != last)
+        {
+          this->rowEntities[_row] = this->rowEntities[last];
+          for (std::size_t i = 0; i < this->channelsPerRow; ++i)
+          {
+            this->channels[_row * this->channelsPerRow + i] =
+                this->channels[last * this->channelsPerRow + i];
+          }
+        }
+        this->rowEntities.pop_back();
+        this->channels.resize(last * this->channelsPerRow);
+      }
+
+      /// \brief Number of rows in the kernel.
+      /// \return The number of sensors with channels here.
+      public: std::size_t RowCount() const
+      {
+        return this->rowEntities.size();
+      }
+
+      /// \brief Draw one sample for every channel of every row.
+      /// \param[in] _info Current update info, keys the draws.
+      /// \param[out] _out Resized and filled with one value per channel;
+      /// row r's channels start at index r times the channels per row.
+      public: void Sample(const UpdateInfo &_info, std::vector<double> &_out)
+      {
+        _out.resize(this->channels.size());
+
+        for (std::size_t row = 0; row < this->rowEntities.size(); ++row)
+        {
+          Rng rng(_info, this->rowEntities[row]);
+          const std::size_t base = row * this->channelsPerRow;
+
+          // Batched Box-Muller: one log/sqrt and one sin/cos pair per
+          // two channels, instead of one transform per sample.
+          for (std::size_t i = 0; i < this->channelsPerRow; i += 2)
+          {
+            const double u1 = 1.0 - rng.DblUniform();
+            const double u2 = rng.DblUniform();
+            const double radius = std::sqrt(-2.0 * std::log(u1));
+            const double angle = 2.0 * IGN_PI * u2;
+            _out[base + i] = radius * std::cos(angle);
+            if (i + 1 < this->channelsPerRow)
+              _out[base + i + 1] = radius * std::sin(angle);
+          }
+        }
+
+        // Scale the standard normal draws per channel in one dense pass.
+        for (std::size_t i = 0; i < this->channels.size(); ++i)
+        {
+          const Channel &channel = this->channels[i];
+          double value = channel.mean + channel.bias +
+              channel.stdDev * _out[i];
+          if (channel.precision > 0.0)
+            value = std::round(value / channel.precision) * channel.precision;
+          _out[i] = value;
+        }
+      }
+
+      /// \brief Number of channels per row.
+      private: std::size_t channelsPerRow;
+
+      /// \brief The entity of each row, keys its draws.
+      private: std::vector<Entity> rowEntities;
+
+      /// \brief Channel parameters, channelsPerRow entries per row.
+      private: std::vector<Channel> channels;
+    };
+    }
+    }
+  }
+}
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_DETAIL_MPSCQUEUE_HH_
+#define IGNITION_GAZEBO_DETAIL_MPSCQUEUE_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    namespace detail
+    {
+    /// \brief A lock-free multi-producer, single-consumer queue.
+    ///
+    /// Any number of threads may Push concurrently without blocking each
+    /// other or the consumer; the single consumer takes everything queued
+    /// so far with DrainAll. This is meant for handing work from transport
+    /// callback threads to the simulation loop, which drains the queue
+    /// once per step, so a callback can never stall stepping on a mutex.
+    ///
+    /// Elements are produced onto an intrusive list with a single
+    /// compare-and-swap, and the consumer detaches the whole list with one
+    /// exchange. Only DrainAll may be called concurrently with Push;
+    /// concurrent calls to DrainAll itself are not supported.
+    template <typename T>
+    class MpscQueue
+    {
+      /// \brief Constructor
+      public: MpscQueue() = default;
+
+      /// \brief Destructor. Frees anything still queued. No Push may be
+      /// in flight on another thread at this point.
+      public: ~MpscQueue()
+      {
+        Node *node = this->head.load(std::memory_order_relaxed);
+        while (node)
+        {
+          Node *next = node->next;
+          delete node;
+          node = next;
+        }
+      }
+
+      /// \brief Queues are neither copyable nor movable; producers hold
+      /// references to them.
+      public: MpscQueue(const MpscQueue &) = delete;
+
+      /// \brief Copy assignment is deleted, see the copy constructor.
+      public: MpscQueue &operator=(const MpscQueue &) = delete;
+
+      /// \brief Add an element to the queue. Safe to call from any number
+      /// of threads concurrently.
+      /// \param[in] _value Value to queue.
+      public: void Push(T _value)
+      {
+        auto *node = new Node{std::move(_value), nullptr};
+        node->next = this->head.load(std::memory_order_relaxed);
+        while (!this->head.compare_exchange_weak(node->next, node,
+            std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+      }
+
+      /// \brief Remove all queued elements. Only the consumer thread may
+      /// call this.
+      /// \return The elements, oldest first.
+      public: std::vector<T> DrainAll()
+      {
+        Node *node = this->head.exchange(nullptr, std::memory_order_acquire);
+
+        // The list comes off newest-first; reverse for FIFO order.
+        std::vector<T> values;
+        while (node)
+        {
+          values.push_back(std::move(node->value));
+          Node *next = node->next;
+          delete node;
+          node = next;
+        }
+        std::reverse(values.begin(), values.end());
+        return values;
+      }
+
+      /// \brief A queued element.
+      private: struct Node
+      {
+        /// \brief The queued value.
+        T value;
+
+        /// \brief The element queued before this one.
+        Node *next;
+      };
+
+      /// \brief Most recently queued element.
+      private: std::atomic<Node *> head{nullptr};
+    };
+    }
+    }
+  }
+}
+#endif
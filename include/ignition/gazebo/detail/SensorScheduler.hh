@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_DETAIL_SENSORSCHEDULER_HH_
+#define IGNITION_GAZEBO_DETAIL_SENSORSCHEDULER_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    namespace detail
+    {
+    /// \brief A timing wheel that wakes sensors only at their due times.
+    ///
+    /// Sensor systems publish at tens of Hz while the simulation steps at
+    /// full rate, so scanning every sensor entity each step is mostly
+    /// wasted work. A system schedules each sensor's next due time here and
+    /// asks AnyDue once per step; that check is a single comparison against
+    /// the cached earliest due time, and only when it fires does the system
+    /// pay for its entity scan and sensor updates.
+    ///
+    /// Due times are hashed into wheel slots by time, so popping the
+    /// sensors due at a given time only visits the slots that elapsed since
+    /// the previous pop. The scheduler is not thread safe; it is meant to
+    /// be owned and used by one system.
+    class SensorScheduler
+    {
+      /// \brief Simulation time type used for due times.
+      public: using Duration = std::chrono::steady_clock::duration;
+
+      /// \brief A scheduled sensor.
+      public: struct Entry
+      {
+        /// \brief Identifier chosen by the caller, typically an entity.
+        uint64_t id;
+
+        /// \brief Time the sensor is due.
+        Duration due;
+      };
+
+      /// \brief Constructor
+      /// \param[in] _resolution Width of one wheel slot. Due times within
+      /// the same slot are popped together.
+      /// \param[in] _slotCount Number of slots in the wheel.
+      public: explicit SensorScheduler(
+                  const Duration &_resolution = std::chrono::milliseconds(1),
+                  std::size_t _slotCount = 256)
+        : resolution(_resolution), slots(_slotCount)
+      {
+      }
+
+      /// \brief Schedule a sensor.
+      /// \param[in] _id Identifier of the sensor.
+      /// \param[in] _due Time the sensor is due. May be in the past, in
+      /// which case the next PopDue returns it.
+      public: void Schedule(uint64_t _id, const Duration &_due)
+      {
+        this->slots[this->SlotOf(_due)].push_back({_id, _due});
+        if (_due < this->nextDue)
+          this->nextDue = _due;
+        ++this->count;
+      }
+
+      /// \brief Remove a sensor from the wheel.
+      /// \param[in] _id Identifier passed to Schedule.
+      public: void Remove(uint64_t _id)
+      {
+        for (auto &slot : this->slots)
+        {
+          for (std::size_t i = 0; i < slot.size(); ++i)
+          {
+            if (slot[i].id == _id)
+            {
+              slot[i] = slot.back();
+              slot.pop_back();
+              --this->count;
+              return;
+            }
+          }
+        }
+      }
+
+      /// \brief Check whether any sensor is due. This is the per-step fast
+      /// path: one comparison, no slot access.
+      /// \param[in] _now Current time.
+      /// \return True if at least one sensor is due at or before _now.
+      public: bool AnyDue(const Duration &_now) const
+      {
+        return this->count > 0 && _now >= this->nextDue;
+      }
+
+      /// \brief Remove and return every sensor due at or before _now. Only
+      /// the slots that elapsed since the previous pop are visited; entries
+      /// hashed into them with a later due time stay scheduled.
+      /// \param[in] _now Current time.
+      /// \param[out] _due Appended with the due sensors, unordered.
+      public: void PopDue(const Duration &_now, std::vector<Entry> &_due)
+      {
+        if (!this->AnyDue(_now))
+          return;
+
+        // Visit the slots between the earliest due time and now, plus one
+        // for slot boundary rounding; with a span of at least one full
+        // turn, every slot is visited once.
+        std::size_t span = static_cast<std::size_t>(
+            (_now - this->nextDue) / this->resolution) + 2;
+        span = span < this->slots.size() ? span : this->slots.size();
+
+        std::size_t slotIndex = this->SlotOf(this->nextDue);
+        for (std::size_t i = 0; i < span; ++i)
+        {
+          auto &slot = this->slots[slotIndex];
+          for (std::size_t j = 0; j < slot.size();)
+          {
+            if (slot[j].due <= _now)
+            {
+              _due.push_back(slot[j]);
+              slot[j] = slot.back();
+              slot.pop_back();
+              --this->count;
+            }
+            else
+            {
+              ++j;
+            }
+          }
+          slotIndex = (slotIndex + 1) % this->slots.size();
+        }
+
+        this->RecomputeNextDue();
+      }
+
+      /// \brief Remove all scheduled sensors.
+      public: void Clear()
+      {
+        for (auto &slot : this->slots)
+          slot.clear();
+        this->count = 0;
+        this->nextDue = Duration::max();
+      }
+
+      /// \brief Number of scheduled sensors.
+      /// \return The number of entries in the wheel.
+      public: std::size_t Count() const
+      {
+        return this->count;
+      }
+
+      /// \brief Compute the wheel slot a due time hashes into.
+      /// \param[in] _due The due time.
+      /// \return Index of the slot.
+      private: std::size_t SlotOf(const Duration &_due) const
+      {
+        // Negative times land in slot 0; they are due immediately anyway.
+        if (_due <= Duration::zero())
+          return 0;
+        return static_cast<std::size_t>(_due / this->resolution) %
+               this->slots.size();
+      }
+
+      /// \brief Recompute the cached earliest due time by scanning the
+      /// remaining entries. Runs at pop rate, not at step rate.
+      private: void RecomputeNextDue()
+      {
+        this->nextDue = Duration::max();
+        for (const auto &slot : this->slots)
+        {
+          for (const auto &entry : slot)
+          {
+            if (entry.due < this->nextDue)
+              this->nextDue = entry.due;
+          }
+        }
+      }
+
+      /// \brief Width of one wheel slot.
+      private: Duration resolution;
+
+      /// \brief The wheel. Each slot holds the entries whose due time
+      /// hashes into it.
+      private: std::vector<std::vector<Entry>> slots;
+
+      /// \brief Earliest due time of any entry, or Duration::max() while
+      /// the wheel is empty.
+      private: Duration nextDue{Duration::max()};
+
+      /// \brief Number of entries in the wheel.
+      private: std::size_t count{0};
+    };
+    }
+    }
+  }
+}
+#endif
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_DETAIL_SMALLVECTOR_HH_
+#define IGNITION_GAZEBO_DETAIL_SMALLVECTOR_HH_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    namespace detail
+    {
+    /// \brief A vector with inline storage for up to InlineCapacity
+    /// elements.
+    ///
+    /// Component storages hold their payloads in contiguous arrays, but a
+    /// std::vector payload still puts the elements themselves behind a
+    /// per-entity heap pointer. Components whose sizes are small and
+    /// bounded in practice — joint state vectors are at most 6 DOF — can
+    /// use this type instead, so Each sweeps read the values inline from
+    /// the component array. Sizes beyond the inline capacity spill to the
+    /// heap and keep working; they just lose the locality benefit.
+    ///
+    /// The interface is the subset of std::vector the components use:
+    /// element access, iteration, size/resize/clear/push_back/assign and
+    /// equality, plus implicit conversion from std::vector and
+    /// initializer lists so call sites don't change.
+    template <typename T, std::size_t InlineCapacity>
+    class SmallVector
+    {
+      /// \brief Constructor. The vector starts empty.
+      public: SmallVector() = default;
+
+      /// \brief Construct from an initializer list.
+      /// \param[in] _values Initial elements.
+      // cppcheck-suppress noExplicitConstructor
+      public: SmallVector(std::initializer_list<T> _values)
+      {
+        this->assign(_values.begin(), _values.end());
+      }
+
+      /// \brief Construct from a std::vector. Implicit so existing call
+      /// sites that pass vectors keep compiling.
+      /// \param[in] _values Initial elements.
+      // cppcheck-suppress noExplicitConstructor
+      public: SmallVector(const std::vector<T> &_values)
+      {
+        this->assign(_values.begin(), _values.end());
+      }
+
+      /// \brief Replace the contents with a range.
+      /// \param[in] _first Start of the range.
+      /// \param[in] _last End of the range.
+      public: template <typename InputIt>
+              void assign(InputIt _first, InputIt _last)
+      {
+        this->clear();
+        for (; _first != _last; ++_first)
+          this->push_back(*_first);
+      }
+
+      /// \brief Append an element.
+      /// \param[in] _value Element to append.
+      public: void push_back(const T &_value)
+      {
+        if (!this->spilled && this->count < InlineCapacity)
+        {
+          this->inlineData[this->count++] = _value;
+          return;
+        }
+        this->Spill();
+        this->heapData.push_back(_value);
+      }
+
+      /// \brief Resize the vector, value-initializing new elements.
+      /// \param[in] _count New size.
+      public: void resize(std::size_t _count)
+      {
+        if (this->spilled || _count > InlineCapacity)
+        {
+          this->Spill();
+          this->heapData.resize(_count);
+          return;
+        }
+        for (std::size_t i = this->count; i < _count; ++i)
+          this->inlineData[i] = T();
+        this->count = _count;
+      }
+
+      /// \brief Remove all elements.
+      public: void clear()
+      {
+        this->heapData.clear();
+        this->spilled = false;
+        this->count = 0;
+      }
+
+      /// \brief Get the number of elements.
+      /// \return Element count.
+      public: std::size_t size() const
+      {
+        return this->spilled ? this->heapData.size() : this->count;
+      }
+
+      /// \brief Get whether the vector is empty.
+      /// \return True if there are no elements.
+      public: bool empty() const
+      {
+        return 0 == this->size();
+      }
+
+      /// \brief Get a pointer to the elements.
+      /// \return Pointer to contiguous storage.
+      public: T *data()
+      {
+        return this->spilled ? this->heapData.data()
+                             : this->inlineData.data();
+      }
+
+      /// \brief Get a pointer to the elements.
+      /// \return Pointer to contiguous storage.
+      public: const T *data() const
+      {
+        return this->spilled ? this->heapData.data()
+                             : this->inlineData.data();
+      }
+
+      /// \brief Element access.
+      /// \param[in] _index Index of the element.
+      /// \return Reference to the element.
+      public: T &operator[](std::size_t _index)
+      {
+        return this->data()[_index];
+      }
+
+      /// \brief Element access.
+      /// \param[in] _index Index of the element.
+      /// \return Reference to the element.
+      public: const T &operator[](std::size_t _index) const
+      {
+        return this->data()[_index];
+      }
+
+      /// \brief Get an iterator to the first element.
+      /// \return Begin iterator.
+      public: T *begin()
+      {
+        return this->data();
+      }
+
+      /// \brief Get an iterator to the first element.
+      /// \return Begin iterator.
+      public: const T *begin() const
+      {
+        return this->data();
+      }
+
+      /// \brief Get an iterator past the last element.
+      /// \return End iterator.
+      public: T *end()
+      {
+        return this->data() + this->size();
+      }
+
+      /// \brief Get an iterator past the last element.
+      /// \return End iterator.
+      public: const T *end() const
+      {
+        return this->data() + this->size();
+      }
+
+      /// \brief Equality comparison.
+      /// \param[in] _a Left operand.
+      /// \param[in] _b Right operand.
+      /// \return True if sizes and all elements match.
+      public: friend bool operator==(const SmallVector &_a,
+                  const SmallVector &_b)
+      {
+        return _a.size() == _b.size() &&
+               std::equal(_a.begin(), _a.end(), _b.begin());
+      }
+
+      /// \brief Inequality comparison.
+      /// \param[in] _a Left operand.
+      /// \param[in] _b Right operand.
+      /// \return True if the vectors differ.
+      public: friend bool operator!=(const SmallVector &_a,
+                  const SmallVector &_b)
+      {
+        return !(_a == _b);
+      }
+
+      /// \brief Move the inline elements to the heap. No-op when already
+      /// spilled.
+      private: void Spill()
+      {
+        if (this->spilled)
+          return;
+        this->heapData.assign(this->inlineData.data(),
+            this->inlineData.data() + this->count);
+        this->spilled = true;
+        this->count = 0;
+      }
+
+      /// \brief Inline element storage.
+      private: std::array<T, InlineCapacity> inlineData{};
+
+      /// \brief Heap storage, used once the inline capacity is exceeded.
+      private: std::vector<T> heapData;
+
+      /// \brief Number of elements while stored inline.
+      private: std::size_t count{0};
+
+      /// \brief Whether the elements live in heapData.
+      private: bool spilled{false};
+    };
+    }
+    }
+  }
+}
+#endif
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_DETAIL_SPSCRING_HH_
+#define IGNITION_GAZEBO_DETAIL_SPSCRING_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    namespace detail
+    {
+    /// \brief A bounded, wait-free single-producer single-consumer ring.
+    ///
+    /// One thread may TryPush and one other thread may TryPop
+    /// concurrently; neither ever blocks, retries or allocates. This is
+    /// meant for handing prepared buffers from the simulation loop to a
+    /// writer thread: a push costs two atomic operations and a move, so
+    /// a consumer stalled on IO can never stall the producer, which
+    /// instead sees a full ring and decides what to drop.
+    ///
+    /// One slot is kept empty to tell a full ring from an empty one, so
+    /// the ring holds at most the requested capacity.
+    template <typename T>
+    class SpscRing
+    {
+      /// \brief Constructor.
+      /// \param[in] _capacity Maximum number of queued elements.
+      public: explicit SpscRing(std::size_t _capacity)
+        : slots(_capacity + 1)
+      {
+      }
+
+      /// \brief Rings are neither copyable nor movable; both threads
+      /// hold references to them.
+      public: SpscRing(const SpscRing &) = delete;
+
+      /// \brief Copy assignment is deleted, see the copy constructor.
+      public: SpscRing &operator=(const SpscRing &) = delete;
+
+      /// \brief Add an element to the ring. Only the producer thread may
+      /// call this.
+      /// \param[in, out] _value Value to queue. Moved from on success,
+      /// left untouched when the ring is full.
+      /// \return False if the ring is full.
+      public: bool TryPush(T &_value)
+      {
+        const std::size_t writeAt =
+            this->head.load(std::memory_order_relaxed);
+        const std::size_t next = this->Advance(writeAt);
+        if (next == this->tail.load(std::memory_order_acquire))
+          return false;
+        this->slots[writeAt] = std::move(_value);
+        this->head.store(next, std::memory_order_release);
+        return true;
+      }
+
+      /// \brief Remove the oldest element. Only the consumer thread may
+      /// call this.
+      /// \param[out] _value Receives the element.
+      /// \return False if the ring is empty.
+      public: bool TryPop(T &_value)
+      {
+        const std::size_t readAt =
+            this->tail.load(std::memory_order_relaxed);
+        if (readAt == this->head.load(std::memory_order_acquire))
+          return false;
+        _value = std::move(this->slots[readAt]);
+        this->tail.store(this->Advance(readAt), std::memory_order_release);
+        return true;
+      }
+
+      /// \brief Check whether the ring is empty. Exact on the consumer
+      /// thread; a concurrent push may make it stale anywhere else.
+      /// \return True if no element is queued.
+      public: bool Empty() const
+      {
+        return this->tail.load(std::memory_order_acquire) ==
+            this->head.load(std::memory_order_acquire);
+      }
+
+      /// \brief Index following _index, wrapping at the slot count.
+      /// \param[in] _index Index to advance.
+      /// \return The next index.
+      private: std::size_t Advance(std::size_t _index) const
+      {
+        return (_index + 1) % this->slots.size();
+      }
+
+      /// \brief Element storage, one slot more than the capacity.
+      private: std::vector<T> slots;
+
+      /// \brief Slot the next push writes to.
+      private: std::atomic<std::size_t> head{0};
+
+      /// \brief Slot the next pop reads from.
+      private: std::atomic<std::size_t> tail{0};
+    };
+    }
+    }
+  }
+}
+#endif
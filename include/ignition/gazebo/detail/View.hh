@@ -17,11 +17,14 @@
 #ifndef IGNITION_GAZEBO_DETAIL_VIEW_HH_
 #define IGNITION_GAZEBO_DETAIL_VIEW_HH_
 
+#include <cstdint>
 #include <map>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 #include "ignition/gazebo/components/Component.hh"
+#include "ignition/gazebo/detail/ComponentStorageBase.hh"
 #include "ignition/gazebo/Entity.hh"
 #include "ignition/gazebo/Export.hh"
 #include "ignition/gazebo/Types.hh"
@@ -82,6 +85,14 @@ class IGNITION_GAZEBO_VISIBLE View
   /// view or when rebuilding the view.
   public: void AddEntity(const Entity _entity, const bool _new = false);
 
+  /// \brief Start maintaining the new/removed delta lists for this view.
+  /// Called by the first EachNew or EachRemoved on the view; views that
+  /// never see those calls skip the per-spawn bookkeeping entirely. The
+  /// lists are backfilled from the manager's current state, so a
+  /// subscription arriving mid-step still observes this step's churn.
+  /// \param[in] _ecm Pointer to the entity component manager.
+  public: void SubscribeNewRemoved(const EntityComponentManager *_ecm);
+
   /// \brief Remove an entity from the view.
   /// \param[in] _entity The entity to remove.
   /// \param[in] _key Components that should also be removed.
@@ -117,18 +128,68 @@ class IGNITION_GAZEBO_VISIBLE View
   /// \brief Clear the list of new entities
   public: void ClearNewEntities();
 
-  /// \brief All the entities that belong to this view.
-  public: std::set<Entity> entities;
+  /// \brief Get whether an entity belongs to this view, taking pending
+  /// insertions and removals into account.
+  /// \param[in] _entity The entity to check.
+  /// \return True if the entity is part of the view.
+  public: bool HasEntity(const Entity _entity) const;
+
+  /// \brief Merge the buffered insertions and removals into the entity
+  /// vector. The cost is proportional to the amount of churn since the
+  /// last call, and this is a no-op when nothing is pending.
+  public: void ApplyPendingChanges();
+
+  /// \brief All the entities that belong to this view, kept sorted in a
+  /// contiguous vector so that iteration is cache friendly. Insertions
+  /// and removals are buffered (see toAddEntities and toEraseEntities)
+  /// and merged in batch by ApplyPendingChanges.
+  public: std::vector<Entity> entities;
+
+  /// \brief Entities buffered for batch insertion into the view.
+  public: std::vector<Entity> toAddEntities;
 
-  /// \brief List of newly created entities
-  public: std::set<Entity> newEntities;
+  /// \brief Entities buffered for batch removal from the view.
+  public: std::vector<Entity> toEraseEntities;
 
-  /// \brief List of entities about to be removed
-  public: std::set<Entity> toRemoveEntities;
+  /// \brief List of newly created entities. Only maintained once a
+  /// consumer has subscribed via SubscribeNewRemoved.
+  public: std::vector<Entity> newEntities;
+
+  /// \brief List of entities about to be removed. Only maintained once a
+  /// consumer has subscribed via SubscribeNewRemoved.
+  public: std::vector<Entity> toRemoveEntities;
+
+  /// \brief Whether a consumer has ever called EachNew or EachRemoved on
+  /// this view. While false, newEntities and toRemoveEntities stay empty
+  /// and entity spawn/removal doesn't touch them.
+  public: bool trackNewRemoved{false};
+
+  /// \brief Subset of entities that belong only to levels loaded as
+  /// buffer zones. These are skipped by EachActive, so systems that
+  /// opted in don't simulate buffered entities at full rate. The set is
+  /// empty unless level streaming flagged entities as buffered.
+  public: std::set<Entity> bufferedEntities;
 
   /// \brief All of the components for each entity.
   public: std::map<std::pair<Entity, ComponentTypeId>,
           ComponentId> components;
+
+  /// \brief Bitmask over the view's required component types. Each type
+  /// that appears in at least one view is assigned a bit index by the
+  /// EntityComponentManager, and the same kind of mask is kept per
+  /// entity, so deciding whether an entity belongs to this view is a
+  /// word-wise subset test instead of a per-type lookup.
+  public: std::vector<uint64_t> mask;
+
+  /// \brief Cache of the storage that holds each component type in this
+  /// view. Each component type is stored sequentially in memory, so
+  /// resolving the storage once per type lets component accesses during
+  /// iteration go straight to the contiguous per-type arrays instead of
+  /// through the EntityComponentManager's storage map on every access.
+  /// The manager clears a type's entry when it replaces that storage,
+  /// which only happens when a storage shared with a cloned manager is
+  /// detached; the cached pointers remain valid otherwise.
+  public: mutable std::map<ComponentTypeId, ComponentStorageBase *> storages;
 };
 /// \endcond
 }
@@ -20,12 +20,19 @@
 #include <ignition/msgs/serialized.pb.h>
 
 #include <QtCore>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include <ignition/transport/Node.hh>
 
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/Export.hh"
+#include "ignition/gazebo/ShmStateChannel.hh"
 
 namespace ignition
 {
@@ -59,10 +66,28 @@ class IGNITION_GAZEBO_VISIBLE GuiRunner : public QObject
   private: void OnStateService(const msgs::SerializedStepMap &_res,
       const bool _result);
 
-  /// \brief Callback when a new state is received from the server.
+  /// \brief Callback when a new state is received from the server. Only
+  /// queues the message; deserialization and ECM application happen on
+  /// the state thread, so the transport callback stays parse-free.
   /// \param[in] _msg New state message.
   private: void OnState(const msgs::SerializedStepMap &_msg);
 
+  /// \brief Apply one state message to the ECM and update all GUI
+  /// systems. Runs on the state thread.
+  /// \param[in] _msg State message to be applied.
+  private: void ProcessState(const msgs::SerializedStepMap &_msg);
+
+  /// \brief Loop run by the state thread: drains queued state messages
+  /// in arrival order.
+  private: void StateThread();
+
+  /// \brief Loop run by the shared memory thread: attaches to the state
+  /// channel the server created under the given name and queues every
+  /// new message it carries. Used instead of the state topic
+  /// subscription when the launcher started both processes.
+  /// \param[in] _channelName Shared memory channel name.
+  private: void ShmStateThread(const std::string &_channelName);
+
   /// \brief Entity-component manager.
   private: gazebo::EntityComponentManager ecm;
 
@@ -74,6 +99,33 @@ class IGNITION_GAZEBO_VISIBLE GuiRunner : public QObject
 
   /// \brief Latest update info
   private: UpdateInfo updateInfo;
+
+  /// \brief Protects pendingStates.
+  private: std::mutex stateMutex;
+
+  /// \brief Notifies the state thread of queued messages.
+  private: std::condition_variable stateCv;
+
+  /// \brief State messages waiting to be applied, in arrival order.
+  /// Delta messages build on one another, so they can't be dropped
+  /// individually; when the queue overflows it is cleared and a keyframe
+  /// is requested instead.
+  private: std::deque<msgs::SerializedStepMap> pendingStates;
+
+  /// \brief True while the state thread should keep running.
+  private: std::atomic<bool> stateThreadRunning{true};
+
+  /// \brief Thread that deserializes and applies state messages, keeping
+  /// that work off the transport and Qt event loop threads.
+  private: std::thread stateThread;
+
+  /// \brief Shared memory state channel, mapped when the server was
+  /// launched from the same `ign gazebo` invocation. Null when states
+  /// arrive through the state topic instead.
+  private: std::unique_ptr<ShmStateChannel> stateShm;
+
+  /// \brief Thread polling the shared memory channel.
+  private: std::thread shmThread;
 };
 }
 }
@@ -55,6 +55,17 @@ class IGNITION_GAZEBO_VISIBLE MarkerManager
   /// \brief Update MarkerManager
   public: void Update();
 
+  /// \brief Set the distance beyond which markers are hidden.
+  /// Marker visuals are kept in a coarse spatial hash, and a whole cell
+  /// is hidden once no sensor in the scene is within this distance of
+  /// it, so the per-update culling cost scales with the number of
+  /// occupied cells rather than the number of markers. A value of zero
+  /// or less disables culling. Culling is disabled by default, and the
+  /// distance can also be set through the
+  /// IGN_GAZEBO_MARKER_CULL_DISTANCE environment variable.
+  /// \param[in] _distance Cull distance in meters.
+  public: void SetCullDistance(double _distance);
+
   /// \brief Initialize the marker manager.
   /// \param[in] _scene Reference to the scene.
   /// \return True on success
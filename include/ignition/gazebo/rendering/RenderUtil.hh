@@ -17,6 +17,7 @@
 #ifndef IGNITION_GAZEBO_RENDERUTIL_HH_
 #define IGNITION_GAZEBO_RENDERUTIL_HH_
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -110,6 +111,18 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
         std::string(const gazebo::Entity &, const sdf::Sensor &,
           const std::string &)> _createSensorCb = {});
 
+    /// \brief Set whether the scene is built for depth-only sensors (GPU
+    /// lidars and depth cameras). When enabled, visuals are created without
+    /// materials, shadow casting is turned off, and lights are not mirrored
+    /// into the scene at all, so no shadow maps are generated and the
+    /// material pipeline is skipped. Geometry and poses are unaffected, so
+    /// depth output is identical. Do not enable this when color or thermal
+    /// cameras may be present: their images would come out unlit and
+    /// untextured. Disabled by default.
+    /// \param[in] _enable True to strip the scene down to depth-relevant
+    /// content.
+    public: void SetDepthOnlyProfile(bool _enable);
+
     /// \brief Set the callback function for removing the sensors
     /// \param[in] _removeSensorCb Callback function for removing the sensors
     /// The callback function arg is the sensor entity to remove
@@ -143,6 +156,27 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \param[in] _active True if active.
     public: void SetTransformActive(bool _active);
 
+    /// \brief Set whether entity poses are smoothly interpolated between
+    /// state updates instead of applied as they arrive. Intended for the
+    /// GUI, whose render loop can run faster than the server publishes
+    /// state; each new pose sample is blended in over the observed sample
+    /// interval so motion stays smooth at high display refresh rates.
+    /// Disabled by default.
+    /// \param[in] _enable True to interpolate poses.
+    public: void SetPoseInterpolation(bool _enable);
+
+    /// \brief Set the time the render thread may spend creating scene
+    /// entities each frame. When a state message brings in more
+    /// entities than fit the budget — typically the first state of a
+    /// large world — the remainder streams in over the following
+    /// frames, models in the user camera's view first, so the window
+    /// paints right away instead of freezing until the whole scene is
+    /// built. Only applies to the GUI scene; sensor scenes are always
+    /// built completely before the next render. Defaults to 4 ms.
+    /// \param[in] _budget Creation budget per frame.
+    public: void SetSceneCreationBudget(
+        const std::chrono::milliseconds &_budget);
+
     /// \brief Private data pointer.
     private: std::unique_ptr<RenderUtilPrivate> dataPtr;
   };
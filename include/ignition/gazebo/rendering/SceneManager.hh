@@ -18,6 +18,7 @@
 #ifndef IGNITION_GAZEBO_SCENEMANAGER_HH_
 #define IGNITION_GAZEBO_SCENEMANAGER_HH_
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -208,6 +209,46 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     public: AnimationUpdateData ActorAnimationAt(
         Entity _id, std::chrono::steady_clock::duration _time) const;
 
+    /// \brief Swap in meshes whose background parse has completed. Visuals
+    /// with mesh geometry are given a placeholder box while the mesh file
+    /// is parsed on a loader thread; calling this on the render thread
+    /// replaces the placeholder once the mesh is available. Should be
+    /// called once per render update.
+    public: void UpdatePendingMeshes();
+
+    /// \brief Switch the level of detail of visuals that declared LOD
+    /// meshes, based on their distance to the nearest sensor in the
+    /// scene. LOD levels are given per visual in SDF as namespaced
+    /// custom elements:
+    ///   <ignition:lod><distance>100</distance><uri>far.dae</uri>
+    ///   </ignition:lod>
+    /// An entry without a <uri> hides the visual beyond its distance.
+    /// Should be called once per render update.
+    public: void UpdateLods();
+
+    /// \brief Set the visibility flags of a visual. If the visual is part
+    /// of a merged static batch, the batches are repartitioned, since
+    /// visuals only share a batch when they share visibility flags.
+    /// \param[in] _id Visual entity's unique id
+    /// \param[in] _flags Visibility flags to set
+    public: void SetVisibilityFlags(Entity _id, uint32_t _flags);
+
+    /// \brief Mark a visual as never moving, making it a candidate for
+    /// static batching. Marked visuals are folded into consolidated
+    /// per-material meshes by UpdateStaticBatches.
+    /// \param[in] _id Visual entity's unique id
+    public: void MarkStatic(Entity _id);
+
+    /// \brief Merge marked static visuals into one consolidated mesh,
+    /// visual and draw call per material, with the source transforms
+    /// baked into the vertices. The source visuals are hidden, not
+    /// destroyed, and the per-batch mapping back to them is kept:
+    /// removing a batched entity, e.g. on level unload, restores the
+    /// survivors and rebuilds their batch. Rebuilds only happen when
+    /// marked visuals were added or removed. Should be called once per
+    /// render update.
+    public: void UpdateStaticBatches();
+
     /// \brief Remove an entity by id
     /// \param[in] _id Entity's unique id
     public: void RemoveEntity(Entity _id);
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/gazebo/BatchingPublisher.hh"
+
+#include <utility>
+
+#include <ignition/common/Console.hh>
+#include <ignition/msgs/Factory.hh>
+
+#include "msgs/message_batch.pb.h"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Private data for BatchingPublisher.
+class ignition::gazebo::BatchingPublisherPrivate
+{
+  /// \brief The envelope publisher.
+  public: transport::Node::Publisher pub;
+
+  /// \brief The batch being filled.
+  public: private_msgs::MessageBatch batch;
+
+  /// \brief How long messages may wait before the batch is flushed.
+  public: std::chrono::steady_clock::duration window{0};
+
+  /// \brief When the oldest message in the batch was appended.
+  public: std::chrono::steady_clock::time_point windowStart;
+};
+
+/// \brief Private data for BatchSubscriber.
+class ignition::gazebo::BatchSubscriberPrivate
+{
+  /// \brief Callback invoked once per batched message.
+  public: BatchSubscriber::Callback callback;
+
+  /// \brief Message prototype matching the envelope's type, reused
+  /// across envelopes.
+  public: std::unique_ptr<google::protobuf::Message> prototype;
+
+  /// \brief Handle one envelope.
+  /// \param[in] _batch The envelope.
+  public: void OnBatch(const private_msgs::MessageBatch &_batch);
+};
+
+//////////////////////////////////////////////////
+BatchingPublisher::BatchingPublisher()
+  : dataPtr(std::make_unique<BatchingPublisherPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+BatchingPublisher::~BatchingPublisher()
+{
+  this->Flush();
+}
+
+//////////////////////////////////////////////////
+bool BatchingPublisher::Init(transport::Node &_node,
+    const std::string &_topic, const std::string &_msgType,
+    const std::chrono::steady_clock::duration &_window)
+{
+  this->dataPtr->pub =
+      _node.Advertise<private_msgs::MessageBatch>(_topic + "/batched");
+  if (!this->dataPtr->pub.Valid())
+  {
+    ignerr << "Failed to advertise batch topic [" << _topic << "/batched]"
+           << std::endl;
+    return false;
+  }
+
+  this->dataPtr->batch.set_type(_msgType);
+  this->dataPtr->window = _window;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void BatchingPublisher::Publish(const google::protobuf::Message &_msg)
+{
+  if (!this->dataPtr->pub.Valid())
+    return;
+
+  const auto now = std::chrono::steady_clock::now();
+  if (this->dataPtr->batch.messages_size() == 0)
+    this->dataPtr->windowStart = now;
+
+  _msg.SerializeToString(this->dataPtr->batch.add_messages());
+
+  if (now - this->dataPtr->windowStart >= this->dataPtr->window)
+    this->Flush();
+}
+
+//////////////////////////////////////////////////
+void BatchingPublisher::Flush()
+{
+  if (!this->dataPtr->pub.Valid() ||
+      this->dataPtr->batch.messages_size() == 0)
+  {
+    return;
+  }
+
+  this->dataPtr->pub.Publish(this->dataPtr->batch);
+  this->dataPtr->batch.clear_messages();
+}
+
+//////////////////////////////////////////////////
+bool BatchingPublisher::Valid() const
+{
+  return this->dataPtr->pub.Valid();
+}
+
+//////////////////////////////////////////////////
+void BatchSubscriberPrivate::OnBatch(const private_msgs::MessageBatch &_batch)
+{
+  if (!this->prototype ||
+      this->prototype->GetDescriptor()->full_name() != _batch.type())
+  {
+    this->prototype = msgs::Factory::New(_batch.type());
+    if (!this->prototype)
+    {
+      ignerr << "Cannot split batch of unknown message type ["
+             << _batch.type() << "]" << std::endl;
+      return;
+    }
+  }
+
+  for (const auto &data : _batch.messages())
+  {
+    if (this->prototype->ParseFromString(data))
+      this->callback(*this->prototype);
+    else
+      ignwarn << "Dropping malformed batched message." << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+BatchSubscriber::BatchSubscriber()
+  : dataPtr(std::make_unique<BatchSubscriberPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+BatchSubscriber::~BatchSubscriber() = default;
+
+//////////////////////////////////////////////////
+bool BatchSubscriber::Init(transport::Node &_node,
+    const std::string &_topic, Callback _cb)
+{
+  this->dataPtr->callback = std::move(_cb);
+
+  // The callback only runs while the subscription, and therefore this
+  // object, is alive.
+  std::function<void(const private_msgs::MessageBatch &)> onBatch =
+      [this](const private_msgs::MessageBatch &_batch)
+      {
+        this->dataPtr->OnBatch(_batch);
+      };
+  return _node.Subscribe(_topic + "/batched", onBatch);
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ignition/msgs/stringmsg.pb.h>
+#include <ignition/transport/Node.hh>
+
+#include "ignition/gazebo/BatchingPublisher.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(BatchingPublisherTest, RoundTrip)
+{
+  transport::Node node;
+
+  BatchingPublisher pub;
+  EXPECT_FALSE(pub.Valid());
+  // A long window so the batch only goes out on the explicit flush.
+  ASSERT_TRUE(pub.Init(node, "/batch_test", "ignition.msgs.StringMsg",
+      std::chrono::hours(1)));
+  EXPECT_TRUE(pub.Valid());
+
+  std::mutex mutex;
+  std::vector<std::string> received;
+  BatchSubscriber sub;
+  ASSERT_TRUE(sub.Init(node, "/batch_test",
+      [&](const google::protobuf::Message &_msg)
+      {
+        auto *str = dynamic_cast<const msgs::StringMsg *>(&_msg);
+        ASSERT_NE(nullptr, str);
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(str->data());
+      }));
+
+  msgs::StringMsg msg;
+  for (int i = 0; i < 5; ++i)
+  {
+    msg.set_data("msg" + std::to_string(i));
+    pub.Publish(msg);
+  }
+  pub.Flush();
+
+  int sleep = 0;
+  for (; sleep < 100; ++sleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (received.size() >= 5u)
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(5u, received.size());
+  // Order within a batch is publish order.
+  for (int i = 0; i < 5; ++i)
+    EXPECT_EQ("msg" + std::to_string(i), received[i]);
+}
+
+/////////////////////////////////////////////////
+TEST(BatchingPublisherTest, ZeroWindowFlushesEachPublish)
+{
+  transport::Node node;
+
+  BatchingPublisher pub;
+  ASSERT_TRUE(pub.Init(node, "/batch_test_zero", "ignition.msgs.StringMsg",
+      std::chrono::steady_clock::duration::zero()));
+
+  std::mutex mutex;
+  std::vector<std::string> received;
+  BatchSubscriber sub;
+  ASSERT_TRUE(sub.Init(node, "/batch_test_zero",
+      [&](const google::protobuf::Message &_msg)
+      {
+        auto *str = dynamic_cast<const msgs::StringMsg *>(&_msg);
+        ASSERT_NE(nullptr, str);
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(str->data());
+      }));
+
+  // With a zero window every publish flushes immediately, no explicit
+  // flush needed.
+  msgs::StringMsg msg;
+  msg.set_data("hello");
+  pub.Publish(msg);
+
+  int sleep = 0;
+  for (; sleep < 100; ++sleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!received.empty())
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(1u, received.size());
+  EXPECT_EQ("hello", received[0]);
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/gazebo/BoundedPublisher.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <ignition/common/Console.hh>
+
+using namespace ignition;
+using namespace gazebo;
+
+namespace
+{
+/// \brief Messages dropped by every BoundedPublisher in the process.
+std::atomic<uint64_t> totalDropped{0};
+}  // namespace
+
+/// \brief Private data for BoundedPublisher.
+class ignition::gazebo::BoundedPublisherPrivate
+{
+  /// \brief Hand queued messages to the transport until stopped.
+  public: void Run();
+
+  /// \brief The underlying publisher.
+  public: transport::Node::Publisher pub;
+
+  /// \brief Maximum number of queued messages.
+  public: std::size_t depth{1};
+
+  /// \brief What to do when the queue is full.
+  public: BoundedPublisher::DropPolicy policy{
+              BoundedPublisher::DropPolicy::kDropOldest};
+
+  /// \brief Queued messages, oldest first.
+  public: std::deque<std::unique_ptr<google::protobuf::Message>> queue;
+
+  /// \brief Guards queue and stop.
+  public: std::mutex mutex;
+
+  /// \brief Signals the worker that a message arrived or stop was
+  /// requested.
+  public: std::condition_variable cv;
+
+  /// \brief True once the destructor asks the worker to finish.
+  public: bool stop{false};
+
+  /// \brief Messages this publisher dropped.
+  public: std::atomic<uint64_t> dropped{0};
+
+  /// \brief The worker draining the queue into the transport.
+  public: std::thread worker;
+};
+
+//////////////////////////////////////////////////
+void BoundedPublisherPrivate::Run()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->cv.wait(lock, [this]()
+    {
+      return this->stop || !this->queue.empty();
+    });
+
+    if (this->queue.empty())
+      break;
+
+    auto msg = std::move(this->queue.front());
+    this->queue.pop_front();
+
+    // The transport write happens outside the lock, so a slow or
+    // blocking send never holds up producers; they keep queueing and
+    // the drop policy takes over once the queue is full.
+    lock.unlock();
+    this->pub.Publish(*msg);
+    lock.lock();
+  }
+}
+
+//////////////////////////////////////////////////
+BoundedPublisher::BoundedPublisher()
+  : dataPtr(std::make_unique<BoundedPublisherPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+BoundedPublisher::~BoundedPublisher()
+{
+  if (this->dataPtr->worker.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      this->dataPtr->stop = true;
+    }
+    this->dataPtr->cv.notify_all();
+    this->dataPtr->worker.join();
+  }
+}
+
+//////////////////////////////////////////////////
+bool BoundedPublisher::InitImpl(transport::Node::Publisher _pub,
+    std::size_t _depth, DropPolicy _policy)
+{
+  if (!_pub.Valid())
+  {
+    ignerr << "Failed to advertise bounded topic" << std::endl;
+    return false;
+  }
+
+  this->dataPtr->pub = std::move(_pub);
+  this->dataPtr->depth = std::max<std::size_t>(1, _depth);
+  this->dataPtr->policy = _policy;
+  this->dataPtr->worker = std::thread(
+      &BoundedPublisherPrivate::Run, this->dataPtr.get());
+  return true;
+}
+
+//////////////////////////////////////////////////
+void BoundedPublisher::Publish(const google::protobuf::Message &_msg)
+{
+  if (!this->dataPtr->pub.Valid())
+    return;
+
+  auto copy = std::unique_ptr<google::protobuf::Message>(_msg.New());
+  copy->CopyFrom(_msg);
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->queue.size() >= this->dataPtr->depth)
+    {
+      if (DropPolicy::kCoalesce == this->dataPtr->policy)
+      {
+        // Only the latest value matters; everything queued is stale.
+        this->dataPtr->dropped += this->dataPtr->queue.size();
+        totalDropped += this->dataPtr->queue.size();
+        this->dataPtr->queue.clear();
+      }
+      else
+      {
+        this->dataPtr->queue.pop_front();
+        ++this->dataPtr->dropped;
+        ++totalDropped;
+      }
+    }
+    this->dataPtr->queue.push_back(std::move(copy));
+  }
+  this->dataPtr->cv.notify_one();
+}
+
+//////////////////////////////////////////////////
+bool BoundedPublisher::HasConnections() const
+{
+  return this->dataPtr->pub.HasConnections();
+}
+
+//////////////////////////////////////////////////
+bool BoundedPublisher::Valid() const
+{
+  return this->dataPtr->pub.Valid();
+}
+
+//////////////////////////////////////////////////
+uint64_t BoundedPublisher::DroppedCount() const
+{
+  return this->dataPtr->dropped.load();
+}
+
+//////////////////////////////////////////////////
+uint64_t BoundedPublisher::TotalDroppedCount()
+{
+  return totalDropped.load();
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ignition/msgs/stringmsg.pb.h>
+#include <ignition/transport/Node.hh>
+
+#include "ignition/gazebo/BoundedPublisher.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(BoundedPublisherTest, RoundTrip)
+{
+  transport::Node node;
+
+  BoundedPublisher pub;
+  EXPECT_FALSE(pub.Valid());
+  ASSERT_TRUE(pub.Init<msgs::StringMsg>(node, "/bounded_test", 16,
+      BoundedPublisher::DropPolicy::kDropOldest));
+  EXPECT_TRUE(pub.Valid());
+  EXPECT_EQ(0u, pub.DroppedCount());
+
+  std::mutex mutex;
+  std::vector<std::string> received;
+  std::function<void(const msgs::StringMsg &)> cb =
+      [&](const msgs::StringMsg &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(_msg.data());
+      };
+  ASSERT_TRUE(node.Subscribe("/bounded_test", cb));
+
+  msgs::StringMsg msg;
+  for (int i = 0; i < 5; ++i)
+  {
+    msg.set_data("msg" + std::to_string(i));
+    pub.Publish(msg);
+  }
+
+  int sleep = 0;
+  for (; sleep < 100; ++sleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (received.size() >= 5u)
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(5u, received.size());
+  // Queued messages go out in publish order.
+  for (int i = 0; i < 5; ++i)
+    EXPECT_EQ("msg" + std::to_string(i), received[i]);
+  EXPECT_EQ(0u, pub.DroppedCount());
+}
+
+/////////////////////////////////////////////////
+TEST(BoundedPublisherTest, DropOldest)
+{
+  transport::Node node;
+
+  // No subscriber, so nothing drains the queue faster than we fill it;
+  // with a depth of 2 every publish past the second drops the oldest.
+  BoundedPublisher pub;
+  ASSERT_TRUE(pub.Init<msgs::StringMsg>(node, "/bounded_test_oldest", 2,
+      BoundedPublisher::DropPolicy::kDropOldest));
+
+  const uint64_t totalBefore = BoundedPublisher::TotalDroppedCount();
+
+  msgs::StringMsg msg;
+  msg.set_data("payload");
+  for (int i = 0; i < 100; ++i)
+    pub.Publish(msg);
+
+  // The queue held at most 2 messages at any point, so at least 98 of
+  // the 100 were dropped. The worker may have drained a few, hence the
+  // inequality.
+  EXPECT_GE(pub.DroppedCount(), 90u);
+  EXPECT_GE(BoundedPublisher::TotalDroppedCount() - totalBefore,
+      pub.DroppedCount());
+}
+
+/////////////////////////////////////////////////
+TEST(BoundedPublisherTest, Coalesce)
+{
+  transport::Node node;
+
+  BoundedPublisher pub;
+  ASSERT_TRUE(pub.Init<msgs::StringMsg>(node, "/bounded_test_coalesce", 4,
+      BoundedPublisher::DropPolicy::kCoalesce));
+
+  msgs::StringMsg msg;
+  msg.set_data("payload");
+  for (int i = 0; i < 100; ++i)
+    pub.Publish(msg);
+
+  // Once the queue filled, each publish replaced everything queued.
+  EXPECT_GE(pub.DroppedCount(), 90u);
+}
@@ -501,6 +501,76 @@ TEST_F(ComponentTest, IStream)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_F(ComponentTest, RawCopy)
+{
+  // Trivially copyable data takes the raw byte path
+  {
+    using Custom = components::Component<math::Vector3d, class CustomTag>;
+
+    Custom comp(math::Vector3d(1.0, 2.0, 3.0));
+
+    std::string data;
+    EXPECT_TRUE(comp.SerializeRaw(data));
+    EXPECT_EQ(sizeof(math::Vector3d), data.size());
+
+    Custom comp2;
+    EXPECT_TRUE(comp2.DeserializeRaw(data.data(), data.size()));
+    EXPECT_EQ(math::Vector3d(1.0, 2.0, 3.0), comp2.Data());
+
+    // A size mismatch is rejected so callers fall back to the stream path
+    EXPECT_FALSE(comp2.DeserializeRaw(data.data(), data.size() - 1));
+  }
+
+  // Non-trivially-copyable data keeps the stream path
+  {
+    using Custom = components::Component<std::string, class CustomTag>;
+
+    Custom comp(std::string("foo"));
+
+    std::string data;
+    EXPECT_FALSE(comp.SerializeRaw(data));
+    EXPECT_FALSE(comp.DeserializeRaw("foo", 3));
+  }
+
+  // A custom serializer implies a custom wire format, so the raw path is
+  // disabled even for trivially copyable data
+  {
+    class DoubleSerializer
+    {
+      public: static std::ostream &Serialize(std::ostream &_out,
+                  const double &_data)
+      {
+        _out << _data;
+        return _out;
+      }
+
+      public: static std::istream &Deserialize(std::istream &_in,
+                  double &_data)
+      {
+        _in >> _data;
+        return _in;
+      }
+    };
+
+    using Custom = components::Component<double, class CustomTag,
+        DoubleSerializer>;
+
+    Custom comp(1.0);
+    std::string data;
+    EXPECT_FALSE(comp.SerializeRaw(data));
+  }
+
+  // Components without data keep the stream path
+  {
+    using Custom = components::Component<components::NoData, class CustomTag>;
+
+    Custom comp;
+    std::string data;
+    EXPECT_FALSE(comp.SerializeRaw(data));
+  }
+}
+
 //////////////////////////////////////////////////
 TEST_F(ComponentTest, TypeId)
 {
@@ -124,7 +124,7 @@ msgs::Collision ignition::gazebo::convert(const sdf::Collision &_in)
   msgs::Collision out;
   out.set_name(_in.Name());
   msgs::Set(out.mutable_pose(), _in.RawPose());
-  out.mutable_geometry()->CopyFrom(convert<msgs::Geometry>(*_in.Geom()));
+  set(out.mutable_geometry(), *_in.Geom());
 
   return out;
 }
@@ -145,47 +145,7 @@ template<>
 msgs::Geometry ignition::gazebo::convert(const sdf::Geometry &_in)
 {
   msgs::Geometry out;
-  if (_in.Type() == sdf::GeometryType::BOX && _in.BoxShape())
-  {
-    out.set_type(msgs::Geometry::BOX);
-    msgs::Set(out.mutable_box()->mutable_size(), _in.BoxShape()->Size());
-  }
-  else if (_in.Type() == sdf::GeometryType::CYLINDER && _in.CylinderShape())
-  {
-    out.set_type(msgs::Geometry::CYLINDER);
-    out.mutable_cylinder()->set_radius(_in.CylinderShape()->Radius());
-    out.mutable_cylinder()->set_length(_in.CylinderShape()->Length());
-  }
-  else if (_in.Type() == sdf::GeometryType::PLANE && _in.PlaneShape())
-  {
-    out.set_type(msgs::Geometry::PLANE);
-    msgs::Set(out.mutable_plane()->mutable_normal(),
-              _in.PlaneShape()->Normal());
-    msgs::Set(out.mutable_plane()->mutable_size(),
-              _in.PlaneShape()->Size());
-  }
-  else if (_in.Type() == sdf::GeometryType::SPHERE && _in.SphereShape())
-  {
-    out.set_type(msgs::Geometry::SPHERE);
-    out.mutable_sphere()->set_radius(_in.SphereShape()->Radius());
-  }
-  else if (_in.Type() == sdf::GeometryType::MESH && _in.MeshShape())
-  {
-    auto meshSdf = _in.MeshShape();
-
-    out.set_type(msgs::Geometry::MESH);
-    auto meshMsg = out.mutable_mesh();
-
-    msgs::Set(meshMsg->mutable_scale(), meshSdf->Scale());
-    meshMsg->set_filename(asFullPath(meshSdf->Uri(), meshSdf->FilePath()));
-    meshMsg->set_submesh(meshSdf->Submesh());
-    meshMsg->set_center_submesh(meshSdf->CenterSubmesh());
-  }
-  else
-  {
-    ignerr << "Geometry type [" << static_cast<int>(_in.Type())
-           << "] not supported" << std::endl;
-  }
+  set(&out, _in);
   return out;
 }
 
@@ -512,12 +472,7 @@ msgs::Time ignition::gazebo::convert(
     const std::chrono::steady_clock::duration &_in)
 {
   msgs::Time out;
-
-  auto secNsec = ignition::math::durationToSecNsec(_in);
-
-  out.set_sec(secNsec.first);
-  out.set_nsec(secNsec.second);
-
+  set(&out, _in);
   return out;
 }
 
@@ -534,14 +489,7 @@ template<>
 msgs::Inertial ignition::gazebo::convert(const math::Inertiald &_in)
 {
   msgs::Inertial out;
-  msgs::Set(out.mutable_pose(), _in.Pose());
-  out.set_mass(_in.MassMatrix().Mass());
-  out.set_ixx(_in.MassMatrix().Ixx());
-  out.set_iyy(_in.MassMatrix().Iyy());
-  out.set_izz(_in.MassMatrix().Izz());
-  out.set_ixy(_in.MassMatrix().Ixy());
-  out.set_ixz(_in.MassMatrix().Ixz());
-  out.set_iyz(_in.MassMatrix().Iyz());
+  set(&out, _in);
   return out;
 }
 
@@ -689,6 +637,65 @@ sdf::Atmosphere ignition::gazebo::convert(const msgs::Atmosphere &_in)
   return out;
 }
 
+//////////////////////////////////////////////////
+void ignition::gazebo::set(msgs::Geometry *_msg, const sdf::Geometry &_in)
+{
+  if (_in.Type() == sdf::GeometryType::BOX && _in.BoxShape())
+  {
+    _msg->set_type(msgs::Geometry::BOX);
+    msgs::Set(_msg->mutable_box()->mutable_size(), _in.BoxShape()->Size());
+  }
+  else if (_in.Type() == sdf::GeometryType::CYLINDER && _in.CylinderShape())
+  {
+    _msg->set_type(msgs::Geometry::CYLINDER);
+    _msg->mutable_cylinder()->set_radius(_in.CylinderShape()->Radius());
+    _msg->mutable_cylinder()->set_length(_in.CylinderShape()->Length());
+  }
+  else if (_in.Type() == sdf::GeometryType::PLANE && _in.PlaneShape())
+  {
+    _msg->set_type(msgs::Geometry::PLANE);
+    msgs::Set(_msg->mutable_plane()->mutable_normal(),
+              _in.PlaneShape()->Normal());
+    msgs::Set(_msg->mutable_plane()->mutable_size(),
+              _in.PlaneShape()->Size());
+  }
+  else if (_in.Type() == sdf::GeometryType::SPHERE && _in.SphereShape())
+  {
+    _msg->set_type(msgs::Geometry::SPHERE);
+    _msg->mutable_sphere()->set_radius(_in.SphereShape()->Radius());
+  }
+  else if (_in.Type() == sdf::GeometryType::MESH && _in.MeshShape())
+  {
+    auto meshSdf = _in.MeshShape();
+
+    _msg->set_type(msgs::Geometry::MESH);
+    auto meshMsg = _msg->mutable_mesh();
+
+    msgs::Set(meshMsg->mutable_scale(), meshSdf->Scale());
+    meshMsg->set_filename(asFullPath(meshSdf->Uri(), meshSdf->FilePath()));
+    meshMsg->set_submesh(meshSdf->Submesh());
+    meshMsg->set_center_submesh(meshSdf->CenterSubmesh());
+  }
+  else
+  {
+    ignerr << "Geometry type [" << static_cast<int>(_in.Type())
+           << "] not supported" << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+void ignition::gazebo::set(msgs::Inertial *_msg, const math::Inertiald &_in)
+{
+  msgs::Set(_msg->mutable_pose(), _in.Pose());
+  _msg->set_mass(_in.MassMatrix().Mass());
+  _msg->set_ixx(_in.MassMatrix().Ixx());
+  _msg->set_iyy(_in.MassMatrix().Iyy());
+  _msg->set_izz(_in.MassMatrix().Izz());
+  _msg->set_ixy(_in.MassMatrix().Ixy());
+  _msg->set_ixz(_in.MassMatrix().Ixz());
+  _msg->set_iyz(_in.MassMatrix().Iyz());
+}
+
 //////////////////////////////////////////////////
 void ignition::gazebo::set(msgs::Time *_msg,
     const std::chrono::steady_clock::duration &_in)
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "CpuAffinity.hh"
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+#include <ignition/common/Console.hh>
+
+using namespace ignition;
+using namespace gazebo;
+
+//////////////////////////////////////////////////
+std::vector<unsigned int> detail::CurrentThreadAffinity()
+{
+#ifdef __linux__
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  if (0 != pthread_getaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet))
+    return {};
+
+  std::vector<unsigned int> cpus;
+  for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &cpuSet))
+      cpus.push_back(cpu);
+  }
+  return cpus;
+#else
+  return {};
+#endif
+}
+
+//////////////////////////////////////////////////
+bool detail::SetCurrentThreadAffinity(const std::vector<unsigned int> &_cpus)
+{
+  if (_cpus.empty())
+    return false;
+
+#ifdef __linux__
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (const auto cpu : _cpus)
+  {
+    if (cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &cpuSet);
+    else
+      ignwarn << "Ignoring out-of-range CPU [" << cpu << "]" << std::endl;
+  }
+
+  if (0 != pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet))
+  {
+    ignwarn << "Failed to set thread CPU affinity." << std::endl;
+    return false;
+  }
+  return true;
+#else
+  ignwarn << "Thread CPU affinity is not supported on this platform."
+          << std::endl;
+  return false;
+#endif
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_CPUAFFINITY_HH_
+#define IGNITION_GAZEBO_CPUAFFINITY_HH_
+
+#include <vector>
+
+#include "ignition/gazebo/config.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    namespace detail
+    {
+    /// \brief Get the CPUs the calling thread may run on.
+    /// \return The CPU indices in the thread's affinity mask, or an
+    /// empty vector on platforms without thread affinity support.
+    std::vector<unsigned int> CurrentThreadAffinity();
+
+    /// \brief Restrict the calling thread to a set of CPUs. Threads
+    /// spawned afterwards by this thread inherit the mask, and on NUMA
+    /// machines first-touch allocation places the thread's memory on
+    /// the node owning those CPUs.
+    /// \param[in] _cpus CPU indices to run on. Ignored when empty.
+    /// \return True if the mask was applied. False on platforms without
+    /// thread affinity support, or when every given CPU is invalid.
+    bool SetCurrentThreadAffinity(const std::vector<unsigned int> &_cpus);
+    }
+    }
+  }
+}
+#endif
@@ -15,14 +15,43 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <ignition/common/Profiler.hh>
-#include <ignition/math/graph/GraphAlgorithms.hh>
+#include <ignition/common/WorkerPool.hh>
+#include "ignition/gazebo/components/AngularVelocity.hh"
+#include "ignition/gazebo/components/Collision.hh"
 #include "ignition/gazebo/components/Component.hh"
 #include "ignition/gazebo/components/Factory.hh"
+#include "ignition/gazebo/components/Joint.hh"
+#include "ignition/gazebo/components/JointPosition.hh"
+#include "ignition/gazebo/components/JointPositionReset.hh"
+#include "ignition/gazebo/components/JointVelocity.hh"
+#include "ignition/gazebo/components/JointVelocityReset.hh"
+#include "ignition/gazebo/components/Light.hh"
+#include "ignition/gazebo/components/LinearVelocity.hh"
+#include "ignition/gazebo/components/Link.hh"
+#include "ignition/gazebo/components/Model.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/ParentEntity.hh"
+#include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/components/PoseCmd.hh"
+#include "ignition/gazebo/components/Sensor.hh"
+#include "ignition/gazebo/components/Visual.hh"
+#include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 
 using namespace ignition;
@@ -43,20 +72,86 @@ class ignition::gazebo::EntityComponentManagerPrivate
   public: void InsertEntityRecursive(Entity _entity,
       std::set<Entity> &_set);
 
+  /// \brief Rebuild the Euler tour of the entity tree: entityTour in
+  /// depth-first order plus the half-open interval each entity's subtree
+  /// occupies in it. Called lazily on the first descendant query after a
+  /// topology change.
+  public: void RebuildEntityTour() const;
+
+  /// \brief Record _entity and its subtree in the Euler tour.
+  /// \param[in] _entity Entity to be recorded.
+  public: void RecordTourRecursive(Entity _entity) const;
+
+  /// \brief Move an entity's subtree interval to its new parent in the
+  /// Euler tour, keeping the tour exact through a reparent so the next
+  /// descendant query doesn't pay for a full rebuild.
+  /// \param[in] _child Entity being reparented.
+  /// \param[in] _parent New parent, or kNullEntity to make a root.
+  /// \return False if the tour couldn't be kept up to date and must be
+  /// marked dirty instead.
+  public: bool SpliceTourSubtree(Entity _child, Entity _parent);
+
   /// \brief Register a new component type.
   /// \param[in] _typeId Type if of the new component.
   /// \return True if created successfully.
   public: bool CreateComponentStorage(const ComponentTypeId _typeId);
 
+  /// \brief Get writable access to a component type's storage, detaching
+  /// it first if it is still shared with a cloned manager. Every path
+  /// that mutates a storage must go through here, so writes after a
+  /// Clone never reach the other manager.
+  /// \param[in] _typeId Type id of the component.
+  /// \return Pointer to the storage, or nullptr if the component type
+  /// has never been created.
+  public: ComponentStorageBase *WritableStorage(
+      const ComponentTypeId _typeId);
+
   /// \brief Map of component storage classes. The key is a component
-  /// type id, and the value is a pointer to the component storage.
+  /// type id, and the value is a pointer to the component storage. The
+  /// pointers are shared with cloned managers until a write detaches
+  /// them; see WritableStorage.
   public: std::map<ComponentTypeId,
-          std::unique_ptr<ComponentStorageBase>> components;
+          std::shared_ptr<ComponentStorageBase>> components;
+
+  /// \brief Whether this manager has ever been involved in a Clone, in
+  /// which case storages may be shared and mutable accesses have to
+  /// detach them. Stays false otherwise, so managers that never fork
+  /// skip the bookkeeping.
+  public: bool storagesShared{false};
 
   /// \brief A graph holding all entities, arranged according to their
   /// parenting.
   public: EntityGraph entities;
 
+  /// \brief Mark an entity's component of a particular type as changed.
+  /// \param[in] _entity The entity.
+  /// \param[in] _typeId Id of the component type.
+  public: void MarkChanged(const Entity _entity,
+      const ComponentTypeId _typeId);
+
+  /// \brief Clear the changed mark of an entity's component.
+  /// \param[in] _entity The entity.
+  /// \param[in] _typeId Id of the component type.
+  public: void UnmarkChanged(const Entity _entity,
+      const ComponentTypeId _typeId);
+
+  /// \brief Per-type dirty tracking. The bitset holds one bit per entity
+  /// slot and is the source of truth; the entity list records which slots
+  /// had their bit raised so changed entities can be enumerated in
+  /// O(changed) instead of scanning all entities. Entries whose bit has
+  /// since been cleared are skipped during enumeration.
+  public: struct ChangedTracker
+  {
+    /// \brief One bit per entity slot, indexed by entity id.
+    std::vector<bool> bits;
+
+    /// \brief Entities whose bit was raised since the last reset.
+    std::vector<Entity> entities;
+  };
+
+  /// \brief Dirty trackers, one per component type that has had changes.
+  public: std::map<ComponentTypeId, ChangedTracker> changedTrackers;
+
   /// \brief Components that have been changed through a peridic change.
   public: std::set<ComponentKey> periodicChangedComponents;
 
@@ -69,12 +164,99 @@ class ignition::gazebo::EntityComponentManagerPrivate
   /// \brief Entities that need to be removed.
   public: std::set<Entity> toRemoveEntities;
 
+  /// \brief Entities whose removal has been processed, so they are out of
+  /// all views already, but whose storage hasn't been reclaimed yet
+  /// because of the removal budget.
+  public: std::set<Entity> tombstoneEntities;
+
+  /// \brief Maximum number of entities destroyed per call to
+  /// ProcessRemoveEntityRequests. Zero destroys all of them.
+  public: uint64_t removalBudget{0};
+
+  /// \brief Entities that belong only to levels loaded as buffer zones.
+  /// Maintained by the level manager and mirrored into each view's
+  /// buffered partition, so EachActive can skip them.
+  public: std::set<Entity> levelBufferedEntities;
+
   /// \brief Flag that indicates if all entities should be removed.
   public: bool removeAllEntities{false};
 
+  /// \brief Look up the id of an entity's component of a particular type.
+  /// \param[in] _entity The entity.
+  /// \param[in] _typeId Id of the component type.
+  /// \return The component's id in its type's storage, or
+  /// kComponentIdInvalid if the entity has no component of that type.
+  public: ComponentId EntityComponentId(const Entity _entity,
+      const ComponentTypeId _typeId) const;
+
+  /// \brief Record the id of an entity's component of a particular type.
+  /// \param[in] _entity The entity.
+  /// \param[in] _typeId Id of the component type.
+  /// \param[in] _id The component's id, or kComponentIdInvalid to clear
+  /// the entry.
+  public: void SetEntityComponentId(const Entity _entity,
+      const ComponentTypeId _typeId, const ComponentId _id);
+
   /// \brief The set of components that each entity has
   public: std::map<Entity, std::vector<ComponentKey>> entityComponents;
 
+  /// \brief Remove an entity's entry from the name index.
+  /// \param[in] _entity The entity.
+  /// \param[in] _name The name the entity is currently indexed under.
+  public: void RemoveFromNameIndex(const Entity _entity,
+      const std::string &_name);
+
+  /// \brief Index from name to the entities holding a name component with
+  /// that value. Each distinct name is stored once as a key, and lookups
+  /// by name become a hash probe instead of a scan with string compares.
+  /// The index is maintained by the component create/remove paths and by
+  /// SetState when it deserializes over an existing name component.
+  public: std::unordered_multimap<std::string, Entity> nameIndex;
+
+  /// \brief Sparse-set index from entity to component id, per component
+  /// type. Entities are created sequentially, so the vector is indexed
+  /// directly by entity id and holds the id of the entity's component in
+  /// that type's storage, or kComponentIdInvalid if the entity has none.
+  /// This makes component lookups and EntityMatches checks array indexes
+  /// instead of a tree walk plus a linear scan of ComponentKeys.
+  public: std::map<ComponentTypeId, std::vector<ComponentId>>
+          componentIdIndex;
+
+  /// \brief Set or clear a bit in a mask, growing the mask as needed.
+  /// \param[in, out] _mask Mask to modify.
+  /// \param[in] _bit Bit index to modify.
+  /// \param[in] _value New value of the bit.
+  public: static void SetMaskBit(std::vector<uint64_t> &_mask,
+      const std::size_t _bit, const bool _value);
+
+  /// \brief Check whether every bit of a required mask is set in another
+  /// mask. The masks may have different lengths; missing words count as
+  /// zero.
+  /// \param[in] _required Mask with the required bits.
+  /// \param[in] _mask Mask to test.
+  /// \return True if _mask has all of _required's bits set.
+  public: static bool MaskContains(const std::vector<uint64_t> &_required,
+      const std::vector<uint64_t> &_mask);
+
+  /// \brief Set or clear a bit in an entity's component mask.
+  /// \param[in] _entity The entity.
+  /// \param[in] _bit Bit index to modify.
+  /// \param[in] _value New value of the bit.
+  public: void SetEntityMaskBit(const Entity _entity,
+      const std::size_t _bit, const bool _value);
+
+  /// \brief Bit index assigned to every component type that appears in
+  /// at least one view. Bits are assigned when a view first requires the
+  /// type and are never reassigned, so entity masks stay valid across
+  /// view churn.
+  public: mutable std::map<ComponentTypeId, std::size_t> viewTypeBits;
+
+  /// \brief Per-entity bitmask over the types in viewTypeBits. Each view
+  /// keeps the matching mask over its required types, so view membership
+  /// in UpdateViews is a word-wise subset test per view instead of a
+  /// lookup per required component type.
+  public: mutable std::map<Entity, std::vector<uint64_t>> entityMasks;
+
   /// \brief A mutex to protect newly created entityes.
   public: std::mutex entityCreatedMutex;
 
@@ -87,15 +269,254 @@ class ignition::gazebo::EntityComponentManagerPrivate
   /// \brief The set of all views.
   public: mutable std::map<detail::ComponentTypeKey, detail::View> views;
 
-  /// \brief Cache of previously queried descendants. The key is the parent
-  /// entity for which descendants were queried, and the value are all its
-  /// descendants.
-  public: mutable std::map<Entity, std::unordered_set<Entity>> descendantCache;
+  /// \brief Entities in depth-first (Euler tour) order. A subtree is a
+  /// contiguous range of this vector, so enumerating descendants is a
+  /// range scan instead of a graph traversal per queried entity.
+  public: mutable std::vector<Entity> entityTour;
+
+  /// \brief Half-open [enter, exit) interval that each entity's subtree
+  /// occupies in entityTour. Testing whether one entity descends from
+  /// another is two integer comparisons against the ancestor's interval.
+  public: mutable std::unordered_map<Entity,
+      std::pair<std::size_t, std::size_t>> entityTourIntervals;
+
+  /// \brief Whether the Euler tour must be rebuilt before the next
+  /// descendant query. Entity creation appends to the tour and
+  /// reparenting splices it, so only removal raises this; the rebuild
+  /// is one depth-first walk of the whole tree, amortized over all
+  /// queries between topology changes.
+  public: mutable bool tourDirty{true};
+
+  /// \brief Cache of previously queried scoped name chains. The key is the
+  /// entity for which the chain was queried, and the value are the (type
+  /// prefix, name) pairs from the root of the tree down to that entity.
+  /// Cleared whenever a rename, reparent or removal could make a cached
+  /// chain stale.
+  public: mutable std::unordered_map<Entity,
+      std::vector<std::pair<std::string, std::string>>> scopedNameCache;
 
   /// \brief Keep track of entities already used to ensure uniqueness.
   public: uint64_t entityCount{0};
+
+  /// \brief Entity ids that have been removed and are available for
+  /// reuse, ordered so that the lowest id is handed out first. Recycling
+  /// slots keeps the entity-indexed structures dense and bounded on long
+  /// runs with continuous entity churn, such as level streaming.
+  public: std::set<Entity> availableEntities;
+
+  /// \brief Generation of each entity slot, indexed by entity id. A
+  /// slot's generation is incremented every time its id is reused, so
+  /// holders of a stale id can detect that it now refers to a different
+  /// entity.
+  public: std::vector<uint64_t> entityGenerations;
+
+  /// \brief One recorded world pose sample.
+  public: struct PoseSample
+  {
+    /// \brief Simulation time the sample was recorded at.
+    std::chrono::steady_clock::duration time;
+
+    /// \brief World pose at that time.
+    math::Pose3d pose;
+  };
+
+  /// \brief Fixed-depth sample ring for one tracked entity.
+  public: struct PoseHistory
+  {
+    /// \brief Number of samples the ring holds before overwriting.
+    std::size_t depth{16};
+
+    /// \brief Recorded samples. Grows up to depth, after which the
+    /// slot at head is the oldest and gets overwritten first.
+    std::vector<PoseSample> samples;
+
+    /// \brief Index of the next slot to overwrite once the ring is
+    /// full.
+    std::size_t head{0};
+  };
+
+  /// \brief World poses from the batched sweep, by entity. Only
+  /// entities with a pose component have an entry. See
+  /// EntityComponentManager::WorldPose.
+  public: mutable std::unordered_map<Entity, math::Pose3d> worldPoses;
+
+  /// \brief Whether worldPoses holds the current step's sweep.
+  public: mutable std::atomic<bool> worldPosesValid{false};
+
+  /// \brief Guards the sweep that fills worldPoses; queries may race
+  /// in from systems on worker threads.
+  public: mutable std::mutex worldPoseMutex;
+
+  /// \brief Pose histories of the tracked entities. See
+  /// EntityComponentManager::TrackPoseHistory.
+  public: mutable std::map<Entity, PoseHistory> poseHistories;
+
+  /// \brief Guards poseHistories; tracking requests may arrive from
+  /// systems running on worker threads.
+  public: mutable std::mutex poseHistoryMutex;
+
+  /// \brief Cumulative structural churn counters. Relaxed atomics so
+  /// the stats service can read them from a transport thread while the
+  /// stepping thread mutates entities. See
+  /// EntityComponentManager::Churn.
+  public: std::atomic<uint64_t> entitiesCreatedCount{0};
+
+  /// \brief Number of entities destroyed. See entitiesCreatedCount.
+  public: std::atomic<uint64_t> entitiesRemovedCount{0};
+
+  /// \brief Number of components created. See entitiesCreatedCount.
+  public: std::atomic<uint64_t> componentsCreatedCount{0};
+
+  /// \brief Number of components removed. See entitiesCreatedCount.
+  public: std::atomic<uint64_t> componentsRemovedCount{0};
+
+  /// \brief Number of view membership refreshes. See
+  /// entitiesCreatedCount.
+  public: std::atomic<uint64_t> viewsUpdatedCount{0};
+
+  /// \brief Cumulative component churn by type: components created and
+  /// removed. Guarded by componentChurnMutex.
+  public: std::unordered_map<ComponentTypeId, std::pair<uint64_t, uint64_t>>
+      componentChurn;
+
+  /// \brief Guards componentChurn.
+  public: mutable std::mutex componentChurnMutex;
+
+  /// \brief A pool of worker threads used by EachParallel.
+  public: mutable common::WorkerPool workerPool{
+          std::max(1u, std::thread::hardware_concurrency())};
+
+  /// \brief One change flag buffered by SetChangedParallel.
+  public: struct BufferedChange
+  {
+    /// \brief The entity whose component changed.
+    Entity entity;
+
+    /// \brief Type of the changed component.
+    ComponentTypeId type;
+
+    /// \brief Changed state value.
+    gazebo::ComponentState state;
+  };
+
+  /// \brief Change flags buffered during a parallel pass, one shard per
+  /// dispatched task. Each shard is written by exactly one worker
+  /// thread, so flagging changes from an EachParallel callback touches
+  /// no shared state; the shards are merged into the trackers above on
+  /// the dispatching thread when the pass completes.
+  public: mutable std::vector<std::vector<BufferedChange>> changeShards;
 };
 
+/// \brief Change shard owned by the calling worker thread for the
+/// duration of one parallel task, null outside of one.
+static thread_local std::vector<
+    EntityComponentManagerPrivate::BufferedChange> *gChangeShard{nullptr};
+
+/////////////////////////////////////////////////
+ComponentId EntityComponentManagerPrivate::EntityComponentId(
+    const Entity _entity, const ComponentTypeId _typeId) const
+{
+  auto typeIter = this->componentIdIndex.find(_typeId);
+  if (typeIter == this->componentIdIndex.end() ||
+      _entity >= typeIter->second.size())
+  {
+    return kComponentIdInvalid;
+  }
+  return typeIter->second[_entity];
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::SetEntityComponentId(
+    const Entity _entity, const ComponentTypeId _typeId,
+    const ComponentId _id)
+{
+  auto &index = this->componentIdIndex[_typeId];
+  if (_entity >= index.size())
+    index.resize(_entity + 1, kComponentIdInvalid);
+  index[_entity] = _id;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::SetMaskBit(
+    std::vector<uint64_t> &_mask, const std::size_t _bit, const bool _value)
+{
+  const std::size_t word = _bit / 64;
+  const uint64_t bit = 1ull << (_bit % 64);
+  if (word >= _mask.size())
+  {
+    if (!_value)
+      return;
+    _mask.resize(word + 1, 0);
+  }
+  if (_value)
+    _mask[word] |= bit;
+  else
+    _mask[word] &= ~bit;
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManagerPrivate::MaskContains(
+    const std::vector<uint64_t> &_required, const std::vector<uint64_t> &_mask)
+{
+  for (std::size_t word = 0; word < _required.size(); ++word)
+  {
+    const uint64_t has = word < _mask.size() ? _mask[word] : 0;
+    if ((_required[word] & ~has) != 0)
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::SetEntityMaskBit(
+    const Entity _entity, const std::size_t _bit, const bool _value)
+{
+  this->SetMaskBit(this->entityMasks[_entity], _bit, _value);
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::RemoveFromNameIndex(
+    const Entity _entity, const std::string &_name)
+{
+  auto range = this->nameIndex.equal_range(_name);
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    if (iter->second == _entity)
+    {
+      this->nameIndex.erase(iter);
+      break;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::MarkChanged(
+    const Entity _entity, const ComponentTypeId _typeId)
+{
+  auto &tracker = this->changedTrackers[_typeId];
+  if (_entity >= tracker.bits.size())
+    tracker.bits.resize(_entity + 1, false);
+  if (!tracker.bits[_entity])
+  {
+    tracker.bits[_entity] = true;
+    tracker.entities.push_back(_entity);
+  }
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::UnmarkChanged(
+    const Entity _entity, const ComponentTypeId _typeId)
+{
+  auto trackerIter = this->changedTrackers.find(_typeId);
+  if (trackerIter != this->changedTrackers.end() &&
+      _entity < trackerIter->second.bits.size())
+  {
+    // The entity stays in the enumeration list, but the cleared bit makes
+    // it be skipped.
+    trackerIter->second.bits[_entity] = false;
+  }
+}
+
 //////////////////////////////////////////////////
 EntityComponentManager::EntityComponentManager()
   : dataPtr(new EntityComponentManagerPrivate)
@@ -114,22 +535,52 @@ size_t EntityComponentManager::EntityCount() const
 /////////////////////////////////////////////////
 Entity EntityComponentManager::CreateEntity()
 {
-  Entity entity = ++this->dataPtr->entityCount;
+  Entity entity;
 
-  if (entity == std::numeric_limits<int64_t>::max())
+  // Reuse a removed entity's slot when one is available, otherwise
+  // allocate a fresh id.
+  if (!this->dataPtr->availableEntities.empty())
   {
-    ignwarn << "Reached maximum number of entities [" << entity << "]"
-            << std::endl;
-    return entity;
+    entity = *this->dataPtr->availableEntities.begin();
+  }
+  else
+  {
+    entity = ++this->dataPtr->entityCount;
+
+    if (entity == std::numeric_limits<int64_t>::max())
+    {
+      ignwarn << "Reached maximum number of entities [" << entity << "]"
+              << std::endl;
+      return entity;
+    }
   }
 
   return this->dataPtr->CreateEntityImplementation(entity);
 }
 
+/////////////////////////////////////////////////
+uint64_t EntityComponentManager::EntityGeneration(const Entity _entity) const
+{
+  if (_entity < this->dataPtr->entityGenerations.size())
+    return this->dataPtr->entityGenerations[_entity];
+  return 0;
+}
+
 /////////////////////////////////////////////////
 Entity EntityComponentManagerPrivate::CreateEntityImplementation(Entity _entity)
 {
   IGN_PROFILE("EntityComponentManager::CreateEntityImplementation");
+  // If the id comes from the free list (or matches a recycled id set by a
+  // peer through SetState), claim the slot and bump its generation.
+  auto availableIter = this->availableEntities.find(_entity);
+  if (availableIter != this->availableEntities.end())
+  {
+    this->availableEntities.erase(availableIter);
+    ++this->entityGenerations[_entity];
+  }
+  if (_entity >= this->entityGenerations.size())
+    this->entityGenerations.resize(_entity + 1, 0u);
+
   this->entities.AddVertex(std::to_string(_entity), _entity, _entity);
 
   // Add entity to the list of newly created entities
@@ -138,8 +589,16 @@ Entity EntityComponentManagerPrivate::CreateEntityImplementation(Entity _entity)
     this->newlyCreatedEntities.insert(_entity);
   }
 
-  // Reset descendants cache
-  this->descendantCache.clear();
+  // Keep the Euler tour exact: a new entity starts as a childless root
+  // at the end of the tour
+  if (!this->tourDirty)
+  {
+    this->entityTourIntervals[_entity] = {this->entityTour.size(),
+        this->entityTour.size() + 1};
+    this->entityTour.push_back(_entity);
+  }
+
+  this->entitiesCreatedCount.fetch_add(1, std::memory_order_relaxed);
 
   return _entity;
 }
@@ -167,6 +626,121 @@ void EntityComponentManagerPrivate::InsertEntityRecursive(Entity _entity,
   _set.insert(_entity);
 }
 
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::RecordTourRecursive(Entity _entity) const
+{
+  const std::size_t enter = this->entityTour.size();
+  this->entityTour.push_back(_entity);
+  for (const auto &vertex : this->entities.AdjacentsFrom(_entity))
+  {
+    this->RecordTourRecursive(vertex.first);
+  }
+  this->entityTourIntervals[_entity] = {enter, this->entityTour.size()};
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::RebuildEntityTour() const
+{
+  IGN_PROFILE("EntityComponentManagerPrivate::RebuildEntityTour");
+  this->entityTour.clear();
+  this->entityTourIntervals.clear();
+
+  // Walk down from every root of the forest
+  for (const auto &vertex : this->entities.Vertices())
+  {
+    if (this->entities.AdjacentsTo(vertex.first).empty())
+      this->RecordTourRecursive(vertex.first);
+  }
+
+  this->tourDirty = false;
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManagerPrivate::SpliceTourSubtree(Entity _child,
+    Entity _parent)
+{
+  // Nothing to keep up to date; the next query rebuilds anyway
+  if (this->tourDirty)
+    return true;
+
+  auto childIter = this->entityTourIntervals.find(_child);
+  if (childIter == this->entityTourIntervals.end())
+    return false;
+
+  const std::size_t childBegin = childIter->second.first;
+  const std::size_t childEnd = childIter->second.second;
+  const std::size_t size = childEnd - childBegin;
+
+  // Destination index after the subtree's slice has been removed:
+  // right after the parent's own tour entry, so the child becomes the
+  // parent's first child, or the end of the tour for a new root.
+  std::size_t dest;
+  if (kNullEntity == _parent)
+  {
+    dest = this->entityTour.size() - size;
+  }
+  else
+  {
+    auto parentIter = this->entityTourIntervals.find(_parent);
+    if (parentIter == this->entityTourIntervals.end())
+      return false;
+
+    std::size_t parentBegin = parentIter->second.first;
+
+    // Parenting an entity to its own descendant would make a cycle;
+    // leave that to a full rebuild.
+    if (parentBegin >= childBegin && parentBegin < childEnd)
+      return false;
+
+    if (parentBegin >= childEnd)
+      parentBegin -= size;
+    dest = parentBegin + 1;
+  }
+
+  // Move the subtree's slice of the tour
+  std::vector<Entity> slice(this->entityTour.begin() + childBegin,
+      this->entityTour.begin() + childEnd);
+  this->entityTour.erase(this->entityTour.begin() + childBegin,
+      this->entityTour.begin() + childEnd);
+  this->entityTour.insert(this->entityTour.begin() + dest,
+      slice.begin(), slice.end());
+
+  // Fix up the intervals with boundary arithmetic: entities inside the
+  // slice move with it, boundaries past the removed range shift down,
+  // and boundaries at or past the insertion shift back up. An interval
+  // ending exactly at the insertion index must contain the parent's own
+  // entry, so exactly the new ancestors grow to cover the slice. When
+  // the child becomes a root the slice lands after every remaining
+  // boundary and nothing shifts back up.
+  const bool insertAtEnd = kNullEntity == _parent;
+  auto shift = [&](std::size_t _index) -> std::size_t
+  {
+    if (_index >= childEnd)
+      _index -= size;
+    if (_index >= dest && !insertAtEnd)
+      _index += size;
+    return _index;
+  };
+
+  for (auto &interval : this->entityTourIntervals)
+  {
+    std::size_t &begin = interval.second.first;
+    std::size_t &end = interval.second.second;
+    if (begin >= childBegin && end <= childEnd)
+    {
+      begin = begin - childBegin + dest;
+      end = end - childBegin + dest;
+    }
+    else
+    {
+      begin = shift(begin);
+      end = shift(end);
+    }
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 void EntityComponentManager::RequestRemoveEntity(Entity _entity,
     bool _recursive)
@@ -205,24 +779,88 @@ void EntityComponentManager::RequestRemoveEntities()
   this->RebuildViews();
 }
 
+/////////////////////////////////////////////////
+void EntityComponentManager::SetRemovalBudget(uint64_t _budget)
+{
+  this->dataPtr->removalBudget = _budget;
+}
+
+/////////////////////////////////////////////////
+uint64_t EntityComponentManager::RemovalBudget() const
+{
+  return this->dataPtr->removalBudget;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::SetEntityLevelBuffered(Entity _entity,
+    bool _buffered)
+{
+  if (_buffered)
+  {
+    if (!this->dataPtr->levelBufferedEntities.insert(_entity).second)
+      return;
+  }
+  else if (0 == this->dataPtr->levelBufferedEntities.erase(_entity))
+  {
+    return;
+  }
+
+  // Mirror the flag into the buffered partition of every view that
+  // contains the entity.
+  for (auto &view : this->dataPtr->views)
+  {
+    if (!view.second.HasEntity(_entity))
+      continue;
+
+    if (_buffered)
+      view.second.bufferedEntities.insert(_entity);
+    else
+      view.second.bufferedEntities.erase(_entity);
+  }
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManager::EntityLevelBuffered(Entity _entity) const
+{
+  return this->dataPtr->levelBufferedEntities.find(_entity) !=
+         this->dataPtr->levelBufferedEntities.end();
+}
+
 /////////////////////////////////////////////////
 void EntityComponentManager::ProcessRemoveEntityRequests()
 {
   IGN_PROFILE("EntityComponentManager::ProcessRemoveEntityRequests");
   std::lock_guard<std::mutex> lock(this->dataPtr->entityRemoveMutex);
+  this->dataPtr->worldPosesValid.store(false, std::memory_order_release);
   // Short-cut if erasing all entities
   if (this->dataPtr->removeAllEntities)
   {
     IGN_PROFILE("RemoveAll");
     this->dataPtr->removeAllEntities = false;
+    this->dataPtr->entitiesRemovedCount.fetch_add(
+        this->dataPtr->entities.Vertices().size(),
+        std::memory_order_relaxed);
+    // Return every slot to the free list so the ids can be recycled.
+    for (const auto &vertex : this->dataPtr->entities.Vertices())
+      this->dataPtr->availableEntities.insert(vertex.first);
     this->dataPtr->entities = EntityGraph();
     this->dataPtr->entityComponents.clear();
+    this->dataPtr->entityMasks.clear();
+    this->dataPtr->componentIdIndex.clear();
+    this->dataPtr->changedTrackers.clear();
+    this->dataPtr->nameIndex.clear();
     this->dataPtr->toRemoveEntities.clear();
+    this->dataPtr->tombstoneEntities.clear();
+    this->dataPtr->levelBufferedEntities.clear();
 
-    for (std::pair<const ComponentTypeId,
-        std::unique_ptr<ComponentStorageBase>> &comp: this->dataPtr->components)
+    for (auto &comp : this->dataPtr->components)
     {
-      comp.second->RemoveAll();
+      // A storage still shared with a cloned manager is detached rather
+      // than cleared, so the clone keeps its components.
+      if (comp.second.use_count() > 1)
+        comp.second = components::Factory::Instance()->NewStorage(comp.first);
+      else
+        comp.second->RemoveAll();
     }
 
     // All views are now invalid.
@@ -231,13 +869,39 @@ void EntityComponentManager::ProcessRemoveEntityRequests()
   else
   {
     IGN_PROFILE("Remove");
-    // Otherwise iterate through the list of entities to remove.
+    // Tombstone the requested entities: remove them from all views right
+    // away, so Each calls stop seeing them, while their storage is
+    // reclaimed below within the removal budget.
     for (const Entity entity : this->dataPtr->toRemoveEntities)
     {
       // Make sure the entity exists and is not removed.
       if (!this->HasEntity(entity))
         continue;
 
+      // Remove the entity from views.
+      for (auto &view : this->dataPtr->views)
+      {
+        view.second.RemoveEntity(entity, view.first);
+      }
+
+      this->dataPtr->tombstoneEntities.insert(entity);
+    }
+    // Clear the set of entities to remove.
+    this->dataPtr->toRemoveEntities.clear();
+
+    // Destroy tombstoned entities, at most removalBudget of them per call
+    // when a budget is set, so large removals are amortized over steps.
+    uint64_t destroyed = 0;
+    auto tombIter = this->dataPtr->tombstoneEntities.begin();
+    while (tombIter != this->dataPtr->tombstoneEntities.end())
+    {
+      if (this->dataPtr->removalBudget > 0 &&
+          destroyed >= this->dataPtr->removalBudget)
+      {
+        break;
+      }
+      const Entity entity = *tombIter;
+
       // Remove from graph
       this->dataPtr->entities.RemoveVertex(entity);
 
@@ -248,25 +912,38 @@ void EntityComponentManager::ProcessRemoveEntityRequests()
         for (const ComponentKey &key :
             this->dataPtr->entityComponents.at(entity))
         {
-          this->dataPtr->components.at(key.first)->Remove(key.second);
+          if (components::Name::typeId == key.first)
+          {
+            auto nameComp = static_cast<const components::Name *>(
+                this->dataPtr->components.at(key.first)->Component(key.second));
+            if (nullptr != nameComp)
+              this->dataPtr->RemoveFromNameIndex(entity, nameComp->Data());
+          }
+          this->dataPtr->WritableStorage(key.first)->Remove(key.second);
+          this->dataPtr->SetEntityComponentId(entity, key.first,
+              kComponentIdInvalid);
+          this->dataPtr->UnmarkChanged(entity, key.first);
         }
 
         // Remove the entry in the entityComponent map
         this->dataPtr->entityComponents.erase(entity);
       }
+      this->dataPtr->entityMasks.erase(entity);
 
-      // Remove the entity from views.
-      for (auto &view : this->dataPtr->views)
-      {
-        view.second.RemoveEntity(entity, view.first);
-      }
+      // Return the slot to the free list so the id can be recycled.
+      this->dataPtr->availableEntities.insert(entity);
+      this->dataPtr->levelBufferedEntities.erase(entity);
+
+      ++destroyed;
+      tombIter = this->dataPtr->tombstoneEntities.erase(tombIter);
     }
-    // Clear the set of entities to remove.
-    this->dataPtr->toRemoveEntities.clear();
+    this->dataPtr->entitiesRemovedCount.fetch_add(destroyed,
+        std::memory_order_relaxed);
   }
 
-  // Reset descendants cache
-  this->dataPtr->descendantCache.clear();
+  // Reset the Euler tour and the scoped name cache
+  this->dataPtr->tourDirty = true;
+  this->dataPtr->scopedNameCache.clear();
 }
 
 /////////////////////////////////////////////////
@@ -291,10 +968,42 @@ bool EntityComponentManager::RemoveComponent(
       this->dataPtr->entityComponents[_entity].begin(),
       this->dataPtr->entityComponents[_entity].end(), _key);
 
-  this->dataPtr->components.at(_key.first)->Remove(_key.second);
+  // Drop the entity's entry from the name index before the component's
+  // value is destroyed.
+  if (components::Name::typeId == _key.first)
+  {
+    auto nameComp = static_cast<const components::Name *>(
+        this->dataPtr->components.at(_key.first)->Component(_key.second));
+    if (nullptr != nameComp)
+      this->dataPtr->RemoveFromNameIndex(_entity, nameComp->Data());
+  }
+
+  // Removing a name or parent component can make cached scoped name
+  // chains stale, for this entity and for everything below it.
+  if (components::Name::typeId == _key.first ||
+      components::ParentEntity::typeId == _key.first)
+  {
+    this->dataPtr->scopedNameCache.clear();
+  }
+
+  this->dataPtr->WritableStorage(_key.first)->Remove(_key.second);
   this->dataPtr->entityComponents[_entity].erase(entityComponentIter);
+  this->dataPtr->SetEntityComponentId(_entity, _key.first,
+      kComponentIdInvalid);
+
+  auto bitIter = this->dataPtr->viewTypeBits.find(_key.first);
+  if (bitIter != this->dataPtr->viewTypeBits.end())
+    this->dataPtr->SetEntityMaskBit(_entity, bitIter->second, false);
   this->dataPtr->oneTimeChangedComponents.erase(_key);
   this->dataPtr->periodicChangedComponents.erase(_key);
+  this->dataPtr->UnmarkChanged(_entity, _key.first);
+
+  this->dataPtr->componentsRemovedCount.fetch_add(1,
+      std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->componentChurnMutex);
+    ++this->dataPtr->componentChurn[_key.first].second;
+  }
 
   this->UpdateViews(_entity);
   return true;
@@ -317,16 +1026,8 @@ bool EntityComponentManager::EntityHasComponentType(const Entity _entity,
   if (!this->HasEntity(_entity))
     return false;
 
-  auto iter = this->dataPtr->entityComponents.find(_entity);
-
-  if (iter == this->dataPtr->entityComponents.end())
-    return false;
-
-  return std::find_if(iter->second.begin(), iter->second.end(),
-      [&] (const ComponentKey &_key)
-      {
-        return _key.first == _typeId;
-      }) != iter->second.end();
+  return kComponentIdInvalid !=
+      this->dataPtr->EntityComponentId(_entity, _typeId);
 }
 
 /////////////////////////////////////////////////
@@ -346,7 +1047,17 @@ bool EntityComponentManager::IsMarkedForRemoval(const Entity _entity) const
     return true;
   }
   return this->dataPtr->toRemoveEntities.find(_entity) !=
-         this->dataPtr->toRemoveEntities.end();
+             this->dataPtr->toRemoveEntities.end() ||
+         this->dataPtr->tombstoneEntities.find(_entity) !=
+             this->dataPtr->tombstoneEntities.end();
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManager::IsTombstoned(const Entity _entity) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityRemoveMutex);
+  return this->dataPtr->tombstoneEntities.find(_entity) !=
+         this->dataPtr->tombstoneEntities.end();
 }
 
 /////////////////////////////////////////////////
@@ -355,26 +1066,19 @@ ComponentState EntityComponentManager::ComponentState(const Entity _entity,
 {
   auto result = ComponentState::NoChange;
 
-  auto ecIter = this->dataPtr->entityComponents.find(_entity);
+  const auto id = this->dataPtr->EntityComponentId(_entity, _typeId);
 
-  if (ecIter == this->dataPtr->entityComponents.end())
+  if (kComponentIdInvalid == id)
     return result;
 
-  auto iter = std::find_if(ecIter->second.begin(), ecIter->second.end(),
-        [&] (const ComponentKey &_key)
-  {
-    return _key.first == _typeId;
-  });
-
-  if (iter == ecIter->second.end())
-    return result;
+  const ComponentKey key{_typeId, id};
 
-  if (this->dataPtr->oneTimeChangedComponents.find(*iter) !=
+  if (this->dataPtr->oneTimeChangedComponents.find(key) !=
       this->dataPtr->oneTimeChangedComponents.end())
   {
     result = ComponentState::OneTimeChange;
   }
-  else if (this->dataPtr->periodicChangedComponents.find(*iter) !=
+  else if (this->dataPtr->periodicChangedComponents.find(key) !=
       this->dataPtr->periodicChangedComponents.end())
   {
     result = ComponentState::PeriodicChange;
@@ -383,6 +1087,78 @@ ComponentState EntityComponentManager::ComponentState(const Entity _entity,
   return result;
 }
 
+/////////////////////////////////////////////////
+std::map<ComponentTypeId, std::pair<std::size_t, std::size_t>>
+    EntityComponentManager::StorageMemory() const
+{
+  std::map<ComponentTypeId, std::pair<std::size_t, std::size_t>> result;
+  for (const auto &comp : this->dataPtr->components)
+  {
+    result[comp.first] = {comp.second->MemoryUsage(), comp.second->Size()};
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::map<std::set<ComponentTypeId>, std::size_t>
+    EntityComponentManager::ViewMemory() const
+{
+  std::map<std::set<ComponentTypeId>, std::size_t> result;
+
+  // Map nodes carry roughly four pointers of bookkeeping on top of their
+  // value.
+  const std::size_t kNodeOverhead = 4 * sizeof(void *);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->viewsMutex);
+  for (const auto &view : this->dataPtr->views)
+  {
+    const detail::View &v = view.second;
+    std::size_t bytes = sizeof(detail::View);
+    bytes += v.entities.capacity() * sizeof(Entity);
+    bytes += v.toAddEntities.capacity() * sizeof(Entity);
+    bytes += v.toEraseEntities.capacity() * sizeof(Entity);
+    bytes += v.newEntities.capacity() * sizeof(Entity);
+    bytes += v.toRemoveEntities.capacity() * sizeof(Entity);
+    bytes += v.bufferedEntities.size() * (sizeof(Entity) + kNodeOverhead);
+    bytes += v.components.size() *
+        (sizeof(std::pair<const std::pair<Entity, ComponentTypeId>,
+                          ComponentId>) + kNodeOverhead);
+    bytes += v.storages.size() *
+        (sizeof(std::pair<const ComponentTypeId, ComponentStorageBase *>) +
+         kNodeOverhead);
+    result[view.first] = bytes;
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+EntityComponentManager::ChurnCounters EntityComponentManager::Churn() const
+{
+  ChurnCounters counters;
+  counters.entitiesCreated =
+      this->dataPtr->entitiesCreatedCount.load(std::memory_order_relaxed);
+  counters.entitiesRemoved =
+      this->dataPtr->entitiesRemovedCount.load(std::memory_order_relaxed);
+  counters.componentsCreated =
+      this->dataPtr->componentsCreatedCount.load(std::memory_order_relaxed);
+  counters.componentsRemoved =
+      this->dataPtr->componentsRemovedCount.load(std::memory_order_relaxed);
+  counters.viewsUpdated =
+      this->dataPtr->viewsUpdatedCount.load(std::memory_order_relaxed);
+  return counters;
+}
+
+/////////////////////////////////////////////////
+std::map<ComponentTypeId, std::pair<uint64_t, uint64_t>>
+    EntityComponentManager::ComponentChurn() const
+{
+  std::map<ComponentTypeId, std::pair<uint64_t, uint64_t>> result;
+  std::lock_guard<std::mutex> lock(this->dataPtr->componentChurnMutex);
+  for (const auto &entry : this->dataPtr->componentChurn)
+    result[entry.first] = entry.second;
+  return result;
+}
+
 /////////////////////////////////////////////////
 bool EntityComponentManager::HasNewEntities() const
 {
@@ -398,6 +1174,247 @@ bool EntityComponentManager::HasEntitiesMarkedForRemoval() const
       !this->dataPtr->toRemoveEntities.empty();
 }
 
+/////////////////////////////////////////////////
+size_t EntityComponentManager::NewEntityCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityCreatedMutex);
+  return this->dataPtr->newlyCreatedEntities.size();
+}
+
+/////////////////////////////////////////////////
+size_t EntityComponentManager::MarkedForRemovalCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityRemoveMutex);
+  return this->dataPtr->toRemoveEntities.size();
+}
+
+/////////////////////////////////////////////////
+std::set<Entity> EntityComponentManager::NewEntities() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityCreatedMutex);
+  return this->dataPtr->newlyCreatedEntities;
+}
+
+/////////////////////////////////////////////////
+std::set<Entity> EntityComponentManager::EntitiesMarkedForRemoval() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityRemoveMutex);
+  if (this->dataPtr->removeAllEntities)
+  {
+    std::set<Entity> entities;
+    for (const auto &vertex : this->dataPtr->entities.Vertices())
+      entities.insert(vertex.first);
+    return entities;
+  }
+  return this->dataPtr->toRemoveEntities;
+}
+
+/////////////////////////////////////////////////
+std::unique_ptr<EntityComponentManager> EntityComponentManager::Clone()
+{
+  IGN_PROFILE("EntityComponentManager::Clone");
+  auto clone = std::make_unique<EntityComponentManager>();
+  auto &data = *clone->dataPtr;
+
+  // Share the per-type component storages. Either manager detaches and
+  // deep-copies a storage on its first write to that type, so the fork
+  // cost is proportional to what actually diverges.
+  data.components = this->dataPtr->components;
+  data.storagesShared = true;
+  this->dataPtr->storagesShared = true;
+
+  data.entities = this->dataPtr->entities;
+  data.changedTrackers = this->dataPtr->changedTrackers;
+  data.periodicChangedComponents = this->dataPtr->periodicChangedComponents;
+  data.oneTimeChangedComponents = this->dataPtr->oneTimeChangedComponents;
+  data.newlyCreatedEntities = this->dataPtr->newlyCreatedEntities;
+  data.toRemoveEntities = this->dataPtr->toRemoveEntities;
+  data.tombstoneEntities = this->dataPtr->tombstoneEntities;
+  data.removalBudget = this->dataPtr->removalBudget;
+  data.levelBufferedEntities = this->dataPtr->levelBufferedEntities;
+  data.removeAllEntities = this->dataPtr->removeAllEntities;
+  data.entityComponents = this->dataPtr->entityComponents;
+  data.nameIndex = this->dataPtr->nameIndex;
+  data.componentIdIndex = this->dataPtr->componentIdIndex;
+  data.viewTypeBits = this->dataPtr->viewTypeBits;
+  data.entityMasks = this->dataPtr->entityMasks;
+  data.entityCount = this->dataPtr->entityCount;
+  data.availableEntities = this->dataPtr->availableEntities;
+  data.entityGenerations = this->dataPtr->entityGenerations;
+
+  // The views, the Euler tour and the scoped name cache are rebuilt
+  // lazily on first use in the clone.
+  return clone;
+}
+
+/////////////////////////////////////////////////
+/// \brief Tag a state message as carrying raw byte copies for its
+/// raw-copyable components, so consumers know to try DeserializeRaw.
+/// Payload size alone can't discriminate: a legacy text payload such as
+/// "-3.14159" is coincidentally sizeof(double) bytes. Untagged messages,
+/// such as recordings made before raw copies existed, must stay on the
+/// stream operator path.
+/// \param[in, out] _msg Message to tag. Already-tagged messages, such as
+/// a reused delta message, are left as they are.
+template <typename StateMsgT>
+static void TagRawEncoding(StateMsgT &_msg)
+{
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.key() == "raw_components")
+      return;
+  }
+  auto data = _msg.mutable_header()->add_data();
+  data->set_key("raw_components");
+  data->add_value("true");
+}
+
+/////////////////////////////////////////////////
+/// \brief Check for the raw-copy tag written by TagRawEncoding.
+/// \param[in] _msg Message to check.
+/// \return True if the message declares raw-copied component payloads.
+template <typename StateMsgT>
+static bool HasRawEncoding(const StateMsgT &_msg)
+{
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.key() == "raw_components" && data.value_size() > 0 &&
+        data.value(0) == "true")
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::Diff(const EntityComponentManager &_base,
+    msgs::SerializedStateMap &_state) const
+{
+  IGN_PROFILE("EntityComponentManager::Diff");
+
+  TagRawEncoding(_state);
+
+  // Serialize a component with the raw fast path, falling back to the
+  // stream operators, the same way State does.
+  auto serialize = [](const components::BaseComponent *_comp) -> std::string
+  {
+    std::string out;
+    if (!_comp->SerializeRaw(out))
+    {
+      std::ostringstream ostr;
+      _comp->Serialize(ostr);
+      out = ostr.str();
+    }
+    return out;
+  };
+
+  // Add one component entry to an entity's message.
+  auto addComponent = [&_state](const Entity _entity,
+      const ComponentTypeId _typeId, std::string &&_value, bool _remove)
+  {
+    auto &entityMsg = (*_state.mutable_entities())[
+        static_cast<uint64_t>(_entity)];
+    entityMsg.set_id(_entity);
+
+    msgs::SerializedComponent compMsg;
+    compMsg.set_type(_typeId);
+    // Removals carry the base's value as payload; SetState skips
+    // components with an empty payload before it checks the remove
+    // flag, and the value is ignored on the removal path.
+    compMsg.set_component(std::move(_value));
+    compMsg.set_remove(_remove);
+    (*entityMsg.mutable_components())[static_cast<int64_t>(_typeId)] =
+        compMsg;
+  };
+
+  // Component types whose storage is still shared between the two
+  // managers can't have diverged, since every write path detaches the
+  // storage first. Only the remaining types need component-level
+  // comparison, so diffing a fork costs proportional to its divergence.
+  std::set<ComponentTypeId> divergentTypes;
+  for (const auto &comp : this->dataPtr->components)
+  {
+    auto baseIter = _base.dataPtr->components.find(comp.first);
+    if (baseIter == _base.dataPtr->components.end() ||
+        baseIter->second != comp.second)
+    {
+      divergentTypes.insert(comp.first);
+    }
+  }
+  for (const auto &comp : _base.dataPtr->components)
+  {
+    if (this->dataPtr->components.find(comp.first) ==
+        this->dataPtr->components.end())
+    {
+      divergentTypes.insert(comp.first);
+    }
+  }
+
+  for (const auto &it : this->dataPtr->entityComponents)
+  {
+    const Entity entity = it.first;
+    const bool baseHas = _base.HasEntity(entity);
+
+    // Components added or changed relative to the base. Entities the
+    // base doesn't know are serialized in full.
+    for (const ComponentKey &key : it.second)
+    {
+      if (baseHas &&
+          divergentTypes.find(key.first) == divergentTypes.end())
+      {
+        continue;
+      }
+
+      auto comp = this->ComponentImplementation(entity, key.first);
+      if (nullptr == comp)
+        continue;
+
+      std::string value = serialize(comp);
+      if (baseHas)
+      {
+        auto baseComp = _base.ComponentImplementation(entity, key.first);
+        if (nullptr != baseComp && serialize(baseComp) == value)
+          continue;
+      }
+      addComponent(entity, key.first, std::move(value), false);
+    }
+
+    if (!baseHas)
+      continue;
+
+    // Components removed relative to the base.
+    auto baseIter = _base.dataPtr->entityComponents.find(entity);
+    if (baseIter == _base.dataPtr->entityComponents.end())
+      continue;
+    for (const ComponentKey &key : baseIter->second)
+    {
+      if (divergentTypes.find(key.first) == divergentTypes.end())
+        continue;
+      if (kComponentIdInvalid !=
+          this->dataPtr->EntityComponentId(entity, key.first))
+      {
+        continue;
+      }
+      auto baseComp = _base.ComponentImplementation(entity, key.first);
+      if (nullptr == baseComp)
+        continue;
+      addComponent(entity, key.first, serialize(baseComp), true);
+    }
+  }
+
+  // Entities in the base that no longer exist here.
+  for (const auto &it : _base.dataPtr->entityComponents)
+  {
+    if (this->HasEntity(it.first))
+      continue;
+    auto &entityMsg = (*_state.mutable_entities())[
+        static_cast<uint64_t>(it.first)];
+    entityMsg.set_id(it.first);
+    entityMsg.set_remove(true);
+  }
+}
+
 /////////////////////////////////////////////////
 bool EntityComponentManager::HasOneTimeComponentChanges() const
 {
@@ -434,6 +1451,12 @@ bool EntityComponentManager::SetParentEntity(const Entity _child,
     this->dataPtr->entities.RemoveEdge(edge);
   }
 
+  // Reparenting moves a whole subtree: splice its Euler tour interval to
+  // the new position, and drop the cached scoped names.
+  if (!this->dataPtr->SpliceTourSubtree(_child, _parent))
+    this->dataPtr->tourDirty = true;
+  this->dataPtr->scopedNameCache.clear();
+
   // Leave parent-less
   if (_parent == kNullEntity)
   {
@@ -449,6 +1472,23 @@ bool EntityComponentManager::SetParentEntity(const Entity _child,
 ComponentKey EntityComponentManager::CreateComponentImplementation(
     const Entity _entity, const ComponentTypeId _componentTypeId,
     const components::BaseComponent *_data)
+{
+  bool rebuildViews{false};
+  ComponentKey componentKey = this->CreateComponentImplementation(
+      _entity, _componentTypeId, _data, rebuildViews);
+
+  if (rebuildViews)
+    this->RebuildViews();
+  else
+    this->UpdateViews(_entity);
+
+  return componentKey;
+}
+
+/////////////////////////////////////////////////
+ComponentKey EntityComponentManager::CreateComponentImplementation(
+    const Entity _entity, const ComponentTypeId _componentTypeId,
+    const components::BaseComponent *_data, bool &_rebuildViews)
 {
   // If type hasn't been instantiated yet, create a storage for it
   if (!this->HasComponentType(_componentTypeId))
@@ -464,17 +1504,44 @@ ComponentKey EntityComponentManager::CreateComponentImplementation(
 
   // Instantiate the new component.
   std::pair<ComponentId, bool> componentIdPair =
-    this->dataPtr->components[_componentTypeId]->Create(_data);
+    this->dataPtr->WritableStorage(_componentTypeId)->Create(_entity, _data);
 
   ComponentKey componentKey{_componentTypeId, componentIdPair.first};
 
   this->dataPtr->entityComponents[_entity].push_back(componentKey);
+  this->dataPtr->SetEntityComponentId(_entity, _componentTypeId,
+      componentIdPair.first);
+
+  auto bitIter = this->dataPtr->viewTypeBits.find(_componentTypeId);
+  if (bitIter != this->dataPtr->viewTypeBits.end())
+    this->dataPtr->SetEntityMaskBit(_entity, bitIter->second, true);
   this->dataPtr->oneTimeChangedComponents.insert(componentKey);
+  this->dataPtr->MarkChanged(_entity, _componentTypeId);
+
+  // Keep the name index up to date so lookups by name stay a hash probe.
+  if (components::Name::typeId == _componentTypeId)
+  {
+    this->dataPtr->nameIndex.insert(
+        {static_cast<const components::Name *>(_data)->Data(), _entity});
+  }
+
+  // A new name or parent component can make cached scoped name chains
+  // stale, for this entity and for everything below it.
+  if (components::Name::typeId == _componentTypeId ||
+      components::ParentEntity::typeId == _componentTypeId)
+  {
+    this->dataPtr->scopedNameCache.clear();
+  }
 
   if (componentIdPair.second)
-    this->RebuildViews();
-  else
-    this->UpdateViews(_entity);
+    _rebuildViews = true;
+
+  this->dataPtr->componentsCreatedCount.fetch_add(1,
+      std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->componentChurnMutex);
+    ++this->dataPtr->componentChurn[_componentTypeId].first;
+  }
 
   return componentKey;
 }
@@ -487,23 +1554,9 @@ bool EntityComponentManager::EntityMatches(Entity _entity,
   if (iter == this->dataPtr->entityComponents.end())
     return false;
 
-  // \todo(nkoenig) The performance of this could be improved. Ideally we
-  // wouldn't need two loops to confirm that an entity matches a set of
-  // types. It might be possible to create bitmask for component sets.
-  // Fixing this might not be high priority, unless we expect frequent
-  // creation of entities and/or queries.
   for (const ComponentTypeId &type : _types)
   {
-    bool found = false;
-    for (const ComponentKey &comp : iter->second)
-    {
-      if (comp.first == type)
-      {
-        found = true;
-        break;
-      }
-    }
-    if (!found)
+    if (kComponentIdInvalid == this->dataPtr->EntityComponentId(_entity, type))
       return false;
   }
 
@@ -511,25 +1564,91 @@ bool EntityComponentManager::EntityMatches(Entity _entity,
 }
 
 /////////////////////////////////////////////////
-ComponentId EntityComponentManager::EntityComponentIdFromType(
-    const Entity _entity, const ComponentTypeId _type) const
+std::vector<Entity> EntityComponentManager::EntitiesByName(
+    const std::string &_name) const
+{
+  std::vector<Entity> result;
+  auto range = this->dataPtr->nameIndex.equal_range(_name);
+  for (auto iter = range.first; iter != range.second; ++iter)
+    result.push_back(iter->second);
+  return result;
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::pair<std::string, std::string>>
+    &EntityComponentManager::ScopedNameChain(const Entity _entity) const
 {
-  auto ecIter = this->dataPtr->entityComponents.find(_entity);
+  // Check cache
+  auto cacheIter = this->dataPtr->scopedNameCache.find(_entity);
+  if (cacheIter != this->dataPtr->scopedNameCache.end())
+    return cacheIter->second;
 
-  if (ecIter == this->dataPtr->entityComponents.end())
-    return -1;
+  std::vector<std::pair<std::string, std::string>> chain;
 
-  auto iter =
-    std::find_if(ecIter->second.begin(), ecIter->second.end(),
-      [&] (const ComponentKey &_key)
+  auto nameComp = this->Component<components::Name>(_entity);
+  if (nullptr != nameComp)
   {
-    return _key.first == _type;
-  });
+    // Reuse the parent's chain, so each entity's prefix of the tree is
+    // resolved at most once no matter how many descendants query it.
+    auto parentComp = this->Component<components::ParentEntity>(_entity);
+    if (nullptr != parentComp)
+      chain = this->ScopedNameChain(parentComp->Data());
+
+    // Get entity type
+    std::string prefix;
+    if (this->Component<components::World>(_entity))
+    {
+      prefix = "world";
+    }
+    else if (this->Component<components::Model>(_entity))
+    {
+      prefix = "model";
+    }
+    else if (this->Component<components::Light>(_entity))
+    {
+      prefix = "light";
+    }
+    else if (this->Component<components::Link>(_entity))
+    {
+      prefix = "link";
+    }
+    else if (this->Component<components::Collision>(_entity))
+    {
+      prefix = "collision";
+    }
+    else if (this->Component<components::Visual>(_entity))
+    {
+      prefix = "visual";
+    }
+    else if (this->Component<components::Joint>(_entity))
+    {
+      prefix = "joint";
+    }
+    else if (this->Component<components::Sensor>(_entity))
+    {
+      prefix = "sensor";
+    }
+    else
+    {
+      ignwarn << "Skipping entity [" << nameComp->Data()
+              << "] when generating scoped name, entity type not known."
+              << std::endl;
+    }
 
-  if (iter != ecIter->second.end())
-    return iter->second;
+    if (!prefix.empty())
+      chain.push_back({prefix, nameComp->Data()});
+  }
 
-  return -1;
+  auto inserted = this->dataPtr->scopedNameCache.insert(
+      {_entity, std::move(chain)});
+  return inserted.first->second;
+}
+
+/////////////////////////////////////////////////
+ComponentId EntityComponentManager::EntityComponentIdFromType(
+    const Entity _entity, const ComponentTypeId _type) const
+{
+  return this->dataPtr->EntityComponentId(_entity, _type);
 }
 
 /////////////////////////////////////////////////
@@ -538,43 +1657,24 @@ const components::BaseComponent
     const Entity _entity, const ComponentTypeId _type) const
 {
   IGN_PROFILE("EntityComponentManager::ComponentImplementation");
-  auto ecIter = this->dataPtr->entityComponents.find(_entity);
+  const auto id = this->dataPtr->EntityComponentId(_entity, _type);
 
-  if (ecIter == this->dataPtr->entityComponents.end())
+  if (kComponentIdInvalid == id)
     return nullptr;
 
-  auto iter = std::find_if(ecIter->second.begin(), ecIter->second.end(),
-      [&] (const ComponentKey &_key)
-  {
-    return _key.first == _type;
-  });
-
-  if (iter != ecIter->second.end())
-    return this->dataPtr->components.at(iter->first)->Component(iter->second);
-
-  return nullptr;
+  return this->dataPtr->components.at(_type)->Component(id);
 }
 
 /////////////////////////////////////////////////
 components::BaseComponent *EntityComponentManager::ComponentImplementation(
     const Entity _entity, const ComponentTypeId _type)
 {
-  auto ecIter = this->dataPtr->entityComponents.find(_entity);
+  const auto id = this->dataPtr->EntityComponentId(_entity, _type);
 
-  if (ecIter == this->dataPtr->entityComponents.end())
+  if (kComponentIdInvalid == id)
     return nullptr;
 
-  auto iter =
-    std::find_if(ecIter->second.begin(), ecIter->second.end(),
-        [&] (const ComponentKey &_key)
-  {
-    return _key.first == _type;
-  });
-
-  if (iter != ecIter->second.end())
-    return this->dataPtr->components.at(iter->first)->Component(iter->second);
-
-  return nullptr;
+  return this->dataPtr->WritableStorage(_type)->Component(id);
 }
 
 /////////////////////////////////////////////////
@@ -594,12 +1694,94 @@ const components::BaseComponent
 components::BaseComponent *EntityComponentManager::ComponentImplementation(
     const ComponentKey &_key)
 {
-  if (this->dataPtr->components.find(_key.first) !=
-      this->dataPtr->components.end())
+  auto *storage = this->dataPtr->WritableStorage(_key.first);
+  if (nullptr != storage)
+    return storage->Component(_key.second);
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::RunParallel(
+    const std::vector<std::function<void()>> &_tasks) const
+{
+  // One change shard per task: each wrapper points its worker thread at
+  // the task's own shard, so SetChangedParallel calls from the callback
+  // append to thread-affine storage instead of contending on the shared
+  // change trackers. The vector is sized up front; the shards don't
+  // move while workers hold pointers into it.
+  auto &shards = this->dataPtr->changeShards;
+  shards.resize(_tasks.size());
+
+  for (std::size_t i = 0; i < _tasks.size(); ++i)
+  {
+    auto *shard = &shards[i];
+    const auto *task = &_tasks[i];
+    this->dataPtr->workerPool.AddWork([shard, task]()
+    {
+      gChangeShard = shard;
+      (*task)();
+      gChangeShard = nullptr;
+    });
+  }
+  this->dataPtr->workerPool.WaitForResults();
+
+  // Merge the buffered flags into the real trackers on this thread.
+  // Flagging changes is manager bookkeeping, not component data, so the
+  // merge is legitimate from the const overload too.
+  auto *self = const_cast<EntityComponentManager *>(this);
+  for (auto &shard : shards)
+  {
+    for (const auto &change : shard)
+      self->SetChanged(change.entity, change.type, change.state);
+    shard.clear();
+  }
+}
+
+/////////////////////////////////////////////////
+ComponentStorageBase *EntityComponentManager::Storage(
+    const ComponentTypeId _typeId) const
+{
+  auto iter = this->dataPtr->components.find(_typeId);
+  if (iter != this->dataPtr->components.end())
+    return iter->second.get();
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+ComponentStorageBase *EntityComponentManager::Storage(
+    const ComponentTypeId _typeId)
+{
+  return this->dataPtr->WritableStorage(_typeId);
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManager::HasSharedStorages() const
+{
+  return this->dataPtr->storagesShared;
+}
+
+/////////////////////////////////////////////////
+ComponentStorageBase *EntityComponentManagerPrivate::WritableStorage(
+    const ComponentTypeId _typeId)
+{
+  auto iter = this->components.find(_typeId);
+  if (iter == this->components.end())
+    return nullptr;
+
+  // Deep-copy a storage still shared with a cloned manager before
+  // handing out mutable access, so the managers diverge instead of
+  // writing through each other.
+  if (this->storagesShared && iter->second.use_count() > 1)
   {
-    return this->dataPtr->components.at(_key.first)->Component(_key.second);
+    iter->second = iter->second->Clone();
+
+    // The views cache raw storage pointers; drop the entries for this
+    // type so the next access resolves the detached storage.
+    std::lock_guard<std::mutex> lock(this->viewsMutex);
+    for (auto &view : this->views)
+      view.second.storages.erase(_typeId);
   }
-  return nullptr;
+  return iter->second.get();
 }
 
 /////////////////////////////////////////////////
@@ -634,11 +1816,9 @@ bool EntityComponentManagerPrivate::CreateComponentStorage(
 components::BaseComponent *EntityComponentManager::First(
     const ComponentTypeId _componentTypeId)
 {
-  auto iter = this->dataPtr->components.find(_componentTypeId);
-  if (iter != this->dataPtr->components.end())
-  {
-    return iter->second->First();
-  }
+  auto *storage = this->dataPtr->WritableStorage(_componentTypeId);
+  if (nullptr != storage)
+    return storage->First();
   return nullptr;
 }
 
@@ -665,6 +1845,36 @@ std::map<detail::ComponentTypeKey, detail::View>::iterator
   // If the view already exists, then the map will return the iterator to
   // the location that prevented the insertion.
   std::lock_guard<std::mutex> lockViews(this->dataPtr->viewsMutex);
+
+  // Build the view's membership mask, assigning a bit to each component
+  // type on its first appearance in a view. Newly assigned bits are
+  // backfilled into the masks of entities that already have the type.
+  for (const ComponentTypeId &typeId : _types)
+  {
+    auto bitIter = this->dataPtr->viewTypeBits.find(typeId);
+    if (bitIter == this->dataPtr->viewTypeBits.end())
+    {
+      bitIter = this->dataPtr->viewTypeBits.insert(
+          {typeId, this->dataPtr->viewTypeBits.size()}).first;
+
+      auto idxIter = this->dataPtr->componentIdIndex.find(typeId);
+      if (idxIter != this->dataPtr->componentIdIndex.end())
+      {
+        for (std::size_t entity = 0; entity < idxIter->second.size();
+            ++entity)
+        {
+          if (idxIter->second[entity] != kComponentIdInvalid)
+          {
+            this->dataPtr->SetEntityMaskBit(Entity(entity),
+                bitIter->second, true);
+          }
+        }
+      }
+    }
+    EntityComponentManagerPrivate::SetMaskBit(_view.mask,
+        bitIter->second, true);
+  }
+
   return this->dataPtr->views.insert(
       std::make_pair(_types, std::move(_view))).first;
 }
@@ -673,10 +1883,30 @@ std::map<detail::ComponentTypeKey, detail::View>::iterator
 void EntityComponentManager::UpdateViews(const Entity _entity)
 {
   IGN_PROFILE("EntityComponentManager::UpdateViews");
+  // Entities awaiting budgeted destruction were already removed from views.
+  if (this->IsTombstoned(_entity))
+    return;
+
+  // Resolve the entity's component mask once; each view's membership
+  // check is then a word-wise subset test against it.
+  static const std::vector<uint64_t> kEmptyMask;
+  const bool hasComponents =
+      this->dataPtr->entityComponents.find(_entity) !=
+      this->dataPtr->entityComponents.end();
+  auto maskIter = this->dataPtr->entityMasks.find(_entity);
+  const std::vector<uint64_t> &entityMask =
+      maskIter != this->dataPtr->entityMasks.end() ?
+      maskIter->second : kEmptyMask;
+
+  this->dataPtr->viewsUpdatedCount.fetch_add(this->dataPtr->views.size(),
+      std::memory_order_relaxed);
+
   for (auto &view : this->dataPtr->views)
   {
     // Add/update the entity if it matches the view.
-    if (this->EntityMatches(_entity, view.first))
+    if (hasComponents &&
+        EntityComponentManagerPrivate::MaskContains(view.second.mask,
+          entityMask))
     {
       view.second.AddEntity(_entity, this->IsNewEntity(_entity));
       // If there is a request to delete this entity, update the view as
@@ -685,6 +1915,10 @@ void EntityComponentManager::UpdateViews(const Entity _entity)
       {
         view.second.AddEntityToRemoved(_entity);
       }
+      if (this->EntityLevelBuffered(_entity))
+      {
+        view.second.bufferedEntities.insert(_entity);
+      }
       for (const ComponentTypeId &compTypeId : view.first)
       {
         view.second.AddComponent(_entity, compTypeId,
@@ -702,15 +1936,24 @@ void EntityComponentManager::UpdateViews(const Entity _entity)
 void EntityComponentManager::RebuildViews()
 {
   IGN_PROFILE("EntityComponentManager::RebuildViews");
+  this->dataPtr->viewsUpdatedCount.fetch_add(this->dataPtr->views.size(),
+      std::memory_order_relaxed);
   for (auto &view : this->dataPtr->views)
   {
     view.second.entities.clear();
+    view.second.toAddEntities.clear();
+    view.second.toEraseEntities.clear();
     view.second.components.clear();
+    view.second.bufferedEntities.clear();
     // Add all the entities that match the component types to the
     // view.
     for (const auto &vertex : this->dataPtr->entities.Vertices())
     {
       Entity entity = vertex.first;
+      // Entities awaiting budgeted destruction stay out of views.
+      if (this->IsTombstoned(entity))
+        continue;
+
       if (this->EntityMatches(entity, view.first))
       {
         view.second.AddEntity(entity, this->IsNewEntity(entity));
@@ -720,6 +1963,10 @@ void EntityComponentManager::RebuildViews()
         {
           view.second.AddEntityToRemoved(entity);
         }
+        if (this->EntityLevelBuffered(entity))
+        {
+          view.second.bufferedEntities.insert(entity);
+        }
         // Store pointers to all the components. This recursively adds
         // all the ComponentTypeTs that belong to the entity to the view.
         for (const ComponentTypeId &compTypeId : view.first)
@@ -730,6 +1977,7 @@ void EntityComponentManager::RebuildViews()
         }
       }
     }
+    view.second.ApplyPendingChanges();
   }
 }
 
@@ -762,10 +2010,15 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedState &_msg,
     auto compBase = this->ComponentImplementation(_entity, comp.first);
     compMsg->set_type(compBase->TypeId());
 
-    std::ostringstream ostr;
-    compBase->Serialize(ostr);
+    // Trivially copyable data is copied into the message byte field
+    // directly; everything else goes through the stream operators.
+    if (!compBase->SerializeRaw(*compMsg->mutable_component()))
+    {
+      std::ostringstream ostr;
+      compBase->Serialize(ostr);
 
-    compMsg->set_component(ostr.str());
+      compMsg->set_component(ostr.str());
+    }
 
     // TODO(anyone) Set component being removed once we have a way to queue it
   }
@@ -801,6 +2054,10 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedStateMap &_msg,
   // Empty means all types
   bool allTypes = _types.empty();
 
+  // Reuse one stream for all of the entity's components instead of
+  // constructing a fresh one per component.
+  std::ostringstream ostr;
+
   for (const ComponentKey &comp : this->dataPtr->entityComponents[_entity])
   {
     if (!allTypes && _types.find(comp.first) == _types.end())
@@ -847,10 +2104,15 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedStateMap &_msg,
       compIter = entIter->second.mutable_components()->find(comp.first);
     }
 
-    // Serialize and store the message
-    std::ostringstream ostr;
-    compBase->Serialize(ostr);
-    compIter->second.set_component(ostr.str());
+    // Serialize and store the message. Trivially copyable data is copied
+    // into the message byte field directly; everything else goes through
+    // the stream operators.
+    if (!compBase->SerializeRaw(*compIter->second.mutable_component()))
+    {
+      ostr.str(std::string());
+      compBase->Serialize(ostr);
+      compIter->second.set_component(ostr.str());
+    }
 
     // TODO(anyone) Set component being removed once we have a way to queue it
   }
@@ -869,6 +2131,7 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedStateMap &_msg,
 ignition::msgs::SerializedState EntityComponentManager::ChangedState() const
 {
   ignition::msgs::SerializedState stateMsg;
+  TagRawEncoding(stateMsg);
 
   // New entities
   for (const auto &entity : this->dataPtr->newlyCreatedEntities)
@@ -891,19 +2154,35 @@ ignition::msgs::SerializedState EntityComponentManager::ChangedState() const
 void EntityComponentManager::ChangedState(
     ignition::msgs::SerializedStateMap &_state) const
 {
+  TagRawEncoding(_state);
+
+  std::unordered_set<Entity> visited;
+
   // New entities
   for (const auto &entity : this->dataPtr->newlyCreatedEntities)
   {
+    visited.insert(entity);
     this->AddEntityToMessage(_state, entity);
   }
 
   // Entities being removed
   for (const auto &entity : this->dataPtr->toRemoveEntities)
   {
-    this->AddEntityToMessage(_state, entity);
+    if (visited.insert(entity).second)
+      this->AddEntityToMessage(_state, entity);
   }
 
-  // TODO(anyone) New / removed / changed components
+  // Entities with changed components. The dirty trackers enumerate these
+  // directly, and AddEntityToMessage only serializes the components that
+  // are actually marked as changed.
+  for (const auto &tracker : this->dataPtr->changedTrackers)
+  {
+    for (const Entity entity : tracker.second.entities)
+    {
+      if (tracker.second.bits[entity] && visited.insert(entity).second)
+        this->AddEntityToMessage(_state, entity);
+    }
+  }
 }
 
 
@@ -913,6 +2192,7 @@ ignition::msgs::SerializedState EntityComponentManager::State(
     const std::unordered_set<ComponentTypeId> &_types) const
 {
   ignition::msgs::SerializedState stateMsg;
+  TagRawEncoding(stateMsg);
   for (const auto &it : this->dataPtr->entityComponents)
   {
     auto entity = it.first;
@@ -934,6 +2214,37 @@ void EntityComponentManager::State(
     const std::unordered_set<ComponentTypeId> &_types,
     bool _full) const
 {
+  TagRawEncoding(_state);
+
+  // When only changed components of specific types are requested, visit
+  // just the entities flagged by the dirty trackers instead of scanning
+  // every entity and testing each of its components. This keeps periodic
+  // publishing, such as the pose updates SceneBroadcaster sends every
+  // cycle, proportional to the amount of change instead of to the world
+  // size. The message content is the same either way: the scan below
+  // also skips unchanged components and drops empty entities.
+  if (!_full && _entities.empty() && !_types.empty())
+  {
+    std::unordered_set<Entity> visited;
+    for (const ComponentTypeId type : _types)
+    {
+      for (const Entity entity : this->ChangedEntities(type))
+      {
+        if (visited.insert(entity).second)
+          this->AddEntityToMessage(_state, entity, _types, _full);
+      }
+    }
+
+    // Entities scheduled for removal are reported even if none of their
+    // components changed.
+    for (const Entity entity : this->dataPtr->toRemoveEntities)
+    {
+      if (visited.insert(entity).second)
+        this->AddEntityToMessage(_state, entity, _types, _full);
+    }
+    return;
+  }
+
   for (const auto &it : this->dataPtr->entityComponents)
   {
     if (_entities.empty() || _entities.find(it.first) != _entities.end())
@@ -946,6 +2257,11 @@ void EntityComponentManager::SetState(
     const ignition::msgs::SerializedState &_stateMsg)
 {
   IGN_PROFILE("EntityComponentManager::SetState Non-map");
+  this->dataPtr->worldPosesValid.store(false, std::memory_order_release);
+  // Only messages tagged by TagRawEncoding carry raw byte copies; a
+  // legacy text payload can coincidentally match a data type's size, so
+  // untagged payloads always go through the stream operators.
+  const bool rawEncoded = HasRawEncoding(_stateMsg);
   // Create / remove / update entities
   for (int e = 0; e < _stateMsg.entities_size(); ++e)
   {
@@ -1005,8 +2321,12 @@ void EntityComponentManager::SetState(
         continue;
       }
 
-      std::istringstream istr(compMsg.component());
-      newComp->Deserialize(istr);
+      if (!rawEncoded || !newComp->DeserializeRaw(compMsg.component().data(),
+          compMsg.component().size()))
+      {
+        std::istringstream istr(compMsg.component());
+        newComp->Deserialize(istr);
+      }
 
       // Get type id
       auto typeId = newComp->TypeId();
@@ -1048,6 +2368,11 @@ void EntityComponentManager::SetState(
     const ignition::msgs::SerializedStateMap &_stateMsg)
 {
   IGN_PROFILE("EntityComponentManager::SetState Map");
+  this->dataPtr->worldPosesValid.store(false, std::memory_order_release);
+  // Only messages tagged by TagRawEncoding carry raw byte copies; a
+  // legacy text payload can coincidentally match a data type's size, so
+  // untagged payloads always go through the stream operators.
+  const bool rawEncoded = HasRawEncoding(_stateMsg);
   // Create / remove / update entities
   for (const auto &iter : _stateMsg.entities())
   {
@@ -1121,8 +2446,13 @@ void EntityComponentManager::SetState(
           continue;
         }
 
-        std::istringstream istr(compMsg.component());
-        newComp->Deserialize(istr);
+        if (!rawEncoded ||
+            !newComp->DeserializeRaw(compMsg.component().data(),
+            compMsg.component().size()))
+        {
+          std::istringstream istr(compMsg.component());
+          newComp->Deserialize(istr);
+        }
 
         this->CreateComponentImplementation(entity,
             newComp->TypeId(), newComp.get());
@@ -1130,8 +2460,24 @@ void EntityComponentManager::SetState(
       // Update component value
       else
       {
-        std::istringstream istr(compMsg.component());
-        comp->Deserialize(istr);
+        // Deserializing over an existing name component can rename the
+        // entity, so re-index it under the new value.
+        if (components::Name::typeId == compIter.first)
+        {
+          auto nameComp = static_cast<components::Name *>(comp);
+          this->dataPtr->RemoveFromNameIndex(entity, nameComp->Data());
+          std::istringstream istr(compMsg.component());
+          comp->Deserialize(istr);
+          this->dataPtr->nameIndex.insert({nameComp->Data(), entity});
+          this->dataPtr->scopedNameCache.clear();
+        }
+        else if (!rawEncoded ||
+            !comp->DeserializeRaw(compMsg.component().data(),
+            compMsg.component().size()))
+        {
+          std::istringstream istr(compMsg.component());
+          comp->Deserialize(istr);
+        }
         this->SetChanged(entity, compIter.first,
             ComponentState::OneTimeChange);
       }
@@ -1140,27 +2486,146 @@ void EntityComponentManager::SetState(
 }
 
 //////////////////////////////////////////////////
-std::unordered_set<Entity> EntityComponentManager::Descendants(Entity _entity)
-    const
+std::string EntityComponentManager::SnapshotState() const
 {
-  // Check cache
-  if (this->dataPtr->descendantCache.find(_entity) !=
-      this->dataPtr->descendantCache.end())
+  IGN_PROFILE("EntityComponentManager::SnapshotState");
+
+  // Only the components physics rewrites every step. Everything else is
+  // structure that an episode reset leaves alone.
+  return this->State({},
+      {components::Pose::typeId,
+       components::LinearVelocity::typeId,
+       components::AngularVelocity::typeId,
+       components::JointPosition::typeId,
+       components::JointVelocity::typeId}).SerializeAsString();
+}
+
+//////////////////////////////////////////////////
+bool EntityComponentManager::RestoreState(const std::string &_blob)
+{
+  IGN_PROFILE("EntityComponentManager::RestoreState");
+
+  msgs::SerializedState stateMsg;
+  if (!stateMsg.ParseFromString(_blob))
+  {
+    ignerr << "Failed to parse state snapshot, not restoring." << std::endl;
+    return false;
+  }
+
+  this->SetState(stateMsg);
+
+  // Write the restored poses and joint states through to physics, which
+  // applies them to its existing engine objects on the next step.
+  for (int e = 0; e < stateMsg.entities_size(); ++e)
   {
-    return this->dataPtr->descendantCache[_entity];
+    const auto &entityMsg = stateMsg.entities(e);
+
+    Entity entity{entityMsg.id()};
+    if (!this->HasEntity(entity))
+      continue;
+
+    for (int c = 0; c < entityMsg.components_size(); ++c)
+    {
+      auto type = entityMsg.components(c).type();
+
+      if (components::Pose::typeId == type)
+      {
+        // Only top-level models go through the pose command; their links
+        // follow from the model pose and the joint state.
+        if (nullptr == this->Component<components::Model>(entity))
+          continue;
+
+        auto parentComp = this->Component<components::ParentEntity>(entity);
+        if (nullptr == parentComp || nullptr ==
+            this->Component<components::World>(parentComp->Data()))
+        {
+          continue;
+        }
+
+        auto poseComp = this->Component<components::Pose>(entity);
+        if (nullptr == poseComp)
+          continue;
+
+        auto poseCmdComp = this->Component<components::WorldPoseCmd>(entity);
+        if (nullptr == poseCmdComp)
+        {
+          this->CreateComponent(entity,
+              components::WorldPoseCmd(poseComp->Data()));
+        }
+        else
+        {
+          poseCmdComp->Data() = poseComp->Data();
+          this->SetChanged(entity, components::WorldPoseCmd::typeId,
+              ComponentState::OneTimeChange);
+        }
+      }
+      else if (components::JointPosition::typeId == type)
+      {
+        auto jointPosComp = this->Component<components::JointPosition>(entity);
+        if (nullptr == jointPosComp)
+          continue;
+
+        auto resetComp =
+            this->Component<components::JointPositionReset>(entity);
+        if (nullptr == resetComp)
+        {
+          this->CreateComponent(entity,
+              components::JointPositionReset(jointPosComp->Data()));
+        }
+        else
+        {
+          resetComp->Data() = jointPosComp->Data();
+          this->SetChanged(entity, components::JointPositionReset::typeId,
+              ComponentState::OneTimeChange);
+        }
+      }
+      else if (components::JointVelocity::typeId == type)
+      {
+        auto jointVelComp = this->Component<components::JointVelocity>(entity);
+        if (nullptr == jointVelComp)
+          continue;
+
+        auto resetComp =
+            this->Component<components::JointVelocityReset>(entity);
+        if (nullptr == resetComp)
+        {
+          this->CreateComponent(entity,
+              components::JointVelocityReset(jointVelComp->Data()));
+        }
+        else
+        {
+          resetComp->Data() = jointVelComp->Data();
+          this->SetChanged(entity, components::JointVelocityReset::typeId,
+              ComponentState::OneTimeChange);
+        }
+      }
+    }
   }
 
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::unordered_set<Entity> EntityComponentManager::Descendants(Entity _entity)
+    const
+{
   std::unordered_set<Entity> descendants;
 
   if (!this->HasEntity(_entity))
     return descendants;
 
-  auto descVector = math::graph::BreadthFirstSort(this->dataPtr->entities,
-      _entity);
-  std::move(descVector.begin(), descVector.end(), std::inserter(descendants,
-      descendants.end()));
+  if (this->dataPtr->tourDirty)
+    this->dataPtr->RebuildEntityTour();
+
+  auto intervalIter = this->dataPtr->entityTourIntervals.find(_entity);
+  if (intervalIter == this->dataPtr->entityTourIntervals.end())
+    return descendants;
+
+  // The subtree is a contiguous range of the Euler tour
+  descendants.insert(
+      this->dataPtr->entityTour.begin() + intervalIter->second.first,
+      this->dataPtr->entityTour.begin() + intervalIter->second.second);
 
-  this->dataPtr->descendantCache[_entity] = descendants;
   return descendants;
 }
 
@@ -1169,6 +2634,232 @@ void EntityComponentManager::SetAllComponentsUnchanged()
 {
   this->dataPtr->periodicChangedComponents.clear();
   this->dataPtr->oneTimeChangedComponents.clear();
+
+  // The step's pose writes are final at this point, so the next
+  // WorldPose query sweeps fresh values.
+  this->dataPtr->worldPosesValid.store(false, std::memory_order_release);
+
+  // Reset the per-type dirty trackers. Only raised bits are lowered, so
+  // the cost is proportional to the amount of change.
+  for (auto &tracker : this->dataPtr->changedTrackers)
+  {
+    for (const Entity entity : tracker.second.entities)
+      tracker.second.bits[entity] = false;
+    tracker.second.entities.clear();
+  }
+}
+
+/////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManager::ChangedEntities(
+    const ComponentTypeId _typeId) const
+{
+  std::vector<Entity> result;
+
+  auto trackerIter = this->dataPtr->changedTrackers.find(_typeId);
+  if (trackerIter == this->dataPtr->changedTrackers.end())
+    return result;
+
+  const auto &tracker = trackerIter->second;
+  result.reserve(tracker.entities.size());
+  for (const Entity entity : tracker.entities)
+  {
+    // Skip entities whose bit was lowered again, e.g. because the
+    // component was removed or marked as unchanged.
+    if (tracker.bits[entity])
+      result.push_back(entity);
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::TrackPoseHistory(const Entity _entity,
+    const std::size_t _depth) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->poseHistoryMutex);
+
+  const std::size_t depth = std::max<std::size_t>(2, _depth);
+  auto iter = this->dataPtr->poseHistories.find(_entity);
+  if (iter == this->dataPtr->poseHistories.end())
+  {
+    auto &history = this->dataPtr->poseHistories[_entity];
+    history.depth = depth;
+    history.samples.reserve(depth);
+  }
+  else if (iter->second.depth != depth)
+  {
+    // A new depth restarts the ring; keeping a mixed-depth ring isn't
+    // worth the bookkeeping for a one-time event.
+    iter->second.depth = depth;
+    iter->second.samples.clear();
+    iter->second.head = 0;
+  }
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::UntrackPoseHistory(const Entity _entity) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->poseHistoryMutex);
+  this->dataPtr->poseHistories.erase(_entity);
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::RecordPoseHistories(
+    const std::chrono::steady_clock::duration &_time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->poseHistoryMutex);
+
+  for (auto iter = this->dataPtr->poseHistories.begin();
+       iter != this->dataPtr->poseHistories.end();)
+  {
+    auto poseComp = this->Component<components::Pose>(iter->first);
+    if (nullptr == poseComp)
+    {
+      // The entity or its pose is gone, so the history is dead weight.
+      iter = this->dataPtr->poseHistories.erase(iter);
+      continue;
+    }
+
+    // Compose the world pose by climbing the parent chain. The batched
+    // WorldPose cache isn't used here: histories track a handful of
+    // entities, so a few short climbs beat sweeping the whole forest,
+    // and recording runs right after systems may have written poses.
+    math::Pose3d pose = poseComp->Data();
+    auto parentComp = this->Component<components::ParentEntity>(iter->first);
+    while (parentComp)
+    {
+      auto parentPoseComp =
+          this->Component<components::Pose>(parentComp->Data());
+      if (nullptr == parentPoseComp)
+        break;
+      pose = pose + parentPoseComp->Data();
+      parentComp =
+          this->Component<components::ParentEntity>(parentComp->Data());
+    }
+
+    auto &history = iter->second;
+    if (history.samples.size() < history.depth)
+    {
+      history.samples.push_back({_time, pose});
+    }
+    else
+    {
+      history.samples[history.head] = {_time, pose};
+      history.head = (history.head + 1) % history.depth;
+    }
+    ++iter;
+  }
+}
+
+/////////////////////////////////////////////////
+std::optional<math::Pose3d> EntityComponentManager::PoseAt(
+    const Entity _entity,
+    const std::chrono::steady_clock::duration &_time) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->poseHistoryMutex);
+
+  auto iter = this->dataPtr->poseHistories.find(_entity);
+  if (iter == this->dataPtr->poseHistories.end() ||
+      iter->second.samples.empty())
+  {
+    return std::nullopt;
+  }
+
+  const auto &history = iter->second;
+  const std::size_t count = history.samples.size();
+
+  // Index into the ring in chronological order. Until the ring is
+  // full, head is still zero and this is the identity.
+  auto sampleAt = [&history, count](const std::size_t _i)
+      -> const EntityComponentManagerPrivate::PoseSample &
+  {
+    return history.samples[(history.head + _i) % count];
+  };
+
+  // Clamp outside the recorded range.
+  if (_time <= sampleAt(0).time)
+    return sampleAt(0).pose;
+  if (_time >= sampleAt(count - 1).time)
+    return sampleAt(count - 1).pose;
+
+  // Find the bracketing samples and interpolate between them.
+  for (std::size_t i = 0; i + 1 < count; ++i)
+  {
+    const auto &prev = sampleAt(i);
+    const auto &next = sampleAt(i + 1);
+    if (_time > next.time)
+      continue;
+
+    const auto span = next.time - prev.time;
+    const double t = span.count() > 0 ?
+        static_cast<double>((_time - prev.time).count()) /
+        static_cast<double>(span.count()) : 1.0;
+
+    math::Pose3d result;
+    result.Pos() = prev.pose.Pos() +
+        (next.pose.Pos() - prev.pose.Pos()) * t;
+    result.Rot() = math::Quaterniond::Slerp(
+        t, prev.pose.Rot(), next.pose.Rot(), true);
+    return result;
+  }
+
+  return sampleAt(count - 1).pose;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::ComputeWorldPoses() const
+{
+  IGN_PROFILE("EntityComponentManager::ComputeWorldPoses");
+
+  this->dataPtr->worldPoses.clear();
+
+  // One pass over the entity forest in parent-before-child order, so
+  // every world pose composes its parent's finished world pose with one
+  // local pose. Entities without a pose component, such as the world
+  // itself, pass their parent's pose through unchanged.
+  std::vector<std::pair<Entity, math::Pose3d>> stack;
+  for (const auto &vertex : this->dataPtr->entities.Vertices())
+  {
+    if (this->dataPtr->entities.AdjacentsTo(vertex.first).empty())
+      stack.emplace_back(vertex.first, math::Pose3d());
+  }
+
+  while (!stack.empty())
+  {
+    const auto [entity, parentPose] = stack.back();
+    stack.pop_back();
+
+    math::Pose3d pose = parentPose;
+    auto poseComp = this->Component<components::Pose>(entity);
+    if (nullptr != poseComp)
+    {
+      pose = poseComp->Data() + parentPose;
+      this->dataPtr->worldPoses[entity] = pose;
+    }
+
+    for (const auto &vertex : this->dataPtr->entities.AdjacentsFrom(entity))
+      stack.emplace_back(vertex.first, pose);
+  }
+}
+
+/////////////////////////////////////////////////
+std::optional<math::Pose3d> EntityComponentManager::WorldPose(
+    const Entity _entity) const
+{
+  if (!this->dataPtr->worldPosesValid.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->worldPoseMutex);
+    if (!this->dataPtr->worldPosesValid.load(std::memory_order_relaxed))
+    {
+      this->ComputeWorldPoses();
+      this->dataPtr->worldPosesValid.store(true, std::memory_order_release);
+    }
+  }
+
+  auto iter = this->dataPtr->worldPoses.find(_entity);
+  if (iter == this->dataPtr->worldPoses.end())
+    return std::nullopt;
+  return iter->second;
 }
 
 /////////////////////////////////////////////////
@@ -1176,34 +2867,95 @@ void EntityComponentManager::SetChanged(
     const Entity _entity, const ComponentTypeId _type,
     gazebo::ComponentState _c)
 {
-  auto ecIter = this->dataPtr->entityComponents.find(_entity);
+  const auto id = this->dataPtr->EntityComponentId(_entity, _type);
 
-  if (ecIter == this->dataPtr->entityComponents.end())
+  if (kComponentIdInvalid == id)
     return;
 
-  auto iter = std::find_if(ecIter->second.begin(), ecIter->second.end(),
-        [&] (const ComponentKey &_key)
-  {
-    return _key.first == _type;
-  });
-
-  if (iter == ecIter->second.end())
-    return;
+  const ComponentKey key{_type, id};
 
   if (_c == ComponentState::PeriodicChange)
   {
-    this->dataPtr->periodicChangedComponents.insert(*iter);
-    this->dataPtr->oneTimeChangedComponents.erase(*iter);
+    this->dataPtr->periodicChangedComponents.insert(key);
+    this->dataPtr->oneTimeChangedComponents.erase(key);
+    this->dataPtr->MarkChanged(_entity, _type);
   }
   else if (_c == ComponentState::OneTimeChange)
   {
-    this->dataPtr->periodicChangedComponents.erase(*iter);
-    this->dataPtr->oneTimeChangedComponents.insert(*iter);
+    this->dataPtr->periodicChangedComponents.erase(key);
+    this->dataPtr->oneTimeChangedComponents.insert(key);
+    this->dataPtr->MarkChanged(_entity, _type);
   }
   else
   {
-    this->dataPtr->periodicChangedComponents.erase(*iter);
-    this->dataPtr->oneTimeChangedComponents.erase(*iter);
+    this->dataPtr->periodicChangedComponents.erase(key);
+    this->dataPtr->oneTimeChangedComponents.erase(key);
+    this->dataPtr->UnmarkChanged(_entity, _type);
+  }
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::SetChangedParallel(
+    const Entity _entity, const ComponentTypeId _type,
+    gazebo::ComponentState _c)
+{
+  // Outside a parallel pass there is no shard to buffer into, and no
+  // concurrency to protect against either.
+  if (nullptr == gChangeShard)
+  {
+    this->SetChanged(_entity, _type, _c);
+    return;
+  }
+  gChangeShard->push_back({_entity, _type, _c});
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::SetChanged(
+    const std::vector<Entity> &_entities, const ComponentTypeId _type,
+    gazebo::ComponentState _c)
+{
+  // Resolve the component ids once and sort them, so the keys go into
+  // the ordered change sets in increasing order and the hinted inserts
+  // below are amortized constant time.
+  std::vector<std::pair<ComponentId, Entity>> ids;
+  ids.reserve(_entities.size());
+  for (const Entity entity : _entities)
+  {
+    const auto id = this->dataPtr->EntityComponentId(entity, _type);
+    if (kComponentIdInvalid == id)
+      continue;
+    ids.push_back({id, entity});
+  }
+  std::sort(ids.begin(), ids.end());
+
+  if (_c == ComponentState::NoChange)
+  {
+    for (const auto &[id, entity] : ids)
+    {
+      const ComponentKey key{_type, id};
+      this->dataPtr->periodicChangedComponents.erase(key);
+      this->dataPtr->oneTimeChangedComponents.erase(key);
+      this->dataPtr->UnmarkChanged(entity, _type);
+    }
+    return;
+  }
+
+  auto &markSet = _c == ComponentState::PeriodicChange ?
+      this->dataPtr->periodicChangedComponents :
+      this->dataPtr->oneTimeChangedComponents;
+  auto &clearSet = _c == ComponentState::PeriodicChange ?
+      this->dataPtr->oneTimeChangedComponents :
+      this->dataPtr->periodicChangedComponents;
+
+  auto hint = markSet.begin();
+  for (const auto &[id, entity] : ids)
+  {
+    const ComponentKey key{_type, id};
+    // The keys arrive in increasing order, so the position following the
+    // previous insertion is the right hint for the next one.
+    hint = std::next(markSet.insert(hint, key));
+    clearSet.erase(key);
+    this->dataPtr->MarkChanged(entity, _type);
   }
 }
 
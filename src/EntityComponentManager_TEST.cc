@@ -17,13 +17,27 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstring>
+#include <set>
+
 #include <ignition/common/Console.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Rand.hh>
 
 #include "ignition/gazebo/components/Factory.hh"
+#include "ignition/gazebo/components/JointPosition.hh"
+#include "ignition/gazebo/components/JointPositionReset.hh"
+#include "ignition/gazebo/components/JointVelocity.hh"
+#include "ignition/gazebo/components/JointVelocityReset.hh"
+#include "ignition/gazebo/components/Model.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/components/PoseCmd.hh"
+#include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/Util.hh"
 #include "ignition/gazebo/config.hh"
 
 using namespace ignition;
@@ -68,6 +82,17 @@ IGN_GAZEBO_REGISTER_COMPONENT("ign_gazebo_components.Odd", Odd)
 }
 }
 
+/// \brief Decode a component byte field produced by the raw copy fast
+/// path back into its data type.
+template <typename DataType>
+DataType rawData(const std::string &_bytes)
+{
+  DataType data{};
+  EXPECT_EQ(sizeof(DataType), _bytes.size());
+  memcpy(&data, _bytes.data(), sizeof(DataType));
+  return data;
+}
+
 class EntityCompMgrTest : public EntityComponentManager
 {
   public: void RunClearNewlyCreatedEntities()
@@ -339,19 +364,20 @@ TEST_P(EntityComponentManagerFixture, RemoveAdjacent)
   // Can't remove the component twice.
   EXPECT_FALSE(manager.RemoveComponent(entity, keys[1]));
 
-  // Check that the two remaining components are still adjacent in memory
+  // Removal tombstones the slot, so the remaining components keep their
+  // original positions; the dead slot between them is reclaimed when the
+  // storage compacts.
   const components::Pose *pose1 =
     manager.Component<components::Pose>(keys[0]);
   const components::Pose *pose3 =
     manager.Component<components::Pose>(keys[2]);
-  EXPECT_EQ(poseSize,
+  EXPECT_EQ(2 * poseSize,
       reinterpret_cast<uintptr_t>(pose3) - reinterpret_cast<uintptr_t>(pose1));
 }
 
 /////////////////////////////////////////////////
-// Removing a component should guarantee that existing components remain
-// adjacent to each other, and addition of a new component is adjacent to
-// the last element.
+// Removing a component tombstones its slot without moving the others, and
+// new components are appended adjacent to the last element.
 TEST_P(EntityComponentManagerFixture, RemoveAddAdjacent)
 {
   Entity entity = manager.CreateEntity();
@@ -377,7 +403,8 @@ TEST_P(EntityComponentManagerFixture, RemoveAddAdjacent)
   keys.push_back(manager.CreateComponent(entity,
         components::Pose(math::Pose3d(1010, 81, 821, 0, 0, 0))));
 
-  // Check that the components are all adjacent in memory
+  // Check the component layout: the removed component's slot stays dead
+  // until compaction, and the new components were appended after it.
   const components::Pose *pose1 =
     manager.Component<components::Pose>(keys[0]);
   const components::Pose *pose2 =
@@ -387,7 +414,7 @@ TEST_P(EntityComponentManagerFixture, RemoveAddAdjacent)
   const components::Pose *pose4 =
     manager.Component<components::Pose>(keys[4]);
 
-  EXPECT_EQ(poseSize,
+  EXPECT_EQ(2 * poseSize,
       reinterpret_cast<uintptr_t>(pose2) - reinterpret_cast<uintptr_t>(pose1));
 
   EXPECT_EQ(poseSize,
@@ -403,6 +430,57 @@ TEST_P(EntityComponentManagerFixture, RemoveAddAdjacent)
   EXPECT_EQ(components::Pose(math::Pose3d(1010, 81, 821, 0, 0, 0)), *pose4);
 }
 
+/////////////////////////////////////////////////
+// Enough removals to cross the storage's compaction threshold; survivors
+// must keep their values and their ids must stay valid across compaction.
+TEST_P(EntityComponentManagerFixture, RemoveComponentChurn)
+{
+  const int count = 300;
+  std::vector<Entity> entities;
+  std::vector<ComponentKey> keys;
+  for (int i = 0; i < count; ++i)
+  {
+    Entity e = manager.CreateEntity();
+    entities.push_back(e);
+    keys.push_back(manager.CreateComponent(e, IntComponent(i)));
+  }
+
+  // Remove all but every third component.
+  for (int i = 0; i < count; ++i)
+  {
+    if (i % 3 == 0)
+      continue;
+    EXPECT_TRUE(manager.RemoveComponent(entities[i], keys[i]));
+  }
+
+  int live = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    auto *comp = manager.Component<IntComponent>(keys[i]);
+    if (i % 3 == 0)
+    {
+      ASSERT_NE(nullptr, comp);
+      EXPECT_EQ(i, comp->Data());
+      ++live;
+    }
+    else
+    {
+      EXPECT_EQ(nullptr, comp);
+    }
+  }
+  EXPECT_EQ(100, live);
+
+  // The bulk sweep must not report dead slots.
+  int swept = 0;
+  manager.EachComponent<IntComponent>(
+      [&](const Entity &, const IntComponent &) -> bool
+      {
+        ++swept;
+        return true;
+      });
+  EXPECT_EQ(100, swept);
+}
+
 /////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture, EntitiesAndComponents)
 {
@@ -870,9 +948,12 @@ TEST_P(EntityComponentManagerFixture, RemoveEntity)
   EXPECT_EQ(2u, manager.EntityCount());
   EXPECT_FALSE(manager.HasEntity(e2));
 
-  // Creating an new entity shouldn't reuse the previously deleted entity.
+  // Creating a new entity reuses the previously deleted entity's slot,
+  // and bumps the slot's generation so stale ids can be detected.
+  EXPECT_EQ(0u, manager.EntityGeneration(e2));
   auto e4 = manager.CreateEntity();
-  EXPECT_EQ(4u, e4);
+  EXPECT_EQ(2u, e4);
+  EXPECT_EQ(1u, manager.EntityGeneration(e4));
   EXPECT_EQ(3u, manager.EntityCount());
 
   // Can not delete an invalid entity, but it shows up as marked for removal.
@@ -897,13 +978,154 @@ TEST_P(EntityComponentManagerFixture, RemoveEntity)
   EXPECT_EQ(1u, manager.EntityCount());
 
   // Delete last
-  manager.RequestRemoveEntity(4);
+  manager.RequestRemoveEntity(e4);
   EXPECT_EQ(1u, manager.EntityCount());
   EXPECT_TRUE(manager.HasEntitiesMarkedForRemoval());
   manager.ProcessEntityRemovals();
   EXPECT_EQ(0u, manager.EntityCount());
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, RemovalBudget)
+{
+  EXPECT_EQ(0u, manager.RemovalBudget());
+  manager.SetRemovalBudget(2);
+  EXPECT_EQ(2u, manager.RemovalBudget());
+
+  // Create some entities
+  std::vector<Entity> entities;
+  for (int i = 0; i < 5; ++i)
+  {
+    Entity entity = manager.CreateEntity();
+    manager.CreateComponent<IntComponent>(entity, IntComponent(i));
+    entities.push_back(entity);
+  }
+  EXPECT_EQ(5u, manager.EntityCount());
+
+  // Populate a view before the removal request.
+  int count = 0;
+  manager.Each<IntComponent>([&](const Entity &, const IntComponent *)->bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(5, count);
+
+  // Remove all the entities. Only the budgeted number of entities are
+  // destroyed per call, but all of them disappear from views right away.
+  for (const Entity entity : entities)
+    manager.RequestRemoveEntity(entity);
+  manager.ProcessEntityRemovals();
+
+  EXPECT_EQ(3u, manager.EntityCount());
+  count = 0;
+  manager.Each<IntComponent>([&](const Entity &, const IntComponent *)->bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(0, count);
+
+  // The deferred entities still hold their components, but must also be
+  // skipped by uncached queries.
+  count = 0;
+  manager.EachNoCache<IntComponent>([&](const Entity &,
+      const IntComponent *)->bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(0, count);
+
+  // Subsequent calls drain the remaining entities.
+  manager.ProcessEntityRemovals();
+  EXPECT_EQ(1u, manager.EntityCount());
+  manager.ProcessEntityRemovals();
+  EXPECT_EQ(0u, manager.EntityCount());
+
+  // A budget of zero destroys everything in one call.
+  manager.SetRemovalBudget(0);
+  for (int i = 0; i < 5; ++i)
+  {
+    Entity entity = manager.CreateEntity();
+    manager.CreateComponent<IntComponent>(entity, IntComponent(i));
+    manager.RequestRemoveEntity(entity);
+  }
+  EXPECT_EQ(5u, manager.EntityCount());
+  manager.ProcessEntityRemovals();
+  EXPECT_EQ(0u, manager.EntityCount());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EachActiveSkipsBufferedEntities)
+{
+  // Create some entities
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  Entity e3 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  manager.CreateComponent<IntComponent>(e2, IntComponent(2));
+  manager.CreateComponent<IntComponent>(e3, IntComponent(3));
+
+  // Without any buffered entities, EachActive matches Each.
+  int count = 0;
+  manager.EachActive<IntComponent>([&](const Entity &,
+      const IntComponent *)->bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(3, count);
+
+  // Flag an entity as buffered. Each still sees it, EachActive doesn't.
+  EXPECT_FALSE(manager.EntityLevelBuffered(e2));
+  manager.SetEntityLevelBuffered(e2, true);
+  EXPECT_TRUE(manager.EntityLevelBuffered(e2));
+
+  count = 0;
+  manager.Each<IntComponent>([&](const Entity &, const IntComponent *)->bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(3, count);
+
+  count = 0;
+  manager.EachActive<IntComponent>([&](const Entity &_entity,
+      const IntComponent *)->bool
+      {
+        EXPECT_NE(e2, _entity);
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(2, count);
+
+  // A view created after the flag was set partitions it too.
+  manager.CreateComponent<DoubleComponent>(e1, DoubleComponent(0.1));
+  manager.CreateComponent<DoubleComponent>(e2, DoubleComponent(0.2));
+  count = 0;
+  manager.EachActive<IntComponent, DoubleComponent>([&](const Entity &_entity,
+      const IntComponent *, const DoubleComponent *)->bool
+      {
+        EXPECT_EQ(e1, _entity);
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(1, count);
+
+  // Clearing the flag restores the entity for EachActive.
+  manager.SetEntityLevelBuffered(e2, false);
+  EXPECT_FALSE(manager.EntityLevelBuffered(e2));
+  count = 0;
+  manager.EachActive<IntComponent>([&](const Entity &,
+      const IntComponent *)->bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(3, count);
+}
+
 //////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture, ViewsRemoveEntity)
 {
@@ -1051,6 +1273,30 @@ TEST_P(EntityComponentManagerFixture, EachNewBasic)
   EXPECT_FALSE(manager.HasNewEntities());
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, NewAndRemovedEntitySets)
+{
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  Entity e3 = manager.CreateEntity();
+
+  EXPECT_EQ(std::set<Entity>({e1, e2, e3}), manager.NewEntities());
+  manager.RunClearNewlyCreatedEntities();
+  EXPECT_TRUE(manager.NewEntities().empty());
+
+  // Only the entities marked since the last processing are reported.
+  manager.RequestRemoveEntity(e2);
+  EXPECT_EQ(std::set<Entity>({e2}), manager.EntitiesMarkedForRemoval());
+
+  // Requesting removal of all entities reports every current entity.
+  manager.RequestRemoveEntities();
+  EXPECT_EQ(std::set<Entity>({e1, e2, e3}),
+      manager.EntitiesMarkedForRemoval());
+
+  manager.ProcessEntityRemovals();
+  EXPECT_TRUE(manager.EntitiesMarkedForRemoval().empty());
+}
+
 //////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture, EachNewAfterRemoveComponent)
 {
@@ -1112,6 +1358,28 @@ TEST_P(EntityComponentManagerFixture, EachNewAddComponentToExistingEntity)
   EXPECT_EQ(1, newCount<IntComponent>(manager));
 }
 
+////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EachOverlappingViews)
+{
+  Entity e1 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(123));
+  manager.CreateComponent<DoubleComponent>(e1, DoubleComponent(0.123));
+
+  // A narrow view and a broader view requiring a superset of its types
+  EXPECT_EQ(1, (eachCount<IntComponent>(manager)));
+  EXPECT_EQ(1, (eachCount<IntComponent, DoubleComponent>(manager)));
+
+  // Removing a component drops the entity from the broader view only
+  EXPECT_TRUE(manager.RemoveComponent(e1, DoubleComponent::typeId));
+  EXPECT_EQ(1, (eachCount<IntComponent>(manager)));
+  EXPECT_EQ(0, (eachCount<IntComponent, DoubleComponent>(manager)));
+
+  // Adding the component back restores membership
+  manager.CreateComponent<DoubleComponent>(e1, DoubleComponent(0.456));
+  EXPECT_EQ(1, (eachCount<IntComponent>(manager)));
+  EXPECT_EQ(1, (eachCount<IntComponent, DoubleComponent>(manager)));
+}
+
 ////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture, EachRemoveBasic)
 {
@@ -1273,6 +1541,214 @@ TEST_P(EntityComponentManagerFixture, EachGetsNewOldRemove)
   EXPECT_EQ(0, removedCount<IntComponent>(manager));
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ForEachChanged)
+{
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(123));
+  manager.CreateComponent<IntComponent>(e2, IntComponent(456));
+
+  // Newly created components are marked as changed.
+  std::vector<Entity> changed;
+  manager.ForEachChanged<IntComponent>(
+      [&](const Entity &_entity, const IntComponent *_comp) -> bool
+      {
+        EXPECT_NE(nullptr, _comp);
+        changed.push_back(_entity);
+        return true;
+      });
+  EXPECT_EQ(2u, changed.size());
+
+  // After a step, nothing is changed.
+  manager.RunSetAllComponentsUnchanged();
+  EXPECT_TRUE(manager.ChangedEntities(IntComponent::typeId).empty());
+
+  // Marking one entity changed enumerates only that entity.
+  manager.SetChanged(e2, IntComponent::typeId,
+      ComponentState::PeriodicChange);
+  changed.clear();
+  manager.ForEachChanged<IntComponent>(
+      [&](const Entity &_entity, const IntComponent *_comp) -> bool
+      {
+        EXPECT_NE(nullptr, _comp);
+        changed.push_back(_entity);
+        return true;
+      });
+  ASSERT_EQ(1u, changed.size());
+  EXPECT_EQ(e2, changed[0]);
+
+  // Marking it unchanged lowers the bit again.
+  manager.SetChanged(e2, IntComponent::typeId, ComponentState::NoChange);
+  EXPECT_TRUE(manager.ChangedEntities(IntComponent::typeId).empty());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EachParallel)
+{
+  // Create entities with int and double components
+  const int count = 100;
+  for (int i = 0; i < count; ++i)
+  {
+    Entity entity = manager.CreateEntity();
+    manager.CreateComponent<IntComponent>(entity, IntComponent(i));
+    manager.CreateComponent<DoubleComponent>(entity, DoubleComponent(0.0));
+  }
+  EXPECT_EQ(static_cast<size_t>(count), manager.EntityCount());
+
+  // Every matching entity should be visited exactly once, regardless of
+  // how the ranges are partitioned across workers.
+  std::atomic<int> visited{0};
+  manager.EachParallel<IntComponent, DoubleComponent>(
+      [&](const Entity &/*_entity*/, IntComponent *_int,
+          DoubleComponent *_double)
+      {
+        ASSERT_NE(nullptr, _int);
+        ASSERT_NE(nullptr, _double);
+        // Writes to the visited entity's own components are safe.
+        _double->Data() = 2.0 * _int->Data();
+        ++visited;
+      });
+  EXPECT_EQ(count, visited);
+
+  // Check the writes landed, using the const overload.
+  visited = 0;
+  const auto &constManager = manager;
+  constManager.EachParallel<IntComponent, DoubleComponent>(
+      [&](const Entity &/*_entity*/, const IntComponent *_int,
+          const DoubleComponent *_double)
+      {
+        ASSERT_NE(nullptr, _int);
+        ASSERT_NE(nullptr, _double);
+        EXPECT_DOUBLE_EQ(2.0 * _int->Data(), _double->Data());
+        ++visited;
+      });
+  EXPECT_EQ(count, visited);
+
+  // An empty view should be a no-op.
+  manager.EachParallel<BoolComponent>(
+      [&](const Entity &/*_entity*/, BoolComponent */*_bool*/)
+      {
+        FAIL() << "Callback should not be invoked for an empty view";
+      });
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, SetChangedParallel)
+{
+  const int count = 100;
+  Entity first = kNullEntity;
+  for (int i = 0; i < count; ++i)
+  {
+    Entity entity = manager.CreateEntity();
+    manager.CreateComponent<IntComponent>(entity, IntComponent(i));
+    if (kNullEntity == first)
+      first = entity;
+  }
+  manager.RunSetAllComponentsUnchanged();
+  EXPECT_TRUE(manager.ChangedEntities(IntComponent::typeId).empty());
+
+  // Flags raised from inside the parallel callbacks land in per-worker
+  // shards and are merged once the pass completes.
+  manager.EachParallel<IntComponent>(
+      [&](const Entity &_entity, IntComponent *_int)
+      {
+        _int->Data() += 1;
+        manager.SetChangedParallel(_entity, IntComponent::typeId,
+            ComponentState::PeriodicChange);
+      });
+  EXPECT_EQ(static_cast<size_t>(count),
+      manager.ChangedEntities(IntComponent::typeId).size());
+  EXPECT_EQ(ComponentState::PeriodicChange,
+      manager.ComponentState(first, IntComponent::typeId));
+
+  // Outside a parallel pass the call degrades to plain SetChanged.
+  manager.RunSetAllComponentsUnchanged();
+  manager.SetChangedParallel(first, IntComponent::typeId,
+      ComponentState::OneTimeChange);
+  ASSERT_EQ(1u, manager.ChangedEntities(IntComponent::typeId).size());
+  EXPECT_EQ(ComponentState::OneTimeChange,
+      manager.ComponentState(first, IntComponent::typeId));
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EachComponent)
+{
+  // A type with no storage yet should be a no-op.
+  manager.EachComponent<IntComponent>(
+      [&](const Entity &/*_entity*/, const IntComponent &/*_value*/) -> bool
+      {
+        ADD_FAILURE() << "Callback should not be invoked without components";
+        return true;
+      });
+
+  // Create entities, not all of which have an int component.
+  const int count = 10;
+  int expectedSum = 0;
+  Entity firstIntEntity = kNullEntity;
+  ComponentKey firstIntKey;
+  for (int i = 0; i < count; ++i)
+  {
+    Entity entity = manager.CreateEntity();
+    manager.CreateComponent<DoubleComponent>(entity, DoubleComponent(0.0));
+    if (i % 2 == 0)
+    {
+      auto compKey =
+          manager.CreateComponent<IntComponent>(entity, IntComponent(i));
+      if (kNullEntity == firstIntEntity)
+      {
+        firstIntEntity = entity;
+        firstIntKey = compKey;
+      }
+      expectedSum += i;
+    }
+  }
+
+  // The bulk pass visits every component of the type exactly once, and
+  // reports the owning entity.
+  int sum = 0;
+  std::set<Entity> owners;
+  manager.EachComponent<IntComponent>(
+      [&](const Entity &_entity, const IntComponent &_value) -> bool
+      {
+        sum += _value.Data();
+        owners.insert(_entity);
+        return true;
+      });
+  EXPECT_EQ(expectedSum, sum);
+  EXPECT_EQ(count / 2u, owners.size());
+
+  // The mutable overload can write through the contiguous array.
+  manager.EachComponent<IntComponent>(
+      [&](const Entity &/*_entity*/, IntComponent &_value) -> bool
+      {
+        _value.Data() *= 2;
+        return true;
+      });
+
+  sum = 0;
+  manager.EachComponent<IntComponent>(
+      [&](const Entity &/*_entity*/, const IntComponent &_value) -> bool
+      {
+        sum += _value.Data();
+        return true;
+      });
+  EXPECT_EQ(2 * expectedSum, sum);
+
+  // Owners stay consistent after a component is removed (swap-remove).
+  EXPECT_TRUE(manager.RemoveComponent(firstIntEntity, firstIntKey));
+
+  owners.clear();
+  manager.EachComponent<IntComponent>(
+      [&](const Entity &_entity, const IntComponent &/*_value*/) -> bool
+      {
+        owners.insert(_entity);
+        return true;
+      });
+  EXPECT_EQ(count / 2u - 1u, owners.size());
+  EXPECT_EQ(owners.end(), owners.find(firstIntEntity));
+}
+
 //////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture, EntityByComponents)
 {
@@ -1338,6 +1814,295 @@ TEST_P(EntityComponentManagerFixture, EntityByComponents)
   EXPECT_EQ(1u, entities.size());
 }
 
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, CreateComponentsBatch)
+{
+  Entity entity = manager.CreateEntity();
+  manager.CreateComponents(entity,
+      IntComponent(123),
+      DoubleComponent(0.123),
+      StringComponent("batch"));
+
+  // All components of the batch are attached with the given values
+  ASSERT_NE(nullptr, manager.Component<IntComponent>(entity));
+  EXPECT_EQ(123, manager.Component<IntComponent>(entity)->Data());
+  ASSERT_NE(nullptr, manager.Component<DoubleComponent>(entity));
+  EXPECT_DOUBLE_EQ(0.123, manager.Component<DoubleComponent>(entity)->Data());
+  ASSERT_NE(nullptr, manager.Component<StringComponent>(entity));
+  EXPECT_EQ("batch", manager.Component<StringComponent>(entity)->Data());
+
+  // Views see the batch-created components
+  int count = 0;
+  manager.Each<IntComponent, DoubleComponent, StringComponent>(
+      [&](const Entity &_entity, const IntComponent *_int,
+          const DoubleComponent *_double, const StringComponent *_string)
+      {
+        EXPECT_EQ(entity, _entity);
+        EXPECT_EQ(123, _int->Data());
+        EXPECT_DOUBLE_EQ(0.123, _double->Data());
+        EXPECT_EQ("batch", _string->Data());
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(1, count);
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EntitiesByName)
+{
+  EXPECT_TRUE(manager.EntitiesByName("box").empty());
+
+  // Names are not unique, so several entities can share one
+  Entity e1 = manager.CreateEntity();
+  manager.CreateComponent<components::Name>(e1, components::Name("box"));
+
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent<components::Name>(e2, components::Name("sphere"));
+  manager.CreateComponent<IntComponent>(e2, IntComponent(1));
+
+  Entity e3 = manager.CreateEntity();
+  manager.CreateComponent<components::Name>(e3, components::Name("box"));
+  manager.CreateComponent<IntComponent>(e3, IntComponent(2));
+
+  EXPECT_EQ(2u, manager.EntitiesByName("box").size());
+  auto sphereEntities = manager.EntitiesByName("sphere");
+  ASSERT_EQ(1u, sphereEntities.size());
+  EXPECT_EQ(e2, sphereEntities[0]);
+  EXPECT_TRUE(manager.EntitiesByName("cylinder").empty());
+
+  // EntityByComponents resolves queries with a name through the index
+  EXPECT_EQ(e2, manager.EntityByComponents(components::Name("sphere")));
+  EXPECT_EQ(e3, manager.EntityByComponents(components::Name("box"),
+      IntComponent(2)));
+  EXPECT_EQ(kNullEntity, manager.EntityByComponents(components::Name("box"),
+      IntComponent(1)));
+  EXPECT_EQ(kNullEntity,
+      manager.EntityByComponents(components::Name("cylinder")));
+
+  // Removing the name component removes the index entry
+  EXPECT_TRUE(manager.RemoveComponent(e1, components::Name::typeId));
+  EXPECT_EQ(1u, manager.EntitiesByName("box").size());
+
+  // Removing the entity does too
+  manager.RequestRemoveEntity(e3);
+  manager.ProcessEntityRemovals();
+  EXPECT_TRUE(manager.EntitiesByName("box").empty());
+  EXPECT_EQ(1u, manager.EntitiesByName("sphere").size());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ScopedNameChain)
+{
+  Entity worldEntity = manager.CreateEntity();
+  manager.CreateComponent<components::World>(worldEntity, components::World());
+  manager.CreateComponent<components::Name>(worldEntity,
+      components::Name("default"));
+
+  Entity modelEntity = manager.CreateEntity();
+  manager.CreateComponent<components::Model>(modelEntity, components::Model());
+  manager.CreateComponent<components::Name>(modelEntity,
+      components::Name("box"));
+  manager.CreateComponent<components::ParentEntity>(modelEntity,
+      components::ParentEntity(worldEntity));
+
+  // Entities without a name have an empty chain
+  Entity namelessEntity = manager.CreateEntity();
+  EXPECT_TRUE(manager.ScopedNameChain(namelessEntity).empty());
+
+  auto chain = manager.ScopedNameChain(modelEntity);
+  ASSERT_EQ(2u, chain.size());
+  EXPECT_EQ("world", chain[0].first);
+  EXPECT_EQ("default", chain[0].second);
+  EXPECT_EQ("model", chain[1].first);
+  EXPECT_EQ("box", chain[1].second);
+
+  // The second query is served from the cache
+  EXPECT_EQ(chain, manager.ScopedNameChain(modelEntity));
+
+  // Removing the parent component invalidates the cached chain
+  EXPECT_TRUE(manager.RemoveComponent(modelEntity,
+      components::ParentEntity::typeId));
+  auto orphanChain = manager.ScopedNameChain(modelEntity);
+  ASSERT_EQ(1u, orphanChain.size());
+  EXPECT_EQ("model", orphanChain[0].first);
+  EXPECT_EQ("box", orphanChain[0].second);
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, PoseHistory)
+{
+  Entity model = manager.CreateEntity();
+  manager.CreateComponent(model,
+      components::Pose(math::Pose3d(1, 0, 0, 0, 0, 0)));
+
+  Entity link = manager.CreateEntity();
+  manager.CreateComponent(link,
+      components::Pose(math::Pose3d(0, 1, 0, 0, 0, 0)));
+  manager.CreateComponent(link, components::ParentEntity(model));
+
+  // Untracked entities have no history
+  EXPECT_FALSE(manager.PoseAt(link, std::chrono::milliseconds(0)).has_value());
+
+  manager.TrackPoseHistory(link, 4);
+
+  // Tracked but nothing recorded yet
+  EXPECT_FALSE(manager.PoseAt(link, std::chrono::milliseconds(0)).has_value());
+
+  manager.RecordPoseHistories(std::chrono::milliseconds(0));
+
+  // The sample holds the world pose, composed over the parent chain
+  auto pose = manager.PoseAt(link, std::chrono::milliseconds(0));
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_EQ(math::Pose3d(1, 1, 0, 0, 0, 0), *pose);
+
+  // Move the model and record a second sample
+  manager.Component<components::Pose>(model)->Data().Pos().X(3);
+  manager.RecordPoseHistories(std::chrono::milliseconds(10));
+
+  // Interpolated halfway between the samples
+  pose = manager.PoseAt(link, std::chrono::milliseconds(5));
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_EQ(math::Pose3d(2, 1, 0, 0, 0, 0), *pose);
+
+  // Times outside the recorded range clamp to the ends
+  pose = manager.PoseAt(link, std::chrono::milliseconds(100));
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_EQ(math::Pose3d(3, 1, 0, 0, 0, 0), *pose);
+  pose = manager.PoseAt(link, std::chrono::milliseconds(-1));
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_EQ(math::Pose3d(1, 1, 0, 0, 0, 0), *pose);
+
+  // Overflow the ring; only the newest 4 samples survive
+  for (int i = 2; i < 8; ++i)
+  {
+    manager.Component<components::Pose>(model)->Data().Pos().X(i * 3);
+    manager.RecordPoseHistories(std::chrono::milliseconds(i * 10));
+  }
+
+  // The oldest surviving sample was recorded at 40ms with x = 12
+  pose = manager.PoseAt(link, std::chrono::milliseconds(0));
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_DOUBLE_EQ(12.0, pose->Pos().X());
+
+  // Interpolation still works across the wrapped ring
+  pose = manager.PoseAt(link, std::chrono::milliseconds(55));
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_DOUBLE_EQ(16.5, pose->Pos().X());
+
+  // Untracking discards the samples
+  manager.UntrackPoseHistory(link);
+  EXPECT_FALSE(
+      manager.PoseAt(link, std::chrono::milliseconds(40)).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, WorldPose)
+{
+  // world (no pose) -> model -> link -> sensor
+  Entity world = manager.CreateEntity();
+
+  Entity model = manager.CreateEntity();
+  manager.CreateComponent(model,
+      components::Pose(math::Pose3d(1, 0, 0, 0, 0, 0)));
+  manager.CreateComponent(model, components::ParentEntity(world));
+  manager.SetParentEntity(model, world);
+
+  Entity link = manager.CreateEntity();
+  manager.CreateComponent(link,
+      components::Pose(math::Pose3d(0, 2, 0, 0, 0, 0)));
+  manager.CreateComponent(link, components::ParentEntity(model));
+  manager.SetParentEntity(link, model);
+
+  Entity sensor = manager.CreateEntity();
+  manager.CreateComponent(sensor,
+      components::Pose(math::Pose3d(0, 0, 3, 0, 0, 0)));
+  manager.CreateComponent(sensor, components::ParentEntity(link));
+  manager.SetParentEntity(sensor, link);
+
+  // One sweep composes the whole chain
+  auto pose = manager.WorldPose(sensor);
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0), *pose);
+
+  pose = manager.WorldPose(link);
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_EQ(math::Pose3d(1, 2, 0, 0, 0, 0), *pose);
+
+  // An entity without a pose component has no world pose
+  EXPECT_FALSE(manager.WorldPose(world).has_value());
+
+  // The sweep is cached: direct mutation isn't visible until the
+  // step's change tracking resets
+  manager.Component<components::Pose>(model)->Data().Pos().X(10);
+  pose = manager.WorldPose(sensor);
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0), *pose);
+
+  manager.RunSetAllComponentsUnchanged();
+  pose = manager.WorldPose(sensor);
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_EQ(math::Pose3d(10, 2, 3, 0, 0, 0), *pose);
+
+  // Entities created after the sweep aren't covered until the next one
+  Entity late = manager.CreateEntity();
+  manager.CreateComponent(late,
+      components::Pose(math::Pose3d(5, 0, 0, 0, 0, 0)));
+  manager.CreateComponent(late, components::ParentEntity(model));
+  manager.SetParentEntity(late, model);
+  EXPECT_FALSE(manager.WorldPose(late).has_value());
+
+  manager.RunSetAllComponentsUnchanged();
+  pose = manager.WorldPose(late);
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_EQ(math::Pose3d(15, 0, 0, 0, 0, 0), *pose);
+
+  // The worldPose helper resolves through the same sweep
+  EXPECT_EQ(math::Pose3d(10, 2, 3, 0, 0, 0), worldPose(sensor, manager));
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ChurnCounters)
+{
+  const auto before = manager.Churn();
+  EXPECT_EQ(0u, before.entitiesCreated);
+  EXPECT_EQ(0u, before.entitiesRemoved);
+  EXPECT_EQ(0u, before.componentsCreated);
+  EXPECT_EQ(0u, before.componentsRemoved);
+
+  Entity entity = manager.CreateEntity();
+  Entity other = manager.CreateEntity();
+  auto key = manager.CreateComponent(entity, IntComponent(1));
+  manager.CreateComponent(other, IntComponent(2));
+  manager.CreateComponent(other, DoubleComponent(0.5));
+
+  auto churn = manager.Churn();
+  EXPECT_EQ(2u, churn.entitiesCreated);
+  EXPECT_EQ(0u, churn.entitiesRemoved);
+  EXPECT_EQ(3u, churn.componentsCreated);
+  EXPECT_EQ(0u, churn.componentsRemoved);
+
+  // Per-type churn distinguishes the component types
+  auto perType = manager.ComponentChurn();
+  EXPECT_EQ(2u, perType[IntComponent::typeId].first);
+  EXPECT_EQ(0u, perType[IntComponent::typeId].second);
+  EXPECT_EQ(1u, perType[DoubleComponent::typeId].first);
+
+  EXPECT_TRUE(manager.RemoveComponent(entity, key));
+  churn = manager.Churn();
+  EXPECT_EQ(1u, churn.componentsRemoved);
+  perType = manager.ComponentChurn();
+  EXPECT_EQ(1u, perType[IntComponent::typeId].second);
+
+  // Removal counts when the request is processed, not when made
+  manager.RequestRemoveEntity(other);
+  EXPECT_EQ(0u, manager.Churn().entitiesRemoved);
+  manager.ProcessEntityRemovals();
+  EXPECT_EQ(1u, manager.Churn().entitiesRemoved);
+
+  // The counters are cumulative, so nothing reset entitiesCreated
+  EXPECT_EQ(2u, manager.Churn().entitiesCreated);
+}
+
 /////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture, EntityGraph)
 {
@@ -1518,7 +2283,7 @@ TEST_P(EntityComponentManagerFixture, State)
     auto compIter = e1Msg.components().begin();
     const auto &e1c0Msg = compIter->second;
     EXPECT_EQ(IntComponent::typeId, e1c0Msg.type());
-    EXPECT_EQ(e1c0, std::stoi(e1c0Msg.component()));
+    EXPECT_EQ(e1c0, rawData<int>(e1c0Msg.component()));
 
     iter = stateMsg.entities().find(e2);
     const auto &e2Msg = iter->second;
@@ -1530,7 +2295,7 @@ TEST_P(EntityComponentManagerFixture, State)
     {
       const auto &e2c0Msg = compIter->second;
       EXPECT_EQ(DoubleComponent::typeId, e2c0Msg.type());
-      EXPECT_DOUBLE_EQ(e2c0, std::stod(e2c0Msg.component()));
+      EXPECT_DOUBLE_EQ(e2c0, rawData<double>(e2c0Msg.component()));
     }
     else
     {
@@ -1544,7 +2309,7 @@ TEST_P(EntityComponentManagerFixture, State)
     {
       const auto &e2c0Msg = compIter->second;
       EXPECT_EQ(DoubleComponent::typeId, e2c0Msg.type());
-      EXPECT_DOUBLE_EQ(e2c0, std::stod(e2c0Msg.component()));
+      EXPECT_DOUBLE_EQ(e2c0, rawData<double>(e2c0Msg.component()));
     }
     else
     {
@@ -1560,7 +2325,7 @@ TEST_P(EntityComponentManagerFixture, State)
 
     const auto &e3c0Msg = e3Msg.components().begin()->second;
     EXPECT_EQ(IntComponent::typeId, e3c0Msg.type());
-    EXPECT_EQ(e3c0, std::stoi(e3c0Msg.component()));
+    EXPECT_EQ(e3c0, rawData<int>(e3c0Msg.component()));
   }
 
   // Serialize changed state into a message, it should be the same
@@ -1731,7 +2496,7 @@ TEST_P(EntityComponentManagerFixture, State)
     auto compIter = e3Msg.components().begin();
     const auto &e3c0Msg = compIter->second;
     EXPECT_EQ(IntComponent::typeId, e3c0Msg.type());
-    EXPECT_EQ(e3c0New, std::stoi(e3c0Msg.component()));
+    EXPECT_EQ(e3c0New, rawData<int>(e3c0Msg.component()));
 
     iter = stateMsg2.entities().find(e4);
     const auto &e4Msg = iter->second;
@@ -1741,10 +2506,281 @@ TEST_P(EntityComponentManagerFixture, State)
     auto compIter4 = e4Msg.components().begin();
     const auto &e4c0Msg = compIter4->second;
     EXPECT_EQ(IntComponent::typeId, e4c0Msg.type());
-    EXPECT_EQ(e4c0, std::stoi(e4c0Msg.component()));
+    EXPECT_EQ(e4c0, rawData<int>(e4c0Msg.component()));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, StateUntaggedTextPayload)
+{
+  // A text payload whose length coincidentally matches the data type's
+  // size — "1234" is sizeof(int) bytes, "-3.14159" is sizeof(double)
+  // bytes — must not be mistaken for a raw byte copy. Only messages
+  // carrying the "raw_components" header tag use the raw path; untagged
+  // messages, such as recordings made before raw copies existed, stay
+  // on the stream operators.
+  Entity e1{1};
+
+  msgs::SerializedStateMap stateMsg;
+  msgs::SerializedEntityMap entMsg;
+  entMsg.set_id(e1);
+
+  msgs::SerializedComponent intMsg;
+  intMsg.set_type(IntComponent::typeId);
+  intMsg.set_component("1234");
+  ASSERT_EQ(sizeof(int), intMsg.component().size());
+  (*entMsg.mutable_components())[intMsg.type()] = intMsg;
+
+  msgs::SerializedComponent doubleMsg;
+  doubleMsg.set_type(DoubleComponent::typeId);
+  doubleMsg.set_component("-3.14159");
+  ASSERT_EQ(sizeof(double), doubleMsg.component().size());
+  (*entMsg.mutable_components())[doubleMsg.type()] = doubleMsg;
+
+  (*stateMsg.mutable_entities())[static_cast<uint64_t>(e1)] = entMsg;
+
+  manager.SetState(stateMsg);
+
+  auto intComp = manager.Component<IntComponent>(e1);
+  ASSERT_NE(nullptr, intComp);
+  EXPECT_EQ(1234, intComp->Data());
+
+  auto doubleComp = manager.Component<DoubleComponent>(e1);
+  ASSERT_NE(nullptr, doubleComp);
+  EXPECT_DOUBLE_EQ(-3.14159, doubleComp->Data());
+
+  // Messages produced by the manager carry the tag, so raw copies
+  // still round-trip.
+  msgs::SerializedStateMap tagged;
+  manager.State(tagged);
+  bool foundTag{false};
+  for (const auto &data : tagged.header().data())
+  {
+    if (data.key() == "raw_components" && data.value_size() > 0)
+      foundTag = "true" == data.value(0);
+  }
+  EXPECT_TRUE(foundTag);
+
+  EntityComponentManager newEcm;
+  newEcm.SetState(tagged);
+  auto roundTripped = newEcm.Component<DoubleComponent>(e1);
+  ASSERT_NE(nullptr, roundTripped);
+  EXPECT_DOUBLE_EQ(-3.14159, roundTripped->Data());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ChangedStateMap)
+{
+  // Create entities with components
+  Entity e1 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e2, IntComponent(2));
+  manager.CreateComponent<DoubleComponent>(e2, DoubleComponent(0.1));
+
+  // Right after creation everything is new / changed
+  {
+    msgs::SerializedStateMap stateMsg;
+    manager.ChangedState(stateMsg);
+    EXPECT_EQ(2, stateMsg.entities_size());
+  }
+
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+
+  // Nothing changed, nothing serialized
+  {
+    msgs::SerializedStateMap stateMsg;
+    manager.ChangedState(stateMsg);
+    EXPECT_EQ(0, stateMsg.entities_size());
+  }
+
+  // Only the modified component of the modified entity is serialized
+  {
+    manager.Component<IntComponent>(e2)->Data() = 20;
+    manager.SetChanged(e2, IntComponent::typeId,
+        ComponentState::OneTimeChange);
+
+    msgs::SerializedStateMap stateMsg;
+    manager.ChangedState(stateMsg);
+    ASSERT_EQ(1, stateMsg.entities_size());
+
+    auto iter = stateMsg.entities().find(e2);
+    ASSERT_NE(stateMsg.entities().end(), iter);
+    ASSERT_EQ(1u, iter->second.components().size());
+    EXPECT_EQ(20, rawData<int>(
+        iter->second.components().begin()->second.component()));
+
+    // Reusing the same message updates the entry in place
+    manager.Component<IntComponent>(e2)->Data() = 30;
+    manager.SetChanged(e2, IntComponent::typeId,
+        ComponentState::OneTimeChange);
+    manager.ChangedState(stateMsg);
+    ASSERT_EQ(1, stateMsg.entities_size());
+    iter = stateMsg.entities().find(e2);
+    EXPECT_EQ(30, rawData<int>(
+        iter->second.components().begin()->second.component()));
+  }
+
+  // The type-filtered delta State() only reports changed components of
+  // the requested types
+  {
+    msgs::SerializedStateMap stateMsg;
+    manager.State(stateMsg, {}, {DoubleComponent::typeId});
+    EXPECT_EQ(0, stateMsg.entities_size());
+
+    manager.State(stateMsg, {}, {IntComponent::typeId});
+    ASSERT_EQ(1, stateMsg.entities_size());
+    auto iter = stateMsg.entities().find(e2);
+    ASSERT_NE(stateMsg.entities().end(), iter);
+    ASSERT_EQ(1u, iter->second.components().size());
   }
 }
 
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, SnapshotRestore)
+{
+  // World with one model holding a joint
+  Entity worldEntity = manager.CreateEntity();
+  manager.CreateComponent(worldEntity, World());
+  manager.CreateComponent(worldEntity, Name("default"));
+
+  Entity modelEntity = manager.CreateEntity();
+  manager.CreateComponent(modelEntity, Model());
+  manager.CreateComponent(modelEntity, Name("box"));
+  manager.CreateComponent(modelEntity, ParentEntity(worldEntity));
+  manager.CreateComponent(modelEntity,
+      Pose({1, 2, 3, 0, 0, 0}));
+
+  Entity jointEntity = manager.CreateEntity();
+  manager.CreateComponent(jointEntity, ParentEntity(modelEntity));
+  manager.CreateComponent(jointEntity, JointPosition({0.5}));
+  manager.CreateComponent(jointEntity, JointVelocity({0.1}));
+
+  // Capture the episode's initial state
+  std::string blob = manager.SnapshotState();
+  EXPECT_FALSE(blob.empty());
+
+  // Simulate forward: pose and joint state drift away
+  manager.Component<Pose>(modelEntity)->Data() =
+      math::Pose3d(4, 5, 6, 0, 0, 1);
+  manager.Component<JointPosition>(jointEntity)->Data() = {1.5};
+  manager.Component<JointVelocity>(jointEntity)->Data() = {2.1};
+
+  // Restore brings back the captured values...
+  EXPECT_TRUE(manager.RestoreState(blob));
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0),
+      manager.Component<Pose>(modelEntity)->Data());
+  EXPECT_EQ(std::vector<double>({0.5}),
+      manager.Component<JointPosition>(jointEntity)->Data());
+  EXPECT_EQ(std::vector<double>({0.1}),
+      manager.Component<JointVelocity>(jointEntity)->Data());
+
+  // ... and writes them through to physics via the command components
+  auto poseCmd = manager.Component<WorldPoseCmd>(modelEntity);
+  ASSERT_NE(nullptr, poseCmd);
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0), poseCmd->Data());
+
+  auto jointPosReset = manager.Component<JointPositionReset>(jointEntity);
+  ASSERT_NE(nullptr, jointPosReset);
+  EXPECT_EQ(std::vector<double>({0.5}), jointPosReset->Data());
+
+  auto jointVelReset = manager.Component<JointVelocityReset>(jointEntity);
+  ASSERT_NE(nullptr, jointVelReset);
+  EXPECT_EQ(std::vector<double>({0.1}), jointVelReset->Data());
+
+  // Restoring again updates the commands in place
+  EXPECT_TRUE(manager.RestoreState(blob));
+  EXPECT_EQ(poseCmd, manager.Component<WorldPoseCmd>(modelEntity));
+
+  // Garbage isn't applied
+  EXPECT_FALSE(manager.RestoreState("not a snapshot"));
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, CloneAndDiff)
+{
+  Entity e1 = manager.CreateEntity();
+  manager.CreateComponent(e1, IntComponent(1));
+  manager.CreateComponent(e1, DoubleComponent(0.5));
+
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent(e2, IntComponent(2));
+
+  // Fork the manager. The clone starts out reading the same values.
+  auto clone = manager.Clone();
+  ASSERT_NE(nullptr, clone);
+  EXPECT_TRUE(clone->HasEntity(e1));
+  EXPECT_TRUE(clone->HasEntity(e2));
+  ASSERT_NE(nullptr, clone->Component<IntComponent>(e1));
+  EXPECT_EQ(1, clone->Component<IntComponent>(e1)->Data());
+  ASSERT_NE(nullptr, clone->Component<DoubleComponent>(e1));
+  EXPECT_DOUBLE_EQ(0.5, clone->Component<DoubleComponent>(e1)->Data());
+
+  // Diverge the clone: change a component, remove one, add one, and
+  // create a whole new entity.
+  clone->Component<IntComponent>(e1)->Data() = 10;
+  EXPECT_TRUE(clone->RemoveComponent(e1, DoubleComponent::typeId));
+  clone->CreateComponent(e2, StringComponent("forked"));
+  Entity e3 = clone->CreateEntity();
+  clone->CreateComponent(e3, IntComponent(3));
+
+  // Copy-on-write: the source manager is unaffected by all of it.
+  EXPECT_EQ(1, manager.Component<IntComponent>(e1)->Data());
+  ASSERT_NE(nullptr, manager.Component<DoubleComponent>(e1));
+  EXPECT_DOUBLE_EQ(0.5, manager.Component<DoubleComponent>(e1)->Data());
+  EXPECT_EQ(nullptr, manager.Component<StringComponent>(e2));
+  EXPECT_FALSE(manager.HasEntity(e3));
+
+  // The diff holds exactly the divergent entities and components.
+  msgs::SerializedStateMap stateMsg;
+  clone->Diff(manager, stateMsg);
+  EXPECT_EQ(3, stateMsg.entities_size());
+
+  ASSERT_NE(stateMsg.entities().end(), stateMsg.entities().find(e1));
+  auto e1Msg = stateMsg.entities().at(e1);
+  EXPECT_FALSE(e1Msg.remove());
+  ASSERT_NE(e1Msg.components().end(),
+      e1Msg.components().find(IntComponent::typeId));
+  EXPECT_FALSE(e1Msg.components().at(IntComponent::typeId).remove());
+  EXPECT_EQ(10, rawData<int>(
+      e1Msg.components().at(IntComponent::typeId).component()));
+  ASSERT_NE(e1Msg.components().end(),
+      e1Msg.components().find(DoubleComponent::typeId));
+  EXPECT_TRUE(e1Msg.components().at(DoubleComponent::typeId).remove());
+
+  ASSERT_NE(stateMsg.entities().end(), stateMsg.entities().find(e2));
+  auto e2Msg = stateMsg.entities().at(e2);
+  EXPECT_EQ(1, e2Msg.components_size());
+  ASSERT_NE(e2Msg.components().end(),
+      e2Msg.components().find(StringComponent::typeId));
+
+  ASSERT_NE(stateMsg.entities().end(), stateMsg.entities().find(e3));
+  auto e3Msg = stateMsg.entities().at(e3);
+  ASSERT_NE(e3Msg.components().end(),
+      e3Msg.components().find(IntComponent::typeId));
+  EXPECT_EQ(3, rawData<int>(
+      e3Msg.components().at(IntComponent::typeId).component()));
+
+  // Applying the diff to a second fork of the source merges the clone's
+  // changes into it.
+  auto merged = manager.Clone();
+  merged->SetState(stateMsg);
+  EXPECT_EQ(10, merged->Component<IntComponent>(e1)->Data());
+  EXPECT_EQ(nullptr, merged->Component<DoubleComponent>(e1));
+  ASSERT_NE(nullptr, merged->Component<StringComponent>(e2));
+  EXPECT_EQ("forked", merged->Component<StringComponent>(e2)->Data());
+  EXPECT_TRUE(merged->HasEntity(e3));
+  ASSERT_NE(nullptr, merged->Component<IntComponent>(e3));
+  EXPECT_EQ(3, merged->Component<IntComponent>(e3)->Data());
+
+  // Identical forks produce an empty diff.
+  msgs::SerializedStateMap emptyMsg;
+  auto fresh = manager.Clone();
+  fresh->Diff(manager, emptyMsg);
+  EXPECT_EQ(0, emptyMsg.entities_size());
+}
+
 /////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture, Descendants)
 {
@@ -1956,6 +2992,129 @@ TEST_P(EntityComponentManagerFixture, Descendants)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, DescendantsReparent)
+{
+  // - 1
+  //   - 2
+  //     - 3
+  //   - 4
+  // - 5
+  //   - 6
+
+  auto e1 = manager.CreateEntity();
+  auto e2 = manager.CreateEntity();
+  manager.SetParentEntity(e2, e1);
+  auto e3 = manager.CreateEntity();
+  manager.SetParentEntity(e3, e2);
+  auto e4 = manager.CreateEntity();
+  manager.SetParentEntity(e4, e1);
+  auto e5 = manager.CreateEntity();
+  auto e6 = manager.CreateEntity();
+  manager.SetParentEntity(e6, e5);
+
+  {
+    auto ds = manager.Descendants(e1);
+    EXPECT_EQ(4u, ds.size());
+    EXPECT_NE(ds.end(), ds.find(e1));
+    EXPECT_NE(ds.end(), ds.find(e2));
+    EXPECT_NE(ds.end(), ds.find(e3));
+    EXPECT_NE(ds.end(), ds.find(e4));
+  }
+
+  // Attach the subtree rooted at 2 under 6, deeper in a later tree
+  EXPECT_TRUE(manager.SetParentEntity(e2, e6));
+
+  {
+    auto ds = manager.Descendants(e1);
+    EXPECT_EQ(2u, ds.size());
+    EXPECT_NE(ds.end(), ds.find(e1));
+    EXPECT_NE(ds.end(), ds.find(e4));
+  }
+
+  {
+    auto ds = manager.Descendants(e5);
+    EXPECT_EQ(4u, ds.size());
+    EXPECT_NE(ds.end(), ds.find(e5));
+    EXPECT_NE(ds.end(), ds.find(e6));
+    EXPECT_NE(ds.end(), ds.find(e2));
+    EXPECT_NE(ds.end(), ds.find(e3));
+  }
+
+  {
+    auto ds = manager.Descendants(e2);
+    EXPECT_EQ(2u, ds.size());
+    EXPECT_NE(ds.end(), ds.find(e2));
+    EXPECT_NE(ds.end(), ds.find(e3));
+  }
+
+  // Move it back to an earlier tree, under 4
+  EXPECT_TRUE(manager.SetParentEntity(e2, e4));
+
+  {
+    auto ds = manager.Descendants(e1);
+    EXPECT_EQ(4u, ds.size());
+    EXPECT_NE(ds.end(), ds.find(e1));
+    EXPECT_NE(ds.end(), ds.find(e2));
+    EXPECT_NE(ds.end(), ds.find(e3));
+    EXPECT_NE(ds.end(), ds.find(e4));
+  }
+
+  {
+    auto ds = manager.Descendants(e4);
+    EXPECT_EQ(3u, ds.size());
+    EXPECT_NE(ds.end(), ds.find(e4));
+    EXPECT_NE(ds.end(), ds.find(e2));
+    EXPECT_NE(ds.end(), ds.find(e3));
+  }
+
+  {
+    auto ds = manager.Descendants(e5);
+    EXPECT_EQ(2u, ds.size());
+    EXPECT_NE(ds.end(), ds.find(e5));
+    EXPECT_NE(ds.end(), ds.find(e6));
+  }
+
+  // Detach it, like a detachable joint breaking
+  EXPECT_TRUE(manager.SetParentEntity(e2, kNullEntity));
+
+  {
+    auto ds = manager.Descendants(e1);
+    EXPECT_EQ(2u, ds.size());
+    EXPECT_NE(ds.end(), ds.find(e1));
+    EXPECT_NE(ds.end(), ds.find(e4));
+  }
+
+  {
+    auto ds = manager.Descendants(e2);
+    EXPECT_EQ(2u, ds.size());
+    EXPECT_NE(ds.end(), ds.find(e2));
+    EXPECT_NE(ds.end(), ds.find(e3));
+  }
+
+  // Reattach, and parent a new entity while the tour is warm
+  EXPECT_TRUE(manager.SetParentEntity(e2, e6));
+  auto e7 = manager.CreateEntity();
+  EXPECT_TRUE(manager.SetParentEntity(e7, e3));
+
+  {
+    auto ds = manager.Descendants(e5);
+    EXPECT_EQ(5u, ds.size());
+    EXPECT_NE(ds.end(), ds.find(e5));
+    EXPECT_NE(ds.end(), ds.find(e6));
+    EXPECT_NE(ds.end(), ds.find(e2));
+    EXPECT_NE(ds.end(), ds.find(e3));
+    EXPECT_NE(ds.end(), ds.find(e7));
+  }
+
+  {
+    auto ds = manager.Descendants(e3);
+    EXPECT_EQ(2u, ds.size());
+    EXPECT_NE(ds.end(), ds.find(e3));
+    EXPECT_NE(ds.end(), ds.find(e7));
+  }
+}
+
 //////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture, SetChanged)
 {
@@ -2009,6 +3168,92 @@ TEST_P(EntityComponentManagerFixture, SetChanged)
       manager.ComponentState(e2, c2.first));
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, SetChangedBatch)
+{
+  // Create entities
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  Entity e3 = manager.CreateEntity();
+  EXPECT_EQ(3u, manager.EntityCount());
+
+  // Add components to each entity
+  auto c1 = manager.CreateComponent<IntComponent>(e1, IntComponent(123));
+  auto c2 = manager.CreateComponent<IntComponent>(e2, IntComponent(456));
+  manager.CreateComponent<IntComponent>(e3, IntComponent(789));
+
+  manager.RunSetAllComponentsUnchanged();
+
+  // Mark several entities as changed in one call. Entities without the
+  // component and invalid entities are skipped.
+  manager.SetChanged({e1, e2, kNullEntity, 999},
+      IntComponent::typeId, ComponentState::PeriodicChange);
+
+  EXPECT_EQ(ComponentState::PeriodicChange,
+      manager.ComponentState(e1, c1.first));
+  EXPECT_EQ(ComponentState::PeriodicChange,
+      manager.ComponentState(e2, c2.first));
+  EXPECT_EQ(ComponentState::NoChange,
+      manager.ComponentState(e3, IntComponent::typeId));
+
+  // One-time changes override periodic ones
+  manager.SetChanged({e1, e3}, IntComponent::typeId,
+      ComponentState::OneTimeChange);
+
+  EXPECT_TRUE(manager.HasOneTimeComponentChanges());
+  EXPECT_EQ(ComponentState::OneTimeChange,
+      manager.ComponentState(e1, c1.first));
+  EXPECT_EQ(ComponentState::OneTimeChange,
+      manager.ComponentState(e3, IntComponent::typeId));
+
+  // Clear all the flags in one call
+  manager.SetChanged({e1, e2, e3}, IntComponent::typeId,
+      ComponentState::NoChange);
+
+  EXPECT_FALSE(manager.HasOneTimeComponentChanges());
+  EXPECT_EQ(ComponentState::NoChange,
+      manager.ComponentState(e1, c1.first));
+  EXPECT_EQ(ComponentState::NoChange,
+      manager.ComponentState(e2, c2.first));
+  EXPECT_EQ(ComponentState::NoChange,
+      manager.ComponentState(e3, IntComponent::typeId));
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, MemoryAccounting)
+{
+  // Create entities with components
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(123));
+  manager.CreateComponent<IntComponent>(e2, IntComponent(456));
+  manager.CreateComponent<DoubleComponent>(e2, DoubleComponent(0.123));
+
+  auto storageMemory = manager.StorageMemory();
+  ASSERT_NE(storageMemory.end(), storageMemory.find(IntComponent::typeId));
+  ASSERT_NE(storageMemory.end(), storageMemory.find(DoubleComponent::typeId));
+
+  // First is bytes, second is the component count
+  EXPECT_GT(storageMemory[IntComponent::typeId].first, 0u);
+  EXPECT_EQ(2u, storageMemory[IntComponent::typeId].second);
+  EXPECT_EQ(1u, storageMemory[DoubleComponent::typeId].second);
+
+  // No view exists until an Each query creates one
+  EXPECT_TRUE(manager.ViewMemory().empty());
+
+  manager.Each<IntComponent>(
+      [&](const Entity &, const IntComponent *)->bool
+      {
+        return true;
+      });
+
+  auto viewMemory = manager.ViewMemory();
+  ASSERT_EQ(1u, viewMemory.size());
+  EXPECT_EQ(std::set<ComponentTypeId>{IntComponent::typeId},
+      viewMemory.begin()->first);
+  EXPECT_GT(viewMemory.begin()->second, 0u);
+}
+
 // Run multiple times. We want to make sure that static globals don't cause
 // problems.
 INSTANTIATE_TEST_CASE_P(EntityComponentManagerRepeat,
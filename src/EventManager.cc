@@ -24,3 +24,27 @@ EventManager::EventManager() = default;
 
 //////////////////////////////////////////////////
 EventManager::~EventManager() = default;
+
+//////////////////////////////////////////////////
+std::size_t EventManager::ProcessDeferred(std::size_t _budget)
+{
+  std::size_t dispatched = 0;
+  while (0u == _budget || dispatched < _budget)
+  {
+    std::function<void()> emission;
+    {
+      std::lock_guard<std::mutex> lock(this->deferredMutex);
+      if (this->deferredEmissions.empty())
+        break;
+      emission = std::move(this->deferredEmissions.front());
+      this->deferredEmissions.pop_front();
+    }
+
+    // Invoke outside the lock so subscribers can queue further emissions.
+    emission();
+    ++dispatched;
+  }
+
+  std::lock_guard<std::mutex> lock(this->deferredMutex);
+  return this->deferredEmissions.size();
+}
@@ -119,3 +119,32 @@ TEST(EventManager, Disambiguate)
   EXPECT_EQ(1, calls);
 }
 
+
+/// Test that deferred emissions only fire when processed, and that the
+/// dispatch budget bounds how many fire per call.
+TEST(EventManager, EmitDeferred)
+{
+  EventManager eventManager;
+
+  int calls = 0;
+  auto connection = eventManager.Connect<events::Pause>(
+    [&calls](bool) { calls++; });
+
+  // Queueing does not invoke the callback.
+  eventManager.EmitDeferred<events::Pause>(true);
+  eventManager.EmitDeferred<events::Pause>(false);
+  eventManager.EmitDeferred<events::Pause>(true);
+  EXPECT_EQ(0, calls);
+
+  // A budget of 2 leaves one emission queued.
+  EXPECT_EQ(1u, eventManager.ProcessDeferred(2u));
+  EXPECT_EQ(2, calls);
+
+  // A budget of 0 drains the queue.
+  EXPECT_EQ(0u, eventManager.ProcessDeferred());
+  EXPECT_EQ(3, calls);
+
+  // Nothing left to dispatch.
+  EXPECT_EQ(0u, eventManager.ProcessDeferred());
+  EXPECT_EQ(3, calls);
+}
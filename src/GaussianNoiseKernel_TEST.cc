@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <sdf/Noise.hh>
+
+#include <ignition/math/Rand.hh>
+
+#include "ignition/gazebo/detail/GaussianNoiseKernel.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(GaussianNoiseKernelTest, SilentChannelsAreZero)
+{
+  detail::GaussianNoiseKernel kernel(3);
+  kernel.AddRow(1, {});
+  EXPECT_EQ(1u, kernel.RowCount());
+
+  UpdateInfo info;
+  std::vector<double> samples;
+  kernel.Sample(info, samples);
+  ASSERT_EQ(3u, samples.size());
+  for (const double sample : samples)
+    EXPECT_DOUBLE_EQ(0.0, sample);
+}
+
+/////////////////////////////////////////////////
+TEST(GaussianNoiseKernelTest, DrawsAreDeterministic)
+{
+  math::Rand::Seed(42);
+
+  sdf::Noise noise;
+  noise.SetType(sdf::NoiseType::GAUSSIAN);
+  noise.SetStdDev(1.0);
+
+  detail::GaussianNoiseKernel kernel(2);
+  kernel.AddRow(7, {noise, noise});
+
+  UpdateInfo info;
+  info.iterations = 5;
+
+  std::vector<double> first, second;
+  kernel.Sample(info, first);
+  kernel.Sample(info, second);
+  EXPECT_EQ(first, second);
+
+  // A different iteration produces different draws.
+  info.iterations = 6;
+  kernel.Sample(info, second);
+  EXPECT_NE(first, second);
+}
+
+/////////////////////////////////////////////////
+TEST(GaussianNoiseKernelTest, SampleStatistics)
+{
+  math::Rand::Seed(42);
+
+  sdf::Noise noise;
+  noise.SetType(sdf::NoiseType::GAUSSIAN);
+  noise.SetMean(2.0);
+  noise.SetStdDev(0.5);
+
+  detail::GaussianNoiseKernel kernel(1);
+  kernel.AddRow(3, {noise});
+
+  UpdateInfo info;
+  std::vector<double> samples;
+  double sum = 0.0;
+  double sumSq = 0.0;
+  const std::size_t count = 20000;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    info.iterations = i;
+    kernel.Sample(info, samples);
+    sum += samples[0];
+    sumSq += samples[0] * samples[0];
+  }
+
+  const double mean = sum / count;
+  const double stdDev = std::sqrt(sumSq / count - mean * mean);
+  EXPECT_NEAR(2.0, mean, 0.02);
+  EXPECT_NEAR(0.5, stdDev, 0.02);
+}
+
+/////////////////////////////////////////////////
+TEST(GaussianNoiseKernelTest, QuantizedDrawsSnapToPrecision)
+{
+  math::Rand::Seed(42);
+
+  sdf::Noise noise;
+  noise.SetType(sdf::NoiseType::GAUSSIAN_QUANTIZED);
+  noise.SetStdDev(1.0);
+  noise.SetPrecision(0.1);
+
+  detail::GaussianNoiseKernel kernel(1);
+  kernel.AddRow(9, {noise});
+
+  UpdateInfo info;
+  std::vector<double> samples;
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    info.iterations = i;
+    kernel.Sample(info, samples);
+    const double steps = samples[0] / 0.1;
+    EXPECT_NEAR(std::round(steps), steps, 1e-9);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(GaussianNoiseKernelTest, SwapRemoveKeepsRemainingRows)
+{
+  sdf::Noise first;
+  first.SetType(sdf::NoiseType::GAUSSIAN);
+  first.SetMean(1.0);
+
+  sdf::Noise second;
+  second.SetType(sdf::NoiseType::GAUSSIAN);
+  second.SetMean(2.0);
+
+  detail::GaussianNoiseKernel kernel(1);
+  kernel.AddRow(1, {first});
+  kernel.AddRow(2, {second});
+  EXPECT_EQ(2u, kernel.RowCount());
+
+  // Removing row 0 swaps the last row into its place.
+  kernel.SwapRemoveRow(0);
+  EXPECT_EQ(1u, kernel.RowCount());
+
+  // Zero standard deviation, so the sample is exactly the mean.
+  UpdateInfo info;
+  std::vector<double> samples;
+  kernel.Sample(info, samples);
+  ASSERT_EQ(1u, samples.size());
+  EXPECT_DOUBLE_EQ(2.0, samples[0]);
+
+  kernel.SwapRemoveRow(0);
+  EXPECT_EQ(0u, kernel.RowCount());
+  kernel.Sample(info, samples);
+  EXPECT_TRUE(samples.empty());
+}
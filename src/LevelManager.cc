@@ -15,6 +15,9 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include <sdf/Actor.hh>
 #include <sdf/Atmosphere.hh>
 #include <sdf/Light.hh>
@@ -54,6 +57,18 @@
 using namespace ignition;
 using namespace gazebo;
 
+namespace
+{
+/// \brief Hash a level index cell coordinate into a map key. Distant
+/// cells may collide, which only costs extra exact intersection tests.
+uint64_t IndexKey(int64_t _x, int64_t _y, int64_t _z)
+{
+  return static_cast<uint64_t>(_x) * 73856093ull ^
+         static_cast<uint64_t>(_y) * 19349663ull ^
+         static_cast<uint64_t>(_z) * 83492791ull;
+}
+}
+
 /////////////////////////////////////////////////
 LevelManager::LevelManager(SimulationRunner *_runner, const bool _useLevels)
     : runner(_runner), useLevels(_useLevels)
@@ -367,6 +382,103 @@ void LevelManager::ReadLevels(const sdf::ElementPtr &_sdf)
 
     this->entityCreator->SetParent(levelEntity, this->worldEntity);
   }
+
+  this->BuildLevelIndex();
+}
+
+/////////////////////////////////////////////////
+void LevelManager::BuildLevelIndex()
+{
+  IGN_PROFILE("LevelManager::BuildLevelIndex");
+
+  this->levelIndex.clear();
+  this->levelIndexCellSize = 0.0;
+
+  // Collect the buffered volume of every level, and size the cells to the
+  // largest one so a level never spans more than a few cells.
+  std::vector<std::pair<Entity, math::AxisAlignedBox>> volumes;
+  double maxExtent = 0.0;
+
+  this->runner->entityCompMgr.Each<components::Level, components::Pose,
+    components::Geometry, components::LevelBuffer>(
+      [&](const Entity &_entity, const components::Level *,
+          const components::Pose *_pose,
+          const components::Geometry *_geometry,
+          const components::LevelBuffer *_buffer) -> bool
+      {
+        auto box = _geometry->Data().BoxShape();
+        if (nullptr == box)
+          return true;
+
+        auto center = _pose->Data().Pos();
+        auto buffer = _buffer->Data();
+        math::AxisAlignedBox outerRegion{
+            center - (box->Size() / 2 + buffer),
+            center + (box->Size() / 2 + buffer)};
+
+        maxExtent = std::max({maxExtent, outerRegion.XLength(),
+            outerRegion.YLength(), outerRegion.ZLength()});
+        volumes.emplace_back(_entity, outerRegion);
+        return true;
+      });
+
+  if (volumes.empty())
+    return;
+
+  this->levelIndexCellSize = std::max(1.0, maxExtent);
+
+  for (const auto &[entity, volume] : volumes)
+  {
+    const auto min = volume.Min() / this->levelIndexCellSize;
+    const auto max = volume.Max() / this->levelIndexCellSize;
+    for (auto x = static_cast<int64_t>(std::floor(min.X()));
+         x <= static_cast<int64_t>(std::floor(max.X())); ++x)
+    {
+      for (auto y = static_cast<int64_t>(std::floor(min.Y()));
+           y <= static_cast<int64_t>(std::floor(max.Y())); ++y)
+      {
+        for (auto z = static_cast<int64_t>(std::floor(min.Z()));
+             z <= static_cast<int64_t>(std::floor(max.Z())); ++z)
+        {
+          this->levelIndex[IndexKey(x, y, z)].push_back(entity);
+        }
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+std::vector<Entity> LevelManager::LevelsInVolume(
+    const math::AxisAlignedBox &_volume) const
+{
+  std::vector<Entity> candidates;
+  if (this->levelIndexCellSize <= 0.0)
+    return candidates;
+
+  std::set<Entity> found;
+  const auto min = _volume.Min() / this->levelIndexCellSize;
+  const auto max = _volume.Max() / this->levelIndexCellSize;
+  for (auto x = static_cast<int64_t>(std::floor(min.X()));
+       x <= static_cast<int64_t>(std::floor(max.X())); ++x)
+  {
+    for (auto y = static_cast<int64_t>(std::floor(min.Y()));
+         y <= static_cast<int64_t>(std::floor(max.Y())); ++y)
+    {
+      for (auto z = static_cast<int64_t>(std::floor(min.Z()));
+           z <= static_cast<int64_t>(std::floor(max.Z())); ++z)
+      {
+        auto cell = this->levelIndex.find(IndexKey(x, y, z));
+        if (cell == this->levelIndex.end())
+          continue;
+        for (const auto &entity : cell->second)
+        {
+          if (found.insert(entity).second)
+            candidates.push_back(entity);
+        }
+      }
+    }
+  }
+  return candidates;
 }
 
 /////////////////////////////////////////////////
@@ -500,6 +612,8 @@ void LevelManager::UpdateLevelsState()
 
   std::vector<Entity> levelsToLoad;
   std::vector<Entity> levelsToUnload;
+  std::set<Entity> predictedLevels;
+  std::set<Entity> innerLevels;
 
   {
     std::lock_guard<std::mutex> lock(this->performerToAddMutex);
@@ -562,66 +676,117 @@ void LevelManager::UpdateLevelsState()
             pose->Data().Pos() - perfBox->Size() / 2,
               pose->Data().Pos() + perfBox->Size() / 2};
 
+          // Estimate the per-step displacement from the previous update
+          // and sweep the performer volume along it, to predict which
+          // levels the performer is heading into.
+          math::Vector3d delta{0, 0, 0};
+          auto prevIt = this->prevPerformerPositions.find(_perfEntity);
+          if (prevIt != this->prevPerformerPositions.end())
+          {
+            delta = pose->Data().Pos() - prevIt->second;
+          }
+          this->prevPerformerPositions[_perfEntity] = pose->Data().Pos();
+
+          const math::Vector3d lookAhead = delta * this->prefetchSteps;
+          math::Vector3d predictedMin = performerVolume.Min();
+          math::Vector3d predictedMax = performerVolume.Max();
+          predictedMin.Min(performerVolume.Min() + lookAhead);
+          predictedMax.Max(performerVolume.Max() + lookAhead);
+          math::AxisAlignedBox predictedVolume{predictedMin, predictedMax};
+
           std::set<Entity> newPerfLevels;
 
-          // loop through levels and check for intersections
-          // Add all levels with intersections to the levelsToLoad even if they
-          // are currently active.
-          this->runner->entityCompMgr.Each<components::Level, components::Pose,
-            components::Geometry,
-            components::LevelBuffer >(
-                [&](const Entity &_entity, const components::Level *,
-                  const components::Pose *_pose,
-                  const components::Geometry *_levelGeometry,
-                  const components::LevelBuffer *_levelBuffer) -> bool
-                {
-                IGN_PROFILE("CheckPerformerAgainstLevel");
-                // Check if the performer is in this level
-                // assume a box for now
-                auto box = _levelGeometry->Data().BoxShape();
-                if (nullptr == box)
-                {
-                ignerr << "Level [" << _entity
-                << "]'s geometry is not a box." << std::endl;
-                return true;
-                }
-                auto buffer = _levelBuffer->Data();
-                auto center = _pose->Data().Pos();
-                math::AxisAlignedBox region{center - box->Size() / 2,
+          // Query the spatial index for levels near this performer and
+          // run the exact intersection tests on those candidates only.
+          // The predicted volume contains the performer volume, so the
+          // candidates cover both the load and the prefetch checks.
+          // Add all levels with intersections to the levelsToLoad even if
+          // they are currently active.
+          for (const Entity &levelEntity :
+              this->LevelsInVolume(predictedVolume))
+          {
+            IGN_PROFILE("CheckPerformerAgainstLevel");
+
+            auto levelPose =
+              this->runner->entityCompMgr.Component<components::Pose>(
+                  levelEntity);
+            auto levelGeometry =
+              this->runner->entityCompMgr.Component<components::Geometry>(
+                  levelEntity);
+            auto levelBuffer =
+              this->runner->entityCompMgr.Component<components::LevelBuffer>(
+                  levelEntity);
+            if (nullptr == levelPose || nullptr == levelGeometry ||
+                nullptr == levelBuffer)
+            {
+              continue;
+            }
+
+            // Check if the performer is in this level
+            // assume a box for now
+            auto box = levelGeometry->Data().BoxShape();
+            if (nullptr == box)
+            {
+              ignerr << "Level [" << levelEntity
+                     << "]'s geometry is not a box." << std::endl;
+              continue;
+            }
+            auto buffer = levelBuffer->Data();
+            auto center = levelPose->Data().Pos();
+            math::AxisAlignedBox region{center - box->Size() / 2,
                 center + box->Size() / 2};
 
-                math::AxisAlignedBox outerRegion{
-                  center - (box->Size() / 2 + buffer),
-                         center + (box->Size() / 2 + buffer)};
-
-                if (region.Intersects(performerVolume))
-                {
-                  newPerfLevels.insert(_entity);
-                  levelsToLoad.push_back(_entity);
-                }
-                else
-                {
-                  // If the level is active, check if the performer is
-                  // outside of the buffer of this level
-                  if (this->IsLevelActive(_entity))
-                  {
-                    if (outerRegion.Intersects(performerVolume))
-                    {
-                      newPerfLevels.insert(_entity);
-                      levelsToLoad.push_back(_entity);
-                      return true;
-                    }
-                    // Otherwise, mark the level to be unloaded
-                    levelsToUnload.push_back(_entity);
-                  }
-                }
-                return true;
-                });
+            math::AxisAlignedBox outerRegion{
+                center - (box->Size() / 2 + buffer),
+                center + (box->Size() / 2 + buffer)};
+
+            if (region.Intersects(performerVolume))
+            {
+              newPerfLevels.insert(levelEntity);
+              levelsToLoad.push_back(levelEntity);
+              innerLevels.insert(levelEntity);
+            }
+            else
+            {
+              // The performer is heading towards this level, prefetch
+              // its entities ahead of the actual crossing.
+              if (predictedVolume.Intersects(region))
+              {
+                predictedLevels.insert(levelEntity);
+              }
+
+              // If the level is active, check if the performer is
+              // still within the buffer of this level
+              if (this->IsLevelActive(levelEntity) &&
+                  outerRegion.Intersects(performerVolume))
+              {
+                newPerfLevels.insert(levelEntity);
+                levelsToLoad.push_back(levelEntity);
+              }
+            }
+          }
 
           *_perfLevels = components::PerformerLevels(newPerfLevels);
 
           return true;
           });
+
+    // Active levels that no performer marked for loading are out of every
+    // performer's reach, so they are unloaded. Candidates that are also in
+    // levelsToLoad are filtered out below. The default level carries no
+    // geometry and is skipped.
+    if (!this->performerMap.empty())
+    {
+      for (const auto &level : this->activeLevels)
+      {
+        if (nullptr != this->runner->entityCompMgr
+                .Component<components::DefaultLevel>(level))
+        {
+          continue;
+        }
+        levelsToUnload.push_back(level);
+      }
+    }
   }
 
   // Sort levelsToLoad and levelsToUnload so as to run std::unique on them.
@@ -700,6 +865,12 @@ void LevelManager::UpdateLevelsState()
     this->UnloadInactiveEntities(entityNamesToUnload);
   }
 
+  // Prefetch levels the performers are predicted to enter soon
+  if (this->useLevels)
+  {
+    this->UpdatePrefetch(predictedLevels, entityNamesMarked);
+  }
+
   // Finally, upadte the list of active levels
   for (const auto &level : levelsToLoad)
   {
@@ -718,6 +889,101 @@ void LevelManager::UpdateLevelsState()
   }
   // Erase from vector
   this->activeLevels.erase(pendingEnd, this->activeLevels.end());
+
+  // Flag entities of levels that are loaded only as buffer zones
+  if (this->useLevels)
+  {
+    this->UpdateBufferedState(innerLevels);
+  }
+}
+
+/////////////////////////////////////////////////
+void LevelManager::UpdateBufferedState(const std::set<Entity> &_innerLevels)
+{
+  IGN_PROFILE("LevelManager::UpdateBufferedState");
+
+  // Gather the names required by levels a performer is actually in, and
+  // the names of levels that are loaded only because of their buffer.
+  std::set<std::string> innerNames;
+  std::set<std::string> buffered;
+  for (const auto &level : this->activeLevels)
+  {
+    auto lvlEntNames = this->runner->entityCompMgr
+        .Component<components::LevelEntityNames>(level);
+    if (nullptr == lvlEntNames)
+      continue;
+
+    // Entities of the default level are always simulated at full rate.
+    bool inner = _innerLevels.find(level) != _innerLevels.end() ||
+        nullptr != this->runner->entityCompMgr
+            .Component<components::DefaultLevel>(level);
+
+    for (const auto &name : lvlEntNames->Data())
+    {
+      if (inner)
+      {
+        innerNames.insert(name);
+      }
+      else if (this->activeEntityNames.find(name) !=
+          this->activeEntityNames.end())
+      {
+        buffered.insert(name);
+      }
+    }
+  }
+
+  // An entity shared with a level a performer is in stays active.
+  for (const auto &name : innerNames)
+  {
+    buffered.erase(name);
+  }
+
+  if (buffered == this->bufferedEntityNames)
+    return;
+
+  // Toggle the flag, subtree included, only for entities whose state
+  // changed in this update.
+  auto updateFlag = [&](const Entity &_entity, const std::string &_name)
+  {
+    bool nowBuffered = buffered.find(_name) != buffered.end();
+    bool wasBuffered = this->bufferedEntityNames.find(_name) !=
+        this->bufferedEntityNames.end();
+    if (nowBuffered == wasBuffered)
+      return;
+
+    for (const auto &descendant :
+        this->runner->entityCompMgr.Descendants(_entity))
+    {
+      this->runner->entityCompMgr.SetEntityLevelBuffered(descendant,
+          nowBuffered);
+    }
+  };
+
+  this->runner->entityCompMgr.Each<components::Model, components::Name>(
+      [&](const Entity &_entity, const components::Model *,
+          const components::Name *_name) -> bool
+      {
+        updateFlag(_entity, _name->Data());
+        return true;
+      });
+
+  this->runner->entityCompMgr.Each<components::Actor, components::Name>(
+      [&](const Entity &_entity, const components::Actor *,
+          const components::Name *_name) -> bool
+      {
+        updateFlag(_entity, _name->Data());
+        return true;
+      });
+
+  this->runner->entityCompMgr.Each<components::Light, components::Name>(
+      [&](const Entity &_entity, const components::Light *,
+          const components::Name *_name) -> bool
+      {
+        updateFlag(_entity, _name->Data());
+        return true;
+      });
+
+  this->bufferedEntityNames = std::move(buffered);
 }
 
 /////////////////////////////////////////////////
@@ -820,6 +1086,88 @@ void LevelManager::UnloadInactiveEntities(
   }
 }
 
+/////////////////////////////////////////////////
+void LevelManager::UpdatePrefetch(const std::set<Entity> &_predictedLevels,
+    const std::set<std::string> &_activeMarked)
+{
+  IGN_PROFILE("LevelManager::UpdatePrefetch");
+
+  // Names needed by the predicted levels
+  std::set<std::string> predictedNames;
+  for (const auto &level : _predictedLevels)
+  {
+    auto lvlEntNames =
+        this->runner->entityCompMgr.Component<components::LevelEntityNames>(
+            level);
+    if (nullptr == lvlEntNames)
+      continue;
+    for (const auto &name : lvlEntNames->Data())
+    {
+      predictedNames.insert(name);
+    }
+  }
+
+  // Entities that became part of an active level are owned by the normal
+  // load / unload cycle from here on.
+  for (const auto &name : _activeMarked)
+  {
+    this->prefetchedNames.erase(name);
+  }
+
+  // Queue predicted entities that are neither loaded nor queued yet
+  for (const auto &name : predictedNames)
+  {
+    if (this->activeEntityNames.find(name) == this->activeEntityNames.end() &&
+        std::find(this->prefetchQueue.begin(), this->prefetchQueue.end(),
+            name) == this->prefetchQueue.end())
+    {
+      this->prefetchQueue.push_back(name);
+    }
+  }
+
+  // Drop queued entities whose level is no longer predicted, e.g. because
+  // the performer changed direction before they were created.
+  this->prefetchQueue.remove_if([&](const std::string &_name)
+      {
+        return predictedNames.find(_name) == predictedNames.end();
+      });
+
+  // Unload prefetched entities that no predicted or active level needs
+  std::set<std::string> namesToDrop;
+  for (const auto &name : this->prefetchedNames)
+  {
+    if (predictedNames.find(name) == predictedNames.end() &&
+        _activeMarked.find(name) == _activeMarked.end())
+    {
+      namesToDrop.insert(name);
+    }
+  }
+  if (!namesToDrop.empty())
+  {
+    this->UnloadInactiveEntities(namesToDrop);
+    for (const auto &name : namesToDrop)
+    {
+      this->prefetchedNames.erase(name);
+    }
+  }
+
+  // Create a small batch per update, spreading the creation cost over the
+  // steps leading up to the crossing instead of paying for the whole
+  // level in the step where the boundary is crossed.
+  std::set<std::string> batch;
+  while (!this->prefetchQueue.empty() &&
+      batch.size() < this->prefetchBatchSize)
+  {
+    batch.insert(this->prefetchQueue.front());
+    this->prefetchQueue.pop_front();
+  }
+  if (!batch.empty())
+  {
+    this->LoadActiveEntities(batch);
+    this->prefetchedNames.insert(batch.begin(), batch.end());
+  }
+}
+
 /////////////////////////////////////////////////
 bool LevelManager::IsLevelActive(const Entity _entity) const
 {
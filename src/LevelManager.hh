@@ -31,6 +31,8 @@
 
 #include <sdf/Element.hh>
 #include <sdf/Geometry.hh>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
 #include <ignition/transport/Node.hh>
 
 #include "ignition/gazebo/config.hh"
@@ -98,6 +100,26 @@ namespace ignition
       private: void UnloadInactiveEntities(
           const std::set<std::string> &_namesToUnload);
 
+      /// \brief Load entities of levels a performer is predicted to enter
+      /// soon, a small batch per update, so the creation cost is spread
+      /// over many steps instead of freezing the step in which the
+      /// boundary is actually crossed. Prefetched entities that no
+      /// predicted or active level needs anymore are unloaded again.
+      /// \param[in] _predictedLevels Levels intersecting the performers'
+      /// predicted volumes but not their current ones.
+      /// \param[in] _activeMarked Names needed by the levels marked for
+      /// loading in this update.
+      private: void UpdatePrefetch(const std::set<Entity> &_predictedLevels,
+          const std::set<std::string> &_activeMarked);
+
+      /// \brief Flag entities that belong only to levels loaded as buffer
+      /// zones, so systems iterating with EachActive skip them. Entities
+      /// of a level some performer is actually in, and entities of the
+      /// default level, are always left active.
+      /// \param[in] _innerLevels Levels whose inner region intersects a
+      /// performer's volume in this update.
+      private: void UpdateBufferedState(const std::set<Entity> &_innerLevels);
+
       /// \brief Read level and performer information from the sdf::World
       /// object
       private: void ReadLevelPerformerInfo();
@@ -125,6 +147,20 @@ namespace ignition
       /// \return True of the level is currently active
       private: bool IsLevelActive(const Entity _entity) const;
 
+      /// \brief Build the uniform grid index over level volumes, buffer
+      /// zones included. Levels don't move during simulation, so this only
+      /// needs to run again if levels are edited.
+      private: void BuildLevelIndex();
+
+      /// \brief Query the level index for levels whose buffered volume may
+      /// intersect the given volume. May return false positives, which the
+      /// caller's exact intersection tests filter out, but never misses a
+      /// level.
+      /// \param[in] _volume Query volume.
+      /// \return Candidate level entities.
+      private: std::vector<Entity> LevelsInVolume(
+          const math::AxisAlignedBox &_volume) const;
+
       /// \brief Service callback to create a new performer.
       /// \param[in] _req Message that contains perfomer information.
       /// \param[out] _rep Reply message, which is set to true when the
@@ -178,6 +214,40 @@ namespace ignition
 
       /// \brief Mutex to protect performersToAdd list.
       private: std::mutex performerToAddMutex;
+
+      /// \brief Position of each performer at the previous update, used to
+      /// estimate its per-step displacement for level prediction.
+      private: std::unordered_map<Entity, math::Vector3d>
+          prevPerformerPositions;
+
+      /// \brief Names of entities queued for prefetching, loaded a batch
+      /// per update.
+      private: std::list<std::string> prefetchQueue;
+
+      /// \brief Names of entities loaded through prefetching whose levels
+      /// haven't become active yet.
+      private: std::set<std::string> prefetchedNames;
+
+      /// \brief Names of entities currently flagged as buffered, i.e.
+      /// loaded only because of a level's buffer zone.
+      private: std::set<std::string> bufferedEntityNames;
+
+      /// \brief Uniform grid over level volumes: each cell maps to the
+      /// levels whose buffered volume covers it. Cell lists may collide
+      /// across distant cells, which only costs extra exact tests.
+      private: std::unordered_map<uint64_t, std::vector<Entity>> levelIndex;
+
+      /// \brief Edge length of one level index cell. Zero until the index
+      /// is built or when there are no levels.
+      private: double levelIndexCellSize{0.0};
+
+      /// \brief Number of updates of look-ahead when predicting which
+      /// levels a performer is heading into.
+      private: double prefetchSteps{200};
+
+      /// \brief Maximum number of entities created per update while
+      /// prefetching.
+      private: size_t prefetchBatchSize{1};
     };
     }
   }
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "ignition/gazebo/detail/MpscQueue.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(MpscQueueTest, DrainEmpty)
+{
+  detail::MpscQueue<int> queue;
+  EXPECT_TRUE(queue.DrainAll().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(MpscQueueTest, FifoOrder)
+{
+  detail::MpscQueue<int> queue;
+  for (int i = 0; i < 10; ++i)
+    queue.Push(i);
+
+  auto values = queue.DrainAll();
+  ASSERT_EQ(10u, values.size());
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(i, values[i]);
+
+  // The queue is empty once drained.
+  EXPECT_TRUE(queue.DrainAll().empty());
+
+  // And usable again afterwards.
+  queue.Push(42);
+  values = queue.DrainAll();
+  ASSERT_EQ(1u, values.size());
+  EXPECT_EQ(42, values[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(MpscQueueTest, MoveOnlyValues)
+{
+  detail::MpscQueue<std::unique_ptr<int>> queue;
+  queue.Push(std::make_unique<int>(1));
+  queue.Push(std::make_unique<int>(2));
+
+  auto values = queue.DrainAll();
+  ASSERT_EQ(2u, values.size());
+  EXPECT_EQ(1, *values[0]);
+  EXPECT_EQ(2, *values[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(MpscQueueTest, ConcurrentProducers)
+{
+  const unsigned int threadCount{4};
+  const int perThread{1000};
+
+  detail::MpscQueue<int> queue;
+  std::vector<std::thread> producers;
+
+  for (unsigned int t = 0; t < threadCount; ++t)
+  {
+    producers.push_back(std::thread([&queue, t]()
+    {
+      for (int i = 0; i < perThread; ++i)
+        queue.Push(t * perThread + i);
+    }));
+  }
+
+  // Drain concurrently with the producers, like the stepping thread does.
+  std::set<int> seen;
+  while (seen.size() < threadCount * perThread)
+  {
+    for (const int value : queue.DrainAll())
+    {
+      // Every value arrives exactly once.
+      EXPECT_TRUE(seen.insert(value).second);
+    }
+  }
+
+  for (auto &producer : producers)
+    producer.join();
+
+  EXPECT_EQ(threadCount * perThread, seen.size());
+  EXPECT_TRUE(queue.DrainAll().empty());
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/gazebo/PluginConfigCache.hh"
+
+#include <mutex>
+#include <unordered_map>
+
+using namespace ignition;
+using namespace gazebo;
+
+namespace
+{
+/// \brief The cache storage, shared by every world and every system
+/// plugin library in the process.
+struct CacheStorage
+{
+  /// \brief Protects entries.
+  std::mutex mutex;
+
+  /// \brief Cached configurations by key.
+  std::unordered_map<std::string, std::shared_ptr<const void>> entries;
+};
+
+//////////////////////////////////////////////////
+CacheStorage &Storage()
+{
+  static CacheStorage storage;
+  return storage;
+}
+}  // namespace
+
+//////////////////////////////////////////////////
+void PluginConfigCache::Clear()
+{
+  auto &storage = Storage();
+  std::lock_guard<std::mutex> lock(storage.mutex);
+  storage.entries.clear();
+}
+
+//////////////////////////////////////////////////
+std::string PluginConfigCache::Key(const char *_type,
+    const std::shared_ptr<const sdf::Element> &_sdf)
+{
+  // The canonical text form covers the element's attributes and its
+  // whole child tree, so any difference between two plugin elements
+  // produces a different key. The type name separates systems that
+  // happen to share an element, and a newline can't appear in either
+  // part alone.
+  std::string key{_type};
+  key += '\n';
+  if (nullptr != _sdf)
+    key += _sdf->ToString("");
+  return key;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const void> PluginConfigCache::Lookup(
+    const std::string &_key)
+{
+  auto &storage = Storage();
+  std::lock_guard<std::mutex> lock(storage.mutex);
+  auto iter = storage.entries.find(_key);
+  return iter != storage.entries.end() ? iter->second : nullptr;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const void> PluginConfigCache::Store(
+    const std::string &_key, std::shared_ptr<const void> _config)
+{
+  auto &storage = Storage();
+  std::lock_guard<std::mutex> lock(storage.mutex);
+  // emplace keeps an existing entry, so parsers that raced on the same
+  // element all end up sharing whichever result was stored first.
+  return storage.entries.emplace(_key, std::move(_config)).first->second;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include <sdf/Element.hh>
+
+#include "ignition/gazebo/PluginConfigCache.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+namespace
+{
+/// \brief An example parsed configuration.
+struct TestParams
+{
+  double gain{0.0};
+};
+
+/// \brief Another configuration type sharing the same element.
+struct OtherParams
+{
+  double gain{0.0};
+};
+
+/// \brief Build a plugin element with a single <gain> child.
+/// \param[in] _gain Value of the child element.
+/// \return The plugin element.
+std::shared_ptr<sdf::Element> PluginElement(const std::string &_gain)
+{
+  auto elem = std::make_shared<sdf::Element>();
+  elem->SetName("plugin");
+
+  auto gain = std::make_shared<sdf::Element>();
+  gain->SetName("gain");
+  gain->AddValue("double", _gain, false, "");
+  elem->InsertElement(gain);
+
+  return elem;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+TEST(PluginConfigCacheTest, ParseOncePerElement)
+{
+  PluginConfigCache::Clear();
+
+  auto elem = PluginElement("1.5");
+  int parseCount{0};
+  auto parse = [&]()
+  {
+    ++parseCount;
+    TestParams params;
+    params.gain = elem->Get<double>("gain", params.gain).first;
+    return params;
+  };
+
+  auto first = PluginConfigCache::Get<TestParams>(elem, parse);
+  ASSERT_NE(nullptr, first);
+  EXPECT_DOUBLE_EQ(1.5, first->gain);
+  EXPECT_EQ(1, parseCount);
+
+  // A second instance with the identical element shares the object.
+  auto second = PluginConfigCache::Get<TestParams>(PluginElement("1.5"),
+      parse);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(1, parseCount);
+}
+
+/////////////////////////////////////////////////
+TEST(PluginConfigCacheTest, DistinctElementsParseSeparately)
+{
+  PluginConfigCache::Clear();
+
+  int parseCount{0};
+  auto parseWith = [&](const std::shared_ptr<sdf::Element> &_elem)
+  {
+    return PluginConfigCache::Get<TestParams>(_elem, [&]()
+    {
+      ++parseCount;
+      TestParams params;
+      params.gain = _elem->Get<double>("gain", params.gain).first;
+      return params;
+    });
+  };
+
+  auto first = parseWith(PluginElement("1.0"));
+  auto second = parseWith(PluginElement("2.0"));
+  EXPECT_EQ(2, parseCount);
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_DOUBLE_EQ(1.0, first->gain);
+  EXPECT_DOUBLE_EQ(2.0, second->gain);
+}
+
+/////////////////////////////////////////////////
+TEST(PluginConfigCacheTest, TypesDoNotCollide)
+{
+  PluginConfigCache::Clear();
+
+  auto elem = PluginElement("3.0");
+
+  auto params = PluginConfigCache::Get<TestParams>(elem, [&]()
+  {
+    TestParams p;
+    p.gain = elem->Get<double>("gain", p.gain).first;
+    return p;
+  });
+
+  // The same element keyed under a different configuration type parses
+  // again instead of aliasing the TestParams entry.
+  int otherParsed{0};
+  auto other = PluginConfigCache::Get<OtherParams>(elem, [&]()
+  {
+    ++otherParsed;
+    OtherParams p;
+    p.gain = elem->Get<double>("gain", p.gain).first;
+    return p;
+  });
+  EXPECT_EQ(1, otherParsed);
+  EXPECT_DOUBLE_EQ(params->gain, other->gain);
+}
+
+/////////////////////////////////////////////////
+TEST(PluginConfigCacheTest, ClearForgetsEntries)
+{
+  PluginConfigCache::Clear();
+
+  auto elem = PluginElement("4.0");
+  int parseCount{0};
+  auto parse = [&]()
+  {
+    ++parseCount;
+    TestParams params;
+    params.gain = elem->Get<double>("gain", params.gain).first;
+    return params;
+  };
+
+  PluginConfigCache::Get<TestParams>(elem, parse);
+  PluginConfigCache::Clear();
+  PluginConfigCache::Get<TestParams>(elem, parse);
+  EXPECT_EQ(2, parseCount);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/Rng.hh"
+
+#include <cmath>
+
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Rand.hh>
+
+using namespace ignition;
+using namespace gazebo;
+
+//////////////////////////////////////////////////
+/// \brief Scramble a value with the splitmix64 finalizer. A single pass
+/// diffuses every input bit into every output bit, which is all that's
+/// needed to turn the structured (seed, entity, iteration, draw) counter
+/// into uniform random bits.
+/// \param[in] _x Value to scramble.
+/// \return The scrambled value.
+static uint64_t Mix(uint64_t _x)
+{
+  _x += 0x9e3779b97f4a7c15ull;
+  _x = (_x ^ (_x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  _x = (_x ^ (_x >> 27)) * 0x94d049bb133111ebull;
+  return _x ^ (_x >> 31);
+}
+
+//////////////////////////////////////////////////
+Rng::Rng(const UpdateInfo &_info, const Entity _entity)
+  : Rng(math::Rand::Seed(), _entity, _info.iterations)
+{
+}
+
+//////////////////////////////////////////////////
+Rng::Rng(const uint64_t _seed, const Entity _entity,
+    const uint64_t _iteration)
+{
+  // Chain the inputs through the mixer so each one permutes the whole
+  // key, rather than just its own bit range.
+  this->key = Mix(Mix(Mix(_seed) + _entity) + _iteration);
+}
+
+//////////////////////////////////////////////////
+uint64_t Rng::NextUInt64()
+{
+  return Mix(this->key + this->drawCount++);
+}
+
+//////////////////////////////////////////////////
+double Rng::DblUniform(const double _min, const double _max)
+{
+  // The top 53 bits of the draw become the mantissa of a double in
+  // [0, 1).
+  const double unit = static_cast<double>(this->NextUInt64() >> 11) *
+      (1.0 / 9007199254740992.0);
+  return _min + unit * (_max - _min);
+}
+
+//////////////////////////////////////////////////
+double Rng::DblNormal(const double _mean, const double _stdDev)
+{
+  // Box-Muller transform over two uniform draws.
+  const double u1 = 1.0 - this->DblUniform();
+  const double u2 = this->DblUniform();
+  return _mean + _stdDev * std::sqrt(-2.0 * std::log(u1)) *
+      std::cos(2.0 * IGN_PI * u2);
+}
+
+//////////////////////////////////////////////////
+int Rng::IntUniform(const int _min, const int _max)
+{
+  if (_max < _min)
+    return _min;
+
+  const uint64_t range =
+      static_cast<uint64_t>(static_cast<int64_t>(_max) - _min) + 1u;
+  return _min + static_cast<int>(this->NextUInt64() % range);
+}
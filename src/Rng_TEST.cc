@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "ignition/gazebo/Rng.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(RngTest, Deterministic)
+{
+  Rng rngA(42u, 7u, 100u);
+  Rng rngB(42u, 7u, 100u);
+
+  // Identical inputs replay the identical sequence.
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(rngA.NextUInt64(), rngB.NextUInt64());
+}
+
+/////////////////////////////////////////////////
+TEST(RngTest, InputsDecorrelate)
+{
+  Rng base(42u, 7u, 100u);
+  Rng otherSeed(43u, 7u, 100u);
+  Rng otherEntity(42u, 8u, 100u);
+  Rng otherIteration(42u, 7u, 101u);
+
+  const uint64_t first = base.NextUInt64();
+  EXPECT_NE(first, otherSeed.NextUInt64());
+  EXPECT_NE(first, otherEntity.NextUInt64());
+  EXPECT_NE(first, otherIteration.NextUInt64());
+}
+
+/////////////////////////////////////////////////
+TEST(RngTest, FromUpdateInfo)
+{
+  UpdateInfo info;
+  info.iterations = 123u;
+
+  Rng rngA(info, 5u);
+  Rng rngB(info, 5u);
+  EXPECT_EQ(rngA.NextUInt64(), rngB.NextUInt64());
+
+  // A different entity on the same iteration draws different numbers.
+  Rng rngC(info, 6u);
+  Rng rngD(info, 5u);
+  rngD.NextUInt64();
+  EXPECT_NE(rngC.NextUInt64(), rngD.NextUInt64());
+}
+
+/////////////////////////////////////////////////
+TEST(RngTest, DblUniform)
+{
+  Rng rng(1u, 2u, 3u);
+
+  double sum = 0.0;
+  const int samples = 10000;
+  for (int i = 0; i < samples; ++i)
+  {
+    const double value = rng.DblUniform(-2.0, 2.0);
+    EXPECT_GE(value, -2.0);
+    EXPECT_LT(value, 2.0);
+    sum += value;
+  }
+
+  // The mean converges on the middle of the range.
+  EXPECT_NEAR(0.0, sum / samples, 0.1);
+}
+
+/////////////////////////////////////////////////
+TEST(RngTest, DblNormal)
+{
+  Rng rng(1u, 2u, 3u);
+
+  double sum = 0.0;
+  double sumSq = 0.0;
+  const int samples = 10000;
+  for (int i = 0; i < samples; ++i)
+  {
+    const double value = rng.DblNormal(5.0, 2.0);
+    sum += value;
+    sumSq += value * value;
+  }
+
+  const double mean = sum / samples;
+  const double stdDev = std::sqrt(sumSq / samples - mean * mean);
+  EXPECT_NEAR(5.0, mean, 0.1);
+  EXPECT_NEAR(2.0, stdDev, 0.1);
+}
+
+/////////////////////////////////////////////////
+TEST(RngTest, IntUniform)
+{
+  Rng rng(1u, 2u, 3u);
+
+  bool sawMin{false};
+  bool sawMax{false};
+  for (int i = 0; i < 1000; ++i)
+  {
+    const int value = rng.IntUniform(-3, 3);
+    EXPECT_GE(value, -3);
+    EXPECT_LE(value, 3);
+    sawMin = sawMin || value == -3;
+    sawMax = sawMax || value == 3;
+  }
+  EXPECT_TRUE(sawMin);
+  EXPECT_TRUE(sawMax);
+
+  // Degenerate ranges collapse to the minimum.
+  EXPECT_EQ(9, rng.IntUniform(9, 9));
+  EXPECT_EQ(9, rng.IntUniform(9, 8));
+}
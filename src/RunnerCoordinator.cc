@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+
+#include "RunnerCoordinator.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+RunnerCoordinator::RunnerCoordinator(std::size_t _count)
+  : active(_count, true), debt(_count, Duration::zero()),
+    deadline(_count, Duration::zero())
+{
+}
+
+/////////////////////////////////////////////////
+void RunnerCoordinator::BeginStep(std::size_t _id)
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->cv.wait(lock, [this, _id]
+      {
+        return this->turn == _id || !this->active[_id];
+      });
+}
+
+/////////////////////////////////////////////////
+void RunnerCoordinator::EndStep(std::size_t _id, const Duration &_elapsed,
+    const Duration &_deadline)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->deadline[_id] = _deadline;
+  if (_elapsed > _deadline)
+    this->debt[_id] += _elapsed - _deadline;
+  if (this->turn == _id)
+    this->AdvanceTurn();
+}
+
+/////////////////////////////////////////////////
+void RunnerCoordinator::Release(std::size_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->active[_id] = false;
+  if (this->turn == _id)
+    this->AdvanceTurn();
+  else
+    this->cv.notify_all();
+}
+
+/////////////////////////////////////////////////
+void RunnerCoordinator::AdvanceTurn()
+{
+  const std::size_t count = this->active.size();
+
+  // First pass: hand the turn to the next active slot that is not in
+  // debt. A slot in debt repays one deadline by sitting the rotation
+  // out.
+  std::size_t fallback = count;
+  for (std::size_t i = 1; i <= count; ++i)
+  {
+    const std::size_t slot = (this->turn + i) % count;
+    if (!this->active[slot])
+      continue;
+    if (this->debt[slot] > Duration::zero())
+    {
+      this->debt[slot] -= std::min(this->debt[slot], this->deadline[slot]);
+      if (fallback == count)
+        fallback = slot;
+      continue;
+    }
+    this->turn = slot;
+    this->cv.notify_all();
+    return;
+  }
+
+  // Every active slot was a debtor (or none is left): take the first
+  // active one anyway so the rotation never stalls.
+  if (fallback != count)
+    this->turn = fallback;
+  this->cv.notify_all();
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_RUNNERCOORDINATOR_HH_
+#define IGNITION_GAZEBO_RUNNERCOORDINATOR_HH_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "ignition/gazebo/config.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \brief Schedules the step loops of several simulation runners in
+    /// round-robin order with deadline accounting.
+    ///
+    /// Each runner is given a slot index and brackets every step with
+    /// BeginStep and EndStep. BeginStep blocks until it is the runner's
+    /// turn, so at most one runner steps at a time and each gets the
+    /// machine in a predictable rotation. A runner whose step overruns
+    /// its deadline accumulates debt; while in debt it is skipped one
+    /// rotation per deadline of debt, throttling a heavy world without
+    /// starving the light ones.
+    class RunnerCoordinator
+    {
+      /// \brief Duration used for deadlines and debt.
+      public: using Duration = std::chrono::steady_clock::duration;
+
+      /// \brief Constructor.
+      /// \param[in] _count Number of runner slots.
+      public: explicit RunnerCoordinator(std::size_t _count);
+
+      /// \brief Block until it is the given runner's turn to step.
+      /// \param[in] _id Slot index of the runner.
+      public: void BeginStep(std::size_t _id);
+
+      /// \brief Report a finished step and pass the turn on.
+      /// \param[in] _id Slot index of the runner.
+      /// \param[in] _elapsed Wall-clock duration of the step.
+      /// \param[in] _deadline Duration the step was budgeted, typically
+      /// the runner's update period.
+      public: void EndStep(std::size_t _id, const Duration &_elapsed,
+                  const Duration &_deadline);
+
+      /// \brief Withdraw a runner from the rotation, for instance when
+      /// its run loop exits. The remaining runners keep rotating.
+      /// \param[in] _id Slot index of the runner.
+      public: void Release(std::size_t _id);
+
+      /// \brief Pass the turn to the next runnable slot. The caller
+      /// must hold this->mutex.
+      private: void AdvanceTurn();
+
+      /// \brief Protects all members below.
+      private: std::mutex mutex;
+
+      /// \brief Signaled whenever the turn changes.
+      private: std::condition_variable cv;
+
+      /// \brief Slot index whose turn it is to step.
+      private: std::size_t turn{0};
+
+      /// \brief Whether each slot is still in the rotation.
+      private: std::vector<bool> active;
+
+      /// \brief Accumulated deadline overrun of each slot.
+      private: std::vector<Duration> debt;
+
+      /// \brief Most recent deadline reported by each slot, used as the
+      /// debt repaid by sitting out one rotation.
+      private: std::vector<Duration> deadline;
+    };
+    }
+  }
+}
+#endif
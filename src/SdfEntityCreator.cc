@@ -15,6 +15,12 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Profiler.hh>
 
@@ -84,6 +90,18 @@ class ignition::gazebo::SdfEntityCreatorPrivate
   /// \brief Keep track of new visuals being added, so we load their plugins
   /// only after we have their scoped name.
   public: std::map<Entity, sdf::ElementPtr> newVisuals;
+
+  /// \brief Look up a pose resolved by the parallel prepass over model
+  /// subtrees, falling back to resolving it in place.
+  /// \param[in] _key Address of the SDF DOM object.
+  /// \param[in] _semPose Semantic pose of the object.
+  /// \return Resolved pose.
+  public: math::Pose3d CachedPose(const void *_key,
+      const sdf::SemanticPose &_semPose);
+
+  /// \brief Poses resolved ahead of time, keyed by the address of their
+  /// SDF DOM object. Only populated while creating a world's entities.
+  public: std::unordered_map<const void *, math::Pose3d> resolvedPoses;
 };
 
 using namespace ignition;
@@ -104,6 +122,69 @@ static math::Pose3d ResolveSdfPose(const sdf::SemanticPose &_semPose)
   return pose;
 }
 
+/////////////////////////////////////////////////
+math::Pose3d SdfEntityCreatorPrivate::CachedPose(const void *_key,
+    const sdf::SemanticPose &_semPose)
+{
+  auto it = this->resolvedPoses.find(_key);
+  if (it != this->resolvedPoses.end())
+    return it->second;
+  return ResolveSdfPose(_semPose);
+}
+
+/////////////////////////////////////////////////
+/// \brief Resolve all poses in a model subtree into a cache keyed by the
+/// address of the SDF DOM object. This only reads the SDF DOM, so
+/// independent subtrees can be resolved concurrently.
+/// \param[in] _model Model subtree to resolve.
+/// \param[out] _out Cache to resolve into.
+static void ResolveModelSubtreePoses(const sdf::Model *_model,
+    std::unordered_map<const void *, math::Pose3d> &_out)
+{
+  _out[_model] = ResolveSdfPose(_model->SemanticPose());
+
+  for (uint64_t linkIndex = 0; linkIndex < _model->LinkCount(); ++linkIndex)
+  {
+    const sdf::Link *link = _model->LinkByIndex(linkIndex);
+    _out[link] = ResolveSdfPose(link->SemanticPose());
+
+    for (uint64_t visualIndex = 0; visualIndex < link->VisualCount();
+        ++visualIndex)
+    {
+      const sdf::Visual *visual = link->VisualByIndex(visualIndex);
+      _out[visual] = ResolveSdfPose(visual->SemanticPose());
+    }
+
+    for (uint64_t collisionIndex = 0; collisionIndex < link->CollisionCount();
+        ++collisionIndex)
+    {
+      const sdf::Collision *collision = link->CollisionByIndex(collisionIndex);
+      _out[collision] = ResolveSdfPose(collision->SemanticPose());
+    }
+
+    for (uint64_t lightIndex = 0; lightIndex < link->LightCount();
+        ++lightIndex)
+    {
+      const sdf::Light *light = link->LightByIndex(lightIndex);
+      _out[light] = ResolveSdfPose(light->SemanticPose());
+    }
+
+    for (uint64_t sensorIndex = 0; sensorIndex < link->SensorCount();
+        ++sensorIndex)
+    {
+      const sdf::Sensor *sensor = link->SensorByIndex(sensorIndex);
+      _out[sensor] = ResolveSdfPose(sensor->SemanticPose());
+    }
+  }
+
+  for (uint64_t jointIndex = 0; jointIndex < _model->JointCount();
+      ++jointIndex)
+  {
+    const sdf::Joint *joint = _model->JointByIndex(jointIndex);
+    _out[joint] = ResolveSdfPose(joint->SemanticPose());
+  }
+}
+
 //////////////////////////////////////////////////
 SdfEntityCreator::SdfEntityCreator(EntityComponentManager &_ecm,
           EventManager &_eventManager)
@@ -146,8 +227,8 @@ Entity SdfEntityCreator::CreateEntities(const sdf::World *_world)
   Entity worldEntity = this->dataPtr->ecm->CreateEntity();
 
   // World components
-  this->dataPtr->ecm->CreateComponent(worldEntity, components::World());
-  this->dataPtr->ecm->CreateComponent(worldEntity,
+  this->dataPtr->ecm->CreateComponents(worldEntity,
+      components::World(),
       components::Name(_world->Name()));
 
   // scene
@@ -164,6 +245,36 @@ Entity SdfEntityCreator::CreateEntities(const sdf::World *_world)
         components::Atmosphere(*_world->Atmosphere()));
   }
 
+  // Resolve the poses of all model subtrees on a worker pool before
+  // committing anything to the ECM. Pose resolution only reads the SDF
+  // DOM and dominates the per-model cost on big worlds; the commits below
+  // then run in the usual deterministic order.
+  if (_world->ModelCount() > 1u)
+  {
+    auto poolSize = std::min<uint64_t>(_world->ModelCount(),
+        std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::unordered_map<const void *, math::Pose3d>>
+        resolved(poolSize);
+    std::vector<std::thread> workers;
+    std::atomic<uint64_t> nextModel{0u};
+    for (uint64_t w = 0; w < poolSize; ++w)
+    {
+      workers.push_back(std::thread([&, w]()
+          {
+            uint64_t modelIndex;
+            while ((modelIndex = nextModel++) < _world->ModelCount())
+            {
+              ResolveModelSubtreePoses(_world->ModelByIndex(modelIndex),
+                  resolved[w]);
+            }
+          }));
+    }
+    for (auto &worker : workers)
+      worker.join();
+    for (const auto &part : resolved)
+      this->dataPtr->resolvedPoses.insert(part.begin(), part.end());
+  }
+
   // Models
   for (uint64_t modelIndex = 0; modelIndex < _world->ModelCount();
       ++modelIndex)
@@ -172,8 +283,14 @@ Entity SdfEntityCreator::CreateEntities(const sdf::World *_world)
     auto modelEntity = this->CreateEntities(model);
 
     this->SetParent(modelEntity, worldEntity);
+
+    // Report load progress so orchestration can track readiness
+    this->dataPtr->eventManager->Emit<events::WorldLoadProgress>(
+        modelIndex + 1, _world->ModelCount());
   }
 
+  this->dataPtr->resolvedPoses.clear();
+
   // Actors
   for (uint64_t actorIndex = 0; actorIndex < _world->ActorCount();
       ++actorIndex)
@@ -194,12 +311,9 @@ Entity SdfEntityCreator::CreateEntities(const sdf::World *_world)
     this->SetParent(lightEntity, worldEntity);
   }
 
-  // Gravity
-  this->dataPtr->ecm->CreateComponent(worldEntity,
-      components::Gravity(_world->Gravity()));
-
-  // MagneticField
-  this->dataPtr->ecm->CreateComponent(worldEntity,
+  // Gravity and MagneticField
+  this->dataPtr->ecm->CreateComponents(worldEntity,
+      components::Gravity(_world->Gravity()),
       components::MagneticField(_world->MagneticField()));
 
   this->dataPtr->eventManager->Emit<events::LoadPlugins>(worldEntity,
@@ -221,19 +335,15 @@ Entity SdfEntityCreator::CreateEntities(const sdf::Model *_model)
   Entity modelEntity = this->dataPtr->ecm->CreateEntity();
 
   // Components
-  this->dataPtr->ecm->CreateComponent(modelEntity, components::Model());
-  this->dataPtr->ecm->CreateComponent(modelEntity,
-      components::Pose(ResolveSdfPose(_model->SemanticPose())));
-  this->dataPtr->ecm->CreateComponent(modelEntity,
-      components::Name(_model->Name()));
-  this->dataPtr->ecm->CreateComponent(modelEntity,
-      components::Static(_model->Static()));
-  this->dataPtr->ecm->CreateComponent(
-      modelEntity, components::WindMode(_model->EnableWind()));
-  this->dataPtr->ecm->CreateComponent(
-      modelEntity, components::SelfCollide(_model->SelfCollide()));
-  this->dataPtr->ecm->CreateComponent(
-      modelEntity, components::SourceFilePath(_model->Element()->FilePath()));
+  this->dataPtr->ecm->CreateComponents(modelEntity,
+      components::Model(),
+      components::Pose(this->dataPtr->CachedPose(_model,
+          _model->SemanticPose())),
+      components::Name(_model->Name()),
+      components::Static(_model->Static()),
+      components::WindMode(_model->EnableWind()),
+      components::SelfCollide(_model->SelfCollide()),
+      components::SourceFilePath(_model->Element()->FilePath()));
 
   // NOTE: Pose components of links, visuals, and collisions are expressed in
   // the parent frame until we get frames working.
@@ -305,10 +415,9 @@ Entity SdfEntityCreator::CreateEntities(const sdf::Actor *_actor)
   Entity actorEntity = this->dataPtr->ecm->CreateEntity();
 
   // Components
-  this->dataPtr->ecm->CreateComponent(actorEntity, components::Actor(*_actor));
-  this->dataPtr->ecm->CreateComponent(actorEntity,
-      components::Pose(_actor->RawPose()));
-  this->dataPtr->ecm->CreateComponent(actorEntity,
+  this->dataPtr->ecm->CreateComponents(actorEntity,
+      components::Actor(*_actor),
+      components::Pose(_actor->RawPose()),
       components::Name(_actor->Name()));
 
   // Actor plugins
@@ -327,10 +436,10 @@ Entity SdfEntityCreator::CreateEntities(const sdf::Light *_light)
   Entity lightEntity = this->dataPtr->ecm->CreateEntity();
 
   // Components
-  this->dataPtr->ecm->CreateComponent(lightEntity, components::Light(*_light));
-  this->dataPtr->ecm->CreateComponent(lightEntity,
-      components::Pose(ResolveSdfPose(_light->SemanticPose())));
-  this->dataPtr->ecm->CreateComponent(lightEntity,
+  this->dataPtr->ecm->CreateComponents(lightEntity,
+      components::Light(*_light),
+      components::Pose(this->dataPtr->CachedPose(_light,
+          _light->SemanticPose())),
       components::Name(_light->Name()));
 
   return lightEntity;
@@ -345,13 +454,11 @@ Entity SdfEntityCreator::CreateEntities(const sdf::Link *_link)
   Entity linkEntity = this->dataPtr->ecm->CreateEntity();
 
   // Components
-  this->dataPtr->ecm->CreateComponent(linkEntity, components::Link());
-
-  this->dataPtr->ecm->CreateComponent(linkEntity,
-      components::Pose(ResolveSdfPose(_link->SemanticPose())));
-  this->dataPtr->ecm->CreateComponent(linkEntity,
-      components::Name(_link->Name()));
-  this->dataPtr->ecm->CreateComponent(linkEntity,
+  this->dataPtr->ecm->CreateComponents(linkEntity,
+      components::Link(),
+      components::Pose(this->dataPtr->CachedPose(_link,
+          _link->SemanticPose())),
+      components::Name(_link->Name()),
       components::Inertial(_link->Inertial()));
 
   if (_link->EnableWind())
@@ -412,9 +519,8 @@ Entity SdfEntityCreator::CreateEntities(const sdf::Joint *_joint)
   Entity jointEntity = this->dataPtr->ecm->CreateEntity();
 
   // Components
-  this->dataPtr->ecm->CreateComponent(jointEntity,
-      components::Joint());
-  this->dataPtr->ecm->CreateComponent(jointEntity,
+  this->dataPtr->ecm->CreateComponents(jointEntity,
+      components::Joint(),
       components::JointType(_joint->Type()));
 
   if (_joint->Axis(0))
@@ -429,15 +535,12 @@ Entity SdfEntityCreator::CreateEntities(const sdf::Joint *_joint)
         components::JointAxis2(*_joint->Axis(1)));
   }
 
-  this->dataPtr->ecm->CreateComponent(jointEntity,
-      components::Pose(ResolveSdfPose(_joint->SemanticPose())));
-  this->dataPtr->ecm->CreateComponent(jointEntity ,
-      components::Name(_joint->Name()));
-  this->dataPtr->ecm->CreateComponent(jointEntity ,
-      components::ThreadPitch(_joint->ThreadPitch()));
-  this->dataPtr->ecm->CreateComponent(jointEntity,
-      components::ParentLinkName(_joint->ParentLinkName()));
-  this->dataPtr->ecm->CreateComponent(jointEntity,
+  this->dataPtr->ecm->CreateComponents(jointEntity,
+      components::Pose(this->dataPtr->CachedPose(_joint,
+          _joint->SemanticPose())),
+      components::Name(_joint->Name()),
+      components::ThreadPitch(_joint->ThreadPitch()),
+      components::ParentLinkName(_joint->ParentLinkName()),
       components::ChildLinkName(_joint->ChildLinkName()));
 
   return jointEntity;
@@ -452,16 +555,13 @@ Entity SdfEntityCreator::CreateEntities(const sdf::Visual *_visual)
   Entity visualEntity = this->dataPtr->ecm->CreateEntity();
 
   // Components
-  this->dataPtr->ecm->CreateComponent(visualEntity, components::Visual());
-  this->dataPtr->ecm->CreateComponent(visualEntity,
-      components::Pose(ResolveSdfPose(_visual->SemanticPose())));
-  this->dataPtr->ecm->CreateComponent(visualEntity,
-      components::Name(_visual->Name()));
-  this->dataPtr->ecm->CreateComponent(visualEntity,
-      components::CastShadows(_visual->CastShadows()));
-  this->dataPtr->ecm->CreateComponent(visualEntity,
-      components::Transparency(_visual->Transparency()));
-  this->dataPtr->ecm->CreateComponent(visualEntity,
+  this->dataPtr->ecm->CreateComponents(visualEntity,
+      components::Visual(),
+      components::Pose(this->dataPtr->CachedPose(_visual,
+          _visual->SemanticPose())),
+      components::Name(_visual->Name()),
+      components::CastShadows(_visual->CastShadows()),
+      components::Transparency(_visual->Transparency()),
       components::VisibilityFlags(_visual->VisibilityFlags()));
 
   if (_visual->Geom())
@@ -493,11 +593,10 @@ Entity SdfEntityCreator::CreateEntities(const sdf::Collision *_collision)
   Entity collisionEntity = this->dataPtr->ecm->CreateEntity();
 
   // Components
-  this->dataPtr->ecm->CreateComponent(collisionEntity,
-      components::Collision());
-  this->dataPtr->ecm->CreateComponent(collisionEntity,
-      components::Pose(ResolveSdfPose(_collision->SemanticPose())));
-  this->dataPtr->ecm->CreateComponent(collisionEntity,
+  this->dataPtr->ecm->CreateComponents(collisionEntity,
+      components::Collision(),
+      components::Pose(this->dataPtr->CachedPose(_collision,
+          _collision->SemanticPose())),
       components::Name(_collision->Name()));
 
   if (_collision->Geom())
@@ -521,11 +620,10 @@ Entity SdfEntityCreator::CreateEntities(const sdf::Sensor *_sensor)
   Entity sensorEntity = this->dataPtr->ecm->CreateEntity();
 
   // Components
-  this->dataPtr->ecm->CreateComponent(sensorEntity,
-      components::Sensor());
-  this->dataPtr->ecm->CreateComponent(sensorEntity,
-      components::Pose(ResolveSdfPose(_sensor->SemanticPose())));
-  this->dataPtr->ecm->CreateComponent(sensorEntity,
+  this->dataPtr->ecm->CreateComponents(sensorEntity,
+      components::Sensor(),
+      components::Pose(this->dataPtr->CachedPose(_sensor,
+          _sensor->SemanticPose())),
       components::Name(_sensor->Name()));
 
   if (_sensor->Type() == sdf::SensorType::CAMERA)
@@ -14,7 +14,11 @@
  * limitations under the License.
  *
  */
+#include <cstdint>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_set>
 
 #include <sdf/sdf.hh>
 
@@ -235,16 +239,41 @@ namespace sdf_generator
     }
   }
 
+  /////////////////////////////////////////////////
+  /// \brief Combine a string into a running FNV-1a checksum.
+  /// \param[in, out] _hash Checksum to update.
+  /// \param[in] _data String to fold into the checksum.
+  static void hashInto(uint64_t &_hash, const std::string &_data)
+  {
+    for (const unsigned char c : _data)
+    {
+      _hash ^= c;
+      _hash *= 0x100000001b3u;
+    }
+  }
+
   /////////////////////////////////////////////////
   std::optional<std::string> generateWorld(
       const EntityComponentManager &_ecm, const Entity &_entity,
       const IncludeUriMap &_includeUriMap,
       const msgs::SdfGeneratorConfig &_config)
+  {
+    WorldGenCache cache;
+    return generateWorld(_ecm, _entity, cache, _includeUriMap, _config);
+  }
+
+  /////////////////////////////////////////////////
+  std::optional<std::string> generateWorld(
+      const EntityComponentManager &_ecm, const Entity &_entity,
+      WorldGenCache &_cache,
+      const IncludeUriMap &_includeUriMap,
+      const msgs::SdfGeneratorConfig &_config)
   {
     sdf::ElementPtr elem = std::make_shared<sdf::Element>();
     sdf::initFile("root.sdf", elem);
     auto worldElem = elem->AddElement("world");
-    if (!updateWorldElement(worldElem, _ecm, _entity, _includeUriMap, _config))
+    if (!updateWorldElement(worldElem, _ecm, _entity, _cache, _includeUriMap,
+        _config))
       return std::nullopt;
 
     return elem->ToString("");
@@ -256,6 +285,19 @@ namespace sdf_generator
                           const Entity &_entity,
                           const IncludeUriMap &_includeUriMap,
                           const msgs::SdfGeneratorConfig &_config)
+  {
+    WorldGenCache cache;
+    return updateWorldElement(_elem, _ecm, _entity, cache, _includeUriMap,
+        _config);
+  }
+
+  /////////////////////////////////////////////////
+  bool updateWorldElement(sdf::ElementPtr _elem,
+                          const EntityComponentManager &_ecm,
+                          const Entity &_entity,
+                          WorldGenCache &_cache,
+                          const IncludeUriMap &_includeUriMap,
+                          const msgs::SdfGeneratorConfig &_config)
   {
     const auto *worldSdf = _ecm.Component<components::WorldSdf>(_entity);
 
@@ -285,10 +327,22 @@ namespace sdf_generator
 
     auto worldDir = common::parentPath(worldSdf->Data().Element()->FilePath());
 
+    // A configuration change can flip any model between inline and
+    // included form, so it invalidates the whole cache.
+    std::string configStr = _config.SerializeAsString();
+    if (configStr != _cache.configStr)
+    {
+      _cache.models.clear();
+      _cache.configStr = configStr;
+    }
+
+    std::unordered_set<Entity> liveModels;
+
     _ecm.Each<components::Model, components::ModelSdf>(
         [&](const Entity &_modelEntity, const components::Model *,
             const components::ModelSdf *_modelSdf)
         {
+          liveModels.insert(_modelEntity);
           auto modelDir =
               common::parentPath(_modelSdf->Data().Element()->FilePath());
           const std::string modelName =
@@ -306,10 +360,31 @@ namespace sdf_generator
             mergeWithOverride(modelConfig, modelConfigIt->second);
           }
 
+          // Only the scoped name, pose and source directory of a model can
+          // change between generations; if they match the cached element,
+          // reuse it instead of copying the model's SDF DOM again.
+          uint64_t checksum = 0xcbf29ce484222325u;
+          hashInto(checksum, modelName);
+          std::ostringstream poseStr;
+          auto *poseComp = _ecm.Component<components::Pose>(_modelEntity);
+          if (nullptr != poseComp)
+            poseStr << poseComp->Data();
+          hashInto(checksum, poseStr.str());
+          hashInto(checksum, modelDir);
+
+          auto &entry = _cache.models[_modelEntity];
+          if (nullptr != entry.elem && entry.checksum == checksum)
+          {
+            _elem->InsertElement(entry.elem);
+            return true;
+          }
+          entry.checksum = checksum;
+
           if (modelConfig.expand_include_tags().data() || !modelFromInclude)
           {
             auto modelElem = _elem->AddElement("model");
             updateModelElement(modelElem, _ecm, _modelEntity);
+            entry.elem = modelElem;
           }
           else if (uriMapIt != _includeUriMap.end())
           {
@@ -350,6 +425,7 @@ namespace sdf_generator
 
             auto includeElem = _elem->AddElement("include");
             updateIncludeElement(includeElem, _ecm, _modelEntity, uri.Str());
+            entry.elem = includeElem;
           }
           else
           {
@@ -359,10 +435,20 @@ namespace sdf_generator
             auto includeElem = _elem->AddElement("include");
             const std::string uri = "file://" + modelDir;
             updateIncludeElement(includeElem, _ecm, _modelEntity, uri);
+            entry.elem = includeElem;
           }
           return true;
         });
 
+    // Drop cache entries for models that no longer exist.
+    for (auto it = _cache.models.begin(); it != _cache.models.end();)
+    {
+      if (liveModels.find(it->first) == liveModels.end())
+        it = _cache.models.erase(it);
+      else
+        ++it;
+    }
+
     return true;
   }
 
@@ -20,6 +20,7 @@
 #include <ignition/msgs/sdf_generator_config.pb.h>
 
 #include <sdf/Element.hh>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
@@ -36,6 +37,30 @@ namespace sdf_generator
 {
   using IncludeUriMap = std::unordered_map<std::string, std::string>;
 
+  /// \brief Cache of generated model elements kept between calls to
+  /// generateWorld(). A model whose generation inputs (name, pose, source
+  /// directory, generator configuration) are unchanged reuses the element
+  /// built on the previous call instead of copying its SDF DOM again.
+  struct WorldGenCache
+  {
+    /// \brief Cached element for one model.
+    struct ModelEntry
+    {
+      /// \brief Checksum of the inputs the element was built from.
+      uint64_t checksum{0};
+
+      /// \brief Generated <model> or <include> element.
+      sdf::ElementPtr elem{nullptr};
+    };
+
+    /// \brief Serialized generator configuration of the previous call.
+    /// The cache is discarded when the configuration changes.
+    std::string configStr;
+
+    /// \brief Cached elements by model entity.
+    std::unordered_map<Entity, ModelEntry> models;
+  };
+
   /// \brief Generate the SDFormat representation of a world
   /// \input[in] _ecm Immutable reference to the Entity Component Manager
   /// \input[in] _entity World entity
@@ -49,6 +74,22 @@ namespace sdf_generator
       const IncludeUriMap &_includeUriMap = IncludeUriMap(),
       const msgs::SdfGeneratorConfig &_config = msgs::SdfGeneratorConfig());
 
+  /// \brief Generate the SDFormat representation of a world, reusing
+  /// cached model elements from a previous generation where possible.
+  /// \input[in] _ecm Immutable reference to the Entity Component Manager
+  /// \input[in] _entity World entity
+  /// \input[in, out] _cache Cache filled by a previous call, updated here
+  /// \input[in] _includeUriMap Map from file paths to URIs used to preserve
+  /// included Fuel models
+  /// \input[in] _config Configuration for the world generator
+  /// \returns Generated world string if generation succeeded.
+  /// Otherwise, nullopt
+  std::optional<std::string> generateWorld(
+      const EntityComponentManager &_ecm, const Entity &_entity,
+      WorldGenCache &_cache,
+      const IncludeUriMap &_includeUriMap = IncludeUriMap(),
+      const msgs::SdfGeneratorConfig &_config = msgs::SdfGeneratorConfig());
+
   /// \brief Update a sdf::Element of a world. Intended for internal use.
   /// \input[in, out] _elem sdf::Element to update
   /// \input[in] _ecm Immutable reference to the Entity Component Manager
@@ -62,6 +103,22 @@ namespace sdf_generator
       const IncludeUriMap &_includeUriMap = IncludeUriMap(),
       const msgs::SdfGeneratorConfig &_config = msgs::SdfGeneratorConfig());
 
+  /// \brief Update a sdf::Element of a world, reusing cached model
+  /// elements where possible. Intended for internal use.
+  /// \input[in, out] _elem sdf::Element to update
+  /// \input[in] _ecm Immutable reference to the Entity Component Manager
+  /// \input[in] _entity World entity
+  /// \input[in, out] _cache Cache filled by a previous call, updated here
+  /// \input[in] _includeUriMap Map from file paths to URIs used to preserve
+  /// included Fuel models
+  /// \input[in] _config Configuration for the world generator
+  bool updateWorldElement(
+      sdf::ElementPtr _elem,
+      const EntityComponentManager &_ecm, const Entity &_entity,
+      WorldGenCache &_cache,
+      const IncludeUriMap &_includeUriMap = IncludeUriMap(),
+      const msgs::SdfGeneratorConfig &_config = msgs::SdfGeneratorConfig());
+
   /// \brief Update a sdf::Element of an inlined model.
   /// Intended for internal use.
   /// \input[in, out] _elem sdf::Element to update
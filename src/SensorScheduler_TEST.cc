@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include "ignition/gazebo/detail/SensorScheduler.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+using Duration = detail::SensorScheduler::Duration;
+
+/////////////////////////////////////////////////
+TEST(SensorSchedulerTest, NothingDueWhileEmpty)
+{
+  detail::SensorScheduler scheduler;
+
+  EXPECT_EQ(0u, scheduler.Count());
+  EXPECT_FALSE(scheduler.AnyDue(Duration(1h)));
+
+  std::vector<detail::SensorScheduler::Entry> due;
+  scheduler.PopDue(Duration(1h), due);
+  EXPECT_TRUE(due.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SensorSchedulerTest, PopsOnlyDueSensors)
+{
+  detail::SensorScheduler scheduler;
+
+  scheduler.Schedule(1, Duration(10ms));
+  scheduler.Schedule(2, Duration(25ms));
+  scheduler.Schedule(3, Duration(100ms));
+  EXPECT_EQ(3u, scheduler.Count());
+
+  // Nothing is due before the earliest due time.
+  EXPECT_FALSE(scheduler.AnyDue(Duration(9ms)));
+
+  // At 30ms, sensors 1 and 2 are due but 3 is not.
+  EXPECT_TRUE(scheduler.AnyDue(Duration(30ms)));
+  std::vector<detail::SensorScheduler::Entry> due;
+  scheduler.PopDue(Duration(30ms), due);
+  ASSERT_EQ(2u, due.size());
+  EXPECT_TRUE((due[0].id == 1 && due[1].id == 2) ||
+              (due[0].id == 2 && due[1].id == 1));
+  EXPECT_EQ(1u, scheduler.Count());
+
+  // Sensor 3 becomes due at its own time.
+  EXPECT_FALSE(scheduler.AnyDue(Duration(99ms)));
+  EXPECT_TRUE(scheduler.AnyDue(Duration(100ms)));
+  due.clear();
+  scheduler.PopDue(Duration(100ms), due);
+  ASSERT_EQ(1u, due.size());
+  EXPECT_EQ(3u, due[0].id);
+  EXPECT_EQ(Duration(100ms), due[0].due);
+  EXPECT_EQ(0u, scheduler.Count());
+}
+
+/////////////////////////////////////////////////
+TEST(SensorSchedulerTest, FarDueTimesSurviveWheelWrap)
+{
+  // A small wheel so due times beyond its horizon share slots with near
+  // ones.
+  detail::SensorScheduler scheduler(1ms, 4);
+
+  scheduler.Schedule(1, Duration(2ms));
+  // 6ms hashes into the same slot as 2ms on a 4-slot wheel.
+  scheduler.Schedule(2, Duration(6ms));
+
+  std::vector<detail::SensorScheduler::Entry> due;
+  scheduler.PopDue(Duration(2ms), due);
+  ASSERT_EQ(1u, due.size());
+  EXPECT_EQ(1u, due[0].id);
+  EXPECT_EQ(1u, scheduler.Count());
+
+  due.clear();
+  scheduler.PopDue(Duration(6ms), due);
+  ASSERT_EQ(1u, due.size());
+  EXPECT_EQ(2u, due[0].id);
+}
+
+/////////////////////////////////////////////////
+TEST(SensorSchedulerTest, PastDueTimesPopImmediately)
+{
+  detail::SensorScheduler scheduler;
+
+  scheduler.Schedule(1, Duration::zero());
+  EXPECT_TRUE(scheduler.AnyDue(Duration::zero()));
+
+  std::vector<detail::SensorScheduler::Entry> due;
+  scheduler.PopDue(Duration::zero(), due);
+  ASSERT_EQ(1u, due.size());
+  EXPECT_EQ(1u, due[0].id);
+}
+
+/////////////////////////////////////////////////
+TEST(SensorSchedulerTest, RemoveAndClear)
+{
+  detail::SensorScheduler scheduler;
+
+  scheduler.Schedule(1, Duration(10ms));
+  scheduler.Schedule(2, Duration(20ms));
+
+  scheduler.Remove(1);
+  EXPECT_EQ(1u, scheduler.Count());
+
+  std::vector<detail::SensorScheduler::Entry> due;
+  scheduler.PopDue(Duration(1s), due);
+  ASSERT_EQ(1u, due.size());
+  EXPECT_EQ(2u, due[0].id);
+
+  scheduler.Schedule(3, Duration(30ms));
+  scheduler.Clear();
+  EXPECT_EQ(0u, scheduler.Count());
+  EXPECT_FALSE(scheduler.AnyDue(Duration(1s)));
+}
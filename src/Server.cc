@@ -102,8 +102,14 @@ Server::Server(const ServerConfig &_config)
 
   sdf::Errors errors;
 
-  // Load a world if specified. Check SDF string first, then SDF file
-  if (!_config.SdfString().empty())
+  // Load a world if specified. Check the SDF Root object first, then the
+  // SDF string, then the SDF file
+  if (nullptr != _config.SdfRoot())
+  {
+    ignmsg << "Loading SDF world from an in-memory Root object.\n";
+    this->dataPtr->sdfRoot = _config.SdfRoot();
+  }
+  else if (!_config.SdfString().empty())
   {
     std::string msg = "Loading SDF string. ";
     if (_config.SdfFile().empty())
@@ -115,7 +121,7 @@ Server::Server(const ServerConfig &_config)
       msg += "File path [" + _config.SdfFile() + "].\n";
     }
     ignmsg <<  msg;
-    errors = this->dataPtr->sdfRoot.LoadSdfString(_config.SdfString());
+    errors = this->dataPtr->sdfRoot->LoadSdfString(_config.SdfString());
   }
   else if (!_config.SdfFile().empty())
   {
@@ -125,19 +131,29 @@ Server::Server(const ServerConfig &_config)
     std::string filePath = systemPaths.FindFile(_config.SdfFile());
     ignmsg << "Loading SDF world file[" << filePath << "].\n";
 
-    // \todo(nkoenig) Async resource download.
-    // This call can block for a long period of time while
-    // resources are downloaded. Blocking here causes the GUI to block with
-    // a black screen (search for "Async resource download" in
-    // 'src/gui_main.cc'.
-    errors = this->dataPtr->sdfRoot.Load(filePath);
+    // Try the world cache first. A hit skips include resolution and
+    // resource fetching; a stale or missing entry falls through to a
+    // normal load, after which the resolved world is cached.
+    if (!_config.UseWorldCache() || !this->dataPtr->LoadCachedWorld(filePath))
+    {
+      // \todo(nkoenig) Async resource download.
+      // This call can block for a long period of time while
+      // resources are downloaded. Blocking here causes the GUI to block with
+      // a black screen (search for "Async resource download" in
+      // 'src/gui_main.cc'.
+      errors = this->dataPtr->sdfRoot->Load(filePath);
+
+      if (errors.empty() && _config.UseWorldCache())
+        this->dataPtr->SaveCachedWorld(filePath);
+    }
   }
   else
   {
     ignmsg << "Loading default world.\n";
     // Load an empty world.
     /// \todo(nkoenig) Add a "AddWorld" function to sdf::Root.
-    errors = this->dataPtr->sdfRoot.LoadSdfString(DefaultWorld::World(_config));
+    errors = this->dataPtr->sdfRoot->LoadSdfString(
+        DefaultWorld::World(_config));
   }
 
   if (!errors.empty())
@@ -14,6 +14,11 @@
  * limitations under the License.
  *
 */
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <ignition/common/Filesystem.hh>
 #include <ignition/common/Util.hh>
 #include <ignition/math/Rand.hh>
@@ -212,7 +217,22 @@ class ignition::gazebo::ServerConfigPrivate
   public: explicit ServerConfigPrivate(
               const std::unique_ptr<ServerConfigPrivate> &_cfg)
           : sdfFile(_cfg->sdfFile),
+            sdfRoot(_cfg->sdfRoot),
             updateRate(_cfg->updateRate),
+            updateBatchSize(_cfg->updateBatchSize),
+            runAheadSteps(_cfg->runAheadSteps),
+            entityRemovalBudget(_cfg->entityRemovalBudget),
+            rtfGovernorEnabled(_cfg->rtfGovernorEnabled),
+            stateChecksumPath(_cfg->stateChecksumPath),
+            checkpointRestorePath(_cfg->checkpointRestorePath),
+            cpuAffinity(_cfg->cpuAffinity),
+            workerThreadCount(_cfg->workerThreadCount),
+            worldCpuBudgets(_cfg->worldCpuBudgets),
+            stepCoordination(_cfg->stepCoordination),
+            postUpdatePipelined(_cfg->postUpdatePipelined),
+            postUpdateBestEffort(_cfg->postUpdateBestEffort),
+            postUpdateSpinWait(_cfg->postUpdateSpinWait),
+            renderPluginsDisabled(_cfg->renderPluginsDisabled),
             useLevels(_cfg->useLevels),
             useLogRecord(_cfg->useLogRecord),
             logRecordPath(_cfg->logRecordPath),
@@ -221,6 +241,7 @@ class ignition::gazebo::ServerConfigPrivate
             logRecordResources(_cfg->logRecordResources),
             logRecordCompressPath(_cfg->logRecordCompressPath),
             resourceCache(_cfg->resourceCache),
+            useWorldCache(_cfg->useWorldCache),
             physicsEngine(_cfg->physicsEngine),
             plugins(_cfg->plugins),
             networkRole(_cfg->networkRole),
@@ -233,9 +254,71 @@ class ignition::gazebo::ServerConfigPrivate
   // \brief The SDF string that the server should load
   public: std::string sdfString = "";
 
+  /// \brief An SDF Root DOM object that the server should load, shared
+  /// with the caller. Takes precedence over sdfFile and sdfString.
+  public: std::shared_ptr<sdf::Root> sdfRoot;
+
   /// \brief An optional update rate.
   public: std::optional<double> updateRate;
 
+  /// \brief Number of simulation steps batched into one full system
+  /// sweep. See ServerConfig::SetUpdateBatchSize.
+  public: unsigned int updateBatchSize = 1;
+
+  /// \brief Number of steps simulated speculatively ahead of confirmed
+  /// time. See ServerConfig::SetRunAheadSteps.
+  public: unsigned int runAheadSteps = 0;
+
+  /// \brief Maximum number of removed entities destroyed per step. See
+  /// ServerConfig::SetEntityRemovalBudget.
+  public: uint64_t entityRemovalBudget = 0;
+
+  /// \brief Shed low-priority systems to hold the real time factor. See
+  /// ServerConfig::SetRtfGovernorEnabled.
+  public: bool rtfGovernorEnabled{false};
+
+  /// \brief Path of the per-step state checksum log. See
+  /// ServerConfig::SetStateChecksumPath.
+  public: std::string stateChecksumPath = "";
+
+  /// \brief Path of a checkpoint file to restore on startup. See
+  /// ServerConfig::SetCheckpointRestorePath.
+  public: std::string checkpointRestorePath = "";
+
+  /// \brief CPUs the server's worlds run on. See
+  /// ServerConfig::SetCpuAffinity.
+  public: std::vector<unsigned int> cpuAffinity;
+
+  /// \brief Worker threads per world, zero for one per hardware thread.
+  /// See ServerConfig::SetWorkerThreadCount.
+  public: unsigned int workerThreadCount{0};
+
+  /// \brief Per-world thread and cpuset overrides, keyed by world name.
+  /// See ServerConfig::SetWorldCpuBudget.
+  public: std::map<std::string,
+              std::pair<unsigned int, std::vector<unsigned int>>>
+                  worldCpuBudgets;
+
+  /// \brief Step the worlds round-robin with deadline accounting. See
+  /// ServerConfig::SetStepCoordination.
+  public: bool stepCoordination{false};
+
+  /// \brief Run PostUpdate against a snapshot, overlapped with the next
+  /// step. See ServerConfig::SetPostUpdatePipelined.
+  public: bool postUpdatePipelined{false};
+
+  /// \brief Let pipelined PostUpdate work skip cycles under load. See
+  /// ServerConfig::SetPostUpdateBestEffort.
+  public: bool postUpdateBestEffort{false};
+
+  /// \brief Spin before sleeping while waiting out PostUpdate work. See
+  /// ServerConfig::SetPostUpdateSpinWait.
+  public: bool postUpdateSpinWait{false};
+
+  /// \brief Refuse to load render-dependent system plugins. See
+  /// ServerConfig::SetRenderPluginsDisabled.
+  public: bool renderPluginsDisabled{false};
+
   /// \brief Use the level system
   public: bool useLevels{false};
 
@@ -262,6 +345,9 @@ class ignition::gazebo::ServerConfigPrivate
   /// from fuel.ignitionrobotics.org, should be stored.
   public: std::string resourceCache = "";
 
+  /// \brief Load fully-resolved worlds from an on-disk cache
+  public: bool useWorldCache{false};
+
   /// \brief File containing physics engine plugin. If empty, DART will be used.
   public: std::string physicsEngine = "";
 
@@ -301,6 +387,7 @@ bool ServerConfig::SetSdfFile(const std::string &_file)
 {
   this->dataPtr->sdfFile = _file;
   this->dataPtr->sdfString = "";
+  this->dataPtr->sdfRoot.reset();
   return true;
 }
 
@@ -315,6 +402,7 @@ bool ServerConfig::SetSdfString(const std::string &_sdfString)
 {
   this->dataPtr->sdfFile = "";
   this->dataPtr->sdfString = _sdfString;
+  this->dataPtr->sdfRoot.reset();
   return true;
 }
 
@@ -324,6 +412,21 @@ std::string ServerConfig::SdfString() const
   return this->dataPtr->sdfString;
 }
 
+//////////////////////////////////////////////////
+bool ServerConfig::SetSdfRoot(std::shared_ptr<sdf::Root> _root)
+{
+  this->dataPtr->sdfFile = "";
+  this->dataPtr->sdfString = "";
+  this->dataPtr->sdfRoot = std::move(_root);
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<sdf::Root> ServerConfig::SdfRoot() const
+{
+  return this->dataPtr->sdfRoot;
+}
+
 //////////////////////////////////////////////////
 void ServerConfig::SetUpdateRate(const double &_hz)
 {
@@ -337,6 +440,193 @@ std::optional<double> ServerConfig::UpdateRate() const
   return this->dataPtr->updateRate;
 }
 
+//////////////////////////////////////////////////
+void ServerConfig::SetUpdateBatchSize(unsigned int _substeps)
+{
+  if (_substeps > 1)
+    this->dataPtr->updateBatchSize = _substeps;
+}
+
+/////////////////////////////////////////////////
+unsigned int ServerConfig::UpdateBatchSize() const
+{
+  return this->dataPtr->updateBatchSize;
+}
+
+//////////////////////////////////////////////////
+void ServerConfig::SetRunAheadSteps(unsigned int _steps)
+{
+  this->dataPtr->runAheadSteps = _steps;
+}
+
+/////////////////////////////////////////////////
+unsigned int ServerConfig::RunAheadSteps() const
+{
+  return this->dataPtr->runAheadSteps;
+}
+
+//////////////////////////////////////////////////
+void ServerConfig::SetEntityRemovalBudget(uint64_t _budget)
+{
+  this->dataPtr->entityRemovalBudget = _budget;
+}
+
+/////////////////////////////////////////////////
+uint64_t ServerConfig::EntityRemovalBudget() const
+{
+  return this->dataPtr->entityRemovalBudget;
+}
+
+//////////////////////////////////////////////////
+void ServerConfig::SetRtfGovernorEnabled(bool _enabled)
+{
+  this->dataPtr->rtfGovernorEnabled = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::RtfGovernorEnabled() const
+{
+  return this->dataPtr->rtfGovernorEnabled;
+}
+
+//////////////////////////////////////////////////
+void ServerConfig::SetStateChecksumPath(const std::string &_path)
+{
+  this->dataPtr->stateChecksumPath = _path;
+}
+
+//////////////////////////////////////////////////
+const std::string &ServerConfig::StateChecksumPath() const
+{
+  return this->dataPtr->stateChecksumPath;
+}
+
+//////////////////////////////////////////////////
+void ServerConfig::SetCheckpointRestorePath(const std::string &_path)
+{
+  this->dataPtr->checkpointRestorePath = _path;
+}
+
+//////////////////////////////////////////////////
+const std::string &ServerConfig::CheckpointRestorePath() const
+{
+  return this->dataPtr->checkpointRestorePath;
+}
+
+//////////////////////////////////////////////////
+void ServerConfig::SetCpuAffinity(const std::vector<unsigned int> &_cpus)
+{
+  this->dataPtr->cpuAffinity = _cpus;
+}
+
+//////////////////////////////////////////////////
+const std::vector<unsigned int> &ServerConfig::CpuAffinity() const
+{
+  return this->dataPtr->cpuAffinity;
+}
+
+//////////////////////////////////////////////////
+void ServerConfig::SetWorkerThreadCount(unsigned int _count)
+{
+  this->dataPtr->workerThreadCount = _count;
+}
+
+//////////////////////////////////////////////////
+unsigned int ServerConfig::WorkerThreadCount() const
+{
+  return this->dataPtr->workerThreadCount;
+}
+
+//////////////////////////////////////////////////
+void ServerConfig::SetWorldCpuBudget(const std::string &_worldName,
+    unsigned int _threads, const std::vector<unsigned int> &_cpus)
+{
+  this->dataPtr->worldCpuBudgets[_worldName] = {_threads, _cpus};
+}
+
+//////////////////////////////////////////////////
+unsigned int ServerConfig::WorldWorkerThreadCount(
+    const std::string &_worldName) const
+{
+  auto iter = this->dataPtr->worldCpuBudgets.find(_worldName);
+  if (iter != this->dataPtr->worldCpuBudgets.end() &&
+      iter->second.first > 0)
+  {
+    return iter->second.first;
+  }
+  return this->dataPtr->workerThreadCount;
+}
+
+//////////////////////////////////////////////////
+std::vector<unsigned int> ServerConfig::WorldCpuAffinity(
+    const std::string &_worldName) const
+{
+  auto iter = this->dataPtr->worldCpuBudgets.find(_worldName);
+  if (iter != this->dataPtr->worldCpuBudgets.end())
+    return iter->second.second;
+  return {};
+}
+
+//////////////////////////////////////////////////
+void ServerConfig::SetStepCoordination(bool _enabled)
+{
+  this->dataPtr->stepCoordination = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool ServerConfig::StepCoordination() const
+{
+  return this->dataPtr->stepCoordination;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetPostUpdatePipelined(bool _enabled)
+{
+  this->dataPtr->postUpdatePipelined = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::PostUpdatePipelined() const
+{
+  return this->dataPtr->postUpdatePipelined;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetPostUpdateBestEffort(bool _enabled)
+{
+  this->dataPtr->postUpdateBestEffort = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::PostUpdateBestEffort() const
+{
+  return this->dataPtr->postUpdateBestEffort;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetPostUpdateSpinWait(bool _enabled)
+{
+  this->dataPtr->postUpdateSpinWait = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::PostUpdateSpinWait() const
+{
+  return this->dataPtr->postUpdateSpinWait;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetRenderPluginsDisabled(bool _disabled)
+{
+  this->dataPtr->renderPluginsDisabled = _disabled;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::RenderPluginsDisabled() const
+{
+  return this->dataPtr->renderPluginsDisabled;
+}
+
 /////////////////////////////////////////////////
 std::optional<std::chrono::steady_clock::duration>
     ServerConfig::UpdatePeriod() const
@@ -492,6 +782,18 @@ void ServerConfig::SetResourceCache(const std::string &_path)
   this->dataPtr->resourceCache = _path;
 }
 
+/////////////////////////////////////////////////
+bool ServerConfig::UseWorldCache() const
+{
+  return this->dataPtr->useWorldCache;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetUseWorldCache(bool _cache)
+{
+  this->dataPtr->useWorldCache = _cache;
+}
+
 /////////////////////////////////////////////////
 const std::string &ServerConfig::PhysicsEngine() const
 {
@@ -18,15 +18,23 @@
 
 #include <tinyxml2.h>
 
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sdf/Element.hh>
 #include <sdf/Root.hh>
 #include <sdf/World.hh>
 
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Util.hh>
 
 #include <ignition/fuel_tools/Interface.hh>
 
-#include <ignition/gui/Application.hh>
-
+#include "CpuAffinity.hh"
 #include "SimulationRunner.hh"
 
 using namespace ignition;
@@ -164,6 +172,19 @@ bool ServerPrivate::Run(const uint64_t _iterations,
   }
   else
   {
+    // Optionally step the worlds round-robin instead of free-running,
+    // so each gets a predictable share of the machine.
+    if (this->config.StepCoordination())
+    {
+      this->runnerCoordinator =
+          std::make_unique<RunnerCoordinator>(this->simRunners.size());
+      for (std::size_t i = 0; i < this->simRunners.size(); ++i)
+      {
+        this->simRunners[i]->SetStepCoordinator(
+            this->runnerCoordinator.get(), i);
+      }
+    }
+
     for (std::unique_ptr<SimulationRunner> &runner : this->simRunners)
     {
       this->workerPool.AddWork([&runner, &_iterations] ()
@@ -183,7 +204,7 @@ bool ServerPrivate::Run(const uint64_t _iterations,
 //////////////////////////////////////////////////
 void ServerPrivate::AddRecordPlugin(const ServerConfig &_config)
 {
-  const sdf::World *sdfWorld = this->sdfRoot.WorldByIndex(0);
+  const sdf::World *sdfWorld = this->sdfRoot->WorldByIndex(0);
   sdf::ElementPtr worldElem = sdfWorld->Element();
 
   // Check if there is already a record plugin specified
@@ -319,21 +340,163 @@ void ServerPrivate::AddRecordPlugin(const ServerConfig &_config)
 //////////////////////////////////////////////////
 void ServerPrivate::CreateEntities()
 {
+  // When CPU placement is configured, the list is split into one
+  // contiguous chunk per world, so a list grouped by NUMA node keeps
+  // each world within one node. The chunk is applied to this thread
+  // before its runner is built: the runner's worker pool threads
+  // inherit the mask, and first-touch allocation places the world's
+  // memory on the chunk's node. The runner pins its own step thread in
+  // Run.
+  const std::vector<unsigned int> &cpus = this->config.CpuAffinity();
+  const uint64_t worldCount = this->sdfRoot->WorldCount();
+  const auto originalAffinity = detail::CurrentThreadAffinity();
+  bool pinned = false;
+
   // Create a simulation runner for each world.
-  for (uint64_t worldIndex = 0; worldIndex <
-       this->sdfRoot.WorldCount(); ++worldIndex)
+  for (uint64_t worldIndex = 0; worldIndex < worldCount; ++worldIndex)
   {
-    auto world = this->sdfRoot.WorldByIndex(worldIndex);
+    auto world = this->sdfRoot->WorldByIndex(worldIndex);
 
     {
       std::lock_guard<std::mutex> lock(this->worldsMutex);
       this->worldNames.push_back(world->Name());
     }
+
+    // A per-world cpuset overrides the world's chunk of the shared
+    // list, for worlds with known, uneven weights.
+    std::vector<unsigned int> chunk =
+        this->config.WorldCpuAffinity(world->Name());
+    if (chunk.empty() && !cpus.empty())
+    {
+      chunk.assign(cpus.begin() + worldIndex * cpus.size() / worldCount,
+          cpus.begin() + (worldIndex + 1) * cpus.size() / worldCount);
+      // More worlds than CPUs: share the whole list instead.
+      if (chunk.empty())
+        chunk = cpus;
+    }
+    if (!chunk.empty())
+      pinned = detail::SetCurrentThreadAffinity(chunk) || pinned;
+
     auto runner = std::make_unique<SimulationRunner>(
         world, this->systemLoader, this->config);
+    runner->SetCpuAffinity(chunk);
     runner->SetFuelUriMap(this->fuelUriMap);
     this->simRunners.push_back(std::move(runner));
   }
+
+  // Restore this thread's mask; only the runners stay pinned.
+  if (pinned && !originalAffinity.empty())
+    detail::SetCurrentThreadAffinity(originalAffinity);
+}
+
+/////////////////////////////////////////////////
+/// \brief Compute a FNV-1a hash of a string. Used to key the world cache,
+/// so it has to be stable across processes.
+/// \param[in] _data String to hash.
+/// \return 64-bit hash of the string.
+static uint64_t HashContents(const std::string &_data)
+{
+  uint64_t hash = 0xcbf29ce484222325u;
+  for (const unsigned char c : _data)
+  {
+    hash ^= c;
+    hash *= 0x100000001b3u;
+  }
+  return hash;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a whole file into a string.
+/// \param[in] _path Path to the file to read.
+/// \param[out] _contents Contents of the file.
+/// \return True if the file could be read.
+static bool ReadFileContents(const std::string &_path, std::string &_contents)
+{
+  std::ifstream in(_path, std::ios::binary);
+  if (!in)
+    return false;
+
+  std::ostringstream stream;
+  stream << in.rdbuf();
+  _contents = stream.str();
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the directory holding cached resolved worlds.
+/// \return Path to the world cache directory.
+static std::string WorldCacheDirectory()
+{
+  std::string home;
+  common::env(IGN_HOMEDIR, home);
+  return common::joinPaths(home, ".ignition", "gazebo", "worldcache");
+}
+
+//////////////////////////////////////////////////
+bool ServerPrivate::LoadCachedWorld(const std::string &_filePath)
+{
+  std::string contents;
+  if (!ReadFileContents(_filePath, contents))
+    return false;
+
+  std::ostringstream fileName;
+  fileName << std::hex << HashContents(contents) << ".sdf";
+  std::string cachePath = common::joinPaths(WorldCacheDirectory(),
+      fileName.str());
+  if (!common::exists(cachePath))
+    return false;
+
+  std::string cached;
+  if (!ReadFileContents(cachePath, cached))
+    return false;
+
+  sdf::Errors errors = this->sdfRoot->LoadSdfString(cached);
+  if (!errors.empty())
+  {
+    ignwarn << "Failed to load cached world [" << cachePath
+            << "], falling back to [" << _filePath << "].\n";
+    for (auto &err : errors)
+      igndbg << err << "\n";
+    return false;
+  }
+
+  ignmsg << "Loaded world from cache [" << cachePath << "].\n";
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ServerPrivate::SaveCachedWorld(const std::string &_filePath)
+{
+  if (nullptr == this->sdfRoot->Element())
+    return;
+
+  std::string contents;
+  if (!ReadFileContents(_filePath, contents))
+    return;
+
+  std::string cacheDir = WorldCacheDirectory();
+  if (!common::exists(cacheDir) && !common::createDirectories(cacheDir))
+  {
+    ignwarn << "Failed to create world cache directory ["
+            << cacheDir << "].\n";
+    return;
+  }
+
+  std::ostringstream fileName;
+  fileName << std::hex << HashContents(contents) << ".sdf";
+  std::string cachePath = common::joinPaths(cacheDir, fileName.str());
+
+  std::ofstream out(cachePath, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    ignwarn << "Failed to write world cache file [" << cachePath << "].\n";
+    return;
+  }
+
+  // The DOM has all <include> tags expanded at this point, so the cached
+  // copy can be loaded without resolving or fetching any resource.
+  out << this->sdfRoot->Element()->ToString("");
+  igndbg << "Cached resolved world to [" << cachePath << "].\n";
 }
 
 //////////////////////////////////////////////////
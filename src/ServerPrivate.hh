@@ -44,6 +44,8 @@
 #include "ignition/gazebo/ServerConfig.hh"
 #include "ignition/gazebo/SystemLoader.hh"
 
+#include "RunnerCoordinator.hh"
+
 using namespace std::chrono_literals;
 
 namespace ignition
@@ -77,6 +79,18 @@ namespace ignition
       /// \brief Create all entities that exist in the sdf::Root object.
       public: void CreateEntities();
 
+      /// \brief Try to load a fully-resolved world for the given file from
+      /// the on-disk world cache. The cache entry is keyed by a hash of the
+      /// file contents, so a modified file is always a cache miss.
+      /// \param[in] _filePath Path to the SDF world file.
+      /// \return True if an up-to-date cached copy was found and loaded.
+      public: bool LoadCachedWorld(const std::string &_filePath);
+
+      /// \brief Store the currently loaded, include-expanded world in the
+      /// on-disk world cache, keyed by a hash of the given file's contents.
+      /// \param[in] _filePath Path to the SDF world file that was loaded.
+      public: void SaveCachedWorld(const std::string &_filePath);
+
       /// \brief Stop server.
       public: void Stop();
 
@@ -110,6 +124,11 @@ namespace ignition
       /// \brief All the simulation runners.
       public: std::vector<std::unique_ptr<SimulationRunner>> simRunners;
 
+      /// \brief Coordinator the runners' step loops take turns through
+      /// when step coordination is enabled. Null otherwise. See
+      /// ServerConfig::SetStepCoordination.
+      public: std::unique_ptr<RunnerCoordinator> runnerCoordinator;
+
       /// \brief Mutex to protect the Run operation.
       public: std::mutex runMutex;
 
@@ -128,8 +147,11 @@ namespace ignition
 
       /// \brief The SDF root object.
       /// This keeps the SDF object in memory so that other classes can keep a
-      /// pointer to child nodes of the root
-      public: sdf::Root sdfRoot;
+      /// pointer to child nodes of the root. Held through a shared pointer
+      /// so a Root built by the caller can be handed over directly via
+      /// ServerConfig::SetSdfRoot, without an XML round-trip.
+      public: std::shared_ptr<sdf::Root> sdfRoot =
+          std::make_shared<sdf::Root>();
 
       /// \brief The server configuration.
       public: ServerConfig config;
@@ -354,6 +354,39 @@ TEST_P(ServerFixture, SdfStringServerConfig)
   EXPECT_EQ(2u, *server.SystemCount());
 }
 
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, SdfRootServerConfig)
+{
+  ignition::gazebo::ServerConfig serverConfig;
+
+  serverConfig.SetSdfString(TestWorldSansPhysics::World());
+  EXPECT_FALSE(serverConfig.SdfString().empty());
+  EXPECT_EQ(nullptr, serverConfig.SdfRoot());
+
+  // Setting the Root object should override the string.
+  auto root = std::make_shared<sdf::Root>();
+  sdf::Errors errors = root->Load(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+  EXPECT_TRUE(errors.empty());
+  serverConfig.SetSdfRoot(root);
+  EXPECT_TRUE(serverConfig.SdfFile().empty());
+  EXPECT_TRUE(serverConfig.SdfString().empty());
+  EXPECT_NE(nullptr, serverConfig.SdfRoot());
+
+  // The server loads the world directly from the in-memory document.
+  gazebo::Server server(serverConfig);
+  EXPECT_FALSE(server.Running());
+  EXPECT_FALSE(*server.Running(0));
+  EXPECT_TRUE(*server.Paused());
+  EXPECT_EQ(0u, *server.IterationCount());
+  EXPECT_EQ(16u, *server.EntityCount());
+  EXPECT_EQ(3u, *server.SystemCount());
+
+  EXPECT_TRUE(server.HasEntity("box"));
+  EXPECT_TRUE(server.HasEntity("sphere"));
+  EXPECT_TRUE(server.HasEntity("cylinder"));
+}
+
 /////////////////////////////////////////////////
 TEST_P(ServerFixture, RunBlocking)
 {
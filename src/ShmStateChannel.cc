@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/gazebo/ShmStateChannel.hh"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+
+using namespace ignition;
+using namespace gazebo;
+
+namespace
+{
+/// \brief Header at the start of the mapped region, followed by the
+/// payload bytes.
+struct ShmHeader
+{
+  /// \brief Payload version. Odd while a write is in progress, even when
+  /// the payload is consistent. Zero means no message has been written.
+  std::atomic<uint64_t> sequence{0};
+
+  /// \brief Set to 1 by the reader when it attaches.
+  std::atomic<uint32_t> readerAttached{0};
+
+  /// \brief Serialized size of the current payload.
+  uint64_t size{0};
+};
+}
+
+#ifndef _WIN32
+
+/////////////////////////////////////////////////
+std::unique_ptr<ShmStateChannel> ShmStateChannel::Create(
+    const std::string &_name, uint64_t _capacity)
+{
+  int fd = shm_open(_name.c_str(), O_CREAT | O_RDWR, 0600);
+  if (fd < 0)
+    return nullptr;
+
+  const uint64_t total = sizeof(ShmHeader) + _capacity;
+  if (ftruncate(fd, total) < 0)
+  {
+    close(fd);
+    shm_unlink(_name.c_str());
+    return nullptr;
+  }
+
+  void *mapping = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED,
+      fd, 0);
+  close(fd);
+  if (MAP_FAILED == mapping)
+  {
+    shm_unlink(_name.c_str());
+    return nullptr;
+  }
+
+  // The region is zero-filled by ftruncate; construct the header in place
+  // to get well-defined atomics.
+  new(mapping) ShmHeader();
+
+  std::unique_ptr<ShmStateChannel> channel(new ShmStateChannel());
+  channel->mapping = mapping;
+  channel->capacity = _capacity;
+  channel->owner = true;
+  channel->name = _name;
+  return channel;
+}
+
+/////////////////////////////////////////////////
+std::unique_ptr<ShmStateChannel> ShmStateChannel::Attach(
+    const std::string &_name)
+{
+  int fd = shm_open(_name.c_str(), O_RDWR, 0);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat st;
+  if (fstat(fd, &st) < 0 ||
+      static_cast<uint64_t>(st.st_size) < sizeof(ShmHeader))
+  {
+    close(fd);
+    return nullptr;
+  }
+
+  void *mapping = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE,
+      MAP_SHARED, fd, 0);
+  close(fd);
+  if (MAP_FAILED == mapping)
+    return nullptr;
+
+  std::unique_ptr<ShmStateChannel> channel(new ShmStateChannel());
+  channel->mapping = mapping;
+  channel->capacity = st.st_size - sizeof(ShmHeader);
+  channel->name = _name;
+
+  static_cast<ShmHeader *>(mapping)->readerAttached.store(1);
+  return channel;
+}
+
+/////////////////////////////////////////////////
+ShmStateChannel::~ShmStateChannel()
+{
+  if (nullptr != this->mapping)
+  {
+    munmap(this->mapping, sizeof(ShmHeader) + this->capacity);
+  }
+  if (this->owner)
+  {
+    shm_unlink(this->name.c_str());
+  }
+}
+
+/////////////////////////////////////////////////
+bool ShmStateChannel::ReaderAttached() const
+{
+  if (nullptr == this->mapping)
+    return false;
+  return 0 != static_cast<const ShmHeader *>(
+      this->mapping)->readerAttached.load();
+}
+
+/////////////////////////////////////////////////
+bool ShmStateChannel::Write(const google::protobuf::Message &_msg)
+{
+  if (nullptr == this->mapping)
+    return false;
+
+  const uint64_t size = _msg.ByteSizeLong();
+  if (size > this->capacity)
+    return false;
+
+  auto *header = static_cast<ShmHeader *>(this->mapping);
+
+  // Mark the payload inconsistent (odd sequence) while writing, so a
+  // reader racing this write sees a torn payload and retries or skips
+  // to the next message.
+  header->sequence.fetch_add(1, std::memory_order_acquire);
+  _msg.SerializeToArray(
+      static_cast<char *>(this->mapping) + sizeof(ShmHeader), size);
+  header->size = size;
+  header->sequence.fetch_add(1, std::memory_order_release);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ShmStateChannel::HasNewData() const
+{
+  if (nullptr == this->mapping)
+    return false;
+
+  const uint64_t seq = static_cast<const ShmHeader *>(
+      this->mapping)->sequence.load(std::memory_order_acquire);
+  return 0 == (seq & 1) && seq != this->lastReadSequence && seq != 0;
+}
+
+/////////////////////////////////////////////////
+bool ShmStateChannel::Read(google::protobuf::Message &_msg)
+{
+  if (!this->HasNewData())
+    return false;
+
+  auto *header = static_cast<ShmHeader *>(this->mapping);
+  const uint64_t seq = header->sequence.load(std::memory_order_acquire);
+
+  if (!_msg.ParseFromArray(
+      static_cast<const char *>(this->mapping) + sizeof(ShmHeader),
+      header->size))
+  {
+    return false;
+  }
+
+  // A concurrent write would have changed the sequence; treat the result
+  // as torn and let the caller retry.
+  if (header->sequence.load(std::memory_order_acquire) != seq)
+    return false;
+
+  this->lastReadSequence = seq;
+  return true;
+}
+
+#else
+
+/////////////////////////////////////////////////
+std::unique_ptr<ShmStateChannel> ShmStateChannel::Create(
+    const std::string &, uint64_t)
+{
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+std::unique_ptr<ShmStateChannel> ShmStateChannel::Attach(const std::string &)
+{
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+ShmStateChannel::~ShmStateChannel() = default;
+
+/////////////////////////////////////////////////
+bool ShmStateChannel::ReaderAttached() const
+{
+  return false;
+}
+
+/////////////////////////////////////////////////
+bool ShmStateChannel::Write(const google::protobuf::Message &)
+{
+  return false;
+}
+
+/////////////////////////////////////////////////
+bool ShmStateChannel::HasNewData() const
+{
+  return false;
+}
+
+/////////////////////////////////////////////////
+bool ShmStateChannel::Read(google::protobuf::Message &)
+{
+  return false;
+}
+
+#endif  // _WIN32
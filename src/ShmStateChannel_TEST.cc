@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "msgs/peer_info.pb.h"
+
+#include "ignition/gazebo/ShmStateChannel.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+#ifndef _WIN32
+
+//////////////////////////////////////////////////
+TEST(ShmStateChannel, AttachMissing)
+{
+  // Attaching to a channel nobody created fails.
+  EXPECT_EQ(nullptr, ShmStateChannel::Attach("/ign-gazebo-test-missing"));
+}
+
+//////////////////////////////////////////////////
+TEST(ShmStateChannel, ReaderAttached)
+{
+  auto writer = ShmStateChannel::Create("/ign-gazebo-test-attach", 1024);
+  ASSERT_NE(nullptr, writer);
+  EXPECT_FALSE(writer->ReaderAttached());
+
+  auto reader = ShmStateChannel::Attach("/ign-gazebo-test-attach");
+  ASSERT_NE(nullptr, reader);
+  EXPECT_TRUE(writer->ReaderAttached());
+}
+
+//////////////////////////////////////////////////
+TEST(ShmStateChannel, WriteRead)
+{
+  auto writer = ShmStateChannel::Create("/ign-gazebo-test-rw", 1024);
+  ASSERT_NE(nullptr, writer);
+  auto reader = ShmStateChannel::Attach("/ign-gazebo-test-rw");
+  ASSERT_NE(nullptr, reader);
+
+  // Nothing written yet.
+  EXPECT_FALSE(reader->HasNewData());
+  private_msgs::PeerInfo out;
+  EXPECT_FALSE(reader->Read(out));
+
+  private_msgs::PeerInfo in;
+  in.set_id("peer-id");
+  in.set_hostname("localhost");
+  EXPECT_TRUE(writer->Write(in));
+
+  EXPECT_TRUE(reader->HasNewData());
+  EXPECT_TRUE(reader->Read(out));
+  EXPECT_EQ("peer-id", out.id());
+  EXPECT_EQ("localhost", out.hostname());
+
+  // The message is only reported as new once.
+  EXPECT_FALSE(reader->HasNewData());
+  EXPECT_FALSE(reader->Read(out));
+
+  // A second write makes the channel new again.
+  in.set_id("peer-id-2");
+  EXPECT_TRUE(writer->Write(in));
+  EXPECT_TRUE(reader->HasNewData());
+  EXPECT_TRUE(reader->Read(out));
+  EXPECT_EQ("peer-id-2", out.id());
+}
+
+//////////////////////////////////////////////////
+TEST(ShmStateChannel, OversizedWrite)
+{
+  auto writer = ShmStateChannel::Create("/ign-gazebo-test-oversized", 4);
+  ASSERT_NE(nullptr, writer);
+
+  private_msgs::PeerInfo in;
+  in.set_id("an id longer than the channel capacity");
+  EXPECT_FALSE(writer->Write(in));
+}
+
+//////////////////////////////////////////////////
+TEST(ShmStateChannel, UnlinkedOnDestruction)
+{
+  {
+    auto writer = ShmStateChannel::Create("/ign-gazebo-test-unlink", 1024);
+    ASSERT_NE(nullptr, writer);
+  }
+
+  // The writer removed the shared memory object when it went out of
+  // scope, so attaching fails.
+  EXPECT_EQ(nullptr, ShmStateChannel::Attach("/ign-gazebo-test-unlink"));
+}
+
+#endif  // _WIN32
@@ -17,16 +17,25 @@
 
 #include "SimulationRunner.hh"
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "ignition/common/Profiler.hh"
+#include "ignition/common/Util.hh"
 
+#include "ignition/gazebo/components/Factory.hh"
 #include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/Sensor.hh"
 #include "ignition/gazebo/components/Visual.hh"
 #include "ignition/gazebo/components/World.hh"
+#include "ignition/gazebo/BoundedPublisher.hh"
 #include "ignition/gazebo/Events.hh"
 #include "ignition/gazebo/SdfEntityCreator.hh"
+#include "ignition/gazebo/StaticSystemRegistry.hh"
 #include "ignition/gazebo/Util.hh"
+#include "msgs/checkpoint.pb.h"
+#include "CpuAffinity.hh"
 #include "network/NetworkManagerPrimary.hh"
 #include "SdfGenerator.hh"
 
@@ -35,6 +44,33 @@ using namespace gazebo;
 
 using StringSet = std::unordered_set<std::string>;
 
+//////////////////////////////////////////////////
+/// \brief Whether a system plugin loads a render engine.
+/// \param[in] _filename Plugin filename from SDF.
+/// \return True for plugins that can't run headless.
+static bool IsRenderPlugin(const std::string &_filename)
+{
+  // The sensors system is the only server-side system that loads a
+  // render engine.
+  return _filename.find("sensors-system") != std::string::npos;
+}
+
+//////////////////////////////////////////////////
+/// \brief Resolve the worker pool size for a world's runner.
+/// \param[in] _world World the runner simulates, may be null.
+/// \param[in] _config Server configuration holding the thread budgets.
+/// \return The configured thread count for the world, or one per
+/// hardware thread (at least two) when no budget is set.
+static unsigned int RunnerThreadCount(const sdf::World *_world,
+    const ServerConfig &_config)
+{
+  unsigned int count = 0;
+  if (nullptr != _world)
+    count = _config.WorldWorkerThreadCount(_world->Name());
+  if (0 == count)
+    count = std::max(2u, std::thread::hardware_concurrency());
+  return count;
+}
 
 //////////////////////////////////////////////////
 SimulationRunner::SimulationRunner(const sdf::World *_world,
@@ -42,7 +78,8 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
                                    const ServerConfig &_config)
     // \todo(nkoenig) Either copy the world, or add copy constructor to the
     // World and other elements.
-    : sdfWorld(_world), serverConfig(_config)
+    : workerPool(RunnerThreadCount(_world, _config)),
+      sdfWorld(_world), serverConfig(_config)
 {
   if (nullptr == _world)
   {
@@ -100,6 +137,74 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
   this->updatePeriod = std::chrono::nanoseconds(
       static_cast<int>(this->stepSize.count() / desiredRtf));
 
+  // Batch multiple physics substeps into one full system sweep, if
+  // configured.
+  this->updateBatchSize = std::max(1u, _config.UpdateBatchSize());
+
+  // Speculate ahead of confirmed time for low-latency teleoperation,
+  // if configured. Distributed runs step in lockstep with the
+  // secondaries and can't roll back unilaterally.
+  if (!_config.NetworkRole().empty() && _config.RunAheadSteps() > 0)
+  {
+    ignwarn << "Run-ahead is not supported with distributed simulation "
+            << "and will be ignored." << std::endl;
+  }
+  else
+  {
+    this->runAheadSteps = _config.RunAheadSteps();
+  }
+
+  this->governorEnabled = _config.RtfGovernorEnabled();
+
+  // Overlap PostUpdate with the next step, if configured. The snapshot
+  // manager gets its own worker pool so waits on the shared pool during
+  // the Update phase don't block on in-flight PostUpdate work.
+  this->postUpdatePipelined = _config.PostUpdatePipelined();
+  if (this->postUpdatePipelined)
+  {
+    this->postUpdatePool = std::make_unique<common::WorkerPool>(
+        RunnerThreadCount(_world, _config));
+  }
+
+  // Let pipelined PostUpdate batches skip cycles under load, if
+  // configured. Without the pipeline there's no snapshot to buffer
+  // deltas against, so the flag only takes effect with it.
+  this->postUpdateBestEffort =
+      this->postUpdatePipelined && _config.PostUpdateBestEffort();
+  if (_config.PostUpdateBestEffort() && !this->postUpdatePipelined)
+  {
+    ignwarn << "Best-effort PostUpdate requires pipelined PostUpdate; "
+            << "ignoring the setting." << std::endl;
+  }
+
+  // Spin before sleeping at the PostUpdate synchronization point, if
+  // configured.
+  this->postUpdateSpinWait = _config.PostUpdateSpinWait();
+
+  // Amortize bulk entity removals over multiple steps, if configured.
+  this->entityCompMgr.SetRemovalBudget(_config.EntityRemovalBudget());
+
+  // Open the state checksum log, if configured. The environment
+  // variable lets the stock command line tool feed the determinism
+  // harness without a programmatic ServerConfig.
+  std::string checksumPath = _config.StateChecksumPath();
+  if (checksumPath.empty())
+    common::env("IGN_GAZEBO_STATE_CHECKSUM_PATH", checksumPath);
+  if (!checksumPath.empty())
+  {
+    this->stateChecksumFile.open(checksumPath, std::ios::trunc);
+    if (this->stateChecksumFile.is_open())
+    {
+      ignmsg << "Writing state checksums to [" << checksumPath << "]"
+             << std::endl;
+    }
+    else
+    {
+      ignerr << "Failed to open state checksum log [" << checksumPath
+             << "]" << std::endl;
+    }
+  }
+
   this->pauseConn = this->eventMgr.Connect<events::Pause>(
       std::bind(&SimulationRunner::SetPaused, this, std::placeholders::_1));
 
@@ -198,12 +303,54 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
 
   ignmsg << "Serving world SDF generation service on [" << opts.NameSpace()
          << "/" << genWorldSdfService << "]" << std::endl;
+
+  std::string systemStatsService{"system_stats"};
+  this->node->Advertise(
+      systemStatsService, &SimulationRunner::SystemStatsService, this);
+
+  ignmsg << "Serving system timing statistics on [" << opts.NameSpace()
+         << "/" << systemStatsService << "]" << std::endl;
+
+  std::string memoryStatsService{"memory_stats"};
+  this->node->Advertise(
+      memoryStatsService, &SimulationRunner::MemoryStatsService, this);
+
+  ignmsg << "Serving memory statistics on [" << opts.NameSpace()
+         << "/" << memoryStatsService << "]" << std::endl;
+
+  std::string stepTraceService{"step_trace"};
+  this->node->Advertise(
+      stepTraceService, &SimulationRunner::StepTraceService, this);
+
+  ignmsg << "Serving step trace dumps on [" << opts.NameSpace()
+         << "/" << stepTraceService << "]" << std::endl;
+
+  std::string reloadService{"systems/reload"};
+  this->node->Advertise(
+      reloadService, &SimulationRunner::ReloadSystemsService, this);
+
+  ignmsg << "Serving system hot reload on [" << opts.NameSpace()
+         << "/" << reloadService << "]" << std::endl;
+
+  std::string checkpointService{"checkpoint"};
+  this->node->Advertise(
+      checkpointService, &SimulationRunner::CheckpointService, this);
+
+  ignmsg << "Serving checkpoints on [" << opts.NameSpace()
+         << "/" << checkpointService << "]" << std::endl;
+
+  // Lay a checkpoint over the freshly loaded world, if configured.
+  if (!_config.CheckpointRestorePath().empty())
+    this->RestoreCheckpoint(_config.CheckpointRestorePath());
 }
 
 //////////////////////////////////////////////////
 SimulationRunner::~SimulationRunner()
 {
-  this->StopWorkerThreads();
+  // Steps driven from outside Run, such as a stepped GUI session, can
+  // leave a pipelined PostUpdate batch in flight.
+  if (this->postUpdateInFlight)
+    this->postUpdatePool->WaitForResults();
 }
 
 /////////////////////////////////////////////////
@@ -352,89 +499,207 @@ void SimulationRunner::PublishStats()
   // Only publish to root topic if no others are.
   if (this->rootClockPub.Valid())
     this->rootClockPub.Publish(clockMsg);
+
+  // Publish per-system timing statistics at roughly 1Hz. Building the
+  // message walks every histogram, so it's throttled here instead of by
+  // the publisher.
+  auto now = std::chrono::steady_clock::now();
+  if (this->systemStatsPub.Valid() &&
+      now - this->prevSystemStatsPubTime >= std::chrono::seconds(1))
+  {
+    this->prevSystemStatsPubTime = now;
+    private_msgs::SystemStatistics_V statsMsg;
+    this->FillSystemStats(statsMsg);
+    this->systemStatsPub.Publish(statsMsg);
+  }
+
+  // Publish memory accounting at a slow rate. Storage and view growth is
+  // gradual, so a sample every few seconds is enough to attribute it.
+  if (this->memoryStatsPub.Valid() &&
+      now - this->prevMemoryStatsPubTime >= std::chrono::seconds(5))
+  {
+    this->prevMemoryStatsPubTime = now;
+    private_msgs::MemoryStatistics memoryMsg;
+    this->FillMemoryStats(memoryMsg);
+    this->memoryStatsPub.Publish(memoryMsg);
+  }
 }
 
 /////////////////////////////////////////////////
 void SimulationRunner::AddSystem(const SystemPluginPtr &_system)
 {
-  std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
-  this->pendingSystems.push_back(_system);
+  this->AddSystem(_system, "", "", nullptr, kNullEntity);
 }
 
 /////////////////////////////////////////////////
-void SimulationRunner::AddSystemToRunner(const SystemPluginPtr &_system)
+void SimulationRunner::AddSystem(const SystemPluginPtr &_system,
+    const std::string &_filename, const std::string &_name,
+    const sdf::ElementPtr &_sdf, const Entity _entity)
 {
-  this->systems.push_back(SystemInternal(_system));
+  SystemInternal system(_system);
+  system.filename = _filename;
+  system.name = _name;
+  system.configureSdf = _sdf;
+  system.configureEntity = _entity;
 
-  const auto &system = this->systems.back();
-
-  if (system.preupdate)
-    this->systemsPreupdate.push_back(system.preupdate);
+  std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
+  this->pendingSystems.push_back(std::move(system));
+}
 
-  if (system.update)
-    this->systemsUpdate.push_back(system.update);
+/////////////////////////////////////////////////
+void SimulationRunner::AddSystem(const std::shared_ptr<System> &_system,
+    const std::string &_name, const sdf::ElementPtr &_sdf,
+    const Entity _entity)
+{
+  SystemInternal system(_system);
+  system.name = _name;
+  system.configureSdf = _sdf;
+  system.configureEntity = _entity;
 
-  if (system.postupdate)
-    this->systemsPostupdate.push_back(system.postupdate);
+  std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
+  this->pendingSystems.push_back(std::move(system));
 }
 
 /////////////////////////////////////////////////
-void SimulationRunner::ProcessSystemQueue()
+void SimulationRunner::AddSystemToRunner(const SystemInternal &_system)
 {
-  std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
-  auto pending = this->pendingSystems.size();
+  this->systems.push_back(_system);
 
-  if (pending > 0)
+  // Hand the system its slice of a restored checkpoint, if one is
+  // waiting for it.
+  if (nullptr != _system.handoff && !_system.name.empty() &&
+      !this->checkpointSystemState.empty())
   {
-    // If additional systems are to be added, stop the existing threads.
-    this->StopWorkerThreads();
+    auto iter = this->checkpointSystemState.find(_system.name);
+    if (iter != this->checkpointSystemState.end())
+    {
+      _system.handoff->RestoreState(iter->second);
+      this->checkpointSystemState.erase(iter);
+    }
   }
 
-  for (const auto &system : this->pendingSystems)
+  this->RebuildSystemVectors();
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::RebuildSystemVectors()
+{
+  this->systemsPreupdate.clear();
+  this->systemsPreupdateOwner.clear();
+  this->systemsUpdate.clear();
+  this->systemsUpdateOwner.clear();
+  this->systemsUpdateAccess.clear();
+  this->systemsPostupdate.clear();
+  this->systemsPostupdateOwner.clear();
+
+  for (size_t systemIndex = 0; systemIndex < this->systems.size();
+       ++systemIndex)
   {
-    this->AddSystemToRunner(system);
-  }
+    const auto &system = this->systems[systemIndex];
 
-  this->pendingSystems.clear();
+    if (system.preupdate)
+    {
+      this->systemsPreupdate.push_back(system.preupdate);
+      this->systemsPreupdateOwner.push_back(systemIndex);
+    }
 
-  // If additional systems were added, recreate the worker threads.
-  if (pending > 0)
-  {
-    igndbg << "Creating PostUpdate worker threads: "
-      << this->systemsPostupdate.size() + 1 << std::endl;
+    if (system.update)
+    {
+      this->systemsUpdate.push_back(system.update);
+      this->systemsUpdateOwner.push_back(systemIndex);
+      this->systemsUpdateAccess.push_back(system.updateAccess);
+    }
+
+    if (system.postupdate)
+    {
+      this->systemsPostupdate.push_back(system.postupdate);
+      this->systemsPostupdateOwner.push_back(systemIndex);
+    }
+  }
+
+  this->RebuildUpdateBatches();
+}
 
-    this->postUpdateStartBarrier =
-      std::make_unique<Barrier>(this->systemsPostupdate.size() + 1);
-    this->postUpdateStopBarrier =
-      std::make_unique<Barrier>(this->systemsPostupdate.size() + 1);
+/////////////////////////////////////////////////
+void SimulationRunner::RebuildUpdateBatches()
+{
+  this->updateBatches.clear();
 
-    this->postUpdateThreadsRunning = true;
-    int id = 0;
+  const size_t count = this->systemsUpdate.size();
 
-    for (auto &system : this->systemsPostupdate)
+  // Cache the declared access sets. Systems without declared access
+  // conflict with everything and act as scheduling barriers.
+  std::vector<std::unordered_set<ComponentTypeId>> reads(count);
+  std::vector<std::unordered_set<ComponentTypeId>> writes(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (nullptr != this->systemsUpdateAccess[i])
     {
-      igndbg << "Creating postupdate worker thread (" << id << ")" << std::endl;
+      reads[i] = this->systemsUpdateAccess[i]->UpdateReadSet();
+      writes[i] = this->systemsUpdateAccess[i]->UpdateWriteSet();
+    }
+  }
 
-      this->postUpdateThreads.push_back(std::thread([&, id]()
-      {
-        std::stringstream ss;
-        ss << "PostUpdateThread: " << id;
-        IGN_PROFILE_THREAD_NAME(ss.str().c_str());
-        while (this->postUpdateThreadsRunning)
-        {
-          this->postUpdateStartBarrier->Wait();
-          if (this->postUpdateThreadsRunning)
-          {
-            system->PostUpdate(this->currentInfo, this->entityCompMgr);
-          }
-          this->postUpdateStopBarrier->Wait();
-        }
-        igndbg << "Exiting postupdate worker thread ("
-          << id << ")" << std::endl;
-      }));
-      id++;
+  auto overlaps = [](const std::unordered_set<ComponentTypeId> &_a,
+      const std::unordered_set<ComponentTypeId> &_b) -> bool
+  {
+    for (const ComponentTypeId type : _a)
+    {
+      if (_b.find(type) != _b.end())
+        return true;
+    }
+    return false;
+  };
+
+  // Two systems conflict when either one doesn't declare its access, or
+  // one's writes overlap the other's reads or writes. Systems with
+  // declared, non-conflicting access commute, so they can be scheduled
+  // side by side even when other systems were added between them.
+  auto conflicts = [&](size_t _i, size_t _j) -> bool
+  {
+    if (nullptr == this->systemsUpdateAccess[_i] ||
+        nullptr == this->systemsUpdateAccess[_j])
+    {
+      return true;
+    }
+    return overlaps(writes[_i], writes[_j]) ||
+           overlaps(writes[_i], reads[_j]) ||
+           overlaps(reads[_i], writes[_j]);
+  };
+
+  // Each system depends on every earlier system it conflicts with. The
+  // resulting DAG is scheduled in levels: a system's level is one more
+  // than the deepest level among its dependencies, and all systems on a
+  // level execute concurrently. The number of systems is small, so the
+  // quadratic pass is fine here; this only runs when systems are added.
+  std::vector<size_t> levels(count, 0);
+  size_t maxLevel = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t j = 0; j < i; ++j)
+    {
+      if (conflicts(i, j))
+        levels[i] = std::max(levels[i], levels[j] + 1);
     }
+    maxLevel = std::max(maxLevel, levels[i]);
+  }
+
+  this->updateBatches.resize(count == 0 ? 0 : maxLevel + 1);
+  for (size_t i = 0; i < count; ++i)
+    this->updateBatches[levels[i]].push_back(i);
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::ProcessSystemQueue()
+{
+  std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
+
+  for (const auto &system : this->pendingSystems)
+  {
+    this->AddSystemToRunner(system);
   }
+
+  this->pendingSystems.clear();
 }
 
 /////////////////////////////////////////////////
@@ -444,31 +709,312 @@ void SimulationRunner::UpdateSystems()
   // \todo(nkoenig)  Systems used to be updated in parallel using
   // an ignition::common::WorkerPool. There is overhead associated with
   // this, most notably the creation and destruction of WorkOrders (see
-  // WorkerPool.cc). We could turn on parallel updates in the future, and/or
-  // turn it on if there are sufficient systems. More testing is required.
+  // WorkerPool.cc). The Update phase now runs systems with declared,
+  // non-conflicting access sets concurrently; PreUpdate remains
+  // sequential. More testing is required before parallelizing further.
+
+  // Recycle the PreUpdate/Update phase arena. Nothing from the previous
+  // step's intra-step phases can still be alive here, and the reset
+  // grows the buffer to the previous step's high-water mark, so steady
+  // state settles out of the heap.
+  this->updateArena.Reset();
+  this->currentInfo.arena = &this->updateArena;
+
+  // Refresh throttling state. A system with a declared update period
+  // becomes due when enough simulation time has accumulated, or while
+  // paused so it keeps responding to user interaction. When a throttled
+  // system is due, its UpdateInfo is snapshotted with dt widened to the
+  // accumulated simulation time, so nothing is lost over skipped steps.
+  for (auto &system : this->systems)
+  {
+    if (system.updatePeriod <= std::chrono::steady_clock::duration::zero())
+      continue;
+
+    system.accumulatedDt += this->currentInfo.dt;
+    system.due = this->currentInfo.paused ||
+        system.accumulatedDt >= system.updatePeriod;
+    if (system.due)
+    {
+      system.throttledInfo = this->currentInfo;
+      system.throttledInfo.dt = system.accumulatedDt;
+      system.accumulatedDt = std::chrono::steady_clock::duration::zero();
+    }
+  }
+
+  // Pick the info a system sees: throttled systems get the snapshot
+  // carrying the accumulated dt, everyone else the shared current info.
+  auto infoFor = [this](const SystemInternal &_system) -> const UpdateInfo *
+  {
+    return _system.updatePeriod > std::chrono::steady_clock::duration::zero() ?
+        &_system.throttledInfo : &this->currentInfo;
+  };
+
+  // Governor shedding: while steps keep overrunning their deadline,
+  // sheddable systems are skipped so the rest of the world holds its
+  // rate. Paused steps still run everything so the GUI stays live, and
+  // unthrottled systems get their due flag restored once shedding ends.
+  for (auto &system : this->systems)
+  {
+    if (!system.sheddable)
+      continue;
+    if (this->shedding && !this->currentInfo.paused)
+      system.due = false;
+    else if (system.updatePeriod <= std::chrono::steady_clock::duration::zero())
+      system.due = true;
+  }
 
   {
     IGN_PROFILE("PreUpdate");
-    for (auto& system : this->systemsPreupdate)
-      system->PreUpdate(this->currentInfo, this->entityCompMgr);
+    const auto phaseStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < this->systemsPreupdate.size(); ++i)
+    {
+      const auto &owner = this->systems[this->systemsPreupdateOwner[i]];
+      if (!owner.due)
+        continue;
+      const auto startTime = std::chrono::steady_clock::now();
+      this->systemsPreupdate[i]->PreUpdate(*infoFor(owner),
+          this->entityCompMgr);
+      owner.timings->preUpdate.Record(
+          std::chrono::steady_clock::now() - startTime);
+    }
+    this->stepPreUpdateTime = std::chrono::steady_clock::now() - phaseStart;
   }
 
   {
     IGN_PROFILE("Update");
-    for (auto& system : this->systemsUpdate)
-      system->Update(this->currentInfo, this->entityCompMgr);
+    const auto phaseStart = std::chrono::steady_clock::now();
+    // Systems that declared access sets via ISystemUpdateAccess are
+    // scheduled in dependency levels and each level runs concurrently.
+    // Systems that didn't declare anything are on levels of their own
+    // and run on this thread, in the order they were added.
+    for (const auto &batch : this->updateBatches)
+    {
+      if (batch.size() == 1)
+      {
+        const size_t index = batch.front();
+        const auto &owner = this->systems[this->systemsUpdateOwner[index]];
+        if (owner.due)
+        {
+          const auto startTime = std::chrono::steady_clock::now();
+          this->systemsUpdate[index]->Update(*infoFor(owner),
+              this->entityCompMgr);
+          owner.timings->update.Record(
+              std::chrono::steady_clock::now() - startTime);
+        }
+        continue;
+      }
+
+      bool submitted{false};
+      for (const size_t index : batch)
+      {
+        const auto &owner = this->systems[this->systemsUpdateOwner[index]];
+        if (!owner.due)
+          continue;
+
+        auto system = this->systemsUpdate[index];
+        const UpdateInfo *info = infoFor(owner);
+        auto *timings = owner.timings.get();
+        this->workerPool.AddWork([this, system, info, timings]()
+        {
+          const auto startTime = std::chrono::steady_clock::now();
+          system->Update(*info, this->entityCompMgr);
+          timings->update.Record(
+              std::chrono::steady_clock::now() - startTime);
+        });
+        submitted = true;
+      }
+      if (submitted)
+        this->workerPool.WaitForResults();
+    }
+    this->stepUpdateTime = std::chrono::steady_clock::now() - phaseStart;
   }
 
   {
     IGN_PROFILE("PostUpdate");
-    // If no systems implementing PostUpdate have been added, then
-    // the barriers will be uninitialized, so guard against that condition.
-    if (this->postUpdateStartBarrier && this->postUpdateStopBarrier)
+    const auto phaseStart = std::chrono::steady_clock::now();
+    this->stepPostUpdateTime = std::chrono::steady_clock::duration::zero();
+    // Fixed-step batching: with an update batch size of N, the
+    // PostUpdate phase runs once every N steps with dt widened over the
+    // whole batch, while PreUpdate and Update above keep running every
+    // step so physics and controllers integrate at full rate. Pausing
+    // flushes the batch so the GUI stays responsive.
+    this->batchedDt += this->currentInfo.dt;
+    if (++this->substepCount < this->updateBatchSize &&
+        !this->currentInfo.paused)
+    {
+      return;
+    }
+    // Best-effort PostUpdate: if the previous batch is still running,
+    // skip this cycle instead of stalling the step on it. The step's
+    // changed-component delta is buffered for the snapshot refresh and
+    // the batched dt keeps accumulating, so the catch-up batch covers
+    // the whole skipped interval. The backlog is bounded; past the cap
+    // the step falls through to the blocking wait below, so a consumer
+    // that never catches up degrades into the non-best-effort behavior
+    // instead of growing the buffer without limit.
+    if (this->postUpdatePipelined && this->postUpdateBestEffort &&
+        this->postUpdateInFlight && !this->currentInfo.paused &&
+        0u != this->postUpdatePending.load(std::memory_order_acquire))
+    {
+      static constexpr std::size_t kMaxPendingSnapshotDeltas{64};
+      if (this->pendingSnapshotDeltas.size() < kMaxPendingSnapshotDeltas)
+      {
+        IGN_PROFILE("SkipPostUpdateCycle");
+        this->pendingSnapshotDeltas.emplace_back();
+        this->entityCompMgr.ChangedState(this->pendingSnapshotDeltas.back());
+        this->substepCount = 0;
+        return;
+      }
+    }
+
+    this->postUpdateInfo = this->currentInfo;
+    this->postUpdateInfo.dt = this->batchedDt;
+    this->substepCount = 0;
+    this->batchedDt = std::chrono::steady_clock::duration::zero();
+
+    // In pipelined mode, PostUpdate systems read a snapshot manager on
+    // their own pool and the next step's PreUpdate/Update overlap them.
+    // The snapshot is refreshed here with this step's changed-component
+    // state, after waiting out the previous batch that was reading it.
+    const EntityComponentManager *postUpdateEcm = &this->entityCompMgr;
+    if (this->postUpdatePipelined)
+    {
+      if (this->postUpdateInFlight)
+      {
+        IGN_PROFILE("WaitPreviousPostUpdate");
+        this->WaitPostUpdateWork(*this->postUpdatePool);
+        this->postUpdateInFlight = false;
+      }
+
+      {
+        IGN_PROFILE("RefreshPostUpdateSnapshot");
+        // The previous batch has consumed the snapshot's new and
+        // removed entities; retire them before applying this step's
+        // delta, mirroring the live manager's end-of-step bookkeeping.
+        this->postUpdateCompMgr.ClearNewlyCreatedEntities();
+        this->postUpdateCompMgr.ProcessRemoveEntityRequests();
+        this->postUpdateCompMgr.SetAllComponentsUnchanged();
+
+        // Deltas buffered over skipped best-effort cycles replay in
+        // step order before this step's delta, so the snapshot never
+        // misses an intermediate change.
+        for (const auto &pendingDelta : this->pendingSnapshotDeltas)
+          this->postUpdateCompMgr.SetState(pendingDelta);
+        this->pendingSnapshotDeltas.clear();
+
+        msgs::SerializedStateMap delta;
+        this->entityCompMgr.ChangedState(delta);
+        this->postUpdateCompMgr.SetState(delta);
+      }
+      postUpdateEcm = &this->postUpdateCompMgr;
+    }
+
+    // PostUpdate gets its own arena: pipelined batches overlap later
+    // steps, so the Update arena's once-per-step reset would pull
+    // memory out from under them. This one is only recycled here, after
+    // the previous batch has been waited out above. Each task's copied
+    // info points at it below.
+    this->postUpdateArena.Reset();
+
+    // PostUpdate has read-only access to the ECM, so every system is
+    // submitted to the worker pool as a task and the step synchronizes
+    // once on the pool instead of handshaking a start and a stop
+    // barrier with one dedicated thread per system. The pool balances
+    // uneven systems across its fixed set of threads.
+    common::WorkerPool &pool = this->postUpdatePipelined ?
+        *this->postUpdatePool : this->workerPool;
+    bool submitted{false};
+    for (size_t i = 0; i < this->systemsPostupdate.size(); ++i)
+    {
+      const auto &owner = this->systems[this->systemsPostupdateOwner[i]];
+      if (!owner.due)
+        continue;
+
+      auto system = this->systemsPostupdate[i];
+      // Throttled systems keep their own accumulated dt; everyone else
+      // sees the batch-wide info. The info is captured by value: a
+      // pipelined batch outlives this scope, and the next step rewrites
+      // the shared structs while the batch is still reading them. The
+      // copy also swaps in this phase's arena for the Update arena the
+      // throttled snapshot was taken with, so a batch never reads from
+      // an arena being reset under it.
+      UpdateInfo info =
+          owner.updatePeriod > std::chrono::steady_clock::duration::zero() ?
+          owner.throttledInfo : this->postUpdateInfo;
+      info.arena = &this->postUpdateArena;
+      auto *timings = owner.timings.get();
+      // Each task counts itself off, so the step thread can poll the
+      // counter for completion instead of sleeping on the pool.
+      this->postUpdatePending.fetch_add(1, std::memory_order_relaxed);
+      auto *pending = &this->postUpdatePending;
+      pool.AddWork([system, info, timings, postUpdateEcm, pending]()
+      {
+        const auto startTime = std::chrono::steady_clock::now();
+        system->PostUpdate(info, *postUpdateEcm);
+        timings->postUpdate.Record(
+            std::chrono::steady_clock::now() - startTime);
+        pending->fetch_sub(1, std::memory_order_release);
+      });
+      submitted = true;
+    }
+    if (submitted)
+    {
+      // Pipelined batches are waited out just before the next snapshot
+      // refresh, so the next step's phases overlap them.
+      if (this->postUpdatePipelined)
+        this->postUpdateInFlight = true;
+      else
+        this->WaitPostUpdateWork(this->workerPool);
+    }
+    this->stepPostUpdateTime = std::chrono::steady_clock::now() - phaseStart;
+  }
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::WaitPostUpdateWork(common::WorkerPool &_pool)
+{
+  const auto waitStart = std::chrono::steady_clock::now();
+
+  if (this->postUpdateSpinWait)
+  {
+    // The last worker to finish usually does so within a few
+    // microseconds of the step thread arriving here, so sleeping on the
+    // pool's condition variable pays a wake latency on every step. Poll
+    // the pending-task counter instead, in bursts of relaxed loads that
+    // grow exponentially with a yield between them, and give up after a
+    // fraction of the update period so an expensive batch still sleeps.
+    auto budget = this->updatePeriod / 4;
+    const auto maxBudget =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::microseconds(200));
+    if (budget <= std::chrono::steady_clock::duration::zero() ||
+        budget > maxBudget)
+    {
+      budget = maxBudget;
+    }
+
+    unsigned int burst = 32u;
+    while (0u != this->postUpdatePending.load(std::memory_order_acquire))
     {
-      this->postUpdateStartBarrier->Wait();
-      this->postUpdateStopBarrier->Wait();
+      for (unsigned int i = 0u; i < burst; ++i)
+      {
+        if (0u == this->postUpdatePending.load(std::memory_order_relaxed))
+          break;
+      }
+      if (std::chrono::steady_clock::now() - waitStart >= budget)
+        break;
+      std::this_thread::yield();
+      burst = std::min(burst * 2u, 4096u);
     }
   }
+
+  // Always synchronize with the pool: it returns immediately once the
+  // spin has observed the counter at zero, and it is what makes the
+  // workers' writes visible to the step thread.
+  _pool.WaitForResults();
+
+  this->postUpdateWaitHist.Record(
+      std::chrono::steady_clock::now() - waitStart);
 }
 
 /////////////////////////////////////////////////
@@ -484,25 +1030,6 @@ void SimulationRunner::OnStop()
   this->running = false;
 }
 
-/////////////////////////////////////////////////
-void SimulationRunner::StopWorkerThreads()
-{
-  this->postUpdateThreadsRunning = false;
-  if (this->postUpdateStartBarrier)
-  {
-    this->postUpdateStartBarrier->Cancel();
-  }
-  if (this->postUpdateStopBarrier)
-  {
-    this->postUpdateStopBarrier->Cancel();
-  }
-  for (auto &thread : this->postUpdateThreads)
-  {
-    thread.join();
-  }
-  this->postUpdateThreads.clear();
-}
-
 /////////////////////////////////////////////////
 bool SimulationRunner::Run(const uint64_t _iterations)
 {
@@ -513,6 +1040,11 @@ bool SimulationRunner::Run(const uint64_t _iterations)
   // in the design.
   IGN_PROFILE_THREAD_NAME("SimulationRunner");
 
+  // Pin the step thread, if configured. The worker pool was pinned by
+  // inheriting the constructing thread's mask.
+  if (!this->cpuAffinity.empty())
+    detail::SetCurrentThreadAffinity(this->cpuAffinity);
+
   // Initialize network communications.
   if (this->networkMgr)
   {
@@ -585,6 +1117,38 @@ bool SimulationRunner::Run(const uint64_t _iterations)
   if (!this->clockPub.Valid())
     this->clockPub = this->node->Advertise<ignition::msgs::Clock>("clock");
 
+  // Create the system timing statistics publisher.
+  if (!this->systemStatsPub.Valid())
+  {
+    this->systemStatsPub =
+        this->node->Advertise<private_msgs::SystemStatistics_V>(
+        "system_stats");
+  }
+
+  // Create the memory statistics publisher.
+  if (!this->memoryStatsPub.Valid())
+  {
+    this->memoryStatsPub =
+        this->node->Advertise<private_msgs::MemoryStatistics>(
+        "memory_stats");
+  }
+
+  // Create the step deadline diagnostics publisher.
+  if (!this->stepDiagnosticsPub.Valid())
+  {
+    this->stepDiagnosticsPub =
+        this->node->Advertise<private_msgs::StepDiagnostics>(
+        "step_diagnostics");
+  }
+
+  // Create the automatic flight-recorder dump publisher.
+  if (!this->stepTracePub.Valid())
+  {
+    this->stepTracePub =
+        this->node->Advertise<private_msgs::StepTrace>(
+        "step_trace");
+  }
+
   // Create the global clock publisher.
   if (!this->rootClockPub.Valid())
   {
@@ -628,8 +1192,26 @@ bool SimulationRunner::Run(const uint64_t _iterations)
     sleepTime = 0ns;
     actualSleep = 0ns;
 
+    // When pacing a distributed primary, lead the nominal period by
+    // the estimated network delay to the slowest secondary, so the
+    // step notification is on the wire early enough for secondaries to
+    // start on time instead of stalling behind transport latency. The
+    // estimate is smoothed over heartbeats, so the lead shifts the
+    // phase of the loop rather than oscillating it.
+    std::chrono::steady_clock::duration stepLead{0};
+    if (this->networkMgr)
+    {
+      auto netPrimary =
+          dynamic_cast<NetworkManagerPrimary *>(this->networkMgr.get());
+      if (netPrimary)
+      {
+        stepLead = std::min(netPrimary->StepLeadTime(),
+            this->updatePeriod / 2);
+      }
+    }
+
     sleepTime = std::max(0ns, this->prevUpdateRealTime +
-        this->updatePeriod - std::chrono::steady_clock::now() -
+        this->updatePeriod - stepLead - std::chrono::steady_clock::now() -
         this->sleepOffset);
 
     // Only sleep if needed.
@@ -664,14 +1246,62 @@ bool SimulationRunner::Run(const uint64_t _iterations)
           dynamic_cast<NetworkManagerPrimary *>(this->networkMgr.get());
       netPrimary->Step(this->currentInfo);
     }
+    else if (this->stepCoordinator)
+    {
+      // Take turns with the other runners in this process. The step's
+      // own duration is reported so a runner that overruns its period
+      // sits out later rotations instead of crowding out the rest.
+      this->stepCoordinator->BeginStep(this->stepCoordinatorId);
+      const auto stepStart = std::chrono::steady_clock::now();
+      this->Step(this->currentInfo);
+      this->stepCoordinator->EndStep(this->stepCoordinatorId,
+          std::chrono::steady_clock::now() - stepStart,
+          this->updatePeriod > 0ns ? this->updatePeriod
+                                   : std::chrono::milliseconds(1));
+    }
     else
     {
+      // Run-ahead: the previous iteration left the world speculatively
+      // ahead of confirmed time. Roll it back to the confirmed frontier
+      // so this step integrates the commands that actually arrived
+      // instead of the held ones the speculation assumed.
+      if (this->runAheadDepth > 0)
+      {
+        IGN_PROFILE("RunAheadRollback");
+        this->entityCompMgr.RestoreState(this->runAheadSnapshot);
+        this->runAheadDepth = 0;
+      }
+
       this->Step(this->currentInfo);
+
+      if (this->runAheadSteps > 0 && !this->currentInfo.paused)
+        this->RunAhead();
     }
   }
 
+  // Let the other runners keep rotating without this one.
+  if (this->stepCoordinator)
+    this->stepCoordinator->Release(this->stepCoordinatorId);
+
   this->running = false;
 
+  // Run anything still queued so no service handler is left waiting on
+  // its future after the loop exits.
+  for (auto &task : this->stepTasks.DrainAll())
+    this->pendingStepTasks.push_back(std::move(task));
+  while (!this->pendingStepTasks.empty())
+  {
+    this->pendingStepTasks.front()();
+    this->pendingStepTasks.pop_front();
+  }
+
+  // Don't leave pipelined PostUpdate work running past the loop.
+  if (this->postUpdateInFlight)
+  {
+    this->postUpdatePool->WaitForResults();
+    this->postUpdateInFlight = false;
+  }
+
   return true;
 }
 
@@ -681,8 +1311,11 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   IGN_PROFILE("SimulationRunner::Step");
   this->currentInfo = _info;
 
+  const auto stepStart = std::chrono::steady_clock::now();
+
   // Publish info
   this->PublishStats();
+  this->stepPublishTime = std::chrono::steady_clock::now() - stepStart;
 
   // Record when the update step starts.
   this->prevUpdateRealTime = std::chrono::steady_clock::now();
@@ -695,6 +1328,12 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   // Update all the systems.
   this->UpdateSystems();
 
+  // Record the end-of-step world poses of the tracked entities, so
+  // consumers such as rendering sensors can interpolate poses at
+  // times that fall between steps.
+  if (!this->currentInfo.paused)
+    this->entityCompMgr.RecordPoseHistories(this->currentInfo.simTime);
+
   if (!this->Paused() && this->pendingSimIterations > 0)
   {
     // Decrement the pending sim iterations, if there are any.
@@ -710,6 +1349,42 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   // Process world control messages.
   this->ProcessMessages();
 
+  // Run work posted by service handlers, now that systems are done
+  // touching the ECM for this step.
+  this->ProcessStepTasks();
+
+  // Dispatch queued event emissions, bounded so slow subscribers can't
+  // stall the step for more than one budget's worth of callbacks.
+  static const std::size_t kDeferredEventBudget{128u};
+  const std::size_t deferredEvents =
+      this->eventMgr.ProcessDeferred(kDeferredEventBudget);
+
+  // Snapshot entity churn for the flight recorder before the lists are
+  // cleared below.
+  const std::size_t newEntities = this->entityCompMgr.NewEntityCount();
+  const std::size_t removedEntities =
+      this->entityCompMgr.MarkedForRemovalCount();
+
+  // Checksum the step's changes while the change-tracking data is
+  // still intact.
+  if (this->stateChecksumFile.is_open() && !this->currentInfo.paused)
+    this->WriteStateChecksum();
+
+  // Emit the per-step entity lifecycle batches before the lists below are
+  // cleared, so one event covers everything created or removed this step,
+  // e.g. a whole level load or unload, and handlers can still query the
+  // entities' components.
+  if (newEntities > 0)
+  {
+    this->eventMgr.Emit<events::EntitiesAdded>(
+        this->entityCompMgr.NewEntities());
+  }
+  if (this->entityCompMgr.HasEntitiesMarkedForRemoval())
+  {
+    this->eventMgr.Emit<events::EntitiesRemoved>(
+        this->entityCompMgr.EntitiesMarkedForRemoval());
+  }
+
   // Clear all new entities
   this->entityCompMgr.ClearNewlyCreatedEntities();
 
@@ -719,12 +1394,95 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   // Each network manager takes care of marking its components as unchanged
   if (!this->networkMgr)
     this->entityCompMgr.SetAllComponentsUnchanged();
+
+  if (!this->currentInfo.paused)
+  {
+    const auto stepDuration = std::chrono::steady_clock::now() - stepStart;
+
+    auto toNs = [](const std::chrono::steady_clock::duration &_d) -> uint64_t
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(_d).count();
+    };
+
+    StepTraceRecord record;
+    record.iterations = this->currentInfo.iterations;
+    record.stepNs = toNs(stepDuration);
+    record.preUpdateNs = toNs(this->stepPreUpdateTime);
+    record.updateNs = toNs(this->stepUpdateTime);
+    record.postUpdateNs = toNs(this->stepPostUpdateTime);
+    record.publishNs = toNs(this->stepPublishTime);
+    record.newEntities = static_cast<uint32_t>(newEntities);
+    record.removedEntities = static_cast<uint32_t>(removedEntities);
+    record.worldControlMsgs = this->stepWorldControlMsgs;
+    record.deferredEvents = static_cast<uint32_t>(deferredEvents);
+
+    // Per-step deltas of the cumulative ECM churn counters.
+    const auto churn = this->entityCompMgr.Churn();
+    record.componentsCreated = static_cast<uint32_t>(
+        churn.componentsCreated - this->lastTraceChurn.componentsCreated);
+    record.componentsRemoved = static_cast<uint32_t>(
+        churn.componentsRemoved - this->lastTraceChurn.componentsRemoved);
+    record.viewsUpdated = static_cast<uint32_t>(
+        churn.viewsUpdated - this->lastTraceChurn.viewsUpdated);
+    this->lastTraceChurn = churn;
+
+    this->RecordStepTrace(record);
+
+    this->GovernorRecordStep(stepDuration);
+  }
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::RunAhead()
+{
+  IGN_PROFILE("SimulationRunner::RunAhead");
+
+  // The step above is the confirmed frontier: every command that had
+  // arrived is integrated into it. Snapshot it, then simulate the
+  // speculative lead with commands held at their latest values. The
+  // systems publish as the speculative steps run, so operators see a
+  // prediction of their inputs' effect one step after sending them,
+  // instead of after the whole step+publish+render pipeline. The next
+  // paced iteration rolls back to the snapshot and repairs the
+  // prediction with the commands that actually arrived; when nothing
+  // new arrived the repair reproduces the same states.
+  //
+  // Only the dynamic state rolls back: entities spawned or removed
+  // during a speculative step stay, like any other side effect a
+  // system performs outside the ECM.
+  this->runAheadSnapshot = this->entityCompMgr.SnapshotState();
+  const UpdateInfo frontierInfo = this->currentInfo;
+
+  for (unsigned int i = 0; i < this->runAheadSteps; ++i)
+  {
+    this->currentInfo.simTime += this->stepSize;
+    ++this->currentInfo.iterations;
+    this->currentInfo.dt = this->stepSize;
+    this->UpdateSystems();
+
+    // The end-of-step bookkeeping Step() would do, so per-step change
+    // tracking works for the speculative steps too. Stats, traces and
+    // control message processing stay with confirmed steps.
+    this->entityCompMgr.ClearNewlyCreatedEntities();
+    this->entityCompMgr.ProcessRemoveEntityRequests();
+    this->entityCompMgr.SetAllComponentsUnchanged();
+    ++this->runAheadDepth;
+  }
+
+  // The lead is display-only; confirmed time carries on from the
+  // frontier.
+  this->currentInfo = frontierInfo;
 }
 
 //////////////////////////////////////////////////
 void SimulationRunner::LoadPlugins(const Entity _entity,
     const sdf::ElementPtr &_sdf)
 {
+  // Configure calls are collected while loading and scheduled together
+  // at the end, so independent systems initialize concurrently. See
+  // ConfigureSystems.
+  std::vector<PendingConfigure> pendingConfigures;
+
   sdf::ElementPtr pluginElem = _sdf->GetElement("plugin");
   while (pluginElem)
   {
@@ -736,23 +1494,59 @@ void SimulationRunner::LoadPlugins(const Entity _entity,
     if (pluginElem->Get<std::string>("filename") != "__default__" &&
         pluginElem->Get<std::string>("name") != "__default__")
     {
-      std::optional<SystemPluginPtr> system;
+      if (this->serverConfig.RenderPluginsDisabled() &&
+          IsRenderPlugin(pluginElem->Get<std::string>("filename")))
       {
-        std::lock_guard<std::mutex> lock(this->systemLoaderMutex);
-        system = this->systemLoader->LoadPlugin(pluginElem);
+        ignmsg << "Skipped render-dependent system ["
+               << pluginElem->Get<std::string>("name") << "]" << std::endl;
+        pluginElem = pluginElem->GetNextElement("plugin");
+        continue;
       }
-      if (system)
+
+      // Statically registered systems are linked into the process, so
+      // they skip path resolution and library loading entirely.
+      auto staticSystem = StaticSystemRegistry::Instantiate(
+          pluginElem->Get<std::string>("name"));
+      if (staticSystem)
       {
-        auto systemConfig = system.value()->QueryInterface<ISystemConfigure>();
+        auto *systemConfig =
+            dynamic_cast<ISystemConfigure *>(staticSystem.get());
         if (systemConfig != nullptr)
         {
-          systemConfig->Configure(_entity, pluginElem,
-              this->entityCompMgr,
-              this->eventMgr);
+          pendingConfigures.push_back({systemConfig,
+              pluginElem->Get<std::string>("name"), _entity, pluginElem,
+              nullptr != dynamic_cast<ISystemConfigureParallel *>(
+                  staticSystem.get())});
         }
-        this->AddSystem(system.value());
-        igndbg << "Loaded system [" << pluginElem->Get<std::string>("name")
-               << "] for entity [" << _entity << "]" << std::endl;
+        this->AddSystem(staticSystem, pluginElem->Get<std::string>("name"),
+            pluginElem, _entity);
+        igndbg << "Loaded statically registered system ["
+               << pluginElem->Get<std::string>("name") << "] for entity ["
+               << _entity << "]" << std::endl;
+        pluginElem = pluginElem->GetNextElement("plugin");
+        continue;
+      }
+
+      std::optional<SystemPluginPtr> system;
+      {
+        std::lock_guard<std::mutex> lock(this->systemLoaderMutex);
+        system = this->systemLoader->LoadPlugin(pluginElem);
+      }
+      if (system)
+      {
+        auto systemConfig = system.value()->QueryInterface<ISystemConfigure>();
+        if (systemConfig != nullptr)
+        {
+          pendingConfigures.push_back({systemConfig,
+              pluginElem->Get<std::string>("name"), _entity, pluginElem,
+              nullptr != system.value()->
+                  QueryInterface<ISystemConfigureParallel>()});
+        }
+        this->AddSystem(system.value(),
+            pluginElem->Get<std::string>("filename"),
+            pluginElem->Get<std::string>("name"), pluginElem, _entity);
+        igndbg << "Loaded system [" << pluginElem->Get<std::string>("name")
+               << "] for entity [" << _entity << "]" << std::endl;
       }
     }
 
@@ -824,6 +1618,32 @@ void SimulationRunner::LoadPlugins(const Entity _entity,
     if (entity != _entity)
       continue;
 
+    if (this->serverConfig.RenderPluginsDisabled() &&
+        IsRenderPlugin(plugin.Filename()))
+    {
+      ignmsg << "Skipped render-dependent system [" << plugin.Name()
+             << "]" << std::endl;
+      continue;
+    }
+
+    auto staticSystem = StaticSystemRegistry::Instantiate(plugin.Name());
+    if (staticSystem)
+    {
+      auto *systemConfig =
+          dynamic_cast<ISystemConfigure *>(staticSystem.get());
+      if (systemConfig != nullptr)
+      {
+        pendingConfigures.push_back({systemConfig, plugin.Name(), _entity,
+            plugin.Sdf(),
+            nullptr != dynamic_cast<ISystemConfigureParallel *>(
+                staticSystem.get())});
+      }
+      this->AddSystem(staticSystem, plugin.Name(), plugin.Sdf(), _entity);
+      igndbg << "Loaded statically registered system [" << plugin.Name()
+             << "] for entity [" << _entity << "]" << std::endl;
+      continue;
+    }
+
     std::optional<SystemPluginPtr> system;
     {
       std::lock_guard<std::mutex> lock(this->systemLoaderMutex);
@@ -836,14 +1656,82 @@ void SimulationRunner::LoadPlugins(const Entity _entity,
       auto systemConfig = system.value()->QueryInterface<ISystemConfigure>();
       if (systemConfig != nullptr)
       {
-        systemConfig->Configure(_entity, plugin.Sdf(), this->entityCompMgr,
-                                this->eventMgr);
+        pendingConfigures.push_back({systemConfig, plugin.Name(), _entity,
+            plugin.Sdf(),
+            nullptr != system.value()->
+                QueryInterface<ISystemConfigureParallel>()});
       }
-      this->AddSystem(system.value());
+      this->AddSystem(system.value(), plugin.Filename(), plugin.Name(),
+          plugin.Sdf(), _entity);
       igndbg << "Loaded system [" << plugin.Name()
              << "] for entity [" << _entity << "]" << std::endl;
     }
   }
+
+  this->ConfigureSystems(pendingConfigures);
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::ConfigureSystems(
+    const std::vector<PendingConfigure> &_pending)
+{
+  if (_pending.empty())
+    return;
+
+  IGN_PROFILE("SimulationRunner::ConfigureSystems");
+  const auto loadStart = std::chrono::steady_clock::now();
+
+  // Durations are recorded per call and reported once the pool has
+  // settled, so the workers don't contend on the console.
+  std::vector<std::chrono::steady_clock::duration> durations(_pending.size());
+
+  auto configureOne = [this, &_pending, &durations](const std::size_t _i)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    _pending[_i].configure->Configure(_pending[_i].entity, _pending[_i].sdf,
+        this->entityCompMgr, this->eventMgr);
+    durations[_i] = std::chrono::steady_clock::now() - start;
+  };
+
+  // Dispatch in load order. Opted-in systems overlap on the worker
+  // pool; an unmarked system is a barrier: everything dispatched before
+  // it finishes first, then it configures alone. Sequencing is the
+  // default because existing systems predate the marker and may mutate
+  // the ECM from Configure.
+  bool dispatched{false};
+  for (std::size_t i = 0; i < _pending.size(); ++i)
+  {
+    if (!_pending[i].parallel)
+    {
+      if (dispatched)
+      {
+        this->workerPool.WaitForResults();
+        dispatched = false;
+      }
+      configureOne(i);
+      continue;
+    }
+
+    this->workerPool.AddWork([configureOne, i]()
+    {
+      configureOne(i);
+    });
+    dispatched = true;
+  }
+  if (dispatched)
+    this->workerPool.WaitForResults();
+
+  for (std::size_t i = 0; i < _pending.size(); ++i)
+  {
+    igndbg << "Configured system [" << _pending[i].name << "] in "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(
+               durations[i]).count() << " ms"
+           << (_pending[i].parallel ? " (parallel)" : "") << std::endl;
+  }
+  igndbg << "Configured " << _pending.size() << " systems in "
+         << std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - loadStart).count()
+         << " ms" << std::endl;
 }
 
 /////////////////////////////////////////////////
@@ -920,8 +1808,6 @@ void SimulationRunner::SetPaused(const bool _paused)
 bool SimulationRunner::OnWorldControl(const msgs::WorldControl &_req,
     msgs::Boolean &_res)
 {
-  std::lock_guard<std::mutex> lock(this->msgBufferMutex);
-
   WorldControl control;
   control.pause = _req.pause();
 
@@ -945,7 +1831,7 @@ bool SimulationRunner::OnWorldControl(const msgs::WorldControl &_req,
     ignwarn << "Changing seed is not supported." << std::endl;
   }
 
-  this->worldControls.push_back(control);
+  this->worldControls.Push(control);
 
   _res.set_data(true);
   return true;
@@ -955,8 +1841,6 @@ bool SimulationRunner::OnWorldControl(const msgs::WorldControl &_req,
 bool SimulationRunner::OnPlaybackControl(const msgs::LogPlaybackControl &_req,
     msgs::Boolean &_res)
 {
-  std::lock_guard<std::mutex> lock(this->msgBufferMutex);
-
   WorldControl control;
   control.pause = _req.pause();
   control.multiStep = _req.multi_step();
@@ -973,7 +1857,7 @@ bool SimulationRunner::OnPlaybackControl(const msgs::LogPlaybackControl &_req,
     ignwarn << "Log forwarding is not supported, use seek." << std::endl;
   }
 
-  this->worldControls.push_back(control);
+  this->worldControls.Push(control);
 
   _res.set_data(true);
   return true;
@@ -983,7 +1867,6 @@ bool SimulationRunner::OnPlaybackControl(const msgs::LogPlaybackControl &_req,
 void SimulationRunner::ProcessMessages()
 {
   IGN_PROFILE("SimulationRunner::ProcessMessages");
-  std::lock_guard<std::mutex> lock(this->msgBufferMutex);
   this->ProcessWorldControl();
 }
 
@@ -991,7 +1874,9 @@ void SimulationRunner::ProcessMessages()
 void SimulationRunner::ProcessWorldControl()
 {
   IGN_PROFILE("SimulationRunner::ProcessWorldControl");
-  for (const auto &control : this->worldControls)
+  const auto controls = this->worldControls.DrainAll();
+  this->stepWorldControlMsgs = static_cast<uint32_t>(controls.size());
+  for (const auto &control : controls)
   {
     // Play / pause
     this->SetPaused(control.pause);
@@ -1013,8 +1898,6 @@ void SimulationRunner::ProcessWorldControl()
       this->requestedSeek = control.seek;
     }
   }
-
-  this->worldControls.clear();
 }
 
 /////////////////////////////////////////////////
@@ -1130,6 +2013,344 @@ bool SimulationRunner::RequestRemoveEntity(const Entity _entity,
   return false;
 }
 
+//////////////////////////////////////////////////
+void SimulationRunner::FillSystemStats(
+    private_msgs::SystemStatistics_V &_msg) const
+{
+  _msg.set_iterations(this->currentInfo.iterations);
+
+  auto fill = [](const DurationHistogram &_hist,
+      private_msgs::PhaseStatistics *_out)
+  {
+    _out->set_count(_hist.Count());
+    _out->set_total_ns(_hist.TotalNs());
+    _out->set_max_ns(_hist.MaxNs());
+    _out->set_p50_ns(_hist.PercentileNs(0.5));
+    _out->set_p90_ns(_hist.PercentileNs(0.9));
+    _out->set_p99_ns(_hist.PercentileNs(0.99));
+  };
+
+  for (const auto &system : this->systems)
+  {
+    auto *stats = _msg.add_systems();
+    stats->set_name(system.timings->name);
+
+    if (system.preupdate)
+      fill(system.timings->preUpdate, stats->mutable_pre_update());
+    if (system.update)
+      fill(system.timings->update, stats->mutable_update());
+    if (system.postupdate)
+      fill(system.timings->postUpdate, stats->mutable_post_update());
+  }
+
+  if (this->postUpdateWaitHist.Count() > 0u)
+    fill(this->postUpdateWaitHist, _msg.mutable_post_update_wait());
+
+  const auto churn = this->entityCompMgr.Churn();
+  auto *churnMsg = _msg.mutable_churn();
+  churnMsg->set_entities_created(churn.entitiesCreated);
+  churnMsg->set_entities_removed(churn.entitiesRemoved);
+  churnMsg->set_components_created(churn.componentsCreated);
+  churnMsg->set_components_removed(churn.componentsRemoved);
+  churnMsg->set_views_updated(churn.viewsUpdated);
+
+  auto *factory = components::Factory::Instance();
+  for (const auto &[typeId, counts] : this->entityCompMgr.ComponentChurn())
+  {
+    auto *component = churnMsg->add_components();
+    component->set_name(factory->Name(typeId));
+    component->set_created(counts.first);
+    component->set_removed(counts.second);
+  }
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::SystemStatsService(
+    private_msgs::SystemStatistics_V &_res)
+{
+  _res.Clear();
+
+  // ProcessSystemQueue holds this mutex while appending to systems, so
+  // taking it here keeps the walk over systems safe from the transport
+  // thread. The histograms themselves can be read while recordings are
+  // in flight.
+  std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
+  this->FillSystemStats(_res);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::FillMemoryStats(
+    private_msgs::MemoryStatistics &_msg) const
+{
+  _msg.set_iterations(this->currentInfo.iterations);
+  _msg.set_entity_count(this->entityCompMgr.EntityCount());
+
+  auto *factory = components::Factory::Instance();
+
+  uint64_t storageBytes = 0;
+  for (const auto &[typeId, usage] : this->entityCompMgr.StorageMemory())
+  {
+    auto *storage = _msg.add_storages();
+    storage->set_name(factory->Name(typeId));
+    storage->set_bytes(usage.first);
+    storage->set_component_count(usage.second);
+    storageBytes += usage.first;
+  }
+  _msg.set_storage_bytes(storageBytes);
+
+  uint64_t viewBytes = 0;
+  for (const auto &[key, bytes] : this->entityCompMgr.ViewMemory())
+  {
+    auto *view = _msg.add_views();
+    std::string names;
+    for (const ComponentTypeId typeId : key)
+    {
+      if (!names.empty())
+        names += ",";
+      names += factory->Name(typeId);
+    }
+    view->set_component_types(names);
+    view->set_bytes(bytes);
+    viewBytes += bytes;
+  }
+  _msg.set_view_bytes(viewBytes);
+
+  _msg.set_dropped_messages(BoundedPublisher::TotalDroppedCount());
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::RecordStepTrace(const StepTraceRecord &_record)
+{
+  const uint64_t head = this->stepTraceHead.load(std::memory_order_relaxed);
+  this->stepTrace[head % kStepTraceSize] = _record;
+  // Publish the new head after the record is complete, so a reader that
+  // acquires it sees fully written records behind it.
+  this->stepTraceHead.store(head + 1, std::memory_order_release);
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::FillStepTrace(private_msgs::StepTrace &_msg) const
+{
+  const uint64_t head = this->stepTraceHead.load(std::memory_order_acquire);
+  const uint64_t count = std::min(head, kStepTraceSize);
+
+  // Copy the raw records first; proto allocation is kept off the window
+  // where the step thread could lap us.
+  std::vector<StepTraceRecord> records(count);
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    records[i] = this->stepTrace[(head - count + i) % kStepTraceSize];
+  }
+
+  // Records overwritten while the copy was in progress are the oldest
+  // ones; drop them so no torn record makes it into the dump.
+  const uint64_t newHead =
+      this->stepTraceHead.load(std::memory_order_acquire);
+  const uint64_t lapped = std::min(newHead - head, count);
+
+  for (uint64_t i = lapped; i < count; ++i)
+  {
+    const auto &record = records[i];
+    auto *step = _msg.add_steps();
+    step->set_iterations(record.iterations);
+    step->set_step_ns(record.stepNs);
+    step->set_pre_update_ns(record.preUpdateNs);
+    step->set_update_ns(record.updateNs);
+    step->set_post_update_ns(record.postUpdateNs);
+    step->set_publish_ns(record.publishNs);
+    step->set_new_entities(record.newEntities);
+    step->set_removed_entities(record.removedEntities);
+    step->set_world_control_msgs(record.worldControlMsgs);
+    step->set_deferred_events(record.deferredEvents);
+    step->set_components_created(record.componentsCreated);
+    step->set_components_removed(record.componentsRemoved);
+    step->set_views_updated(record.viewsUpdated);
+  }
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::StepTraceService(private_msgs::StepTrace &_res)
+{
+  _res.Clear();
+  this->FillStepTrace(_res);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::GovernorRecordStep(
+    const std::chrono::steady_clock::duration &_stepDuration)
+{
+  // Steps that overrun this many times in a row trigger shedding, and
+  // this many steps back within deadline restore the shed systems. The
+  // restore threshold is much larger so the governor doesn't oscillate
+  // when a world hovers around its deadline.
+  static constexpr uint64_t kShedAfterMisses{10};
+  static constexpr uint64_t kRestoreAfterHits{500};
+
+  // Without an update period there is no deadline to miss.
+  if (this->updatePeriod <= 0ns)
+    return;
+
+  const bool missed = _stepDuration > this->updatePeriod;
+  if (missed)
+  {
+    ++this->deadlineMisses;
+    ++this->consecutiveMisses;
+    this->consecutiveHits = 0;
+  }
+  else
+  {
+    ++this->consecutiveHits;
+    this->consecutiveMisses = 0;
+  }
+
+  // Publish diagnostics for missed deadlines, throttled to roughly one
+  // message per second so a persistent overload can't flood the topic.
+  auto now = std::chrono::steady_clock::now();
+  if (missed && this->stepDiagnosticsPub.Valid() &&
+      now - this->prevStepDiagnosticsPubTime >= std::chrono::seconds(1))
+  {
+    this->prevStepDiagnosticsPubTime = now;
+
+    auto toNs = [](const std::chrono::steady_clock::duration &_d) -> uint64_t
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(_d).count();
+    };
+
+    private_msgs::StepDiagnostics msg;
+    msg.set_iterations(this->currentInfo.iterations);
+    msg.set_deadline_ns(toNs(this->updatePeriod));
+    msg.set_step_ns(toNs(_stepDuration));
+    msg.set_pre_update_ns(toNs(this->stepPreUpdateTime));
+    msg.set_update_ns(toNs(this->stepUpdateTime));
+    msg.set_post_update_ns(toNs(this->stepPostUpdateTime));
+    msg.set_publish_ns(toNs(this->stepPublishTime));
+    msg.set_deadline_misses(this->deadlineMisses);
+    msg.set_shed_system_count(this->shedCount);
+    this->stepDiagnosticsPub.Publish(msg);
+  }
+
+  // Dump the flight recorder when a miss follows a clean stretch, so the
+  // trace still holds the steps leading up to the spike. Serializing the
+  // whole ring is too heavy to do on every miss, hence the long throttle.
+  if (missed && this->consecutiveMisses == 1 && this->stepTracePub.Valid() &&
+      now - this->prevStepTracePubTime >= std::chrono::seconds(10))
+  {
+    this->prevStepTracePubTime = now;
+    private_msgs::StepTrace traceMsg;
+    this->FillStepTrace(traceMsg);
+    this->stepTracePub.Publish(traceMsg);
+  }
+
+  if (!this->governorEnabled)
+    return;
+
+  if (!this->shedding && this->consecutiveMisses >= kShedAfterMisses)
+  {
+    this->shedding = true;
+    this->shedCount = 0;
+    for (const auto &system : this->systems)
+    {
+      if (system.sheddable)
+        ++this->shedCount;
+    }
+    ignwarn << "Real time factor governor: shedding " << this->shedCount
+            << " low-priority systems after " << this->consecutiveMisses
+            << " consecutive deadline misses." << std::endl;
+  }
+  else if (this->shedding && this->consecutiveHits >= kRestoreAfterHits)
+  {
+    this->shedding = false;
+    ignmsg << "Real time factor governor: restoring " << this->shedCount
+           << " low-priority systems, steps are back within deadline."
+           << std::endl;
+    this->shedCount = 0;
+  }
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::WriteStateChecksum()
+{
+  IGN_PROFILE("SimulationRunner::WriteStateChecksum");
+
+  msgs::SerializedStateMap state;
+  this->entityCompMgr.ChangedState(state);
+
+  // FNV-1a, accumulated per component type so a divergence between two
+  // runs names the component that drifted, not just the step. The
+  // entity id is mixed in ahead of each component so equal values
+  // swapped between entities don't cancel out.
+  auto mix = [](uint64_t &_sum, const void *_data, std::size_t _len)
+  {
+    auto *bytes = static_cast<const unsigned char *>(_data);
+    for (std::size_t i = 0; i < _len; ++i)
+    {
+      _sum ^= bytes[i];
+      _sum *= 0x100000001b3u;
+    }
+  };
+  static constexpr uint64_t kFnvOffset{0xcbf29ce484222325u};
+
+  // Type 0 accumulates entity removals, which have no component left to
+  // hash. Creations show up through their components.
+  std::map<ComponentTypeId, uint64_t> sums;
+  for (const auto &entityPair : state.entities())
+  {
+    const uint64_t entityId = entityPair.first;
+    const auto &entityMsg = entityPair.second;
+
+    if (entityMsg.remove())
+    {
+      auto sum = sums.insert({0u, kFnvOffset}).first;
+      mix(sum->second, &entityId, sizeof(entityId));
+    }
+
+    for (const auto &compPair : entityMsg.components())
+    {
+      const auto typeId = static_cast<ComponentTypeId>(compPair.first);
+      auto sum = sums.insert({typeId, kFnvOffset}).first;
+      mix(sum->second, &entityId, sizeof(entityId));
+      const bool removed = compPair.second.remove();
+      mix(sum->second, &removed, sizeof(removed));
+      mix(sum->second, compPair.second.component().data(),
+          compPair.second.component().size());
+    }
+  }
+
+  // Name each type the first time it appears, so the diff tool can
+  // report names instead of ids.
+  for (const auto &typeSums : sums)
+  {
+    const auto typeId = typeSums.first;
+    if (!this->checksumTypesSeen.insert(typeId).second)
+      continue;
+    this->stateChecksumFile << "# type " << typeId << " "
+        << (typeId == 0u ? "entity_removal" :
+            components::Factory::Instance()->Name(typeId)) << "\n";
+  }
+
+  // One line per step: the iteration count, then type:checksum pairs
+  // in type order so identical runs produce byte-identical lines.
+  this->stateChecksumFile << this->currentInfo.iterations;
+  for (const auto &[typeId, sum] : sums)
+  {
+    this->stateChecksumFile << ' ' << typeId << ':'
+        << std::hex << sum << std::dec;
+  }
+  this->stateChecksumFile << '\n';
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::MemoryStatsService(
+    private_msgs::MemoryStatistics &_res)
+{
+  _res.Clear();
+  this->FillMemoryStats(_res);
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool SimulationRunner::GuiInfoService(ignition::msgs::GUI &_res)
 {
@@ -1140,21 +2361,322 @@ bool SimulationRunner::GuiInfoService(ignition::msgs::GUI &_res)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool SimulationRunner::ReloadSystems(const std::string &_filename)
+{
+  // Fold queued systems in first so one pending from the same library
+  // can't bypass the reload.
+  this->ProcessSystemQueue();
+
+  // A pipelined PostUpdate batch may still be reading through the old
+  // instances; wait it out before destroying them.
+  if (this->postUpdateInFlight)
+  {
+    this->postUpdatePool->WaitForResults();
+    this->postUpdateInFlight = false;
+  }
+
+  // Quiesce: save the state of every instance from the library, then
+  // drop the instances. The SystemPluginPtrs hold the library open, so
+  // all of them have to go before the loader can close it.
+  struct ReloadRecord
+  {
+    std::string name;
+    sdf::ElementPtr sdf;
+    Entity entity;
+    std::string state;
+    bool hasState{false};
+  };
+  std::vector<ReloadRecord> records;
+  for (auto iter = this->systems.begin(); iter != this->systems.end();)
+  {
+    if (iter->filename != _filename)
+    {
+      ++iter;
+      continue;
+    }
+
+    ReloadRecord record;
+    record.name = iter->name;
+    record.sdf = iter->configureSdf;
+    record.entity = iter->configureEntity;
+    if (nullptr != iter->handoff)
+    {
+      record.state = iter->handoff->SaveState();
+      record.hasState = true;
+    }
+    records.push_back(std::move(record));
+    iter = this->systems.erase(iter);
+  }
+
+  if (records.empty())
+  {
+    ignwarn << "No system loaded from [" << _filename
+            << "], nothing to reload." << std::endl;
+    return false;
+  }
+
+  this->RebuildSystemVectors();
+
+  {
+    std::lock_guard<std::mutex> lock(this->systemLoaderMutex);
+    this->systemLoader->UnloadLibrary(_filename);
+  }
+
+  bool result = true;
+  for (const auto &record : records)
+  {
+    std::optional<SystemPluginPtr> system;
+    {
+      std::lock_guard<std::mutex> lock(this->systemLoaderMutex);
+      system = this->systemLoader->LoadPlugin(_filename, record.name,
+          record.sdf);
+    }
+    if (!system)
+    {
+      ignerr << "Failed to reload system [" << record.name << "] from ["
+             << _filename << "]." << std::endl;
+      result = false;
+      continue;
+    }
+
+    auto systemConfig = system.value()->QueryInterface<ISystemConfigure>();
+    if (nullptr != systemConfig)
+    {
+      systemConfig->Configure(record.entity, record.sdf,
+          this->entityCompMgr, this->eventMgr);
+    }
+
+    auto handoff = system.value()->QueryInterface<ISystemStateHandoff>();
+    if (nullptr != handoff && record.hasState)
+      handoff->RestoreState(record.state);
+
+    SystemInternal reloaded(system.value());
+    reloaded.filename = _filename;
+    reloaded.name = record.name;
+    reloaded.configureSdf = record.sdf;
+    reloaded.configureEntity = record.entity;
+    this->AddSystemToRunner(reloaded);
+
+    ignmsg << "Reloaded system [" << record.name << "] from ["
+           << _filename << "]" << std::endl;
+  }
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::ReloadSystemsService(const msgs::StringMsg &_req,
+    msgs::Boolean &_res)
+{
+  // Reload on the stepping thread between steps, so no update phase is
+  // mid-flight through the instances being replaced. Only this
+  // transport thread blocks while it waits.
+  bool result = false;
+  auto future = this->RequestStepTask([&]()
+  {
+    result = this->ReloadSystems(_req.data());
+  });
+  future.wait();
+
+  _res.set_data(result);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::CheckpointService(const msgs::StringMsg &_req,
+    msgs::Boolean &_res)
+{
+  // Serialize on the stepping thread between steps, so the state is a
+  // consistent step-boundary snapshot. Only this transport thread
+  // blocks while it waits.
+  bool result = false;
+  auto future = this->RequestStepTask([&]()
+  {
+    result = this->WriteCheckpoint(_req.data());
+  });
+  future.wait();
+
+  _res.set_data(result);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::WriteCheckpoint(const std::string &_path)
+{
+  IGN_PROFILE("SimulationRunner::WriteCheckpoint");
+
+  private_msgs::Checkpoint checkpoint;
+  checkpoint.set_world_name(this->worldName);
+  checkpoint.set_iterations(this->currentInfo.iterations);
+  checkpoint.set_sim_time_ns(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+      this->currentInfo.simTime).count());
+
+  this->entityCompMgr.State(*checkpoint.mutable_state(), {}, {}, true);
+
+  for (const auto &system : this->systems)
+  {
+    if (nullptr == system.handoff || system.name.empty())
+      continue;
+    auto *systemState = checkpoint.add_system_state();
+    systemState->set_name(system.name);
+    systemState->set_state(system.handoff->SaveState());
+  }
+
+  std::ofstream file(_path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    ignerr << "Failed to open checkpoint file [" << _path
+           << "] for writing." << std::endl;
+    return false;
+  }
+
+  if (!checkpoint.SerializeToOstream(&file))
+  {
+    ignerr << "Failed to serialize checkpoint to [" << _path << "]"
+           << std::endl;
+    return false;
+  }
+
+  ignmsg << "Wrote checkpoint of world [" << this->worldName << "] at "
+         << checkpoint.iterations() << " iterations to [" << _path << "]"
+         << std::endl;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::RestoreCheckpoint(const std::string &_path)
+{
+  std::ifstream file(_path, std::ios::binary);
+  if (!file.is_open())
+  {
+    ignerr << "Failed to open checkpoint file [" << _path << "]"
+           << std::endl;
+    return false;
+  }
+
+  private_msgs::Checkpoint checkpoint;
+  if (!checkpoint.ParseFromIstream(&file))
+  {
+    ignerr << "Failed to parse checkpoint file [" << _path << "]"
+           << std::endl;
+    return false;
+  }
+
+  // Checkpoints only apply to the world they were taken from; other
+  // worlds of a multi-world server skip the file.
+  if (checkpoint.world_name() != this->worldName)
+  {
+    ignwarn << "Checkpoint [" << _path << "] was taken from world ["
+            << checkpoint.world_name() << "], not [" << this->worldName
+            << "]. Skipping restore." << std::endl;
+    return false;
+  }
+
+  // The SDF world was already loaded, so its entities exist with the
+  // same ids as in the original run; laying the full state over them
+  // also recreates anything spawned after load.
+  this->entityCompMgr.SetState(checkpoint.state());
+
+  this->currentInfo.iterations = checkpoint.iterations();
+  this->currentInfo.simTime =
+      std::chrono::nanoseconds(checkpoint.sim_time_ns());
+
+  // System state is handed out in AddSystemToRunner: systems are still
+  // pending when the constructor restores a checkpoint.
+  for (const auto &systemState : checkpoint.system_state())
+    this->checkpointSystemState[systemState.name()] = systemState.state();
+
+  ignmsg << "Restored world [" << this->worldName << "] from checkpoint ["
+         << _path << "] at " << checkpoint.iterations() << " iterations."
+         << std::endl;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::future<void> SimulationRunner::RequestStepTask(
+    std::function<void()> _task)
+{
+  std::packaged_task<void()> task(std::move(_task));
+  auto future = task.get_future();
+
+  // Without a stepping thread nothing drains the queue, and nothing
+  // races the ECM either, so run the task here.
+  if (!this->running)
+  {
+    task();
+    return future;
+  }
+
+  this->stepTasks.Push(std::move(task));
+  return future;
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::ProcessStepTasks()
+{
+  IGN_PROFILE("SimulationRunner::ProcessStepTasks");
+
+  for (auto &task : this->stepTasks.DrainAll())
+    this->pendingStepTasks.push_back(std::move(task));
+
+  if (this->pendingStepTasks.empty())
+    return;
+
+  // A budget keeps a burst of expensive requests, e.g. scene snapshots
+  // for several new GUI connections, from stalling the step; leftovers
+  // run on the following steps.
+  static constexpr std::chrono::milliseconds kStepTaskBudget{2};
+  const auto start = std::chrono::steady_clock::now();
+
+  while (!this->pendingStepTasks.empty())
+  {
+    this->pendingStepTasks.front()();
+    this->pendingStepTasks.pop_front();
+
+    if (std::chrono::steady_clock::now() - start >= kStepTaskBudget)
+      break;
+  }
+}
+
 //////////////////////////////////////////////////
 bool SimulationRunner::GenerateWorldSdf(const msgs::SdfGeneratorConfig &_req,
                                         msgs::StringMsg &_res)
 {
-  // TODO(addisu) This is not thread-safe. Wait until it is safe to access the
-  // ECM.
-  Entity world = this->entityCompMgr.EntityByComponents(components::World());
-  std::optional<std::string> genString = sdf_generator::generateWorld(
-      this->entityCompMgr, world, this->fuelUriMap, _req);
-  if (genString.has_value())
+  // Generate on the stepping thread between system updates, so the
+  // generator sees a consistent ECM. Only this transport thread blocks
+  // while it waits.
+  bool result = false;
+  auto future = this->RequestStepTask([&]()
   {
-    _res.set_data(*genString);
-    return true;
-  }
-  return false;
+    Entity world =
+        this->entityCompMgr.EntityByComponents(components::World());
+    std::optional<std::string> genString = sdf_generator::generateWorld(
+        this->entityCompMgr, world, this->sdfGenCache, this->fuelUriMap,
+        _req);
+    if (genString.has_value())
+    {
+      _res.set_data(*genString);
+      result = true;
+    }
+  });
+  future.wait();
+  return result;
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::SetCpuAffinity(const std::vector<unsigned int> &_cpus)
+{
+  this->cpuAffinity = _cpus;
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::SetStepCoordinator(RunnerCoordinator *_coordinator,
+    const std::size_t _id)
+{
+  this->stepCoordinator = _coordinator;
+  this->stepCoordinatorId = _id;
 }
 
 //////////////////////////////////////////////////
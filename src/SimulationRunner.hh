@@ -21,12 +21,17 @@
 #include <ignition/msgs/log_playback_control.pb.h>
 #include <ignition/msgs/sdf_generator_config.pb.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <fstream>
 #include <functional>
+#include <future>
 #include <list>
 #include <memory>
 #include <string>
+#include <thread>
+#include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -41,18 +46,25 @@
 
 #include "ignition/gazebo/config.hh"
 #include "ignition/gazebo/Conversions.hh"
+#include "ignition/gazebo/detail/MpscQueue.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/EventManager.hh"
 #include "ignition/gazebo/Export.hh"
 #include "ignition/gazebo/ServerConfig.hh"
+#include "ignition/gazebo/StepArena.hh"
 #include "ignition/gazebo/System.hh"
 #include "ignition/gazebo/SystemLoader.hh"
 #include "ignition/gazebo/SystemPluginPtr.hh"
 #include "ignition/gazebo/Types.hh"
 
+#include "msgs/memory_statistics.pb.h"
+#include "msgs/step_diagnostics.pb.h"
+#include "msgs/system_statistics.pb.h"
 #include "network/NetworkManager.hh"
+#include "RunnerCoordinator.hh"
+#include "SdfGenerator.hh"
 #include "LevelManager.hh"
-#include "Barrier.hh"
+#include "SystemTimings.hh"
 
 using namespace std::chrono_literals;
 
@@ -88,6 +100,52 @@ namespace ignition
       std::chrono::steady_clock::duration seek{-1};
     };
 
+    /// \brief One step's record in the flight-recorder ring buffer.
+    /// Plain data so recording a step is a handful of stores.
+    struct StepTraceRecord
+    {
+      /// \brief Number of elapsed simulation iterations at this step.
+      uint64_t iterations{0};
+
+      /// \brief Wall-clock duration of the step in nanoseconds.
+      uint64_t stepNs{0};
+
+      /// \brief Wall-clock duration of the PreUpdate phase.
+      uint64_t preUpdateNs{0};
+
+      /// \brief Wall-clock duration of the Update phase.
+      uint64_t updateNs{0};
+
+      /// \brief Wall-clock duration of the PostUpdate phase. Zero on
+      /// steps where update batching skipped the phase.
+      uint64_t postUpdateNs{0};
+
+      /// \brief Wall-clock duration of stats and clock publishing.
+      uint64_t publishNs{0};
+
+      /// \brief Number of entities created during the step.
+      uint32_t newEntities{0};
+
+      /// \brief Number of entities marked for removal during the step.
+      uint32_t removedEntities{0};
+
+      /// \brief Number of world control messages drained during the
+      /// step.
+      uint32_t worldControlMsgs{0};
+
+      /// \brief Number of deferred events dispatched during the step.
+      uint32_t deferredEvents{0};
+
+      /// \brief Number of components created during the step.
+      uint32_t componentsCreated{0};
+
+      /// \brief Number of components removed during the step.
+      uint32_t componentsRemoved{0};
+
+      /// \brief Number of view membership refreshes during the step.
+      uint32_t viewsUpdated{0};
+    };
+
     /// \brief Class to hold systems internally
     class SystemInternal
     {
@@ -97,14 +155,58 @@ namespace ignition
                 system(systemPlugin->QueryInterface<System>()),
                 preupdate(systemPlugin->QueryInterface<ISystemPreUpdate>()),
                 update(systemPlugin->QueryInterface<ISystemUpdate>()),
-                postupdate(systemPlugin->QueryInterface<ISystemPostUpdate>())
+                updateAccess(systemPlugin->QueryInterface<ISystemUpdateAccess>()),
+                postupdate(systemPlugin->QueryInterface<ISystemPostUpdate>()),
+                handoff(systemPlugin->QueryInterface<ISystemStateHandoff>())
+      {
+        auto periodIface =
+            this->systemPlugin->QueryInterface<ISystemUpdatePeriod>();
+        if (periodIface)
+          this->updatePeriod = periodIface->UpdatePeriod();
+
+        this->sheddable =
+            nullptr != this->systemPlugin->QueryInterface<ISystemSheddable>();
+
+        // The concrete class name identifies the system in timing
+        // statistics. It is implementation-defined and typically mangled,
+        // but the system's name is always recognizable in it.
+        this->timings = std::make_shared<SystemTimings>(
+            nullptr != this->system ?
+            typeid(*this->system).name() : "unknown");
+      }
+
+      /// \brief Construct from a statically registered system, which
+      /// has no plugin library behind it. See StaticSystemRegistry.
+      public: explicit SystemInternal(std::shared_ptr<System> _system)
+              : systemShared(std::move(_system)),
+                system(systemShared.get()),
+                preupdate(dynamic_cast<ISystemPreUpdate *>(system)),
+                update(dynamic_cast<ISystemUpdate *>(system)),
+                updateAccess(dynamic_cast<ISystemUpdateAccess *>(system)),
+                postupdate(dynamic_cast<ISystemPostUpdate *>(system)),
+                handoff(dynamic_cast<ISystemStateHandoff *>(system))
       {
+        auto periodIface = dynamic_cast<ISystemUpdatePeriod *>(this->system);
+        if (periodIface)
+          this->updatePeriod = periodIface->UpdatePeriod();
+
+        this->sheddable =
+            nullptr != dynamic_cast<ISystemSheddable *>(this->system);
+
+        this->timings = std::make_shared<SystemTimings>(
+            nullptr != this->system ?
+            typeid(*this->system).name() : "unknown");
       }
 
       /// \brief Plugin object. This manages the lifecycle of the instantiated
       /// class as well as the shared library.
       public: SystemPluginPtr systemPlugin;
 
+      /// \brief Owns a system that came from the static registry
+      /// instead of a plugin library. Null for plugin-loaded systems,
+      /// whose lifetime systemPlugin manages.
+      public: std::shared_ptr<System> systemShared;
+
       /// \brief Access this system via the `System` interface
       public: System *system = nullptr;
 
@@ -116,12 +218,61 @@ namespace ignition
       /// Will be nullptr if the System doesn't implement this interface.
       public: ISystemUpdate *update = nullptr;
 
+      /// \brief Access this system via the ISystemUpdateAccess interface
+      /// Will be nullptr if the System doesn't implement this interface.
+      public: ISystemUpdateAccess *updateAccess = nullptr;
+
       /// \brief Access this system via the ISystemPostUpdate interface
       /// Will be nullptr if the System doesn't implement this interface.
       public: ISystemPostUpdate *postupdate = nullptr;
 
+      /// \brief Access this system via the ISystemStateHandoff interface
+      /// Will be nullptr if the System doesn't implement this interface.
+      public: ISystemStateHandoff *handoff = nullptr;
+
+      /// \brief Shared library filename the system was loaded from.
+      /// Empty for systems added without provenance, which can't be hot
+      /// reloaded.
+      public: std::string filename;
+
+      /// \brief Plugin class name the system was instantiated as.
+      public: std::string name;
+
+      /// \brief SDF element the system was configured with, kept so a
+      /// reloaded instance can be configured the same way. May be null.
+      public: sdf::ElementPtr configureSdf;
+
+      /// \brief Entity the system was configured for.
+      public: Entity configureEntity{kNullEntity};
+
       /// \brief Vector of queries and callbacks
       public: std::vector<EntityQueryCallback> updates;
+
+      /// \brief Minimum simulation time between this system's updates.
+      /// Zero, the default, updates the system on every step. See
+      /// ISystemUpdatePeriod.
+      public: std::chrono::steady_clock::duration updatePeriod{0};
+
+      /// \brief Simulation time accumulated since the system last ran.
+      /// Only maintained for systems with a non-zero updatePeriod.
+      public: std::chrono::steady_clock::duration accumulatedDt{0};
+
+      /// \brief Whether the system runs on the current step. Refreshed at
+      /// the start of every call to SimulationRunner::UpdateSystems.
+      public: bool due{true};
+
+      /// \brief Update info handed to a throttled system when it runs.
+      /// Its dt carries the simulation time accumulated over the skipped
+      /// steps.
+      public: UpdateInfo throttledInfo;
+
+      /// \brief Whether the system may be skipped by the real time
+      /// factor governor. See ISystemSheddable.
+      public: bool sheddable{false};
+
+      /// \brief Timing histograms for this system's phases. Held through
+      /// a shared pointer so SystemInternal stays copyable.
+      public: std::shared_ptr<SystemTimings> timings;
     };
 
     class IGNITION_GAZEBO_VISIBLE SimulationRunner
@@ -143,9 +294,6 @@ namespace ignition
       /// \brief Internal method for handling stop event (to prevent recursion)
       private: void OnStop();
 
-      /// \brief Stop and join all post update worker threads
-      private: void StopWorkerThreads();
-
       /// \brief Run the simulationrunner.
       /// \param[in] _iterations Number of iterations.
       /// \return True if the operation completed successfully.
@@ -164,9 +312,50 @@ namespace ignition
       /// \param[in] _system System to be added
       public: void AddSystem(const SystemPluginPtr &_system);
 
+      /// \brief Add a system to the runner together with where it came
+      /// from, so it can be hot reloaded later. See AddSystem.
+      /// \param[in] _system System to be added
+      /// \param[in] _filename Shared library filename it was loaded from.
+      /// \param[in] _name Plugin class name it was instantiated as.
+      /// \param[in] _sdf SDF element it was configured with. May be null.
+      /// \param[in] _entity Entity it was configured for.
+      public: void AddSystem(const SystemPluginPtr &_system,
+                  const std::string &_filename, const std::string &_name,
+                  const sdf::ElementPtr &_sdf, const Entity _entity);
+
+      /// \brief Add a statically registered system to the runner. The
+      /// system has no shared library behind it, so it cannot be hot
+      /// reloaded. See StaticSystemRegistry.
+      /// \param[in] _system System to be added.
+      /// \param[in] _name Plugin class name it was registered under.
+      /// \param[in] _sdf SDF element it was configured with. May be null.
+      /// \param[in] _entity Entity it was configured for.
+      public: void AddSystem(const std::shared_ptr<System> &_system,
+                  const std::string &_name, const sdf::ElementPtr &_sdf,
+                  const Entity _entity);
+
+      /// \brief Reload every system loaded from the given shared
+      /// library: serialize state through ISystemStateHandoff where
+      /// implemented, destroy the instances, drop the library from the
+      /// loader cache so the rebuilt binary is opened, then configure
+      /// fresh instances and restore their state. Must run on the
+      /// stepping thread between steps; use the `systems/reload` service
+      /// from outside.
+      /// \param[in] _filename Shared library filename to reload.
+      /// \return True if at least one system was reloaded.
+      public: bool ReloadSystems(const std::string &_filename);
+
       /// \brief Update all the systems
       public: void UpdateSystems();
 
+      /// \brief Wait for the PostUpdate tasks submitted to a worker
+      /// pool to finish, optionally spinning on the pending-task
+      /// counter before falling back to the pool's blocking wait. The
+      /// wait duration is recorded for the system statistics message.
+      /// \param[in] _pool The pool the PostUpdate tasks were submitted
+      /// to.
+      private: void WaitPostUpdateWork(common::WorkerPool &_pool);
+
       /// \brief Publish current world statistics.
       public: void PublishStats();
 
@@ -307,9 +496,127 @@ namespace ignition
       /// \return True if successful.
       private: bool GuiInfoService(ignition::msgs::GUI &_res);
 
+      /// \brief Callback for the system reload service. Runs
+      /// ReloadSystems on the stepping thread at a step boundary.
+      /// \param[in] _req Request holding the plugin filename to reload.
+      /// \param[out] _res True when at least one system was reloaded.
+      /// \return True if successful.
+      private: bool ReloadSystemsService(const msgs::StringMsg &_req,
+                   msgs::Boolean &_res);
+
+      /// \brief Callback for the system timing statistics service.
+      /// \param[out] _res Response containing per-system phase durations
+      /// and percentiles.
+      /// \return True if successful.
+      private: bool SystemStatsService(
+                   private_msgs::SystemStatistics_V &_res);
+
+      /// \brief Fill a message with the per-system timing statistics
+      /// recorded so far.
+      /// \param[out] _msg Message to fill.
+      private: void FillSystemStats(
+                   private_msgs::SystemStatistics_V &_msg) const;
+
+      /// \brief Callback for the memory statistics service.
+      /// \param[out] _res Response containing per-storage and per-view
+      /// memory accounting.
+      /// \return True if successful.
+      private: bool MemoryStatsService(
+                   private_msgs::MemoryStatistics &_res);
+
+      /// \brief Fill a message with the current entity component manager
+      /// memory accounting.
+      /// \param[out] _msg Message to fill.
+      private: void FillMemoryStats(
+                   private_msgs::MemoryStatistics &_msg) const;
+
+      /// \brief Record the wall-clock duration of the step that just
+      /// finished, publish diagnostics when the step missed its real
+      /// time deadline, and drive the governor's shedding state. Called
+      /// at the end of every unpaused step.
+      /// \param[in] _stepDuration Wall-clock duration of the step.
+      private: void GovernorRecordStep(
+                   const std::chrono::steady_clock::duration &_stepDuration);
+
+      /// \brief Append one record to the flight-recorder ring buffer.
+      /// Called at the end of every unpaused step; the cost is copying
+      /// one plain struct and one atomic store.
+      /// \param[in] _record The step's record.
+      private: void RecordStepTrace(const StepTraceRecord &_record);
+
+      /// \brief Copy the flight-recorder ring buffer into a message,
+      /// oldest step first. Records overwritten while the copy was in
+      /// progress are dropped, so the result is never torn.
+      /// \param[out] _msg Message to fill.
+      private: void FillStepTrace(private_msgs::StepTrace &_msg) const;
+
+      /// \brief Callback for the flight-recorder dump service.
+      /// \param[out] _res Response containing the last recorded steps.
+      /// \return True if successful.
+      private: bool StepTraceService(private_msgs::StepTrace &_res);
+
+      /// \brief Callback for the checkpoint service. Writes the world
+      /// to the requested file on the stepping thread at a step
+      /// boundary.
+      /// \param[in] _req Path of the checkpoint file to write.
+      /// \param[out] _res True if the checkpoint was written.
+      /// \return True if successful.
+      private: bool CheckpointService(const msgs::StringMsg &_req,
+                   msgs::Boolean &_res);
+
+      /// \brief Write a checkpoint of the world to a file: iteration
+      /// count and simulation time, the full ECM state, and the state
+      /// of every system implementing ISystemStateHandoff. Must run at
+      /// a step boundary.
+      /// \param[in] _path Path of the file to write.
+      /// \return True if the checkpoint was written.
+      private: bool WriteCheckpoint(const std::string &_path);
+
+      /// \brief Restore a checkpoint written by WriteCheckpoint. Lays
+      /// the saved ECM state over the freshly loaded world, restores
+      /// iteration count and simulation time, and stashes the
+      /// per-system state, which is handed to matching systems as they
+      /// are added to the runner. Called from the constructor when
+      /// ServerConfig::CheckpointRestorePath is set.
+      /// \param[in] _path Path of the checkpoint file.
+      /// \return True if the checkpoint was applied.
+      private: bool RestoreCheckpoint(const std::string &_path);
+
+      /// \brief Append one line to the state checksum log with a
+      /// checksum per component type of everything that changed during
+      /// the step. Uses the change-tracking data, so the cost scales
+      /// with the changed components, not the world. Called at the end
+      /// of every unpaused step while the log is open; two logs from
+      /// identical runs are byte-identical. See
+      /// ServerConfig::SetStateChecksumPath.
+      private: void WriteStateChecksum();
+
       /// \brief Calculate real time factor and populate currentInfo.
       private: void UpdateCurrentInfo();
 
+      /// \brief Snapshot the confirmed frontier and simulate
+      /// runAheadSteps speculative steps past it with commands held at
+      /// their latest values, so published state leads confirmed time.
+      /// Restores currentInfo to the frontier before returning; the
+      /// next paced step rolls the world state back and repairs the
+      /// speculation with the commands that actually arrived.
+      private: void RunAhead();
+
+      /// \brief Queue work to run on the stepping thread between system
+      /// updates. Service handlers use this to touch the ECM without
+      /// racing simulation: they enqueue the work and wait on the
+      /// returned future while only the transport thread blocks. Tasks
+      /// run once per step under a time budget; leftover tasks carry
+      /// over to the next step. When the runner isn't running, the task
+      /// executes inline since nothing is stepping concurrently.
+      /// \param[in] _task The work to run.
+      /// \return Future satisfied after the task has run.
+      public: std::future<void> RequestStepTask(std::function<void()> _task);
+
+      /// \brief Run queued step tasks until the queue empties or the
+      /// per-step time budget runs out. Called once per Step.
+      private: void ProcessStepTasks();
+
       /// \brief Process all buffered messages. Ths function is called at
       /// the end of an update iteration.
       private: void ProcessMessages();
@@ -319,7 +626,53 @@ namespace ignition
 
       /// \brief Actually add system to the runner
       /// \param[in] _system System to be added
-      public: void AddSystemToRunner(const SystemPluginPtr &_system);
+      public: void AddSystemToRunner(const SystemInternal &_system);
+
+      /// \brief One Configure call collected while loading plugins, so
+      /// the calls can be scheduled together once loading is done. See
+      /// ConfigureSystems.
+      private: struct PendingConfigure
+      {
+        /// \brief Configure interface of the loaded system.
+        public: ISystemConfigure *configure{nullptr};
+
+        /// \brief Name of the system, for timing output.
+        public: std::string name;
+
+        /// \brief Entity the system is attached to.
+        public: Entity entity{kNullEntity};
+
+        /// \brief SDF element to configure with.
+        public: sdf::ElementPtr sdf;
+
+        /// \brief True when the system opted into concurrent
+        /// configuration. See ISystemConfigureParallel.
+        public: bool parallel{false};
+      };
+
+      /// \brief Run collected Configure calls, concurrently where
+      /// allowed, and log per-system timing. Calls are dispatched onto
+      /// the worker pool in load order; opted-in systems overlap, while
+      /// an unmarked system waits out everything dispatched before it,
+      /// runs alone, and then dispatching resumes, so stretches of
+      /// opted-in systems are bounded by their slowest member instead
+      /// of the sum of all of them.
+      /// \param[in] _pending The collected calls, in load order.
+      private: void ConfigureSystems(
+                   const std::vector<PendingConfigure> &_pending);
+
+      /// \brief Rebuild the per-phase interface vectors and the Update
+      /// scheduling levels from the systems vector. Called after systems
+      /// are added or, on a reload, removed.
+      private: void RebuildSystemVectors();
+
+      /// \brief Rebuild the Update scheduling levels. Each system
+      /// depends on every earlier system it conflicts with (a write
+      /// overlapping the other's read or write, or either side not
+      /// declaring its access), and the dependency DAG is flattened
+      /// into levels that execute concurrently. Systems without
+      /// declared access act as barriers and get a level of their own.
+      private: void RebuildUpdateBatches();
 
       /// \brief Calls AddSystemToRunner to each system that is pending to be
       /// added.
@@ -333,6 +686,24 @@ namespace ignition
       public: bool GenerateWorldSdf(const msgs::SdfGeneratorConfig &_req,
                                     msgs::StringMsg &_res);
 
+      /// \brief Set the CPUs this runner's step thread runs on. Applied
+      /// at the start of Run. The worker pool inherits the mask from the
+      /// thread that constructed the runner; see
+      /// ServerConfig::SetCpuAffinity.
+      /// \param[in] _cpus CPU indices to run on. An empty list, the
+      /// default, leaves placement to the operating system.
+      public: void SetCpuAffinity(const std::vector<unsigned int> &_cpus);
+
+      /// \brief Put this runner's step loop under a coordinator, which
+      /// schedules the steps of every runner in the process round-robin
+      /// with deadline accounting. Must be called before Run. See
+      /// ServerConfig::SetStepCoordination.
+      /// \param[in] _coordinator The coordinator, which must outlive
+      /// Run. Null, the default, leaves the step loop free-running.
+      /// \param[in] _id This runner's slot index in the coordinator.
+      public: void SetStepCoordinator(RunnerCoordinator *_coordinator,
+                  const std::size_t _id);
+
       /// \brief Sets the file path to fuel URI map.
       /// \param[in] _map A populated map of file paths to fuel URIs.
       public: void SetFuelUriMap(
@@ -355,7 +726,7 @@ namespace ignition
       private: std::vector<SystemInternal> systems;
 
       /// \brief Pending systems to be added to systems.
-      private: std::vector<SystemPluginPtr> pendingSystems;
+      private: std::vector<SystemInternal> pendingSystems;
 
       /// \brief Mutex to protect pendingSystems
       private: mutable std::mutex pendingSystemsMutex;
@@ -366,12 +737,34 @@ namespace ignition
       /// \brief Systems implementing PreUpdate
       private: std::vector<ISystemPreUpdate *> systemsPreupdate;
 
+      /// \brief Indices into systems, parallel to systemsPreupdate. Used
+      /// to reach the owning SystemInternal for throttling state.
+      private: std::vector<size_t> systemsPreupdateOwner;
+
       /// \brief Systems implementing Update
       private: std::vector<ISystemUpdate *> systemsUpdate;
 
+      /// \brief Indices into systems, parallel to systemsUpdate.
+      private: std::vector<size_t> systemsUpdateOwner;
+
+      /// \brief Declared Update access sets, parallel to systemsUpdate.
+      /// An entry is nullptr for systems that don't implement
+      /// ISystemUpdateAccess.
+      private: std::vector<ISystemUpdateAccess *> systemsUpdateAccess;
+
+      /// \brief Update systems grouped into scheduling levels derived
+      /// from the dependency DAG over declared access sets. Each entry is
+      /// an index into systemsUpdate. Systems on one level are executed
+      /// concurrently; a level of one runs on the main thread. See
+      /// RebuildUpdateBatches().
+      private: std::vector<std::vector<size_t>> updateBatches;
+
       /// \brief Systems implementing PostUpdate
       private: std::vector<ISystemPostUpdate *> systemsPostupdate;
 
+      /// \brief Indices into systems, parallel to systemsPostupdate.
+      private: std::vector<size_t> systemsPostupdateOwner;
+
       /// \brief Manager of all events.
       private: EventManager eventMgr;
 
@@ -384,8 +777,17 @@ namespace ignition
       /// \brief Manager of distributing/receiving network work.
       private: std::unique_ptr<NetworkManager> networkMgr{nullptr};
 
-      /// \brief A pool of worker threads.
-      private: common::WorkerPool workerPool{2};
+      /// \brief A pool of worker threads, shared by the concurrent
+      /// Update levels and the PostUpdate phase. Sized from the server
+      /// configuration's thread budget for this world, one thread per
+      /// hardware thread by default.
+      private: common::WorkerPool workerPool;
+
+      /// \brief A separate pool for pipelined PostUpdate work, so waits
+      /// on the shared pool during the next step's Update phase don't
+      /// block on PostUpdate systems still reading the snapshot. Only
+      /// constructed in pipelined mode.
+      private: std::unique_ptr<common::WorkerPool> postUpdatePool;
 
       /// \brief Wall time of the previous update.
       private: std::chrono::steady_clock::time_point prevUpdateRealTime;
@@ -398,6 +800,87 @@ namespace ignition
       /// The default update rate is 500hz, which is a period of 2ms.
       private: std::chrono::steady_clock::duration updatePeriod{2ms};
 
+      /// \brief Number of simulation steps batched into one full system
+      /// sweep. The PostUpdate phase runs once per batch; the steps in
+      /// between run PreUpdate and Update only. See
+      /// ServerConfig::SetUpdateBatchSize.
+      private: unsigned int updateBatchSize{1};
+
+      /// \brief Number of steps taken in the current batch.
+      private: unsigned int substepCount{0};
+
+      /// \brief Number of steps simulated speculatively ahead of
+      /// confirmed time each paced step, for low-latency teleoperation.
+      /// See ServerConfig::SetRunAheadSteps. Zero disables run-ahead.
+      private: unsigned int runAheadSteps{0};
+
+      /// \brief How many speculative steps the world currently is ahead
+      /// of the confirmed frontier, i.e. how far the next rollback
+      /// rewinds.
+      private: unsigned int runAheadDepth{0};
+
+      /// \brief Dynamic-state snapshot of the confirmed frontier,
+      /// restored before each confirmed step while run-ahead is active.
+      private: std::string runAheadSnapshot;
+
+      /// \brief Simulation time accumulated over the current batch.
+      private: std::chrono::steady_clock::duration batchedDt{0};
+
+      /// \brief Update info handed to the PostUpdate phase when it runs;
+      /// its dt covers the whole batch.
+      private: UpdateInfo postUpdateInfo;
+
+      /// \brief Arena for PreUpdate/Update phase temporaries, reset at
+      /// the top of every UpdateSystems call.
+      private: StepArena updateArena;
+
+      /// \brief Arena for PostUpdate phase temporaries. It gets its own
+      /// arena because pipelined PostUpdate batches overlap later steps;
+      /// it is only reset once the previous batch has been waited out,
+      /// just before the next one is submitted.
+      private: StepArena postUpdateArena;
+
+      /// \brief Whether PostUpdate runs against a snapshot, overlapped
+      /// with the next step. See ServerConfig::SetPostUpdatePipelined.
+      private: bool postUpdatePipelined{false};
+
+      /// \brief Whether pipelined PostUpdate batches may skip cycles
+      /// instead of stalling the step when the previous batch is still
+      /// running. See ServerConfig::SetPostUpdateBestEffort.
+      private: bool postUpdateBestEffort{false};
+
+      /// \brief Changed-component deltas of steps whose PostUpdate
+      /// cycle was skipped in best-effort mode, in step order. Applied
+      /// to the snapshot manager before the next batch dispatches.
+      private: std::vector<msgs::SerializedStateMap> pendingSnapshotDeltas;
+
+      /// \brief Snapshot entity component manager read by PostUpdate
+      /// systems in pipelined mode. It is refreshed after each Update
+      /// phase by applying the step's changed-component state, so the
+      /// cost of keeping it current scales with the amount of change,
+      /// not with the world size.
+      private: EntityComponentManager postUpdateCompMgr;
+
+      /// \brief Whether PostUpdate work from the previous step may still
+      /// be running on the worker pool.
+      private: bool postUpdateInFlight{false};
+
+      /// \brief Number of submitted PostUpdate tasks that haven't
+      /// finished yet. The tasks decrement it themselves, so the step
+      /// thread can poll for completion without touching the worker
+      /// pool's lock.
+      private: std::atomic<unsigned int> postUpdatePending{0};
+
+      /// \brief Whether the step thread spins briefly before blocking
+      /// while waiting out PostUpdate work. See
+      /// ServerConfig::SetPostUpdateSpinWait.
+      private: bool postUpdateSpinWait{false};
+
+      /// \brief Wait durations observed at the PostUpdate
+      /// synchronization point, surfaced in the system statistics
+      /// message.
+      private: DurationHistogram postUpdateWaitHist;
+
       /// \brief List of simulation times used to compute averages.
       private: std::list<std::chrono::steady_clock::duration> simTimes;
 
@@ -425,6 +908,116 @@ namespace ignition
       /// \brief Clock publisher for the root `/clock` topic.
       private: ignition::transport::Node::Publisher rootClockPub;
 
+      /// \brief Per-system timing statistics publisher.
+      private: ignition::transport::Node::Publisher systemStatsPub;
+
+      /// \brief Wall time the system statistics were last published.
+      private: std::chrono::steady_clock::time_point
+                   prevSystemStatsPubTime;
+
+      /// \brief Memory statistics publisher.
+      private: ignition::transport::Node::Publisher memoryStatsPub;
+
+      /// \brief Wall time the memory statistics were last published.
+      private: std::chrono::steady_clock::time_point
+                   prevMemoryStatsPubTime;
+
+      /// \brief Step deadline diagnostics publisher.
+      private: ignition::transport::Node::Publisher stepDiagnosticsPub;
+
+      /// \brief Wall time the step diagnostics were last published.
+      private: std::chrono::steady_clock::time_point
+                   prevStepDiagnosticsPubTime;
+
+      /// \brief Whether the real time factor governor may shed systems.
+      /// See ServerConfig::SetRtfGovernorEnabled.
+      private: bool governorEnabled{false};
+
+      /// \brief Whether sheddable systems are currently being skipped.
+      private: bool shedding{false};
+
+      /// \brief Number of systems currently shed.
+      private: uint64_t shedCount{0};
+
+      /// \brief Cumulative number of steps that missed their deadline.
+      private: uint64_t deadlineMisses{0};
+
+      /// \brief Deadline misses since the last step that made it.
+      private: uint64_t consecutiveMisses{0};
+
+      /// \brief Steps within deadline since the last miss.
+      private: uint64_t consecutiveHits{0};
+
+      /// \brief Wall-clock duration of the last step's PreUpdate phase.
+      private: std::chrono::steady_clock::duration stepPreUpdateTime{0};
+
+      /// \brief Wall-clock duration of the last step's Update phase.
+      private: std::chrono::steady_clock::duration stepUpdateTime{0};
+
+      /// \brief Wall-clock duration of the last PostUpdate phase. Zero
+      /// on steps where update batching skipped the phase.
+      private: std::chrono::steady_clock::duration stepPostUpdateTime{0};
+
+      /// \brief Wall-clock duration of the last step's stats and clock
+      /// publishing.
+      private: std::chrono::steady_clock::duration stepPublishTime{0};
+
+      /// \brief Number of world control messages drained during the
+      /// current step.
+      private: uint32_t stepWorldControlMsgs{0};
+
+      /// \brief Number of steps held by the flight recorder.
+      private: static constexpr uint64_t kStepTraceSize{4096};
+
+      /// \brief Flight-recorder ring buffer holding the last
+      /// kStepTraceSize steps. Written only by the step thread; readers
+      /// synchronize through stepTraceHead.
+      private: std::vector<StepTraceRecord> stepTrace{kStepTraceSize};
+
+      /// \brief Number of records ever written to the trace. The record
+      /// for step n lives at index n % kStepTraceSize. Stored with
+      /// release order after the record is complete, so a reader that
+      /// acquires the head sees fully written records behind it.
+      private: std::atomic<uint64_t> stepTraceHead{0};
+
+      /// \brief Churn counter totals at the end of the previous step,
+      /// so the trace records per-step deltas of the cumulative
+      /// counters. Only touched by the step thread.
+      private: EntityComponentManager::ChurnCounters lastTraceChurn;
+
+      /// \brief State checksum log. Only open when a path was
+      /// configured; see ServerConfig::SetStateChecksumPath.
+      private: std::ofstream stateChecksumFile;
+
+      /// \brief Component types that have appeared in the checksum log,
+      /// used to emit each type's name once.
+      private: std::unordered_set<ComponentTypeId> checksumTypesSeen;
+
+      /// \brief System state from a restored checkpoint, keyed by
+      /// plugin class name. Entries are handed to systems implementing
+      /// ISystemStateHandoff as they are added to the runner and erased
+      /// once consumed.
+      private: std::unordered_map<std::string, std::string>
+          checkpointSystemState;
+
+      /// \brief Trace dump publisher. Used for the automatic dump when a
+      /// deadline miss follows a clean stretch.
+      private: ignition::transport::Node::Publisher stepTracePub;
+
+      /// \brief Wall time the trace was last dumped automatically.
+      private: std::chrono::steady_clock::time_point prevStepTracePubTime;
+
+      /// \brief CPUs the step thread is pinned to. Empty leaves
+      /// placement to the operating system. See SetCpuAffinity.
+      private: std::vector<unsigned int> cpuAffinity;
+
+      /// \brief Coordinator the step loop takes turns through. Null
+      /// leaves the loop free-running. See SetStepCoordinator.
+      private: RunnerCoordinator *stepCoordinator{nullptr};
+
+      /// \brief This runner's slot index in the step coordinator.
+      private: std::size_t stepCoordinatorId{0};
+
       /// \brief Name of world being simulated.
       private: std::string worldName;
 
@@ -464,11 +1057,18 @@ namespace ignition
       /// \brief Keeps the latest simulation info.
       private: UpdateInfo currentInfo;
 
-      /// \brief Buffer of world control messages.
-      private: std::list<WorldControl> worldControls;
+      /// \brief Buffer of world control messages. Transport callback
+      /// threads push without blocking, and the stepping thread drains
+      /// the queue once per step in ProcessMessages.
+      private: detail::MpscQueue<WorldControl> worldControls;
+
+      /// \brief Queue of work posted by service handlers, drained on
+      /// the stepping thread. See RequestStepTask.
+      private: detail::MpscQueue<std::packaged_task<void()>> stepTasks;
 
-      /// \brief Mutex to protect message buffers.
-      private: std::mutex msgBufferMutex;
+      /// \brief Drained tasks that did not fit into a step's budget,
+      /// run first on the following step.
+      private: std::list<std::packaged_task<void()>> pendingStepTasks;
 
       /// \brief Keep the latest GUI message.
       public: msgs::GUI guiMsg;
@@ -476,21 +1076,13 @@ namespace ignition
       /// \brief Copy of the server configuration.
       public: ServerConfig serverConfig;
 
-      /// \brief Collection of threads running system PostUpdates
-      private: std::vector<std::thread> postUpdateThreads;
-
-      /// \brief Flag to indicate running status of PostUpdate threads
-      private: std::atomic<bool> postUpdateThreadsRunning{false};
-
-      /// \brief Barrier to signal beginning of PostUpdate thread execution
-      private: std::unique_ptr<Barrier> postUpdateStartBarrier;
-
-      /// \brief Barrier to signal end of PostUpdate thread execution
-      private: std::unique_ptr<Barrier> postUpdateStopBarrier;
-
       /// \brief Map from file paths to Fuel URIs.
       private: std::unordered_map<std::string, std::string> fuelUriMap;
 
+      /// \brief Cache reused between world generation requests, so only
+      /// models whose components changed are regenerated.
+      private: sdf_generator::WorldGenCache sdfGenCache;
+
       friend class LevelManager;
     };
     }
@@ -16,7 +16,14 @@
 */
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <thread>
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
 #include <ignition/transport/Node.hh>
 #include <sdf/Box.hh>
 #include <sdf/Cylinder.hh>
@@ -1228,6 +1235,24 @@ TEST_P(SimulationRunnerTest, LoadPluginsEvent)
       componentId)) << componentId;
 }
 
+/////////////////////////////////////////////////
+TEST_P(SimulationRunnerTest, ReloadUnknownSystem)
+{
+  // Load SDF file without plugins
+  sdf::Root root;
+  root.Load(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+  ASSERT_EQ(1u, root.WorldCount());
+
+  // Create simulation runner
+  auto systemLoader = std::make_shared<SystemLoader>();
+  SimulationRunner runner(root.WorldByIndex(0), systemLoader);
+
+  // Nothing was loaded from this library, so there is nothing to
+  // reload.
+  EXPECT_FALSE(runner.ReloadSystems("libNoSuchSystem.so"));
+}
+
 /////////////////////////////////////////////////
 TEST_P(SimulationRunnerTest, GuiInfo)
 {
@@ -1292,6 +1317,213 @@ TEST_P(SimulationRunnerTest, GenerateWorldSdf)
   EXPECT_EQ(3u, world->ModelCount());
 }
 
+/////////////////////////////////////////////////
+TEST_P(SimulationRunnerTest, StepTasks)
+{
+  // Load SDF file
+  sdf::Root root;
+  root.Load(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  ASSERT_EQ(1u, root.WorldCount());
+
+  // Create simulation runner
+  auto systemLoader = std::make_shared<SystemLoader>();
+  SimulationRunner runner(root.WorldByIndex(0), systemLoader);
+
+  // Without a stepping thread the task runs inline.
+  bool ran{false};
+  auto future = runner.RequestStepTask([&]()
+  {
+    ran = true;
+  });
+  EXPECT_EQ(std::future_status::ready,
+      future.wait_for(std::chrono::seconds(0)));
+  EXPECT_TRUE(ran);
+
+  // While running, tasks are executed by the step loop.
+  std::atomic<bool> taskDone{false};
+  std::thread stepThread([&]()
+  {
+    while (!runner.Running())
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    auto stepFuture = runner.RequestStepTask([&]()
+    {
+      taskDone = true;
+    });
+    stepFuture.wait();
+  });
+
+  runner.SetPaused(false);
+  EXPECT_TRUE(runner.Run(500));
+
+  stepThread.join();
+  EXPECT_TRUE(taskDone);
+}
+
+/////////////////////////////////////////////////
+TEST_P(SimulationRunnerTest, PipelinedPostUpdate)
+{
+  // Load SDF file
+  sdf::Root root;
+  root.Load(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  ASSERT_EQ(1u, root.WorldCount());
+
+  ServerConfig config;
+  config.SetPostUpdatePipelined(true);
+
+  // Create simulation runner
+  auto systemLoader = std::make_shared<SystemLoader>();
+  SimulationRunner runner(root.WorldByIndex(0), systemLoader, config);
+  runner.SetPaused(false);
+
+  // The snapshot refresh and the deferred batch wait must not lose or
+  // hang any step.
+  EXPECT_TRUE(runner.Run(100));
+  EXPECT_EQ(100u, runner.CurrentInfo().iterations);
+
+  // A second run reuses the snapshot manager across Run calls.
+  EXPECT_TRUE(runner.Run(100));
+  EXPECT_EQ(200u, runner.CurrentInfo().iterations);
+}
+
+/////////////////////////////////////////////////
+TEST_P(SimulationRunnerTest, BestEffortPostUpdate)
+{
+  // Load SDF file
+  sdf::Root root;
+  root.Load(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  ASSERT_EQ(1u, root.WorldCount());
+
+  ServerConfig config;
+  config.SetPostUpdatePipelined(true);
+  config.SetPostUpdateBestEffort(true);
+
+  // Create simulation runner
+  auto systemLoader = std::make_shared<SystemLoader>();
+  SimulationRunner runner(root.WorldByIndex(0), systemLoader, config);
+  runner.SetPaused(false);
+
+  // Cycle skipping and the buffered delta replay must not lose or hang
+  // any step.
+  EXPECT_TRUE(runner.Run(100));
+  EXPECT_EQ(100u, runner.CurrentInfo().iterations);
+
+  EXPECT_TRUE(runner.Run(100));
+  EXPECT_EQ(200u, runner.CurrentInfo().iterations);
+}
+
+/////////////////////////////////////////////////
+TEST_P(SimulationRunnerTest, StateChecksum)
+{
+  // Load SDF file
+  sdf::Root root;
+  root.Load(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  ASSERT_EQ(1u, root.WorldCount());
+
+  // Run the same world twice with checksum logging and expect the logs
+  // to be byte-identical.
+  auto readLog = [&](const std::string &_path) -> std::string
+  {
+    sdf::Root runRoot;
+    runRoot.Load(std::string(PROJECT_SOURCE_PATH) +
+        "/test/worlds/shapes.sdf");
+
+    ServerConfig config;
+    config.SetStateChecksumPath(_path);
+
+    auto systemLoader = std::make_shared<SystemLoader>();
+    SimulationRunner runner(runRoot.WorldByIndex(0), systemLoader, config);
+    runner.SetPaused(false);
+    EXPECT_TRUE(runner.Run(50));
+
+    std::ifstream log(_path);
+    EXPECT_TRUE(log.is_open());
+    std::stringstream content;
+    content << log.rdbuf();
+    return content.str();
+  };
+
+  const auto logA = readLog(common::joinPaths(common::cwd(),
+      "state_checksum_a.txt"));
+  const auto logB = readLog(common::joinPaths(common::cwd(),
+      "state_checksum_b.txt"));
+
+  EXPECT_FALSE(logA.empty());
+  EXPECT_EQ(logA, logB);
+}
+
+/////////////////////////////////////////////////
+TEST_P(SimulationRunnerTest, CheckpointRestore)
+{
+  // Load SDF file
+  sdf::Root root;
+  root.Load(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  ASSERT_EQ(1u, root.WorldCount());
+
+  const auto path = common::joinPaths(common::cwd(), "checkpoint.bin");
+  auto systemLoader = std::make_shared<SystemLoader>();
+
+  std::size_t entityCount{0u};
+
+  // Run a world and write a checkpoint through the service
+  {
+    SimulationRunner runner(root.WorldByIndex(0), systemLoader);
+    runner.SetPaused(false);
+    EXPECT_TRUE(runner.Run(10));
+    EXPECT_EQ(10u, runner.CurrentInfo().iterations);
+    entityCount = runner.EntityCompMgr().EntityCount();
+
+    transport::Node node;
+    msgs::StringMsg req;
+    req.set_data(path);
+    msgs::Boolean res;
+    bool result{false};
+    EXPECT_TRUE(node.Request("/world/default/checkpoint", req, 5000, res,
+        result));
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(res.data());
+  }
+
+  // A restored runner continues from the checkpoint instead of from the
+  // SDF state
+  {
+    ServerConfig config;
+    config.SetCheckpointRestorePath(path);
+    SimulationRunner runner(root.WorldByIndex(0), systemLoader, config);
+    EXPECT_EQ(10u, runner.CurrentInfo().iterations);
+    EXPECT_EQ(10ms, runner.CurrentInfo().simTime);
+    EXPECT_EQ(entityCount, runner.EntityCompMgr().EntityCount());
+
+    runner.SetPaused(false);
+    EXPECT_TRUE(runner.Run(5));
+    EXPECT_EQ(15u, runner.CurrentInfo().iterations);
+  }
+
+  // A checkpoint from another world is skipped
+  {
+    sdf::Root otherRoot;
+    otherRoot.LoadSdfString(R"(<?xml version="1.0"?>
+      <sdf version="1.6">
+        <world name="other_world"/>
+      </sdf>)");
+    ASSERT_EQ(1u, otherRoot.WorldCount());
+
+    ServerConfig config;
+    config.SetCheckpointRestorePath(path);
+    SimulationRunner runner(otherRoot.WorldByIndex(0), systemLoader, config);
+    EXPECT_EQ(0u, runner.CurrentInfo().iterations);
+  }
+}
+
 // Run multiple times. We want to make sure that static globals don't cause
 // problems.
 INSTANTIATE_TEST_CASE_P(ServerRepeat, SimulationRunnerTest,
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+#include "ignition/gazebo/detail/SmallVector.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+using TestVector = detail::SmallVector<double, 3>;
+
+/////////////////////////////////////////////////
+TEST(SmallVectorTest, ElementAccessAndIteration)
+{
+  TestVector vec{1.0, 2.0, 3.0};
+  ASSERT_EQ(3u, vec.size());
+  EXPECT_FALSE(vec.empty());
+  EXPECT_DOUBLE_EQ(1.0, vec[0]);
+  EXPECT_DOUBLE_EQ(3.0, vec[2]);
+
+  EXPECT_DOUBLE_EQ(6.0, std::accumulate(vec.begin(), vec.end(), 0.0));
+
+  vec[1] = 20.0;
+  EXPECT_DOUBLE_EQ(20.0, vec[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(SmallVectorTest, GrowsPastInlineCapacity)
+{
+  TestVector vec;
+  for (int i = 0; i < 10; ++i)
+    vec.push_back(i);
+
+  ASSERT_EQ(10u, vec.size());
+  for (int i = 0; i < 10; ++i)
+    EXPECT_DOUBLE_EQ(i, vec[i]);
+
+  // Shrinking back reuses the heap storage; values stay correct.
+  vec.resize(2);
+  ASSERT_EQ(2u, vec.size());
+  EXPECT_DOUBLE_EQ(1.0, vec[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(SmallVectorTest, ResizeValueInitializes)
+{
+  TestVector vec{1.0};
+  vec.resize(3);
+  ASSERT_EQ(3u, vec.size());
+  EXPECT_DOUBLE_EQ(1.0, vec[0]);
+  EXPECT_DOUBLE_EQ(0.0, vec[1]);
+  EXPECT_DOUBLE_EQ(0.0, vec[2]);
+
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SmallVectorTest, AssignAndVectorInterop)
+{
+  std::vector<double> source{4.0, 5.0};
+
+  // Implicit conversion keeps call sites passing std::vector working.
+  TestVector vec = source;
+  ASSERT_EQ(2u, vec.size());
+  EXPECT_DOUBLE_EQ(5.0, vec[1]);
+
+  vec.assign(source.begin(), source.begin() + 1);
+  ASSERT_EQ(1u, vec.size());
+  EXPECT_DOUBLE_EQ(4.0, vec[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(SmallVectorTest, Equality)
+{
+  TestVector a{1.0, 2.0};
+  TestVector b{1.0, 2.0};
+  TestVector c{1.0, 3.0};
+  EXPECT_TRUE(a == b);
+  EXPECT_TRUE(a != c);
+  EXPECT_FALSE(a == c);
+
+  // Equality ignores where the elements live: grow one vector onto the
+  // heap and back to the same contents.
+  TestVector d;
+  for (int i = 0; i < 5; ++i)
+    d.push_back(i);
+  d.resize(2);
+  d[0] = 1.0;
+  d[1] = 2.0;
+  EXPECT_TRUE(a == d);
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+#include "ignition/gazebo/detail/SpscRing.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(SpscRingTest, PopEmpty)
+{
+  detail::SpscRing<int> ring(4);
+  int value{0};
+  EXPECT_TRUE(ring.Empty());
+  EXPECT_FALSE(ring.TryPop(value));
+}
+
+/////////////////////////////////////////////////
+TEST(SpscRingTest, FifoOrderAndCapacity)
+{
+  detail::SpscRing<int> ring(4);
+
+  for (int i = 0; i < 4; ++i)
+  {
+    int value = i;
+    EXPECT_TRUE(ring.TryPush(value));
+  }
+
+  // The ring holds exactly its capacity; the next push is refused and
+  // the value stays with the caller.
+  int overflow = 42;
+  EXPECT_FALSE(ring.TryPush(overflow));
+  EXPECT_EQ(42, overflow);
+
+  for (int i = 0; i < 4; ++i)
+  {
+    int value{-1};
+    EXPECT_TRUE(ring.TryPop(value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_TRUE(ring.Empty());
+
+  // And usable again after wrapping around.
+  int value = 7;
+  EXPECT_TRUE(ring.TryPush(value));
+  EXPECT_TRUE(ring.TryPop(value));
+  EXPECT_EQ(7, value);
+}
+
+/////////////////////////////////////////////////
+TEST(SpscRingTest, MoveOnlyValues)
+{
+  detail::SpscRing<std::unique_ptr<int>> ring(2);
+
+  auto in = std::make_unique<int>(1);
+  EXPECT_TRUE(ring.TryPush(in));
+  EXPECT_EQ(nullptr, in);
+
+  std::unique_ptr<int> out;
+  EXPECT_TRUE(ring.TryPop(out));
+  ASSERT_NE(nullptr, out);
+  EXPECT_EQ(1, *out);
+}
+
+/////////////////////////////////////////////////
+TEST(SpscRingTest, ConcurrentProducerConsumer)
+{
+  const int count{100000};
+
+  detail::SpscRing<int> ring(16);
+
+  std::thread producer([&ring]()
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      int value = i;
+      // A full ring only delays the producer in this test; the values
+      // must all arrive, in order.
+      while (!ring.TryPush(value))
+      {
+      }
+    }
+  });
+
+  for (int expected = 0; expected < count; )
+  {
+    int value{-1};
+    if (!ring.TryPop(value))
+      continue;
+    // Values come out exactly once, in push order.
+    ASSERT_EQ(expected, value);
+    ++expected;
+  }
+
+  producer.join();
+  EXPECT_TRUE(ring.Empty());
+}
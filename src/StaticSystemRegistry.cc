@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/gazebo/StaticSystemRegistry.hh"
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+using namespace ignition;
+using namespace gazebo;
+
+namespace
+{
+/// \brief Factory storage, behind a function local static so
+/// registrations running as static initializers in any translation
+/// unit find it already constructed.
+struct RegistryStorage
+{
+  /// \brief Protects factories.
+  std::mutex mutex;
+
+  /// \brief Registered factories by plugin class name. Ordered, so
+  /// Names() lists them deterministically.
+  std::map<std::string, StaticSystemRegistry::SystemFactoryFn> factories;
+};
+
+//////////////////////////////////////////////////
+RegistryStorage &Storage()
+{
+  static RegistryStorage storage;
+  return storage;
+}
+}
+
+//////////////////////////////////////////////////
+bool StaticSystemRegistry::Register(const std::string &_name,
+    SystemFactoryFn _factory)
+{
+  auto &storage = Storage();
+  std::lock_guard<std::mutex> lock(storage.mutex);
+  storage.factories[_name] = std::move(_factory);
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<System> StaticSystemRegistry::Instantiate(
+    const std::string &_name)
+{
+  SystemFactoryFn factory;
+  {
+    auto &storage = Storage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    auto iter = storage.factories.find(_name);
+    if (iter == storage.factories.end())
+      return nullptr;
+    factory = iter->second;
+  }
+
+  // Invoked outside the lock, so a factory is free to touch the
+  // registry.
+  return factory();
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> StaticSystemRegistry::Names()
+{
+  auto &storage = Storage();
+  std::lock_guard<std::mutex> lock(storage.mutex);
+
+  std::vector<std::string> names;
+  names.reserve(storage.factories.size());
+  for (const auto &entry : storage.factories)
+    names.push_back(entry.first);
+  return names;
+}
+
+//////////////////////////////////////////////////
+void StaticSystemRegistry::Clear()
+{
+  auto &storage = Storage();
+  std::lock_guard<std::mutex> lock(storage.mutex);
+  storage.factories.clear();
+}
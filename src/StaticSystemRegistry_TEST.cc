@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+
+// Exercise the registration macro the way a system library compiled
+// with the IGN_GAZEBO_STATIC_SYSTEMS option sees it.
+#define IGN_GAZEBO_STATIC_SYSTEMS
+#include "ignition/gazebo/StaticSystemRegistry.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+namespace
+{
+class DummySystem : public System
+{
+};
+
+class OtherSystem : public System
+{
+};
+}
+
+IGNITION_GAZEBO_ADD_STATIC_SYSTEM(DummySystem)
+
+/////////////////////////////////////////////////
+TEST(StaticSystemRegistryTest, MacroRegisters)
+{
+  auto system = StaticSystemRegistry::Instantiate("DummySystem");
+  ASSERT_NE(nullptr, system);
+  EXPECT_NE(nullptr, dynamic_cast<DummySystem *>(system.get()));
+
+  auto names = StaticSystemRegistry::Names();
+  EXPECT_NE(names.end(),
+      std::find(names.begin(), names.end(), "DummySystem"));
+}
+
+/////////////////////////////////////////////////
+TEST(StaticSystemRegistryTest, NewInstancePerCall)
+{
+  int calls = 0;
+  EXPECT_TRUE(StaticSystemRegistry::Register("test::Counted",
+      [&calls]() -> std::shared_ptr<System>
+      {
+        ++calls;
+        return std::make_shared<DummySystem>();
+      }));
+
+  auto first = StaticSystemRegistry::Instantiate("test::Counted");
+  auto second = StaticSystemRegistry::Instantiate("test::Counted");
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_EQ(2, calls);
+}
+
+/////////////////////////////////////////////////
+TEST(StaticSystemRegistryTest, UnknownName)
+{
+  EXPECT_EQ(nullptr, StaticSystemRegistry::Instantiate("test::NotThere"));
+}
+
+/////////////////////////////////////////////////
+TEST(StaticSystemRegistryTest, LastRegistrationWins)
+{
+  StaticSystemRegistry::Register("test::Replaced",
+      []() -> std::shared_ptr<System>
+      {
+        return std::make_shared<DummySystem>();
+      });
+  StaticSystemRegistry::Register("test::Replaced",
+      []() -> std::shared_ptr<System>
+      {
+        return std::make_shared<OtherSystem>();
+      });
+
+  auto system = StaticSystemRegistry::Instantiate("test::Replaced");
+  ASSERT_NE(nullptr, system);
+  EXPECT_NE(nullptr, dynamic_cast<OtherSystem *>(system.get()));
+}
+
+/////////////////////////////////////////////////
+TEST(StaticSystemRegistryTest, ClearForgetsEntries)
+{
+  StaticSystemRegistry::Register("test::Forgotten",
+      []() -> std::shared_ptr<System>
+      {
+        return std::make_shared<DummySystem>();
+      });
+  ASSERT_NE(nullptr, StaticSystemRegistry::Instantiate("test::Forgotten"));
+
+  StaticSystemRegistry::Clear();
+  EXPECT_EQ(nullptr, StaticSystemRegistry::Instantiate("test::Forgotten"));
+  EXPECT_TRUE(StaticSystemRegistry::Names().empty());
+}
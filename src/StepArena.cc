@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/gazebo/StepArena.hh"
+
+#include <atomic>
+#include <cstdint>
+
+using namespace ignition;
+using namespace gazebo;
+
+namespace
+{
+/// \brief Every block is rounded up to this, so any block is aligned for
+/// any standard type.
+constexpr std::size_t kArenaAlign = alignof(std::max_align_t);
+}
+
+// Private data class.
+class ignition::gazebo::StepArenaPrivate
+{
+  /// \brief The buffer blocks are bumped out of.
+  public: std::unique_ptr<char[]> buffer;
+
+  /// \brief Buffer capacity in bytes.
+  public: std::size_t capacity{0};
+
+  /// \brief Bytes handed out since the last Reset. Monotonic within a
+  /// phase: it keeps counting past the capacity while fallbacks go to
+  /// the heap, which is exactly the high-water mark Reset grows the
+  /// buffer to.
+  public: std::atomic<std::size_t> offset{0};
+};
+
+//////////////////////////////////////////////////
+StepArena::StepArena(std::size_t _capacity)
+  : dataPtr(std::make_unique<StepArenaPrivate>())
+{
+  this->dataPtr->capacity = _capacity;
+  this->dataPtr->buffer = std::make_unique<char[]>(_capacity);
+}
+
+//////////////////////////////////////////////////
+StepArena::~StepArena() = default;
+
+//////////////////////////////////////////////////
+void *StepArena::Allocate(std::size_t _bytes)
+{
+  const std::size_t rounded =
+      (_bytes + kArenaAlign - 1) & ~(kArenaAlign - 1);
+
+  const std::size_t start = this->dataPtr->offset.fetch_add(rounded,
+      std::memory_order_relaxed);
+  if (start + rounded <= this->dataPtr->capacity)
+    return this->dataPtr->buffer.get() + start;
+
+  // The buffer is spent for this phase; the heap carries the overflow
+  // and the next Reset grows the buffer past it.
+  return ::operator new(_bytes);
+}
+
+//////////////////////////////////////////////////
+bool StepArena::Owns(const void *_ptr) const
+{
+  const char *ptr = static_cast<const char *>(_ptr);
+  const char *base = this->dataPtr->buffer.get();
+  return ptr >= base && ptr < base + this->dataPtr->capacity;
+}
+
+//////////////////////////////////////////////////
+void StepArena::Reset()
+{
+  const std::size_t used = this->dataPtr->offset.exchange(0,
+      std::memory_order_relaxed);
+  if (used <= this->dataPtr->capacity)
+    return;
+
+  // The phase overflowed to the heap. Size the buffer to the next power
+  // of two past what it asked for, so a steady-state phase settles into
+  // the arena after one step and never touches the heap again.
+  std::size_t capacity = this->dataPtr->capacity;
+  while (capacity < used)
+    capacity *= 2;
+  this->dataPtr->buffer = std::make_unique<char[]>(capacity);
+  this->dataPtr->capacity = capacity;
+}
+
+//////////////////////////////////////////////////
+std::size_t StepArena::Capacity() const
+{
+  return this->dataPtr->capacity;
+}
+
+//////////////////////////////////////////////////
+std::size_t StepArena::Used() const
+{
+  return this->dataPtr->offset.load(std::memory_order_relaxed);
+}
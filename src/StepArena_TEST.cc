@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "ignition/gazebo/StepArena.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(StepArenaTest, AllocateAndReset)
+{
+  StepArena arena(1024);
+  EXPECT_EQ(1024u, arena.Capacity());
+  EXPECT_EQ(0u, arena.Used());
+
+  void *first = arena.Allocate(100);
+  ASSERT_NE(nullptr, first);
+  EXPECT_TRUE(arena.Owns(first));
+  // Blocks are aligned for any standard type.
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(first) %
+      alignof(std::max_align_t));
+
+  void *second = arena.Allocate(100);
+  EXPECT_TRUE(arena.Owns(second));
+  EXPECT_NE(first, second);
+
+  // A reset recycles the buffer: the next allocation reuses it from the
+  // start.
+  arena.Reset();
+  EXPECT_EQ(0u, arena.Used());
+  EXPECT_EQ(first, arena.Allocate(100));
+}
+
+/////////////////////////////////////////////////
+TEST(StepArenaTest, OverflowFallsBackAndGrows)
+{
+  StepArena arena(128);
+
+  void *inArena = arena.Allocate(100);
+  EXPECT_TRUE(arena.Owns(inArena));
+
+  // The buffer is spent; the overflow comes from the heap and must be
+  // deleted by the caller.
+  void *overflow = arena.Allocate(100);
+  ASSERT_NE(nullptr, overflow);
+  EXPECT_FALSE(arena.Owns(overflow));
+  ::operator delete(overflow);
+
+  // Reset sizes the buffer to what the phase actually used, so the same
+  // demand fits the arena next time.
+  arena.Reset();
+  EXPECT_GE(arena.Capacity(), 200u);
+  EXPECT_TRUE(arena.Owns(arena.Allocate(100)));
+  EXPECT_TRUE(arena.Owns(arena.Allocate(100)));
+}
+
+/////////////////////////////////////////////////
+TEST(StepArenaTest, AllocatorBacksVectors)
+{
+  StepArena arena(1u << 16);
+
+  ArenaVector<int> values{StepArenaAllocator<int>(&arena)};
+  for (int i = 0; i < 100; ++i)
+    values.push_back(i);
+
+  EXPECT_TRUE(arena.Owns(values.data()));
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i, values[i]);
+
+  // A null arena degrades to the heap, so containers can be declared
+  // unconditionally even when the host provides no arena.
+  ArenaVector<int> heapValues{StepArenaAllocator<int>(nullptr)};
+  heapValues.push_back(42);
+  EXPECT_EQ(42, heapValues[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(StepArenaTest, ConcurrentAllocations)
+{
+  const unsigned int threadCount{4};
+  const int perThread{100};
+
+  StepArena arena(1u << 20);
+  std::vector<std::vector<void *>> blocks(threadCount);
+  std::vector<std::thread> threads;
+
+  for (unsigned int t = 0; t < threadCount; ++t)
+  {
+    threads.push_back(std::thread([&arena, &blocks, t]()
+    {
+      for (int i = 0; i < perThread; ++i)
+        blocks[t].push_back(arena.Allocate(64));
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // Every thread got distinct blocks out of the shared buffer.
+  std::set<void *> seen;
+  for (const auto &threadBlocks : blocks)
+  {
+    for (void *block : threadBlocks)
+    {
+      EXPECT_TRUE(arena.Owns(block));
+      EXPECT_TRUE(seen.insert(block).second);
+    }
+  }
+  EXPECT_EQ(threadCount * perThread, seen.size());
+}
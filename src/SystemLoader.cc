@@ -15,9 +15,14 @@
  *
 */
 
+#include <chrono>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <ignition/gazebo/SystemLoader.hh>
 
@@ -41,11 +46,20 @@ class ignition::gazebo::SystemLoaderPrivate
   public: explicit SystemLoaderPrivate() = default;
 
   //////////////////////////////////////////////////
-  public: bool InstantiateSystemPlugin(const std::string &_filename,
-              const std::string &_name,
-              const sdf::ElementPtr &/*_sdf*/,
-              ignition::plugin::PluginPtr &_plugin)
+  /// \brief Resolve a plugin filename to a shared library path on disk.
+  /// Successful lookups are memoized process-wide, so the Nth loader to
+  /// ask for the same plugin skips the path search entirely.
+  /// \param[in] _filename Shared library filename to resolve.
+  /// \return Path to the library, empty if it couldn't be found.
+  public: std::string ResolvePluginPath(const std::string &_filename)
   {
+    {
+      std::lock_guard<std::mutex> lock(libMutex);
+      auto pathIt = resolvedPaths.find(_filename);
+      if (pathIt != resolvedPaths.end())
+        return pathIt->second;
+    }
+
     ignition::common::SystemPaths systemPaths;
     systemPaths.SetPluginPathEnv(pluginPathEnv);
 
@@ -58,6 +72,55 @@ class ignition::gazebo::SystemLoaderPrivate
     systemPaths.AddPluginPaths(IGN_GAZEBO_PLUGIN_INSTALL_DIR);
 
     auto pathToLib = systemPaths.FindSharedLibrary(_filename);
+    if (!pathToLib.empty())
+    {
+      std::lock_guard<std::mutex> lock(libMutex);
+      resolvedPaths[_filename] = pathToLib;
+    }
+    return pathToLib;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Load the shared library at the given path, unless some loader
+  /// in this process has done so already. The time spent on a fresh load
+  /// is recorded for startup profiling.
+  /// \param[in] _filename Shared library filename, used for messages and
+  /// to key the load timings.
+  /// \param[in] _pathToLib Resolved path to the library.
+  /// \return True if the library is loaded.
+  public: bool LoadLibrary(const std::string &_filename,
+              const std::string &_pathToLib)
+  {
+    std::lock_guard<std::mutex> lock(libMutex);
+    if (loadedLibs.find(_pathToLib) != loadedLibs.end())
+      return true;
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto pluginNames = loader.LoadLib(_pathToLib);
+    if (pluginNames.empty() || pluginNames.begin()->empty())
+    {
+      ignerr << "Failed to load system plugin [" << _filename <<
+                "] : couldn't load library on path [" << _pathToLib <<
+                "]." << std::endl;
+      return false;
+    }
+    auto duration = std::chrono::steady_clock::now() - startTime;
+
+    loadedLibs.insert(_pathToLib);
+    loadTimes[_filename] = duration;
+    igndbg << "Loaded library [" << _pathToLib << "] in " <<
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+      duration).count() << " ms" << std::endl;
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  public: bool InstantiateSystemPlugin(const std::string &_filename,
+              const std::string &_name,
+              const sdf::ElementPtr &/*_sdf*/,
+              ignition::plugin::PluginPtr &_plugin)
+  {
+    auto pathToLib = this->ResolvePluginPath(_filename);
     if (pathToLib.empty())
     {
       // We assume ignition::gazebo corresponds to the levels feature
@@ -69,25 +132,13 @@ class ignition::gazebo::SystemLoaderPrivate
       return false;
     }
 
-    auto pluginNames = this->loader.LoadLib(pathToLib);
-    if (pluginNames.empty())
-    {
-      ignerr << "Failed to load system plugin [" << _filename <<
-                "] : couldn't load library on path [" << pathToLib <<
-                "]." << std::endl;
+    if (!this->LoadLibrary(_filename, pathToLib))
       return false;
-    }
 
-    auto pluginName = *pluginNames.begin();
-    if (pluginName.empty())
     {
-      ignerr << "Failed to load system plugin [" << _filename <<
-                "] : couldn't load library on path [" << pathToLib <<
-                "]." << std::endl;
-      return false;
+      std::lock_guard<std::mutex> lock(libMutex);
+      _plugin = loader.Instantiate(_name);
     }
-
-    _plugin = this->loader.Instantiate(_name);
     if (!_plugin)
     {
       ignerr << "Failed to load system plugin [" << _name <<
@@ -112,8 +163,22 @@ class ignition::gazebo::SystemLoaderPrivate
   // Default plugin search path environment variable
   public: std::string pluginPathEnv{"IGN_GAZEBO_SYSTEM_PLUGIN_PATH"};
 
-  /// \brief Plugin loader instace
-  public: ignition::plugin::Loader loader;
+  /// \brief Plugin loader instance, shared by every SystemLoader in the
+  /// process so each shared library is opened only once.
+  public: static ignition::plugin::Loader loader;
+
+  /// \brief Protects the loader and the process-wide caches below.
+  public: static std::mutex libMutex;
+
+  /// \brief Plugin filenames memoized to resolved shared library paths.
+  public: static std::unordered_map<std::string, std::string> resolvedPaths;
+
+  /// \brief Paths of shared libraries that have already been loaded.
+  public: static std::unordered_set<std::string> loadedLibs;
+
+  /// \brief Time spent loading each plugin library, keyed by filename.
+  public: static std::map<std::string,
+      std::chrono::steady_clock::duration> loadTimes;
 
   /// \brief Paths to search for system plugins.
   public: std::unordered_set<std::string> systemPluginPaths;
@@ -122,10 +187,26 @@ class ignition::gazebo::SystemLoaderPrivate
   public: std::unordered_set<SystemPluginPtr> systemPluginsAdded;
 };
 
+ignition::plugin::Loader SystemLoaderPrivate::loader;
+std::mutex SystemLoaderPrivate::libMutex;
+std::unordered_map<std::string, std::string> SystemLoaderPrivate::resolvedPaths;
+std::unordered_set<std::string> SystemLoaderPrivate::loadedLibs;
+std::map<std::string,
+    std::chrono::steady_clock::duration> SystemLoaderPrivate::loadTimes;
+
 //////////////////////////////////////////////////
 SystemLoader::SystemLoader()
   : dataPtr(new SystemLoaderPrivate())
 {
+  // Eagerly load common plugins once per process, so later worlds find
+  // their libraries already resolved and opened.
+  static std::once_flag preloadOnce;
+  std::call_once(preloadOnce, [this]()
+      {
+        std::string preload;
+        if (ignition::common::env("IGN_GAZEBO_PRELOAD_PLUGINS", preload))
+          this->PreloadPlugins(ignition::common::Split(preload, ':'));
+      });
 }
 
 //////////////////////////////////////////////////
@@ -177,6 +258,53 @@ std::optional<SystemPluginPtr> SystemLoader::LoadPlugin(
   return LoadPlugin(filename, pluginName, _sdf);
 }
 
+//////////////////////////////////////////////////
+void SystemLoader::PreloadPlugins(const std::vector<std::string> &_filenames)
+{
+  for (const auto &filename : _filenames)
+  {
+    if (filename.empty())
+      continue;
+
+    auto pathToLib = this->dataPtr->ResolvePluginPath(filename);
+    if (pathToLib.empty())
+    {
+      ignwarn << "Failed to preload system plugin [" << filename <<
+                 "] : couldn't find shared library." << std::endl;
+      continue;
+    }
+    this->dataPtr->LoadLibrary(filename, pathToLib);
+  }
+}
+
+//////////////////////////////////////////////////
+bool SystemLoader::UnloadLibrary(const std::string &_filename)
+{
+  std::lock_guard<std::mutex> lock(SystemLoaderPrivate::libMutex);
+  auto pathIt = SystemLoaderPrivate::resolvedPaths.find(_filename);
+  if (pathIt == SystemLoaderPrivate::resolvedPaths.end())
+    return false;
+
+  const std::string pathToLib = pathIt->second;
+  SystemLoaderPrivate::loader.ForgetLibrary(pathToLib);
+  SystemLoaderPrivate::loadedLibs.erase(pathToLib);
+  SystemLoaderPrivate::loadTimes.erase(_filename);
+  // A rebuild may land somewhere else, e.g. a freshly sourced overlay,
+  // so the path is re-resolved on the next load too.
+  SystemLoaderPrivate::resolvedPaths.erase(pathIt);
+
+  igndbg << "Forgot library [" << pathToLib << "]" << std::endl;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::map<std::string, std::chrono::steady_clock::duration>
+    SystemLoader::PluginLoadTimes() const
+{
+  std::lock_guard<std::mutex> lock(SystemLoaderPrivate::libMutex);
+  return SystemLoaderPrivate::loadTimes;
+}
+
 //////////////////////////////////////////////////
 std::string SystemLoader::PrettyStr() const
 {
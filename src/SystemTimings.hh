@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMTIMINGS_HH_
+#define IGNITION_GAZEBO_SYSTEMTIMINGS_HH_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#include "ignition/gazebo/config.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \brief A lock-free histogram of durations, with one bucket per
+    /// power of two of nanoseconds. Recording is a handful of relaxed
+    /// atomic additions, cheap enough to stay enabled in production, and
+    /// the statistics can be read from any thread while recordings are
+    /// in flight. Percentiles are estimated as the upper bound of the
+    /// bucket containing the requested rank, so they are accurate to
+    /// within a factor of two.
+    class DurationHistogram
+    {
+      /// \brief Number of buckets. Bucket i counts durations whose
+      /// nanosecond count has its highest set bit at position i.
+      public: static constexpr size_t kBucketCount{64};
+
+      /// \brief Record one duration. Safe to call concurrently with
+      /// readers, but a single histogram expects one writer at a time.
+      /// \param[in] _duration The duration to record.
+      public: void Record(const std::chrono::steady_clock::duration _duration)
+      {
+        const uint64_t ns = static_cast<uint64_t>(std::max<int64_t>(0,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+            _duration).count()));
+
+        size_t bucket = 0;
+        uint64_t value = ns;
+        while (value >>= 1)
+          ++bucket;
+
+        this->buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        this->totalCount.fetch_add(1, std::memory_order_relaxed);
+        this->totalNs.fetch_add(ns, std::memory_order_relaxed);
+
+        uint64_t prevMax = this->maxNs.load(std::memory_order_relaxed);
+        while (ns > prevMax && !this->maxNs.compare_exchange_weak(
+            prevMax, ns, std::memory_order_relaxed))
+        {
+        }
+      }
+
+      /// \brief Get the number of recorded durations.
+      /// \return The count.
+      public: uint64_t Count() const
+      {
+        return this->totalCount.load(std::memory_order_relaxed);
+      }
+
+      /// \brief Get the sum of all recorded durations.
+      /// \return The total in nanoseconds.
+      public: uint64_t TotalNs() const
+      {
+        return this->totalNs.load(std::memory_order_relaxed);
+      }
+
+      /// \brief Get the maximum recorded duration.
+      /// \return The maximum in nanoseconds.
+      public: uint64_t MaxNs() const
+      {
+        return this->maxNs.load(std::memory_order_relaxed);
+      }
+
+      /// \brief Estimate a percentile of the recorded durations.
+      /// \param[in] _percentile Percentile in (0, 1], e.g. 0.99.
+      /// \return Upper bound of the histogram bucket containing the
+      /// requested rank, in nanoseconds, or zero if nothing was recorded.
+      public: uint64_t PercentileNs(const double _percentile) const
+      {
+        const uint64_t total = this->Count();
+        if (0u == total)
+          return 0u;
+
+        const uint64_t rank = std::max<uint64_t>(1u,
+            static_cast<uint64_t>(std::ceil(_percentile * total)));
+
+        uint64_t cumulative = 0u;
+        for (size_t i = 0; i < kBucketCount; ++i)
+        {
+          cumulative += this->buckets[i].load(std::memory_order_relaxed);
+          if (cumulative >= rank)
+          {
+            return i + 1 >= kBucketCount ?
+                this->MaxNs() : (2ull << i) - 1u;
+          }
+        }
+        return this->MaxNs();
+      }
+
+      /// \brief Counts of recorded durations per power-of-two bucket.
+      private: std::array<std::atomic<uint64_t>, kBucketCount> buckets{};
+
+      /// \brief Number of recorded durations.
+      private: std::atomic<uint64_t> totalCount{0};
+
+      /// \brief Sum of all recorded durations in nanoseconds.
+      private: std::atomic<uint64_t> totalNs{0};
+
+      /// \brief Maximum recorded duration in nanoseconds.
+      private: std::atomic<uint64_t> maxNs{0};
+    };
+
+    /// \brief Per-phase timing histograms for one system. The
+    /// SimulationRunner keeps one of these per system and records the
+    /// duration of every PreUpdate, Update and PostUpdate call.
+    class SystemTimings
+    {
+      /// \brief Constructor
+      /// \param[in] _name Name of the system plugin.
+      public: explicit SystemTimings(const std::string &_name)
+              : name(_name)
+      {
+      }
+
+      /// \brief Name of the system plugin.
+      public: std::string name;
+
+      /// \brief Durations of the system's PreUpdate calls.
+      public: DurationHistogram preUpdate;
+
+      /// \brief Durations of the system's Update calls.
+      public: DurationHistogram update;
+
+      /// \brief Durations of the system's PostUpdate calls.
+      public: DurationHistogram postUpdate;
+    };
+    }
+  }
+}
+#endif
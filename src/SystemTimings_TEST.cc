@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "SystemTimings.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(DurationHistogramTest, Empty)
+{
+  DurationHistogram hist;
+  EXPECT_EQ(0u, hist.Count());
+  EXPECT_EQ(0u, hist.TotalNs());
+  EXPECT_EQ(0u, hist.MaxNs());
+  EXPECT_EQ(0u, hist.PercentileNs(0.5));
+  EXPECT_EQ(0u, hist.PercentileNs(0.99));
+}
+
+/////////////////////////////////////////////////
+TEST(DurationHistogramTest, CountTotalMax)
+{
+  DurationHistogram hist;
+  hist.Record(100ns);
+  hist.Record(200ns);
+  hist.Record(700ns);
+
+  EXPECT_EQ(3u, hist.Count());
+  EXPECT_EQ(1000u, hist.TotalNs());
+  EXPECT_EQ(700u, hist.MaxNs());
+}
+
+/////////////////////////////////////////////////
+TEST(DurationHistogramTest, Percentiles)
+{
+  DurationHistogram hist;
+
+  // 90 short durations and 10 long ones.
+  for (int i = 0; i < 90; ++i)
+    hist.Record(100ns);
+  for (int i = 0; i < 10; ++i)
+    hist.Record(1ms);
+
+  // Percentiles are the upper bound of the bucket holding the rank:
+  // 100ns falls in the [64, 128) bucket, 1ms in [524288, 1048576).
+  EXPECT_EQ(127u, hist.PercentileNs(0.5));
+  EXPECT_EQ(127u, hist.PercentileNs(0.9));
+  EXPECT_EQ(1048575u, hist.PercentileNs(0.99));
+  EXPECT_EQ(1048575u, hist.PercentileNs(1.0));
+}
+
+/////////////////////////////////////////////////
+TEST(DurationHistogramTest, NegativeDurationClamped)
+{
+  DurationHistogram hist;
+  hist.Record(-5ns);
+  EXPECT_EQ(1u, hist.Count());
+  EXPECT_EQ(0u, hist.TotalNs());
+  EXPECT_EQ(0u, hist.MaxNs());
+}
+
+/////////////////////////////////////////////////
+TEST(SystemTimingsTest, Phases)
+{
+  SystemTimings timings("my_system");
+  EXPECT_EQ("my_system", timings.name);
+
+  timings.preUpdate.Record(1us);
+  timings.update.Record(2us);
+  timings.update.Record(4us);
+
+  EXPECT_EQ(1u, timings.preUpdate.Count());
+  EXPECT_EQ(2u, timings.update.Count());
+  EXPECT_EQ(0u, timings.postUpdate.Count());
+  EXPECT_EQ(6000u, timings.update.TotalNs());
+}
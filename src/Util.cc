@@ -24,17 +24,8 @@
 #endif
 #include <ignition/common/Filesystem.hh>
 
-#include "ignition/gazebo/components/Collision.hh"
-#include "ignition/gazebo/components/Joint.hh"
-#include "ignition/gazebo/components/Light.hh"
-#include "ignition/gazebo/components/Link.hh"
-#include "ignition/gazebo/components/Model.hh"
-#include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/Pose.hh"
-#include "ignition/gazebo/components/Sensor.hh"
-#include "ignition/gazebo/components/Visual.hh"
-#include "ignition/gazebo/components/World.hh"
 
 #include "ignition/gazebo/Util.hh"
 
@@ -48,6 +39,13 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
 math::Pose3d worldPose(const Entity &_entity,
     const EntityComponentManager &_ecm)
 {
+  // One batched sweep per step computes every world pose and is shared
+  // by all callers; see EntityComponentManager::WorldPose.
+  auto cached = _ecm.WorldPose(_entity);
+  if (cached)
+    return *cached;
+
+  // Entities created after the sweep fall back to walking the chain.
   // work out pose in world frame
   math::Pose3d pose = _ecm.Component<components::Pose>(_entity)->Data();
   auto p = _ecm.Component<components::ParentEntity>(_entity);
@@ -70,78 +68,21 @@ std::string scopedName(const Entity &_entity,
     const EntityComponentManager &_ecm, const std::string &_delim,
     bool _includePrefix)
 {
+  // The chain is cached by the entity component manager, so resolving the
+  // name again is a hash lookup plus string assembly.
   std::string result;
 
-  auto entity = _entity;
-
-  while (true)
+  for (const auto &level : _ecm.ScopedNameChain(_entity))
   {
-    // Get entity name
-    auto nameComp = _ecm.Component<components::Name>(entity);
-    if (nullptr == nameComp)
-      break;
-    auto name = nameComp->Data();
+    if (!result.empty())
+      result += _delim;
 
-    // Get entity type
-    std::string prefix;
-    if (_ecm.Component<components::World>(entity))
-    {
-      prefix = "world";
-    }
-    else if (_ecm.Component<components::Model>(entity))
-    {
-      prefix = "model";
-    }
-    else if (_ecm.Component<components::Light>(entity))
+    if (_includePrefix)
     {
-      prefix = "light";
+      result += level.first;
+      result += _delim;
     }
-    else if (_ecm.Component<components::Link>(entity))
-    {
-      prefix = "link";
-    }
-    else if (_ecm.Component<components::Collision>(entity))
-    {
-      prefix = "collision";
-    }
-    else if (_ecm.Component<components::Visual>(entity))
-    {
-      prefix = "visual";
-    }
-    else if (_ecm.Component<components::Joint>(entity))
-    {
-      prefix = "joint";
-    }
-    else if (_ecm.Component<components::Sensor>(entity))
-    {
-      prefix = "sensor";
-    }
-    else
-    {
-      ignwarn << "Skipping entity [" << name
-              << "] when generating scoped name, entity type not known."
-              << std::endl;
-    }
-
-
-    auto parentComp = _ecm.Component<components::ParentEntity>(entity);
-    if (!prefix.empty())
-    {
-      result.insert(0, name);
-      if (_includePrefix)
-      {
-        result.insert(0, _delim);
-        result.insert(0, prefix);
-      }
-    }
-
-    if (nullptr == parentComp)
-      break;
-
-    if (!prefix.empty())
-      result.insert(0, _delim);
-
-    entity = parentComp->Data();
+    result += level.second;
   }
 
   return result;
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+
 #include "ignition/gazebo/detail/View.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 
@@ -24,10 +26,74 @@ using namespace detail;
 //////////////////////////////////////////////////
 void View::AddEntity(const Entity _entity, const bool _new)
 {
-  this->entities.insert(_entity);
-  if (_new)
+  if (_new && this->trackNewRemoved &&
+      std::find(this->newEntities.begin(), this->newEntities.end(),
+      _entity) == this->newEntities.end())
+  {
+    this->newEntities.push_back(_entity);
+  }
+
+  // If the entity is pending removal, adding it back cancels the removal.
+  auto eraseIter = std::find(this->toEraseEntities.begin(),
+      this->toEraseEntities.end(), _entity);
+  if (eraseIter != this->toEraseEntities.end())
   {
-    this->newEntities.insert(_entity);
+    this->toEraseEntities.erase(eraseIter);
+    return;
+  }
+
+  // Skip entities that already belong to the view.
+  if (std::binary_search(this->entities.begin(), this->entities.end(),
+      _entity) ||
+      std::find(this->toAddEntities.begin(), this->toAddEntities.end(),
+      _entity) != this->toAddEntities.end())
+  {
+    return;
+  }
+
+  this->toAddEntities.push_back(_entity);
+}
+
+//////////////////////////////////////////////////
+bool View::HasEntity(const Entity _entity) const
+{
+  if (std::find(this->toEraseEntities.begin(), this->toEraseEntities.end(),
+      _entity) != this->toEraseEntities.end())
+  {
+    return false;
+  }
+
+  return std::binary_search(this->entities.begin(), this->entities.end(),
+      _entity) ||
+      std::find(this->toAddEntities.begin(), this->toAddEntities.end(),
+      _entity) != this->toAddEntities.end();
+}
+
+//////////////////////////////////////////////////
+void View::ApplyPendingChanges()
+{
+  if (!this->toEraseEntities.empty())
+  {
+    std::sort(this->toEraseEntities.begin(), this->toEraseEntities.end());
+    this->entities.erase(std::remove_if(this->entities.begin(),
+        this->entities.end(),
+        [this](const Entity _entity)
+        {
+          return std::binary_search(this->toEraseEntities.begin(),
+              this->toEraseEntities.end(), _entity);
+        }), this->entities.end());
+    this->toEraseEntities.clear();
+  }
+
+  if (!this->toAddEntities.empty())
+  {
+    std::sort(this->toAddEntities.begin(), this->toAddEntities.end());
+    const auto middle = this->entities.size();
+    this->entities.insert(this->entities.end(), this->toAddEntities.begin(),
+        this->toAddEntities.end());
+    std::inplace_merge(this->entities.begin(),
+        this->entities.begin() + middle, this->entities.end());
+    this->toAddEntities.clear();
   }
 }
 
@@ -43,13 +109,27 @@ void View::AddComponent(const Entity _entity,
 //////////////////////////////////////////////////
 bool View::RemoveEntity(const Entity _entity, const ComponentTypeKey &_key)
 {
-  if (this->entities.find(_entity) == this->entities.end())
+  if (!this->HasEntity(_entity))
     return false;
 
-  // Otherwise, remove the entity from the view
-  this->entities.erase(_entity);
-  this->newEntities.erase(_entity);
-  this->toRemoveEntities.erase(_entity);
+  // Buffer the removal from the entity vector; the bookkeeping structures
+  // are small enough to update eagerly. An entity that was itself still
+  // pending insertion just has the insertion cancelled.
+  auto addIter = std::find(this->toAddEntities.begin(),
+      this->toAddEntities.end(), _entity);
+  if (addIter != this->toAddEntities.end())
+    this->toAddEntities.erase(addIter);
+  else
+    this->toEraseEntities.push_back(_entity);
+  auto newIter = std::find(this->newEntities.begin(),
+      this->newEntities.end(), _entity);
+  if (newIter != this->newEntities.end())
+    this->newEntities.erase(newIter);
+  auto removeIter = std::find(this->toRemoveEntities.begin(),
+      this->toRemoveEntities.end(), _entity);
+  if (removeIter != this->toRemoveEntities.end())
+    this->toRemoveEntities.erase(removeIter);
+  this->bufferedEntities.erase(_entity);
 
   // Remove the entity from the components map
   for (const ComponentTypeId &compTypeId : _key)
@@ -64,8 +144,21 @@ const components::BaseComponent *View::ComponentImplementation(
     ComponentTypeId _typeId,
     const EntityComponentManager *_ecm) const
 {
-  return _ecm->ComponentImplementation(
-      {_typeId, this->components.at({_entity, _typeId})});
+  // Resolve the storage for this component type once, and reuse it for
+  // all subsequent accesses. This keeps iteration over the view within
+  // the contiguous per-type component arrays.
+  auto storageIter = this->storages.find(_typeId);
+  if (storageIter == this->storages.end())
+  {
+    storageIter = this->storages.insert(
+        {_typeId, _ecm->Storage(_typeId)}).first;
+  }
+
+  if (nullptr == storageIter->second)
+    return nullptr;
+
+  return storageIter->second->Component(
+      this->components.at({_entity, _typeId}));
 }
 
 //////////////////////////////////////////////////
@@ -77,8 +170,42 @@ void View::ClearNewEntities()
 //////////////////////////////////////////////////
 bool View::AddEntityToRemoved(const Entity _entity)
 {
-  if (this->entities.find(_entity) == this->entities.end())
+  // Views nobody calls EachRemoved on don't pay for removal tracking. A
+  // late subscription backfills from the manager's marked-for-removal
+  // state instead.
+  if (!this->trackNewRemoved)
     return false;
-  this->toRemoveEntities.insert(_entity);
+  if (!this->HasEntity(_entity))
+    return false;
+  if (std::find(this->toRemoveEntities.begin(), this->toRemoveEntities.end(),
+      _entity) == this->toRemoveEntities.end())
+  {
+    this->toRemoveEntities.push_back(_entity);
+  }
   return true;
 }
+
+//////////////////////////////////////////////////
+void View::SubscribeNewRemoved(const EntityComponentManager *_ecm)
+{
+  if (this->trackNewRemoved)
+    return;
+  this->trackNewRemoved = true;
+
+  // Backfill this step's churn so the first EachNew / EachRemoved call
+  // doesn't miss entities that changed before the subscription existed.
+  for (const Entity entity : this->entities)
+  {
+    if (_ecm->IsNewEntity(entity))
+      this->newEntities.push_back(entity);
+    if (_ecm->IsMarkedForRemoval(entity))
+      this->toRemoveEntities.push_back(entity);
+  }
+  for (const Entity entity : this->toAddEntities)
+  {
+    if (_ecm->IsNewEntity(entity))
+      this->newEntities.push_back(entity);
+    if (_ecm->IsMarkedForRemoval(entity))
+      this->toRemoveEntities.push_back(entity);
+  }
+}
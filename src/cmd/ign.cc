@@ -15,7 +15,12 @@
  *
 */
 #include <tinyxml2.h>
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
 #include <ignition/common/Console.hh>
 #include <ignition/common/SignalHandler.hh>
 #include <ignition/common/Filesystem.hh>
@@ -189,9 +194,67 @@ extern "C" IGNITION_GAZEBO_VISIBLE int runServer(const char *_sdfString,
     }
     else
     {
+      std::string playbackPath = ignition::common::absPath(
+        std::string(_playback));
+
+      // Batch playback: when the given directory is not itself a recording
+      // but contains several of them, replay all of the logs in this one
+      // process, one server per log, so plugin loading and other startup
+      // costs are paid once instead of once per log.
+      if (ignition::common::isDirectory(playbackPath) &&
+          !ignition::common::exists(
+          ignition::common::joinPaths(playbackPath, "state.tlog")))
+      {
+        std::vector<std::string> logs;
+        for (ignition::common::DirIter it(playbackPath);
+            it != ignition::common::DirIter(); ++it)
+        {
+          if (ignition::common::isDirectory(*it) &&
+              ignition::common::exists(
+              ignition::common::joinPaths(*it, "state.tlog")))
+          {
+            logs.push_back(*it);
+          }
+        }
+
+        if (!logs.empty())
+        {
+          std::sort(logs.begin(), logs.end());
+          ignmsg << "Batch playback of " << logs.size() << " logs in ["
+                 << playbackPath << "]" << std::endl;
+
+          std::vector<std::unique_ptr<ignition::gazebo::Server>> servers;
+          for (const auto &log : logs)
+          {
+            ignition::gazebo::ServerConfig logConfig = serverConfig;
+            logConfig.SetLogPlaybackPath(log);
+            servers.push_back(std::make_unique<ignition::gazebo::Server>(
+              logConfig));
+          }
+
+          // Run all playbacks concurrently and wait for them to finish
+          for (auto &server : servers)
+            server->Run(false, _iterations, _run == 0);
+
+          bool running = true;
+          while (running)
+          {
+            running = false;
+            for (auto &server : servers)
+              running = running || server->Running();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+          }
+
+          igndbg << "Shutting down batch playback" << std::endl;
+          return 0;
+        }
+
+        ignwarn << "No recordings found in [" << playbackPath << "]"
+                << std::endl;
+      }
+
       ignmsg << "Playing back states" << _playback << std::endl;
-      serverConfig.SetLogPlaybackPath(ignition::common::absPath(
-        std::string(_playback)));
+      serverConfig.SetLogPlaybackPath(playbackPath);
     }
   }
 
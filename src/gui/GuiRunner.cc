@@ -15,6 +15,12 @@
  *
 */
 
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Profiler.hh>
 #include <ignition/fuel_tools/Interface.hh>
@@ -45,12 +51,36 @@ GuiRunner::GuiRunner(const std::string &_worldName)
 
   this->RequestState();
 
-  // Periodic change updates
-  this->node.Subscribe(this->stateTopic, &GuiRunner::OnState, this);
+  // Apply states away from the transport and Qt event loop threads
+  this->stateThread = std::thread(&GuiRunner::StateThread, this);
+
+  // When the launcher forked the server and this GUI from the same
+  // invocation it exported a shared memory channel name; read the state
+  // stream from there, skipping the transport stack. Otherwise fall back
+  // to the state topic.
+  const char *shmName = std::getenv("IGN_GAZEBO_STATE_SHM");
+  if (nullptr != shmName && '\0' != shmName[0])
+  {
+    this->shmThread = std::thread(&GuiRunner::ShmStateThread, this,
+        std::string(shmName) + "-" + _worldName);
+  }
+  else
+  {
+    // Periodic change updates
+    this->node.Subscribe(this->stateTopic, &GuiRunner::OnState, this);
+  }
 }
 
 /////////////////////////////////////////////////
-GuiRunner::~GuiRunner() = default;
+GuiRunner::~GuiRunner()
+{
+  this->stateThreadRunning = false;
+  this->stateCv.notify_all();
+  if (this->stateThread.joinable())
+    this->stateThread.join();
+  if (this->shmThread.joinable())
+    this->shmThread.join();
+}
 
 /////////////////////////////////////////////////
 void GuiRunner::RequestState()
@@ -89,6 +119,106 @@ void GuiRunner::OnStateService(const msgs::SerializedStepMap &_res,
 void GuiRunner::OnState(const msgs::SerializedStepMap &_msg)
 {
   IGN_PROFILE_THREAD_NAME("GuiRunner::OnState");
+  IGN_PROFILE("GuiRunner::OnState");
+
+  // Deltas build on one another, so a backlog can't be thinned by
+  // dropping individual messages. If the GUI can't keep up, start over
+  // from a fresh keyframe instead of processing a growing queue.
+  static const std::size_t kMaxPendingStates{10u};
+
+  {
+    std::lock_guard<std::mutex> lock(this->stateMutex);
+    if (this->pendingStates.size() >= kMaxPendingStates)
+    {
+      this->pendingStates.clear();
+      this->RequestState();
+    }
+    this->pendingStates.push_back(_msg);
+  }
+  this->stateCv.notify_one();
+}
+
+/////////////////////////////////////////////////
+void GuiRunner::StateThread()
+{
+  IGN_PROFILE_THREAD_NAME("GuiRunner::StateThread");
+  while (this->stateThreadRunning)
+  {
+    msgs::SerializedStepMap msg;
+    {
+      std::unique_lock<std::mutex> lock(this->stateMutex);
+      this->stateCv.wait(lock, [this]()
+          {
+            return !this->stateThreadRunning || !this->pendingStates.empty();
+          });
+      if (!this->stateThreadRunning)
+        break;
+      msg = std::move(this->pendingStates.front());
+      this->pendingStates.pop_front();
+    }
+
+    this->ProcessState(msg);
+  }
+}
+
+/////////////////////////////////////////////////
+void GuiRunner::ShmStateThread(const std::string &_channelName)
+{
+  IGN_PROFILE_THREAD_NAME("GuiRunner::ShmStateThread");
+
+  // The server creates the channel while it sets up transport, which may
+  // happen after this GUI comes up; keep trying until it appears.
+  while (this->stateThreadRunning && nullptr == this->stateShm)
+  {
+    this->stateShm = ShmStateChannel::Attach(_channelName);
+    if (nullptr == this->stateShm)
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  if (nullptr != this->stateShm)
+  {
+    igndbg << "Reading state from shared memory channel [" << _channelName
+           << "]" << std::endl;
+  }
+
+  uint64_t lastSeq{0};
+  bool synced{false};
+  msgs::SerializedStepMap msg;
+  while (this->stateThreadRunning)
+  {
+    if (!this->stateShm->Read(msg))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      continue;
+    }
+
+    // The channel only holds the newest message, so if this thread falls
+    // behind the 60 Hz writer, intermediate deltas are lost. The header
+    // sequence number makes that visible: on a gap, drop the delta and
+    // recover through a keyframe, like a topic subscriber would.
+    uint64_t seq{0};
+    bool keyframe{false};
+    for (const auto &data : msg.state().header().data())
+    {
+      if (data.key() == "seq" && data.value_size() > 0)
+        seq = std::stoull(data.value(0));
+      else if (data.key() == "keyframe" && data.value_size() > 0)
+        keyframe = data.value(0) == "true";
+    }
+
+    if (!keyframe && synced && seq != lastSeq + 1)
+      this->RequestState();
+    else
+      this->OnState(msg);
+
+    synced = true;
+    lastSeq = seq;
+  }
+}
+
+/////////////////////////////////////////////////
+void GuiRunner::ProcessState(const msgs::SerializedStepMap &_msg)
+{
   IGN_PROFILE("GuiRunner::Update");
 
   this->ecm.SetState(_msg.state());
@@ -102,5 +232,10 @@ void GuiRunner::OnState(const msgs::SerializedStepMap &_msg)
   }
   this->ecm.ClearNewlyCreatedEntities();
   this->ecm.ProcessRemoveEntityRequests();
+
+  // Lower the change flags raised by SetState, so plugins that look at
+  // component states between updates only see what the next message
+  // actually touched. This mirrors the server-side update loop.
+  this->ecm.SetAllComponentsUnchanged();
 }
 
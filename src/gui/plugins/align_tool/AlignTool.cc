@@ -16,9 +16,12 @@
 */
 
 #include <ignition/msgs/boolean.pb.h>
+#include <ignition/msgs/pose_v.pb.h>
 #include <ignition/msgs/vector3d.pb.h>
 
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 #include <ignition/gui/Application.hh>
 #include <ignition/gui/MainWindow.hh>
 #include <ignition/common/Console.hh>
@@ -386,25 +389,37 @@ void AlignTool::Align()
   std::vector<ignition::rendering::VisualPtr> selectedList;
   ignition::rendering::VisualPtr relativeVisual;
 
-  for (const auto &entityId : this->dataPtr->selectedEntities)
+  // Map each selected entity to its visual in a single pass over the
+  // scene, instead of one scan per selected entity
+  std::unordered_set<Entity> selectedIds(
+      this->dataPtr->selectedEntities.begin(),
+      this->dataPtr->selectedEntities.end());
+  std::unordered_map<Entity, rendering::VisualPtr> selectedVisuals;
+  for (auto i = 0u; i < scene->VisualCount(); ++i)
   {
-    for (auto i = 0u; i < scene->VisualCount(); ++i)
-    {
-      ignition::rendering::VisualPtr vis = scene->VisualByIndex(i);
-      if (!vis)
-        continue;
+    ignition::rendering::VisualPtr vis = scene->VisualByIndex(i);
+    if (!vis)
+      continue;
 
-      if (std::get<int>(vis->UserData("gazebo-entity")) ==
-          static_cast<int>(entityId))
-      {
-        // Check here to see if visual is top level or not, continue if not
-        rendering::VisualPtr topLevelVis = this->TopLevelVisual(scene, vis);
-        if (topLevelVis != vis)
-          continue;
+    auto entityId = static_cast<Entity>(
+        std::get<int>(vis->UserData("gazebo-entity")));
+    if (selectedIds.find(entityId) == selectedIds.end())
+      continue;
 
-        selectedList.push_back(vis);
-      }
-    }
+    // Check here to see if visual is top level or not, continue if not
+    rendering::VisualPtr topLevelVis = this->TopLevelVisual(scene, vis);
+    if (topLevelVis != vis)
+      continue;
+
+    selectedVisuals[entityId] = vis;
+  }
+
+  // Preserve selection order, which determines the relative visual
+  for (const auto &entityId : this->dataPtr->selectedEntities)
+  {
+    auto visIt = selectedVisuals.find(entityId);
+    if (visIt != selectedVisuals.end())
+      selectedList.push_back(visIt->second);
   }
 
   // Selected links will result in this list being empty as they won't be
@@ -429,11 +444,14 @@ void AlignTool::Align()
   if (this->dataPtr->poseCmdService.empty())
   {
     this->dataPtr->poseCmdService = "/world/" + this->dataPtr->worldName
-        + "/set_pose";
+        + "/set_pose_vector";
   }
 
   int axisIndex = static_cast<int>(this->dataPtr->axis);
-  ignition::msgs::Pose req;
+
+  // All target poses are batched into one request, so aligning costs a
+  // single round trip regardless of how many entities are selected
+  ignition::msgs::Pose_V req;
 
   ignition::math::AxisAlignedBox targetBox = relativeVisual->BoundingBox();
   ignition::math::Vector3d targetMin = targetBox.Min();
@@ -474,10 +492,10 @@ void AlignTool::Align()
     else if (this->dataPtr->currentState == AlignState::ALIGN)
     {
       this->UpdateTransparency(vis, false /* opaque */);
-      req.set_name(vis->Name());
-      msgs::Set(req.mutable_position(), newPos);
-      msgs::Set(req.mutable_orientation(), vis->WorldRotation());
-      this->dataPtr->node.Request(this->dataPtr->poseCmdService, req, cb);
+      auto poseMsg = req.add_pose();
+      poseMsg->set_name(vis->Name());
+      msgs::Set(poseMsg->mutable_position(), newPos);
+      msgs::Set(poseMsg->mutable_orientation(), vis->WorldRotation());
       vis->SetUserData("pause-update", static_cast<int>(0));
       this->dataPtr->prevPositions[i-this->dataPtr->first] = newPos;
     }
@@ -532,9 +550,12 @@ void AlignTool::Align()
     this->dataPtr->currentState = AlignState::NONE;
     this->dataPtr->prevPositions.clear();
   }
-  // Also reset transparency map if state is align
+  // Also reset transparency map if state is align, and send the batched
+  // pose request
   else if (this->dataPtr->currentState == AlignState::ALIGN)
   {
+    if (req.pose_size() > 0)
+      this->dataPtr->node.Request(this->dataPtr->poseCmdService, req, cb);
     this->dataPtr->originalTransparency.clear();
   }
 }
@@ -68,6 +68,10 @@ namespace ignition::gazebo
     /// \brief Entity being inspected. Default to world.
     public: Entity entity{1};
 
+    /// \brief Entity that was inspected during the previous update, to
+    /// detect selection changes that require repopulating every component.
+    public: Entity lastEntity{kNullEntity};
+
     /// \brief World entity
     public: Entity worldEntity{kNullEntity};
 
@@ -292,6 +296,12 @@ void ComponentInspector::Update(const UpdateInfo &,
   if (this->dataPtr->paused)
     return;
 
+  // When the inspected entity changed, every component must be
+  // repopulated; otherwise only the components flagged changed this
+  // cycle need to touch the Qt model.
+  const bool fullRefresh = this->dataPtr->entity != this->dataPtr->lastEntity;
+  this->dataPtr->lastEntity = this->dataPtr->entity;
+
   auto componentTypes = _ecm.ComponentTypes(this->dataPtr->entity);
 
   // List all components
@@ -367,6 +377,7 @@ void ComponentInspector::Update(const UpdateInfo &,
 
     // Get component item
     QStandardItem *item;
+    bool newItem{false};
     auto itemIt = this->dataPtr->componentsModel.items.find(typeId);
     if (itemIt != this->dataPtr->componentsModel.items.end())
     {
@@ -381,6 +392,7 @@ void ComponentInspector::Update(const UpdateInfo &,
           Qt::BlockingQueuedConnection,
           Q_RETURN_ARG(QStandardItem *, item),
           Q_ARG(ignition::gazebo::ComponentTypeId, typeId));
+      newItem = true;
     }
 
     if (nullptr == item)
@@ -390,6 +402,15 @@ void ComponentInspector::Update(const UpdateInfo &,
       continue;
     }
 
+    // Skip components that were not touched by the latest state message,
+    // so steady-state updates don't rewrite the whole model every cycle
+    if (!fullRefresh && !newItem &&
+        ComponentState::NoChange ==
+        _ecm.ComponentState(this->dataPtr->entity, typeId))
+    {
+      continue;
+    }
+
     // Populate component-specific data
     if (typeId == components::AngularAcceleration::typeId)
     {
@@ -98,86 +98,132 @@ QString entityType(Entity _entity,
 /////////////////////////////////////////////////
 TreeModel::TreeModel() : QStandardItemModel()
 {
+  qRegisterMetaType<QVector<AddedEntity>>("QVector<AddedEntity>");
+  qRegisterMetaType<QVector<unsigned int>>("QVector<unsigned int>");
 }
 
 /////////////////////////////////////////////////
 void TreeModel::AddEntity(unsigned int _entity, const QString &_entityName,
     unsigned int _parentEntity, const QString &_type)
 {
-  IGN_PROFILE_THREAD_NAME("Qt thread");
-  IGN_PROFILE("TreeModel::AddEntity");
-  QStandardItem *parentItem{nullptr};
+  this->AddEntities({{_entity, _entityName, _parentEntity, _type}});
+}
 
-  // Root
-  if (_parentEntity == kNullEntity)
+/////////////////////////////////////////////////
+void TreeModel::AddEntities(const QVector<AddedEntity> &_entities)
+{
+  IGN_PROFILE_THREAD_NAME("Qt thread");
+  IGN_PROFILE("TreeModel::AddEntities");
+
+  // Build the role hash once per batch instead of once per item
+  auto roles = this->roleNames();
+  const int nameRole = roles.key("entityName");
+  const int entityRole = roles.key("entity");
+  const int typeRole = roles.key("type");
+
+  // Items queued for the parent currently being filled. Appending a run of
+  // siblings in one call gives the view a single rows-inserted signal for
+  // the whole run.
+  QStandardItem *runParent{nullptr};
+  QList<QStandardItem *> run;
+  auto flushRun = [&]()
   {
-    parentItem = this->invisibleRootItem();
-  }
+    if (nullptr != runParent && !run.isEmpty())
+      runParent->appendRows(run);
+    run.clear();
+  };
 
-  // Nested
-  // TODO(louise) There should be a way to easily access these from
-  // QStandardItemModel instead of keeping our own map
-  auto item = this->entityItems.find(_parentEntity);
-  if (item != this->entityItems.end())
+  for (const auto &added : _entities)
   {
-    parentItem = item->second;
-  }
+    QStandardItem *parentItem{nullptr};
 
-  if (nullptr == parentItem)
-  {
-    ignerr << "Failed to find parent entity [" << _parentEntity << "]"
-           << std::endl;
-    return;
-  }
+    // Root
+    if (added.parent == kNullEntity)
+    {
+      parentItem = this->invisibleRootItem();
+    }
 
-  // New entity item
-  auto entityItem = new QStandardItem(_entityName);
-  entityItem->setData(_entityName, this->roleNames().key("entityName"));
-  entityItem->setData(QString::number(_entity),
-      this->roleNames().key("entity"));
-  entityItem->setData(_type, this->roleNames().key("type"));
+    // Nested
+    // TODO(louise) There should be a way to easily access these from
+    // QStandardItemModel instead of keeping our own map
+    auto item = this->entityItems.find(added.parent);
+    if (item != this->entityItems.end())
+    {
+      parentItem = item->second;
+    }
+
+    if (nullptr == parentItem)
+    {
+      ignerr << "Failed to find parent entity [" << added.parent << "]"
+             << std::endl;
+      continue;
+    }
+
+    if (parentItem != runParent)
+    {
+      flushRun();
+      runParent = parentItem;
+    }
 
-  parentItem->appendRow(entityItem);
+    // New entity item
+    auto entityItem = new QStandardItem(added.name);
+    entityItem->setData(added.name, nameRole);
+    entityItem->setData(QString::number(added.entity), entityRole);
+    entityItem->setData(added.type, typeRole);
 
-  this->entityItems[_entity] = entityItem;
+    run.push_back(entityItem);
+    this->entityItems[added.entity] = entityItem;
+  }
+  flushRun();
 }
 
 /////////////////////////////////////////////////
 void TreeModel::RemoveEntity(unsigned int _entity)
 {
-  IGN_PROFILE("TreeModel::RemoveEntity");
-  QStandardItem *item{nullptr};
-  auto itemIt = this->entityItems.find(_entity);
-  if (itemIt != this->entityItems.end())
-  {
-    item = itemIt->second;
-  }
+  this->RemoveEntities({_entity});
+}
 
-  if (nullptr == item)
-  {
-    return;
-  }
+/////////////////////////////////////////////////
+void TreeModel::RemoveEntities(const QVector<unsigned int> &_entities)
+{
+  IGN_PROFILE("TreeModel::RemoveEntities");
 
-  // Remove all children from our custom map
-  std::function<void(const QStandardItem *)> removeChildren =
-      [&](const QStandardItem *_item)
+  const int entityRole = this->roleNames().key("entity");
+
+  for (const auto entity : _entities)
   {
-    for (int i = 0; i < _item->rowCount(); ++i)
+    QStandardItem *item{nullptr};
+    auto itemIt = this->entityItems.find(entity);
+    if (itemIt != this->entityItems.end())
     {
-      auto childItem = _item->child(i);
-      removeChildren(childItem);
-      this->entityItems.erase(childItem->data(
-          this->roleNames().key("entity")).toUInt());
+      item = itemIt->second;
     }
-  };
-  this->entityItems.erase(_entity);
-  removeChildren(item);
 
-  // Remove from the view
-  if (nullptr == item->parent())
-    this->removeRow(item->row());
-  else
-    item->parent()->removeRow(item->row());
+    if (nullptr == item)
+    {
+      continue;
+    }
+
+    // Remove all children from our custom map
+    std::function<void(const QStandardItem *)> removeChildren =
+        [&](const QStandardItem *_item)
+    {
+      for (int i = 0; i < _item->rowCount(); ++i)
+      {
+        auto childItem = _item->child(i);
+        removeChildren(childItem);
+        this->entityItems.erase(childItem->data(entityRole).toUInt());
+      }
+    };
+    this->entityItems.erase(entity);
+    removeChildren(item);
+
+    // Remove from the view
+    if (nullptr == item->parent())
+      this->removeRow(item->row());
+    else
+      item->parent()->removeRow(item->row());
+  }
 }
 
 /////////////////////////////////////////////////
@@ -265,6 +311,13 @@ void EntityTree::LoadConfig(const tinyxml2::XMLElement *)
 void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
 {
   IGN_PROFILE("EntityTree::Update");
+
+  // Additions and removals are collected here and handed to the Qt thread
+  // in one queued call each, so a level streaming in costs two queued
+  // events rather than one per entity.
+  QVector<AddedEntity> addedEntities;
+  QVector<unsigned int> removedEntities;
+
   // Treat all pre-existent entities as new at startup
   if (!this->dataPtr->initialized)
   {
@@ -297,12 +350,10 @@ void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
         parentEntity = kNullEntity;
       }
 
-      QMetaObject::invokeMethod(&this->dataPtr->treeModel, "AddEntity",
-          Qt::QueuedConnection,
-          Q_ARG(unsigned int, _entity),
-          Q_ARG(QString, QString::fromStdString(_name->Data())),
-          Q_ARG(unsigned int, parentEntity),
-          Q_ARG(QString, entityType(_entity, _ecm)));
+      addedEntities.push_back({static_cast<unsigned int>(_entity),
+          QString::fromStdString(_name->Data()),
+          static_cast<unsigned int>(parentEntity),
+          entityType(_entity, _ecm)});
       return true;
     });
     this->dataPtr->initialized = true;
@@ -325,12 +376,10 @@ void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
         parentEntity = kNullEntity;
       }
 
-      QMetaObject::invokeMethod(&this->dataPtr->treeModel, "AddEntity",
-          Qt::QueuedConnection,
-          Q_ARG(unsigned int, _entity),
-          Q_ARG(QString, QString::fromStdString(_name->Data())),
-          Q_ARG(unsigned int, parentEntity),
-          Q_ARG(QString, entityType(_entity, _ecm)));
+      addedEntities.push_back({static_cast<unsigned int>(_entity),
+          QString::fromStdString(_name->Data()),
+          static_cast<unsigned int>(parentEntity),
+          entityType(_entity, _ecm)});
       return true;
     });
   }
@@ -339,11 +388,23 @@ void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
     [&](const Entity &_entity,
         const components::Name *)->bool
   {
-    QMetaObject::invokeMethod(&this->dataPtr->treeModel, "RemoveEntity",
-        Qt::QueuedConnection,
-        Q_ARG(unsigned int, _entity));
+    removedEntities.push_back(static_cast<unsigned int>(_entity));
     return true;
   });
+
+  if (!addedEntities.isEmpty())
+  {
+    QMetaObject::invokeMethod(&this->dataPtr->treeModel, "AddEntities",
+        Qt::QueuedConnection,
+        Q_ARG(QVector<AddedEntity>, addedEntities));
+  }
+
+  if (!removedEntities.isEmpty())
+  {
+    QMetaObject::invokeMethod(&this->dataPtr->treeModel, "RemoveEntities",
+        Qt::QueuedConnection,
+        Q_ARG(QVector<unsigned int>, removedEntities));
+  }
 }
 
 /////////////////////////////////////////////////
@@ -29,6 +29,24 @@ namespace gazebo
 {
   class EntityTreePrivate;
 
+  /// \brief Data describing one entity to be added to the tree. Additions
+  /// are batched into vectors of these so that a burst of new entities
+  /// costs one queued call into the Qt thread instead of one per entity.
+  struct AddedEntity
+  {
+    /// \brief Entity to be added
+    unsigned int entity;
+
+    /// \brief Entity name
+    QString name;
+
+    /// \brief Parent entity
+    unsigned int parent;
+
+    /// \brief Entity type
+    QString type;
+  };
+
   /// \brief TODO
   class TreeModel : public QStandardItemModel
   {
@@ -54,10 +72,20 @@ namespace gazebo
         unsigned int _parentEntity = kNullEntity,
         const QString &_type = QString());
 
+    /// \brief Add a batch of entities to the tree. Consecutive entities
+    /// with the same parent are appended in one model insertion, so the
+    /// view processes one rows-inserted signal per group of siblings.
+    /// \param[in] _entities Entities to be added, parents before children.
+    public slots: void AddEntities(const QVector<AddedEntity> &_entities);
+
     /// \brief Remove an entity from the tree.
     /// \param[in] _entity Entity to be removed
     public slots: void RemoveEntity(unsigned int _entity);
 
+    /// \brief Remove a batch of entities from the tree.
+    /// \param[in] _entities Entities to be removed
+    public slots: void RemoveEntities(const QVector<unsigned int> &_entities);
+
     /// \brief Get the entity type of a tree item at specified index
     /// \param[in] _index Model index
     /// \return Type of entity
@@ -116,4 +144,6 @@ namespace gazebo
 }
 }
 
+Q_DECLARE_METATYPE(ignition::gazebo::AddedEntity)
+
 #endif
@@ -16,9 +16,13 @@
 */
 
 #include <cmath>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <sdf/Link.hh>
@@ -255,6 +259,49 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \brief Video encoder
     public: common::VideoEncoder videoEncoder;
 
+    /// \brief One captured frame waiting to be encoded.
+    public: struct VideoFrame
+    {
+      /// \brief Raw image data
+      std::vector<unsigned char> data;
+
+      /// \brief Frame width in pixels
+      unsigned int width;
+
+      /// \brief Frame height in pixels
+      unsigned int height;
+    };
+
+    /// \brief Captured frames waiting to be encoded. Bounded so a slow
+    /// encoder cannot grow the queue without limit; when full, the oldest
+    /// queued frame is dropped and counted, so the recording stays close
+    /// to what is currently on screen.
+    public: std::deque<VideoFrame> videoFrameQueue;
+
+    /// \brief Frame buffers returned by the encoder thread for reuse, so
+    /// steady-state recording does not allocate on the render thread.
+    public: std::vector<std::vector<unsigned char>> videoFreeBuffers;
+
+    /// \brief Maximum number of captured frames held in the queue.
+    public: const size_t maxVideoFrames = 60u;
+
+    /// \brief Number of frames dropped because the queue was full.
+    public: uint64_t droppedVideoFrames = 0u;
+
+    /// \brief Protects videoFrameQueue and videoEncodeStop.
+    public: std::mutex videoQueueMutex;
+
+    /// \brief Signals the encoder thread that a frame is ready or that
+    /// recording is being stopped.
+    public: std::condition_variable videoQueueCv;
+
+    /// \brief Worker thread that encodes queued frames, keeping encoding
+    /// off the render thread.
+    public: std::thread videoEncodeThread;
+
+    /// \brief Tells the encoder thread to exit once the queue is drained.
+    public: bool videoEncodeStop = false;
+
     /// \brief Ray query for mouse clicks
     public: rendering::RayQueryPtr rayQuery;
 
@@ -368,7 +415,19 @@ IgnRenderer::IgnRenderer()
 
 
 /////////////////////////////////////////////////
-IgnRenderer::~IgnRenderer() = default;
+IgnRenderer::~IgnRenderer()
+{
+  // Stop the video encoder thread if the window is closed mid-recording
+  if (this->dataPtr->videoEncodeThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->videoQueueMutex);
+      this->dataPtr->videoEncodeStop = true;
+    }
+    this->dataPtr->videoQueueCv.notify_one();
+    this->dataPtr->videoEncodeThread.join();
+  }
+}
 
 ////////////////////////////////////////////////
 RenderUtil *IgnRenderer::RenderUtil() const
@@ -445,22 +504,105 @@ void IgnRenderer::Render()
         this->dataPtr->cameraImage = this->dataPtr->camera->CreateImage();
       }
 
-      // Video recorder is on. Add more frames to it
+      // Video recorder is on. Queue the captured frame for the encoder
+      // thread, so encoding never blocks the render loop.
       if (this->dataPtr->videoEncoder.IsEncoding())
       {
         this->dataPtr->camera->Copy(this->dataPtr->cameraImage);
-        this->dataPtr->videoEncoder.AddFrame(
-            this->dataPtr->cameraImage.Data<unsigned char>(), width, height);
+        auto *imgData = this->dataPtr->cameraImage.Data<unsigned char>();
+
+        IgnRendererPrivate::VideoFrame frame;
+        {
+          std::lock_guard<std::mutex> lock(this->dataPtr->videoQueueMutex);
+          if (!this->dataPtr->videoFreeBuffers.empty())
+          {
+            frame.data = std::move(this->dataPtr->videoFreeBuffers.back());
+            this->dataPtr->videoFreeBuffers.pop_back();
+          }
+        }
+        // Copy outside the lock; a recycled buffer already has the right
+        // capacity, so this does not allocate once recording is warm.
+        frame.data.assign(imgData,
+            imgData + this->dataPtr->cameraImage.MemorySize());
+        frame.width = width;
+        frame.height = height;
+
+        {
+          std::lock_guard<std::mutex> lock(this->dataPtr->videoQueueMutex);
+          if (this->dataPtr->videoFrameQueue.size() >=
+              this->dataPtr->maxVideoFrames)
+          {
+            // Drop the oldest frame so the encoder works on the most
+            // recent footage when it falls behind.
+            this->dataPtr->videoFreeBuffers.push_back(
+                std::move(this->dataPtr->videoFrameQueue.front().data));
+            this->dataPtr->videoFrameQueue.pop_front();
+            this->dataPtr->droppedVideoFrames++;
+          }
+          this->dataPtr->videoFrameQueue.push_back(std::move(frame));
+        }
+        this->dataPtr->videoQueueCv.notify_one();
       }
       // Video recorder is idle. Start recording.
       else
       {
         this->dataPtr->videoEncoder.Start(this->dataPtr->recordVideoFormat,
             this->dataPtr->recordVideoSavePath, width, height);
+
+        // Launch the encoder thread, which drains the frame queue
+        this->dataPtr->videoEncodeStop = false;
+        this->dataPtr->droppedVideoFrames = 0u;
+        this->dataPtr->videoEncodeThread = std::thread([this]()
+            {
+              while (true)
+              {
+                IgnRendererPrivate::VideoFrame frame;
+                {
+                  std::unique_lock<std::mutex> lock(
+                      this->dataPtr->videoQueueMutex);
+                  this->dataPtr->videoQueueCv.wait(lock, [this]()
+                      {
+                        return this->dataPtr->videoEncodeStop ||
+                            !this->dataPtr->videoFrameQueue.empty();
+                      });
+                  // Drain remaining frames before exiting
+                  if (this->dataPtr->videoFrameQueue.empty())
+                    break;
+                  frame = std::move(this->dataPtr->videoFrameQueue.front());
+                  this->dataPtr->videoFrameQueue.pop_front();
+                }
+                this->dataPtr->videoEncoder.AddFrame(frame.data.data(),
+                    frame.width, frame.height);
+                // Hand the buffer back so the render thread can reuse it
+                {
+                  std::lock_guard<std::mutex> lock(
+                      this->dataPtr->videoQueueMutex);
+                  this->dataPtr->videoFreeBuffers.push_back(
+                      std::move(frame.data));
+                }
+              }
+            });
       }
     }
     else if (this->dataPtr->videoEncoder.IsEncoding())
     {
+      // Stop the encoder thread first so all queued frames are encoded
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->videoQueueMutex);
+        this->dataPtr->videoEncodeStop = true;
+      }
+      this->dataPtr->videoQueueCv.notify_one();
+      if (this->dataPtr->videoEncodeThread.joinable())
+        this->dataPtr->videoEncodeThread.join();
+      this->dataPtr->videoFreeBuffers.clear();
+
+      if (this->dataPtr->droppedVideoFrames > 0u)
+      {
+        ignwarn << "Dropped " << this->dataPtr->droppedVideoFrames
+                << " video frames because encoding could not keep up"
+                << std::endl;
+      }
+
       this->dataPtr->videoEncoder.Stop();
     }
   }
@@ -2121,6 +2263,13 @@ void Scene3D::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         visibilityMaskStr >> visibilityMask;
       renderWindow->SetVisibilityMask(visibilityMask);
     }
+
+    if (auto elem = _pluginElem->FirstChildElement("pose_interpolation"))
+    {
+      std::string interpolateStr = common::lowercase(elem->GetText());
+      this->dataPtr->renderUtil->SetPoseInterpolation(
+          interpolateStr == "true" || interpolateStr == "1");
+    }
   }
 
   // transform mode
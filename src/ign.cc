@@ -14,15 +14,35 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <ignition/common/Console.hh>
 #include <ignition/common/Filesystem.hh>
+#include <ignition/common/SignalHandler.hh>
+#include <ignition/msgs/boolean.pb.h>
+#include <ignition/msgs/stringmsg.pb.h>
+#include <ignition/transport/Node.hh>
 
 #include "ignition/gazebo/config.hh"
 #include "ignition/gazebo/Server.hh"
 #include "ignition/gazebo/ServerConfig.hh"
 
 #include "ignition/gazebo/gui/Gui.hh"
+#include "msgs/memory_statistics.pb.h"
+#include "msgs/system_statistics.pb.h"
 #include "ign.hh"
 
 //////////////////////////////////////////////////
@@ -270,6 +290,363 @@ extern "C" IGNITION_GAZEBO_VISIBLE int runServer(const char *_sdfString,
   return 0;
 }
 
+//////////////////////////////////////////////////
+extern "C" IGNITION_GAZEBO_VISIBLE int runDaemon(const char *_file)
+{
+  ignLogInit(ignition::gazebo::ServerConfig().LogRecordPath(),
+      "server_console.log");
+
+  ignmsg << "Ignition Gazebo Daemon v" << IGNITION_GAZEBO_VERSION_FULL
+         << std::endl;
+
+  // Pre-warm the process. Constructing a server loads the system plugin
+  // shared libraries and primes the SDF and resource caches, which is
+  // where most of a cold start is spent. The server itself is discarded;
+  // the libraries stay mapped, so servers created for later run requests
+  // start in tens of milliseconds instead of seconds.
+  {
+    ignition::gazebo::ServerConfig prewarmConfig;
+    if (_file != nullptr && std::strlen(_file) > 0)
+      prewarmConfig.SetSdfFile(_file);
+    ignition::gazebo::Server prewarm(prewarmConfig);
+  }
+  ignmsg << "Daemon pre-warm complete, waiting for run requests."
+         << std::endl;
+
+  std::mutex requestMutex;
+  std::vector<std::string> pendingFiles;
+  bool shutdown{false};
+
+  // Accept run requests. The request payload is the path to an SDF file.
+  std::function<bool(const ignition::msgs::StringMsg &,
+      ignition::msgs::Boolean &)> runCb =
+    [&](const ignition::msgs::StringMsg &_req,
+        ignition::msgs::Boolean &_res) -> bool
+    {
+      if (_req.data().empty() || !ignition::common::exists(_req.data()))
+      {
+        ignerr << "Daemon run request for missing file [" << _req.data()
+               << "]" << std::endl;
+        _res.set_data(false);
+        return true;
+      }
+      std::lock_guard<std::mutex> lock(requestMutex);
+      pendingFiles.push_back(_req.data());
+      _res.set_data(true);
+      return true;
+    };
+
+  std::function<bool(ignition::msgs::Boolean &)> shutdownCb =
+    [&](ignition::msgs::Boolean &_res) -> bool
+    {
+      std::lock_guard<std::mutex> lock(requestMutex);
+      shutdown = true;
+      _res.set_data(true);
+      return true;
+    };
+
+  ignition::transport::Node node;
+  node.Advertise("/gazebo/daemon/run", runCb);
+  node.Advertise("/gazebo/daemon/shutdown", shutdownCb);
+
+  ignition::common::SignalHandler sigHandler;
+  sigHandler.AddCallback([&](int)
+    {
+      std::lock_guard<std::mutex> lock(requestMutex);
+      shutdown = true;
+    });
+
+  // Each request gets its own server, run in this process so it reuses
+  // the warm plugin libraries. Finished servers are pruned so a
+  // long-lived daemon does not accumulate worlds.
+  std::list<std::unique_ptr<ignition::gazebo::Server>> servers;
+  while (true)
+  {
+    std::vector<std::string> files;
+    {
+      std::lock_guard<std::mutex> lock(requestMutex);
+      if (shutdown)
+        break;
+      files.swap(pendingFiles);
+    }
+
+    for (const auto &file : files)
+    {
+      ignmsg << "Daemon starting simulation [" << file << "]" << std::endl;
+      ignition::gazebo::ServerConfig serverConfig;
+      serverConfig.SetSdfFile(file);
+      auto server =
+          std::make_unique<ignition::gazebo::Server>(serverConfig);
+      server->Run(false, 0, false);
+      servers.push_back(std::move(server));
+    }
+
+    servers.remove_if([](const auto &_server)
+        {
+          return !_server->Running();
+        });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  igndbg << "Shutting down ign-gazebo-daemon" << std::endl;
+  return 0;
+}
+
+namespace
+{
+/// \brief Format a nanosecond duration as microseconds with one decimal.
+std::string FormatUs(uint64_t _ns)
+{
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(1)
+      << static_cast<double>(_ns) / 1000.0;
+  return out.str();
+}
+
+/// \brief Print one row of the per-system timing table.
+void PrintPhaseRow(const std::string &_system, const std::string &_phase,
+    const ignition::gazebo::private_msgs::PhaseStatistics &_stats)
+{
+  if (_stats.count() == 0)
+    return;
+  std::cout << "  " << std::left << std::setw(34) << _system
+            << std::setw(12) << _phase << std::right
+            << std::setw(9) << _stats.count()
+            << std::setw(12) << std::fixed << std::setprecision(1)
+            << static_cast<double>(_stats.total_ns()) / 1e6
+            << std::setw(10) << FormatUs(_stats.p50_ns())
+            << std::setw(10) << FormatUs(_stats.p90_ns())
+            << std::setw(10) << FormatUs(_stats.p99_ns())
+            << std::setw(10) << FormatUs(_stats.max_ns())
+            << std::endl;
+}
+}  // namespace
+
+//////////////////////////////////////////////////
+extern "C" IGNITION_GAZEBO_VISIBLE int runProfiler(const char *_file,
+    int _seconds)
+{
+  if (_file == nullptr || std::strlen(_file) == 0)
+  {
+    ignerr << "The profiler needs a world file to load." << std::endl;
+    return -1;
+  }
+  const int seconds = _seconds > 0 ? _seconds : 10;
+
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(_file);
+
+  ignmsg << "Profiling [" << _file << "] headless for " << seconds
+         << " seconds" << std::endl;
+
+  ignition::gazebo::Server server(serverConfig);
+  server.Run(false, 0, false);
+
+  // Let the server's publishers and services come up before sampling.
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  // Count every message published while the window is open. Raw
+  // subscriptions avoid deserializing, so observing a topic costs one
+  // callback and the intraprocess copy.
+  std::mutex topicMutex;
+  std::map<std::string, std::pair<uint64_t, uint64_t>> topicCounts;
+  ignition::transport::Node node;
+  std::function<void(const char *, const size_t,
+      const ignition::transport::MessageInfo &)> countCb =
+    [&](const char *, const size_t _size,
+        const ignition::transport::MessageInfo &_info)
+    {
+      std::lock_guard<std::mutex> lock(topicMutex);
+      auto &entry = topicCounts[_info.Topic()];
+      ++entry.first;
+      entry.second += _size;
+    };
+
+  std::vector<std::string> topics;
+  node.TopicList(topics);
+  for (const auto &topic : topics)
+    node.SubscribeRaw(topic, countCb);
+
+  const auto windowStart = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  const double windowSec = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - windowStart).count();
+
+  std::map<std::string, std::pair<uint64_t, uint64_t>> counts;
+  {
+    std::lock_guard<std::mutex> lock(topicMutex);
+    counts = topicCounts;
+  }
+
+  // The stats services are advertised under /world/<name>; find them by
+  // suffix so the world name doesn't need to be parsed from the SDF.
+  std::string systemStatsService;
+  std::string memoryStatsService;
+  std::vector<std::string> services;
+  node.ServiceList(services);
+  for (const auto &service : services)
+  {
+    if (service.find("/world/") != 0)
+      continue;
+    const std::string systemSuffix{"/system_stats"};
+    const std::string memorySuffix{"/memory_stats"};
+    if (service.size() > systemSuffix.size() &&
+        service.compare(service.size() - systemSuffix.size(),
+          systemSuffix.size(), systemSuffix) == 0)
+    {
+      systemStatsService = service;
+    }
+    else if (service.size() > memorySuffix.size() &&
+        service.compare(service.size() - memorySuffix.size(),
+          memorySuffix.size(), memorySuffix) == 0)
+    {
+      memoryStatsService = service;
+    }
+  }
+
+  ignition::gazebo::private_msgs::SystemStatistics_V systemStats;
+  ignition::gazebo::private_msgs::MemoryStatistics memoryStats;
+  bool haveSystemStats{false};
+  bool haveMemoryStats{false};
+  bool result{false};
+  const unsigned int timeoutMs{5000};
+  if (!systemStatsService.empty())
+  {
+    haveSystemStats = node.Request(systemStatsService, timeoutMs,
+        systemStats, result) && result;
+  }
+  if (!memoryStatsService.empty())
+  {
+    haveMemoryStats = node.Request(memoryStatsService, timeoutMs,
+        memoryStats, result) && result;
+  }
+
+  std::cout << std::endl
+            << "Profile of [" << _file << "]" << std::endl
+            << "  wall clock: " << std::fixed << std::setprecision(1)
+            << windowSec << " s";
+  if (haveSystemStats)
+  {
+    std::cout << ", iterations: " << systemStats.iterations()
+              << " (" << std::setprecision(1)
+              << static_cast<double>(systemStats.iterations()) / windowSec
+              << " Hz)";
+  }
+  std::cout << std::endl << std::endl;
+
+  if (haveSystemStats)
+  {
+    // Sort systems by accumulated time, biggest consumers first.
+    std::vector<const ignition::gazebo::private_msgs::SystemStatistics *>
+        systems;
+    for (const auto &system : systemStats.systems())
+      systems.push_back(&system);
+    auto totalNs =
+      [](const ignition::gazebo::private_msgs::SystemStatistics *_s)
+      {
+        return _s->pre_update().total_ns() + _s->update().total_ns() +
+            _s->post_update().total_ns();
+      };
+    std::sort(systems.begin(), systems.end(),
+        [&totalNs](const auto *_a, const auto *_b)
+        {
+          return totalNs(_a) > totalNs(_b);
+        });
+
+    std::cout << "Per-system timings:" << std::endl
+              << "  " << std::left << std::setw(34) << "SYSTEM"
+              << std::setw(12) << "PHASE" << std::right
+              << std::setw(9) << "CALLS" << std::setw(12) << "TOTAL(ms)"
+              << std::setw(10) << "P50(us)" << std::setw(10) << "P90(us)"
+              << std::setw(10) << "P99(us)" << std::setw(10) << "MAX(us)"
+              << std::endl;
+    for (const auto *system : systems)
+    {
+      PrintPhaseRow(system->name(), "PreUpdate", system->pre_update());
+      PrintPhaseRow(system->name(), "Update", system->update());
+      PrintPhaseRow(system->name(), "PostUpdate", system->post_update());
+    }
+    std::cout << std::endl;
+  }
+  else
+  {
+    ignwarn << "System timing statistics unavailable." << std::endl;
+  }
+
+  if (haveMemoryStats)
+  {
+    std::cout << "Entity component manager: "
+              << memoryStats.entity_count() << " entities, "
+              << memoryStats.storages_size() << " component types, "
+              << memoryStats.storage_bytes() / 1024 << " KiB storages, "
+              << memoryStats.view_bytes() / 1024 << " KiB views ("
+              << memoryStats.views_size() << " views)" << std::endl;
+
+    std::vector<const ignition::gazebo::private_msgs::StorageMemory *>
+        storages;
+    for (const auto &storage : memoryStats.storages())
+      storages.push_back(&storage);
+    std::sort(storages.begin(), storages.end(),
+        [](const auto *_a, const auto *_b)
+        {
+          return _a->bytes() > _b->bytes();
+        });
+
+    std::cout << "  " << std::left << std::setw(46) << "COMPONENT"
+              << std::right << std::setw(10) << "COUNT"
+              << std::setw(12) << "KiB" << std::endl;
+    for (const auto *storage : storages)
+    {
+      std::cout << "  " << std::left << std::setw(46) << storage->name()
+                << std::right << std::setw(10) << storage->component_count()
+                << std::setw(12) << std::fixed << std::setprecision(1)
+                << static_cast<double>(storage->bytes()) / 1024.0
+                << std::endl;
+    }
+    std::cout << std::endl;
+  }
+  else
+  {
+    ignwarn << "Memory statistics unavailable." << std::endl;
+  }
+
+  if (!counts.empty())
+  {
+    // Sort topics by message rate.
+    std::vector<std::pair<std::string, std::pair<uint64_t, uint64_t>>>
+        sortedTopics(counts.begin(), counts.end());
+    std::sort(sortedTopics.begin(), sortedTopics.end(),
+        [](const auto &_a, const auto &_b)
+        {
+          return _a.second.first > _b.second.first;
+        });
+
+    std::cout << "Message rates:" << std::endl
+              << "  " << std::left << std::setw(56) << "TOPIC"
+              << std::right << std::setw(9) << "MSGS"
+              << std::setw(10) << "HZ" << std::setw(12) << "KiB/s"
+              << std::endl;
+    for (const auto &topic : sortedTopics)
+    {
+      if (topic.second.first == 0)
+        continue;
+      std::cout << "  " << std::left << std::setw(56) << topic.first
+                << std::right << std::setw(9) << topic.second.first
+                << std::setw(10) << std::fixed << std::setprecision(1)
+                << static_cast<double>(topic.second.first) / windowSec
+                << std::setw(12)
+                << static_cast<double>(topic.second.second) / 1024.0
+                    / windowSec
+                << std::endl;
+    }
+    std::cout << std::endl;
+  }
+
+  igndbg << "Shutting down ign-gazebo-profiler" << std::endl;
+  return 0;
+}
+
 //////////////////////////////////////////////////
 extern "C" IGNITION_GAZEBO_VISIBLE int runGui(const char *_guiConfig)
 {
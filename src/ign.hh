@@ -58,6 +58,27 @@ extern "C" IGNITION_GAZEBO_VISIBLE int runServer(const char *_sdfString,
     int _logCompress, const char *_playback,
     const char *_physicsEngine, const char *_file);
 
+/// \brief External hook to run the simulation daemon. The daemon is a
+/// resident server process that pre-loads the system plugin libraries and
+/// then accepts run requests over the /gazebo/daemon/run service, so
+/// repeated simulations skip the per-process startup cost.
+/// \param[in] _file Path to an SDF file used to pre-warm the plugin
+/// libraries and resource caches. May be empty, in which case the default
+/// world is used.
+/// \return 0 if successful, 1 if not.
+extern "C" IGNITION_GAZEBO_VISIBLE int runDaemon(const char *_file);
+
+/// \brief External hook to run the world statistics profiler. Loads a
+/// world, runs it headless for the given number of seconds and prints a
+/// report: per-system timings, entity and component counts, entity
+/// component manager memory, and message rates per topic.
+/// \param[in] _file Path to the SDF file to profile.
+/// \param[in] _seconds Number of seconds to run. Values less than one
+/// select the default of ten seconds.
+/// \return 0 if successful, -1 if not.
+extern "C" IGNITION_GAZEBO_VISIBLE int runProfiler(const char *_file,
+    int _seconds);
+
 /// \brief External hook to run simulation GUI.
 /// \param[in] _guiConfig Path to Ignition GUI configuration file.
 /// \return 0 if successful, 1 if not.
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <string>
+#include <unordered_set>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
@@ -25,6 +26,7 @@
 #include "msgs/peer_control.pb.h"
 #include "msgs/simulation_step.pb.h"
 
+#include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/PerformerAffinity.hh"
 #include "ignition/gazebo/components/PerformerLevels.hh"
 #include "ignition/gazebo/Conversions.hh"
@@ -50,12 +52,29 @@ NetworkManagerPrimary::NetworkManagerPrimary(
   this->simStepPub = this->node.Advertise<private_msgs::SimulationStep>("step");
 
   this->node.Subscribe("step_ack", &NetworkManagerPrimary::OnStepAck, this);
+
+  this->node.Subscribe("step_stats", &NetworkManagerPrimary::OnStepStats,
+      this);
+
+  std::string pipelinedValue;
+  if (common::env("IGN_GAZEBO_NETWORK_PIPELINED", pipelinedValue))
+  {
+    std::transform(pipelinedValue.begin(), pipelinedValue.end(),
+        pipelinedValue.begin(), ::tolower);
+    this->pipelined = pipelinedValue == "1" || pipelinedValue == "true";
+    if (this->pipelined)
+    {
+      ignmsg << "Pipelined lockstep enabled. Secondary state on the primary "
+             << "will lag one step behind." << std::endl;
+    }
+  }
 }
 
 //////////////////////////////////////////////////
 void NetworkManagerPrimary::Handshake()
 {
   auto peers = this->dataPtr->tracker->SecondaryPeers();
+  auto peerInfos = this->dataPtr->tracker->Peers();
   for (const auto &peer : peers)
   {
     private_msgs::PeerControl req, resp;
@@ -91,6 +110,25 @@ void NetworkManagerPrimary::Handshake()
              << timeout << " ms" << std::endl;
     }
 
+    // Secondaries on the same host expose their state through a shared
+    // memory channel, bypassing transport for the step acknowledgement.
+    for (const auto &info : peerInfos)
+    {
+      if (info.id == peer &&
+          info.hostname == this->dataPtr->peerInfo.hostname)
+      {
+        auto channel = ShmStateChannel::Attach(
+            "/ign-gazebo-" + sc->prefix + "-state");
+        if (channel)
+        {
+          ignmsg << "Using shared memory state channel for secondary ["
+                 << sc->prefix << "]" << std::endl;
+          this->stateChannels[sc->prefix] = std::move(channel);
+        }
+        break;
+      }
+    }
+
     this->secondaries[sc->prefix] = std::move(sc);
   }
 }
@@ -137,41 +175,57 @@ bool NetworkManagerPrimary::Step(const UpdateInfo &_info)
     return false;
   }
 
-  // Send step to all secondaries
-  this->secondaryStates.clear();
-  this->simStepPub.Publish(step);
-
-  // Block until all secondaries are done
+  if (this->pipelined)
   {
-    IGN_PROFILE("Waiting for secondaries");
-
-    int sleep = 0;
-    int maxSleep = 10 * 1000 * 1000;
-    for (; sleep < maxSleep &&
-       (this->secondaryStates.size() < this->secondaries.size()); ++sleep)
+    // Pipelined lockstep runs with one step of slack. Collect the
+    // acknowledgements of the previous step first, while no new step is
+    // out, so every ack that arrives afterwards unambiguously belongs
+    // to the step published below.
+    std::vector<msgs::SerializedStateMap> previousStates;
+    if (this->stepInFlight && !this->WaitForSecondaryStates(previousStates))
     {
-      std::this_thread::sleep_for(std::chrono::nanoseconds(1));
+      return false;
     }
 
-    if (sleep == maxSleep)
+    // Publish this step so the secondaries start computing it right
+    // away, then overlap their computation with applying the previous
+    // step's results and running this primary's own systems.
+    this->simStepPub.Publish(step);
+    this->stepInFlight = true;
+
     {
-      ignerr << "Waited 10 s and got only [" << this->secondaryStates.size()
-             << " / " << this->secondaries.size()
-             << "] responses from secondaries. Stopping simulation."
-             << std::endl;
-      this->dataPtr->eventMgr->Emit<events::Stop>();
-      return false;
+      IGN_PROFILE("Updating primary state");
+      for (const auto &msg : previousStates)
+      {
+        this->dataPtr->ecm->SetState(msg);
+      }
     }
+
+    this->dataPtr->stepFunction(_info);
+
+    this->dataPtr->ecm->SetAllComponentsUnchanged();
+
+    return true;
+  }
+
+  // Send step to all secondaries
+  this->secondaryStates.clear();
+  this->simStepPub.Publish(step);
+
+  // Block until all secondaries are done
+  std::vector<msgs::SerializedStateMap> states;
+  if (!this->WaitForSecondaryStates(states))
+  {
+    return false;
   }
 
   // Update primary state with states received from secondaries
   {
     IGN_PROFILE("Updating primary state");
-    for (const auto &msg : this->secondaryStates)
+    for (const auto &msg : states)
     {
       this->dataPtr->ecm->SetState(msg);
     }
-    this->secondaryStates.clear();
   }
 
   // Step all systems
@@ -182,6 +236,57 @@ bool NetworkManagerPrimary::Step(const UpdateInfo &_info)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool NetworkManagerPrimary::WaitForSecondaryStates(
+    std::vector<msgs::SerializedStateMap> &_states)
+{
+  IGN_PROFILE("Waiting for secondaries");
+
+  // Acknowledgements arrive on the step_ack topic, or through a shared
+  // memory channel for co-located secondaries.
+  auto ackCount = [this]()
+  {
+    size_t count = this->secondaryStates.size();
+    for (const auto &[prefix, channel] : this->stateChannels)
+    {
+      if (channel->HasNewData())
+        ++count;
+    }
+    return count;
+  };
+
+  int sleep = 0;
+  int maxSleep = 10 * 1000 * 1000;
+  for (; sleep < maxSleep && (ackCount() < this->secondaries.size()); ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::nanoseconds(1));
+  }
+
+  if (sleep == maxSleep)
+  {
+    ignerr << "Waited 10 s and got only [" << ackCount()
+           << " / " << this->secondaries.size()
+           << "] responses from secondaries. Stopping simulation."
+           << std::endl;
+    this->dataPtr->eventMgr->Emit<events::Stop>();
+    return false;
+  }
+
+  _states = std::move(this->secondaryStates);
+  this->secondaryStates.clear();
+
+  for (auto &[prefix, channel] : this->stateChannels)
+  {
+    msgs::SerializedStateMap stateMsg;
+    if (channel->Read(stateMsg))
+    {
+      _states.push_back(std::move(stateMsg));
+    }
+  }
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 std::string NetworkManagerPrimary::Namespace() const
 {
@@ -195,12 +300,98 @@ std::map<std::string, SecondaryControl::Ptr>
   return this->secondaries;
 }
 
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration NetworkManagerPrimary::StepLeadTime() const
+{
+  return this->dataPtr->tracker->MaxNetworkDelay(
+      NetworkRole::SimulationSecondary);
+}
+
 //////////////////////////////////////////////////
 void NetworkManagerPrimary::OnStepAck(const msgs::SerializedStateMap &_msg)
 {
   this->secondaryStates.push_back(_msg);
 }
 
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::OnStepStats(
+    const private_msgs::SecondaryStepStats &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->loadsMutex);
+  this->secondaryLoads[_msg.prefix()] = _msg.avg_step_ns();
+}
+
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::RebalanceAffinities(
+    private_msgs::SimulationStep &_msg)
+{
+  const uint64_t iterations = _msg.stats().iterations();
+  if (this->secondaries.size() < 2 ||
+      iterations < this->lastRebalanceIteration + this->rebalancePeriod)
+  {
+    return;
+  }
+
+  // Wait until every secondary has reported its timing.
+  std::map<std::string, uint64_t> loads;
+  {
+    std::lock_guard<std::mutex> lock(this->loadsMutex);
+    loads = this->secondaryLoads;
+  }
+  if (loads.size() < this->secondaries.size())
+    return;
+
+  auto slowest = loads.begin();
+  auto fastest = loads.begin();
+  for (auto it = loads.begin(); it != loads.end(); ++it)
+  {
+    if (it->second > slowest->second)
+      slowest = it;
+    if (it->second < fastest->second)
+      fastest = it;
+  }
+
+  // Only migrate when the spread is worth the disruption.
+  if (slowest->second * 2 < fastest->second * 3)
+    return;
+
+  // Performers currently simulated by the slowest secondary. Moving a
+  // lone performer would just move the load, not balance it.
+  std::vector<Entity> candidates;
+  this->dataPtr->ecm->Each<components::PerformerAffinity>(
+    [&](const Entity &_entity,
+        const components::PerformerAffinity *_affinity) -> bool
+    {
+      if (_affinity->Data() == slowest->first)
+      {
+        candidates.push_back(_entity);
+      }
+      return true;
+    });
+  if (candidates.size() < 2)
+    return;
+
+  const Entity performer = candidates.front();
+  this->lastRebalanceIteration = iterations;
+
+  // Ship the performer's current subtree, so the receiving secondary
+  // starts from the state the previous owner last reported.
+  auto parent =
+      this->dataPtr->ecm->Component<components::ParentEntity>(performer);
+  if (nullptr != parent)
+  {
+    std::unordered_set<Entity> entities;
+    auto children = this->dataPtr->ecm->Descendants(parent->Data());
+    entities.insert(children.begin(), children.end());
+    this->dataPtr->ecm->State(*_msg.mutable_state(), entities, {}, true);
+  }
+
+  ignmsg << "Migrating performer [" << performer << "] from secondary ["
+         << slowest->first << "] to [" << fastest->first << "]" << std::endl;
+
+  this->SetAffinity(performer, fastest->first, _msg.add_affinity());
+}
+
 //////////////////////////////////////////////////
 bool NetworkManagerPrimary::SecondariesCanStep() const
 {
@@ -296,6 +487,9 @@ void NetworkManagerPrimary::PopulateAffinities(
   }
 
   // TODO(louise) Process level changes
+
+  // Re-visit the assignment based on measured secondary load.
+  this->RebalanceAffinities(_msg);
 }
 
 //////////////////////////////////////////////////
@@ -18,8 +18,10 @@
 #define IGNITION_GAZEBO_NETWORK_NETWORKMANAGERPRIMARY_HH_
 
 #include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -28,9 +30,11 @@
 #include <ignition/gazebo/Entity.hh>
 #include <ignition/transport/Node.hh>
 
+#include "msgs/secondary_step_stats.pb.h"
 #include "msgs/simulation_step.pb.h"
 
 #include "NetworkManager.hh"
+#include "ignition/gazebo/ShmStateChannel.hh"
 
 namespace ignition
 {
@@ -87,13 +91,40 @@ namespace ignition
       /// peers.
       public: std::map<std::string, SecondaryControl::Ptr>& Secondaries();
 
+      /// \brief Get how far ahead of the nominal pace the step message
+      /// should be published so it reaches the slowest secondary in
+      /// time, based on the network delay estimates from the peer
+      /// tracker's heartbeats.
+      /// \return Largest estimated one-way delay to a secondary, or
+      /// zero until the estimates have settled.
+      public: std::chrono::steady_clock::duration StepLeadTime() const;
+
       /// \brief Callback for step ack messages.
       /// \param[in] _msg Message containing secondary's updated state.
       private: void OnStepAck(const msgs::SerializedStateMap &_msg);
 
+      /// \brief Block until every secondary has acknowledged the step in
+      /// flight, then take their states.
+      /// \param[out] _states Filled with one state message per secondary.
+      /// \return False if the wait timed out, in which case simulation is
+      /// stopped.
+      private: bool WaitForSecondaryStates(
+          std::vector<msgs::SerializedStateMap> &_states);
+
       /// \brief Check if the step publisher has connections.
       private: bool SecondariesCanStep() const;
 
+      /// \brief Callback for step timing reported by secondaries.
+      /// \param[in] _msg Timing from one secondary.
+      private: void OnStepStats(const private_msgs::SecondaryStepStats &_msg);
+
+      /// \brief Move a performer from the slowest secondary to the fastest
+      /// one when their measured step durations have drifted apart, so no
+      /// single secondary gates the lockstep.
+      /// \param[in] _msg Step message, filled with the new affinity and the
+      /// migrated performer's state.
+      private: void RebalanceAffinities(private_msgs::SimulationStep &_msg);
+
       /// \brief Populate the step message with the latest affinities according
       /// to levels.
       /// \param[in] _msg Step message.
@@ -117,6 +148,41 @@ namespace ignition
 
       /// \brief Keep track of states received from secondaries.
       private: std::vector<msgs::SerializedStateMap> secondaryStates;
+
+      /// \brief Shared memory state channels, keyed by secondary prefix.
+      /// Only populated for secondaries running on the same host as the
+      /// primary; their step acknowledgements arrive through the channel
+      /// instead of the step_ack topic.
+      private: std::map<std::string,
+          std::unique_ptr<ShmStateChannel>> stateChannels;
+
+      /// \brief True when pipelined lockstep is enabled through the
+      /// IGN_GAZEBO_NETWORK_PIPELINED environment variable. The step
+      /// message for iteration N is then published before the
+      /// acknowledgements of iteration N-1 are applied, so secondaries
+      /// compute step N while the primary aggregates step N-1. The
+      /// secondary state the primary sees lags one step behind, which is
+      /// acceptable when performer interactions across secondaries are
+      /// rare.
+      private: bool pipelined{false};
+
+      /// \brief Whether a step has been published whose acknowledgements
+      /// have not been collected yet. Only used in pipelined mode.
+      private: bool stepInFlight{false};
+
+      /// \brief Latest smoothed step duration in nanoseconds reported by
+      /// each secondary, keyed by prefix.
+      private: std::map<std::string, uint64_t> secondaryLoads;
+
+      /// \brief Guards secondaryLoads, written from the transport callback.
+      private: mutable std::mutex loadsMutex;
+
+      /// \brief Iteration at which the last performer migration happened.
+      private: uint64_t lastRebalanceIteration{0};
+
+      /// \brief Minimum number of iterations between performer migrations,
+      /// giving the load measurements time to settle after a migration.
+      private: uint64_t rebalancePeriod{1000};
     };
     }
   }  // namespace gazebo
@@ -16,6 +16,7 @@
 */
 
 #include <algorithm>
+#include <chrono>
 #include <string>
 
 #include <ignition/common/Console.hh>
@@ -62,6 +63,15 @@ NetworkManagerSecondary::NetworkManagerSecondary(
   this->node.Subscribe("step", &NetworkManagerSecondary::OnStep, this);
 
   this->stepAckPub = this->node.Advertise<msgs::SerializedStateMap>("step_ack");
+
+  this->stepStatsPub =
+      this->node.Advertise<private_msgs::SecondaryStepStats>("step_stats");
+
+  // Offer a shared memory channel for the step acknowledgements. It is
+  // only used if the primary runs on the same host and attaches to it
+  // during handshake; otherwise acknowledgements go through transport.
+  this->stateChannel = ShmStateChannel::Create(
+      "/ign-gazebo-" + this->Namespace() + "-state");
 }
 
 //////////////////////////////////////////////////
@@ -110,6 +120,7 @@ void NetworkManagerSecondary::OnStep(
   }
 
   // Update affinities
+  bool gainedPerformer{false};
   for (int i = 0; i < _msg.affinity_size(); ++i)
   {
     const auto &affinityMsg = _msg.affinity(i);
@@ -118,6 +129,7 @@ void NetworkManagerSecondary::OnStep(
     if (affinityMsg.secondary_prefix() == this->Namespace())
     {
       this->performers.insert(entityId);
+      gainedPerformer = true;
 
       ignmsg << "Secondary [" << this->Namespace()
              << "] assigned affinity to performer [" << entityId << "]."
@@ -126,9 +138,14 @@ void NetworkManagerSecondary::OnStep(
     // If performer has been assigned to another secondary, remove it
     else
     {
+      // The model may already be gone if the performer was migrated away
+      // from this secondary earlier.
       auto parent =
           this->dataPtr->ecm->Component<components::ParentEntity>(entityId);
-      this->dataPtr->ecm->RequestRemoveEntity(parent->Data());
+      if (nullptr != parent)
+      {
+        this->dataPtr->ecm->RequestRemoveEntity(parent->Data());
+      }
 
       if (this->performers.find(entityId) != this->performers.end())
       {
@@ -140,10 +157,19 @@ void NetworkManagerSecondary::OnStep(
     }
   }
 
+  // A migrated performer arrives with the state its previous owner last
+  // reported; apply it before stepping so this secondary takes over from
+  // there.
+  if (gainedPerformer && _msg.has_state())
+  {
+    this->dataPtr->ecm->SetState(_msg.state());
+  }
+
   // Update info
   auto info = convert<UpdateInfo>(_msg.stats());
 
   // Step runner
+  const auto stepStart = std::chrono::steady_clock::now();
   this->dataPtr->stepFunction(info);
 
   // Update state with all the performer's entities
@@ -166,9 +192,42 @@ void NetworkManagerSecondary::OnStep(
 
   msgs::SerializedStateMap stateMsg;
   if (!entities.empty())
-    this->dataPtr->ecm->State(stateMsg, entities);
+  {
+    // The acknowledgement normally carries only the components that
+    // changed since the previous step: State skips unchanged components
+    // through the ECM change tracking, and the components are marked
+    // unchanged again below once the delta has been built. A periodic
+    // keyframe sends the performers' full state instead, so the primary
+    // can recover from a delta that was lost or applied out of order.
+    const bool keyframe = this->stateKeyframePeriod > 0 &&
+        _msg.stats().iterations() % this->stateKeyframePeriod == 0;
+    this->dataPtr->ecm->State(stateMsg, entities, {}, keyframe);
+  }
 
-  this->stepAckPub.Publish(stateMsg);
+  // Exponential moving average of the step duration, so a single slow
+  // step doesn't trigger a migration.
+  const uint64_t stepNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - stepStart).count();
+  this->avgStepNs =
+      0 == this->avgStepNs ? stepNs : (this->avgStepNs * 7 + stepNs) / 8;
+
+  // A co-located primary consumes the acknowledgement through shared
+  // memory; it is serialized directly into the mapped region and never
+  // goes through transport. Fall back to the step_ack topic otherwise,
+  // or if the state outgrew the channel capacity.
+  if (nullptr == this->stateChannel || !this->stateChannel->ReaderAttached() ||
+      !this->stateChannel->Write(stateMsg))
+  {
+    this->stepAckPub.Publish(stateMsg);
+  }
+
+  if (_msg.stats().iterations() % 100 == 0)
+  {
+    private_msgs::SecondaryStepStats statsMsg;
+    statsMsg.set_prefix(this->Namespace());
+    statsMsg.set_avg_step_ns(this->avgStepNs);
+    this->stepStatsPub.Publish(statsMsg);
+  }
 
   this->dataPtr->ecm->SetAllComponentsUnchanged();
 }
@@ -26,10 +26,12 @@
 #include <ignition/gazebo/Export.hh>
 #include <ignition/transport/Node.hh>
 
+#include "msgs/secondary_step_stats.pb.h"
 #include "msgs/simulation_step.pb.h"
 #include "msgs/peer_control.pb.h"
 
 #include "NetworkManager.hh"
+#include "ignition/gazebo/ShmStateChannel.hh"
 
 namespace ignition
 {
@@ -79,8 +81,29 @@ namespace ignition
       /// \brief Publish step acknowledgement messages.
       private: ignition::transport::Node::Publisher stepAckPub;
 
+      /// \brief Publish periodic step timing, used by the primary to
+      /// balance performers across secondaries.
+      private: ignition::transport::Node::Publisher stepStatsPub;
+
+      /// \brief Smoothed duration of one simulation step in nanoseconds.
+      private: uint64_t avgStepNs{0};
+
       /// \brief Collection of performers associated with this secondary.
       private: std::unordered_set<Entity> performers;
+
+      /// \brief Shared memory channel carrying step acknowledgements to a
+      /// primary running on the same host. The primary attaches to it
+      /// during handshake if the hosts match; until then acknowledgements
+      /// go through the step_ack topic.
+      private: std::unique_ptr<ShmStateChannel> stateChannel;
+
+      /// \brief Number of steps between full state keyframes. Step
+      /// acknowledgements normally carry only the components that
+      /// changed since the previous step; every this many iterations the
+      /// performers' full state is sent instead, so the primary can
+      /// recover from a lost or partially applied delta. Zero disables
+      /// keyframes.
+      private: uint64_t stateKeyframePeriod{1000};
     };
     }
   }  // namespace gazebo
@@ -16,6 +16,9 @@
 */
 #include "PeerTracker.hh"
 
+#include <algorithm>
+#include <random>
+
 using namespace ignition;
 using namespace gazebo;
 
@@ -93,17 +96,16 @@ size_t PeerTracker::StaleMultiplier() const
 /////////////////////////////////////////////////
 size_t PeerTracker::NumPeers() const
 {
-  auto lock = PeerLock(this->peersMutex);
-  return this->peers.size();
+  return std::atomic_load(&this->peers)->size();
 }
 
 /////////////////////////////////////////////////
 size_t PeerTracker::NumPeers(const NetworkRole &_role) const
 {
-  auto lock = PeerLock(this->peersMutex);
+  auto snapshot = std::atomic_load(&this->peers);
 
   size_t count = 0;
-  for (auto peer : peers)
+  for (const auto &peer : *snapshot)
   {
     if (peer.second.info.role == _role)
     {
@@ -113,19 +115,82 @@ size_t PeerTracker::NumPeers(const NetworkRole &_role) const
   return count;
 }
 
+/////////////////////////////////////////////////
+PeerTracker::Duration PeerTracker::ClockOffset(const std::string &_id) const
+{
+  auto snapshot = std::atomic_load(&this->peers);
+  auto iter = snapshot->find(_id);
+  if (iter == snapshot->end() || !iter->second.hasClockEstimate)
+    return Duration::zero();
+  return std::chrono::duration_cast<Duration>(iter->second.clockOffset);
+}
+
+/////////////////////////////////////////////////
+PeerTracker::Duration PeerTracker::NetworkDelay(const std::string &_id) const
+{
+  auto snapshot = std::atomic_load(&this->peers);
+  auto iter = snapshot->find(_id);
+  if (iter == snapshot->end() || !iter->second.hasClockEstimate)
+    return Duration::zero();
+  return std::chrono::duration_cast<Duration>(iter->second.networkDelay);
+}
+
+/////////////////////////////////////////////////
+PeerTracker::Duration PeerTracker::MaxNetworkDelay(
+    const NetworkRole &_role) const
+{
+  auto snapshot = std::atomic_load(&this->peers);
+
+  std::chrono::nanoseconds maxDelay{0};
+  for (const auto &peer : *snapshot)
+  {
+    if (peer.second.info.role == _role && peer.second.hasClockEstimate)
+    {
+      maxDelay = std::max(maxDelay, peer.second.networkDelay);
+    }
+  }
+  return std::chrono::duration_cast<Duration>(maxDelay);
+}
+
 /////////////////////////////////////////////////
 void PeerTracker::HeartbeatLoop()
 {
   using Clock = std::chrono::steady_clock;
   Clock::time_point lastUpdateTime;
 
+  // Jitter the heartbeat period so peers that started together don't
+  // stay in phase and flood discovery in bursts.
+  std::mt19937 jitterRng(std::random_device{}());
+
   while (this->heartbeatRunning)
   {
     lastUpdateTime = Clock::now();
-    this->heartbeatPub.Publish(toProto(this->info));
+
+    auto snapshot = std::atomic_load(&this->peers);
+
+    // Stamp the heartbeat and echo the latest timing observation of
+    // every known peer, so each peer can pair its own measurement of
+    // our heartbeats with our measurement of theirs and estimate the
+    // clock offset and network delay. See OnPeerHeartbeat.
+    auto msg = toProto(this->info);
+    const auto stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        lastUpdateTime.time_since_epoch());
+    msg.mutable_header()->mutable_stamp()->set_sec(
+        stamp.count() / 1000000000);
+    msg.mutable_header()->mutable_stamp()->set_nsec(
+        stamp.count() % 1000000000);
+    for (const auto &peer : *snapshot)
+    {
+      if (!peer.second.hasDelta)
+        continue;
+      auto *sample = msg.add_clock_samples();
+      sample->set_peer_id(peer.first);
+      sample->set_delta_ns(peer.second.lastDelta.count());
+    }
+    this->heartbeatPub.Publish(msg);
 
     std::vector<PeerInfo> toRemove;
-    for (auto peer : this->peers)
+    for (const auto &peer : *snapshot)
     {
       auto age = Clock::now() - peer.second.lastSeen;
       if (age > (this->staleMultiplier * this->heartbeatPeriod))
@@ -141,9 +206,14 @@ void PeerTracker::HeartbeatLoop()
     }
 
     // Compute sleep time to keep update loop as close to
-    // heartbeatPeriod as possible.
+    // heartbeatPeriod as possible, plus up to +/-10% of jitter.
+    const auto periodNs = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(this->heartbeatPeriod).count();
+    std::uniform_int_distribution<int64_t> jitterDist(
+        -periodNs / 10, periodNs / 10);
     auto sleepTime = std::max(std::chrono::nanoseconds(0),
-          lastUpdateTime + this->heartbeatPeriod - Clock::now());
+          lastUpdateTime + this->heartbeatPeriod +
+          std::chrono::nanoseconds(jitterDist(jitterRng)) - Clock::now());
 
     if (sleepTime > std::chrono::nanoseconds(0))
     {
@@ -155,17 +225,20 @@ void PeerTracker::HeartbeatLoop()
 /////////////////////////////////////////////////
 bool PeerTracker::RemovePeer(const PeerInfo &_info)
 {
-  auto lock = PeerLock(this->peersMutex);
+  std::lock_guard<std::mutex> lock(this->writeMutex);
 
-  auto iter = this->peers.find(_info.id);
-  if (iter == this->peers.end())
+  auto updated = std::make_shared<PeerMap>(*std::atomic_load(&this->peers));
+  auto iter = updated->find(_info.id);
+  if (iter == updated->end())
   {
     igndbg << "Attempting to remove peer [" << _info.id << "] from ["
            << this->info.id << "] but it wasn't connected" << std::endl;
     return false;
   }
 
-  this->peers.erase(iter);
+  updated->erase(iter);
+  std::atomic_store(&this->peers,
+      std::shared_ptr<const PeerMap>(std::move(updated)));
   return true;
 }
 
@@ -202,31 +275,94 @@ void PeerTracker::OnPeerHeartbeat(const private_msgs::PeerInfo &_info)
     return;
   }
 
-  auto lock = PeerLock(this->peersMutex);
-
-  // If it doesn't exist, we may have missed a peer announce,
-  // so add it here on the heartbeat.
-  if (this->peers.find(peer.id) == this->peers.end())
+  bool added{false};
   {
-    this->OnPeerAdded(peer);
+    std::lock_guard<std::mutex> lock(this->writeMutex);
+
+    auto updated = std::make_shared<PeerMap>(*std::atomic_load(&this->peers));
+
+    // If it doesn't exist, we may have missed a peer announce,
+    // so add it here on the heartbeat.
+    added = updated->find(peer.id) == updated->end();
+
+    // Update information about the state of this peer.
+    auto &peerState = (*updated)[peer.id];
+    if (added)
+    {
+      peerState.info = peer;
+    }
+    peerState.lastSeen = std::chrono::steady_clock::now();
+    peerState.lastHeader = std::chrono::steady_clock::time_point(
+        std::chrono::seconds(_info.header().stamp().sec()) +
+        std::chrono::nanoseconds(_info.header().stamp().nsec()));
+
+    // Record how late the heartbeat arrived relative to its stamp.
+    // This mixes the sender's clock and ours, so it is only echoed
+    // back to the sender; the estimation below uses the pair.
+    if (_info.header().stamp().sec() != 0 ||
+        _info.header().stamp().nsec() != 0)
+    {
+      peerState.lastDelta =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              peerState.lastSeen - peerState.lastHeader);
+      peerState.hasDelta = true;
+    }
+
+    // PTP-style estimation: with the peer's clock ahead of ours by the
+    // offset and a symmetric one-way delay, ourDelta is delay minus
+    // offset and the peer's mirrored observation of us (theirDelta) is
+    // delay plus offset. Half the difference is the offset and half
+    // the sum is the delay. Smooth both with an exponential average so
+    // heartbeat jitter doesn't whip the estimates around.
+    for (const auto &sample : _info.clock_samples())
+    {
+      if (sample.peer_id() != this->info.id || !peerState.hasDelta)
+        continue;
+
+      const std::chrono::nanoseconds ourDelta = peerState.lastDelta;
+      const std::chrono::nanoseconds theirDelta{sample.delta_ns()};
+      const auto offset = (theirDelta - ourDelta) / 2;
+      const auto delay = std::max(std::chrono::nanoseconds(0),
+          (ourDelta + theirDelta) / 2);
+
+      if (!peerState.hasClockEstimate)
+      {
+        peerState.clockOffset = offset;
+        peerState.networkDelay = delay;
+        peerState.hasClockEstimate = true;
+      }
+      else
+      {
+        peerState.clockOffset = (peerState.clockOffset * 7 + offset) / 8;
+        peerState.networkDelay = (peerState.networkDelay * 7 + delay) / 8;
+      }
+      break;
+    }
+
+    std::atomic_store(&this->peers,
+        std::shared_ptr<const PeerMap>(std::move(updated)));
   }
 
-  // Update information about the state of this peer.
-  auto &peerState = this->peers[peer.id];
-  peerState.lastSeen = std::chrono::steady_clock::now();
-  peerState.lastHeader = std::chrono::steady_clock::time_point(
-      std::chrono::seconds(_info.header().stamp().sec()) +
-      std::chrono::nanoseconds(_info.header().stamp().nsec()));
+  // Emit event for any consumers, outside the write lock.
+  if (added && eventMgr)
+    eventMgr->Emit<PeerAdded>(peer);
 }
 
 /////////////////////////////////////////////////
 void PeerTracker::OnPeerAdded(const PeerInfo &_info)
 {
-  auto lock = PeerLock(this->peersMutex);
-  auto peerState = PeerState();
-  peerState.info = _info;
-  peerState.lastSeen = std::chrono::steady_clock::now();
-  this->peers[_info.id] = peerState;
+  {
+    std::lock_guard<std::mutex> lock(this->writeMutex);
+
+    auto updated = std::make_shared<PeerMap>(*std::atomic_load(&this->peers));
+    auto peerState = PeerState();
+    peerState.info = _info;
+    peerState.lastSeen = std::chrono::steady_clock::now();
+    (*updated)[_info.id] = peerState;
+
+    std::atomic_store(&this->peers,
+        std::shared_ptr<const PeerMap>(std::move(updated)));
+  }
 
   // Emit event for any consumers
   if (eventMgr)
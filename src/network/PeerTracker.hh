@@ -19,6 +19,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -99,6 +100,34 @@ namespace ignition
       /// \return Number of hearbeats before a peer is marked stale.
       public: size_t StaleMultiplier() const;
 
+      /// \brief Get the estimated clock offset of a peer relative to
+      /// this peer, built from paired heartbeat timing observations in
+      /// the style of PTP: each side measures the arrival delay of the
+      /// other's stamped heartbeats, echoes its measurement back, and
+      /// half the difference of the pair is the offset. The estimate is
+      /// smoothed over many heartbeats.
+      /// \param[in] _id ID of the peer.
+      /// \return Estimated offset, positive when the peer's clock is
+      /// ahead of this peer's. Zero until enough heartbeats have been
+      /// exchanged.
+      public: Duration ClockOffset(const std::string &_id) const;
+
+      /// \brief Get the estimated one-way network delay to a peer,
+      /// built from the same paired heartbeat observations as
+      /// ClockOffset: half the sum of the pair is the delay.
+      /// \param[in] _id ID of the peer.
+      /// \return Estimated one-way delay, or zero until enough
+      /// heartbeats have been exchanged.
+      public: Duration NetworkDelay(const std::string &_id) const;
+
+      /// \brief Get the largest estimated one-way network delay among
+      /// the peers with the given role, e.g. to pace step publications
+      /// ahead of the slowest secondary.
+      /// \param[in] _role Role of peers to consider.
+      /// \return Largest estimated delay, or zero if no peer with the
+      /// role has an estimate yet.
+      public: Duration MaxNetworkDelay(const NetworkRole &_role) const;
+
       /// \brief Retrieve total number of detected peers in the network.
       public: size_t NumPeers() const;
 
@@ -129,13 +158,26 @@ namespace ignition
       public: std::vector<std::string> SecondaryPeers() const
               {
                 std::vector<std::string> ret;
-                for (const auto& it : this->peers)
+                auto snapshot = std::atomic_load(&this->peers);
+                for (const auto& it : *snapshot)
                 {
                   ret.push_back(it.first);
                 }
                 return ret;
               }
 
+      /// \brief Retrieve a copy of the information of all discovered peers.
+      public: std::vector<PeerInfo> Peers() const
+              {
+                std::vector<PeerInfo> ret;
+                auto snapshot = std::atomic_load(&this->peers);
+                for (const auto &it : *snapshot)
+                {
+                  ret.push_back(it.second.info);
+                }
+                return ret;
+              }
+
       /// \brief Internal loop to announce and check stale peers.
       private: void HeartbeatLoop();
 
@@ -175,20 +217,43 @@ namespace ignition
 
         /// \brief Keep last time heartbeat was received
         std::chrono::steady_clock::time_point lastSeen;
-      };
 
-      /// \brief Convenience type alias
-      private: using PeerMutex = std::recursive_mutex;
+        /// \brief Last observed arrival-minus-stamp delta of this
+        /// peer's heartbeats. Mixes the two peers' clocks, so it is
+        /// echoed back to the peer rather than used directly.
+        std::chrono::nanoseconds lastDelta{0};
+
+        /// \brief True once lastDelta holds an observation.
+        bool hasDelta{false};
+
+        /// \brief Smoothed clock offset estimate. See
+        /// PeerTracker::ClockOffset.
+        std::chrono::nanoseconds clockOffset{0};
+
+        /// \brief Smoothed one-way network delay estimate. See
+        /// PeerTracker::NetworkDelay.
+        std::chrono::nanoseconds networkDelay{0};
+
+        /// \brief True once a paired observation has seeded the offset
+        /// and delay estimates.
+        bool hasClockEstimate{false};
+      };
 
       /// \brief Convenience type alias
-      private: using PeerLock = std::lock_guard<PeerMutex>;
+      private: using PeerMap = std::map<std::string, PeerState>;
 
-      /// \brief Used for guarding map of peers.
-      /// N.b. marked mutable to allow const in places that are read only.
-      private: mutable PeerMutex peersMutex;
+      /// \brief Serializes writers of the peer map. Readers don't take it.
+      private: std::mutex writeMutex;
 
-      /// \brief Information about discovered peers
-      private: std::map<std::string, PeerState> peers;
+      /// \brief Information about discovered peers.
+      ///
+      /// The map is read-mostly: readers atomically load the current
+      /// snapshot and never block, while writers copy the map, modify the
+      /// copy under writeMutex and atomically publish it. This keeps the
+      /// Step paths, which query peers every iteration, from contending
+      /// with discovery and heartbeat traffic.
+      private: std::shared_ptr<const PeerMap> peers
+                   {std::make_shared<PeerMap>()};
 
       /// \brief Thread for executing heartbeat loop
       private: std::thread heartbeatThread;
@@ -171,6 +171,47 @@ TEST(PeerTracker, PeerTrackerStale)
   // received from stale peer
 }
 
+//////////////////////////////////////////////////
+TEST(PeerTracker, ClockEstimation)
+{
+  ignition::common::Console::SetVerbosity(4);
+  EventManager eventMgr;
+
+  auto info1 = PeerInfo(NetworkRole::SimulationPrimary);
+  auto tracker1 = std::make_shared<PeerTracker>(info1, &eventMgr);
+  tracker1->SetHeartbeatPeriod(std::chrono::milliseconds(20));
+
+  auto info2 = PeerInfo(NetworkRole::SimulationSecondary);
+  auto tracker2 = std::make_shared<PeerTracker>(info2, &eventMgr);
+  tracker2->SetHeartbeatPeriod(std::chrono::milliseconds(20));
+
+  // Wait for discovery plus a few heartbeat rounds, so the echoed
+  // timing observations have been paired on both sides.
+  for (int sleep = 0; sleep < 50 &&
+      (tracker1->NumPeers() == 0 || tracker2->NumPeers() == 0);
+      ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  // Both trackers run on the same clock, so the estimated offset must
+  // be small and the one-way delay non-negative and small.
+  auto offset = tracker1->ClockOffset(info2.id);
+  auto delay = tracker1->NetworkDelay(info2.id);
+  EXPECT_LT(std::chrono::abs(offset), std::chrono::milliseconds(100));
+  EXPECT_GE(delay, std::chrono::steady_clock::duration::zero());
+  EXPECT_LT(delay, std::chrono::milliseconds(100));
+
+  // The only secondary bounds the role-wide maximum.
+  EXPECT_EQ(delay,
+      tracker1->MaxNetworkDelay(NetworkRole::SimulationSecondary));
+
+  // Unknown peers have no estimate.
+  EXPECT_EQ(std::chrono::steady_clock::duration::zero(),
+      tracker1->ClockOffset("unknown"));
+}
+
 //////////////////////////////////////////////////
 TEST(PeerTracker, Partitioned)
 {
@@ -15,11 +15,16 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <map>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <ignition/msgs.hh>
 #include <ignition/transport/Node.hh>
@@ -27,15 +32,35 @@
 #include "ignition/gazebo/Events.hh"
 #include "ignition/gazebo/Conversions.hh"
 #include "ignition/common/Console.hh"
+#include "ignition/common/Util.hh"
 #include "ignition/rendering/Marker.hh"
 #include "ignition/rendering/RenderingIface.hh"
 #include "ignition/rendering/Scene.hh"
+#include "ignition/rendering/Sensor.hh"
 
 #include "ignition/gazebo/rendering/MarkerManager.hh"
 
 using namespace ignition;
 using namespace gazebo;
 
+namespace ignition
+{
+namespace gazebo
+{
+/// \brief A coarse spatial hash cell holding marker visuals. Visibility is
+/// toggled for a whole cell at a time, so culling cost is proportional to
+/// the number of occupied cells rather than the number of markers.
+class MarkerCell
+{
+  /// \brief Visuals whose marker position falls inside this cell.
+  public: std::vector<rendering::VisualPtr> visuals;
+
+  /// \brief Last visibility state applied to the visuals in this cell.
+  public: bool visible = true;
+};
+}
+}
+
 /// Private data for the MarkerManager class
 class ignition::gazebo::MarkerManagerPrivate
 {
@@ -85,6 +110,51 @@ class ignition::gazebo::MarkerManagerPrivate
   /// \param[in] _time The time data.
   public: void SetSimTime(const std::chrono::steady_clock::duration &_time);
 
+  /// \brief Compute the spatial hash key for a position.
+  /// \param[in] _pos Position in world coordinates.
+  /// \return Key of the cell containing the position.
+  public: uint64_t CellKey(const math::Vector3d &_pos) const;
+
+  /// \brief Compute the center of a spatial hash cell.
+  /// \param[in] _key Key of the cell.
+  /// \return Center of the cell in world coordinates.
+  public: math::Vector3d CellCenter(uint64_t _key) const;
+
+  /// \brief Insert a marker visual into the cell containing its position,
+  /// moving it out of its previous cell if it has one.
+  /// \param[in] _ns Marker namespace.
+  /// \param[in] _id Marker id within the namespace.
+  /// \param[in] _visual The marker's visual.
+  public: void UpdateCell(const std::string &_ns, uint64_t _id,
+                          const rendering::VisualPtr &_visual);
+
+  /// \brief Remove a marker visual from the spatial hash.
+  /// \param[in] _ns Marker namespace.
+  /// \param[in] _id Marker id within the namespace.
+  /// \param[in] _visual The marker's visual.
+  public: void RemoveFromCell(const std::string &_ns, uint64_t _id,
+                              const rendering::VisualPtr &_visual);
+
+  /// \brief Hide spatial hash cells that no sensor in the scene is close
+  /// enough to see, and show cells that came back into range. No-op when
+  /// culling is disabled.
+  public: void UpdateCulling();
+
+  /// \brief Distance beyond which markers are hidden. Zero or less
+  /// disables culling.
+  public: double cullDistance = 0.0;
+
+  /// \brief Edge length of a spatial hash cell, derived from the cull
+  /// distance.
+  public: double cellSize = 1.0;
+
+  /// \brief Coarse spatial hash from cell key to the markers in the cell.
+  public: std::unordered_map<uint64_t, MarkerCell> cells;
+
+  /// \brief Cell key of each marker, indexed by namespace and id. Used to
+  /// move markers between cells when they are modified or deleted.
+  public: std::map<std::string, std::map<uint64_t, uint64_t>> markerCells;
+
   /// \brief Previous sim time received
   public: std::chrono::steady_clock::duration lastSimTime;
 
@@ -141,6 +211,31 @@ void MarkerManager::Update()
   return this->dataPtr->Update();
 }
 
+/////////////////////////////////////////////////
+void MarkerManager::SetCullDistance(double _distance)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->cullDistance = _distance;
+
+  // Size the cells so that a handful of them cover the visible range. A
+  // lower bound keeps the hash from degenerating into one cell per marker
+  // for small distances.
+  this->dataPtr->cellSize = std::max(1.0, _distance * 0.25);
+
+  // Existing markers were hashed with the previous cell size, so rebuild
+  // the hash and restore visibility; the next Update re-culls.
+  this->dataPtr->cells.clear();
+  this->dataPtr->markerCells.clear();
+  for (const auto &ns : this->dataPtr->visuals)
+  {
+    for (const auto &iter : ns.second)
+    {
+      iter.second->SetVisible(true);
+      this->dataPtr->UpdateCell(ns.first, iter.first, iter.second);
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 bool MarkerManager::Init(const ignition::rendering::ScenePtr &_scene)
 {
@@ -152,6 +247,22 @@ bool MarkerManager::Init(const ignition::rendering::ScenePtr &_scene)
 
   this->dataPtr->scene = _scene;
 
+  // Culling is opt-in, so debug-heavy deployments can enable it without
+  // code changes.
+  std::string cullDistanceStr;
+  if (common::env("IGN_GAZEBO_MARKER_CULL_DISTANCE", cullDistanceStr))
+  {
+    try
+    {
+      this->SetCullDistance(std::stod(cullDistanceStr));
+    }
+    catch (const std::exception &)
+    {
+      ignerr << "Invalid IGN_GAZEBO_MARKER_CULL_DISTANCE value["
+             << cullDistanceStr << "]\n";
+    }
+  }
+
   if (this->dataPtr->topicName.empty())
   {
     ignerr << "Unable to advertise marker service. Topic name empty.\n";
@@ -223,6 +334,7 @@ void MarkerManagerPrivate::Update()
             (markerPtr->Lifetime() <= simTime ||
             this->simTime < this->lastSimTime))
         {
+          this->RemoveFromCell(mit->first, it->first, it->second);
           this->scene->DestroyVisual(it->second);
           it = mit->second.erase(it);
           break;
@@ -237,6 +349,8 @@ void MarkerManagerPrivate::Update()
       ++mit;
   }
   this->lastSimTime = this->simTime;
+
+  this->UpdateCulling();
 }
 
 /////////////////////////////////////////////////
@@ -247,6 +361,135 @@ void MarkerManagerPrivate::SetSimTime(
   this->simTime = _time;
 }
 
+/////////////////////////////////////////////////
+uint64_t MarkerManagerPrivate::CellKey(const math::Vector3d &_pos) const
+{
+  // Pack the integer cell coordinates into 21 bits per axis, offset so
+  // that negative coordinates pack cleanly.
+  const uint64_t mask = 0x1FFFFF;
+  const int64_t offset = 0x100000;
+  uint64_t x = static_cast<uint64_t>(static_cast<int64_t>(
+      std::floor(_pos.X() / this->cellSize)) + offset) & mask;
+  uint64_t y = static_cast<uint64_t>(static_cast<int64_t>(
+      std::floor(_pos.Y() / this->cellSize)) + offset) & mask;
+  uint64_t z = static_cast<uint64_t>(static_cast<int64_t>(
+      std::floor(_pos.Z() / this->cellSize)) + offset) & mask;
+  return x | (y << 21) | (z << 42);
+}
+
+/////////////////////////////////////////////////
+math::Vector3d MarkerManagerPrivate::CellCenter(uint64_t _key) const
+{
+  const uint64_t mask = 0x1FFFFF;
+  const int64_t offset = 0x100000;
+  int64_t x = static_cast<int64_t>(_key & mask) - offset;
+  int64_t y = static_cast<int64_t>((_key >> 21) & mask) - offset;
+  int64_t z = static_cast<int64_t>((_key >> 42) & mask) - offset;
+  return math::Vector3d((x + 0.5) * this->cellSize,
+                        (y + 0.5) * this->cellSize,
+                        (z + 0.5) * this->cellSize);
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::UpdateCell(const std::string &_ns, uint64_t _id,
+    const rendering::VisualPtr &_visual)
+{
+  uint64_t key = this->CellKey(_visual->WorldPosition());
+
+  auto &nsCells = this->markerCells[_ns];
+  auto keyIter = nsCells.find(_id);
+  if (keyIter != nsCells.end())
+  {
+    // The marker stayed in its cell; nothing to do.
+    if (keyIter->second == key)
+      return;
+
+    this->RemoveFromCell(_ns, _id, _visual);
+  }
+
+  auto &cell = this->cells[key];
+  cell.visuals.push_back(_visual);
+  this->markerCells[_ns][_id] = key;
+
+  // Match the cell's current visibility; the next culling pass corrects
+  // it if the view has moved.
+  _visual->SetVisible(cell.visible);
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::RemoveFromCell(const std::string &_ns,
+    uint64_t _id, const rendering::VisualPtr &_visual)
+{
+  auto nsIter = this->markerCells.find(_ns);
+  if (nsIter == this->markerCells.end())
+    return;
+
+  auto keyIter = nsIter->second.find(_id);
+  if (keyIter == nsIter->second.end())
+    return;
+
+  auto cellIter = this->cells.find(keyIter->second);
+  if (cellIter != this->cells.end())
+  {
+    auto &cellVisuals = cellIter->second.visuals;
+    cellVisuals.erase(std::remove(cellVisuals.begin(), cellVisuals.end(),
+        _visual), cellVisuals.end());
+    if (cellVisuals.empty())
+      this->cells.erase(cellIter);
+  }
+
+  nsIter->second.erase(keyIter);
+  if (nsIter->second.empty())
+    this->markerCells.erase(nsIter);
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::UpdateCulling()
+{
+  if (this->cullDistance <= 0.0 || this->cells.empty())
+    return;
+
+  // A marker is visible as long as any sensor in the scene is within
+  // range of its cell, so the per-sensor sets are folded into one
+  // union visibility state.
+  std::vector<math::Vector3d> viewPositions;
+  for (unsigned int i = 0; i < this->scene->SensorCount(); ++i)
+  {
+    auto sensor = this->scene->SensorByIndex(i);
+    if (sensor)
+      viewPositions.push_back(sensor->WorldPosition());
+  }
+  if (viewPositions.empty())
+    return;
+
+  // Cells are tested against their center, padded by the cell's bounding
+  // radius so markers near a cell edge are never culled early.
+  const double pad = 0.5 * std::sqrt(3.0) * this->cellSize;
+  const double rangeSq = std::pow(this->cullDistance + pad, 2);
+
+  for (auto &cell : this->cells)
+  {
+    math::Vector3d center = this->CellCenter(cell.first);
+
+    bool visible = false;
+    for (const auto &viewPos : viewPositions)
+    {
+      if ((center - viewPos).SquaredLength() <= rangeSq)
+      {
+        visible = true;
+        break;
+      }
+    }
+
+    if (visible == cell.second.visible)
+      continue;
+
+    cell.second.visible = visible;
+    for (const auto &visual : cell.second.visuals)
+      visual->SetVisible(visible);
+  }
+}
+
 /////////////////////////////////////////////////
 void MarkerManagerPrivate::SetVisual(const ignition::msgs::Marker &_msg,
                            const rendering::VisualPtr &_visualPtr)
@@ -473,6 +716,9 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
         this->SetMarker(_msg, markerPtr);
 
         visualIter->second->AddGeometry(markerPtr);
+
+        // The modification may have moved the marker to another cell
+        this->UpdateCell(ns, id, visualIter->second);
       }
     }
     // Otherwise create a new marker
@@ -502,6 +748,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
 
       // Store the visual
       this->visuals[ns][id] = visualPtr;
+      this->UpdateCell(ns, id, visualPtr);
     }
   }
   // Remove a single marker
@@ -511,6 +758,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
     if (nsIter != this->visuals.end() &&
         visualIter != nsIter->second.end())
     {
+      this->RemoveFromCell(ns, id, visualIter->second);
       this->scene->DestroyVisual(visualIter->second);
       this->visuals[ns].erase(visualIter);
 
@@ -540,6 +788,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
     {
       for (auto it : nsIter->second)
       {
+        this->RemoveFromCell(ns, it.first, it.second);
         this->scene->DestroyVisual(it.second);
       }
       nsIter->second.clear();
@@ -557,6 +806,8 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
         }
       }
       this->visuals.clear();
+      this->cells.clear();
+      this->markerCells.clear();
     }
   }
   else
@@ -15,8 +15,14 @@
  *
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <map>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <sdf/Actor.hh>
@@ -32,8 +38,10 @@
 #include <ignition/common/Profiler.hh>
 #include <ignition/common/Skeleton.hh>
 #include <ignition/common/SkeletonAnimation.hh>
+#include <ignition/common/WorkerPool.hh>
 
 #include <ignition/math/Color.hh>
+#include <ignition/math/Frustum.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Matrix4.hh>
 #include <ignition/math/Pose3.hh>
@@ -55,9 +63,11 @@
 #include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/ParentEntity.hh"
+#include "ignition/gazebo/components/Performer.hh"
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/RgbdCamera.hh"
 #include "ignition/gazebo/components/Scene.hh"
+#include "ignition/gazebo/components/Static.hh"
 #include "ignition/gazebo/components/Temperature.hh"
 #include "ignition/gazebo/components/ThermalCamera.hh"
 #include "ignition/gazebo/components/Transparency.hh"
@@ -143,6 +153,11 @@ class ignition::gazebo::RenderUtilPrivate
   /// [0] entity id, [1], SDF DOM, [2] parent entity id
   public: std::vector<std::tuple<Entity, sdf::Visual, Entity>> newVisuals;
 
+  /// \brief New visuals that never move: their top level model is static
+  /// and has no performer. They are handed to the scene manager's static
+  /// batching, which merges them into consolidated per-material meshes.
+  public: std::vector<Entity> newStaticVisuals;
+
   /// \brief New actors to be created. The elements in the tuple are:
   /// [0] entity id, [1], SDF DOM, [2] parent entity id
   public: std::vector<std::tuple<Entity, sdf::Actor, Entity>> newActors;
@@ -156,6 +171,55 @@ class ignition::gazebo::RenderUtilPrivate
   public: std::vector<std::tuple<Entity, sdf::Sensor, Entity>>
       newSensors;
 
+  /// \brief Backlog of model creations deferred by the per-frame
+  /// creation budget. On the first state of a big world the backlog is
+  /// the whole scene; it is drained one budget slice per frame, models
+  /// in the user camera's view first, so the window paints right away
+  /// and stays interactive while the rest streams in. Only touched on
+  /// the render thread.
+  public: std::vector<std::tuple<Entity, sdf::Model, Entity, uint64_t>>
+      pendingModels;
+
+  /// \brief Links waiting for their budget slice or for their parent
+  /// model to be created.
+  public: std::vector<std::tuple<Entity, sdf::Link, Entity>> pendingLinks;
+
+  /// \brief Visuals waiting for their budget slice or parent link.
+  public: std::vector<std::tuple<Entity, sdf::Visual, Entity>>
+      pendingVisuals;
+
+  /// \brief Static batching marks waiting for their visual.
+  public: std::vector<Entity> pendingStaticVisuals;
+
+  /// \brief Actors waiting for their budget slice or parent.
+  public: std::vector<std::tuple<Entity, sdf::Actor, Entity>>
+      pendingActors;
+
+  /// \brief Lights waiting for their budget slice or parent.
+  public: std::vector<std::tuple<Entity, sdf::Light, Entity>>
+      pendingLights;
+
+  /// \brief Time the render thread may spend creating scene entities
+  /// per frame. See RenderUtil::SetSceneCreationBudget.
+  public: std::chrono::milliseconds creationBudget{4};
+
+  /// \brief Move pending models visible from the user camera to the
+  /// front of the backlog, so the initial viewpoint fills in first.
+  public: void PrioritizePendingModels();
+
+  /// \brief Drop pending creations made moot by entity removal: the
+  /// removed entities themselves and everything pending beneath them,
+  /// whose parent will now never be created.
+  /// \param[in] _removed Removed entity ids mapped to the sim iteration
+  /// of their removal request.
+  public: void ScrubPending(
+      const std::unordered_map<Entity, uint64_t> &_removed);
+
+  /// \brief Whether a pending creation's parent is ready in the scene.
+  /// \param[in] _parent Parent entity id.
+  /// \return True if the parent node exists or the parent is the world.
+  public: bool ParentReady(Entity _parent) const;
+
   /// \brief Map of ids of entites to be removed and sim iteration when the
   /// remove request is received
   public: std::unordered_map<Entity, uint64_t> removeEntities;
@@ -163,13 +227,29 @@ class ignition::gazebo::RenderUtilPrivate
   /// \brief A map of entity ids and pose updates.
   public: std::unordered_map<Entity, math::Pose3d> entityPoses;
 
+  /// \brief All entities mirrored into the scene graph. Used to filter the
+  /// differential pose update, since many entities that are not rendered
+  /// (collisions, joints, ...) also carry a pose component.
+  public: std::unordered_set<Entity> renderEntities;
+
   /// \brief A map of entity ids and actor transforms.
   public: std::map<Entity, std::map<std::string, math::Matrix4d>>
                           actorTransforms;
 
+  /// \brief A map of entity ids and visibility flag updates. Flags are
+  /// server authoritative: a change to the VisibilityFlags component
+  /// reaches both the GUI scene and the sensor scene through this map.
+  public: std::unordered_map<Entity, uint32_t> entityVisibilityFlags;
+
   /// \brief A map of entity ids and temperature
   public: std::map<Entity, float> entityTemp;
 
+  /// \brief Temperature last written to each visual's user data. Only
+  /// touched on the render thread, and used to skip writes that would not
+  /// change the visual, since toggling user data dirties the thermal
+  /// camera's material pass for the visual.
+  public: std::unordered_map<Entity, float> appliedTemp;
+
   /// \brief A map of entity ids and wire boxes
   public: std::unordered_map<Entity, ignition::rendering::WireBoxPtr> wireBoxes;
 
@@ -185,12 +265,39 @@ class ignition::gazebo::RenderUtilPrivate
   /// \todo(anyone) Let this be turned on from a component
   public: bool actorManualSkeletonUpdate = false;
 
+  /// \brief Actors whose skeleton poses should be evaluated for the
+  /// current frame, and the sim time to evaluate them at. Filled in
+  /// UpdateRenderingEntities, drained by Update, which hands the
+  /// evaluations to actorPosePool. Protected by updateMutex.
+  public: std::vector<std::pair<Entity, std::chrono::steady_clock::duration>>
+                          actorPoseEvals;
+
+  /// \brief Skeleton poses computed by actorPosePool since the last
+  /// frame: render frame N uploads the poses evaluated while frame N-1
+  /// was drawn. Guarded by actorPoseResultsMutex.
+  public: std::map<Entity, std::map<std::string, math::Matrix4d>>
+                          actorPoseResults;
+
+  /// \brief Guards actorPoseResults against concurrent workers.
+  public: std::mutex actorPoseResultsMutex;
+
+  /// \brief Pool evaluating actor skeleton poses while the render
+  /// thread draws, so the thread itself only uploads bone transforms.
+  public: common::WorkerPool actorPosePool{
+          std::max(1u, std::thread::hardware_concurrency())};
+
   /// \brief Mutex to protect updates
   public: std::mutex updateMutex;
 
   //// \brief Flag to indicate whether to create sensors
   public: bool enableSensors = false;
 
+  /// \brief True to build a scene for depth-only sensors: visuals get no
+  /// materials or shadow casting and lights are not mirrored into the
+  /// scene, so the material pipeline and shadow maps are skipped entirely.
+  /// See RenderUtil::SetDepthOnlyProfile.
+  public: bool depthProfile = false;
+
   /// \brief A set containing all the entities with attached rendering sensors
   public: std::unordered_set<Entity> sensorEntities;
 
@@ -213,6 +320,32 @@ class ignition::gazebo::RenderUtilPrivate
   /// \brief Whether the transform gizmo is being dragged.
   public: bool transformActive{false};
 
+  /// \brief Whether to interpolate entity poses between state updates
+  /// instead of applying them as they arrive. See
+  /// RenderUtil::SetPoseInterpolation.
+  public: bool interpolatePoses{false};
+
+  /// \brief Interpolation state of one entity's pose.
+  public: struct PoseSample
+  {
+    /// \brief Pose the entity is blending from.
+    math::Pose3d from;
+
+    /// \brief Latest pose received for the entity.
+    math::Pose3d to;
+  };
+
+  /// \brief Poses currently being interpolated toward, by entity.
+  /// Entries are dropped once the blend completes.
+  public: std::unordered_map<Entity, PoseSample> poseSamples;
+
+  /// \brief Wall clock time the newest pose samples arrived.
+  public: std::chrono::steady_clock::time_point poseSampleTime;
+
+  /// \brief Estimated interval between pose samples in seconds, measured
+  /// from their arrival times.
+  public: double poseSamplePeriod{1.0 / 60.0};
+
   /// \brief Highlight a node and all its children.
   /// \param[in] _node Node to be highlighted
   public: void HighlightNode(const rendering::NodePtr &_node);
@@ -275,31 +408,41 @@ void RenderUtil::Update()
   if (!this->dataPtr->scene)
     return;
 
+  // The pose evaluations dispatched at the end of the previous Update
+  // must finish before anything below can touch the scene manager.
+  this->dataPtr->actorPosePool.WaitForResults();
+
   this->dataPtr->updateMutex.lock();
   auto newScenes = std::move(this->dataPtr->newScenes);
   auto newModels = std::move(this->dataPtr->newModels);
   auto newLinks = std::move(this->dataPtr->newLinks);
   auto newVisuals = std::move(this->dataPtr->newVisuals);
+  auto newStaticVisuals = std::move(this->dataPtr->newStaticVisuals);
   auto newActors = std::move(this->dataPtr->newActors);
   auto newLights = std::move(this->dataPtr->newLights);
   auto removeEntities = std::move(this->dataPtr->removeEntities);
   auto entityPoses = std::move(this->dataPtr->entityPoses);
   auto trajectoryPoses = std::move(this->dataPtr->trajectoryPoses);
   auto actorTransforms = std::move(this->dataPtr->actorTransforms);
+  auto actorPoseEvals = std::move(this->dataPtr->actorPoseEvals);
   auto actorAnimationData = std::move(this->dataPtr->actorAnimationData);
+  auto entityVisibilityFlags = std::move(this->dataPtr->entityVisibilityFlags);
   auto entityTemp = std::move(this->dataPtr->entityTemp);
 
   this->dataPtr->newScenes.clear();
   this->dataPtr->newModels.clear();
   this->dataPtr->newLinks.clear();
   this->dataPtr->newVisuals.clear();
+  this->dataPtr->newStaticVisuals.clear();
   this->dataPtr->newActors.clear();
   this->dataPtr->newLights.clear();
   this->dataPtr->removeEntities.clear();
   this->dataPtr->entityPoses.clear();
   this->dataPtr->trajectoryPoses.clear();
   this->dataPtr->actorTransforms.clear();
+  this->dataPtr->actorPoseEvals.clear();
   this->dataPtr->actorAnimationData.clear();
+  this->dataPtr->entityVisibilityFlags.clear();
   this->dataPtr->entityTemp.clear();
 
   this->dataPtr->markerManager.Update();
@@ -312,6 +455,15 @@ void RenderUtil::Update()
   }
   this->dataPtr->updateMutex.unlock();
 
+  // Skeleton poses evaluated while the previous frame was drawn; this
+  // frame only uploads them.
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->actorPoseResultsMutex);
+    for (auto &result : this->dataPtr->actorPoseResults)
+      actorTransforms[result.first] = std::move(result.second);
+    this->dataPtr->actorPoseResults.clear();
+  }
+
   // scene - only one scene is supported for now
   // extend the sensor system to support mutliple scenes in the future
   for (auto &scene : newScenes)
@@ -335,6 +487,7 @@ void RenderUtil::Update()
           this->dataPtr->selectedEntities.end(), entity.first),
           this->dataPtr->selectedEntities.end());
       this->dataPtr->sceneManager.RemoveEntity(entity.first);
+      this->dataPtr->appliedTemp.erase(entity.first);
 
       // delete associated sensor, if existing
       auto sensorEntityIt = this->dataPtr->sensorEntities.find(entity.first);
@@ -349,51 +502,142 @@ void RenderUtil::Update()
   // create new entities
   {
     IGN_PROFILE("RenderUtil::Update Create");
-    for (const auto &model : newModels)
+
+    // Queue this cycle's arrivals behind whatever is still waiting. On
+    // the first state of a big world the backlog is the entire scene;
+    // it is drained under the per-frame budget below instead of built
+    // synchronously, so the window paints while the world streams in.
+    auto &pendingModels = this->dataPtr->pendingModels;
+    pendingModels.insert(pendingModels.end(),
+        std::make_move_iterator(newModels.begin()),
+        std::make_move_iterator(newModels.end()));
+    auto &pendingLinks = this->dataPtr->pendingLinks;
+    pendingLinks.insert(pendingLinks.end(),
+        std::make_move_iterator(newLinks.begin()),
+        std::make_move_iterator(newLinks.end()));
+    auto &pendingVisuals = this->dataPtr->pendingVisuals;
+    pendingVisuals.insert(pendingVisuals.end(),
+        std::make_move_iterator(newVisuals.begin()),
+        std::make_move_iterator(newVisuals.end()));
+    auto &pendingStaticVisuals = this->dataPtr->pendingStaticVisuals;
+    pendingStaticVisuals.insert(pendingStaticVisuals.end(),
+        newStaticVisuals.begin(), newStaticVisuals.end());
+    auto &pendingActors = this->dataPtr->pendingActors;
+    pendingActors.insert(pendingActors.end(),
+        std::make_move_iterator(newActors.begin()),
+        std::make_move_iterator(newActors.end()));
+    auto &pendingLights = this->dataPtr->pendingLights;
+    pendingLights.insert(pendingLights.end(),
+        std::make_move_iterator(newLights.begin()),
+        std::make_move_iterator(newLights.end()));
+
+    // Entities removed again while still pending must never be created;
+    // this also covers the create/remove race the old synchronous path
+    // resolved by comparing creation and removal iterations.
+    // \todo(anyone) add test to check scene entities are properly added
+    // and removed.
+    this->dataPtr->ScrubPending(removeEntities);
+
+    // A sensor scene must be complete before the next sensor render, so
+    // only the GUI scene is built progressively.
+    const bool budgeted = !this->dataPtr->enableSensors;
+    const auto createStart = std::chrono::steady_clock::now();
+    auto inBudget = [&]()
     {
-      uint64_t iteration = std::get<3>(model);
-      Entity entityId = std::get<0>(model);
-      // since entites to be created and removed are queued, we need
-      // to check their creation timestamp to make sure we do not create a new
-      // entity when there is also a remove request with a more recent
-      // timestamp
-      // \todo(anyone) add test to check scene entities are properly added
-      // and removed.
-      auto removeIt = removeEntities.find(entityId);
-      if (removeIt != removeEntities.end())
+      return !budgeted || std::chrono::steady_clock::now() - createStart <
+          this->dataPtr->creationBudget;
+    };
+
+    if (budgeted)
+      this->dataPtr->PrioritizePendingModels();
+
+    // Each queue keeps what the budget or a not-yet-created parent
+    // defers; the budget is checked before every creation, so at least
+    // one entity per queue is created each frame and the backlog always
+    // drains.
+    auto drain = [&](auto &_pending, const auto &_create)
+    {
+      std::size_t kept = 0;
+      for (std::size_t i = 0; i < _pending.size(); ++i)
       {
-        uint64_t removeIteration = removeIt->second;
-        if (iteration < removeIteration)
+        if (inBudget() &&
+            this->dataPtr->ParentReady(std::get<2>(_pending[i])))
+        {
+          _create(_pending[i]);
           continue;
+        }
+        if (kept != i)
+          _pending[kept] = std::move(_pending[i]);
+        ++kept;
       }
-      this->dataPtr->sceneManager.CreateModel(
-          entityId, std::get<1>(model), std::get<2>(model));
-    }
+      _pending.resize(kept);
+    };
 
-    for (const auto &link : newLinks)
-    {
-      this->dataPtr->sceneManager.CreateLink(
-          std::get<0>(link), std::get<1>(link), std::get<2>(link));
-    }
+    drain(pendingModels,
+        [&](const std::tuple<Entity, sdf::Model, Entity, uint64_t> &_model)
+        {
+          this->dataPtr->sceneManager.CreateModel(
+              std::get<0>(_model), std::get<1>(_model), std::get<2>(_model));
+        });
 
-    for (const auto &visual : newVisuals)
-    {
-      this->dataPtr->sceneManager.CreateVisual(
-          std::get<0>(visual), std::get<1>(visual), std::get<2>(visual));
-    }
+    drain(pendingLinks,
+        [&](const std::tuple<Entity, sdf::Link, Entity> &_link)
+        {
+          this->dataPtr->sceneManager.CreateLink(
+              std::get<0>(_link), std::get<1>(_link), std::get<2>(_link));
+        });
 
-    for (const auto &actor : newActors)
-    {
-      this->dataPtr->sceneManager.CreateActor(
-          std::get<0>(actor), std::get<1>(actor), std::get<2>(actor));
-    }
+    drain(pendingVisuals,
+        [&](const std::tuple<Entity, sdf::Visual, Entity> &_visual)
+        {
+          this->dataPtr->sceneManager.CreateVisual(std::get<0>(_visual),
+              std::get<1>(_visual), std::get<2>(_visual));
+        });
 
-    for (const auto &light : newLights)
+    // Static batching marks only apply once their visual exists.
     {
-      this->dataPtr->sceneManager.CreateLight(
-          std::get<0>(light), std::get<1>(light), std::get<2>(light));
+      std::size_t kept = 0;
+      for (std::size_t i = 0; i < pendingStaticVisuals.size(); ++i)
+      {
+        Entity entity = pendingStaticVisuals[i];
+        if (inBudget() &&
+            nullptr != this->dataPtr->sceneManager.NodeById(entity))
+        {
+          this->dataPtr->sceneManager.MarkStatic(entity);
+        }
+        else
+        {
+          pendingStaticVisuals[kept++] = entity;
+        }
+      }
+      pendingStaticVisuals.resize(kept);
     }
 
+    // Swap in placeholder visuals whose meshes finished parsing on the
+    // scene manager's loader thread.
+    this->dataPtr->sceneManager.UpdatePendingMeshes();
+
+    // Switch levels of detail based on the new sensor poses.
+    this->dataPtr->sceneManager.UpdateLods();
+
+    // Merge never-moving visuals into consolidated per-material meshes.
+    // Only rebuilds when batchable visuals were added or removed.
+    this->dataPtr->sceneManager.UpdateStaticBatches();
+
+    drain(pendingActors,
+        [&](const std::tuple<Entity, sdf::Actor, Entity> &_actor)
+        {
+          this->dataPtr->sceneManager.CreateActor(
+              std::get<0>(_actor), std::get<1>(_actor), std::get<2>(_actor));
+        });
+
+    drain(pendingLights,
+        [&](const std::tuple<Entity, sdf::Light, Entity> &_light)
+        {
+          this->dataPtr->sceneManager.CreateLight(
+              std::get<0>(_light), std::get<1>(_light), std::get<2>(_light));
+        });
+
     if (this->dataPtr->enableSensors && this->dataPtr->createSensorCb)
     {
       for (const auto &sensor : newSensors)
@@ -430,6 +674,18 @@ void RenderUtil::Update()
   // update entities' pose
   {
     IGN_PROFILE("RenderUtil::Update Poses");
+    auto now = std::chrono::steady_clock::now();
+    if (this->dataPtr->interpolatePoses && !entityPoses.empty())
+    {
+      // Track the interval at which pose samples arrive; the clamp keeps
+      // a stalled state stream from turning into seconds-long glides.
+      std::chrono::duration<double> elapsed =
+          now - this->dataPtr->poseSampleTime;
+      this->dataPtr->poseSamplePeriod =
+          math::clamp(elapsed.count(), 1e-3, 0.25);
+      this->dataPtr->poseSampleTime = now;
+    }
+
     for (const auto &pose : entityPoses)
     {
       auto node = this->dataPtr->sceneManager.NodeById(pose.first);
@@ -458,7 +714,55 @@ void RenderUtil::Update()
         continue;
       }
 
-      node->SetLocalPose(pose.second);
+      if (this->dataPtr->interpolatePoses)
+      {
+        // Blend from wherever the node is now; the interpolation pass
+        // below moves it the rest of the way over the sample period.
+        auto &sample = this->dataPtr->poseSamples[pose.first];
+        sample.from = node->LocalPose();
+        sample.to = pose.second;
+      }
+      else
+      {
+        node->SetLocalPose(pose.second);
+      }
+    }
+
+    // Apply the in-flight pose blends. This runs every render frame, not
+    // just when new state arrives, which is what keeps motion smooth when
+    // the display refreshes faster than the state stream.
+    if (this->dataPtr->interpolatePoses && !this->dataPtr->transformActive)
+    {
+      std::chrono::duration<double> sinceSample =
+          now - this->dataPtr->poseSampleTime;
+      const double alpha = math::clamp(
+          sinceSample.count() / this->dataPtr->poseSamplePeriod, 0.0, 1.0);
+
+      for (auto it = this->dataPtr->poseSamples.begin();
+           it != this->dataPtr->poseSamples.end();)
+      {
+        auto node = this->dataPtr->sceneManager.NodeById(it->first);
+        if (!node)
+        {
+          it = this->dataPtr->poseSamples.erase(it);
+          continue;
+        }
+
+        const auto &sample = it->second;
+        math::Pose3d blended(
+            sample.from.Pos() +
+            (sample.to.Pos() - sample.from.Pos()) * alpha,
+            math::Quaterniond::Slerp(
+                alpha, sample.from.Rot(), sample.to.Rot(), true));
+        node->SetLocalPose(blended);
+
+        // The blend is complete; drop the sample so idle entities cost
+        // nothing on later frames.
+        if (alpha >= 1.0)
+          it = this->dataPtr->poseSamples.erase(it);
+        else
+          ++it;
+      }
     }
 
     // update entities' local transformations
@@ -595,9 +899,20 @@ void RenderUtil::Update()
     }
   }
 
+  // update visibility flags
+  for (const auto &flags : entityVisibilityFlags)
+  {
+    this->dataPtr->sceneManager.SetVisibilityFlags(flags.first, flags.second);
+  }
+
   // set visual temperature
   for (auto &temp : entityTemp)
   {
+    auto appliedIt = this->dataPtr->appliedTemp.find(temp.first);
+    if (appliedIt != this->dataPtr->appliedTemp.end() &&
+        math::equal(appliedIt->second, temp.second))
+      continue;
+
     auto node = this->dataPtr->sceneManager.NodeById(temp.first);
     if (!node)
       continue;
@@ -608,7 +923,133 @@ void RenderUtil::Update()
       continue;
 
     visual->SetUserData("temperature", temp.second);
+    this->dataPtr->appliedTemp[temp.first] = temp.second;
   }
+
+  // Kick off skeleton pose evaluation for the actors queued this
+  // frame. The workers run while the frame draws; the WaitForResults
+  // at the top of the next Update is the synchronization point, and
+  // that frame uploads the poses computed here.
+  for (const auto &eval : actorPoseEvals)
+  {
+    const Entity entity = eval.first;
+    const auto evalTime = eval.second;
+    this->dataPtr->actorPosePool.AddWork([this, entity, evalTime]()
+    {
+      auto frames = this->dataPtr->sceneManager.ActorSkeletonTransformsAt(
+          entity, evalTime);
+      std::lock_guard<std::mutex> lock(this->dataPtr->actorPoseResultsMutex);
+      this->dataPtr->actorPoseResults[entity] = std::move(frames);
+    });
+  }
+}
+
+//////////////////////////////////////////////////
+bool RenderUtilPrivate::ParentReady(Entity _parent) const
+{
+  return _parent == this->sceneManager.WorldId() ||
+      nullptr != this->sceneManager.NodeById(_parent);
+}
+
+//////////////////////////////////////////////////
+void RenderUtilPrivate::PrioritizePendingModels()
+{
+  if (this->pendingModels.size() < 2)
+    return;
+
+  // Find the user camera. The GUI scene has exactly one; a scene
+  // without cameras keeps arrival order.
+  rendering::CameraPtr camera;
+  for (unsigned int i = 0; i < this->scene->SensorCount(); ++i)
+  {
+    camera = std::dynamic_pointer_cast<rendering::Camera>(
+        this->scene->SensorByIndex(i));
+    if (camera)
+      break;
+  }
+  if (!camera)
+    return;
+
+  const math::Pose3d camPose = camera->WorldPose();
+  const math::Frustum frustum(camera->NearClipPlane(),
+      camera->FarClipPlane(), camera->HFOV(), camera->AspectRatio(),
+      camPose);
+
+  // Models in the initial view fill in first. The raw pose stands in
+  // for the model's world pose, which is exact for top level models. A
+  // radius around the camera is included so nearby models are already
+  // there when the user turns around.
+  std::stable_partition(this->pendingModels.begin(),
+      this->pendingModels.end(),
+      [&](const std::tuple<Entity, sdf::Model, Entity, uint64_t> &_model)
+      {
+        const math::Vector3d &pos = std::get<1>(_model).RawPose().Pos();
+        return frustum.Contains(pos) ||
+            camPose.Pos().Distance(pos) < 20.0;
+      });
+}
+
+//////////////////////////////////////////////////
+void RenderUtilPrivate::ScrubPending(
+    const std::unordered_map<Entity, uint64_t> &_removed)
+{
+  if (_removed.empty())
+    return;
+
+  // Everything pending beneath a removed entity can never be created:
+  // its parent will never appear. Models seed the set, and pending
+  // links, visuals, actors and lights below them follow. The queues
+  // hold parents before their children, so one pass per queue is
+  // enough.
+  std::unordered_set<Entity> gone;
+
+  auto modelEnd = std::remove_if(this->pendingModels.begin(),
+      this->pendingModels.end(),
+      [&](const std::tuple<Entity, sdf::Model, Entity, uint64_t> &_model)
+      {
+        // since entites to be created and removed are queued, we need
+        // to check their creation timestamp to make sure we do not
+        // drop a pending entity when the remove request is older than
+        // its creation
+        auto it = _removed.find(std::get<0>(_model));
+        if ((it != _removed.end() && std::get<3>(_model) < it->second) ||
+            0 != gone.count(std::get<2>(_model)))
+        {
+          gone.insert(std::get<0>(_model));
+          return true;
+        }
+        return false;
+      });
+  this->pendingModels.erase(modelEnd, this->pendingModels.end());
+
+  auto scrubChildren = [&](auto &_pending)
+  {
+    auto end = std::remove_if(_pending.begin(), _pending.end(),
+        [&](const auto &_item)
+        {
+          if (0 == _removed.count(std::get<0>(_item)) &&
+              0 == gone.count(std::get<2>(_item)))
+          {
+            return false;
+          }
+          gone.insert(std::get<0>(_item));
+          return true;
+        });
+    _pending.erase(end, _pending.end());
+  };
+  scrubChildren(this->pendingLinks);
+  scrubChildren(this->pendingVisuals);
+  scrubChildren(this->pendingActors);
+  scrubChildren(this->pendingLights);
+
+  auto staticEnd = std::remove_if(this->pendingStaticVisuals.begin(),
+      this->pendingStaticVisuals.end(),
+      [&](Entity _entity)
+      {
+        return 0 != _removed.count(_entity) || 0 != gone.count(_entity);
+      });
+  this->pendingStaticVisuals.erase(staticEnd,
+      this->pendingStaticVisuals.end());
 }
 
 //////////////////////////////////////////////////
@@ -618,8 +1059,18 @@ void RenderUtilPrivate::CreateRenderingEntities(
   IGN_PROFILE("RenderUtilPrivate::CreateRenderingEntities");
   auto addNewSensor = [&_ecm, this](Entity _entity, const sdf::Sensor &_sdfData,
                                     Entity _parent,
-                                    const std::string &_topicSuffix)
+                                    const std::string &_topicSuffix,
+                                    bool _usesMaterials = false)
   {
+    // The depth-only profile strips materials and lights from the scene,
+    // which depth output does not depend on but images do.
+    if (_usesMaterials && this->depthProfile)
+    {
+      ignwarn << "Sensor [" << _sdfData.Name() << "] renders materials but "
+              << "the scene uses the depth-only profile. Its output will be "
+              << "unlit and untextured." << std::endl;
+    }
+
     sdf::Sensor sdfDataCopy(_sdfData);
     std::string sensorScopedName =
         removeParentScope(scopedName(_entity, _ecm, "::", false), "::");
@@ -632,6 +1083,30 @@ void RenderUtilPrivate::CreateRenderingEntities(
     this->newSensors.push_back(
         std::make_tuple(_entity, std::move(sdfDataCopy), _parent));
     this->sensorEntities.insert(_entity);
+    this->renderEntities.insert(_entity);
+  };
+
+  // A visual is batchable as static when its top level model is static,
+  // since nothing under a static model ever moves, and carries no
+  // performer, since performer models are what levels load and unload
+  // around.
+  auto isStaticVisual = [&_ecm](Entity _entity) -> bool
+  {
+    Entity current = _entity;
+    while (true)
+    {
+      auto parentComp = _ecm.Component<components::ParentEntity>(current);
+      if (!parentComp)
+        return false;
+      Entity parent = parentComp->Data();
+      if (_ecm.Component<components::World>(parent))
+        break;
+      current = parent;
+    }
+    auto staticComp = _ecm.Component<components::Static>(current);
+    if (!staticComp || !staticComp->Data())
+      return false;
+    return _ecm.ChildrenByComponents(current, components::Performer()).empty();
   };
 
   const std::string cameraSuffix{"/image"};
@@ -673,6 +1148,7 @@ void RenderUtilPrivate::CreateRenderingEntities(
           this->newModels.push_back(
               std::make_tuple(_entity, model, _parent->Data(),
               _info.iterations));
+          this->renderEntities.insert(_entity);
           return true;
         });
 
@@ -689,6 +1165,7 @@ void RenderUtilPrivate::CreateRenderingEntities(
           link.SetRawPose(_pose->Data());
           this->newLinks.push_back(
               std::make_tuple(_entity, link, _parent->Data()));
+          this->renderEntities.insert(_entity);
           return true;
         });
 
@@ -713,28 +1190,35 @@ void RenderUtilPrivate::CreateRenderingEntities(
           visual.SetName(_name->Data());
           visual.SetRawPose(_pose->Data());
           visual.SetGeom(_geom->Data());
-          visual.SetCastShadows(_castShadows->Data());
+          visual.SetCastShadows(!this->depthProfile && _castShadows->Data());
           visual.SetTransparency(_transparency->Data());
           visual.SetVisibilityFlags(_visibilityFlags->Data());
 
-          // Optional components
-          auto material = _ecm.Component<components::Material>(_entity);
-          if (material != nullptr)
+          // Optional components. Materials and temperatures only affect
+          // image output and are skipped in the depth-only profile.
+          if (!this->depthProfile)
           {
-            visual.SetMaterial(material->Data());
-          }
-
-          // todo(anyone) make visual updates more generic without using extra
-          // variables like entityTemp just for storing one specific visual
-          // param?
-          auto temp = _ecm.Component<components::Temperature>(_entity);
-          if (temp)
-          {
-            this->entityTemp[_entity] = temp->Data().Kelvin();
+            auto material = _ecm.Component<components::Material>(_entity);
+            if (material != nullptr)
+            {
+              visual.SetMaterial(material->Data());
+            }
+
+            // todo(anyone) make visual updates more generic without using
+            // extra variables like entityTemp just for storing one specific
+            // visual param?
+            auto temp = _ecm.Component<components::Temperature>(_entity);
+            if (temp)
+            {
+              this->entityTemp[_entity] = temp->Data().Kelvin();
+            }
           }
 
           this->newVisuals.push_back(
               std::make_tuple(_entity, visual, _parent->Data()));
+          this->renderEntities.insert(_entity);
+          if (isStaticVisual(_entity))
+            this->newStaticVisuals.push_back(_entity);
           return true;
         });
 
@@ -746,19 +1230,27 @@ void RenderUtilPrivate::CreateRenderingEntities(
         {
           this->newActors.push_back(
               std::make_tuple(_entity, _actor->Data(), _parent->Data()));
+          this->renderEntities.insert(_entity);
           return true;
         });
 
     // lights
-    _ecm.Each<components::Light, components::ParentEntity>(
-        [&](const Entity &_entity,
-            const components::Light *_light,
-            const components::ParentEntity *_parent) -> bool
-        {
-          this->newLights.push_back(
-              std::make_tuple(_entity, _light->Data(), _parent->Data()));
-          return true;
-        });
+    // The depth-only profile leaves lights out of the scene entirely:
+    // depth does not depend on illumination, and without shadow-casting
+    // lights no shadow maps are rendered.
+    if (!this->depthProfile)
+    {
+      _ecm.Each<components::Light, components::ParentEntity>(
+          [&](const Entity &_entity,
+              const components::Light *_light,
+              const components::ParentEntity *_parent) -> bool
+          {
+            this->newLights.push_back(
+                std::make_tuple(_entity, _light->Data(), _parent->Data()));
+            this->renderEntities.insert(_entity);
+            return true;
+          });
+    }
 
     if (this->enableSensors)
     {
@@ -769,7 +1261,7 @@ void RenderUtilPrivate::CreateRenderingEntities(
             const components::ParentEntity *_parent)->bool
           {
             addNewSensor(_entity, _camera->Data(), _parent->Data(),
-                         cameraSuffix);
+                         cameraSuffix, true);
             return true;
           });
 
@@ -791,7 +1283,7 @@ void RenderUtilPrivate::CreateRenderingEntities(
             const components::ParentEntity *_parent)->bool
           {
             addNewSensor(_entity, _rgbdCamera->Data(), _parent->Data(),
-                         rgbdCameraSuffix);
+                         rgbdCameraSuffix, true);
             return true;
           });
 
@@ -813,7 +1305,7 @@ void RenderUtilPrivate::CreateRenderingEntities(
             const components::ParentEntity *_parent)->bool
           {
             addNewSensor(_entity, _thermalCamera->Data(), _parent->Data(),
-                         thermalCameraSuffix);
+                         thermalCameraSuffix, true);
             return true;
           });
     }
@@ -849,6 +1341,7 @@ void RenderUtilPrivate::CreateRenderingEntities(
           this->newModels.push_back(
               std::make_tuple(_entity, model, _parent->Data(),
               _info.iterations));
+          this->renderEntities.insert(_entity);
           return true;
         });
 
@@ -865,6 +1358,7 @@ void RenderUtilPrivate::CreateRenderingEntities(
           link.SetRawPose(_pose->Data());
           this->newLinks.push_back(
               std::make_tuple(_entity, link, _parent->Data()));
+          this->renderEntities.insert(_entity);
           return true;
         });
 
@@ -889,19 +1383,25 @@ void RenderUtilPrivate::CreateRenderingEntities(
           visual.SetName(_name->Data());
           visual.SetRawPose(_pose->Data());
           visual.SetGeom(_geom->Data());
-          visual.SetCastShadows(_castShadows->Data());
+          visual.SetCastShadows(!this->depthProfile && _castShadows->Data());
           visual.SetTransparency(_transparency->Data());
           visual.SetVisibilityFlags(_visibilityFlags->Data());
 
-          // Optional components
-          auto material = _ecm.Component<components::Material>(_entity);
-          if (material != nullptr)
+          // Optional components, skipped in the depth-only profile
+          if (!this->depthProfile)
           {
-            visual.SetMaterial(material->Data());
+            auto material = _ecm.Component<components::Material>(_entity);
+            if (material != nullptr)
+            {
+              visual.SetMaterial(material->Data());
+            }
           }
 
           this->newVisuals.push_back(
               std::make_tuple(_entity, visual, _parent->Data()));
+          this->renderEntities.insert(_entity);
+          if (isStaticVisual(_entity))
+            this->newStaticVisuals.push_back(_entity);
           return true;
         });
 
@@ -913,19 +1413,24 @@ void RenderUtilPrivate::CreateRenderingEntities(
         {
           this->newActors.push_back(
               std::make_tuple(_entity, _actor->Data(), _parent->Data()));
+          this->renderEntities.insert(_entity);
           return true;
         });
 
-    // lights
-    _ecm.EachNew<components::Light, components::ParentEntity>(
-        [&](const Entity &_entity,
-            const components::Light *_light,
-            const components::ParentEntity *_parent) -> bool
-        {
-          this->newLights.push_back(
-              std::make_tuple(_entity, _light->Data(), _parent->Data()));
-          return true;
-        });
+    // lights, left out of the scene in the depth-only profile
+    if (!this->depthProfile)
+    {
+      _ecm.EachNew<components::Light, components::ParentEntity>(
+          [&](const Entity &_entity,
+              const components::Light *_light,
+              const components::ParentEntity *_parent) -> bool
+          {
+            this->newLights.push_back(
+                std::make_tuple(_entity, _light->Data(), _parent->Data()));
+            this->renderEntities.insert(_entity);
+            return true;
+          });
+    }
 
     if (this->enableSensors)
     {
@@ -936,7 +1441,7 @@ void RenderUtilPrivate::CreateRenderingEntities(
             const components::ParentEntity *_parent)->bool
           {
             addNewSensor(_entity, _camera->Data(), _parent->Data(),
-                         cameraSuffix);
+                         cameraSuffix, true);
             return true;
           });
 
@@ -958,7 +1463,7 @@ void RenderUtilPrivate::CreateRenderingEntities(
             const components::ParentEntity *_parent)->bool
           {
             addNewSensor(_entity, _rgbdCamera->Data(), _parent->Data(),
-                         rgbdCameraSuffix);
+                         rgbdCameraSuffix, true);
             return true;
           });
 
@@ -980,7 +1485,7 @@ void RenderUtilPrivate::CreateRenderingEntities(
             const components::ParentEntity *_parent)->bool
           {
             addNewSensor(_entity, _thermalCamera->Data(), _parent->Data(),
-                         thermalCameraSuffix);
+                         thermalCameraSuffix, true);
             return true;
           });
     }
@@ -992,35 +1497,49 @@ void RenderUtilPrivate::UpdateRenderingEntities(
     const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("RenderUtilPrivate::UpdateRenderingEntities");
-  _ecm.Each<components::Model, components::Pose>(
-      [&](const Entity &_entity,
-        const components::Model *,
-        const components::Pose *_pose)->bool
-      {
-        this->entityPoses[_entity] = _pose->Data();
-        return true;
-      });
 
-  _ecm.Each<components::Link, components::Pose>(
-      [&](const Entity &_entity,
-        const components::Link *,
-        const components::Pose *_pose)->bool
+  // Differential pose update: only components marked changed during this
+  // iteration are visited, so the cost scales with scene churn rather than
+  // scene size. The filter against renderEntities drops entities that carry
+  // a pose but are never rendered, such as collisions and joints.
+  _ecm.ForEachChanged<components::Pose>(
+      [&](const Entity &_entity, const components::Pose *_pose)->bool
       {
-        this->entityPoses[_entity] = _pose->Data();
+        if (this->renderEntities.find(_entity) != this->renderEntities.end())
+          this->entityPoses[_entity] = _pose->Data();
         return true;
       });
 
-  // visuals
-  _ecm.Each<components::Visual, components::Pose >(
+  // Differential temperature update: Temperature components are marked
+  // changed on creation and on every write, so heat sources spawned or
+  // updated at runtime reach the scene without a per-visual scan. The
+  // batch applying these on the render thread skips values that are
+  // already set. Temperatures only matter to thermal cameras and are
+  // skipped in the depth-only profile.
+  if (!this->depthProfile)
+  {
+    _ecm.ForEachChanged<components::Temperature>(
+        [&](const Entity &_entity, const components::Temperature *_temp)->bool
+        {
+          this->entityTemp[_entity] = _temp->Data().Kelvin();
+          return true;
+        });
+  }
+
+  // Differential visibility update: visibility flags are authoritative
+  // on the server, so sensors stop seeing a subtree the moment a system
+  // or user command rewrites its flags, without duplicating models per
+  // sensor.
+  _ecm.ForEachChanged<components::VisibilityFlags>(
       [&](const Entity &_entity,
-        const components::Visual *,
-        const components::Pose *_pose)->bool
+          const components::VisibilityFlags *_flags)->bool
       {
-        this->entityPoses[_entity] = _pose->Data();
+        this->entityVisibilityFlags[_entity] = _flags->Data();
         return true;
       });
 
-  // actors
+  // actors animate with sim time even when their pose component does not
+  // change, so they keep a full pass.
   _ecm.Each<components::Actor, components::Pose>(
       [&](const Entity &_entity,
         const components::Actor *,
@@ -1049,12 +1568,12 @@ void RenderUtilPrivate::UpdateRenderingEntities(
             this->actorAnimationData[_entity] = animData;
           }
         }
-        // Bone poses calculated by ign-common
+        // Bone poses calculated by ign-common. Queued here and
+        // evaluated on actorPosePool while the frame draws; the next
+        // frame uploads the result.
         else if (this->actorManualSkeletonUpdate)
         {
-          this->actorTransforms[_entity] =
-              this->sceneManager.ActorSkeletonTransformsAt(
-              _entity, this->simTime);
+          this->actorPoseEvals.push_back({_entity, this->simTime});
         }
         // Trajectory info from SDF so ign-rendering can calculate bone poses
         else
@@ -1069,66 +1588,6 @@ void RenderUtilPrivate::UpdateRenderingEntities(
           this->trajectoryPoses[_entity] = trajPoseComp->Data();
         return true;
       });
-
-  // lights
-  _ecm.Each<components::Light, components::Pose>(
-      [&](const Entity &_entity,
-        const components::Light *,
-        const components::Pose *_pose)->bool
-      {
-        this->entityPoses[_entity] = _pose->Data();
-        return true;
-      });
-
-  // Update cameras
-  _ecm.Each<components::Camera, components::Pose>(
-      [&](const Entity &_entity,
-        const components::Camera *,
-        const components::Pose *_pose)->bool
-      {
-        this->entityPoses[_entity] = _pose->Data();
-        return true;
-      });
-
-  // Update depth cameras
-  _ecm.Each<components::DepthCamera, components::Pose>(
-      [&](const Entity &_entity,
-        const components::DepthCamera *,
-        const components::Pose *_pose)->bool
-      {
-        this->entityPoses[_entity] = _pose->Data();
-        return true;
-      });
-
-  // Update RGBD cameras
-  _ecm.Each<components::RgbdCamera, components::Pose>(
-      [&](const Entity &_entity,
-        const components::RgbdCamera *,
-        const components::Pose *_pose)->bool
-      {
-        this->entityPoses[_entity] = _pose->Data();
-        return true;
-      });
-
-  // Update gpu_lidar
-  _ecm.Each<components::GpuLidar, components::Pose>(
-      [&](const Entity &_entity,
-        const components::GpuLidar *,
-        const components::Pose *_pose)->bool
-      {
-        this->entityPoses[_entity] = _pose->Data();
-        return true;
-      });
-
-  // Update thermal cameras
-  _ecm.Each<components::ThermalCamera, components::Pose>(
-      [&](const Entity &_entity,
-        const components::ThermalCamera *,
-        const components::Pose *_pose)->bool
-      {
-        this->entityPoses[_entity] = _pose->Data();
-        return true;
-      });
 }
 
 //////////////////////////////////////////////////
@@ -1140,6 +1599,7 @@ void RenderUtilPrivate::RemoveRenderingEntities(
       [&](const Entity &_entity, const components::Model *)->bool
       {
         this->removeEntities[_entity] = _info.iterations;
+        this->renderEntities.erase(_entity);
         return true;
       });
 
@@ -1147,6 +1607,7 @@ void RenderUtilPrivate::RemoveRenderingEntities(
       [&](const Entity &_entity, const components::Link *)->bool
       {
         this->removeEntities[_entity] = _info.iterations;
+        this->renderEntities.erase(_entity);
         return true;
       });
 
@@ -1155,6 +1616,7 @@ void RenderUtilPrivate::RemoveRenderingEntities(
       [&](const Entity &_entity, const components::Visual *)->bool
       {
         this->removeEntities[_entity] = _info.iterations;
+        this->renderEntities.erase(_entity);
         return true;
       });
 
@@ -1163,6 +1625,7 @@ void RenderUtilPrivate::RemoveRenderingEntities(
       [&](const Entity &_entity, const components::Light *)->bool
       {
         this->removeEntities[_entity] = _info.iterations;
+        this->renderEntities.erase(_entity);
         return true;
       });
 
@@ -1171,6 +1634,7 @@ void RenderUtilPrivate::RemoveRenderingEntities(
     [&](const Entity &_entity, const components::Camera *)->bool
       {
         this->removeEntities[_entity] = _info.iterations;
+        this->renderEntities.erase(_entity);
         return true;
       });
 
@@ -1179,6 +1643,7 @@ void RenderUtilPrivate::RemoveRenderingEntities(
     [&](const Entity &_entity, const components::DepthCamera *)->bool
       {
         this->removeEntities[_entity] = _info.iterations;
+        this->renderEntities.erase(_entity);
         return true;
       });
 
@@ -1187,6 +1652,7 @@ void RenderUtilPrivate::RemoveRenderingEntities(
     [&](const Entity &_entity, const components::RgbdCamera *)->bool
       {
         this->removeEntities[_entity] = _info.iterations;
+        this->renderEntities.erase(_entity);
         return true;
       });
 
@@ -1195,6 +1661,7 @@ void RenderUtilPrivate::RemoveRenderingEntities(
     [&](const Entity &_entity, const components::GpuLidar *)->bool
       {
         this->removeEntities[_entity] = _info.iterations;
+        this->renderEntities.erase(_entity);
         return true;
       });
 
@@ -1203,6 +1670,7 @@ void RenderUtilPrivate::RemoveRenderingEntities(
     [&](const Entity &_entity, const components::ThermalCamera *)->bool
       {
         this->removeEntities[_entity] = _info.iterations;
+        this->renderEntities.erase(_entity);
         return true;
       });
 }
@@ -1391,6 +1859,25 @@ void RenderUtil::SetTransformActive(bool _active)
   this->dataPtr->transformActive = _active;
 }
 
+/////////////////////////////////////////////////
+void RenderUtil::SetPoseInterpolation(bool _enable)
+{
+  this->dataPtr->interpolatePoses = _enable;
+}
+
+//////////////////////////////////////////////////
+void RenderUtil::SetSceneCreationBudget(
+    const std::chrono::milliseconds &_budget)
+{
+  this->dataPtr->creationBudget = _budget;
+}
+
+/////////////////////////////////////////////////
+void RenderUtil::SetDepthOnlyProfile(bool _enable)
+{
+  this->dataPtr->depthProfile = _enable;
+}
+
 ////////////////////////////////////////////////
 void RenderUtilPrivate::HighlightNode(const rendering::NodePtr &_node)
 {
@@ -16,7 +16,19 @@
  */
 
 
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 #include <sdf/Box.hh>
 #include <sdf/Cylinder.hh>
@@ -30,12 +42,15 @@
 #include <ignition/common/KeyFrame.hh>
 #include <ignition/common/Skeleton.hh>
 #include <ignition/common/SkeletonAnimation.hh>
+#include <ignition/common/Mesh.hh>
 #include <ignition/common/MeshManager.hh>
+#include <ignition/common/SubMesh.hh>
 
 #include <ignition/rendering/Geometry.hh>
 #include <ignition/rendering/Light.hh>
 #include <ignition/rendering/Material.hh>
 #include <ignition/rendering/Scene.hh>
+#include <ignition/rendering/Sensor.hh>
 #include <ignition/rendering/Visual.hh>
 
 #include "ignition/gazebo/Util.hh"
@@ -47,6 +62,149 @@ using namespace std::chrono_literals;
 
 using TP = std::chrono::steady_clock::time_point;
 
+/// \brief Process-wide cache of parsed mesh assets. Every scene in the
+/// process shares it: when the server runs sensors and the GUI in one
+/// process, the sensor scene and the GUI scene each own a SceneManager,
+/// and without a shared cache they would parse identical files twice and
+/// race each other inside the mesh manager. One loader thread serves all
+/// scenes, duplicate requests are folded, and reference counts across all
+/// scenes decide when a mesh is evicted from memory.
+class MeshCache
+{
+  /// \brief Get the process-wide instance.
+  public: static MeshCache &Instance()
+  {
+    static MeshCache instance;
+    return instance;
+  }
+
+  /// \brief Hand a mesh file to the loader thread, starting the thread on
+  /// first use. Duplicate requests are dropped; the mesh manager caches
+  /// parsed meshes by resolved path, so repeated spawns of the same model
+  /// from any scene never queue again.
+  /// \param[in] _meshName Resolved mesh file path.
+  public: void Queue(const std::string &_meshName)
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if (!this->queuedMeshes.insert(_meshName).second)
+      return;
+
+    this->loadQueue.push_back(_meshName);
+    if (!this->running)
+    {
+      this->running = true;
+      this->loaderThread = std::thread(&MeshCache::LoaderLoop, this);
+    }
+    lock.unlock();
+    this->cv.notify_one();
+  }
+
+  /// \brief Whether the parse of a mesh file failed.
+  /// \param[in] _meshName Resolved mesh file path.
+  /// \return True if the loader gave up on this mesh.
+  public: bool Failed(const std::string &_meshName)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->failedMeshes.find(_meshName) != this->failedMeshes.end();
+  }
+
+  /// \brief Add a reference to a mesh. Called by scenes for each visual
+  /// that uses the mesh.
+  /// \param[in] _meshName Resolved mesh file path.
+  public: void Retain(const std::string &_meshName)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->refCounts[_meshName];
+  }
+
+  /// \brief Drop a reference to a mesh. When the last visual of the last
+  /// scene using the mesh is gone, the parsed copy is evicted from the
+  /// mesh manager and a later spawn queues a fresh parse.
+  /// \param[in] _meshName Resolved mesh file path.
+  public: void Release(const std::string &_meshName)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->refCounts.find(_meshName);
+    if (it == this->refCounts.end())
+      return;
+
+    if (--it->second <= 0)
+    {
+      this->refCounts.erase(it);
+      this->queuedMeshes.erase(_meshName);
+      this->failedMeshes.erase(_meshName);
+      common::MeshManager::Instance()->RemoveMesh(_meshName);
+    }
+  }
+
+  /// \brief Loader thread function. Parses queued mesh files through the
+  /// common::MeshManager, which caches them by name for all scenes to
+  /// pick up.
+  private: void LoaderLoop()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (this->running)
+    {
+      this->cv.wait(lock, [this]()
+      {
+        return !this->running || !this->loadQueue.empty();
+      });
+
+      while (this->running && !this->loadQueue.empty())
+      {
+        std::string meshName = std::move(this->loadQueue.front());
+        this->loadQueue.erase(this->loadQueue.begin());
+
+        // Parse outside the lock. The mesh manager caches the result by
+        // resolved path, so render threads pick it up without reparsing.
+        lock.unlock();
+        const common::Mesh *mesh =
+            common::MeshManager::Instance()->Load(meshName);
+        lock.lock();
+
+        if (nullptr == mesh)
+          this->failedMeshes.insert(meshName);
+      }
+    }
+  }
+
+  /// \brief Destructor, stops the loader thread.
+  private: ~MeshCache()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->running = false;
+    }
+    this->cv.notify_all();
+    if (this->loaderThread.joinable())
+      this->loaderThread.join();
+  }
+
+  /// \brief Thread that parses mesh files off the render threads.
+  private: std::thread loaderThread;
+
+  /// \brief Mutex protecting the queue and bookkeeping maps.
+  private: std::mutex mutex;
+
+  /// \brief Condition variable to wake the loader thread.
+  private: std::condition_variable cv;
+
+  /// \brief Mesh files waiting to be parsed.
+  private: std::vector<std::string> loadQueue;
+
+  /// \brief Mesh files handed to the loader, to fold duplicates.
+  private: std::unordered_set<std::string> queuedMeshes;
+
+  /// \brief Mesh files whose parse failed.
+  private: std::unordered_set<std::string> failedMeshes;
+
+  /// \brief Number of visuals across all scenes using each mesh.
+  private: std::map<std::string, int> refCounts;
+
+  /// \brief Whether the loader thread is running.
+  private: bool running{false};
+};
+
 /// \brief Private data class.
 class ignition::gazebo::SceneManagerPrivate
 {
@@ -71,6 +229,66 @@ class ignition::gazebo::SceneManagerPrivate
   public: std::map<Entity, std::vector<common::TrajectoryInfo>>
                     actorTrajectories;
 
+  /// \brief Uniformly sampled tables for one actor trajectory. Built once
+  /// at load so per-frame evaluation is a table lookup instead of a
+  /// keyframe scan.
+  public: struct TrajectorySamples
+  {
+    /// \brief Seconds between consecutive samples.
+    double step{0.0};
+
+    /// \brief Interpolated waypoint pose at each sample time.
+    std::vector<math::Pose3d> poses;
+
+    /// \brief Distance traveled along the waypoints at each sample time.
+    std::vector<double> distances;
+  };
+
+  /// \brief Sampled waypoint tables per actor, parallel to the actor's
+  /// entry in actorTrajectories. Trajectories without waypoints get an
+  /// empty table.
+  public: std::map<Entity, std::vector<TrajectorySamples>>
+                    actorTrajectorySamples;
+
+  /// \brief Uniformly sampled root node motion of one skeleton animation.
+  public: struct RootNodeSamples
+  {
+    /// \brief Seconds between consecutive samples.
+    double step{0.0};
+
+    /// \brief Length of the animation in seconds.
+    double length{0.0};
+
+    /// \brief Raw root node frame at each sample time.
+    std::vector<math::Pose3d> frames;
+
+    /// \brief X translation of the first root keyframe.
+    double firstX{0.0};
+
+    /// \brief X translation of the last root keyframe.
+    double lastX{0.0};
+
+    /// \brief Animation time at uniformly spaced x positions between
+    /// firstX and lastX. Empty when the animation has no x displacement.
+    std::vector<double> timeAtX;
+  };
+
+  /// \brief Sampled root node tables per actor, indexed by animation.
+  public: std::map<Entity, std::vector<RootNodeSamples>>
+                    actorRootNodeSamples;
+
+  /// \brief Build the sampled trajectory and root node tables of an
+  /// actor. Called once when the actor is created.
+  /// \param[in] _id Actor entity's unique id
+  public: void BuildActorSampleTables(Entity _id);
+
+  /// \brief Get the sampled table of the trajectory an actor is playing.
+  /// \param[in] _id Actor entity's unique id
+  /// \param[in] _traj The trajectory, as returned by ActorTrajectoryAt
+  /// \return The table, or nullptr if the trajectory has no waypoints.
+  public: const TrajectorySamples *TrajectorySamplesFor(Entity _id,
+      const common::TrajectoryInfo &_traj) const;
+
   /// \brief Map of light entity in Gazebo to light pointers.
   public: std::map<Entity, rendering::LightPtr> lights;
 
@@ -84,8 +302,236 @@ class ignition::gazebo::SceneManagerPrivate
   /// also sets the time point in which the animation should be played
   public: AnimationUpdateData ActorTrajectoryAt(
       Entity _id, const std::chrono::steady_clock::duration &_time) const;
+
+  /// \brief Evaluate the skin-aligned skeleton frames of an animation.
+  /// Looped evaluations are quantized to the sample grid the actor
+  /// tables use and cached under the skeleton and animation, so a crowd
+  /// of actors sharing a skin costs one evaluation per sample instead
+  /// of one per actor. X-interpolated evaluations depend on the actor's
+  /// own distance along its trajectory and are computed directly.
+  /// \param[in] _skel Skeleton to evaluate.
+  /// \param[in] _animIndex Animation to evaluate.
+  /// \param[in] _timeSeconds Animation time in seconds.
+  /// \param[in] _distance Distance traveled, for x interpolation.
+  /// \param[in] _interpolateX Whether to evaluate by distance.
+  /// \param[in] _noLoop Whether the animation plays once.
+  /// \return Frames by skin node name.
+  public: std::map<std::string, math::Matrix4d> SkeletonFramesAt(
+      const common::SkeletonPtr &_skel, unsigned int _animIndex,
+      double _timeSeconds, double _distance, bool _interpolateX,
+      bool _noLoop) const;
+
+  /// \brief Evaluated skeleton frames, keyed by skeleton, animation
+  /// and sample index. Guarded by skeletonFrameMutex.
+  public: mutable std::map<std::string,
+      std::map<std::string, math::Matrix4d>> skeletonFrameCache;
+
+  /// \brief Guards skeletonFrameCache; RenderUtil evaluates actor
+  /// poses on worker threads.
+  public: mutable std::mutex skeletonFrameMutex;
+
+  /// \brief A visual waiting for its mesh to be parsed by the loader
+  /// thread. The placeholder created in its place is swapped for the real
+  /// visual in UpdatePendingMeshes.
+  public: struct PendingMeshVisual
+  {
+    /// \brief Visual entity id.
+    Entity id;
+
+    /// \brief The visual SDF DOM, replayed once the mesh is ready.
+    sdf::Visual visual;
+
+    /// \brief Parent entity id.
+    Entity parentId;
+
+    /// \brief Resolved mesh file path.
+    std::string meshName;
+  };
+
+  /// \brief Visuals whose meshes are still being parsed.
+  public: std::vector<PendingMeshVisual> pendingMeshVisuals;
+
+  /// \brief Mesh file used by each visual, for the shared cache's
+  /// reference counting.
+  public: std::map<Entity, std::string> visualMeshNames;
+
+  /// \brief One level of detail of a visual.
+  public: struct LodLevel
+  {
+    /// \brief Distance at which this level becomes active.
+    double distance;
+
+    /// \brief Geometry rendered at this level. A null geometry hides
+    /// the visual entirely beyond the level's distance.
+    rendering::GeometryPtr geometry;
+  };
+
+  /// \brief The levels of detail of one visual.
+  public: struct VisualLods
+  {
+    /// \brief Levels sorted by ascending distance. Level zero holds the
+    /// full resolution geometry.
+    std::vector<LodLevel> levels;
+
+    /// \brief Index of the level currently attached to the visual.
+    size_t activeLevel{0};
+  };
+
+  /// \brief Visuals that declared level-of-detail meshes.
+  public: std::map<Entity, VisualLods> visualLods;
+
+  /// \brief What a visual renders, recorded at creation time so static
+  /// batching can bake the same geometry and material into a merged mesh.
+  public: struct BatchGeomInfo
+  {
+    /// \brief Name of the source mesh in the common::MeshManager: the
+    /// unit primitive meshes for primitive geometries, the resolved file
+    /// path for mesh geometries.
+    std::string meshName;
+
+    /// \brief Submesh restriction of a mesh geometry, empty for all.
+    std::string submeshName;
+
+    /// \brief True for primitive geometries, which render with an SDF or
+    /// default material. Meshes carry their own materials instead unless
+    /// an SDF material is given.
+    bool primitive{false};
+
+    /// \brief Whether the visual has an explicit SDF material.
+    bool hasMaterial{false};
+
+    /// \brief The SDF material, valid when hasMaterial is set.
+    sdf::Material material;
+
+    /// \brief Transparency of the visual.
+    double transparency{0.0};
+
+    /// \brief Whether the visual casts shadows.
+    bool castShadows{true};
+
+    /// \brief Visibility flags of the visual.
+    uint32_t visibilityFlags{0};
+  };
+
+  /// \brief Geometry and material record per visual, for static batching.
+  public: std::map<Entity, BatchGeomInfo> batchGeomInfo;
+
+  /// \brief Visuals marked as never moving via MarkStatic.
+  public: std::unordered_set<Entity> staticVisuals;
+
+  /// \brief One merged static mesh and the visuals folded into it.
+  public: struct StaticBatch
+  {
+    /// \brief Merged mesh, kept alive while the batch visual uses it.
+    std::unique_ptr<common::Mesh> mesh;
+
+    /// \brief Visual drawing the merged mesh.
+    rendering::VisualPtr visual;
+
+    /// \brief Entities whose visuals are hidden behind the batch.
+    std::vector<Entity> sources;
+  };
+
+  /// \brief Merged batches currently in the scene.
+  public: std::vector<StaticBatch> staticBatches;
+
+  /// \brief True when the set of batchable visuals changed and the
+  /// batches must be rebuilt.
+  public: bool staticBatchesDirty{false};
+
+  /// \brief Serial number for unique batch mesh and visual names.
+  public: unsigned int staticBatchCounter{0};
 };
 
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Interpolate a uniformly sampled pose table.
+/// \param[in] _samples Poses at multiples of _step seconds.
+/// \param[in] _step Seconds between consecutive samples.
+/// \param[in] _t Query time in seconds, clamped into the table.
+/// \return Pose with linearly interpolated translation and spherically
+/// interpolated rotation.
+math::Pose3d SamplePoseTable(const std::vector<math::Pose3d> &_samples,
+    double _step, double _t)
+{
+  if (_samples.empty())
+    return math::Pose3d::Zero;
+
+  const double pos = std::max(0.0, _t / _step);
+  const std::size_t i0 = std::min(static_cast<std::size_t>(pos),
+      _samples.size() - 1);
+  const std::size_t i1 = std::min(i0 + 1, _samples.size() - 1);
+  const double frac = std::min(1.0, pos - static_cast<double>(i0));
+
+  math::Pose3d out;
+  out.Pos() = _samples[i0].Pos() +
+      (_samples[i1].Pos() - _samples[i0].Pos()) * frac;
+  out.Rot() = math::Quaterniond::Slerp(frac, _samples[i0].Rot(),
+      _samples[i1].Rot(), true);
+  return out;
+}
+
+/////////////////////////////////////////////////
+/// \brief Interpolate a uniformly sampled scalar table.
+/// \param[in] _samples Values at multiples of _step seconds.
+/// \param[in] _step Spacing between consecutive samples.
+/// \param[in] _t Query position, clamped into the table.
+/// \return Linearly interpolated value.
+double SampleScalarTable(const std::vector<double> &_samples,
+    double _step, double _t)
+{
+  if (_samples.empty())
+    return 0.0;
+
+  const double pos = std::max(0.0, _t / _step);
+  const std::size_t i0 = std::min(static_cast<std::size_t>(pos),
+      _samples.size() - 1);
+  const std::size_t i1 = std::min(i0 + 1, _samples.size() - 1);
+  const double frac = std::min(1.0, pos - static_cast<double>(i0));
+
+  return _samples[i0] + (_samples[i1] - _samples[i0]) * frac;
+}
+
+/// \brief Rate at which the actor tables are sampled. Actor keyframes are
+/// authored at or below this rate, so interpolating between samples stays
+/// within the source animation's own resolution.
+const double kActorSampleStep = 1.0 / 30.0;
+
+/////////////////////////////////////////////////
+/// \brief Signature of the material a visual renders with. Visuals that
+/// share a signature look identical and can be drawn by one merged mesh.
+/// \param[in] _info The visual's recorded geometry and material info.
+/// \return Signature string usable as a grouping key.
+std::string MaterialSignature(
+    const ignition::gazebo::SceneManagerPrivate::BatchGeomInfo &_info)
+{
+  std::ostringstream sig;
+  if (!_info.hasMaterial)
+  {
+    sig << "default";
+  }
+  else
+  {
+    sig << _info.material.Ambient() << "|" << _info.material.Diffuse()
+        << "|" << _info.material.Specular() << "|"
+        << _info.material.Emissive();
+    const sdf::Pbr *pbr = _info.material.PbrMaterial();
+    const sdf::PbrWorkflow *metal = pbr ?
+        pbr->Workflow(sdf::PbrWorkflowType::METAL) : nullptr;
+    if (metal)
+    {
+      sig << "|" << metal->Roughness() << "|" << metal->Metalness()
+          << "|" << metal->AlbedoMap() << "|" << metal->NormalMap()
+          << "|" << metal->RoughnessMap() << "|" << metal->MetalnessMap();
+    }
+  }
+  sig << "|" << _info.transparency << "|" << _info.castShadows
+      << "|" << _info.visibilityFlags;
+  return sig.str();
+}
+}
+
 
 /////////////////////////////////////////////////
 SceneManager::SceneManager()
@@ -244,6 +690,39 @@ rendering::VisualPtr SceneManager::CreateVisual(Entity _id,
       _visual.Name();
   if (parent)
     name = parent->Name() + "::" + name;
+
+  // Meshes parse on the shared cache's loader thread so a detailed model
+  // spawned mid-run doesn't stall rendering. Until the mesh is ready the
+  // visual is a placeholder box at the mesh scale; UpdatePendingMeshes
+  // swaps in the real visual. Meshes already parsed, by this scene or any
+  // other in the process, take the synchronous path below.
+  std::string meshFullPath;
+  if (_visual.Geom()->Type() == sdf::GeometryType::MESH)
+  {
+    meshFullPath = asFullPath(_visual.Geom()->MeshShape()->Uri(),
+        _visual.Geom()->MeshShape()->FilePath());
+    if (!meshFullPath.empty() &&
+        !common::MeshManager::Instance()->HasMesh(meshFullPath))
+    {
+      MeshCache::Instance().Queue(meshFullPath);
+      this->dataPtr->pendingMeshVisuals.push_back(
+          {_id, _visual, _parentId, meshFullPath});
+
+      rendering::VisualPtr placeholder =
+          this->dataPtr->scene->CreateVisual(name);
+      placeholder->SetUserData("gazebo-entity", static_cast<int>(_id));
+      placeholder->SetUserData("pause-update", static_cast<int>(0));
+      placeholder->SetLocalPose(_visual.RawPose());
+      placeholder->AddGeometry(this->dataPtr->scene->CreateBox());
+      placeholder->SetLocalScale(_visual.Geom()->MeshShape()->Scale());
+      placeholder->SetVisibilityFlags(_visual.VisibilityFlags());
+      this->dataPtr->visuals[_id] = placeholder;
+      if (parent)
+        parent->AddChild(placeholder);
+      return placeholder;
+    }
+  }
+
   rendering::VisualPtr visualVis = this->dataPtr->scene->CreateVisual(name);
   visualVis->SetUserData("gazebo-entity", static_cast<int>(_id));
   visualVis->SetUserData("pause-update", static_cast<int>(0));
@@ -272,6 +751,93 @@ rendering::VisualPtr SceneManager::CreateVisual(Entity _id,
     visualVis->AddGeometry(geom);
     visualVis->SetLocalScale(scale);
 
+    if (!meshFullPath.empty())
+    {
+      // Count this visual against the shared cache so the parsed mesh can
+      // be evicted once the last user in the process is gone.
+      MeshCache::Instance().Retain(meshFullPath);
+      this->dataPtr->visualMeshNames[_id] = meshFullPath;
+    }
+
+    // Optional far meshes, declared as namespaced custom elements so
+    // libsdformat preserves them:
+    //   <ignition:lod><distance>100</distance><uri>far.dae</uri></ignition:lod>
+    // Levels switch by distance to the nearest sensor in UpdateLods. An
+    // entry without a <uri> hides the visual beyond its distance.
+    if (_visual.Element() && _visual.Element()->HasElement("ignition:lod"))
+    {
+      SceneManagerPrivate::VisualLods lods;
+      lods.levels.push_back({0.0, geom});
+      for (auto lodElem = _visual.Element()->GetElement("ignition:lod");
+           lodElem; lodElem = lodElem->GetNextElement("ignition:lod"))
+      {
+        double lodDistance = lodElem->Get<double>("distance", 0.0).first;
+        rendering::GeometryPtr lodGeom;
+        if (lodElem->HasElement("uri"))
+        {
+          auto lodPath = asFullPath(lodElem->Get<std::string>("uri"),
+              lodElem->FilePath());
+          rendering::MeshDescriptor lodDescriptor;
+          lodDescriptor.meshName = lodPath;
+          lodGeom = this->dataPtr->scene->CreateMesh(lodDescriptor);
+          if (!lodGeom)
+          {
+            ignerr << "Failed to load LOD mesh [" << lodPath
+                   << "] for visual [" << name << "]" << std::endl;
+            continue;
+          }
+        }
+        lods.levels.push_back({lodDistance, lodGeom});
+      }
+
+      if (lods.levels.size() > 1)
+      {
+        std::sort(lods.levels.begin(), lods.levels.end(),
+            [](const SceneManagerPrivate::LodLevel &_a,
+               const SceneManagerPrivate::LodLevel &_b)
+            { return _a.distance < _b.distance; });
+        this->dataPtr->visualLods[_id] = std::move(lods);
+      }
+    }
+
+    // Record what static batching would need to bake this visual into a
+    // merged mesh. Primitives map to the mesh manager's unit meshes,
+    // which are the meshes the render engine instanced for them.
+    {
+      SceneManagerPrivate::BatchGeomInfo batchInfo;
+      batchInfo.primitive = true;
+      if (_visual.Geom()->Type() == sdf::GeometryType::BOX)
+        batchInfo.meshName = "unit_box";
+      else if (_visual.Geom()->Type() == sdf::GeometryType::CYLINDER)
+        batchInfo.meshName = "unit_cylinder";
+      else if (_visual.Geom()->Type() == sdf::GeometryType::PLANE)
+        batchInfo.meshName = "unit_plane";
+      else if (_visual.Geom()->Type() == sdf::GeometryType::SPHERE)
+        batchInfo.meshName = "unit_sphere";
+      else if (_visual.Geom()->Type() == sdf::GeometryType::MESH &&
+          !_visual.Geom()->MeshShape()->CenterSubmesh())
+      {
+        // Centered submeshes are recentred by the loader, so the source
+        // mesh no longer matches what is rendered; leave those unbatched.
+        batchInfo.meshName = meshFullPath;
+        batchInfo.submeshName = _visual.Geom()->MeshShape()->Submesh();
+        batchInfo.primitive = false;
+      }
+
+      if (!batchInfo.meshName.empty())
+      {
+        if (_visual.Material())
+        {
+          batchInfo.hasMaterial = true;
+          batchInfo.material = *_visual.Material();
+        }
+        batchInfo.transparency = _visual.Transparency();
+        batchInfo.castShadows = _visual.CastShadows();
+        batchInfo.visibilityFlags = _visual.VisibilityFlags();
+        this->dataPtr->batchGeomInfo[_id] = std::move(batchInfo);
+      }
+    }
+
     // set material
     rendering::MaterialPtr material{nullptr};
     if (_visual.Material())
@@ -346,6 +912,299 @@ rendering::VisualPtr SceneManager::CreateVisual(Entity _id,
   return visualVis;
 }
 
+/////////////////////////////////////////////////
+void SceneManager::UpdatePendingMeshes()
+{
+  if (this->dataPtr->pendingMeshVisuals.empty())
+    return;
+
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  std::vector<SceneManagerPrivate::PendingMeshVisual> stillPending;
+  for (auto &pending : this->dataPtr->pendingMeshVisuals)
+  {
+    // Keep the placeholder box for meshes that could not be parsed; the
+    // loader already reported the error.
+    if (MeshCache::Instance().Failed(pending.meshName))
+      continue;
+
+    if (!meshManager->HasMesh(pending.meshName))
+    {
+      stillPending.push_back(pending);
+      continue;
+    }
+
+    // The entity may have been removed while the mesh was parsing.
+    auto it = this->dataPtr->visuals.find(pending.id);
+    if (it == this->dataPtr->visuals.end())
+      continue;
+
+    // Swap the placeholder for the real visual by replaying the creation,
+    // which now takes the synchronous path.
+    this->dataPtr->scene->DestroyVisual(it->second);
+    this->dataPtr->visuals.erase(it);
+    this->CreateVisual(pending.id, pending.visual, pending.parentId);
+
+    // The real visual may be batchable now that its mesh is parsed.
+    if (this->dataPtr->staticVisuals.find(pending.id) !=
+        this->dataPtr->staticVisuals.end())
+    {
+      this->dataPtr->staticBatchesDirty = true;
+    }
+  }
+  this->dataPtr->pendingMeshVisuals = std::move(stillPending);
+}
+
+/////////////////////////////////////////////////
+void SceneManager::UpdateLods()
+{
+  if (this->dataPtr->visualLods.empty())
+    return;
+
+  // Levels switch against the nearest sensor, so every sensor sees its
+  // own level of detail or better.
+  std::vector<math::Vector3d> viewPositions;
+  for (unsigned int i = 0; i < this->dataPtr->scene->SensorCount(); ++i)
+  {
+    auto sensor = this->dataPtr->scene->SensorByIndex(i);
+    if (sensor)
+      viewPositions.push_back(sensor->WorldPosition());
+  }
+  if (viewPositions.empty())
+    return;
+
+  for (auto &lodIt : this->dataPtr->visualLods)
+  {
+    auto visIt = this->dataPtr->visuals.find(lodIt.first);
+    if (visIt == this->dataPtr->visuals.end())
+      continue;
+    auto visual = visIt->second;
+
+    double distSq = std::numeric_limits<double>::max();
+    for (const auto &viewPos : viewPositions)
+    {
+      distSq = std::min(distSq,
+          (visual->WorldPosition() - viewPos).SquaredLength());
+    }
+
+    auto &lods = lodIt.second;
+    size_t level = 0;
+    for (size_t i = 0; i < lods.levels.size(); ++i)
+    {
+      if (distSq >= lods.levels[i].distance * lods.levels[i].distance)
+        level = i;
+    }
+
+    if (level == lods.activeLevel)
+      continue;
+
+    // Geometries stay loaded; switching levels is only a scene graph
+    // attach/detach.
+    auto &current = lods.levels[lods.activeLevel];
+    auto &next = lods.levels[level];
+    if (current.geometry)
+      visual->RemoveGeometry(current.geometry);
+    if (next.geometry)
+      visual->AddGeometry(next.geometry);
+    lods.activeLevel = level;
+  }
+}
+
+/////////////////////////////////////////////////
+void SceneManager::SetVisibilityFlags(Entity _id, uint32_t _flags)
+{
+  auto it = this->dataPtr->visuals.find(_id);
+  if (it == this->dataPtr->visuals.end())
+    return;
+
+  it->second->SetVisibilityFlags(_flags);
+
+  auto infoIt = this->dataPtr->batchGeomInfo.find(_id);
+  if (infoIt != this->dataPtr->batchGeomInfo.end() &&
+      infoIt->second.visibilityFlags != _flags)
+  {
+    infoIt->second.visibilityFlags = _flags;
+
+    // Visibility flags are part of the batch signature, so a batched
+    // visual has to move to the batch matching its new flags.
+    if (this->dataPtr->staticVisuals.find(_id) !=
+        this->dataPtr->staticVisuals.end())
+    {
+      this->dataPtr->staticBatchesDirty = true;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void SceneManager::MarkStatic(Entity _id)
+{
+  if (this->dataPtr->staticVisuals.insert(_id).second)
+    this->dataPtr->staticBatchesDirty = true;
+}
+
+/////////////////////////////////////////////////
+void SceneManager::UpdateStaticBatches()
+{
+  if (!this->dataPtr->staticBatchesDirty)
+    return;
+  this->dataPtr->staticBatchesDirty = false;
+
+  // Tear down the previous batches. Source visuals still in the scene
+  // are shown again and repartitioned below.
+  for (auto &batch : this->dataPtr->staticBatches)
+  {
+    if (batch.visual)
+      this->dataPtr->scene->DestroyVisual(batch.visual);
+    for (const auto &source : batch.sources)
+    {
+      auto it = this->dataPtr->visuals.find(source);
+      if (it != this->dataPtr->visuals.end())
+        it->second->SetVisible(true);
+    }
+  }
+  this->dataPtr->staticBatches.clear();
+
+  // Partition the batchable visuals by material signature. Visuals that
+  // render identically end up in the same group and thus the same draw
+  // call.
+  std::map<std::string, std::vector<Entity>> groups;
+  for (const auto &id : this->dataPtr->staticVisuals)
+  {
+    auto infoIt = this->dataPtr->batchGeomInfo.find(id);
+    if (infoIt == this->dataPtr->batchGeomInfo.end())
+      continue;
+    if (this->dataPtr->visuals.find(id) == this->dataPtr->visuals.end())
+      continue;
+
+    // Visuals with levels of detail swap geometries at runtime.
+    if (this->dataPtr->visualLods.find(id) != this->dataPtr->visualLods.end())
+      continue;
+
+    // Meshes without an explicit SDF material keep their own per-submesh
+    // materials and cannot be drawn with a single-material batch.
+    const auto &info = infoIt->second;
+    if (!info.primitive && !info.hasMaterial)
+      continue;
+
+    groups[MaterialSignature(info)].push_back(id);
+  }
+
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  for (auto &group : groups)
+  {
+    if (group.second.size() < 2)
+      continue;
+
+    // Bake each source's world transform into one triangle submesh.
+    common::SubMesh sub;
+    std::vector<Entity> merged;
+    for (const auto &id : group.second)
+    {
+      const auto &info = this->dataPtr->batchGeomInfo[id];
+      const common::Mesh *mesh = meshManager->MeshByName(info.meshName);
+      if (nullptr == mesh)
+        continue;
+
+      auto vis = this->dataPtr->visuals[id];
+      const math::Pose3d pose = vis->WorldPose();
+      const math::Vector3d scale = vis->WorldScale();
+
+      bool appended = false;
+      for (unsigned int s = 0; s < mesh->SubMeshCount(); ++s)
+      {
+        auto sourceSub = mesh->SubMeshByIndex(s).lock();
+        if (!sourceSub)
+          continue;
+        if (!info.submeshName.empty() &&
+            sourceSub->Name() != info.submeshName)
+          continue;
+        if (sourceSub->SubMeshPrimitiveType() != common::SubMesh::TRIANGLES)
+          continue;
+
+        const unsigned int offset = sub.VertexCount();
+        for (unsigned int v = 0; v < sourceSub->VertexCount(); ++v)
+        {
+          sub.AddVertex(pose.Pos() +
+              pose.Rot() * (scale * sourceSub->Vertex(v)));
+          if (v < sourceSub->NormalCount())
+            sub.AddNormal((pose.Rot() * sourceSub->Normal(v)).Normalized());
+          if (v < sourceSub->TexCoordCount())
+            sub.AddTexCoord(sourceSub->TexCoord(v));
+        }
+        for (unsigned int i = 0; i < sourceSub->IndexCount(); ++i)
+          sub.AddIndex(offset + sourceSub->Index(i));
+        appended = true;
+      }
+      if (appended)
+        merged.push_back(id);
+    }
+
+    if (merged.size() < 2)
+      continue;
+
+    SceneManagerPrivate::StaticBatch batch;
+    batch.mesh = std::make_unique<common::Mesh>();
+    batch.mesh->SetName("static_batch_" +
+        std::to_string(this->dataPtr->staticBatchCounter++));
+    batch.mesh->AddSubMesh(sub);
+
+    rendering::MeshDescriptor descriptor;
+    descriptor.meshName = batch.mesh->Name();
+    descriptor.mesh = batch.mesh.get();
+    auto geom = this->dataPtr->scene->CreateMesh(descriptor);
+    if (!geom)
+    {
+      ignerr << "Failed to create merged static mesh ["
+             << batch.mesh->Name() << "]" << std::endl;
+      continue;
+    }
+
+    batch.visual = this->dataPtr->scene->CreateVisual(batch.mesh->Name());
+    batch.visual->SetUserData("gazebo-entity", static_cast<int>(0));
+    batch.visual->SetUserData("pause-update", static_cast<int>(0));
+    batch.visual->AddGeometry(geom);
+
+    // All sources in a group share a material signature, so the first
+    // one's material stands for the batch.
+    const auto &info = this->dataPtr->batchGeomInfo[merged.front()];
+    rendering::MaterialPtr material{nullptr};
+    if (info.hasMaterial)
+    {
+      material = this->LoadMaterial(info.material);
+    }
+    else
+    {
+      // Default material of primitives, as in CreateVisual
+      material = this->dataPtr->scene->Material("ign-grey");
+      if (!material)
+      {
+        material = this->dataPtr->scene->CreateMaterial("ign-grey");
+        material->SetAmbient(0.3, 0.3, 0.3);
+        material->SetDiffuse(0.7, 0.7, 0.7);
+        material->SetSpecular(1.0, 1.0, 1.0);
+        material->SetRoughness(0.2);
+        material->SetMetalness(1.0);
+      }
+    }
+    if (material)
+    {
+      material->SetTransparency(info.transparency);
+      material->SetCastShadows(info.castShadows);
+      geom->SetMaterial(material);
+      // todo(anyone) SetMaterial function clones the input material.
+      // but does not take ownership of it so we need to destroy it here.
+      this->dataPtr->scene->DestroyMaterial(material);
+    }
+    batch.visual->SetVisibilityFlags(info.visibilityFlags);
+    this->dataPtr->scene->RootVisual()->AddChild(batch.visual);
+
+    for (const auto &id : merged)
+      this->dataPtr->visuals[id]->SetVisible(false);
+
+    batch.sources = std::move(merged);
+    this->dataPtr->staticBatches.push_back(std::move(batch));
+  }
+}
+
 /////////////////////////////////////////////////
 rendering::GeometryPtr SceneManager::LoadGeometry(const sdf::Geometry &_geom,
     math::Vector3d &_scale, math::Pose3d &_localPose)
@@ -795,6 +1654,10 @@ rendering::VisualPtr SceneManager::CreateActor(Entity _id,
 
   this->dataPtr->actorTrajectories[_id] = trajectories;
 
+  // Precompute sampled waypoint and root motion tables so the per-frame
+  // animation update is a table lookup instead of keyframe interpolation.
+  this->dataPtr->BuildActorSampleTables(_id);
+
   // create mesh with animations
   rendering::MeshPtr actorMesh = this->dataPtr->scene->CreateMesh(
       descriptor);
@@ -1020,7 +1883,31 @@ AnimationUpdateData SceneManager::ActorAnimationAt(
   animData.animationName = skel->Animation(animIndex)->Name();
 
   std::string rootNodeName = skel->RootNode()->Name();
-  double distance = animData.trajectory.DistanceSoFar(animData.time);
+
+  // Sampled tables precomputed at load. When present, the root motion
+  // below is a table lookup instead of a keyframe scan.
+  const SceneManagerPrivate::RootNodeSamples *rootTable = nullptr;
+  auto rootIt = this->dataPtr->actorRootNodeSamples.find(_id);
+  if (rootIt != this->dataPtr->actorRootNodeSamples.end() &&
+      animIndex < rootIt->second.size() &&
+      !rootIt->second[animIndex].frames.empty())
+  {
+    rootTable = &rootIt->second[animIndex];
+  }
+  const SceneManagerPrivate::TrajectorySamples *trajTable =
+      this->dataPtr->TrajectorySamplesFor(_id, animData.trajectory);
+
+  double distance;
+  if (nullptr != trajTable)
+  {
+    distance = SampleScalarTable(trajTable->distances, trajTable->step,
+        std::chrono::duration<double>(animData.time).count());
+  }
+  else
+  {
+    distance = animData.trajectory.DistanceSoFar(animData.time);
+  }
+
   if (animData.followTrajectory)
   {
     math::Matrix4d rawFrame;
@@ -1032,37 +1919,72 @@ AnimationUpdateData SceneManager::ActorAnimationAt(
       // We should consider refactoring part of that function to return
       // PoseAtX for only one skeleton node in addition to the current
       // function that computes PoseAtX for all skeleton nodes
-      common::NodeAnimation *rootNode =
-          skel->Animation(animIndex)->NodeAnimationByName(rootNodeName);
-      math::Matrix4d lastPos = rootNode->KeyFrame(
-          rootNode->FrameCount() - 1).second;
-      math::Matrix4d firstPos = rootNode->KeyFrame(0).second;
-      double x = distance;
-      if (x < firstPos.Translation().X())
-        x = firstPos.Translation().X();
-      double lastX = lastPos.Translation().X();
-      if (x > lastX && !animData.loop)
-        x = lastX;
-      while (x > lastX)
-        x -= lastX;
-
-      // update animation timepoint for root node
-      // this should be the time that is used in the
-      // SkeletonAnimationEnabled call
-      double time = rootNode->TimeAtX(x);
-
-      // get raw skeleton transform for root node. Needed to keep skeleton
-      // animation in sync with trajectory animation
-      rawFrame = rootNode->FrameAt(time, animData.loop);
-      animData.time = std::chrono::duration_cast<
-        std::chrono::steady_clock::duration>(
-        std::chrono::duration<double>(time));
+      if (nullptr != rootTable && !rootTable->timeAtX.empty())
+      {
+        double x = distance;
+        if (x < rootTable->firstX)
+          x = rootTable->firstX;
+        double lastX = rootTable->lastX;
+        if (x > lastX && !animData.loop)
+          x = lastX;
+        while (x > lastX)
+          x -= lastX;
+
+        const double xStep = (rootTable->lastX - rootTable->firstX) /
+            static_cast<double>(rootTable->timeAtX.size() - 1);
+        double time = SampleScalarTable(rootTable->timeAtX, xStep,
+            x - rootTable->firstX);
+
+        rawFrame = math::Matrix4d(SamplePoseTable(rootTable->frames,
+            rootTable->step, time));
+        animData.time = std::chrono::duration_cast<
+          std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(time));
+      }
+      else
+      {
+        common::NodeAnimation *rootNode =
+            skel->Animation(animIndex)->NodeAnimationByName(rootNodeName);
+        math::Matrix4d lastPos = rootNode->KeyFrame(
+            rootNode->FrameCount() - 1).second;
+        math::Matrix4d firstPos = rootNode->KeyFrame(0).second;
+        double x = distance;
+        if (x < firstPos.Translation().X())
+          x = firstPos.Translation().X();
+        double lastX = lastPos.Translation().X();
+        if (x > lastX && !animData.loop)
+          x = lastX;
+        while (x > lastX)
+          x -= lastX;
+
+        // update animation timepoint for root node
+        // this should be the time that is used in the
+        // SkeletonAnimationEnabled call
+        double time = rootNode->TimeAtX(x);
+
+        // get raw skeleton transform for root node. Needed to keep
+        // skeleton animation in sync with trajectory animation
+        rawFrame = rootNode->FrameAt(time, animData.loop);
+        animData.time = std::chrono::duration_cast<
+          std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(time));
+      }
     }
     else
     {
       double timeSeconds = std::chrono::duration<double>(animData.time).count();
-      rawFrame = skel->Animation(animIndex)->NodePoseAt(
-          rootNodeName, timeSeconds, animData.loop);
+      if (nullptr != rootTable)
+      {
+        if (animData.loop && rootTable->length > 0.0)
+          timeSeconds = std::fmod(timeSeconds, rootTable->length);
+        rawFrame = math::Matrix4d(SamplePoseTable(rootTable->frames,
+            rootTable->step, timeSeconds));
+      }
+      else
+      {
+        rawFrame = skel->Animation(animIndex)->NodePoseAt(
+            rootNodeName, timeSeconds, animData.loop);
+      }
     }
 
     math::Matrix4d skinTf = skel->AlignTranslation(animIndex, rootNodeName)
@@ -1103,54 +2025,58 @@ std::map<std::string, math::Matrix4d> SceneManager::ActorSkeletonTransformsAt(
   common::TrajectoryInfo traj = animData.trajectory;
   auto time = animData.time;
 
-  common::PoseKeyFrame poseFrame(0.0);
+  // Sampled waypoint table precomputed at load, when available.
+  const SceneManagerPrivate::TrajectorySamples *trajTable =
+      this->dataPtr->TrajectorySamplesFor(_id, traj);
+
+  math::Matrix4d rootTf(math::Quaterniond::Identity);
   if (followTraj)
-    traj.Waypoints()->InterpolatedKeyFrame(poseFrame);
-  math::Matrix4d rootTf(poseFrame.Rotation());
-  rootTf.SetTranslation(poseFrame.Translation());
+  {
+    if (nullptr != trajTable)
+    {
+      rootTf = math::Matrix4d(SamplePoseTable(trajTable->poses,
+          trajTable->step, std::chrono::duration<double>(time).count()));
+    }
+    else
+    {
+      common::PoseKeyFrame poseFrame(0.0);
+      traj.Waypoints()->InterpolatedKeyFrame(poseFrame);
+      rootTf = math::Matrix4d(poseFrame.Rotation());
+      rootTf.SetTranslation(poseFrame.Translation());
+    }
+  }
 
   auto vIt = this->dataPtr->actorSkeletons.find(_id);
   if (vIt != this->dataPtr->actorSkeletons.end())
   {
     auto skel = vIt->second;
     unsigned int animIndex = traj.AnimIndex();
-    std::map<std::string, math::Matrix4d> rawFrames;
 
     double timeSeconds = std::chrono::duration<double>(time).count();
 
+    bool interpolateX = false;
+    double distance = 0.0;
     if (followTraj)
     {
-      double distance = traj.DistanceSoFar(time);
-      // check interpolate x.
-      // todo(anyone) there is a problem with PoseAtX that causes
-      // it to go into an infinite loop if the animation has no x displacement
-      // e.g. a person standing that does not move in x direction
-      if (traj.Waypoints()->InterpolateX() && !math::equal(distance, 0.0))
+      if (nullptr != trajTable)
       {
-        rawFrames = skel->Animation(animIndex)->PoseAtX(distance,
-                                        skel->RootNode()->Name());
+        distance = SampleScalarTable(trajTable->distances, trajTable->step,
+            timeSeconds);
       }
       else
       {
-        rawFrames = skel->Animation(animIndex)->PoseAt(timeSeconds, !noLoop);
+        distance = traj.DistanceSoFar(time);
       }
-    }
-    else
-    {
-      rawFrames = skel->Animation(animIndex)->PoseAt(timeSeconds, !noLoop);
+      // check interpolate x.
+      // todo(anyone) there is a problem with PoseAtX that causes
+      // it to go into an infinite loop if the animation has no x displacement
+      // e.g. a person standing that does not move in x direction
+      interpolateX =
+          traj.Waypoints()->InterpolateX() && !math::equal(distance, 0.0);
     }
 
-    for (auto pair : rawFrames)
-    {
-      std::string nodeName = pair.first;
-      auto nodeTf = pair.second;
-
-      std::string skinName = skel->NodeNameAnimToSkin(animIndex, nodeName);
-      math::Matrix4d skinTf = skel->AlignTranslation(animIndex, nodeName)
-              * nodeTf * skel->AlignRotation(animIndex, nodeName);
-
-      allFrames[skinName] = skinTf;
-    }
+    allFrames = this->dataPtr->SkeletonFramesAt(skel, animIndex,
+        timeSeconds, distance, interpolateX, noLoop);
   }
 
   // correct animation root pose
@@ -1171,6 +2097,73 @@ std::map<std::string, math::Matrix4d> SceneManager::ActorSkeletonTransformsAt(
   return allFrames;
 }
 
+/////////////////////////////////////////////////
+std::map<std::string, math::Matrix4d> SceneManagerPrivate::SkeletonFramesAt(
+    const common::SkeletonPtr &_skel, unsigned int _animIndex,
+    double _timeSeconds, double _distance, bool _interpolateX,
+    bool _noLoop) const
+{
+  std::map<std::string, math::Matrix4d> rawFrames;
+  std::string cacheKey;
+
+  if (_interpolateX)
+  {
+    // distance along the trajectory is unique to each actor and grows
+    // without bound, so these evaluations are not cached
+    rawFrames = _skel->Animation(_animIndex)->PoseAtX(_distance,
+        _skel->RootNode()->Name());
+  }
+  else
+  {
+    double sampleTime = _timeSeconds;
+    double length = _skel->Animation(_animIndex)->Length();
+    if (!_noLoop && length > 0.0)
+      sampleTime = std::fmod(sampleTime, length);
+
+    // quantize to the same grid the actor trajectory tables use so
+    // actors sharing a skin share cache entries
+    const long sample = std::lround(sampleTime / kActorSampleStep);
+    sampleTime = sample * kActorSampleStep;
+
+    std::ostringstream key;
+    key << _skel.get() << ':' << _animIndex << ':' << _noLoop << ':'
+        << sample;
+    cacheKey = key.str();
+
+    {
+      std::lock_guard<std::mutex> lock(this->skeletonFrameMutex);
+      auto it = this->skeletonFrameCache.find(cacheKey);
+      if (it != this->skeletonFrameCache.end())
+        return it->second;
+    }
+
+    rawFrames = _skel->Animation(_animIndex)->PoseAt(sampleTime, !_noLoop);
+  }
+
+  std::map<std::string, math::Matrix4d> frames;
+  for (auto pair : rawFrames)
+  {
+    std::string nodeName = pair.first;
+    auto nodeTf = pair.second;
+
+    std::string skinName = _skel->NodeNameAnimToSkin(_animIndex, nodeName);
+    math::Matrix4d skinTf = _skel->AlignTranslation(_animIndex, nodeName)
+            * nodeTf * _skel->AlignRotation(_animIndex, nodeName);
+
+    frames[skinName] = skinTf;
+  }
+
+  if (cacheKey.empty())
+    return frames;
+
+  static constexpr std::size_t kSkeletonFrameCacheMax{4096};
+  std::lock_guard<std::mutex> lock(this->skeletonFrameMutex);
+  if (this->skeletonFrameCache.size() >= kSkeletonFrameCacheMax)
+    this->skeletonFrameCache.clear();
+  return this->skeletonFrameCache.emplace(
+      cacheKey, std::move(frames)).first->second;
+}
+
 /////////////////////////////////////////////////
 void SceneManager::RemoveEntity(Entity _id)
 {
@@ -1178,6 +2171,18 @@ void SceneManager::RemoveEntity(Entity _id)
     auto it = this->dataPtr->visuals.find(_id);
     if (it != this->dataPtr->visuals.end())
     {
+      auto meshIt = this->dataPtr->visualMeshNames.find(_id);
+      if (meshIt != this->dataPtr->visualMeshNames.end())
+      {
+        MeshCache::Instance().Release(meshIt->second);
+        this->dataPtr->visualMeshNames.erase(meshIt);
+      }
+      this->dataPtr->visualLods.erase(_id);
+      this->dataPtr->batchGeomInfo.erase(_id);
+      // A batch that folded this visual in has stale geometry now; the
+      // next UpdateStaticBatches call rebuilds it from the survivors.
+      if (this->dataPtr->staticVisuals.erase(_id) > 0)
+        this->dataPtr->staticBatchesDirty = true;
       this->dataPtr->scene->DestroyVisual(it->second);
       this->dataPtr->visuals.erase(it);
       return;
@@ -1280,7 +2285,9 @@ AnimationUpdateData SceneManagerPrivate::ActorTrajectoryAt(
   if (trajIt == this->actorTrajectories.end())
     return animData;
 
-  auto trajs = trajIt->second;
+  // Reference, not copy: copying a trajectory deep-copies its waypoint
+  // animation, which is far too expensive for a per-frame call.
+  const auto &trajs = trajIt->second;
   bool followTraj = true;
   if (1 == trajs.size() && nullptr == trajs[0].Waypoints())
     followTraj = false;
@@ -1316,7 +2323,7 @@ AnimationUpdateData SceneManagerPrivate::ActorTrajectoryAt(
     }
     if (followTraj)
     {
-      for (auto &trajectory : trajs)
+      for (const auto &trajectory : trajs)
       {
         if (trajectory.StartTime() - firstTraj->StartTime() <= time
             && trajectory.EndTime() - firstTraj->StartTime() >= time)
@@ -1339,3 +2346,118 @@ AnimationUpdateData SceneManagerPrivate::ActorTrajectoryAt(
   animData.valid = true;
   return animData;
 }
+
+/////////////////////////////////////////////////
+void SceneManagerPrivate::BuildActorSampleTables(Entity _id)
+{
+  auto trajIt = this->actorTrajectories.find(_id);
+  auto skelIt = this->actorSkeletons.find(_id);
+  if (trajIt == this->actorTrajectories.end() ||
+      skelIt == this->actorSkeletons.end())
+    return;
+
+  const double step = kActorSampleStep;
+
+  // Waypoint pose and distance-so-far tables, one per trajectory.
+  std::vector<TrajectorySamples> trajTables(trajIt->second.size());
+  for (std::size_t i = 0; i < trajIt->second.size(); ++i)
+  {
+    auto &traj = trajIt->second[i];
+    if (nullptr == traj.Waypoints())
+      continue;
+
+    auto &table = trajTables[i];
+    table.step = step;
+    const double duration =
+        std::chrono::duration<double>(traj.Duration()).count();
+    const std::size_t count = std::max<std::size_t>(2,
+        static_cast<std::size_t>(std::ceil(duration / step)) + 1);
+    table.poses.reserve(count);
+    table.distances.reserve(count);
+    for (std::size_t k = 0; k < count; ++k)
+    {
+      const double t = std::min(static_cast<double>(k) * step, duration);
+      traj.Waypoints()->Time(t);
+      common::PoseKeyFrame poseFrame(0.0);
+      traj.Waypoints()->InterpolatedKeyFrame(poseFrame);
+      table.poses.push_back(
+          math::Pose3d(poseFrame.Translation(), poseFrame.Rotation()));
+      table.distances.push_back(traj.DistanceSoFar(
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(t))));
+    }
+  }
+  this->actorTrajectorySamples[_id] = std::move(trajTables);
+
+  // Root node motion and time-at-x tables, one per animation. Only the
+  // root node is tabulated: the remaining bones are animated by the
+  // render engine, which keys them off the time looked up here.
+  auto skel = skelIt->second;
+  const std::string rootNodeName = skel->RootNode()->Name();
+  std::vector<RootNodeSamples> rootTables(skel->AnimationCount());
+  for (unsigned int i = 0; i < skel->AnimationCount(); ++i)
+  {
+    common::SkeletonAnimation *anim = skel->Animation(i);
+    common::NodeAnimation *rootNode =
+        anim->NodeAnimationByName(rootNodeName);
+    if (nullptr == rootNode || 0 == rootNode->FrameCount())
+      continue;
+
+    auto &table = rootTables[i];
+    table.step = step;
+    table.length = anim->Length();
+    const std::size_t count = std::max<std::size_t>(2,
+        static_cast<std::size_t>(std::ceil(table.length / step)) + 1);
+    table.frames.reserve(count);
+    for (std::size_t k = 0; k < count; ++k)
+    {
+      const double t = std::min(static_cast<double>(k) * step,
+          table.length);
+      table.frames.push_back(rootNode->FrameAt(t, true).Pose());
+    }
+
+    table.firstX = rootNode->KeyFrame(0).second.Translation().X();
+    table.lastX = rootNode->KeyFrame(
+        rootNode->FrameCount() - 1).second.Translation().X();
+    if (table.lastX > table.firstX)
+    {
+      const double xStep = (table.lastX - table.firstX) /
+          static_cast<double>(count - 1);
+      table.timeAtX.reserve(count);
+      for (std::size_t k = 0; k < count; ++k)
+      {
+        table.timeAtX.push_back(rootNode->TimeAtX(std::min(
+            table.firstX + static_cast<double>(k) * xStep, table.lastX)));
+      }
+    }
+  }
+  this->actorRootNodeSamples[_id] = std::move(rootTables);
+}
+
+/////////////////////////////////////////////////
+const SceneManagerPrivate::TrajectorySamples *
+SceneManagerPrivate::TrajectorySamplesFor(Entity _id,
+    const common::TrajectoryInfo &_traj) const
+{
+  auto tableIt = this->actorTrajectorySamples.find(_id);
+  auto trajIt = this->actorTrajectories.find(_id);
+  if (tableIt == this->actorTrajectorySamples.end() ||
+      trajIt == this->actorTrajectories.end())
+    return nullptr;
+
+  // ActorTrajectoryAt returns a copy of the trajectory, so match it back
+  // to its row by schedule: start and end times are unique per actor.
+  const auto &trajs = trajIt->second;
+  for (std::size_t i = 0;
+       i < trajs.size() && i < tableIt->second.size(); ++i)
+  {
+    if (trajs[i].StartTime() == _traj.StartTime() &&
+        trajs[i].EndTime() == _traj.EndTime())
+    {
+      const auto &table = tableIt->second[i];
+      return table.poses.empty() ? nullptr : &table;
+    }
+  }
+
+  return nullptr;
+}
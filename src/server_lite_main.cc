@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <ignition/common/Console.hh>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/ServerConfig.hh"
+
+//////////////////////////////////////////////////
+/// \brief Print usage information and exit.
+/// \param[in] _status Process exit status.
+static void Usage(int _status)
+{
+  std::cout
+    << "Minimal headless Ignition Gazebo server. Runs physics, logging\n"
+    << "and transport only; render-dependent systems are refused so the\n"
+    << "process never loads a render engine.\n\n"
+    << "Usage: ignition-gazebo-server-lite [options] <world.sdf>\n\n"
+    << "Options:\n"
+    << "  -i <iterations>  Number of iterations to run, 0 to run forever.\n"
+    << "  -z <hz>          Update rate in hertz.\n"
+    << "  --levels         Use the level system.\n"
+    << "  -v <level>       Verbosity level, defaults to 1.\n"
+    << "  -h               Print this help and exit.\n";
+  std::exit(_status);
+}
+
+//////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  std::string sdfFile;
+  uint64_t iterations{0};
+  double hz{-1.0};
+  bool levels{false};
+  int verbosity{1};
+
+  for (int i = 1; i < _argc; ++i)
+  {
+    if (0 == std::strcmp(_argv[i], "-h"))
+    {
+      Usage(0);
+    }
+    else if (0 == std::strcmp(_argv[i], "--levels"))
+    {
+      levels = true;
+    }
+    else if (0 == std::strcmp(_argv[i], "-i") && i + 1 < _argc)
+    {
+      iterations = std::strtoull(_argv[++i], nullptr, 10);
+    }
+    else if (0 == std::strcmp(_argv[i], "-z") && i + 1 < _argc)
+    {
+      hz = std::strtod(_argv[++i], nullptr);
+    }
+    else if (0 == std::strcmp(_argv[i], "-v") && i + 1 < _argc)
+    {
+      verbosity = std::atoi(_argv[++i]);
+    }
+    else if (sdfFile.empty() && _argv[i][0] != '-')
+    {
+      sdfFile = _argv[i];
+    }
+    else
+    {
+      std::cerr << "Unknown option [" << _argv[i] << "]\n\n";
+      Usage(1);
+    }
+  }
+
+  if (sdfFile.empty())
+  {
+    std::cerr << "Missing world file.\n\n";
+    Usage(1);
+  }
+
+  ignition::common::Console::SetVerbosity(verbosity);
+
+  ignmsg << "Ignition Gazebo Server Lite v" << IGNITION_GAZEBO_VERSION_FULL
+         << std::endl;
+
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(sdfFile);
+  serverConfig.SetRenderPluginsDisabled(true);
+
+  if (hz > 0.0)
+    serverConfig.SetUpdateRate(hz);
+
+  if (levels)
+  {
+    ignmsg << "Using the level system\n";
+    serverConfig.SetUseLevels(true);
+  }
+
+  ignition::gazebo::Server server(serverConfig);
+
+  // Run the server, blocking until the iterations are done or the
+  // process is interrupted.
+  server.Run(true, iterations, false);
+
+  igndbg << "Shutting down server-lite" << std::endl;
+  return 0;
+}
@@ -34,6 +34,7 @@
 #include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/World.hh"
+#include "ignition/gazebo/detail/SensorScheduler.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/Util.hh"
 
@@ -53,6 +54,13 @@ class ignition::gazebo::systems::AltimeterPrivate
   /// \brief Ign-sensors sensor factory for creating sensors
   public: sensors::SensorFactory sensorFactory;
 
+  /// \brief Wakes sensors at their due times. Altimeters publish at tens
+  /// of Hz, so steps in between skip the entity scan entirely.
+  public: detail::SensorScheduler scheduler;
+
+  /// \brief Scratch list of sensors popped from the scheduler.
+  public: std::vector<detail::SensorScheduler::Entry> dueSensors;
+
   /// \brief Create altimeter sensor
   /// \param[in] _ecm Mutable reference to ECM.
   public: void CreateAltimeterEntities(EntityComponentManager &_ecm);
@@ -97,17 +105,47 @@ void Altimeter::PostUpdate(const UpdateInfo &_info,
         << "s]. System may not work properly." << std::endl;
   }
 
-  // Only update and publish if not paused.
-  if (!_info.paused)
+  // Only do the entity scan and sensor updates when a sensor is due; the
+  // scheduler check is a single comparison per step.
+  if (!_info.paused && this->dataPtr->scheduler.AnyDue(_info.simTime))
   {
     this->dataPtr->UpdateAltimeters(_ecm);
 
+    // Update measurement time
+    auto time = math::durationToSecNsec(_info.simTime);
+    const common::Time measurementTime(time.first, time.second);
+
     for (auto &it : this->dataPtr->entitySensorMap)
     {
-      // Update measurement time
-      auto time = math::durationToSecNsec(_info.simTime);
       dynamic_cast<sensors::Sensor *>(it.second.get())->Update(
-          common::Time(time.first, time.second), false);
+          measurementTime, false);
+    }
+
+    // Reschedule the sensors that were due. Anchoring the next due time to
+    // the previous one keeps the wheel in step with the sensor's own
+    // update schedule.
+    this->dataPtr->dueSensors.clear();
+    this->dataPtr->scheduler.PopDue(_info.simTime, this->dataPtr->dueSensors);
+    for (const auto &due : this->dataPtr->dueSensors)
+    {
+      auto it = this->dataPtr->entitySensorMap.find(due.id);
+      if (it == this->dataPtr->entitySensorMap.end())
+        continue;
+
+      auto period = std::chrono::steady_clock::duration::zero();
+      const double rate = it->second->UpdateRate();
+      if (rate > 0)
+      {
+        period = std::chrono::duration_cast<
+            std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / rate));
+      }
+
+      // An unthrottled sensor, or one woken late, is due again right away.
+      auto next = due.due + period;
+      if (next <= _info.simTime)
+        next = _info.simTime;
+      this->dataPtr->scheduler.Schedule(due.id, next);
     }
   }
 
@@ -153,6 +191,10 @@ void AltimeterPrivate::CreateAltimeterEntities(EntityComponentManager &_ecm)
         this->entitySensorMap.insert(
             std::make_pair(_entity, std::move(sensor)));
 
+        // Due immediately; the sensor's update rate takes over from there.
+        this->scheduler.Schedule(_entity,
+            std::chrono::steady_clock::duration::zero());
+
         return true;
       });
 }
@@ -204,6 +246,7 @@ void AltimeterPrivate::RemoveAltimeterEntities(
         }
 
         this->entitySensorMap.erase(sensorId);
+        this->scheduler.Remove(_entity);
 
         return true;
       });
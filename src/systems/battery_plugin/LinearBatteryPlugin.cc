@@ -19,8 +19,12 @@
 #include <ignition/msgs/boolean.pb.h>
 
 #include <atomic>
+#include <cstddef>
+#include <deque>
 #include <functional>
+#include <limits>
 #include <string>
+#include <vector>
 
 #include <ignition/common/Battery.hh>
 #include <ignition/common/Profiler.hh>
@@ -49,6 +53,288 @@ using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
+/// \brief Process-wide pool that stores the state of every linear battery in
+/// contiguous arrays. Plugin instances register at configure time and stage
+/// their per-step inputs in PreUpdate; the first instance to reach Update
+/// integrates the whole fleet in a single pass and writes every BatterySoC
+/// component in batch, so the per-step cost stays one tight loop no matter
+/// how many batteries a world contains.
+class LinearBatteryPool
+{
+  /// \brief Index value marking a battery that is not in the pool.
+  public: static constexpr std::size_t kInvalidIndex{
+              std::numeric_limits<std::size_t>::max()};
+
+  /// \brief Get the process-wide pool.
+  public: static LinearBatteryPool &Instance()
+  {
+    static LinearBatteryPool instance;
+    return instance;
+  }
+
+  /// \brief Constant parameters of one battery.
+  public: struct Params
+  {
+    /// \brief Open-circuit voltage constant coefficient in V
+    double e0;
+
+    /// \brief Open-circuit voltage linear coefficient in V
+    double e1;
+
+    /// \brief Initial charge in Ah
+    double q0;
+
+    /// \brief Capacity in Ah
+    double c;
+
+    /// \brief Inner resistance in Ohm
+    double r;
+
+    /// \brief Current low-pass filter characteristic time in seconds
+    double tau;
+
+    /// \brief Hours taken to fully charge the battery
+    double tCharge;
+  };
+
+  /// \brief Add a battery to the pool.
+  /// \param[in] _params Constant battery parameters
+  /// \param[in] _batteryEntity Entity holding the BatterySoC component
+  /// \param[in] _battery The battery itself
+  /// \param[in] _modelName Name of the model the battery belongs to
+  /// \return Index of the battery's row in the pool arrays.
+  public: std::size_t Register(const Params &_params, Entity _batteryEntity,
+              common::BatteryPtr _battery, const std::string &_modelName)
+  {
+    std::size_t index = this->active.size();
+    this->active.push_back(true);
+    this->staged.push_back(false);
+    this->charging.push_back(false);
+    this->drainPrinted.push_back(false);
+    this->params.push_back(_params);
+    this->q.push_back(_params.q0);
+    this->soc.push_back(1.0);
+    this->iraw.push_back(0.0);
+    this->ismooth.push_back(0.0);
+    this->voltage.push_back(_battery->InitVoltage());
+    this->totalPower.push_back(0.0);
+    this->dt.push_back(0.0);
+    this->windowSum.push_back(0.0);
+    this->windows.push_back({});
+    this->entities.push_back(_batteryEntity);
+    this->batteries.push_back(_battery);
+    this->modelNames.push_back(_modelName);
+    return index;
+  }
+
+  /// \brief Deactivate a battery's row when its plugin is destroyed.
+  /// \param[in] _index Row index returned by Register
+  public: void Unregister(std::size_t _index)
+  {
+    this->active[_index] = false;
+    this->batteries[_index].reset();
+  }
+
+  /// \brief Reset a battery's integration state.
+  /// \param[in] _index Row index returned by Register
+  public: void Reset(std::size_t _index)
+  {
+    this->iraw[_index] = 0.0;
+    this->ismooth[_index] = 0.0;
+    this->q[_index] = this->params[_index].q0;
+    this->windowSum[_index] = 0.0;
+    this->windows[_index].clear();
+  }
+
+  /// \brief Stage one battery's inputs for the next integration pass.
+  /// \param[in] _index Row index returned by Register
+  /// \param[in] _dt Step size in seconds
+  /// \param[in] _totalPower Sum of the battery's consumer power loads in W
+  /// \param[in] _charging Whether the battery is being recharged
+  public: void Stage(std::size_t _index, double _dt, double _totalPower,
+              bool _charging)
+  {
+    this->dt[_index] = _dt;
+    this->totalPower[_index] = _totalPower;
+    this->charging[_index] = _charging;
+    this->staged[_index] = true;
+  }
+
+  /// \brief Integrate every staged battery in one pass and write their
+  /// BatterySoC components. Runs at most once per iteration; later callers
+  /// within the same iteration return immediately.
+  /// \param[in] _ecm Mutable reference to the entity component manager
+  /// \param[in] _iteration Current simulation iteration
+  public: void IntegrateAll(EntityComponentManager &_ecm, uint64_t _iteration)
+  {
+    if (_iteration == this->lastIteration)
+      return;
+    this->lastIteration = _iteration;
+
+    for (std::size_t i = 0; i < this->active.size(); ++i)
+    {
+      if (!this->active[i] || !this->staged[i])
+        continue;
+      this->staged[i] = false;
+
+      if (fabs(this->voltage[i]) < 1e-3)
+      {
+        this->voltage[i] = 0.0;
+        continue;
+      }
+      if (this->soc[i] < 0)
+        continue;
+
+      auto prevSocInt = static_cast<int>(this->soc[i] * 100);
+
+      const Params &p = this->params[i];
+      double k = this->dt[i] / p.tau;
+
+      this->iraw[i] = this->totalPower[i] / this->voltage[i];
+
+      // compute charging current
+      auto iCharge = p.c / p.tCharge;
+
+      // add charging current to battery
+      if (this->charging[i] && this->soc[i] < 0.9)
+        this->iraw[i] -= iCharge;
+
+      this->ismooth[i] = this->ismooth[i] +
+          k * (this->iraw[i] - this->ismooth[i]);
+
+      // Keep a running sum over the historic current window. This is
+      // equivalent to summing the window every step, without the
+      // O(window size) loop.
+      if (this->windows[i].size() >= 100)
+      {
+        this->windowSum[i] -= this->windows[i].front();
+        this->windows[i].pop_front();
+      }
+      double sample = this->ismooth[i] * this->dt[i] / 3600.0;
+      this->windows[i].push_back(sample);
+      this->windowSum[i] += sample;
+
+      // Convert dt to hours
+      this->q[i] = this->q[i] - ((this->dt[i] * this->ismooth[i]) / 3600.0);
+
+      // open circuit voltage
+      this->voltage[i] = p.e0 + p.e1 * (1 - this->q[i] / p.c)
+          - p.r * this->ismooth[i];
+
+      // Estimate state of charge
+      this->soc[i] = this->soc[i] - this->windowSum[i] / p.c;
+
+      // Throttle debug messages
+      auto socInt = static_cast<int>(this->soc[i] * 100);
+      if (socInt % 10 == 0 && socInt != prevSocInt)
+      {
+        igndbg << "Battery: " << this->batteries[i]->Name() << std::endl;
+        igndbg << "PowerLoads().size(): "
+               << this->batteries[i]->PowerLoads().size() << std::endl;
+        igndbg << "charging status: " << std::boolalpha
+               << static_cast<bool>(this->charging[i]) << std::endl;
+        igndbg << "charging current: " << iCharge << std::endl;
+        igndbg << "voltage: " << this->voltage[i] << std::endl;
+        igndbg << "state of charge: " << this->soc[i]
+               << " (q " << this->q[i] << ")" << std::endl << std::endl;
+      }
+      if (this->soc[i] < 0 && !this->drainPrinted[i])
+      {
+        ignwarn << "Model " << this->modelNames[i] << " out of battery.\n";
+        this->drainPrinted[i] = true;
+      }
+
+      // Batch component write
+      auto *batteryComp =
+          _ecm.Component<components::BatterySoC>(this->entities[i]);
+      if (batteryComp)
+        batteryComp->Data() = this->soc[i];
+    }
+  }
+
+  /// \brief Get a battery's state of charge.
+  /// \param[in] _index Row index returned by Register
+  public: double Soc(std::size_t _index) const
+  {
+    return this->soc[_index];
+  }
+
+  /// \brief Get a battery's voltage.
+  /// \param[in] _index Row index returned by Register
+  public: double Voltage(std::size_t _index) const
+  {
+    return this->voltage[_index];
+  }
+
+  /// \brief Get a battery's smoothed current.
+  /// \param[in] _index Row index returned by Register
+  public: double Current(std::size_t _index) const
+  {
+    return this->ismooth[_index];
+  }
+
+  /// \brief Get a battery's instantaneous charge.
+  /// \param[in] _index Row index returned by Register
+  public: double Charge(std::size_t _index) const
+  {
+    return this->q[_index];
+  }
+
+  /// \brief Whether each row belongs to a live plugin instance
+  private: std::vector<bool> active;
+
+  /// \brief Whether each row has inputs staged for the next pass
+  private: std::vector<bool> staged;
+
+  /// \brief Whether each battery is being recharged
+  private: std::vector<bool> charging;
+
+  /// \brief Whether each battery's drained warning has been printed
+  private: std::vector<bool> drainPrinted;
+
+  /// \brief Constant parameters per battery
+  private: std::vector<Params> params;
+
+  /// \brief Instantaneous charge in Ah per battery
+  private: std::vector<double> q;
+
+  /// \brief State of charge per battery
+  private: std::vector<double> soc;
+
+  /// \brief Raw current in A per battery
+  private: std::vector<double> iraw;
+
+  /// \brief Smoothed current in A per battery
+  private: std::vector<double> ismooth;
+
+  /// \brief Open-circuit voltage in V per battery
+  private: std::vector<double> voltage;
+
+  /// \brief Staged total consumer power in W per battery
+  private: std::vector<double> totalPower;
+
+  /// \brief Staged step size in seconds per battery
+  private: std::vector<double> dt;
+
+  /// \brief Running sum of each battery's historic current window
+  private: std::vector<double> windowSum;
+
+  /// \brief Historic current window samples per battery
+  private: std::vector<std::deque<double>> windows;
+
+  /// \brief Entity holding each battery's BatterySoC component
+  private: std::vector<Entity> entities;
+
+  /// \brief The batteries themselves, used for debug output
+  private: std::vector<common::BatteryPtr> batteries;
+
+  /// \brief Model name per battery, used for the drained warning
+  private: std::vector<std::string> modelNames;
+
+  /// \brief Iteration the pool last integrated
+  private: uint64_t lastIteration{std::numeric_limits<uint64_t>::max()};
+};
+
 class ignition::gazebo::systems::LinearBatteryPluginPrivate
 {
   /// \brief Reset the plugin
@@ -72,8 +358,9 @@ class ignition::gazebo::systems::LinearBatteryPluginPrivate
   /// \brief Pointer to battery contained in link.
   public: common::BatteryPtr battery;
 
-  /// \brief Whether warning that battery has drained has been printed once.
-  public: bool drainPrinted{false};
+  /// \brief Index of this battery's row in the shared pool, or
+  /// LinearBatteryPool::kInvalidIndex before registration.
+  public: std::size_t poolIndex{LinearBatteryPool::kInvalidIndex};
 
   /// \brief Battery consumer identifier.
   /// Current implementation limits one consumer (Model) per battery.
@@ -99,33 +386,12 @@ class ignition::gazebo::systems::LinearBatteryPluginPrivate
   /// \brief Current low-pass filter characteristic time in seconds.
   public: double tau{0.0};
 
-  /// \brief Raw battery current in A.
-  public: double iraw{0.0};
-
-  /// \brief Smoothed battery current in A.
-  public: double ismooth{0.0};
-
-  /// \brief Instantaneous battery charge in Ah.
-  public: double q{0.0};
-
-  /// \brief State of charge
-  public: double soc{1.0};
-
   /// \brief Recharge status
   public: std::atomic_bool startCharging{false};
 
   /// \brief Hours taken to fully charge battery
   public: double tCharge{0.0};
 
-  /// \brief Battery current for a historic time window
-  public: std::deque<double> iList;
-
-  /// \brief Time interval for a historic time window
-  public: std::deque<double> dtList;
-
-  /// \brief Simulation time handled during a single update.
-  public: std::chrono::steady_clock::duration stepSize;
-
   /// \brief Flag on whether the battery should start draining
   public: bool startDraining = true;
 
@@ -158,6 +424,9 @@ LinearBatteryPlugin::~LinearBatteryPlugin()
 {
   this->dataPtr->Reset();
 
+  if (LinearBatteryPool::kInvalidIndex != this->dataPtr->poolIndex)
+    LinearBatteryPool::Instance().Unregister(this->dataPtr->poolIndex);
+
   if (this->dataPtr->battery)
   {
     // Consumer-specific
@@ -197,10 +466,7 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
     this->dataPtr->e1 = _sdf->Get<double>("open_circuit_voltage_linear_coef");
 
   if (_sdf->HasElement("initial_charge"))
-  {
     this->dataPtr->q0 = _sdf->Get<double>("initial_charge");
-    this->dataPtr->q = this->dataPtr->q0;
-  }
 
   if (_sdf->HasElement("capacity"))
     this->dataPtr->c = _sdf->Get<double>("capacity");
@@ -218,9 +484,9 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
 
     // Create battery entity and component
     this->dataPtr->batteryEntity = _ecm.CreateEntity();
-    // Initialize with initial voltage
+    // Initialize with a full state of charge
     _ecm.CreateComponent(this->dataPtr->batteryEntity,
-      components::BatterySoC(this->dataPtr->soc));
+      components::BatterySoC(1.0));
     _ecm.CreateComponent(this->dataPtr->batteryEntity, components::Name(
       batteryName));
     _ecm.SetParentEntity(this->dataPtr->batteryEntity, _entity);
@@ -291,6 +557,20 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
     }
   }
 
+  // Register this battery with the shared pool, which stores every battery's
+  // state in contiguous arrays and integrates them all in one pass.
+  LinearBatteryPool::Params params;
+  params.e0 = this->dataPtr->e0;
+  params.e1 = this->dataPtr->e1;
+  params.q0 = this->dataPtr->q0;
+  params.c = this->dataPtr->c;
+  params.r = this->dataPtr->r;
+  params.tau = this->dataPtr->tau;
+  params.tCharge = this->dataPtr->tCharge;
+  this->dataPtr->poolIndex = LinearBatteryPool::Instance().Register(params,
+      this->dataPtr->batteryEntity, this->dataPtr->battery,
+      this->dataPtr->modelName);
+
   ignmsg << "LinearBatteryPlugin configured. Battery name: "
          << this->dataPtr->battery->Name() << std::endl;
   igndbg << "Battery initial voltage: " << this->dataPtr->battery->InitVoltage()
@@ -308,15 +588,17 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
 /////////////////////////////////////////////////
 void LinearBatteryPluginPrivate::Reset()
 {
-  this->iraw = 0.0;
-  this->ismooth = 0.0;
-  this->q = this->q0;
+  if (LinearBatteryPool::kInvalidIndex == this->poolIndex)
+    return;
+  LinearBatteryPool::Instance().Reset(this->poolIndex);
 }
 
 /////////////////////////////////////////////////
 double LinearBatteryPluginPrivate::StateOfCharge() const
 {
-  return this->soc;
+  if (LinearBatteryPool::kInvalidIndex == this->poolIndex)
+    return 1.0;
+  return LinearBatteryPool::Instance().Soc(this->poolIndex);
 }
 
 //////////////////////////////////////////////////
@@ -337,7 +619,7 @@ void LinearBatteryPluginPrivate::OnDisableRecharge(
 
 //////////////////////////////////////////////////
 void LinearBatteryPlugin::PreUpdate(
-  const ignition::gazebo::UpdateInfo &/*_info*/,
+  const ignition::gazebo::UpdateInfo &_info,
   ignition::gazebo::EntityComponentManager &_ecm)
 {
   IGN_PROFILE("LinearBatteryPlugin::PreUpdate");
@@ -360,26 +642,47 @@ void LinearBatteryPlugin::PreUpdate(
           if (fabsf(static_cast<float>(jointVel)) > 0)
           {
             this->dataPtr->startDraining = true;
-            return;
+            break;
           }
         }
       }
 
       const auto *jointForceCmd =
         _ecm.Component<components::JointForceCmd>(jointEntity);
-      if (jointForceCmd)
+      if (!this->dataPtr->startDraining && jointForceCmd)
       {
         for (double jointForce : jointForceCmd->Data())
         {
           if (fabsf(static_cast<float>(jointForce)) > 0)
           {
             this->dataPtr->startDraining = true;
-            return;
+            break;
           }
         }
       }
+
+      if (this->dataPtr->startDraining)
+        break;
     }
   }
+
+  // Stage this battery's inputs so the pool can integrate the whole fleet in
+  // one pass during Update
+  if (LinearBatteryPool::kInvalidIndex != this->dataPtr->poolIndex &&
+      !_info.paused &&
+      (this->dataPtr->startDraining || this->dataPtr->startCharging))
+  {
+    double totalpower = 0.0;
+    for (const auto &powerLoad : this->dataPtr->battery->PowerLoads())
+      totalpower += powerLoad.second;
+
+    // Seconds
+    double dt = (std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _info.dt).count()) * 1e-9;
+
+    LinearBatteryPool::Instance().Stage(this->dataPtr->poolIndex, dt,
+        totalpower, this->dataPtr->startCharging);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -418,17 +721,14 @@ void LinearBatteryPlugin::Update(const UpdateInfo &_info,
   }
 
   // Update actual battery
-  this->dataPtr->stepSize = _info.dt;
-
-  if (this->dataPtr->battery)
+  if (LinearBatteryPool::kInvalidIndex != this->dataPtr->poolIndex)
   {
+    // The first plugin instance to get here integrates every staged battery
+    // in one pass and writes all BatterySoC components; later instances find
+    // the iteration already handled. The per-battery Update call only feeds
+    // the precomputed voltage back to the battery.
+    LinearBatteryPool::Instance().IntegrateAll(_ecm, _info.iterations);
     this->dataPtr->battery->Update();
-
-    // Update component
-    auto *batteryComp =
-      _ecm.Component<components::BatterySoC>(this->dataPtr->batteryEntity);
-
-    batteryComp->Data() = this->dataPtr->StateOfCharge();
   }
 }
 
@@ -441,15 +741,18 @@ void LinearBatteryPlugin::PostUpdate(const UpdateInfo &_info,
   if (_info.paused)
     return;
 
+  if (LinearBatteryPool::kInvalidIndex == this->dataPtr->poolIndex)
+    return;
+
   // Publish battery state
+  const auto &pool = LinearBatteryPool::Instance();
   msgs::BatteryState msg;
-  msg.mutable_header()->mutable_stamp()->CopyFrom(
-      convert<msgs::Time>(_info.simTime));
+  set(msg.mutable_header()->mutable_stamp(), _info.simTime);
   msg.set_voltage(this->dataPtr->battery->Voltage());
-  msg.set_current(this->dataPtr->ismooth);
-  msg.set_charge(this->dataPtr->q);
+  msg.set_current(pool.Current(this->dataPtr->poolIndex));
+  msg.set_charge(pool.Charge(this->dataPtr->poolIndex));
   msg.set_capacity(this->dataPtr->c);
-  msg.set_percentage(this->dataPtr->soc);
+  msg.set_percentage(pool.Soc(this->dataPtr->poolIndex));
   if (this->dataPtr->startCharging)
     msg.set_power_supply_status(msgs::BatteryState::CHARGING);
   else if (this->dataPtr->startDraining)
@@ -471,75 +774,12 @@ double LinearBatteryPlugin::OnUpdateVoltage(
     return 0.0;
   if (this->dataPtr->StateOfCharge() < 0)
     return _battery->Voltage();
+  if (LinearBatteryPool::kInvalidIndex == this->dataPtr->poolIndex)
+    return _battery->Voltage();
 
-  auto prevSocInt = static_cast<int>(this->dataPtr->StateOfCharge() * 100);
-
-  // Seconds
-  double dt = (std::chrono::duration_cast<std::chrono::nanoseconds>(
-    this->dataPtr->stepSize).count()) * 1e-9;
-  double totalpower = 0.0;
-  double k = dt / this->dataPtr->tau;
-
-  for (auto powerLoad : _battery->PowerLoads())
-    totalpower += powerLoad.second;
-
-  this->dataPtr->iraw = totalpower / _battery->Voltage();
-
-  // compute charging current
-  auto iCharge = this->dataPtr->c / this->dataPtr->tCharge;
-
-  // add charging current to battery
-  if (this->dataPtr->startCharging && this->dataPtr->StateOfCharge() < 0.9)
-    this->dataPtr->iraw -= iCharge;
-
-  this->dataPtr->ismooth = this->dataPtr->ismooth + k *
-    (this->dataPtr->iraw - this->dataPtr->ismooth);
-
-  // Keep a list of historic currents and time intervals
-  if (this->dataPtr->iList.size() >= 100)
-  {
-    this->dataPtr->iList.pop_front();
-    this->dataPtr->dtList.pop_front();
-  }
-  this->dataPtr->iList.push_back(this->dataPtr->ismooth);
-  this->dataPtr->dtList.push_back(dt);
-
-  // Convert dt to hours
-  this->dataPtr->q = this->dataPtr->q - ((dt * this->dataPtr->ismooth) /
-    3600.0);
-
-  // open circuit voltage
-  double voltage = this->dataPtr->e0 + this->dataPtr->e1 * (
-    1 - this->dataPtr->q / this->dataPtr->c)
-      - this->dataPtr->r * this->dataPtr->ismooth;
-
-  // Estimate state of charge
-  double isum = 0.0;
-  for (size_t i = 0; i < this->dataPtr->iList.size(); ++i)
-    isum += (this->dataPtr->iList[i] * this->dataPtr->dtList[i] / 3600.0);
-  this->dataPtr->soc = this->dataPtr->soc - isum / this->dataPtr->c;
-
-  // Throttle debug messages
-  auto socInt = static_cast<int>(this->dataPtr->StateOfCharge() * 100);
-  if (socInt % 10 == 0 && socInt != prevSocInt)
-  {
-    igndbg << "Battery: " << this->dataPtr->battery->Name() << std::endl;
-    igndbg << "PowerLoads().size(): " << _battery->PowerLoads().size()
-           << std::endl;
-    igndbg << "charging status: " << std::boolalpha
-           << this->dataPtr->startCharging << std::endl;
-    igndbg << "charging current: " << iCharge << std::endl;
-    igndbg << "voltage: " << voltage << std::endl;
-    igndbg << "state of charge: " << this->dataPtr->StateOfCharge()
-           << " (q " << this->dataPtr->q << ")" << std::endl << std::endl;
-  }
-  if (this->dataPtr->StateOfCharge() < 0 && !this->dataPtr->drainPrinted)
-  {
-    ignwarn << "Model " << this->dataPtr->modelName << " out of battery.\n";
-    this->dataPtr->drainPrinted = true;
-  }
-
-  return voltage;
+  // The integration already ran in the pool's single pass over all
+  // batteries; just report the resulting voltage back to the battery.
+  return LinearBatteryPool::Instance().Voltage(this->dataPtr->poolIndex);
 }
 
 IGNITION_ADD_PLUGIN(LinearBatteryPlugin,
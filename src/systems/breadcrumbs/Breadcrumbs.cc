@@ -18,6 +18,8 @@
 #include <ignition/msgs/empty.pb.h>
 
 #include <iterator>
+#include <string>
+#include <unordered_set>
 
 #include <ignition/common/Profiler.hh>
 
@@ -105,6 +107,12 @@ void Breadcrumbs::Configure(const Entity &_entity,
     return;
   }
 
+  // Copy the parsed model once; deployments reuse it and only overwrite its
+  // name and pose, so the model DOM is not copied again per deployment.
+  this->deployModel = *this->modelRoot.ModelByIndex(0);
+  this->deployBaseName = this->deployModel.Name();
+  this->deployBasePose = this->deployModel.RawPose();
+
   if (_sdf->HasElement("performer_volume"))
   {
     auto vol = _sdf->GetElementImpl("performer_volume");
@@ -138,6 +146,19 @@ void Breadcrumbs::Configure(const Entity &_entity,
 
   this->worldEntity = _ecm.EntityByComponents(components::World());
 
+  // Pre-build the static model skeleton so the first auto-disable does not
+  // parse model.sdf in the middle of a step.
+  if (this->disablePhysicsTime > std::chrono::steady_clock::duration::zero())
+  {
+    sdf::ElementPtr staticModelSDF(new sdf::Element);
+    sdf::initFile("model.sdf", staticModelSDF);
+    staticModelSDF->GetAttribute("name")->Set("static_model");
+    staticModelSDF->GetElement("static")->Set(true);
+    sdf::ElementPtr linkElem = staticModelSDF->AddElement("link");
+    linkElem->GetAttribute("name")->Set("static_link");
+    this->staticModelToSpawn.Load(staticModelSDF);
+  }
+
   this->initialized = true;
 }
 
@@ -159,27 +180,31 @@ void Breadcrumbs::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
 
     auto poseComp = _ecm.Component<components::Pose>(this->model.Entity());
 
+    // Collect existing model names once per batch; names of models spawned
+    // below are added as we go, so each deployment doesn't rescan the ECM.
+    std::unordered_set<std::string> modelNames;
+    if (!cmds.empty())
+    {
+      _ecm.Each<components::Name, components::Model>(
+          [&modelNames](const Entity &, const components::Name *_name,
+                        const components::Model *)
+          {
+            modelNames.insert(_name->Data());
+            return true;
+          });
+    }
+
     for (std::size_t i = 0; i < cmds.size(); ++i)
     {
       if (this->maxDeployments < 0 ||
           this->numDeployments < this->maxDeployments)
       {
-        sdf::Model modelToSpawn = *this->modelRoot.ModelByIndex(0);
+        sdf::Model &modelToSpawn = this->deployModel;
         std::string desiredName =
-            modelToSpawn.Name() + "_" + std::to_string(this->numDeployments);
-
-        std::vector<std::string> modelNames;
-        _ecm.Each<components::Name, components::Model>(
-            [&modelNames](const Entity &, const components::Name *_name,
-                          const components::Model *)
-            {
-              modelNames.push_back(_name->Data());
-              return true;
-            });
+            this->deployBaseName + "_" + std::to_string(this->numDeployments);
 
         // Check if there's a model with the same name.
-        auto it = std::find(modelNames.begin(), modelNames.end(), desiredName);
-        if (it != modelNames.end())
+        if (modelNames.find(desiredName) != modelNames.end())
         {
           if (!this->allowRenaming)
           {
@@ -192,16 +217,16 @@ void Breadcrumbs::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
 
           std::string newName = desiredName;
           int counter = 0;
-          while (std::find(modelNames.begin(), modelNames.end(), newName) !=
-                 modelNames.end())
+          while (modelNames.find(newName) != modelNames.end())
           {
             newName = desiredName + "_" + std::to_string(++counter);
           }
           desiredName = newName;
         }
+        modelNames.insert(desiredName);
 
         modelToSpawn.SetName(desiredName);
-        modelToSpawn.SetRawPose(poseComp->Data() * modelToSpawn.RawPose());
+        modelToSpawn.SetRawPose(poseComp->Data() * this->deployBasePose);
         ignmsg << "Deploying " << modelToSpawn.Name() << " at "
                << modelToSpawn.RawPose() << std::endl;
         Entity entity = this->creator->CreateEntities(&modelToSpawn);
@@ -238,7 +263,7 @@ void Breadcrumbs::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
       }
       else
       {
-        ignmsg << "Asked to deploy " << this->modelRoot.ModelByIndex(0)->Name()
+        ignmsg << "Asked to deploy " << this->deployBaseName
                << " but the maximum number of deployments has reached the "
                << "limit of " << this->maxDeployments << std::endl;
       }
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <set>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -129,6 +130,18 @@ namespace systems
     /// \brief sdf::Root of the model to be deployed
     private: sdf::Root modelRoot;
 
+    /// \brief Parsed breadcrumb model reused for every deployment. Only its
+    /// name and raw pose change per deployment, so deploying does not copy
+    /// the model DOM again.
+    private: sdf::Model deployModel;
+
+    /// \brief Name of the breadcrumb model template
+    private: std::string deployBaseName;
+
+    /// \brief Raw pose of the breadcrumb model template, kept aside because
+    /// the reused model's pose is overwritten on every deployment
+    private: math::Pose3d deployBasePose;
+
     /// \brief Whether the deployed models will be performers
     private: bool isPerformer{false};
 
@@ -19,6 +19,7 @@
 #include <ignition/msgs/contact.pb.h>
 #include <ignition/msgs/contacts.pb.h>
 
+#include <algorithm>
 #include <unordered_map>
 
 #include <ignition/common/Profiler.hh>
@@ -57,7 +58,7 @@ class ContactSensor
   /// \brief Add contacts to the list to be published
   /// \param[in] _stamp Time stamp of the sensor measurement
   /// \param[in] _contacts A contact message to be added to the list
-  public: void AddContacts(const std::chrono::steady_clock::duration &_stamp,
+  public: void AddContacts(const msgs::Time &_stamp,
                            const msgs::Contacts &_contacts);
 
   /// \brief Publish sensor data over ign transport
@@ -98,6 +99,12 @@ class ignition::gazebo::systems::ContactPrivate
   /// \brief A map of Contact entity to its Contact sensor.
   public: std::unordered_map<Entity,
       std::unique_ptr<ContactSensor>> entitySensorMap;
+
+  /// \brief Map of collision entity to the sensors publishing it, so each
+  /// contacting collision dispatches straight to its sensors instead of
+  /// every sensor polling every one of its collisions.
+  public: std::unordered_map<Entity,
+      std::vector<ContactSensor *>> collisionSensorIndex;
 };
 
 //////////////////////////////////////////////////
@@ -126,18 +133,17 @@ void ContactSensor::Load(const sdf::ElementPtr &_sdf, const std::string &_topic,
 
 //////////////////////////////////////////////////
 void ContactSensor::AddContacts(
-    const std::chrono::steady_clock::duration &_stamp,
+    const msgs::Time &_stamp,
     const msgs::Contacts &_contacts)
 {
-  auto stamp = convert<msgs::Time>(_stamp);
   for (const auto &contact : _contacts.contact())
   {
     auto *newContact = this->contactsMsg.add_contact();
     newContact->CopyFrom(contact);
-    newContact->mutable_header()->mutable_stamp()->CopyFrom(stamp);
+    newContact->mutable_header()->mutable_stamp()->CopyFrom(_stamp);
   }
 
-  this->contactsMsg.mutable_header()->mutable_stamp()->CopyFrom(stamp);
+  this->contactsMsg.mutable_header()->mutable_stamp()->CopyFrom(_stamp);
 }
 
 //////////////////////////////////////////////////
@@ -202,6 +208,12 @@ void ContactPrivate::CreateSensors(EntityComponentManager &_ecm)
 
         auto sensor = std::make_unique<ContactSensor>();
         sensor->Load(_contact->Data(), defaultTopic, collisionEntities);
+
+        for (const Entity &collisionEntity : collisionEntities)
+        {
+          this->collisionSensorIndex[collisionEntity].push_back(sensor.get());
+        }
+
         this->entitySensorMap.insert(
             std::make_pair(_entity, std::move(sensor)));
 
@@ -214,20 +226,30 @@ void ContactPrivate::UpdateSensors(const UpdateInfo &_info,
                                    const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("ContactPrivate::UpdateSensors");
-  for (const auto &item : this->entitySensorMap)
-  {
-    for (const Entity &entity : item.second->collisionEntities)
-    {
-      auto contacts = _ecm.Component<components::ContactSensorData>(entity);
 
-      // We will assume that the ContactData component will have been created if
-      // this entity is in the collisionEntities list
-      if (contacts->Data().contact_size() > 0)
+  // The stamp is shared by every sensor, so convert it once.
+  auto stamp = convert<msgs::Time>(_info.simTime);
+
+  // One dense scan over the contact data written by physics; collisions
+  // without contacts are skipped before any sensor is touched.
+  _ecm.Each<components::ContactSensorData>(
+      [&](const Entity &_entity,
+          const components::ContactSensorData *_contacts) -> bool
       {
-        item.second->AddContacts(_info.simTime, contacts->Data());
-      }
-    }
-  }
+        if (_contacts->Data().contact_size() == 0)
+          return true;
+
+        auto it = this->collisionSensorIndex.find(_entity);
+        if (it != this->collisionSensorIndex.end())
+        {
+          for (ContactSensor *sensor : it->second)
+          {
+            sensor->AddContacts(stamp, _contacts->Data());
+          }
+        }
+
+        return true;
+      });
 }
 
 //////////////////////////////////////////////////
@@ -247,6 +269,21 @@ void ContactPrivate::RemoveSensors(
           return true;
         }
 
+        // Drop the sensor's collisions from the dispatch index.
+        for (const Entity &collisionEntity :
+             sensorId->second->collisionEntities)
+        {
+          auto indexIt = this->collisionSensorIndex.find(collisionEntity);
+          if (indexIt == this->collisionSensorIndex.end())
+            continue;
+
+          auto &sensors = indexIt->second;
+          sensors.erase(std::remove(sensors.begin(), sensors.end(),
+              sensorId->second.get()), sensors.end());
+          if (sensors.empty())
+            this->collisionSensorIndex.erase(indexIt);
+        }
+
         this->entitySensorMap.erase(sensorId);
 
         return true;
@@ -29,6 +29,7 @@
 #include "ignition/gazebo/components/JointVelocityCmd.hh"
 #include "ignition/gazebo/Link.hh"
 #include "ignition/gazebo/Model.hh"
+#include "ignition/gazebo/PluginConfigCache.hh"
 
 #include "DiffDrive.hh"
 #include "SpeedLimiter.hh"
@@ -49,6 +50,60 @@ struct Commands
   Commands() : lin(0.0), ang(0.0) {}
 };
 
+/// \brief Parameters parsed from the plugin element. Instances
+/// configured from identical elements share one object through the
+/// PluginConfigCache, so a fleet of identical robots parses them once.
+struct DiffDriveParams
+{
+  /// \brief Names of the left joints.
+  std::vector<std::string> leftJointNames;
+
+  /// \brief Names of the right joints.
+  std::vector<std::string> rightJointNames;
+
+  /// \brief Distance between wheels.
+  double wheelSeparation{1.0};
+
+  /// \brief Wheel radius.
+  double wheelRadius{0.2};
+
+  /// \brief True if velocity limits were specified.
+  bool hasVelocityLimits{false};
+
+  /// \brief True if acceleration limits were specified.
+  bool hasAccelerationLimits{false};
+
+  /// \brief True if jerk limits were specified.
+  bool hasJerkLimits{false};
+
+  /// \brief Minimum velocity.
+  double minVel{std::numeric_limits<double>::lowest()};
+
+  /// \brief Maximum velocity.
+  double maxVel{std::numeric_limits<double>::max()};
+
+  /// \brief Minimum acceleration.
+  double minAccel{std::numeric_limits<double>::lowest()};
+
+  /// \brief Maximum acceleration.
+  double maxAccel{std::numeric_limits<double>::max()};
+
+  /// \brief Minimum jerk.
+  double minJerk{std::numeric_limits<double>::lowest()};
+
+  /// \brief Maximum jerk.
+  double maxJerk{std::numeric_limits<double>::max()};
+
+  /// \brief Update period calculated from <odom_publish_frequency>.
+  std::chrono::steady_clock::duration odomPubPeriod{0};
+
+  /// \brief Custom command topic, empty for the per-model default.
+  std::string topic;
+
+  /// \brief Custom odometry topic, empty for the per-model default.
+  std::string odomTopic;
+};
+
 class ignition::gazebo::systems::DiffDrivePrivate
 {
   /// \brief Callback for velocity subscription
@@ -114,6 +169,12 @@ class ignition::gazebo::systems::DiffDrivePrivate
   /// \brief Diff drive odometry message publisher.
   public: transport::Node::Publisher odomPub;
 
+  /// \brief Reusable odometry message. The frame name header data is
+  /// filled on the first publish and kept; later publishes only update
+  /// the pose, twist and time stamp, so steady-state publishing does
+  /// not allocate.
+  public: msgs::Odometry odomMsg;
+
   /// \brief Linear velocity limiter.
   public: std::unique_ptr<SpeedLimiter> limiterLin;
 
@@ -160,103 +221,116 @@ void DiffDrive::Configure(const Entity &_entity,
     return;
   }
 
-  // Ugly, but needed because the sdf::Element::GetElement is not a const
-  // function and _sdf is a const shared pointer to a const sdf::Element.
-  auto ptr = const_cast<sdf::Element *>(_sdf.get());
-
-  // Get params from SDF
-  sdf::ElementPtr sdfElem = ptr->GetElement("left_joint");
-  while (sdfElem)
+  // Get params from SDF. Identical plugin elements are parsed once and
+  // the result shared between instances, so a fleet of identical
+  // robots walks the element tree a single time.
+  auto params = PluginConfigCache::Get<DiffDriveParams>(_sdf, [&_sdf]()
   {
-    this->dataPtr->leftJointNames.push_back(sdfElem->Get<std::string>());
-    sdfElem = sdfElem->GetNextElement("left_joint");
-  }
-  sdfElem = ptr->GetElement("right_joint");
-  while (sdfElem)
-  {
-    this->dataPtr->rightJointNames.push_back(sdfElem->Get<std::string>());
-    sdfElem = sdfElem->GetNextElement("right_joint");
-  }
+    DiffDriveParams out;
 
-  this->dataPtr->wheelSeparation = _sdf->Get<double>("wheel_separation",
-      this->dataPtr->wheelSeparation).first;
-  this->dataPtr->wheelRadius = _sdf->Get<double>("wheel_radius",
-      this->dataPtr->wheelRadius).first;
-
-  // Parse speed limiter parameters.
-  bool hasVelocityLimits     = false;
-  bool hasAccelerationLimits = false;
-  bool hasJerkLimits         = false;
-  double minVel              = std::numeric_limits<double>::lowest();
-  double maxVel              = std::numeric_limits<double>::max();
-  double minAccel            = std::numeric_limits<double>::lowest();
-  double maxAccel            = std::numeric_limits<double>::max();
-  double minJerk             = std::numeric_limits<double>::lowest();
-  double maxJerk             = std::numeric_limits<double>::max();
-
-  if (_sdf->HasElement("min_velocity"))
-  {
-    minVel = _sdf->Get<double>("min_velocity");
-    hasVelocityLimits = true;
-  }
-  if (_sdf->HasElement("max_velocity"))
-  {
-    maxVel = _sdf->Get<double>("max_velocity");
-    hasVelocityLimits = true;
-  }
-  if (_sdf->HasElement("min_acceleration"))
-  {
-    minAccel = _sdf->Get<double>("min_acceleration");
-    hasAccelerationLimits = true;
-  }
-  if (_sdf->HasElement("max_acceleration"))
-  {
-    maxAccel = _sdf->Get<double>("max_acceleration");
-    hasAccelerationLimits = true;
-  }
-  if (_sdf->HasElement("min_jerk"))
-  {
-    minJerk = _sdf->Get<double>("min_jerk");
-    hasJerkLimits = true;
-  }
-  if (_sdf->HasElement("max_jerk"))
-  {
-    maxJerk = _sdf->Get<double>("max_jerk");
-    hasJerkLimits = true;
-  }
+    // Ugly, but needed because the sdf::Element::GetElement is not a const
+    // function and _sdf is a const shared pointer to a const sdf::Element.
+    auto ptr = const_cast<sdf::Element *>(_sdf.get());
+
+    sdf::ElementPtr sdfElem = ptr->GetElement("left_joint");
+    while (sdfElem)
+    {
+      out.leftJointNames.push_back(sdfElem->Get<std::string>());
+      sdfElem = sdfElem->GetNextElement("left_joint");
+    }
+    sdfElem = ptr->GetElement("right_joint");
+    while (sdfElem)
+    {
+      out.rightJointNames.push_back(sdfElem->Get<std::string>());
+      sdfElem = sdfElem->GetNextElement("right_joint");
+    }
 
-  // Instantiate the speed limiters.
+    out.wheelSeparation = _sdf->Get<double>("wheel_separation",
+        out.wheelSeparation).first;
+    out.wheelRadius = _sdf->Get<double>("wheel_radius",
+        out.wheelRadius).first;
+
+    // Parse speed limiter parameters.
+    if (_sdf->HasElement("min_velocity"))
+    {
+      out.minVel = _sdf->Get<double>("min_velocity");
+      out.hasVelocityLimits = true;
+    }
+    if (_sdf->HasElement("max_velocity"))
+    {
+      out.maxVel = _sdf->Get<double>("max_velocity");
+      out.hasVelocityLimits = true;
+    }
+    if (_sdf->HasElement("min_acceleration"))
+    {
+      out.minAccel = _sdf->Get<double>("min_acceleration");
+      out.hasAccelerationLimits = true;
+    }
+    if (_sdf->HasElement("max_acceleration"))
+    {
+      out.maxAccel = _sdf->Get<double>("max_acceleration");
+      out.hasAccelerationLimits = true;
+    }
+    if (_sdf->HasElement("min_jerk"))
+    {
+      out.minJerk = _sdf->Get<double>("min_jerk");
+      out.hasJerkLimits = true;
+    }
+    if (_sdf->HasElement("max_jerk"))
+    {
+      out.maxJerk = _sdf->Get<double>("max_jerk");
+      out.hasJerkLimits = true;
+    }
+
+    double odomFreq = _sdf->Get<double>("odom_publish_frequency", 50).first;
+    if (odomFreq > 0)
+    {
+      std::chrono::duration<double> odomPer{1 / odomFreq};
+      out.odomPubPeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        odomPer);
+    }
+
+    if (_sdf->HasElement("topic"))
+      out.topic = _sdf->Get<std::string>("topic");
+    if (_sdf->HasElement("odom_topic"))
+      out.odomTopic = _sdf->Get<std::string>("odom_topic");
+
+    return out;
+  });
+
+  this->dataPtr->leftJointNames = params->leftJointNames;
+  this->dataPtr->rightJointNames = params->rightJointNames;
+  this->dataPtr->wheelSeparation = params->wheelSeparation;
+  this->dataPtr->wheelRadius = params->wheelRadius;
+  this->dataPtr->odomPubPeriod = params->odomPubPeriod;
+
+  // Instantiate the speed limiters. They carry per-instance state, so
+  // only their limits come from the shared parameters.
   this->dataPtr->limiterLin = std::make_unique<SpeedLimiter>(
-    hasVelocityLimits, hasAccelerationLimits, hasJerkLimits,
-    minVel, maxVel, minAccel, maxAccel, minJerk, maxJerk);
+    params->hasVelocityLimits, params->hasAccelerationLimits,
+    params->hasJerkLimits, params->minVel, params->maxVel,
+    params->minAccel, params->maxAccel, params->minJerk, params->maxJerk);
 
   this->dataPtr->limiterAng = std::make_unique<SpeedLimiter>(
-    hasVelocityLimits, hasAccelerationLimits, hasJerkLimits,
-    minVel, maxVel, minAccel, maxAccel, minJerk, maxJerk);
-
-  double odomFreq = _sdf->Get<double>("odom_publish_frequency", 50).first;
-  if (odomFreq > 0)
-  {
-    std::chrono::duration<double> odomPer{1 / odomFreq};
-    this->dataPtr->odomPubPeriod =
-      std::chrono::duration_cast<std::chrono::steady_clock::duration>(odomPer);
-  }
+    params->hasVelocityLimits, params->hasAccelerationLimits,
+    params->hasJerkLimits, params->minVel, params->maxVel,
+    params->minAccel, params->maxAccel, params->minJerk, params->maxJerk);
 
   // Setup odometry.
   this->dataPtr->odom.SetWheelParams(this->dataPtr->wheelSeparation,
       this->dataPtr->wheelRadius, this->dataPtr->wheelRadius);
 
   // Subscribe to commands
-  std::string topic{"/model/" + this->dataPtr->model.Name(_ecm) + "/cmd_vel"};
-  if (_sdf->HasElement("topic"))
-    topic = _sdf->Get<std::string>("topic");
+  std::string topic{params->topic.empty() ?
+      "/model/" + this->dataPtr->model.Name(_ecm) + "/cmd_vel" :
+      params->topic};
   this->dataPtr->node.Subscribe(topic, &DiffDrivePrivate::OnCmdVel,
       this->dataPtr.get());
 
-  std::string odomTopic{"/model/" + this->dataPtr->model.Name(_ecm) +
-    "/odometry"};
-  if (_sdf->HasElement("odom_topic"))
-    odomTopic = _sdf->Get<std::string>("odom_topic");
+  std::string odomTopic{params->odomTopic.empty() ?
+      "/model/" + this->dataPtr->model.Name(_ecm) + "/odometry" :
+      params->odomTopic};
   this->dataPtr->odomPub = this->dataPtr->node.Advertise<msgs::Odometry>(
       odomTopic);
 
@@ -278,12 +352,13 @@ void DiffDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
         << "s]. System may not work properly." << std::endl;
   }
 
-  // If the joints haven't been identified yet, look for them
+  // If the joints haven't been identified yet, look for them. Once they
+  // are cached no name lookup happens here again.
   static std::set<std::string> warnedModels;
-  auto modelName = this->dataPtr->model.Name(_ecm);
   if (this->dataPtr->leftJoints.empty() ||
       this->dataPtr->rightJoints.empty())
   {
+    auto modelName = this->dataPtr->model.Name(_ecm);
     bool warned{false};
     for (const std::string &name : this->dataPtr->leftJointNames)
     {
@@ -314,16 +389,17 @@ void DiffDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     {
       warnedModels.insert(modelName);
     }
-  }
 
-  if (this->dataPtr->leftJoints.empty() || this->dataPtr->rightJoints.empty())
-    return;
+    if (this->dataPtr->leftJoints.empty() ||
+        this->dataPtr->rightJoints.empty())
+      return;
 
-  if (warnedModels.find(modelName) != warnedModels.end())
-  {
-    ignmsg << "Found joints for model [" << modelName
-           << "], plugin will start working." << std::endl;
-    warnedModels.erase(modelName);
+    if (warnedModels.find(modelName) != warnedModels.end())
+    {
+      ignmsg << "Found joints for model [" << modelName
+             << "], plugin will start working." << std::endl;
+      warnedModels.erase(modelName);
+    }
   }
 
   // Nothing left to do if paused.
@@ -342,7 +418,9 @@ void DiffDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     }
     else
     {
-      *vel = components::JointVelocityCmd({this->dataPtr->leftJointSpeed});
+      // Write the command in place; rebuilding the component would
+      // reallocate its vector every cycle
+      vel->Data()[0] = this->dataPtr->leftJointSpeed;
     }
   }
 
@@ -358,7 +436,7 @@ void DiffDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     }
     else
     {
-      *vel = components::JointVelocityCmd({this->dataPtr->rightJointSpeed});
+      vel->Data()[0] = this->dataPtr->rightJointSpeed;
     }
   }
 
@@ -433,8 +511,26 @@ void DiffDrivePrivate::UpdateOdometry(const ignition::gazebo::UpdateInfo &_info,
   }
   this->lastOdomPubTime = _info.simTime;
 
-  // Construct the odometry message and publish it.
-  msgs::Odometry msg;
+  // Fill the frame names once; they never change after configuration.
+  msgs::Odometry &msg = this->odomMsg;
+  if (msg.header().data_size() == 0)
+  {
+    const std::string modelName = this->model.Name(_ecm);
+
+    auto frame = msg.mutable_header()->add_data();
+    frame->set_key("frame_id");
+    frame->add_value(modelName + "/odom");
+
+    std::optional<std::string> linkName = this->canonicalLink.Name(_ecm);
+    if (linkName)
+    {
+      auto childFrame = msg.mutable_header()->add_data();
+      childFrame->set_key("child_frame_id");
+      childFrame->add_value(modelName + "/" + *linkName);
+    }
+  }
+
+  // Update the pose, twist and stamp in place and publish.
   msg.mutable_pose()->mutable_position()->set_x(this->odom.X());
   msg.mutable_pose()->mutable_position()->set_y(this->odom.Y());
 
@@ -445,21 +541,7 @@ void DiffDrivePrivate::UpdateOdometry(const ignition::gazebo::UpdateInfo &_info,
   msg.mutable_twist()->mutable_angular()->set_z(*this->odom.AngularVelocity());
 
   // Set the time stamp in the header
-  msg.mutable_header()->mutable_stamp()->CopyFrom(
-      convert<msgs::Time>(_info.simTime));
-
-  // Set the frame id.
-  auto frame = msg.mutable_header()->add_data();
-  frame->set_key("frame_id");
-  frame->add_value(this->model.Name(_ecm) + "/odom");
-
-  std::optional<std::string> linkName = this->canonicalLink.Name(_ecm);
-  if (linkName)
-  {
-    auto childFrame = msg.mutable_header()->add_data();
-    childFrame->set_key("child_frame_id");
-    childFrame->add_value(this->model.Name(_ecm) + "/" + *linkName);
-  }
+  set(msg.mutable_header()->mutable_stamp(), _info.simTime);
 
   // Publish the message
   this->odomPub.Publish(msg);
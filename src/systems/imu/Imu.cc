@@ -17,7 +17,17 @@
 
 #include <ignition/plugin/Register.hh>
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <sdf/Element.hh>
+#include <sdf/Imu.hh>
+#include <sdf/Noise.hh>
 
 #include <ignition/common/Profiler.hh>
 
@@ -34,6 +44,7 @@
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/World.hh"
+#include "ignition/gazebo/detail/GaussianNoiseKernel.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/Util.hh"
 
@@ -46,9 +57,44 @@ using namespace systems;
 /// \brief Private Imu data class.
 class ignition::gazebo::systems::ImuPrivate
 {
-  /// \brief A map of IMU entity to its IMU sensor.
-  public: std::unordered_map<Entity,
-      std::unique_ptr<ignition::sensors::ImuSensor>> entitySensorMap;
+  /// \brief Entity of each IMU, aligned with the per-sensor arrays below.
+  /// Sensor state is kept in parallel contiguous arrays so the per-step
+  /// update is one sweep over dense rows instead of a hash map iteration.
+  public: std::vector<Entity> sensorEntities;
+
+  /// \brief The IMU sensors, aligned with sensorEntities.
+  public: std::vector<std::unique_ptr<ignition::sensors::ImuSensor>> sensors;
+
+  /// \brief Map of IMU entity to its row in the per-sensor arrays.
+  public: std::unordered_map<Entity, std::size_t> sensorIndices;
+
+  /// \brief World pose staged for each sensor this step.
+  public: std::vector<math::Pose3d> worldPoses;
+
+  /// \brief Angular velocity staged for each sensor this step.
+  public: std::vector<math::Vector3d> angularVels;
+
+  /// \brief Linear acceleration staged for each sensor this step.
+  public: std::vector<math::Vector3d> linearAccels;
+
+  /// \brief Whether each sensor had state staged this step.
+  public: std::vector<bool> staged;
+
+  /// \brief Number of noise channels per IMU: angular velocity and
+  /// linear acceleration, three axes each.
+  public: static constexpr std::size_t kNoiseChannels{6};
+
+  /// \brief Batched Gaussian noise, one row per sensor, aligned with
+  /// sensorEntities. Sensors whose SDF noise couldn't be folded into the
+  /// kernel get a silent row, so the rows stay aligned.
+  public: detail::GaussianNoiseKernel noiseKernel{kNoiseChannels};
+
+  /// \brief Whether each sensor's noise was folded into the kernel and
+  /// stripped from the SDF handed to ign-sensors.
+  public: std::vector<bool> kernelNoise;
+
+  /// \brief Scratch buffer of noise samples, one per channel.
+  public: std::vector<double> noiseSamples;
 
   /// \brief Ign-sensors sensor factory for creating sensors
   public: sensors::SensorFactory sensorFactory;
@@ -59,10 +105,16 @@ class ignition::gazebo::systems::ImuPrivate
   /// \param[in] _ecm Mutable reference to ECM.
   public: void CreateImuEntities(EntityComponentManager &_ecm);
 
-  /// \brief Update IMU sensor data based on physics data
+  /// \brief Stage the pose, angular velocity and linear acceleration of
+  /// every IMU into the per-sensor arrays.
   /// \param[in] _ecm Immutable reference to ECM.
   public: void Update(const EntityComponentManager &_ecm);
 
+  /// \brief Push the staged state into the sensors and update them all in
+  /// one pass.
+  /// \param[in] _info Current simulation step info.
+  public: void UpdateSensors(const UpdateInfo &_info);
+
   /// \brief Remove IMU sensors if their entities have been removed from
   /// simulation.
   /// \param[in] _ecm Immutable reference to ECM.
@@ -103,14 +155,7 @@ void Imu::PostUpdate(const UpdateInfo &_info,
   if (!_info.paused)
   {
     this->dataPtr->Update(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      // Update measurement time
-      auto time = math::durationToSecNsec(_info.simTime);
-      dynamic_cast<sensors::Sensor *>(it.second.get())->Update(
-          common::Time(time.first, time.second), false);
-    }
+    this->dataPtr->UpdateSensors(_info);
   }
 
   this->dataPtr->RemoveImuEntities(_ecm);
@@ -154,6 +199,40 @@ void ImuPrivate::CreateImuEntities(EntityComponentManager &_ecm)
           std::string topic = scopedName(_entity, _ecm) + "/imu";
           data.SetTopic(topic);
         }
+
+        // Fold Gaussian noise into the batched kernel and strip it from
+        // the SDF handed to ign-sensors, so the per-sample virtual noise
+        // dispatch inside the sensor is skipped. Custom noise types keep
+        // the sensor-side path and get a silent kernel row.
+        std::vector<sdf::Noise> noises(kNoiseChannels);
+        bool useKernel = false;
+        if (const sdf::Imu *imuSdf = data.ImuSensor())
+        {
+          noises = {imuSdf->AngularVelocityXNoise(),
+                    imuSdf->AngularVelocityYNoise(),
+                    imuSdf->AngularVelocityZNoise(),
+                    imuSdf->LinearAccelerationXNoise(),
+                    imuSdf->LinearAccelerationYNoise(),
+                    imuSdf->LinearAccelerationZNoise()};
+          useKernel = std::all_of(noises.begin(), noises.end(),
+              detail::GaussianNoiseKernel::Supported);
+          if (useKernel)
+          {
+            sdf::Imu stripped = *imuSdf;
+            stripped.SetAngularVelocityXNoise(sdf::Noise());
+            stripped.SetAngularVelocityYNoise(sdf::Noise());
+            stripped.SetAngularVelocityZNoise(sdf::Noise());
+            stripped.SetLinearAccelerationXNoise(sdf::Noise());
+            stripped.SetLinearAccelerationYNoise(sdf::Noise());
+            stripped.SetLinearAccelerationZNoise(sdf::Noise());
+            data.SetImuSensor(stripped);
+          }
+        }
+        if (!useKernel)
+          noises.assign(kNoiseChannels, sdf::Noise());
+        this->noiseKernel.AddRow(_entity, noises);
+        this->kernelNoise.push_back(useKernel);
+
         std::unique_ptr<sensors::ImuSensor> sensor =
             this->sensorFactory.CreateSensor<
             sensors::ImuSensor>(data);
@@ -171,8 +250,14 @@ void ImuPrivate::CreateImuEntities(EntityComponentManager &_ecm)
         math::Pose3d p = worldPose(_entity, _ecm);
         sensor->SetOrientationReference(p.Rot());
 
-        this->entitySensorMap.insert(
-            std::make_pair(_entity, std::move(sensor)));
+        // Append a row to the per-sensor arrays.
+        this->sensorIndices[_entity] = this->sensors.size();
+        this->sensorEntities.push_back(_entity);
+        this->sensors.push_back(std::move(sensor));
+        this->worldPoses.push_back(math::Pose3d::Zero);
+        this->angularVels.push_back(math::Vector3d::Zero);
+        this->linearAccels.push_back(math::Vector3d::Zero);
+        this->staged.push_back(false);
 
         return true;
       });
@@ -192,18 +277,21 @@ void ImuPrivate::Update(const EntityComponentManager &_ecm)
         const components::AngularVelocity *_angularVel,
         const components::LinearAcceleration *_linearAccel)->bool
       {
-        auto it = this->entitySensorMap.find(_entity);
-        if (it != this->entitySensorMap.end())
+        auto it = this->sensorIndices.find(_entity);
+        if (it != this->sensorIndices.end())
         {
-          const auto &imuWorldPose = _worldPose->Data();
-          it->second->SetWorldPose(imuWorldPose);
+          const std::size_t index = it->second;
+
+          this->worldPoses[index] = _worldPose->Data();
 
           // Set the IMU angular velocity (defined in imu's local frame)
-          it->second->SetAngularVelocity(_angularVel->Data());
+          this->angularVels[index] = _angularVel->Data();
 
           // Set the IMU linear acceleration in the imu local frame
-          it->second->SetLinearAcceleration(_linearAccel->Data());
-         }
+          this->linearAccels[index] = _linearAccel->Data();
+
+          this->staged[index] = true;
+        }
         else
         {
           ignerr << "Failed to update IMU: " << _entity << ". "
@@ -214,6 +302,46 @@ void ImuPrivate::Update(const EntityComponentManager &_ecm)
       });
 }
 
+//////////////////////////////////////////////////
+void ImuPrivate::UpdateSensors(const UpdateInfo &_info)
+{
+  IGN_PROFILE("ImuPrivate::UpdateSensors");
+
+  // The measurement time is the same for every sensor, so compute it once.
+  auto time = math::durationToSecNsec(_info.simTime);
+  const common::Time measurementTime(time.first, time.second);
+
+  // One batched draw covers every channel of every sensor this step.
+  this->noiseKernel.Sample(_info, this->noiseSamples);
+
+  for (std::size_t i = 0; i < this->sensors.size(); ++i)
+  {
+    auto *sensor = this->sensors[i].get();
+    if (this->kernelNoise[i])
+    {
+      // The staged arrays hold the clean values; noise is resampled and
+      // re-applied every update, so the sensor publishes a fresh noisy
+      // measurement even when no new state arrived.
+      const double *noise = this->noiseSamples.data() + i * kNoiseChannels;
+      sensor->SetWorldPose(this->worldPoses[i]);
+      sensor->SetAngularVelocity(this->angularVels[i] +
+          math::Vector3d(noise[0], noise[1], noise[2]));
+      sensor->SetLinearAcceleration(this->linearAccels[i] +
+          math::Vector3d(noise[3], noise[4], noise[5]));
+      this->staged[i] = false;
+    }
+    else if (this->staged[i])
+    {
+      sensor->SetWorldPose(this->worldPoses[i]);
+      sensor->SetAngularVelocity(this->angularVels[i]);
+      sensor->SetLinearAcceleration(this->linearAccels[i]);
+      this->staged[i] = false;
+    }
+
+    dynamic_cast<sensors::Sensor *>(sensor)->Update(measurementTime, false);
+  }
+}
+
 //////////////////////////////////////////////////
 void ImuPrivate::RemoveImuEntities(
     const EntityComponentManager &_ecm)
@@ -223,15 +351,38 @@ void ImuPrivate::RemoveImuEntities(
     [&](const Entity &_entity,
         const components::Imu *)->bool
       {
-        auto sensorId = this->entitySensorMap.find(_entity);
-        if (sensorId == this->entitySensorMap.end())
+        auto sensorId = this->sensorIndices.find(_entity);
+        if (sensorId == this->sensorIndices.end())
         {
           ignerr << "Internal error, missing IMU sensor for entity ["
                  << _entity << "]" << std::endl;
           return true;
         }
 
-        this->entitySensorMap.erase(sensorId);
+        // Swap the last row into the removed one so the arrays stay dense.
+        const std::size_t index = sensorId->second;
+        const std::size_t last = this->sensors.size() - 1;
+        if (index != last)
+        {
+          this->sensorEntities[index] = this->sensorEntities[last];
+          this->sensors[index] = std::move(this->sensors[last]);
+          this->worldPoses[index] = this->worldPoses[last];
+          this->angularVels[index] = this->angularVels[last];
+          this->linearAccels[index] = this->linearAccels[last];
+          this->staged[index] = this->staged[last];
+          this->kernelNoise[index] = this->kernelNoise[last];
+          this->sensorIndices[this->sensorEntities[index]] = index;
+        }
+        this->noiseKernel.SwapRemoveRow(index);
+
+        this->sensorEntities.pop_back();
+        this->sensors.pop_back();
+        this->worldPoses.pop_back();
+        this->angularVels.pop_back();
+        this->linearAccels.pop_back();
+        this->staged.pop_back();
+        this->kernelNoise.pop_back();
+        this->sensorIndices.erase(_entity);
 
         return true;
       });
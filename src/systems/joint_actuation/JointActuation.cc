@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <ignition/msgs/double.pb.h>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Profiler.hh>
+#include <ignition/math/PID.hh>
+#include <ignition/plugin/Register.hh>
+#include <ignition/transport/Node.hh>
+
+#include "ignition/gazebo/components/JointForceCmd.hh"
+#include "ignition/gazebo/components/JointVelocity.hh"
+#include "ignition/gazebo/components/JointVelocityCmd.hh"
+#include "ignition/gazebo/detail/MpscQueue.hh"
+#include "ignition/gazebo/Model.hh"
+
+#include "JointActuation.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+class ignition::gazebo::systems::JointActuationPrivate
+{
+  /// \brief A command received on one of the topics, queued for the next
+  /// update.
+  public: struct Command
+  {
+    /// \brief Index into the actuators vector.
+    std::size_t index;
+
+    /// \brief True for a cmd_force message, false for cmd_vel.
+    bool isForce;
+
+    /// \brief Commanded value.
+    double value;
+  };
+
+  /// \brief State of one actuated joint. Kept in a contiguous vector so
+  /// the per-step pass walks a flat array.
+  public: struct Actuator
+  {
+    /// \brief Joint name from SDF.
+    std::string jointName;
+
+    /// \brief Joint entity, resolved lazily.
+    Entity joint{kNullEntity};
+
+    /// \brief Velocity PID, used when gains were configured.
+    math::PID pid;
+
+    /// \brief Whether PID gains were configured for this joint.
+    bool usePid{false};
+
+    /// \brief Latest commanded velocity.
+    double targetVel{0.0};
+
+    /// \brief Latest commanded (feedforward) force.
+    double ffForce{0.0};
+
+    /// \brief Whether a cmd_vel message has ever arrived. Until then no
+    /// velocity command component is written.
+    bool velReceived{false};
+
+    /// \brief Whether a cmd_force message has ever arrived. Force
+    /// presence suppresses velocity commands in Physics, so the force
+    /// component is only written once a command exists or PID is on.
+    bool forceReceived{false};
+  };
+
+  /// \brief Ignition communication node.
+  public: transport::Node node;
+
+  /// \brief All actuated joints of the model.
+  public: std::vector<Actuator> actuators;
+
+  /// \brief Commands queued by transport callbacks, drained once per
+  /// step. Callbacks never contend with the simulation loop on a mutex.
+  public: detail::MpscQueue<Command> commands;
+
+  /// \brief Model interface
+  public: Model model{kNullEntity};
+};
+
+//////////////////////////////////////////////////
+JointActuation::JointActuation()
+  : dataPtr(std::make_unique<JointActuationPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+void JointActuation::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &/*_eventMgr*/)
+{
+  this->dataPtr->model = Model(_entity);
+
+  if (!this->dataPtr->model.Valid(_ecm))
+  {
+    ignerr << "JointActuation plugin should be attached to a model entity. "
+           << "Failed to initialize." << std::endl;
+    return;
+  }
+
+  auto sdfClone = _sdf->Clone();
+
+  if (!sdfClone->HasElement("actuator"))
+  {
+    ignerr << "JointActuation found no <actuator> elements. "
+           << "Failed to initialize." << std::endl;
+    return;
+  }
+
+  for (auto elem = sdfClone->GetElement("actuator"); elem;
+       elem = elem->GetNextElement("actuator"))
+  {
+    JointActuationPrivate::Actuator actuator;
+    actuator.jointName = elem->Get<std::string>("joint_name", "").first;
+    if (actuator.jointName.empty())
+    {
+      ignerr << "JointActuation found an <actuator> without a <joint_name>. "
+             << "Skipping it." << std::endl;
+      continue;
+    }
+
+    if (elem->HasElement("p_gain") || elem->HasElement("i_gain") ||
+        elem->HasElement("d_gain"))
+    {
+      actuator.usePid = true;
+      actuator.pid.Init(
+          elem->Get<double>("p_gain", 1.0).first,
+          elem->Get<double>("i_gain", 0.0).first,
+          elem->Get<double>("d_gain", 0.0).first,
+          elem->Get<double>("i_max", 1.0).first,
+          elem->Get<double>("i_min", -1.0).first,
+          elem->Get<double>("cmd_max", -1.0).first,
+          elem->Get<double>("cmd_min", 0.0).first);
+    }
+
+    const std::size_t index = this->dataPtr->actuators.size();
+    this->dataPtr->actuators.push_back(actuator);
+
+    std::string topicBase{"/model/" + this->dataPtr->model.Name(_ecm) +
+                          "/joint/" + actuator.jointName};
+
+    // The callbacks just queue; everything else happens in the single
+    // per-step pass.
+    auto *dataPtr = this->dataPtr.get();
+    std::function<void(const msgs::Double &)> velCb =
+        [dataPtr, index](const msgs::Double &_msg)
+        {
+          dataPtr->commands.Push({index, false, _msg.data()});
+        };
+    this->dataPtr->node.Subscribe(topicBase + "/cmd_vel", velCb);
+
+    std::function<void(const msgs::Double &)> forceCb =
+        [dataPtr, index](const msgs::Double &_msg)
+        {
+          dataPtr->commands.Push({index, true, _msg.data()});
+        };
+    this->dataPtr->node.Subscribe(topicBase + "/cmd_force", forceCb);
+
+    ignmsg << "JointActuation subscribing to Double messages on ["
+           << topicBase << "/cmd_vel] and [" << topicBase << "/cmd_force]"
+           << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+void JointActuation::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
+    ignition::gazebo::EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("JointActuation::PreUpdate");
+
+  // \TODO(anyone) Support rewind
+  if (_info.dt < std::chrono::steady_clock::duration::zero())
+  {
+    ignwarn << "Detected jump back in time ["
+        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
+        << "s]. System may not work properly." << std::endl;
+  }
+
+  // Fold everything that arrived since the last step into the actuator
+  // state. Later commands win.
+  for (const auto &cmd : this->dataPtr->commands.DrainAll())
+  {
+    auto &actuator = this->dataPtr->actuators[cmd.index];
+    if (cmd.isForce)
+    {
+      actuator.ffForce = cmd.value;
+      actuator.forceReceived = true;
+    }
+    else
+    {
+      actuator.targetVel = cmd.value;
+      actuator.velReceived = true;
+    }
+  }
+
+  // Nothing left to do if paused.
+  if (_info.paused)
+    return;
+
+  // One pass over the flat actuator array evaluates every joint.
+  for (auto &actuator : this->dataPtr->actuators)
+  {
+    // If the joint hasn't been identified yet, look for it
+    if (actuator.joint == kNullEntity)
+    {
+      actuator.joint =
+          this->dataPtr->model.JointByName(_ecm, actuator.jointName);
+      if (actuator.joint == kNullEntity)
+        continue;
+    }
+
+    if (actuator.usePid)
+    {
+      // Ask Physics to fill in the joint velocity, and drive it to the
+      // target with feedforward force plus the PID correction.
+      auto jointVel =
+          _ecm.Component<components::JointVelocity>(actuator.joint);
+      if (nullptr == jointVel)
+      {
+        _ecm.CreateComponent(actuator.joint, components::JointVelocity());
+        continue;
+      }
+
+      double velocity =
+          jointVel->Data().empty() ? 0.0 : jointVel->Data()[0];
+      double forceCmd = actuator.ffForce +
+          actuator.pid.Update(velocity - actuator.targetVel, _info.dt);
+
+      auto force = _ecm.Component<components::JointForceCmd>(actuator.joint);
+      if (nullptr == force)
+        _ecm.CreateComponent(actuator.joint,
+            components::JointForceCmd({forceCmd}));
+      else
+        force->Data()[0] += forceCmd;
+
+      continue;
+    }
+
+    // Pass-through mode, matching JointController and ApplyJointForce.
+    if (actuator.velReceived)
+    {
+      auto vel = _ecm.Component<components::JointVelocityCmd>(actuator.joint);
+      if (nullptr == vel)
+        _ecm.CreateComponent(actuator.joint,
+            components::JointVelocityCmd({actuator.targetVel}));
+      else
+        vel->Data()[0] = actuator.targetVel;
+    }
+
+    if (actuator.forceReceived)
+    {
+      auto force = _ecm.Component<components::JointForceCmd>(actuator.joint);
+      if (nullptr == force)
+        _ecm.CreateComponent(actuator.joint,
+            components::JointForceCmd({actuator.ffForce}));
+      else
+        force->Data()[0] += actuator.ffForce;
+    }
+  }
+}
+
+IGNITION_ADD_PLUGIN(JointActuation,
+                    ignition::gazebo::System,
+                    JointActuation::ISystemConfigure,
+                    JointActuation::ISystemPreUpdate)
+
+IGNITION_ADD_PLUGIN_ALIAS(JointActuation,
+                          "ignition::gazebo::systems::JointActuation")
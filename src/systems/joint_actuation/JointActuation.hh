@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_GAZEBO_SYSTEMS_JOINTACTUATION_HH_
+#define IGNITION_GAZEBO_SYSTEMS_JOINTACTUATION_HH_
+
+#include <ignition/gazebo/System.hh>
+#include <memory>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declaration
+  class JointActuationPrivate;
+
+  /// \brief Fused actuation for all the joints of a model. One instance
+  /// replaces a JointController and/or ApplyJointForce per joint: commands
+  /// from all topics go through a single lock-free queue, and one pass per
+  /// step evaluates feedforward force plus an optional velocity PID from
+  /// contiguous per-actuator state, writing the command components that
+  /// Physics consumes. Currently only the first axis of a joint is
+  /// actuated.
+  ///
+  /// Configuration: one `<actuator>` element per joint, holding
+  /// `<joint_name>` and optionally the velocity PID gains `<p_gain>`,
+  /// `<i_gain>`, `<d_gain>`, `<i_max>`, `<i_min>`, `<cmd_max>` and
+  /// `<cmd_min>`. Each actuator subscribes to
+  /// `/model/<model>/joint/<joint>/cmd_vel` and `.../cmd_force`. With
+  /// gains, both commands fold into one JointForceCmd
+  /// (feedforward + PID on velocity error); without gains, cmd_vel
+  /// writes JointVelocityCmd and cmd_force writes JointForceCmd
+  /// directly, matching JointController and ApplyJointForce.
+  class IGNITION_GAZEBO_VISIBLE JointActuation
+      : public System,
+        public ISystemConfigure,
+        public ISystemPreUpdate
+  {
+    /// \brief Constructor
+    public: JointActuation();
+
+    /// \brief Destructor
+    public: ~JointActuation() override = default;
+
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) override;
+
+    // Documentation inherited
+    public: void PreUpdate(
+                const ignition::gazebo::UpdateInfo &_info,
+                ignition::gazebo::EntityComponentManager &_ecm) override;
+
+    /// \brief Private data pointer
+    private: std::unique_ptr<JointActuationPrivate> dataPtr;
+  };
+  }
+}
+}
+}
+
+#endif
@@ -39,7 +39,7 @@ JointStatePublisher::JointStatePublisher()
 
 //////////////////////////////////////////////////
 void JointStatePublisher::Configure(
-    const Entity &_entity, const std::shared_ptr<const sdf::Element> &,
+    const Entity &_entity, const std::shared_ptr<const sdf::Element> &_sdf,
     EntityComponentManager &_ecm, EventManager &)
 {
   // Get the model.
@@ -51,6 +51,12 @@ void JointStatePublisher::Configure(
     return;
   }
 
+  if (_sdf->HasElement("batch_window_ms"))
+  {
+    this->batchWindow = std::chrono::milliseconds(
+        _sdf->Get<int>("batch_window_ms"));
+  }
+
   // Create the position, velocity, and force components for the joint.
   std::vector<Entity> childJoints = _ecm.ChildrenByComponents(
       this->model.Entity(), components::Joint());
@@ -78,13 +84,36 @@ void JointStatePublisher::Configure(
   }
 }
 
+//////////////////////////////////////////////////
+void JointStatePublisher::InitializeMessage(const EntityComponentManager &_ecm)
+{
+  this->joints = _ecm.ChildrenByComponents(
+      this->model.Entity(), components::Joint());
+
+  this->msg.Clear();
+
+  // Set the name and ID.
+  this->msg.set_name(this->model.Name(_ecm));
+  this->msg.set_id(this->model.Entity());
+
+  // Add a message per joint with the fields that never change.
+  for (const Entity &joint : this->joints)
+  {
+    msgs::Joint *jointMsg = this->msg.add_joint();
+    jointMsg->set_name(_ecm.Component<components::Name>(joint)->Data());
+    jointMsg->set_id(joint);
+  }
+
+  this->msgInitialized = true;
+}
+
 //////////////////////////////////////////////////
 void JointStatePublisher::PostUpdate(const UpdateInfo &_info,
                                 const EntityComponentManager &_ecm)
 {
   // Create the model state publisher. This can't be done in ::Configure
   // because the World is not guaranteed to be accessible.
-  if (!this->modelPub)
+  if (!this->modelPub && !this->batchPub.Valid())
   {
     std::string worldName;
 
@@ -99,39 +128,55 @@ void JointStatePublisher::PostUpdate(const UpdateInfo &_info,
       // Advertise the state topic
       std::string topic = std::string("/world/") + worldName + "/model/"
         + this->model.Name(_ecm) + "/joint_state";
-      this->modelPub = std::make_unique<transport::Node::Publisher>(
-          this->node.Advertise<msgs::Model>(topic));
+      if (this->batchWindow > std::chrono::steady_clock::duration::zero())
+      {
+        this->batchPub.Init(this->node, topic, "ignition.msgs.Model",
+            this->batchWindow);
+      }
+      else
+      {
+        this->modelPub = std::make_unique<transport::Node::Publisher>(
+            this->node.Advertise<msgs::Model>(topic));
+      }
     }
   }
 
   // Skip if we couldn't create the publisher.
-  if (!this->modelPub)
+  if (!this->modelPub && !this->batchPub.Valid())
     return;
 
-  // Create the message
-  msgs::Model msg;
-  msg.mutable_header()->mutable_stamp()->CopyFrom(
-      convert<msgs::Time>(_info.simTime));
+  // Rebuild the message skeleton when it hasn't been built yet or when the
+  // model's joints may have changed, e.g. a joint was detached.
+  bool initialize = !this->msgInitialized || _ecm.HasNewEntities();
+  if (!initialize)
+  {
+    for (const Entity &joint : this->joints)
+    {
+      if (!_ecm.HasEntity(joint))
+      {
+        initialize = true;
+        break;
+      }
+    }
+  }
+  if (initialize)
+    this->InitializeMessage(_ecm);
 
-  // Set the name and ID.
-  msg.set_name(this->model.Name(_ecm));
-  msg.set_id(this->model.Entity());
+  // Only the numeric fields below change between updates; the skeleton
+  // (names, ids, ordering) is reused from InitializeMessage.
+  set(this->msg.mutable_header()->mutable_stamp(), _info.simTime);
 
   // Set the model pose
   const auto *pose = _ecm.Component<components::Pose>(
       this->model.Entity());
   if (pose)
-    msgs::Set(msg.mutable_pose(), pose->Data());
+    msgs::Set(this->msg.mutable_pose(), pose->Data());
 
   // Process each joint
-  std::vector<Entity> childJoints = _ecm.ChildrenByComponents(
-      this->model.Entity(), components::Joint());
-  for (const Entity &joint : childJoints)
+  for (std::size_t j = 0; j < this->joints.size(); ++j)
   {
-    // Add a joint message.
-    msgs::Joint *jointMsg = msg.add_joint();
-    jointMsg->set_name(_ecm.Component<components::Name>(joint)->Data());
-    jointMsg->set_id(joint);
+    const Entity &joint = this->joints[j];
+    msgs::Joint *jointMsg = this->msg.mutable_joint(static_cast<int>(j));
 
     // Set the joint pose
     pose = _ecm.Component<components::Pose>(joint);
@@ -188,7 +233,10 @@ void JointStatePublisher::PostUpdate(const UpdateInfo &_info,
   }
 
   // Publish the message.
-  this->modelPub->Publish(msg);
+  if (this->batchPub.Valid())
+    this->batchPub.Publish(this->msg);
+  else
+    this->modelPub->Publish(this->msg);
 }
 
 IGNITION_ADD_PLUGIN(JointStatePublisher,
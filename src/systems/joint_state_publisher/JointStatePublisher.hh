@@ -18,7 +18,11 @@
 #ifndef IGNITION_GAZEBO_SYSTEMS_STATE_PUBLISHER_HH_
 #define IGNITION_GAZEBO_SYSTEMS_STATE_PUBLISHER_HH_
 
+#include <chrono>
 #include <memory>
+#include <vector>
+#include <ignition/msgs/model.pb.h>
+#include <ignition/gazebo/BatchingPublisher.hh>
 #include <ignition/gazebo/Model.hh>
 #include <ignition/transport/Node.hh>
 #include <ignition/gazebo/System.hh>
@@ -34,6 +38,12 @@ namespace systems
   /// \brief The JointStatePub system publishes state information for
   /// a model. The published message type is ignition::msgs::Model, and the
   /// publication topic is "/world/<world_name>/model/<model_name>/state".
+  ///
+  /// The optional `<batch_window_ms>` SDF parameter batches messages
+  /// within the given wall-clock window into one envelope on
+  /// `<topic>/batched` instead of publishing each step, amortizing
+  /// per-publish overhead at high update rates. Subscribers split the
+  /// envelope with gazebo::BatchSubscriber.
   class IGNITION_GAZEBO_VISIBLE JointStatePublisher
       : public System,
         public ISystemConfigure,
@@ -54,14 +64,39 @@ namespace systems
     public: void PostUpdate(const UpdateInfo &_info,
                             const EntityComponentManager &_ecm) final;
 
+    /// \brief Build the message skeleton: model and joint names, ids, and
+    /// ordering. These fields do not change between updates, so they are
+    /// filled once here and only the numeric fields are overwritten each
+    /// cycle in PostUpdate.
+    /// \param[in] _ecm Immutable reference to the entity component manager
+    private: void InitializeMessage(const EntityComponentManager &_ecm);
+
     /// \brief The model
     private: Model model;
 
+    /// \brief Cached child joints of the model, in message order
+    private: std::vector<Entity> joints;
+
+    /// \brief Preallocated message published every cycle. The skeleton is
+    /// built by InitializeMessage and reused between updates.
+    private: msgs::Model msg;
+
+    /// \brief Whether the message skeleton has been built
+    private: bool msgInitialized{false};
+
     /// \brief The communication node
     private: transport::Node node;
 
     /// \brief The publisher
     private: std::unique_ptr<transport::Node::Publisher> modelPub;
+
+    /// \brief Batching window from `<batch_window_ms>`. Zero publishes
+    /// each message individually.
+    private: std::chrono::steady_clock::duration batchWindow{0};
+
+    /// \brief Batch publisher, used instead of modelPub when a batch
+    /// window is configured.
+    private: BatchingPublisher batchPub;
   };
   }
 }
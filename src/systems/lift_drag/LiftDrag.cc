@@ -16,6 +16,9 @@
  */
 
 #include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <map>
 #include <vector>
 
 #include <ignition/common/Profiler.hh>
@@ -43,16 +46,414 @@ using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
+namespace
+{
+/// \brief Aggregates every loaded LiftDrag surface so the aerodynamics of an
+/// airframe are evaluated in a single pass per step. The kinematic state of
+/// each link is fetched once and shared by all surfaces attached to it, and
+/// their forces and torques are accumulated into one wrench per link instead
+/// of one wrench command per surface. This uses the same process-wide
+/// registry pattern as the linear battery pool: every LiftDrag system calls
+/// UpdateAll, and the first call of a step does the work for all of them.
+class LiftDragPool
+{
+  /// \brief Index value used for surfaces that are not registered.
+  public: static constexpr std::size_t kInvalidIndex{
+              std::numeric_limits<std::size_t>::max()};
+
+  /// \brief Parameters and target entities of one lifting surface. See the
+  /// LiftDragPrivate members of the same names for documentation.
+  public: struct Surface
+  {
+    bool active{false};
+    Entity linkEntity{kNullEntity};
+    Entity controlJointEntity{kNullEntity};
+    double cla{1.0};
+    double cda{0.01};
+    double cma{0.01};
+    double alphaStall{IGN_PI_2};
+    double claStall{0.0};
+    double cdaStall{1.0};
+    double cmaStall{0.0};
+    double rho{1.2041};
+    bool radialSymmetry{false};
+    double area{1.0};
+    double alpha0{0.0};
+    math::Vector3d cp{math::Vector3d::Zero};
+    math::Vector3d forward{math::Vector3d::UnitX};
+    math::Vector3d upward{math::Vector3d::UnitZ};
+    double controlJointRadToCL{4.0};
+  };
+
+  /// \brief Get the process-wide pool instance.
+  public: static LiftDragPool &Instance()
+  {
+    static LiftDragPool instance;
+    return instance;
+  }
+
+  /// \brief Register a surface with the pool.
+  /// \param[in] _surface Surface parameters. The active flag is set here.
+  /// \return Index of the surface's row in the pool.
+  public: std::size_t Register(const Surface &_surface)
+  {
+    Surface surface = _surface;
+    surface.active = true;
+
+    // Reuse a row freed by a previously unregistered surface, if any.
+    for (std::size_t i = 0; i < this->surfaces.size(); ++i)
+    {
+      if (!this->surfaces[i].active)
+      {
+        this->surfaces[i] = surface;
+        return i;
+      }
+    }
+
+    this->surfaces.push_back(surface);
+    return this->surfaces.size() - 1;
+  }
+
+  /// \brief Remove a surface from the pool.
+  /// \param[in] _index Index returned by Register.
+  public: void Unregister(std::size_t _index)
+  {
+    if (_index < this->surfaces.size())
+      this->surfaces[_index].active = false;
+  }
+
+  /// \brief Evaluate all registered surfaces and apply one accumulated
+  /// wrench per link. Only the first call of a given iteration does any
+  /// work; subsequent calls from the other LiftDrag systems return
+  /// immediately.
+  /// \param[in] _ecm Mutable reference to the EntityComponentManager.
+  /// \param[in] _iteration Current iteration count from UpdateInfo.
+  public: void UpdateAll(EntityComponentManager &_ecm, uint64_t _iteration)
+  {
+    if (_iteration == this->lastIteration)
+      return;
+    this->lastIteration = _iteration;
+
+    IGN_PROFILE("LiftDragPool::UpdateAll");
+
+    this->linkStates.clear();
+
+    // First pass: accumulate the wrench of every surface into the state of
+    // its link. The link state is fetched once per link, not per surface.
+    for (Surface &surface : this->surfaces)
+    {
+      if (!surface.active)
+        continue;
+
+      auto stateIt = this->linkStates.find(surface.linkEntity);
+      if (stateIt == this->linkStates.end())
+      {
+        LinkState state;
+
+        // Skip the aerodynamics while the link's level is loaded only as a
+        // buffer zone.
+        if (!_ecm.EntityLevelBuffered(surface.linkEntity))
+        {
+          const auto worldLinVel =
+              _ecm.Component<components::WorldLinearVelocity>(
+              surface.linkEntity);
+          const auto worldAngVel =
+              _ecm.Component<components::WorldAngularVelocity>(
+              surface.linkEntity);
+          const auto worldPose =
+              _ecm.Component<components::WorldPose>(surface.linkEntity);
+
+          if (worldLinVel && worldAngVel && worldPose)
+          {
+            state.valid = true;
+            state.pose = worldPose->Data();
+            state.linVel = worldLinVel->Data();
+            state.angVel = worldAngVel->Data();
+          }
+        }
+
+        stateIt = this->linkStates.emplace(surface.linkEntity, state).first;
+      }
+
+      if (!stateIt->second.valid)
+        continue;
+
+      components::JointPosition *controlJointPosition = nullptr;
+      if (surface.controlJointEntity != kNullEntity)
+      {
+        controlJointPosition = _ecm.Component<components::JointPosition>(
+            surface.controlJointEntity);
+      }
+
+      this->AccumulateSurface(surface, controlJointPosition,
+          stateIt->second);
+    }
+
+    // Second pass: one wrench command per link.
+    for (auto &[linkEntity, state] : this->linkStates)
+    {
+      if (!state.valid || !state.hasWrench)
+        continue;
+
+      Link link(linkEntity);
+      link.AddWorldWrench(_ecm, state.force, state.torque);
+    }
+  }
+
+  /// \brief Kinematic state of a link, shared by its surfaces, and the
+  /// wrench accumulated over them.
+  private: struct LinkState
+  {
+    bool valid{false};
+    math::Pose3d pose;
+    math::Vector3d linVel{math::Vector3d::Zero};
+    math::Vector3d angVel{math::Vector3d::Zero};
+    bool hasWrench{false};
+    math::Vector3d force{math::Vector3d::Zero};
+    math::Vector3d torque{math::Vector3d::Zero};
+  };
+
+  /// \brief Compute the lift and drag of one surface and add them to the
+  /// wrench accumulated on its link.
+  /// \param[in] _surface Surface to evaluate. The center of pressure may be
+  /// corrected for nan or inf.
+  /// \param[in] _controlJointPosition Position of the surface's control
+  /// joint, or nullptr if it has none.
+  /// \param[in, out] _state Shared state of the surface's link.
+  private: void AccumulateSurface(Surface &_surface,
+               const components::JointPosition *_controlJointPosition,
+               LinkState &_state) const
+  {
+    const auto &pose = _state.pose;
+    const auto cpWorld = pose.Rot().RotateVector(_surface.cp);
+
+    // get linear velocity at cp in world frame
+    const auto vel = _state.linVel + _state.angVel.Cross(cpWorld);
+
+    if (vel.Length() <= 0.01)
+      return;
+
+    const auto velI = vel.Normalized();
+
+    // rotate forward and upward vectors into world frame
+    const auto forwardI = pose.Rot().RotateVector(_surface.forward);
+
+    ignition::math::Vector3d upwardI;
+    if (_surface.radialSymmetry)
+    {
+      // use inflow velocity to determine upward direction
+      // which is the component of inflow perpendicular to forward direction.
+      ignition::math::Vector3d tmp = forwardI.Cross(velI);
+      upwardI = forwardI.Cross(tmp).Normalize();
+    }
+    else
+    {
+      upwardI = pose.Rot().RotateVector(_surface.upward);
+    }
+
+    // spanwiseI: a vector normal to lift-drag-plane described in world frame
+    const auto spanwiseI = forwardI.Cross(upwardI).Normalize();
+
+    const double minRatio = -1.0;
+    const double maxRatio = 1.0;
+    // check sweep (angle between velI and lift-drag-plane)
+    double sinSweepAngle = ignition::math::clamp(
+        spanwiseI.Dot(velI), minRatio, maxRatio);
+
+    // get cos from trig identity
+    const double cosSweepAngle = 1.0 - sinSweepAngle * sinSweepAngle;
+    double sweep = std::asin(sinSweepAngle);
+
+    // truncate sweep to within +/-90 deg
+    while (std::fabs(sweep) > 0.5 * IGN_PI)
+    {
+      sweep = sweep > 0 ? sweep - IGN_PI : sweep + IGN_PI;
+    }
+
+    // angle of attack is the angle between
+    // velI projected into lift-drag plane
+    //  and
+    // forward vector
+    //
+    // projected = spanwiseI Xcross ( vector Xcross spanwiseI)
+    //
+    // so,
+    // removing spanwise velocity from vel
+    // Note: Original code had:
+    //    const auto velInLDPlane = vel - vel.Dot(spanwiseI)*velI;
+    // I believe the projection should be onto spanwiseI which then gets
+    // removed from vel
+    const auto velInLDPlane = vel - vel.Dot(spanwiseI)*spanwiseI;
+
+    // get direction of drag
+    const auto dragDirection = -velInLDPlane.Normalized();
+
+    // get direction of lift
+    const auto liftI = spanwiseI.Cross(velInLDPlane).Normalized();
+
+    // compute angle between upwardI and liftI
+    // in general, given vectors a and b:
+    //   cos(theta) = a.Dot(b)/(a.Length()*b.Lenghth())
+    // given upwardI and liftI are both unit vectors, we can drop the
+    // denominator
+    //   cos(theta) = a.Dot(b)
+    const double cosAlpha =
+        ignition::math::clamp(liftI.Dot(upwardI), minRatio, maxRatio);
+
+    // Is alpha positive or negative? Test:
+    // forwardI points toward zero alpha
+    // if forwardI is in the same direction as lift, alpha is positive.
+    // liftI is in the same direction as forwardI?
+    double alpha = _surface.alpha0 - std::acos(cosAlpha);
+    if (liftI.Dot(forwardI) >= 0.0)
+      alpha = _surface.alpha0 + std::acos(cosAlpha);
+
+    // normalize to within +/-90 deg
+    while (fabs(alpha) > 0.5 * IGN_PI)
+    {
+      alpha = alpha > 0 ? alpha - IGN_PI : alpha + IGN_PI;
+    }
+
+    // compute dynamic pressure
+    const double speedInLDPlane = velInLDPlane.Length();
+    const double q = 0.5 * _surface.rho * speedInLDPlane * speedInLDPlane;
+
+    // compute cl at cp, check for stall, correct for sweep
+    double cl;
+    if (alpha > _surface.alphaStall)
+    {
+      cl = (_surface.cla * _surface.alphaStall +
+            _surface.claStall * (alpha - _surface.alphaStall)) *
+           cosSweepAngle;
+      // make sure cl is still great than 0
+      cl = std::max(0.0, cl);
+    }
+    else if (alpha < -_surface.alphaStall)
+    {
+      cl = (-_surface.cla * _surface.alphaStall +
+            _surface.claStall * (alpha + _surface.alphaStall))
+           * cosSweepAngle;
+      // make sure cl is still less than 0
+      cl = std::min(0.0, cl);
+    }
+    else
+      cl = _surface.cla * alpha * cosSweepAngle;
+
+    // modify cl per control joint value
+    if (_controlJointPosition)
+    {
+      cl = cl +
+          _surface.controlJointRadToCL * _controlJointPosition->Data()[0];
+      /// \todo(anyone): also change cm and cd
+    }
+
+    // compute lift force at cp
+    ignition::math::Vector3d lift = cl * q * _surface.area * liftI;
+
+    // compute cd at cp, check for stall, correct for sweep
+    double cd;
+    if (alpha > _surface.alphaStall)
+    {
+      cd = (_surface.cda * _surface.alphaStall +
+            _surface.cdaStall * (alpha - _surface.alphaStall))
+           * cosSweepAngle;
+    }
+    else if (alpha < -_surface.alphaStall)
+    {
+      cd = (-_surface.cda * _surface.alphaStall +
+            _surface.cdaStall * (alpha + _surface.alphaStall))
+           * cosSweepAngle;
+    }
+    else
+      cd = (_surface.cda * alpha) * cosSweepAngle;
+
+    // make sure drag is positive
+    cd = std::fabs(cd);
+
+    // drag at cp
+    ignition::math::Vector3d drag = cd * q * _surface.area * dragDirection;
+
+    // compute cm at cp, check for stall, correct for sweep
+    double cm;
+    if (alpha > _surface.alphaStall)
+    {
+      cm = (_surface.cma * _surface.alphaStall +
+            _surface.cmaStall * (alpha - _surface.alphaStall))
+           * cosSweepAngle;
+      // make sure cm is still great than 0
+      cm = std::max(0.0, cm);
+    }
+    else if (alpha < -_surface.alphaStall)
+    {
+      cm = (-_surface.cma * _surface.alphaStall +
+            _surface.cmaStall * (alpha + _surface.alphaStall))
+           * cosSweepAngle;
+      // make sure cm is still less than 0
+      cm = std::min(0.0, cm);
+    }
+    else
+      cm = _surface.cma * alpha * cosSweepAngle;
+
+    /// \todo(anyone): implement cm
+    /// for now, reset cm to zero, as cm needs testing
+    cm = 0.0;
+
+    // compute moment (torque) at cp
+    // spanwiseI used to be momentDirection
+    ignition::math::Vector3d moment = cm * q * _surface.area * spanwiseI;
+
+    // force and torque about cg in world frame
+    ignition::math::Vector3d force = lift + drag;
+    ignition::math::Vector3d torque = moment;
+    // Correct for nan or inf
+    force.Correct();
+    _surface.cp.Correct();
+    torque.Correct();
+
+    // We want to apply the force at cp. The old LiftDrag plugin did the
+    // following:
+    //     this->link->AddForceAtRelativePosition(force, this->cp);
+    // The documentation of AddForceAtRelativePosition says:
+    //> Add a force (in world frame coordinates) to the body at a
+    //> position relative to the center of mass which is expressed in the
+    //> link's own frame of reference.
+    // But it appears that 'cp' is specified in the link frame so it probably
+    // should have been
+    //     this->link->AddForceAtRelativePosition(
+    //         force, this->cp - this->link->GetInertial()->CoG());
+    //
+    // \todo(addisu) Create a convenient API for applying forces at offset
+    // positions
+    _state.force += force;
+    _state.torque += torque + cpWorld.Cross(force);
+    _state.hasWrench = true;
+  }
+
+  /// \brief All registered surfaces, contiguous so a step sweeps them in
+  /// order.
+  private: std::vector<Surface> surfaces;
+
+  /// \brief Per-link shared state and accumulated wrenches, reused between
+  /// steps.
+  private: std::map<Entity, LinkState> linkStates;
+
+  /// \brief Iteration of the last pooled update, used to run once per step.
+  private: uint64_t lastIteration{std::numeric_limits<uint64_t>::max()};
+};
+}
+
 class ignition::gazebo::systems::LiftDragPrivate
 {
   // Initialize the system
   public: void Load(const EntityComponentManager &_ecm,
                     const sdf::ElementPtr &_sdf);
 
-  /// \brief Compute lift and drag forces and update the corresponding
-  /// components
-  /// \param[in] _ecm Immutable reference to the EntityComponentManager
-  public: void Update(EntityComponentManager &_ecm);
+  /// \brief Destructor. Removes the surface from the pool.
+  public: ~LiftDragPrivate()
+  {
+    if (this->poolIndex != LiftDragPool::kInvalidIndex)
+      LiftDragPool::Instance().Unregister(this->poolIndex);
+  }
 
   /// \brief Model interface
   public: Model model{kNullEntity};
@@ -134,6 +535,10 @@ class ignition::gazebo::systems::LiftDragPrivate
 
   /// \brief Initialization flag
   public: bool initialized{false};
+
+  /// \brief Index of this surface in the pool, or kInvalidIndex while it is
+  /// not registered.
+  public: std::size_t poolIndex{LiftDragPool::kInvalidIndex};
 };
 
 //////////////////////////////////////////////////
@@ -211,254 +616,6 @@ LiftDrag::LiftDrag()
 {
 }
 
-//////////////////////////////////////////////////
-void LiftDragPrivate::Update(EntityComponentManager &_ecm)
-{
-  IGN_PROFILE("LiftDragPrivate::Update");
-  // get linear velocity at cp in world frame
-  const auto worldLinVel =
-      _ecm.Component<components::WorldLinearVelocity>(this->linkEntity);
-  const auto worldAngVel =
-      _ecm.Component<components::WorldAngularVelocity>(this->linkEntity);
-  const auto worldPose =
-      _ecm.Component<components::WorldPose>(this->linkEntity);
-
-  components::JointPosition *controlJointPosition = nullptr;
-  if (this->controlJointEntity != kNullEntity)
-  {
-    controlJointPosition =
-        _ecm.Component<components::JointPosition>(this->controlJointEntity);
-  }
-
-  if (!worldLinVel || !worldAngVel || !worldPose)
-    return;
-
-  const auto &pose = worldPose->Data();
-  const auto cpWorld = pose.Rot().RotateVector(this->cp);
-  const auto vel = worldLinVel->Data() + worldAngVel->Data().Cross(cpWorld);
-
-  if (vel.Length() <= 0.01)
-    return;
-
-  const auto velI = vel.Normalized();
-
-  // rotate forward and upward vectors into world frame
-  const auto forwardI = pose.Rot().RotateVector(this->forward);
-
-  ignition::math::Vector3d upwardI;
-  if (this->radialSymmetry)
-  {
-    // use inflow velocity to determine upward direction
-    // which is the component of inflow perpendicular to forward direction.
-    ignition::math::Vector3d tmp = forwardI.Cross(velI);
-    upwardI = forwardI.Cross(tmp).Normalize();
-  }
-  else
-  {
-    upwardI = pose.Rot().RotateVector(this->upward);
-  }
-
-  // spanwiseI: a vector normal to lift-drag-plane described in world frame
-  const auto spanwiseI = forwardI.Cross(upwardI).Normalize();
-
-  const double minRatio = -1.0;
-  const double maxRatio = 1.0;
-  // check sweep (angle between velI and lift-drag-plane)
-  double sinSweepAngle = ignition::math::clamp(
-      spanwiseI.Dot(velI), minRatio, maxRatio);
-
-  // get cos from trig identity
-  const double cosSweepAngle = 1.0 - sinSweepAngle * sinSweepAngle;
-  double sweep = std::asin(sinSweepAngle);
-
-  // truncate sweep to within +/-90 deg
-  while (std::fabs(sweep) > 0.5 * IGN_PI)
-  {
-    sweep = sweep > 0 ? sweep - IGN_PI : sweep + IGN_PI;
-  }
-
-  // angle of attack is the angle between
-  // velI projected into lift-drag plane
-  //  and
-  // forward vector
-  //
-  // projected = spanwiseI Xcross ( vector Xcross spanwiseI)
-  //
-  // so,
-  // removing spanwise velocity from vel
-  // Note: Original code had:
-  //    const auto velInLDPlane = vel - vel.Dot(spanwiseI)*velI;
-  // I believe the projection should be onto spanwiseI which then gets removed
-  // from vel
-  const auto velInLDPlane = vel - vel.Dot(spanwiseI)*spanwiseI;
-
-  // get direction of drag
-  const auto dragDirection = -velInLDPlane.Normalized();
-
-  // get direction of lift
-  const auto liftI = spanwiseI.Cross(velInLDPlane).Normalized();
-
-  // compute angle between upwardI and liftI
-  // in general, given vectors a and b:
-  //   cos(theta) = a.Dot(b)/(a.Length()*b.Lenghth())
-  // given upwardI and liftI are both unit vectors, we can drop the denominator
-  //   cos(theta) = a.Dot(b)
-  const double cosAlpha =
-      ignition::math::clamp(liftI.Dot(upwardI), minRatio, maxRatio);
-
-  // Is alpha positive or negative? Test:
-  // forwardI points toward zero alpha
-  // if forwardI is in the same direction as lift, alpha is positive.
-  // liftI is in the same direction as forwardI?
-  double alpha = this->alpha0 - std::acos(cosAlpha);
-  if (liftI.Dot(forwardI) >= 0.0)
-    alpha = this->alpha0 + std::acos(cosAlpha);
-
-  // normalize to within +/-90 deg
-  while (fabs(alpha) > 0.5 * IGN_PI)
-  {
-    alpha = alpha > 0 ? alpha - IGN_PI : alpha + IGN_PI;
-  }
-
-  // compute dynamic pressure
-  const double speedInLDPlane = velInLDPlane.Length();
-  const double q = 0.5 * this->rho * speedInLDPlane * speedInLDPlane;
-
-  // compute cl at cp, check for stall, correct for sweep
-  double cl;
-  if (alpha > this->alphaStall)
-  {
-    cl = (this->cla * this->alphaStall +
-          this->claStall * (alpha - this->alphaStall)) *
-         cosSweepAngle;
-    // make sure cl is still great than 0
-    cl = std::max(0.0, cl);
-  }
-  else if (alpha < -this->alphaStall)
-  {
-    cl = (-this->cla * this->alphaStall +
-          this->claStall * (alpha + this->alphaStall))
-         * cosSweepAngle;
-    // make sure cl is still less than 0
-    cl = std::min(0.0, cl);
-  }
-  else
-    cl = this->cla * alpha * cosSweepAngle;
-
-  // modify cl per control joint value
-  if (controlJointPosition)
-  {
-    cl = cl + this->controlJointRadToCL * controlJointPosition->Data()[0];
-    /// \todo(anyone): also change cm and cd
-  }
-
-  // compute lift force at cp
-  ignition::math::Vector3d lift = cl * q * this->area * liftI;
-
-  // compute cd at cp, check for stall, correct for sweep
-  double cd;
-  if (alpha > this->alphaStall)
-  {
-    cd = (this->cda * this->alphaStall +
-          this->cdaStall * (alpha - this->alphaStall))
-         * cosSweepAngle;
-  }
-  else if (alpha < -this->alphaStall)
-  {
-    cd = (-this->cda * this->alphaStall +
-          this->cdaStall * (alpha + this->alphaStall))
-         * cosSweepAngle;
-  }
-  else
-    cd = (this->cda * alpha) * cosSweepAngle;
-
-  // make sure drag is positive
-  cd = std::fabs(cd);
-
-  // drag at cp
-  ignition::math::Vector3d drag = cd * q * this->area * dragDirection;
-
-  // compute cm at cp, check for stall, correct for sweep
-  double cm;
-  if (alpha > this->alphaStall)
-  {
-    cm = (this->cma * this->alphaStall +
-          this->cmaStall * (alpha - this->alphaStall))
-         * cosSweepAngle;
-    // make sure cm is still great than 0
-    cm = std::max(0.0, cm);
-  }
-  else if (alpha < -this->alphaStall)
-  {
-    cm = (-this->cma * this->alphaStall +
-          this->cmaStall * (alpha + this->alphaStall))
-         * cosSweepAngle;
-    // make sure cm is still less than 0
-    cm = std::min(0.0, cm);
-  }
-  else
-    cm = this->cma * alpha * cosSweepAngle;
-
-  /// \todo(anyone): implement cm
-  /// for now, reset cm to zero, as cm needs testing
-  cm = 0.0;
-
-  // compute moment (torque) at cp
-  // spanwiseI used to be momentDirection
-  ignition::math::Vector3d moment = cm * q * this->area * spanwiseI;
-
-
-  // force and torque about cg in world frame
-  ignition::math::Vector3d force = lift + drag;
-  ignition::math::Vector3d torque = moment;
-  // Correct for nan or inf
-  force.Correct();
-  this->cp.Correct();
-  torque.Correct();
-
-  // We want to apply the force at cp. The old LiftDrag plugin did the
-  // following:
-  //     this->link->AddForceAtRelativePosition(force, this->cp);
-  // The documentation of AddForceAtRelativePosition says:
-  //> Add a force (in world frame coordinates) to the body at a
-  //> position relative to the center of mass which is expressed in the
-  //> link's own frame of reference.
-  // But it appears that 'cp' is specified in the link frame so it probably
-  // should have been
-  //     this->link->AddForceAtRelativePosition(
-  //         force, this->cp - this->link->GetInertial()->CoG());
-  //
-  // \todo(addisu) Create a convenient API for applying forces at offset
-  // positions
-  const auto totalTorque = torque + cpWorld.Cross(force);
-  Link link(this->linkEntity);
-  link.AddWorldWrench(_ecm, force, totalTorque);
-
-  // Debug
-  // auto linkName = _ecm.Component<components::Name>(this->linkEntity)->Data();
-  // igndbg << "=============================\n";
-  // igndbg << "Link: [" << linkName << "] pose: [" << pose
-  //        << "] dynamic pressure: [" << q << "]\n";
-  // igndbg << "spd: [" << vel.Length() << "] vel: [" << vel << "]\n";
-  // igndbg << "LD plane spd: [" << velInLDPlane.Length() << "] vel : ["
-  //        << velInLDPlane << "]\n";
-  // igndbg << "forward (inertial): " << forwardI << "\n";
-  // igndbg << "upward (inertial): " << upwardI << "\n";
-  // igndbg << "q: " << q << "\n";
-  // igndbg << "cl: " << cl << "\n";
-  // igndbg << "lift dir (inertial): " << liftI << "\n";
-  // igndbg << "Span direction (normal to LD plane): " << spanwiseI << "\n";
-  // igndbg << "sweep: " << sweep << "\n";
-  // igndbg << "alpha: " << alpha << "\n";
-  // igndbg << "lift: " << lift << "\n";
-  // igndbg << "drag: " << drag << " cd: " << cd << " cda: "
-  //        << this->cda << "\n";
-  // igndbg << "moment: " << moment << "\n";
-  // igndbg << "force: " << force << "\n";
-  // igndbg << "torque: " << torque << "\n";
-  // igndbg << "totalTorque: " << totalTorque << "\n";
-}
-
 //////////////////////////////////////////////////
 void LiftDrag::Configure(const Entity &_entity,
                          const std::shared_ptr<const sdf::Element> &_sdf,
@@ -523,6 +680,28 @@ void LiftDrag::PreUpdate(const UpdateInfo &_info, EntityComponentManager &_ecm)
         _ecm.CreateComponent(this->dataPtr->controlJointEntity,
             components::JointPosition());
       }
+
+      // Register this surface so the pooled pass evaluates it together with
+      // the other surfaces of the airframe.
+      LiftDragPool::Surface surface;
+      surface.linkEntity = this->dataPtr->linkEntity;
+      surface.controlJointEntity = this->dataPtr->controlJointEntity;
+      surface.cla = this->dataPtr->cla;
+      surface.cda = this->dataPtr->cda;
+      surface.cma = this->dataPtr->cma;
+      surface.alphaStall = this->dataPtr->alphaStall;
+      surface.claStall = this->dataPtr->claStall;
+      surface.cdaStall = this->dataPtr->cdaStall;
+      surface.cmaStall = this->dataPtr->cmaStall;
+      surface.rho = this->dataPtr->rho;
+      surface.radialSymmetry = this->dataPtr->radialSymmetry;
+      surface.area = this->dataPtr->area;
+      surface.alpha0 = this->dataPtr->alpha0;
+      surface.cp = this->dataPtr->cp;
+      surface.forward = this->dataPtr->forward;
+      surface.upward = this->dataPtr->upward;
+      surface.controlJointRadToCL = this->dataPtr->controlJointRadToCL;
+      this->dataPtr->poolIndex = LiftDragPool::Instance().Register(surface);
     }
   }
 
@@ -533,7 +712,10 @@ void LiftDrag::PreUpdate(const UpdateInfo &_info, EntityComponentManager &_ecm)
   // above
   if (this->dataPtr->initialized && this->dataPtr->validConfig)
   {
-    this->dataPtr->Update(_ecm);
+    // All registered surfaces are evaluated in one pooled pass; the first
+    // LiftDrag system to get here in a step does the work for every
+    // airframe.
+    LiftDragPool::Instance().UpdateAll(_ecm, _info.iterations);
   }
 }
 
@@ -19,7 +19,22 @@
 
 #include <ignition/msgs/pose_v.pb.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <set>
 #include <string>
+#include <unordered_set>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <ignition/common/Filesystem.hh>
 #include <ignition/common/Profiler.hh>
@@ -39,8 +54,11 @@
 #include "ignition/gazebo/Conversions.hh"
 #include "ignition/gazebo/Events.hh"
 #include "ignition/gazebo/SdfEntityCreator.hh"
+#include "ignition/gazebo/StaticSystemRegistry.hh"
+#include "ignition/gazebo/components/Factory.hh"
 #include "ignition/gazebo/components/Geometry.hh"
 #include "ignition/gazebo/components/Material.hh"
+#include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/Pose.hh"
 
 using namespace ignition;
@@ -86,14 +104,81 @@ class ignition::gazebo::systems::LogPlaybackPrivate
   public: void Parse(EntityComponentManager &_ecm,
       const msgs::SerializedStateMap &_msg);
 
+  /// \brief Load the chunk index footer from a chunked state recording,
+  /// if one exists next to the transport log.
+  /// \return True if a valid chunk index was loaded.
+  public: bool LoadChunkIndex();
+
+  /// \brief Replay chunked state records whose sim time falls in
+  /// [_startNs, _endNs], starting from the chunk at or before _startNs.
+  /// \param[in] _ecm Mutable ECM.
+  /// \param[in] _startNs Start sim time in nanoseconds, inclusive.
+  /// \param[in] _endNs End sim time in nanoseconds, inclusive.
+  /// \param[in] _trackRemovals True while seeking back in time, to keep
+  /// the removal list consistent with entity insertions and deletions.
+  /// \param[in, out] _entitiesToRemove Entities to remove after a seek.
+  public: void ReplayChunkedState(EntityComponentManager &_ecm,
+      int64_t _startNs, int64_t _endNs, bool _trackRemovals,
+      std::set<Entity> &_entitiesToRemove);
+
+  /// \brief Index entry for one chunk of a chunked state recording.
+  public: struct ChunkIndexEntry
+  {
+    /// \brief Sim time of the keyframe starting the chunk, in nanoseconds.
+    int64_t simTimeNs;
+
+    /// \brief Offset of the chunk from the start of the file.
+    uint64_t offset;
+  };
+
+  /// \brief Index of chunks, loaded from the chunk file footer. Sorted by
+  /// sim time, so seeks are a binary search.
+  public: std::vector<ChunkIndexEntry> chunkIndex;
+
+  /// \brief Strip components whose type is not in the materialize set, so
+  /// they are never parsed out of their serialized payload nor created in
+  /// the ECM. Entity creations and removals are always kept.
+  /// \param[in, out] _msg State message to prune in place.
+  public: void FilterComponents(msgs::SerializedStateMap &_msg) const;
+
+  /// \brief Stream for the chunked state file.
+  public: std::ifstream chunkFile;
+
+  /// \brief Whether states are played back from a chunked recording
+  /// instead of the transport log.
+  public: bool useChunks{false};
+
+#ifndef _WIN32
+  /// \brief Memory mapping of the chunked state file, so record payloads
+  /// are materialized on demand by the page cache instead of being copied
+  /// through stream reads. Null if the file could not be mapped.
+  public: const char *chunkData{nullptr};
+
+  /// \brief Size of the memory mapping in bytes.
+  public: uint64_t chunkDataSize{0};
+#endif
+
+  /// \brief Component types to materialize into the ECM during playback.
+  /// Empty means all recorded types are applied.
+  public: std::unordered_set<ComponentTypeId> materializeTypes;
+
   /// \brief A batch of data from log file, of all pose messages
   public: transport::log::Batch batch;
 
   /// \brief Pointer to ign-transport Log
   public: std::unique_ptr<transport::log::Log> log;
 
-  /// \brief Indicator of whether any playback instance has ever been started
-  public: static bool started;
+  /// \brief Names of worlds for which a playback instance has been
+  /// started. Independent worlds can be played back in the same process,
+  /// e.g. by batch playback; two playbacks of the same world would
+  /// collide on its topics, so only the first one is started.
+  public: static std::set<std::string> startedWorlds;
+
+  /// \brief Protects startedWorlds.
+  public: static std::mutex startedMutex;
+
+  /// \brief Name of the world this instance plays back into.
+  public: std::string worldName;
 
   /// \brief Directory in which to place log file
   public: std::string logPath{""};
@@ -115,7 +200,26 @@ class ignition::gazebo::systems::LogPlaybackPrivate
   public: bool doReplaceResourceURIs{true};
 };
 
-bool LogPlaybackPrivate::started{false};
+std::set<std::string> LogPlaybackPrivate::startedWorlds;
+std::mutex LogPlaybackPrivate::startedMutex;
+
+/// \brief Magic bytes identifying a chunked state file and its footer.
+static const char kChunkMagic[8] =
+    {'I', 'G', 'N', 'S', 'T', 'C', 'H', 'K'};
+
+/// \brief Version of the chunked state file layout understood here.
+static const uint64_t kChunkVersion = 1;
+
+//////////////////////////////////////////////////
+/// \brief Read a 64-bit word in native byte order.
+/// \param[in] _in Stream to read from.
+/// \param[out] _value Value read.
+/// \return True if the read succeeded.
+static bool ReadWord(std::ifstream &_in, uint64_t &_value)
+{
+  _in.read(reinterpret_cast<char *>(&_value), sizeof(_value));
+  return _in.good();
+}
 
 //////////////////////////////////////////////////
 LogPlayback::LogPlayback()
@@ -126,6 +230,14 @@ LogPlayback::LogPlayback()
 //////////////////////////////////////////////////
 LogPlayback::~LogPlayback()
 {
+#ifndef _WIN32
+  if (this->dataPtr->chunkData)
+  {
+    munmap(const_cast<char *>(this->dataPtr->chunkData),
+      this->dataPtr->chunkDataSize);
+  }
+#endif
+
   if (!this->dataPtr->extDest.empty())
   {
     common::removeAll(this->dataPtr->extDest);
@@ -189,6 +301,272 @@ void LogPlaybackPrivate::Parse(EntityComponentManager &_ecm,
   _ecm.SetState(_msg);
 }
 
+//////////////////////////////////////////////////
+void LogPlaybackPrivate::FilterComponents(msgs::SerializedStateMap &_msg)
+    const
+{
+  if (this->materializeTypes.empty())
+    return;
+
+  for (auto &entityPair : *_msg.mutable_entities())
+  {
+    auto &entityMsg = entityPair.second;
+
+    // Entity removals must always be applied
+    if (entityMsg.remove())
+      continue;
+
+    std::vector<int64_t> skipped;
+    for (const auto &compPair : entityMsg.components())
+    {
+      if (this->materializeTypes.find(compPair.second.type()) ==
+          this->materializeTypes.end())
+      {
+        skipped.push_back(compPair.first);
+      }
+    }
+
+    // Entities with all components filtered out are kept, so entity
+    // creations are not lost
+    for (const auto &type : skipped)
+      entityMsg.mutable_components()->erase(type);
+  }
+}
+
+//////////////////////////////////////////////////
+bool LogPlaybackPrivate::LoadChunkIndex()
+{
+  std::string chunkPath = common::joinPaths(this->logPath, "state.chunks");
+  if (!common::exists(chunkPath))
+    return false;
+
+  this->chunkFile.open(chunkPath, std::ios::in | std::ios::binary);
+  if (!this->chunkFile.is_open())
+  {
+    ignerr << "Failed to open chunk file [" << chunkPath << "]" << std::endl;
+    return false;
+  }
+
+  // Verify header magic and version
+  char magic[sizeof(kChunkMagic)];
+  uint64_t version = 0;
+  this->chunkFile.read(magic, sizeof(magic));
+  if (!this->chunkFile.good() ||
+      std::memcmp(magic, kChunkMagic, sizeof(magic)) != 0 ||
+      !ReadWord(this->chunkFile, version) || version != kChunkVersion)
+  {
+    ignerr << "Invalid chunk file [" << chunkPath << "]" << std::endl;
+    this->chunkFile.close();
+    return false;
+  }
+
+  // The trailer holds the index offset, the chunk count and the magic again
+  this->chunkFile.seekg(
+    -static_cast<std::streamoff>(2 * sizeof(uint64_t) + sizeof(magic)),
+    std::ios::end);
+  uint64_t indexOffset = 0;
+  uint64_t chunkCount = 0;
+  if (!ReadWord(this->chunkFile, indexOffset) ||
+      !ReadWord(this->chunkFile, chunkCount) ||
+      !this->chunkFile.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, kChunkMagic, sizeof(magic)) != 0)
+  {
+    ignerr << "Chunk file [" << chunkPath << "] has no index footer. "
+           << "Was the recording stopped cleanly?" << std::endl;
+    this->chunkFile.close();
+    return false;
+  }
+
+  this->chunkFile.seekg(indexOffset, std::ios::beg);
+  for (uint64_t i = 0; i < chunkCount; ++i)
+  {
+    uint64_t timeNs = 0;
+    uint64_t offset = 0;
+    if (!ReadWord(this->chunkFile, timeNs) ||
+        !ReadWord(this->chunkFile, offset))
+    {
+      ignerr << "Truncated chunk index in [" << chunkPath << "]"
+             << std::endl;
+      this->chunkIndex.clear();
+      this->chunkFile.close();
+      return false;
+    }
+    this->chunkIndex.push_back({static_cast<int64_t>(timeNs), offset});
+  }
+
+  if (this->chunkIndex.empty())
+  {
+    this->chunkFile.close();
+    return false;
+  }
+
+#ifndef _WIN32
+  // Map the file so records are paged in on demand and parsed straight
+  // out of the mapping, with the stream kept as a fallback
+  int fd = open(chunkPath.c_str(), O_RDONLY);
+  if (fd >= 0)
+  {
+    struct stat st;
+    if (fstat(fd, &st) == 0)
+    {
+      void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED)
+      {
+        this->chunkData = static_cast<const char *>(addr);
+        this->chunkDataSize = st.st_size;
+      }
+    }
+    close(fd);
+  }
+#endif
+
+  ignmsg << "Loaded chunked state index with " << this->chunkIndex.size()
+         << " keyframes" << std::endl;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LogPlaybackPrivate::ReplayChunkedState(EntityComponentManager &_ecm,
+    int64_t _startNs, int64_t _endNs, bool _trackRemovals,
+    std::set<Entity> &_entitiesToRemove)
+{
+  if (this->chunkIndex.empty())
+    return;
+
+  // Binary search for the last chunk whose keyframe is at or before the
+  // start time. Earlier chunks cannot contain records in range.
+  auto it = std::upper_bound(this->chunkIndex.begin(),
+    this->chunkIndex.end(), _startNs,
+    [](int64_t _t, const ChunkIndexEntry &_entry)
+    {
+      return _t < _entry.simTimeNs;
+    });
+  if (it != this->chunkIndex.begin())
+    --it;
+
+  // Read from the memory mapping when available, otherwise from the
+  // stream. With the mapping, record payloads are parsed in place.
+  uint64_t pos = 0;
+  bool mapped = false;
+#ifndef _WIN32
+  mapped = nullptr != this->chunkData;
+#endif
+
+  auto readWord = [&](uint64_t &_value) -> bool
+  {
+#ifndef _WIN32
+    if (mapped)
+    {
+      if (pos + sizeof(_value) > this->chunkDataSize)
+        return false;
+      std::memcpy(&_value, this->chunkData + pos, sizeof(_value));
+      pos += sizeof(_value);
+      return true;
+    }
+#endif
+    return ReadWord(this->chunkFile, _value);
+  };
+
+  for (; it != this->chunkIndex.end() && it->simTimeNs <= _endNs; ++it)
+  {
+    pos = it->offset;
+    if (!mapped)
+    {
+      this->chunkFile.clear();
+      this->chunkFile.seekg(it->offset, std::ios::beg);
+    }
+
+    uint64_t byteSize = 0;
+    uint64_t recordCount = 0;
+    if (!readWord(byteSize) || !readWord(recordCount))
+    {
+      ignerr << "Truncated chunk in chunked state file" << std::endl;
+      return;
+    }
+
+    for (uint64_t i = 0; i < recordCount; ++i)
+    {
+      uint64_t timeNs = 0;
+      uint64_t msgSize = 0;
+      if (!readWord(timeNs) || !readWord(msgSize))
+      {
+        ignerr << "Truncated record in chunked state file" << std::endl;
+        return;
+      }
+
+      auto recordTime = static_cast<int64_t>(timeNs);
+      if (recordTime > _endNs)
+        return;
+
+      if (recordTime < _startNs)
+      {
+        // Skip records before the requested range
+        if (mapped)
+          pos += msgSize;
+        else
+          this->chunkFile.seekg(msgSize, std::ios::cur);
+        continue;
+      }
+
+      msgs::SerializedStateMap msg;
+      bool parsed = false;
+#ifndef _WIN32
+      if (mapped)
+      {
+        if (pos + msgSize > this->chunkDataSize)
+        {
+          ignerr << "Truncated record in chunked state file" << std::endl;
+          return;
+        }
+        parsed = msg.ParseFromArray(this->chunkData + pos,
+          static_cast<int>(msgSize));
+        pos += msgSize;
+      }
+#endif
+      if (!mapped)
+      {
+        std::string data(msgSize, '\0');
+        this->chunkFile.read(&data[0], msgSize);
+        if (!this->chunkFile.good())
+        {
+          ignerr << "Truncated record in chunked state file" << std::endl;
+          return;
+        }
+        parsed = msg.ParseFromString(data);
+      }
+      if (!parsed)
+      {
+        ignerr << "Failed to parse record in chunked state file"
+               << std::endl;
+        return;
+      }
+
+      this->FilterComponents(msg);
+
+      // While seeking back in time, update the list of entities to be
+      // removed so we do not remove any entities that are to be created
+      if (_trackRemovals)
+      {
+        for (const auto &entIt : msg.entities())
+        {
+          const auto &entityMsg = entIt.second;
+          Entity entity{entityMsg.id()};
+          if (entityMsg.remove())
+          {
+            _entitiesToRemove.insert(entity);
+          }
+          else
+          {
+            _entitiesToRemove.erase(entity);
+          }
+        }
+      }
+
+      this->Parse(_ecm, msg);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void LogPlaybackPrivate::Parse(EntityComponentManager &_ecm,
     const msgs::SerializedState &_msg)
@@ -197,15 +575,63 @@ void LogPlaybackPrivate::Parse(EntityComponentManager &_ecm,
 }
 
 //////////////////////////////////////////////////
-void LogPlayback::Configure(const Entity &,
+void LogPlayback::Configure(const Entity &_entity,
     const std::shared_ptr<const sdf::Element> &_sdf,
     EntityComponentManager &_ecm, EventManager &_eventMgr)
 {
+  auto nameComp = _ecm.Component<components::Name>(_entity);
+  if (nameComp)
+    this->dataPtr->worldName = nameComp->Data();
+
   // Get directory paths from SDF
   this->dataPtr->logPath = _sdf->Get<std::string>("path");
 
   this->dataPtr->eventManager = &_eventMgr;
 
+  // Optional on-demand materialization. Each <materialize> element names a
+  // component type (e.g. "Pose", or the full registered name) to apply to
+  // the ECM during playback; all other component payloads are skipped
+  // without ever being parsed. Useful for pose-only visualization of
+  // large logs. No <materialize> element means all types are applied.
+  if (_sdf->HasElement("materialize"))
+  {
+    auto *factory = components::Factory::Instance();
+    auto typeIds = factory->TypeIds();
+    auto sdfClone = _sdf->Clone();
+    for (auto elem = sdfClone->GetElement("materialize"); elem;
+        elem = elem->GetNextElement("materialize"))
+    {
+      auto name = elem->Get<std::string>();
+      bool found = false;
+      for (const auto &typeId : typeIds)
+      {
+        auto registered = factory->Name(typeId);
+        // Accept the full registered name or the suffix after the last '.'
+        if (registered == name ||
+            (registered.size() > name.size() + 1 &&
+            registered.compare(registered.size() - name.size() - 1,
+            name.size() + 1, "." + name) == 0))
+        {
+          this->dataPtr->materializeTypes.insert(typeId);
+          found = true;
+          break;
+        }
+      }
+      if (!found)
+      {
+        ignwarn << "Unknown component type [" << name
+                << "] in <materialize>, ignoring." << std::endl;
+      }
+    }
+
+    if (!this->dataPtr->materializeTypes.empty())
+    {
+      ignmsg << "Materializing only "
+             << this->dataPtr->materializeTypes.size()
+             << " component type(s) during playback" << std::endl;
+    }
+  }
+
   // Prepend working directory if path is relative
   this->dataPtr->logPath = common::absPath(this->dataPtr->logPath);
 
@@ -220,28 +646,28 @@ void LogPlayback::Configure(const Entity &,
     }
   }
 
-  // Enforce only one playback instance
-  if (!LogPlaybackPrivate::started)
+  // Enforce only one playback instance per world
+  bool alreadyStarted;
+  {
+    std::lock_guard<std::mutex> lock(LogPlaybackPrivate::startedMutex);
+    alreadyStarted = LogPlaybackPrivate::startedWorlds.find(
+      this->dataPtr->worldName) != LogPlaybackPrivate::startedWorlds.end();
+  }
+
+  if (!alreadyStarted)
   {
     this->dataPtr->Start(_ecm);
   }
   else
   {
-    ignwarn << "A LogPlayback instance has already been started. "
-      << "Will not start another.\n";
+    ignwarn << "A LogPlayback instance has already been started for world ["
+      << this->dataPtr->worldName << "]. Will not start another.\n";
   }
 }
 
 //////////////////////////////////////////////////
 bool LogPlaybackPrivate::Start(EntityComponentManager &_ecm)
 {
-  if (LogPlaybackPrivate::started)
-  {
-    ignwarn << "A LogPlayback instance has already been started. "
-      << "Will not start another.\n";
-    return true;
-  }
-
   if (this->logPath.empty())
   {
     ignerr << "Unspecified log path to playback. Nothing to play.\n";
@@ -265,6 +691,10 @@ bool LogPlaybackPrivate::Start(EntityComponentManager &_ecm)
     ignerr << "Failed to open log file [" << dbPath << "]" << std::endl;
   }
 
+  // A chunked recording stores the state stream in a side file next to
+  // the transport log
+  this->useChunks = this->LoadChunkIndex();
+
   // Access all messages in .tlog file
   this->batch = this->log->QueryMessages();
   auto iter = this->batch.begin();
@@ -274,31 +704,45 @@ bool LogPlaybackPrivate::Start(EntityComponentManager &_ecm)
     ignerr << "No messages found in log file [" << dbPath << "]" << std::endl;
   }
 
-  // Look for the first SerializedState message and use it to set the initial
-  // state of the world. Messages received before this are ignored.
-  for (; iter != this->batch.end(); ++iter)
+  if (this->useChunks)
   {
-    auto msgType = iter->Type();
-    if (msgType == "ignition.msgs.SerializedState")
-    {
-      msgs::SerializedState msg;
-      msg.ParseFromString(iter->Data());
-      this->Parse(_ecm, msg);
-      break;
-    }
-    else if (msgType == "ignition.msgs.SerializedStateMap")
+    // The first record of the first chunk is the initial full state
+    std::set<Entity> unused;
+    this->ReplayChunkedState(_ecm, this->chunkIndex.front().simTimeNs,
+      this->chunkIndex.front().simTimeNs, false, unused);
+  }
+  else
+  {
+    // Look for the first SerializedState message and use it to set the
+    // initial state of the world. Messages received before this are ignored.
+    for (; iter != this->batch.end(); ++iter)
     {
-      msgs::SerializedStateMap msg;
-      msg.ParseFromString(iter->Data());
-      this->Parse(_ecm, msg);
-      break;
+      auto msgType = iter->Type();
+      if (msgType == "ignition.msgs.SerializedState")
+      {
+        msgs::SerializedState msg;
+        msg.ParseFromString(iter->Data());
+        this->Parse(_ecm, msg);
+        break;
+      }
+      else if (msgType == "ignition.msgs.SerializedStateMap")
+      {
+        msgs::SerializedStateMap msg;
+        msg.ParseFromString(iter->Data());
+        this->FilterComponents(msg);
+        this->Parse(_ecm, msg);
+        break;
+      }
     }
   }
 
   this->ReplaceResourceURIs(_ecm);
 
   this->instStarted = true;
-  LogPlaybackPrivate::started = true;
+  {
+    std::lock_guard<std::mutex> lock(LogPlaybackPrivate::startedMutex);
+    LogPlaybackPrivate::startedWorlds.insert(this->worldName);
+  }
   return true;
 }
 
@@ -497,11 +941,46 @@ void LogPlayback::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
       entitiesToRemove.insert(Entity(entity.first));
 
     startTime = std::chrono::steady_clock::duration::zero();
+
+    // With a chunked recording we can instead seek to the keyframe at or
+    // before the target time, found with a binary search on the index
+    if (this->dataPtr->useChunks)
+    {
+      auto endNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        endTime).count();
+      auto it = std::upper_bound(this->dataPtr->chunkIndex.begin(),
+        this->dataPtr->chunkIndex.end(), endNs,
+        [](int64_t _t, const LogPlaybackPrivate::ChunkIndexEntry &_entry)
+        {
+          return _t < _entry.simTimeNs;
+        });
+      if (it != this->dataPtr->chunkIndex.begin())
+        --it;
+      startTime = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::nanoseconds(it->simTimeNs));
+    }
   }
 
   this->dataPtr->batch = this->dataPtr->log->QueryMessages(
       transport::log::AllTopics({startTime, endTime}));
 
+  // States of a chunked recording live in the side file rather than the
+  // transport log
+  if (this->dataPtr->useChunks)
+  {
+    auto startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      startTime).count();
+    auto endNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      endTime).count();
+    // Records at startTime were already applied in the previous step
+    if (!seekRewind)
+      startNs += 1;
+    this->dataPtr->ReplayChunkedState(_ecm, startNs, endNs, seekRewind,
+      entitiesToRemove);
+    this->dataPtr->ReplaceResourceURIs(_ecm);
+  }
+
   msgs::Pose_V queuedPose;
 
   auto iter = this->dataPtr->batch.begin();
@@ -551,6 +1030,7 @@ void LogPlayback::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
     {
       msgs::SerializedStateMap msg;
       msg.ParseFromString(iter->Data());
+      this->dataPtr->FilterComponents(msg);
 
       // For seeking back in time only:
       // While stepping, update the list of entities to be removed
@@ -617,3 +1097,5 @@ IGNITION_ADD_PLUGIN(ignition::gazebo::systems::LogPlayback,
 
 IGNITION_ADD_PLUGIN_ALIAS(ignition::gazebo::systems::LogPlayback,
                           "ignition::gazebo::systems::LogPlayback")
+
+IGNITION_GAZEBO_ADD_STATIC_SYSTEM(ignition::gazebo::systems::LogPlayback)
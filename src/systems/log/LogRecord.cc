@@ -25,6 +25,15 @@
 #include <ctime>
 #include <set>
 #include <list>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Filesystem.hh>
@@ -48,6 +57,7 @@
 #include <sdf/Visual.hh>
 #include <sdf/World.hh>
 
+#include "ignition/gazebo/components/Factory.hh"
 #include "ignition/gazebo/components/Geometry.hh"
 #include "ignition/gazebo/components/Light.hh"
 #include "ignition/gazebo/components/Link.hh"
@@ -57,6 +67,8 @@
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/SourceFilePath.hh"
 #include "ignition/gazebo/components/Visual.hh"
+#include "ignition/gazebo/detail/SpscRing.hh"
+#include "ignition/gazebo/StaticSystemRegistry.hh"
 #include "ignition/gazebo/Util.hh"
 
 using namespace ignition;
@@ -102,6 +114,44 @@ class ignition::gazebo::systems::LogRecordPrivate
   /// \brief Compress model resource files and state file into one file.
   public: void CompressStateAndResources();
 
+  /// \brief Drop components whose serialized payload is byte-identical to
+  /// the one recorded in the previous frame, so a pose that did not move
+  /// is only stored once. Created and removed entities are kept in full.
+  /// \param[in, out] _msg State message to prune in place.
+  public: void DropUnchangedComponents(msgs::SerializedStateMap &_msg);
+
+  /// \brief Reset the previous-frame payload cache to the contents of a
+  /// full state keyframe.
+  /// \param[in] _msg Keyframe state message.
+  public: void RefreshComponentCache(const msgs::SerializedStateMap &_msg);
+
+  /// \brief Apply the configured include/exclude recording filters to a
+  /// state message, before it is serialized. Filtered data costs neither
+  /// serialization time nor disk.
+  /// \param[in, out] _msg State message to prune in place.
+  /// \param[in] _ecm Immutable ECM, used to resolve excluded subtrees.
+  public: void FilterState(msgs::SerializedStateMap &_msg,
+    const EntityComponentManager &_ecm);
+
+  /// \brief Append one serialized state message to the chunked state file.
+  /// Records are buffered in memory and handed to the IO thread through
+  /// the wait-free chunk ring whenever the current chunk reaches the
+  /// configured chunk size, so the simulation thread never blocks on
+  /// disk.
+  /// \param[in] _data Serialized SerializedStateMap message.
+  /// \param[in] _simTimeNs Sim time of the record in nanoseconds.
+  public: void AppendChunkedState(const std::string &_data,
+    int64_t _simTimeNs);
+
+  /// \brief Loop run by the chunk IO thread. Takes finished chunks off
+  /// the ring, appends them to the chunk file and keeps the index up to
+  /// date. Writes the index footer before exiting.
+  public: void ChunkWriteLoop();
+
+  /// \brief Flush the last partial chunk, stop the IO thread and close the
+  /// chunk file.
+  public: void FinishChunkedState();
+
   /// \brief Indicator of whether any recorder instance has ever been started.
   /// Currently, only one instance is allowed. This enforcement may be removed
   /// in the future.
@@ -155,8 +205,118 @@ class ignition::gazebo::systems::LogRecordPrivate
 
   /// \brief List of saved models if record with resources is enabled.
   public: std::set<std::string> savedModels;
+
+  /// \brief Whether to record state messages to a chunked binary side file
+  /// instead of per-message records in the transport log.
+  public: bool chunkedState{false};
+
+  /// \brief Target chunk size in bytes.
+  public: uint64_t chunkSize{1024 * 1024};
+
+  /// \brief Stream for the chunked state file.
+  public: std::ofstream chunkFile;
+
+  /// \brief Records accumulated for the chunk currently being built.
+  public: std::string chunkBuffer;
+
+  /// \brief Sim time of the first record in the current chunk.
+  public: int64_t chunkFirstTimeNs{0};
+
+  /// \brief Number of records in the current chunk.
+  public: uint64_t chunkRecordCount{0};
+
+  /// \brief Index entry for one finished chunk.
+  public: struct ChunkIndexEntry
+  {
+    /// \brief Sim time of the first record in the chunk, in nanoseconds.
+    int64_t simTimeNs;
+
+    /// \brief Offset of the chunk from the start of the file.
+    uint64_t offset;
+  };
+
+  /// \brief Index of finished chunks, written as the file footer.
+  public: std::vector<ChunkIndexEntry> chunkIndex;
+
+  /// \brief Finished chunks on their way to the IO thread, paired with
+  /// the sim time of their first record. The ring is wait-free on both
+  /// sides: handing a chunk over costs the simulation thread a move and
+  /// two atomic operations, so a write stall in the IO thread can never
+  /// reach into the step. When the disk falls so far behind that the
+  /// ring fills up, the chunk is dropped and counted instead of
+  /// stalling; each chunk starts with a keyframe, so the log stays
+  /// consistent and only loses that interval of history.
+  public: detail::SpscRing<std::pair<int64_t, std::string>> chunkRing{16};
+
+  /// \brief Number of chunks dropped because the ring was full. Written
+  /// by the simulation thread, read once the IO thread has exited.
+  public: uint64_t chunkRingFullCount{0};
+
+  /// \brief Dedicated IO thread that appends chunks to the chunk file.
+  public: std::thread chunkThread;
+
+  /// \brief Tells the IO thread to exit once the ring is drained.
+  public: std::atomic<bool> chunkStop{false};
+
+  /// \brief Serialized payload of each component as of the previous frame,
+  /// keyed by entity and component type. Used to drop unchanged repeats.
+  public: std::map<std::pair<uint64_t, int64_t>, std::string>
+    lastComponentData;
+
+  /// \brief Component types to record. Empty means all types are recorded.
+  public: std::unordered_set<ComponentTypeId> recordComponentTypes;
+
+  /// \brief Component types to exclude from recording.
+  public: std::unordered_set<ComponentTypeId> excludeComponentTypes;
+
+  /// \brief Names of entities whose subtrees are excluded from recording.
+  /// Names are resolved to entities lazily, as the entities may not exist
+  /// yet when the plugin is configured.
+  public: std::list<std::string> excludeEntityNames;
+
+  /// \brief Resolved roots of excluded entity subtrees.
+  public: std::unordered_set<Entity> excludedEntities;
 };
 
+/// \brief Magic bytes identifying a chunked state file and its footer.
+static const char kChunkMagic[8] =
+    {'I', 'G', 'N', 'S', 'T', 'C', 'H', 'K'};
+
+/// \brief Version of the chunked state file layout.
+static const uint64_t kChunkVersion = 1;
+
+//////////////////////////////////////////////////
+/// \brief Resolve a component type name to its registered type id. Both
+/// the full registered name and the suffix after the last '.' are
+/// accepted, so "Pose" matches "ign_gazebo_components.Pose".
+/// \param[in] _name Component type name.
+/// \return Type id, or kComponentTypeIdInvalid if not registered.
+static gazebo::ComponentTypeId ResolveComponentType(const std::string &_name)
+{
+  auto *factory = gazebo::components::Factory::Instance();
+  for (const auto &typeId : factory->TypeIds())
+  {
+    auto registered = factory->Name(typeId);
+    if (registered == _name ||
+        (registered.size() > _name.size() + 1 &&
+        registered.compare(registered.size() - _name.size() - 1,
+        _name.size() + 1, "." + _name) == 0))
+    {
+      return typeId;
+    }
+  }
+  return gazebo::kComponentTypeIdInvalid;
+}
+
+//////////////////////////////////////////////////
+/// \brief Append a 64-bit word to a buffer in its native byte order.
+/// \param[in, out] _buf Buffer to append to.
+/// \param[in] _value Value to append.
+static void AppendWord(std::string &_buf, uint64_t _value)
+{
+  _buf.append(reinterpret_cast<const char *>(&_value), sizeof(_value));
+}
+
 bool LogRecordPrivate::started{false};
 
 //////////////////////////////////////////////////
@@ -185,6 +345,7 @@ LogRecord::~LogRecord()
   {
     // Use ign-transport directly
     this->dataPtr->recorder.Stop();
+    this->dataPtr->FinishChunkedState();
 
     if (this->dataPtr->compress)
       this->dataPtr->CompressStateAndResources();
@@ -209,6 +370,55 @@ void LogRecord::Configure(const Entity &_entity,
   this->dataPtr->compress = _sdf->Get<bool>("compress", false).first;
   this->dataPtr->cmpPath = _sdf->Get<std::string>("compress_path", "").first;
 
+  // Optional chunked state recording. Instead of one sqlite record per
+  // state message, states are batched into fixed-size chunks appended to a
+  // binary side file by a dedicated IO thread.
+  this->dataPtr->chunkedState = _sdf->Get<bool>("chunked_state",
+    false).first;
+  this->dataPtr->chunkSize = _sdf->Get<uint64_t>("chunk_size",
+    this->dataPtr->chunkSize).first;
+
+  // Optional recording filters, applied before serialization. Each
+  // <record_component> element names a component type to record (empty
+  // means all), each <exclude_component> a type to drop, and each
+  // <exclude_entity> an entity whose whole subtree is left out. E.g.:
+  //   <record_component>Pose</record_component>
+  //   <record_component>JointPosition</record_component>
+  //   <exclude_entity>ground_plane</exclude_entity>
+  auto sdfClone = _sdf->Clone();
+  for (const auto &tag : {"record_component", "exclude_component"})
+  {
+    if (!_sdf->HasElement(tag))
+      continue;
+
+    auto &types = std::string(tag) == "record_component" ?
+      this->dataPtr->recordComponentTypes :
+      this->dataPtr->excludeComponentTypes;
+    for (auto elem = sdfClone->GetElement(tag); elem;
+        elem = elem->GetNextElement(tag))
+    {
+      auto name = elem->Get<std::string>();
+      auto typeId = ResolveComponentType(name);
+      if (kComponentTypeIdInvalid == typeId)
+      {
+        ignwarn << "Unknown component type [" << name << "] in <" << tag
+                << ">, ignoring." << std::endl;
+        continue;
+      }
+      types.insert(typeId);
+    }
+  }
+
+  if (_sdf->HasElement("exclude_entity"))
+  {
+    for (auto elem = sdfClone->GetElement("exclude_entity"); elem;
+        elem = elem->GetNextElement("exclude_entity"))
+    {
+      this->dataPtr->excludeEntityNames.push_back(
+        elem->Get<std::string>());
+    }
+  }
+
   // If plugin is specified in both the SDF tag and on command line, only
   //   activate one recorder.
   if (!LogRecordPrivate::started)
@@ -309,7 +519,10 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
   sdf::ElementPtr sdfWorld = sdfRoot->GetElement("world");
   this->recorder.AddTopic("/world/" + this->worldName + "/dynamic_pose/info");
   this->recorder.AddTopic(sdfTopic);
-  this->recorder.AddTopic(stateTopic);
+  // When recording chunked state, the high-rate state stream bypasses the
+  // per-message transport log and goes to the chunk file instead.
+  if (!this->chunkedState)
+    this->recorder.AddTopic(stateTopic);
   // this->recorder.AddTopic(std::regex(".*"));
 
   // Timestamp messages with sim time and republish that time on
@@ -324,6 +537,39 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
   if (this->recorder.Start(dbPath) ==
       ignition::transport::log::RecorderError::SUCCESS)
   {
+    if (this->chunkedState)
+    {
+      std::string chunkPath = common::joinPaths(this->logPath,
+        "state.chunks");
+      if (common::exists(chunkPath))
+      {
+        ignmsg << "Overwriting existing file [" << chunkPath << "]\n";
+        common::removeFile(chunkPath);
+      }
+
+      this->chunkFile.open(chunkPath,
+        std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!this->chunkFile.is_open())
+      {
+        ignerr << "Failed to open chunk file [" << chunkPath
+               << "]. Falling back to per-message state records."
+               << std::endl;
+        this->chunkedState = false;
+        this->recorder.AddTopic(stateTopic);
+      }
+      else
+      {
+        ignmsg << "Recording chunked state to [" << chunkPath << "]"
+               << std::endl;
+        this->chunkFile.write(kChunkMagic, sizeof(kChunkMagic));
+        std::string version;
+        AppendWord(version, kChunkVersion);
+        this->chunkFile.write(version.data(), version.size());
+        this->chunkThread = std::thread(
+          &LogRecordPrivate::ChunkWriteLoop, this);
+      }
+    }
+
     this->instStarted = true;
     return true;
   }
@@ -331,6 +577,284 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
     return false;
 }
 
+//////////////////////////////////////////////////
+void LogRecordPrivate::DropUnchangedComponents(msgs::SerializedStateMap &_msg)
+{
+  std::vector<uint64_t> emptyEntities;
+  for (auto &entityPair : *_msg.mutable_entities())
+  {
+    auto &entityMsg = entityPair.second;
+
+    // Removed entities must always be recorded; forget their cached
+    // payloads so an entity reusing the id starts fresh.
+    if (entityMsg.remove())
+    {
+      this->lastComponentData.erase(
+        this->lastComponentData.lower_bound(std::make_pair(entityMsg.id(),
+          std::numeric_limits<int64_t>::min())),
+        this->lastComponentData.lower_bound(std::make_pair(
+          entityMsg.id() + 1, std::numeric_limits<int64_t>::min())));
+      continue;
+    }
+
+    std::vector<int64_t> unchanged;
+    for (auto &compPair : *entityMsg.mutable_components())
+    {
+      auto key = std::make_pair(entityMsg.id(), compPair.second.type());
+
+      // Component removals must also be recorded
+      if (compPair.second.remove())
+      {
+        this->lastComponentData.erase(key);
+        continue;
+      }
+
+      auto lastIt = this->lastComponentData.find(key);
+      if (lastIt != this->lastComponentData.end() &&
+          lastIt->second == compPair.second.component())
+      {
+        unchanged.push_back(compPair.first);
+      }
+      else
+      {
+        this->lastComponentData[key] = compPair.second.component();
+      }
+    }
+
+    for (const auto &type : unchanged)
+      entityMsg.mutable_components()->erase(type);
+
+    if (entityMsg.components().empty())
+      emptyEntities.push_back(entityPair.first);
+  }
+
+  for (const auto &id : emptyEntities)
+    _msg.mutable_entities()->erase(id);
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::RefreshComponentCache(
+  const msgs::SerializedStateMap &_msg)
+{
+  this->lastComponentData.clear();
+  for (const auto &entityPair : _msg.entities())
+  {
+    const auto &entityMsg = entityPair.second;
+    if (entityMsg.remove())
+      continue;
+
+    for (const auto &compPair : entityMsg.components())
+    {
+      if (compPair.second.remove())
+        continue;
+
+      this->lastComponentData[std::make_pair(entityMsg.id(),
+        compPair.second.type())] = compPair.second.component();
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::FilterState(msgs::SerializedStateMap &_msg,
+  const EntityComponentManager &_ecm)
+{
+  if (this->recordComponentTypes.empty() &&
+      this->excludeComponentTypes.empty() &&
+      this->excludeEntityNames.empty() && this->excludedEntities.empty())
+  {
+    return;
+  }
+
+  // Resolve excluded subtree roots by name once their entities exist
+  for (auto nameIt = this->excludeEntityNames.begin();
+      nameIt != this->excludeEntityNames.end();)
+  {
+    auto entity = _ecm.EntityByComponents(components::Name(*nameIt));
+    if (kNullEntity != entity)
+    {
+      this->excludedEntities.insert(entity);
+      nameIt = this->excludeEntityNames.erase(nameIt);
+    }
+    else
+      ++nameIt;
+  }
+
+  std::vector<uint64_t> droppedEntities;
+  for (auto &entityPair : *_msg.mutable_entities())
+  {
+    auto &entityMsg = entityPair.second;
+
+    // Drop entities inside an excluded subtree
+    if (!this->excludedEntities.empty())
+    {
+      bool excluded = false;
+      for (auto e = Entity(entityMsg.id()); kNullEntity != e;
+          e = _ecm.ParentEntity(e))
+      {
+        if (this->excludedEntities.find(e) != this->excludedEntities.end())
+        {
+          excluded = true;
+          break;
+        }
+      }
+      if (excluded)
+      {
+        droppedEntities.push_back(entityPair.first);
+        continue;
+      }
+    }
+
+    // Entity removals must always be recorded
+    if (entityMsg.remove())
+      continue;
+
+    std::vector<int64_t> dropped;
+    for (const auto &compPair : entityMsg.components())
+    {
+      auto type = compPair.second.type();
+      if ((!this->recordComponentTypes.empty() &&
+          this->recordComponentTypes.find(type) ==
+          this->recordComponentTypes.end()) ||
+          this->excludeComponentTypes.find(type) !=
+          this->excludeComponentTypes.end())
+      {
+        dropped.push_back(compPair.first);
+      }
+    }
+
+    // Entities whose components were all filtered out are kept, so entity
+    // creations still land in the log
+    for (const auto &type : dropped)
+      entityMsg.mutable_components()->erase(type);
+  }
+
+  for (const auto &id : droppedEntities)
+    _msg.mutable_entities()->erase(id);
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::AppendChunkedState(const std::string &_data,
+  int64_t _simTimeNs)
+{
+  if (this->chunkRecordCount == 0u)
+    this->chunkFirstTimeNs = _simTimeNs;
+
+  AppendWord(this->chunkBuffer, static_cast<uint64_t>(_simTimeNs));
+  AppendWord(this->chunkBuffer, _data.size());
+  this->chunkBuffer += _data;
+  this->chunkRecordCount++;
+
+  if (this->chunkBuffer.size() < this->chunkSize)
+    return;
+
+  // Chunk is full. Prepend its header and hand it to the IO thread.
+  std::string chunk;
+  chunk.reserve(this->chunkBuffer.size() + 2 * sizeof(uint64_t));
+  AppendWord(chunk, this->chunkBuffer.size());
+  AppendWord(chunk, this->chunkRecordCount);
+  chunk += this->chunkBuffer;
+
+  auto record = std::make_pair(this->chunkFirstTimeNs, std::move(chunk));
+  if (!this->chunkRing.TryPush(record))
+  {
+    // A full ring means the disk cannot keep up; blocking here would put
+    // the write stall right back into the step. The next chunk starts
+    // with a fresh keyframe, so dropping this one loses its interval of
+    // history but keeps the log consistent.
+    this->chunkRingFullCount++;
+    ignwarn << "State chunk ring is full, dropping a "
+            << record.second.size() << " byte chunk. The disk is not "
+            << "keeping up with the recording rate." << std::endl;
+  }
+
+  this->chunkBuffer.clear();
+  this->chunkRecordCount = 0;
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::ChunkWriteLoop()
+{
+  // Chunk file layout, all words 64-bit in native byte order:
+  //   header:  8-byte magic, version
+  //   chunk:   byte size, record count, records
+  //   record:  sim time (ns), message size, serialized SerializedStateMap
+  // The first record of each chunk is a full state keyframe; the rest are
+  // changed states relative to it.
+  //   footer:  index entries (first sim time, chunk offset), followed by
+  //            index offset, chunk count, 8-byte magic
+  uint64_t offset = sizeof(kChunkMagic) + sizeof(uint64_t);
+  std::pair<int64_t, std::string> chunk;
+  while (true)
+  {
+    if (!this->chunkRing.TryPop(chunk))
+    {
+      // Drain the ring before exiting so no chunk is lost on shutdown
+      if (this->chunkStop.load(std::memory_order_acquire))
+        break;
+      // Chunks arrive every few hundred steps; an idle poll is cheaper
+      // than making the producer signal, which would cost it a lock.
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      continue;
+    }
+
+    this->chunkIndex.push_back({chunk.first, offset});
+    this->chunkFile.write(chunk.second.data(), chunk.second.size());
+    offset += chunk.second.size();
+  }
+
+  // The index footer lets playback binary-search for a sim time without
+  // scanning the chunks themselves.
+  uint64_t indexOffset = offset;
+  std::string footer;
+  for (const auto &entry : this->chunkIndex)
+  {
+    AppendWord(footer, static_cast<uint64_t>(entry.simTimeNs));
+    AppendWord(footer, entry.offset);
+  }
+  AppendWord(footer, indexOffset);
+  AppendWord(footer, this->chunkIndex.size());
+  footer.append(kChunkMagic, sizeof(kChunkMagic));
+  this->chunkFile.write(footer.data(), footer.size());
+  this->chunkFile.flush();
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::FinishChunkedState()
+{
+  if (!this->chunkThread.joinable())
+    return;
+
+  // Flush the last partial chunk
+  if (this->chunkRecordCount > 0u)
+  {
+    std::string chunk;
+    AppendWord(chunk, this->chunkBuffer.size());
+    AppendWord(chunk, this->chunkRecordCount);
+    chunk += this->chunkBuffer;
+
+    // The IO thread is still draining the ring at this point, so a full
+    // ring only means waiting for it, not dropping the end of the log.
+    auto record = std::make_pair(this->chunkFirstTimeNs, std::move(chunk));
+    while (!this->chunkRing.TryPush(record))
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    this->chunkBuffer.clear();
+    this->chunkRecordCount = 0;
+  }
+
+  this->chunkStop.store(true, std::memory_order_release);
+  this->chunkThread.join();
+  this->chunkFile.close();
+
+  if (this->chunkRingFullCount > 0u)
+  {
+    ignwarn << "Dropped " << this->chunkRingFullCount << " state "
+            << "chunk(s) during recording because the IO thread could "
+            << "not keep up. The log is consistent but has gaps over "
+            << "those intervals." << std::endl;
+  }
+}
+
 //////////////////////////////////////////////////
 bool LogRecordPrivate::RecordResources() const
 {
@@ -643,9 +1167,39 @@ void LogRecord::PostUpdate(const UpdateInfo &_info,
   // that. It would reduce some of the compute on replaying
   // (especially in tools like plotting or seeking through logs).
   msgs::SerializedStateMap stateMsg;
-  _ecm.ChangedState(stateMsg);
+  bool keyframe = this->dataPtr->chunkedState &&
+    this->dataPtr->chunkRecordCount == 0u;
+  if (keyframe)
+  {
+    // Each chunk starts with a full state keyframe, so seeking during
+    // playback can land on a chunk boundary without replaying the log
+    // from the beginning.
+    _ecm.State(stateMsg, {}, {}, true);
+  }
+  else
+  {
+    _ecm.ChangedState(stateMsg);
+  }
+
+  // Apply recording filters before anything is serialized
+  this->dataPtr->FilterState(stateMsg, _ecm);
+
+  if (keyframe)
+    this->dataPtr->RefreshComponentCache(stateMsg);
+  else if (this->dataPtr->chunkedState)
+    this->dataPtr->DropUnchangedComponents(stateMsg);
   if (!stateMsg.entities().empty())
+  {
     this->dataPtr->statePub.Publish(stateMsg);
+    if (this->dataPtr->chunkedState)
+    {
+      std::string data;
+      stateMsg.SerializeToString(&data);
+      this->dataPtr->AppendChunkedState(data,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+        _info.simTime).count());
+    }
+  }
 
   // If there are new models loaded, save meshes and textures
   if (this->dataPtr->RecordResources() && _ecm.HasNewEntities())
@@ -660,3 +1214,5 @@ IGNITION_ADD_PLUGIN(ignition::gazebo::systems::LogRecord,
 
 IGNITION_ADD_PLUGIN_ALIAS(ignition::gazebo::systems::LogRecord,
                           "ignition::gazebo::systems::LogRecord")
+
+IGNITION_GAZEBO_ADD_STATIC_SYSTEM(ignition::gazebo::systems::LogRecord)
@@ -17,6 +17,12 @@
 
 #include <ignition/plugin/Register.hh>
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include <sdf/Magnetometer.hh>
+#include <sdf/Noise.hh>
 #include <sdf/Sensor.hh>
 
 #include <ignition/common/Profiler.hh>
@@ -32,6 +38,8 @@
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/World.hh"
+#include "ignition/gazebo/detail/GaussianNoiseKernel.hh"
+#include "ignition/gazebo/detail/SensorScheduler.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/Util.hh"
 
@@ -51,6 +59,34 @@ class ignition::gazebo::systems::MagnetometerPrivate
   /// \brief Ign-sensors sensor factory for creating sensors
   public: sensors::SensorFactory sensorFactory;
 
+  /// \brief Wakes sensors at their due times. Magnetometers publish at
+  /// tens of Hz, so steps in between skip the entity scan entirely.
+  public: detail::SensorScheduler scheduler;
+
+  /// \brief Scratch list of sensors popped from the scheduler.
+  public: std::vector<detail::SensorScheduler::Entry> dueSensors;
+
+  /// \brief Number of noise channels per magnetometer: the three field
+  /// axes.
+  public: static constexpr std::size_t kNoiseChannels{3};
+
+  /// \brief Batched Gaussian noise, one row per sensor whose SDF noise
+  /// was folded out of ign-sensors.
+  public: detail::GaussianNoiseKernel noiseKernel{kNoiseChannels};
+
+  /// \brief Kernel row of each folded sensor.
+  public: std::unordered_map<Entity, std::size_t> noiseRows;
+
+  /// \brief Entity of each kernel row, aligned with the kernel.
+  public: std::vector<Entity> noiseRowEntities;
+
+  /// \brief Scratch buffer of noise samples, one per channel.
+  public: std::vector<double> noiseSamples;
+
+  /// \brief The world magnetic field, assumed uniform and fixed. Kept
+  /// here so the per-step noise can be added on top of the clean field.
+  public: math::Vector3d worldMagneticField;
+
   /// \brief Create magnetometer sensor
   /// \param[in] _ecm Mutable reference to ECM.
   public: void CreateMagnetometerEntities(EntityComponentManager &_ecm);
@@ -96,17 +132,64 @@ void Magnetometer::PostUpdate(const UpdateInfo &_info,
         << "s]. System may not work properly." << std::endl;
   }
 
-  // Only update and publish if not paused.
-  if (!_info.paused)
+  // Only do the entity scan and sensor updates when a sensor is due; the
+  // scheduler check is a single comparison per step.
+  if (!_info.paused && this->dataPtr->scheduler.AnyDue(_info.simTime))
   {
     this->dataPtr->Update(_ecm);
 
+    // Update measurement time
+    auto time = math::durationToSecNsec(_info.simTime);
+    const common::Time measurementTime(time.first, time.second);
+
+    // One batched draw covers every folded sensor this update.
+    this->dataPtr->noiseKernel.Sample(_info, this->dataPtr->noiseSamples);
+
     for (auto &it : this->dataPtr->entitySensorMap)
     {
-      // Update measurement time
-      auto time = math::durationToSecNsec(_info.simTime);
+      auto rowIt = this->dataPtr->noiseRows.find(it.first);
+      if (rowIt != this->dataPtr->noiseRows.end())
+      {
+        // The noise is defined per body-frame axis; rotating it into the
+        // world field lets the sensor's own rotation back into the body
+        // frame reproduce it exactly.
+        const double *noise = this->dataPtr->noiseSamples.data() +
+            rowIt->second * MagnetometerPrivate::kNoiseChannels;
+        it.second->SetWorldMagneticField(
+            this->dataPtr->worldMagneticField +
+            it.second->WorldPose().Rot().RotateVector(
+            math::Vector3d(noise[0], noise[1], noise[2])));
+      }
+
       dynamic_cast<sensors::Sensor *>(it.second.get())->Update(
-          common::Time(time.first, time.second), false);
+          measurementTime, false);
+    }
+
+    // Reschedule the sensors that were due. Anchoring the next due time to
+    // the previous one keeps the wheel in step with the sensor's own
+    // update schedule.
+    this->dataPtr->dueSensors.clear();
+    this->dataPtr->scheduler.PopDue(_info.simTime, this->dataPtr->dueSensors);
+    for (const auto &due : this->dataPtr->dueSensors)
+    {
+      auto it = this->dataPtr->entitySensorMap.find(due.id);
+      if (it == this->dataPtr->entitySensorMap.end())
+        continue;
+
+      auto period = std::chrono::steady_clock::duration::zero();
+      const double rate = it->second->UpdateRate();
+      if (rate > 0)
+      {
+        period = std::chrono::duration_cast<
+            std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / rate));
+      }
+
+      // An unthrottled sensor, or one woken late, is due again right away.
+      auto next = due.due + period;
+      if (next <= _info.simTime)
+        next = _info.simTime;
+      this->dataPtr->scheduler.Schedule(due.id, next);
     }
   }
 
@@ -150,6 +233,30 @@ void MagnetometerPrivate::CreateMagnetometerEntities(
           std::string topic = scopedName(_entity, _ecm) + "/magnetometer";
           data.SetTopic(topic);
         }
+
+        // Fold Gaussian field noise into the batched kernel and strip it
+        // from the SDF handed to ign-sensors, so the per-sample virtual
+        // noise dispatch inside the sensor is skipped. Custom noise types
+        // keep the sensor-side path.
+        if (const sdf::Magnetometer *magSdf = data.MagnetometerSensor())
+        {
+          std::vector<sdf::Noise> noises{magSdf->XNoise(), magSdf->YNoise(),
+              magSdf->ZNoise()};
+          if (std::all_of(noises.begin(), noises.end(),
+              detail::GaussianNoiseKernel::Supported))
+          {
+            sdf::Magnetometer stripped = *magSdf;
+            stripped.SetXNoise(sdf::Noise());
+            stripped.SetYNoise(sdf::Noise());
+            stripped.SetZNoise(sdf::Noise());
+            data.SetMagnetometerSensor(stripped);
+
+            this->noiseRows[_entity] =
+                this->noiseKernel.AddRow(_entity, noises);
+            this->noiseRowEntities.push_back(_entity);
+          }
+        }
+
         std::unique_ptr<sensors::MagnetometerSensor> sensor =
             this->sensorFactory.CreateSensor<
             sensors::MagnetometerSensor>(data);
@@ -161,6 +268,7 @@ void MagnetometerPrivate::CreateMagnetometerEntities(
         // set world magnetic field. Assume uniform in world and does not
         // change throughout simulation
         sensor->SetWorldMagneticField(worldField->Data());
+        this->worldMagneticField = worldField->Data();
 
         // Get initial pose of sensor and set the reference z pos
         // The WorldPose component was just created and so it's empty
@@ -171,6 +279,10 @@ void MagnetometerPrivate::CreateMagnetometerEntities(
         this->entitySensorMap.insert(
             std::make_pair(_entity, std::move(sensor)));
 
+        // Due immediately; the sensor's update rate takes over from there.
+        this->scheduler.Schedule(_entity,
+            std::chrono::steady_clock::duration::zero());
+
         return true;
       });
 }
@@ -221,6 +333,21 @@ void MagnetometerPrivate::RemoveMagnetometerEntities(
         }
 
         this->entitySensorMap.erase(sensorId);
+        this->scheduler.Remove(_entity);
+
+        auto rowIt = this->noiseRows.find(_entity);
+        if (rowIt != this->noiseRows.end())
+        {
+          // Swap the last kernel row into the removed one, mirroring the
+          // kernel's own swap-remove.
+          const std::size_t row = rowIt->second;
+          const std::size_t last = this->noiseRowEntities.size() - 1;
+          this->noiseKernel.SwapRemoveRow(row);
+          this->noiseRowEntities[row] = this->noiseRowEntities[last];
+          this->noiseRows[this->noiseRowEntities[row]] = row;
+          this->noiseRowEntities.pop_back();
+          this->noiseRows.erase(_entity);
+        }
 
         return true;
       });
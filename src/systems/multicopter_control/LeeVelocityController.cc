@@ -103,12 +103,14 @@ void LeeVelocityController::CalculateRotorVelocities(
   angularAccelerationThrust.block<3, 1>(0, 0) = angularAcceleration;
   angularAccelerationThrust(3) = thrust;
 
-  _rotorVelocities =
+  // The allocation matrix was factored in InitializeParameters, so mapping
+  // the desired angular acceleration and thrust to rotor velocities is a
+  // single matrix-vector product. noalias avoids an intermediate copy, and
+  // clamping against a scalar avoids allocating a zero vector on each call.
+  _rotorVelocities.noalias() =
       this->angularAccToRotorVelocities * angularAccelerationThrust;
 
-  _rotorVelocities =
-      _rotorVelocities.cwiseMax(Eigen::VectorXd::Zero(_rotorVelocities.rows()));
-  _rotorVelocities = _rotorVelocities.cwiseSqrt();
+  _rotorVelocities = _rotorVelocities.cwiseMax(0.0).cwiseSqrt();
 }
 
 //////////////////////////////////////////////////
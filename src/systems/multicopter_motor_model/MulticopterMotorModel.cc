@@ -655,9 +655,10 @@ void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
 
       const auto jointVelCmd = _ecm.Component<components::JointVelocityCmd>(
           this->jointEntity);
-      *jointVelCmd = components::JointVelocityCmd(
-          {this->turningDirection * refMotorRotVel
-                              / this->rotorVelocitySlowdownSim});
+      // Write the command in place; rebuilding the component would
+      // reallocate its vector every cycle
+      jointVelCmd->Data()[0] = this->turningDirection * refMotorRotVel
+                              / this->rotorVelocitySlowdownSim;
     }
   }
 }
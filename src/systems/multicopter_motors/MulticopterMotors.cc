@@ -0,0 +1,648 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/common/Profiler.hh>
+
+#include <ignition/plugin/Register.hh>
+#include <ignition/transport/Node.hh>
+
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/msgs.hh>
+
+#include <sdf/sdf.hh>
+
+#include "ignition/gazebo/components/Actuators.hh"
+#include "ignition/gazebo/components/ExternalWorldWrenchCmd.hh"
+#include "ignition/gazebo/components/JointAxis.hh"
+#include "ignition/gazebo/components/JointVelocity.hh"
+#include "ignition/gazebo/components/JointVelocityCmd.hh"
+#include "ignition/gazebo/components/LinearVelocity.hh"
+#include "ignition/gazebo/components/ParentLinkName.hh"
+#include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/components/Wind.hh"
+#include "ignition/gazebo/Link.hh"
+#include "ignition/gazebo/Model.hh"
+
+#include "MulticopterMotors.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+class ignition::gazebo::systems::MulticopterMotorsPrivate
+{
+  /// \brief Callback for actuator commands.
+  public: void OnActuatorMsg(const ignition::msgs::Actuators &_msg);
+
+  /// \brief Resolve rotor joint and link entities and cache the static
+  /// joint pose and axis data. Returns true once everything is found.
+  /// \param[in] _ecm The entity component manager.
+  public: bool ResolveEntities(const EntityComponentManager &_ecm);
+
+  /// \brief Create missing components required by the update.
+  /// \param[in] _ecm The entity component manager.
+  /// \return True if all components already existed and held data.
+  public: bool EnsureComponents(EntityComponentManager &_ecm);
+
+  /// \brief Apply link forces and moments based on propeller state.
+  /// \param[in] _ecm The entity component manager.
+  /// \param[in] _dt Step size in seconds.
+  public: void UpdateForcesAndMoments(EntityComponentManager &_ecm,
+              double _dt);
+
+  /// \brief Model interface
+  public: Model model{kNullEntity};
+
+  /// \brief Topic for actuator commands.
+  public: std::string commandSubTopic;
+
+  /// \brief Topic namespace.
+  public: std::string robotNamespace;
+
+  /// \brief Number of rotors. All per-rotor vectors below share this size
+  /// and index rotors in <rotor> element order, so the per-step math runs
+  /// over contiguous arrays of plain doubles.
+  public: std::size_t rotorCount{0};
+
+  /// \brief Rotor joint names.
+  public: std::vector<std::string> jointNames;
+
+  /// \brief Rotor link names.
+  public: std::vector<std::string> linkNames;
+
+  /// \brief Rotor joint entities.
+  public: std::vector<Entity> joints;
+
+  /// \brief Rotor link entities.
+  public: std::vector<Entity> links;
+
+  /// \brief Parent link entities, one per rotor. Usually all rotors share
+  /// the base link, but arbitrary attachments are supported.
+  public: std::vector<Entity> parentLinks;
+
+  /// \brief Turning direction of each motor, 1 for counter-clockwise and
+  /// -1 for clockwise. Stored as double to keep the batch math branch-free.
+  public: std::vector<double> turningDirections;
+
+  /// \brief Index of each rotor in the Actuators velocity array.
+  public: std::vector<int> motorNumbers;
+
+  /// \brief Thrust coefficients with units of N / (rad/s)^2.
+  public: std::vector<double> motorConstants;
+
+  /// \brief Moment constants for drag torque with units of length (m).
+  public: std::vector<double> momentConstants;
+
+  /// \brief Rotor drag coefficients with units of N / (m/s^2).
+  public: std::vector<double> rotorDragCoefficients;
+
+  /// \brief Rolling moment coefficients with units of N*m / (m/s^2).
+  public: std::vector<double> rollingMomentCoefficients;
+
+  /// \brief Maximum rotational velocity commands with units of rad/s.
+  public: std::vector<double> maxRotVelocities;
+
+  /// \brief Rotor velocity slowdown factors; see MulticopterMotorModel.
+  public: std::vector<double> slowdowns;
+
+  /// \brief First order filter time constants for rotor acceleration.
+  public: std::vector<double> timeConstantsUp;
+
+  /// \brief First order filter time constants for rotor deceleration.
+  public: std::vector<double> timeConstantsDown;
+
+  /// \brief Cached filter gains exp(-dt / tau) for acceleration. The exp
+  /// calls are only repeated when the step size changes.
+  public: std::vector<double> filterAlphaUp;
+
+  /// \brief Cached filter gains exp(-dt / tau) for deceleration.
+  public: std::vector<double> filterAlphaDown;
+
+  /// \brief Step size the cached filter gains were computed for.
+  public: double filterDt{-1.0};
+
+  /// \brief Reference input of each motor in rad/s.
+  public: std::vector<double> refMotorInputs;
+
+  /// \brief First order filter state, the filtered rotor velocity.
+  public: std::vector<double> filteredVelocities;
+
+  /// \brief Scratch buffer of joint velocities scaled back to real rotor
+  /// velocities.
+  public: std::vector<double> realVelocities;
+
+  /// \brief Scratch buffer of per-rotor thrust values.
+  public: std::vector<double> thrusts;
+
+  /// \brief Cached pose of each rotor joint in its child link frame.
+  public: std::vector<math::Pose3d> jointPoses;
+
+  /// \brief Cached axis of each rotor joint in the joint frame.
+  public: std::vector<math::Vector3d> jointAxes;
+
+  /// \brief Whether all rotor entities have been resolved.
+  public: bool entitiesResolved{false};
+
+  /// \brief Whether a resolution failure has been reported.
+  public: bool warnedMissing{false};
+
+  /// \brief Received Actuators message. This is nullopt if no message has
+  /// been received.
+  public: std::optional<msgs::Actuators> recvdActuatorsMsg;
+
+  /// \brief Mutex to protect recvdActuatorsMsg.
+  public: std::mutex recvdActuatorsMsgMutex;
+
+  /// \brief Ignition communication node.
+  public: transport::Node node;
+};
+
+//////////////////////////////////////////////////
+MulticopterMotors::MulticopterMotors()
+  : dataPtr(std::make_unique<MulticopterMotorsPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+void MulticopterMotors::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &/*_eventMgr*/)
+{
+  this->dataPtr->model = Model(_entity);
+
+  if (!this->dataPtr->model.Valid(_ecm))
+  {
+    ignerr << "MulticopterMotors plugin should be attached to a model "
+           << "entity. Failed to initialize." << std::endl;
+    return;
+  }
+
+  auto sdfClone = _sdf->Clone();
+
+  if (sdfClone->HasElement("robotNamespace"))
+  {
+    this->dataPtr->robotNamespace =
+        sdfClone->Get<std::string>("robotNamespace");
+  }
+  else
+  {
+    ignerr << "Please specify a robotNamespace.\n";
+  }
+
+  sdfClone->Get<std::string>("commandSubTopic",
+      this->dataPtr->commandSubTopic, this->dataPtr->commandSubTopic);
+
+  // Vehicle-level defaults, overridable per rotor. The default values match
+  // MulticopterMotorModel.
+  double motorConstant{8.54858e-06};
+  double momentConstant{0.016};
+  double rotorDragCoefficient{1.0e-4};
+  double rollingMomentCoefficient{1.0e-6};
+  double maxRotVelocity{838.0};
+  double timeConstantUp{1.0 / 80.0};
+  double timeConstantDown{1.0 / 40.0};
+  double slowdown{10.0};
+
+  sdfClone->Get<double>("motorConstant", motorConstant, motorConstant);
+  sdfClone->Get<double>("momentConstant", momentConstant, momentConstant);
+  sdfClone->Get<double>("rotorDragCoefficient", rotorDragCoefficient,
+      rotorDragCoefficient);
+  sdfClone->Get<double>("rollingMomentCoefficient", rollingMomentCoefficient,
+      rollingMomentCoefficient);
+  sdfClone->Get<double>("maxRotVelocity", maxRotVelocity, maxRotVelocity);
+  sdfClone->Get<double>("timeConstantUp", timeConstantUp, timeConstantUp);
+  sdfClone->Get<double>("timeConstantDown", timeConstantDown,
+      timeConstantDown);
+  sdfClone->Get<double>("rotorVelocitySlowdownSim", slowdown, slowdown);
+
+  if (!sdfClone->HasElement("rotor"))
+  {
+    ignerr << "MulticopterMotors found no <rotor> elements. "
+           << "Failed to initialize." << std::endl;
+    return;
+  }
+
+  sdf::ElementPtr rotorElem = sdfClone->GetElement("rotor");
+  while (rotorElem)
+  {
+    auto jointName = rotorElem->Get<std::string>("jointName", "").first;
+    auto linkName = rotorElem->Get<std::string>("linkName", "").first;
+    if (jointName.empty() || linkName.empty())
+    {
+      ignerr << "A <rotor> element is missing a jointName or linkName "
+             << "parameter. Skipping this rotor." << std::endl;
+      rotorElem = rotorElem->GetNextElement("rotor");
+      continue;
+    }
+
+    double turningDirection{0.0};
+    auto turningDirectionStr =
+        rotorElem->Get<std::string>("turningDirection", "").first;
+    if (turningDirectionStr == "cw")
+      turningDirection = -1.0;
+    else if (turningDirectionStr == "ccw")
+      turningDirection = 1.0;
+    else
+      ignerr << "Please only use 'cw' or 'ccw' as turningDirection.\n";
+
+    this->dataPtr->jointNames.push_back(jointName);
+    this->dataPtr->linkNames.push_back(linkName);
+    this->dataPtr->turningDirections.push_back(turningDirection);
+    this->dataPtr->motorNumbers.push_back(rotorElem->Get<int>("motorNumber",
+        static_cast<int>(this->dataPtr->motorNumbers.size())).first);
+
+    this->dataPtr->motorConstants.push_back(
+        rotorElem->Get<double>("motorConstant", motorConstant).first);
+    this->dataPtr->momentConstants.push_back(
+        rotorElem->Get<double>("momentConstant", momentConstant).first);
+    this->dataPtr->rotorDragCoefficients.push_back(
+        rotorElem->Get<double>("rotorDragCoefficient",
+            rotorDragCoefficient).first);
+    this->dataPtr->rollingMomentCoefficients.push_back(
+        rotorElem->Get<double>("rollingMomentCoefficient",
+            rollingMomentCoefficient).first);
+    this->dataPtr->maxRotVelocities.push_back(
+        rotorElem->Get<double>("maxRotVelocity", maxRotVelocity).first);
+    this->dataPtr->timeConstantsUp.push_back(
+        rotorElem->Get<double>("timeConstantUp", timeConstantUp).first);
+    this->dataPtr->timeConstantsDown.push_back(
+        rotorElem->Get<double>("timeConstantDown", timeConstantDown).first);
+    this->dataPtr->slowdowns.push_back(
+        rotorElem->Get<double>("rotorVelocitySlowdownSim", slowdown).first);
+
+    rotorElem = rotorElem->GetNextElement("rotor");
+  }
+
+  this->dataPtr->rotorCount = this->dataPtr->jointNames.size();
+  if (0 == this->dataPtr->rotorCount)
+  {
+    ignerr << "MulticopterMotors configured no valid rotors. "
+           << "Failed to initialize." << std::endl;
+    return;
+  }
+
+  // Size the entity caches and scratch buffers once.
+  this->dataPtr->joints.resize(this->dataPtr->rotorCount, kNullEntity);
+  this->dataPtr->links.resize(this->dataPtr->rotorCount, kNullEntity);
+  this->dataPtr->parentLinks.resize(this->dataPtr->rotorCount, kNullEntity);
+  this->dataPtr->filterAlphaUp.resize(this->dataPtr->rotorCount, 0.0);
+  this->dataPtr->filterAlphaDown.resize(this->dataPtr->rotorCount, 0.0);
+  this->dataPtr->refMotorInputs.resize(this->dataPtr->rotorCount, 0.0);
+  this->dataPtr->filteredVelocities.resize(this->dataPtr->rotorCount, 0.0);
+  this->dataPtr->realVelocities.resize(this->dataPtr->rotorCount, 0.0);
+  this->dataPtr->thrusts.resize(this->dataPtr->rotorCount, 0.0);
+  this->dataPtr->jointPoses.resize(this->dataPtr->rotorCount);
+  this->dataPtr->jointAxes.resize(this->dataPtr->rotorCount);
+
+  // Subscribe to actuator command messages
+  std::string topic{this->dataPtr->robotNamespace + "/"
+                  + this->dataPtr->commandSubTopic};
+  this->dataPtr->node.Subscribe(topic,
+      &MulticopterMotorsPrivate::OnActuatorMsg, this->dataPtr.get());
+}
+
+//////////////////////////////////////////////////
+void MulticopterMotors::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
+    ignition::gazebo::EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("MulticopterMotors::PreUpdate");
+
+  // \TODO(anyone) Support rewind
+  if (_info.dt < std::chrono::steady_clock::duration::zero())
+  {
+    ignwarn << "Detected jump back in time ["
+        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
+        << "s]. System may not work properly." << std::endl;
+  }
+
+  if (0 == this->dataPtr->rotorCount)
+    return;
+
+  if (!this->dataPtr->entitiesResolved &&
+      !this->dataPtr->ResolveEntities(_ecm))
+    return;
+
+  bool doUpdateForcesAndMoments = this->dataPtr->EnsureComponents(_ecm);
+
+  // Nothing left to do if paused.
+  if (_info.paused)
+    return;
+
+  if (doUpdateForcesAndMoments)
+  {
+    this->dataPtr->UpdateForcesAndMoments(_ecm,
+        std::chrono::duration<double>(_info.dt).count());
+  }
+}
+
+//////////////////////////////////////////////////
+bool MulticopterMotorsPrivate::ResolveEntities(
+    const EntityComponentManager &_ecm)
+{
+  bool allFound = true;
+  for (std::size_t i = 0; i < this->rotorCount; ++i)
+  {
+    if (this->joints[i] == kNullEntity)
+    {
+      this->joints[i] = this->model.JointByName(_ecm, this->jointNames[i]);
+    }
+    if (this->links[i] == kNullEntity)
+    {
+      this->links[i] = this->model.LinkByName(_ecm, this->linkNames[i]);
+    }
+    if (this->joints[i] == kNullEntity || this->links[i] == kNullEntity)
+    {
+      allFound = false;
+      continue;
+    }
+
+    if (this->parentLinks[i] == kNullEntity)
+    {
+      const auto parentLinkName = _ecm.Component<components::ParentLinkName>(
+          this->joints[i]);
+      if (parentLinkName)
+      {
+        this->parentLinks[i] =
+            this->model.LinkByName(_ecm, parentLinkName->Data());
+      }
+      if (this->parentLinks[i] == kNullEntity)
+      {
+        allFound = false;
+        continue;
+      }
+    }
+
+    // The joint pose and axis never change after load; cache them so the
+    // update never queries them again.
+    const auto jointPose = _ecm.Component<components::Pose>(this->joints[i]);
+    const auto jointAxis = _ecm.Component<components::JointAxis>(
+        this->joints[i]);
+    if (!jointPose || !jointAxis)
+    {
+      allFound = false;
+      continue;
+    }
+    this->jointPoses[i] = jointPose->Data();
+    this->jointAxes[i] = jointAxis->Data().Xyz();
+  }
+
+  if (!allFound && !this->warnedMissing)
+  {
+    ignwarn << "MulticopterMotors failed to resolve all rotor joints and "
+            << "links for model [" << this->model.Name(_ecm)
+            << "]. The system will keep looking." << std::endl;
+    this->warnedMissing = true;
+  }
+
+  this->entitiesResolved = allFound;
+  return allFound;
+}
+
+//////////////////////////////////////////////////
+bool MulticopterMotorsPrivate::EnsureComponents(EntityComponentManager &_ecm)
+{
+  bool ready = true;
+  for (std::size_t i = 0; i < this->rotorCount; ++i)
+  {
+    const auto jointVelocity = _ecm.Component<components::JointVelocity>(
+        this->joints[i]);
+    if (!jointVelocity)
+    {
+      _ecm.CreateComponent(this->joints[i], components::JointVelocity());
+      ready = false;
+    }
+    else if (jointVelocity->Data().empty())
+    {
+      ready = false;
+    }
+
+    if (!_ecm.Component<components::JointVelocityCmd>(this->joints[i]))
+    {
+      _ecm.CreateComponent(this->joints[i],
+          components::JointVelocityCmd({0}));
+      ready = false;
+    }
+
+    if (!_ecm.Component<components::WorldPose>(this->links[i]))
+    {
+      _ecm.CreateComponent(this->links[i], components::WorldPose());
+      ready = false;
+    }
+    if (!_ecm.Component<components::WorldLinearVelocity>(this->links[i]))
+    {
+      _ecm.CreateComponent(this->links[i],
+          components::WorldLinearVelocity());
+      ready = false;
+    }
+
+    if (!_ecm.Component<components::WorldPose>(this->parentLinks[i]))
+    {
+      _ecm.CreateComponent(this->parentLinks[i], components::WorldPose());
+      ready = false;
+    }
+  }
+  return ready;
+}
+
+//////////////////////////////////////////////////
+void MulticopterMotorsPrivate::OnActuatorMsg(
+    const ignition::msgs::Actuators &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->recvdActuatorsMsgMutex);
+  this->recvdActuatorsMsg = _msg;
+}
+
+//////////////////////////////////////////////////
+void MulticopterMotorsPrivate::UpdateForcesAndMoments(
+    EntityComponentManager &_ecm, double _dt)
+{
+  IGN_PROFILE("MulticopterMotorsPrivate::UpdateForcesAndMoments");
+
+  using Pose = ignition::math::Pose3d;
+  using Vector3 = ignition::math::Vector3d;
+
+  // Read the actuator command once for the whole vehicle. A component takes
+  // precedence over a message received via transport.
+  std::optional<msgs::Actuators> msg;
+  auto actuatorMsgComp =
+      _ecm.Component<components::Actuators>(this->model.Entity());
+  if (actuatorMsgComp)
+  {
+    msg = actuatorMsgComp->Data();
+  }
+  else
+  {
+    std::lock_guard<std::mutex> lock(this->recvdActuatorsMsgMutex);
+    if (this->recvdActuatorsMsg.has_value())
+    {
+      msg = *this->recvdActuatorsMsg;
+      this->recvdActuatorsMsg.reset();
+    }
+  }
+
+  if (msg.has_value())
+  {
+    for (std::size_t i = 0; i < this->rotorCount; ++i)
+    {
+      if (this->motorNumbers[i] > msg->velocity_size() - 1)
+      {
+        ignerr << "You tried to access index " << this->motorNumbers[i]
+          << " of the Actuator velocity array which is of size "
+          << msg->velocity_size() << std::endl;
+        return;
+      }
+      this->refMotorInputs[i] = std::min(
+          static_cast<double>(msg->velocity(this->motorNumbers[i])),
+          this->maxRotVelocities[i]);
+    }
+  }
+
+  // Refresh the cached first order filter gains only when the step size
+  // changes; exp is by far the most expensive scalar operation here.
+  if (std::abs(_dt - this->filterDt) > 1e-12)
+  {
+    for (std::size_t i = 0; i < this->rotorCount; ++i)
+    {
+      this->filterAlphaUp[i] = std::exp(-_dt / this->timeConstantsUp[i]);
+      this->filterAlphaDown[i] = std::exp(-_dt / this->timeConstantsDown[i]);
+    }
+    this->filterDt = _dt;
+  }
+
+  // Batch phase: everything below runs over contiguous double arrays with
+  // no ECM access, so the compiler is free to vectorize.
+  for (std::size_t i = 0; i < this->rotorCount; ++i)
+  {
+    const double motorRotVel =
+        _ecm.Component<components::JointVelocity>(this->joints[i])->Data()[0];
+    const double realVel = motorRotVel * this->slowdowns[i];
+    this->realVelocities[i] = realVel;
+    // Assuming symmetric propellers (or rotors) for the thrust calculation.
+    const double sign = (realVel > 0) - (realVel < 0);
+    this->thrusts[i] = this->turningDirections[i] * sign * realVel * realVel *
+        this->motorConstants[i];
+  }
+
+  for (std::size_t i = 0; i < this->rotorCount; ++i)
+  {
+    // First order filter on the reference velocity, with separate gains for
+    // acceleration and deceleration.
+    const double alpha = this->refMotorInputs[i] > this->filteredVelocities[i]
+        ? this->filterAlphaUp[i] : this->filterAlphaDown[i];
+    this->filteredVelocities[i] = alpha * this->filteredVelocities[i] +
+        (1.0 - alpha) * this->refMotorInputs[i];
+  }
+
+  if (this->realVelocities[0] / (2 * IGN_PI) > 1 / (2 * _dt))
+  {
+    ignerr << "Aliasing on motor [" << this->motorNumbers[0]
+          << "] might occur. Consider making smaller simulation time "
+             "steps or raising the rotorVelocitySlowdownSim param.\n";
+  }
+
+  Entity windEntity = _ecm.EntityByComponents(components::Wind());
+  auto windLinearVel =
+      _ecm.Component<components::WorldLinearVelocity>(windEntity);
+  const Vector3 windSpeedWorld = windLinearVel->Data();
+
+  // Application phase: per-rotor forces, with the reaction torques of all
+  // rotors accumulated so each parent link gets a single wrench write.
+  std::unordered_map<Entity, Vector3> parentTorques;
+  for (std::size_t i = 0; i < this->rotorCount; ++i)
+  {
+    Link link(this->links[i]);
+    const auto worldPose = link.WorldPose(_ecm);
+    const auto worldLinearVel = link.WorldLinearVelocity(_ecm);
+
+    // Forces from Philppe Martin's and Erwan Salaun's
+    // 2010 IEEE Conference on Robotics and Automation paper
+    // The True Role of Accelerometer Feedback in Quadrotor Control
+    // - \omega * \lambda_1 * V_A^{\perp}
+    const Pose jointWorldPose = *worldPose * this->jointPoses[i];
+    const Vector3 jointAxis =
+        jointWorldPose.Rot().RotateVector(this->jointAxes[i]);
+    const Vector3 relativeWindVelocityWorld = *worldLinearVel -
+        windSpeedWorld;
+    const Vector3 bodyVelocityPerpendicular = relativeWindVelocityWorld -
+        (relativeWindVelocityWorld.Dot(jointAxis) * jointAxis);
+    const Vector3 airDrag = -std::abs(this->realVelocities[i]) *
+        this->rotorDragCoefficients[i] * bodyVelocityPerpendicular;
+
+    // Apply thrust and air drag to the rotor link in one force.
+    link.AddWorldForce(_ecm,
+        worldPose->Rot().RotateVector(Vector3(0, 0, this->thrusts[i])) +
+        airDrag);
+
+    // Drag torque in the parent frame; see MulticopterMotorModel for the
+    // frame derivation.
+    Link parentLink(this->parentLinks[i]);
+    const auto parentWorldPose = parentLink.WorldPose(_ecm);
+    const Pose poseDifference = *worldPose - *parentWorldPose;
+    const Vector3 dragTorque(0, 0,
+        -this->turningDirections[i] * this->thrusts[i] *
+        this->momentConstants[i]);
+    const Vector3 dragTorqueParentFrame =
+        poseDifference.Rot().RotateVector(dragTorque);
+
+    // - \omega * \mu_1 * V_A^{\perp}
+    const Vector3 rollingMoment = -std::abs(this->realVelocities[i]) *
+        this->rollingMomentCoefficients[i] * bodyVelocityPerpendicular;
+
+    parentTorques[this->parentLinks[i]] +=
+        parentWorldPose->Rot().RotateVector(dragTorqueParentFrame) +
+        rollingMoment;
+
+    // Write the filtered velocity command in place.
+    const auto jointVelCmd = _ecm.Component<components::JointVelocityCmd>(
+        this->joints[i]);
+    jointVelCmd->Data()[0] = this->turningDirections[i] *
+        this->filteredVelocities[i] / this->slowdowns[i];
+  }
+
+  for (const auto &[parentEntity, torque] : parentTorques)
+  {
+    auto parentWrenchComp =
+      _ecm.Component<components::ExternalWorldWrenchCmd>(parentEntity);
+    if (!parentWrenchComp)
+    {
+      components::ExternalWorldWrenchCmd wrench;
+      msgs::Set(wrench.Data().mutable_torque(), torque);
+      _ecm.CreateComponent(parentEntity, wrench);
+    }
+    else
+    {
+      msgs::Set(parentWrenchComp->Data().mutable_torque(),
+        msgs::Convert(parentWrenchComp->Data().torque()) + torque);
+    }
+  }
+}
+
+IGNITION_ADD_PLUGIN(MulticopterMotors,
+                    ignition::gazebo::System,
+                    MulticopterMotors::ISystemConfigure,
+                    MulticopterMotors::ISystemPreUpdate)
+
+IGNITION_ADD_PLUGIN_ALIAS(MulticopterMotors,
+                          "ignition::gazebo::systems::MulticopterMotors")
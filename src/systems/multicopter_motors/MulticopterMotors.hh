@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_GAZEBO_SYSTEMS_MULTICOPTERMOTORS_HH_
+#define IGNITION_GAZEBO_SYSTEMS_MULTICOPTERMOTORS_HH_
+
+#include <ignition/gazebo/System.hh>
+#include <memory>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declaration
+  class MulticopterMotorsPrivate;
+
+  /// \brief Vehicle-level rotor aerodynamics. This system computes the same
+  /// thrust, drag and rolling moment model as MulticopterMotorModel, but for
+  /// all rotors of a model in one plugin instance. Rotor state is kept in
+  /// contiguous per-rotor arrays so the per-step math runs as tight loops
+  /// over plain doubles, actuator commands are read once per vehicle instead
+  /// of once per rotor, and the reaction torques of all rotors are
+  /// accumulated and applied to each parent link with a single wrench write.
+  /// Prefer this system over one MulticopterMotorModel instance per rotor
+  /// when simulating many vehicles.
+  ///
+  /// # Parameters
+  ///
+  /// robotNamespace: Topic namespace, required. The system subscribes to
+  /// <robotNamespace>/<commandSubTopic> for actuator commands.
+  ///
+  /// commandSubTopic: Topic for ignition::msgs::Actuators commands.
+  ///
+  /// Vehicle-level defaults for motorConstant, momentConstant,
+  /// rotorDragCoefficient, rollingMomentCoefficient, maxRotVelocity,
+  /// timeConstantUp, timeConstantDown and rotorVelocitySlowdownSim may be
+  /// given at the top level; each has the same meaning and default value as
+  /// in MulticopterMotorModel.
+  ///
+  /// rotor: One element per rotor, containing
+  ///   * jointName: Name of the rotor joint, required.
+  ///   * linkName: Name of the rotor link, required.
+  ///   * turningDirection: 'cw' or 'ccw', required.
+  ///   * motorNumber: Index into the Actuators velocity array. Defaults to
+  ///     the order of the <rotor> elements.
+  ///   * Any of the vehicle-level parameters above, overriding the default
+  ///     for this rotor.
+  class IGNITION_GAZEBO_VISIBLE MulticopterMotors
+      : public System,
+        public ISystemConfigure,
+        public ISystemPreUpdate
+  {
+    /// \brief Constructor
+    public: MulticopterMotors();
+
+    /// \brief Destructor
+    public: ~MulticopterMotors() override = default;
+
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) override;
+
+    // Documentation inherited
+    public: void PreUpdate(
+                const ignition::gazebo::UpdateInfo &_info,
+                ignition::gazebo::EntityComponentManager &_ecm) override;
+
+    /// \brief Private data pointer
+    private: std::unique_ptr<MulticopterMotorsPrivate> dataPtr;
+  };
+  }
+}
+}
+}
+
+#endif
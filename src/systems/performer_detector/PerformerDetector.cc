@@ -17,6 +17,17 @@
 
 #include <ignition/msgs/pose.pb.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/Vector3.hh>
@@ -40,6 +51,402 @@ using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
+namespace
+{
+/// \brief Shared registry of every loaded PerformerDetector. Detector
+/// regions are kept in a spatial hash so each performer only tests the
+/// detectors whose cells its volume overlaps, instead of every detector
+/// scanning every performer. The hash is rebuilt only when a detector
+/// moves or is added or removed; enter and exit events are published on
+/// state change, as before. This follows the same process-wide registry
+/// pattern as the linear battery pool: every PerformerDetector calls
+/// UpdateAll, and the first call of a step does the work for all of them.
+class PerformerDetectorRegistry
+{
+  /// \brief Index value used for detectors that are not registered.
+  public: static constexpr std::size_t kInvalidIndex{
+              std::numeric_limits<std::size_t>::max()};
+
+  /// \brief Get the process-wide registry instance.
+  public: static PerformerDetectorRegistry &Instance()
+  {
+    static PerformerDetectorRegistry instance;
+    return instance;
+  }
+
+  /// \brief Register a detector.
+  /// \param[in] _modelEntity Entity of the model the detector is attached
+  /// to; the detection region is centered on its pose.
+  /// \param[in] _geometry Detection region in the model frame.
+  /// \param[in] _name Detector name used as frame_id in event messages.
+  /// \param[in] _pub Publisher for the detector's event messages.
+  /// \return Index of the detector's row in the registry.
+  public: std::size_t Register(Entity _modelEntity,
+              const math::AxisAlignedBox &_geometry,
+              const std::string &_name,
+              const transport::Node::Publisher &_pub)
+  {
+    Detector detector;
+    detector.active = true;
+    detector.modelEntity = _modelEntity;
+    detector.geometry = _geometry;
+    detector.name = _name;
+    detector.pub = _pub;
+
+    this->hashDirty = true;
+
+    // Reuse a row freed by a previously unregistered detector, if any.
+    for (std::size_t i = 0; i < this->detectors.size(); ++i)
+    {
+      if (!this->detectors[i].active)
+      {
+        this->detectors[i] = std::move(detector);
+        return i;
+      }
+    }
+
+    this->detectors.push_back(std::move(detector));
+    this->visitStamps.push_back(0);
+    return this->detectors.size() - 1;
+  }
+
+  /// \brief Remove a detector from the registry.
+  /// \param[in] _index Index returned by Register.
+  public: void Unregister(std::size_t _index)
+  {
+    if (_index >= this->detectors.size())
+      return;
+
+    Detector &detector = this->detectors[_index];
+    for (const Entity &entity : detector.detected)
+    {
+      auto it = this->detectedBy.find(entity);
+      if (it == this->detectedBy.end())
+        continue;
+      it->second.erase(std::remove(it->second.begin(), it->second.end(),
+          _index), it->second.end());
+      if (it->second.empty())
+        this->detectedBy.erase(it);
+    }
+    detector.detected.clear();
+    detector.active = false;
+    this->hashDirty = true;
+  }
+
+  /// \brief Test every performer against the detectors its volume can
+  /// reach and publish enter and exit events on state changes. Only the
+  /// first call of a given iteration does any work.
+  /// \param[in] _info Current simulation step info.
+  /// \param[in] _ecm Immutable reference to the EntityComponentManager.
+  public: void UpdateAll(const UpdateInfo &_info,
+              const EntityComponentManager &_ecm)
+  {
+    if (_info.iterations == this->lastIteration)
+      return;
+    this->lastIteration = _info.iterations;
+
+    IGN_PROFILE("PerformerDetectorRegistry::UpdateAll");
+
+    // Refresh the world-space region of every detector; a moved detector
+    // dirties the hash.
+    for (std::size_t i = 0; i < this->detectors.size(); ++i)
+    {
+      Detector &detector = this->detectors[i];
+      if (!detector.active)
+        continue;
+
+      auto poseComp = _ecm.Component<components::Pose>(detector.modelEntity);
+      if (nullptr == poseComp)
+        continue;
+
+      if (!detector.everPosed || poseComp->Data() != detector.pose)
+      {
+        detector.pose = poseComp->Data();
+        // Double negative because AxisAlignedBox does not currently have
+        // operator+ that takes a position
+        detector.region = detector.geometry - (-detector.pose.Pos());
+        detector.everPosed = true;
+        this->hashDirty = true;
+      }
+    }
+
+    if (this->hashDirty)
+      this->RebuildHash();
+
+    // One scan over the performers for all detectors.
+    _ecm.Each<components::Performer, components::Geometry,
+              components::ParentEntity>(
+        [&](const Entity &_entity, const components::Performer *,
+            const components::Geometry *_geometry,
+            const components::ParentEntity *_parent) -> bool
+        {
+          // We assume the geometry contains a box.
+          auto perfBox = _geometry->Data().BoxShape();
+          if (nullptr == perfBox)
+          {
+            ignerr << "Internal error: geometry of performer [" << _entity
+                   << "] missing box." << std::endl;
+            return true;
+          }
+
+          auto pose =
+              _ecm.Component<components::Pose>(_parent->Data())->Data();
+          math::AxisAlignedBox performerVolume{
+              pose.Pos() - perfBox->Size() / 2,
+              pose.Pos() + perfBox->Size() / 2};
+
+          // Enter events: candidate detectors come from the hash cells the
+          // performer's volume overlaps.
+          ++this->visitToken;
+          this->VisitCells(performerVolume,
+              [&](std::size_t _index)
+              {
+                if (this->visitStamps[_index] == this->visitToken)
+                  return;
+                this->visitStamps[_index] = this->visitToken;
+
+                Detector &detector = this->detectors[_index];
+                if (!detector.active || !detector.everPosed)
+                  return;
+
+                if (detector.region.Intersects(performerVolume) &&
+                    detector.detected.insert(_entity).second)
+                {
+                  this->detectedBy[_entity].push_back(_index);
+                  this->PublishEvent(detector, _entity, _ecm, pose, true,
+                      _info.simTime);
+                }
+              });
+
+          // Exit events: recheck only the detectors that currently hold
+          // this performer.
+          auto it = this->detectedBy.find(_entity);
+          if (it != this->detectedBy.end())
+          {
+            auto &holders = it->second;
+            for (std::size_t i = 0; i < holders.size();)
+            {
+              Detector &detector = this->detectors[holders[i]];
+              if (!detector.region.Intersects(performerVolume))
+              {
+                detector.detected.erase(_entity);
+                this->PublishEvent(detector, _entity, _ecm, pose, false,
+                    _info.simTime);
+                holders[i] = holders.back();
+                holders.pop_back();
+              }
+              else
+              {
+                ++i;
+              }
+            }
+            if (holders.empty())
+              this->detectedBy.erase(it);
+          }
+
+          return true;
+        });
+  }
+
+  /// \brief A registered detector and its detection state.
+  private: struct Detector
+  {
+    /// \brief False while the row is free for reuse.
+    bool active{false};
+
+    /// \brief Entity of the model the detector is attached to.
+    Entity modelEntity{kNullEntity};
+
+    /// \brief Detection region in the model frame.
+    math::AxisAlignedBox geometry;
+
+    /// \brief Detector name used as frame_id in event messages.
+    std::string name;
+
+    /// \brief Publisher for the detector's event messages.
+    transport::Node::Publisher pub;
+
+    /// \brief Last known pose of the detector's model.
+    math::Pose3d pose;
+
+    /// \brief Detection region in the world frame.
+    math::AxisAlignedBox region;
+
+    /// \brief Whether the model pose has been read at least once.
+    bool everPosed{false};
+
+    /// \brief Performers currently inside the region.
+    std::unordered_set<Entity> detected;
+  };
+
+  /// \brief Publish an enter or exit event, mirroring the message layout
+  /// this system has always used.
+  /// \param[in] _detector Detector reporting the event.
+  /// \param[in] _entity The performer entity.
+  /// \param[in] _ecm Immutable reference to the EntityComponentManager.
+  /// \param[in] _performerPose World pose of the performer's model.
+  /// \param[in] _state True on enter, false on exit.
+  /// \param[in] _stamp Time stamp of the event.
+  private: void PublishEvent(Detector &_detector, const Entity &_entity,
+               const EntityComponentManager &_ecm,
+               const math::Pose3d &_performerPose, bool _state,
+               const std::chrono::steady_clock::duration &_stamp)
+  {
+    auto parentComp = _ecm.Component<components::ParentEntity>(_entity);
+    std::string name;
+    if (parentComp)
+    {
+      auto nameComp = _ecm.Component<components::Name>(parentComp->Data());
+      if (nameComp)
+        name = nameComp->Data();
+    }
+
+    const math::Pose3d relPose = _detector.pose.Inverse() * _performerPose;
+
+    msgs::Pose msg = msgs::Convert(relPose);
+    msg.set_name(name);
+    msg.set_id(_entity);
+
+    auto stamp = math::durationToSecNsec(_stamp);
+    msg.mutable_header()->mutable_stamp()->set_sec(stamp.first);
+    msg.mutable_header()->mutable_stamp()->set_nsec(stamp.second);
+
+    {
+      auto *headerData = msg.mutable_header()->add_data();
+      headerData->set_key("frame_id");
+      headerData->add_value(_detector.name);
+    }
+    {
+      auto *headerData = msg.mutable_header()->add_data();
+      headerData->set_key("state");
+      headerData->add_value(std::to_string(_state));
+    }
+
+    _detector.pub.Publish(msg);
+  }
+
+  /// \brief Rebuild the spatial hash from the detector regions. The cell
+  /// size is the largest region extent, so each region covers at most
+  /// eight cells.
+  private: void RebuildHash()
+  {
+    this->cells.clear();
+
+    this->cellSize = 1.0;
+    for (const Detector &detector : this->detectors)
+    {
+      if (!detector.active || !detector.everPosed)
+        continue;
+      const math::Vector3d size = detector.region.Size();
+      this->cellSize = std::max({this->cellSize, size.X(), size.Y(),
+          size.Z()});
+    }
+
+    for (std::size_t i = 0; i < this->detectors.size(); ++i)
+    {
+      const Detector &detector = this->detectors[i];
+      if (!detector.active || !detector.everPosed)
+        continue;
+
+      this->ForEachCellKey(detector.region,
+          [&](uint64_t _key)
+          {
+            this->cells[_key].push_back(i);
+          });
+    }
+
+    this->hashDirty = false;
+  }
+
+  /// \brief Call a function with the index of every detector hashed into
+  /// a cell overlapped by a box. A detector may be visited more than once;
+  /// callers deduplicate with visitStamps.
+  /// \param[in] _box Query box in the world frame.
+  /// \param[in] _func Function called per candidate detector index.
+  private: template <typename Func>
+           void VisitCells(const math::AxisAlignedBox &_box, Func _func)
+  {
+    this->ForEachCellKey(_box,
+        [&](uint64_t _key)
+        {
+          auto it = this->cells.find(_key);
+          if (it == this->cells.end())
+            return;
+          for (const std::size_t index : it->second)
+            _func(index);
+        });
+  }
+
+  /// \brief Call a function with the hash key of every cell a box
+  /// overlaps. Distinct cells may collide to the same key; that only adds
+  /// candidates, which the intersection test filters out.
+  /// \param[in] _box Query box in the world frame.
+  /// \param[in] _func Function called per cell key.
+  private: template <typename Func>
+           void ForEachCellKey(const math::AxisAlignedBox &_box,
+               Func _func) const
+  {
+    const auto cellOf = [this](double _v) -> int64_t
+    {
+      return static_cast<int64_t>(std::floor(_v / this->cellSize));
+    };
+
+    const int64_t minX = cellOf(_box.Min().X());
+    const int64_t maxX = cellOf(_box.Max().X());
+    const int64_t minY = cellOf(_box.Min().Y());
+    const int64_t maxY = cellOf(_box.Max().Y());
+    const int64_t minZ = cellOf(_box.Min().Z());
+    const int64_t maxZ = cellOf(_box.Max().Z());
+
+    for (int64_t x = minX; x <= maxX; ++x)
+    {
+      for (int64_t y = minY; y <= maxY; ++y)
+      {
+        for (int64_t z = minZ; z <= maxZ; ++z)
+        {
+          _func(static_cast<uint64_t>(x) * 73856093u ^
+                static_cast<uint64_t>(y) * 19349663u ^
+                static_cast<uint64_t>(z) * 83492791u);
+        }
+      }
+    }
+  }
+
+  /// \brief All registered detectors.
+  private: std::vector<Detector> detectors;
+
+  /// \brief Spatial hash from cell key to the detectors overlapping it.
+  private: std::unordered_map<uint64_t, std::vector<std::size_t>> cells;
+
+  /// \brief Width of one hash cell in meters.
+  private: double cellSize{1.0};
+
+  /// \brief Whether the hash must be rebuilt before the next query.
+  private: bool hashDirty{true};
+
+  /// \brief Which performers are inside which detectors, so exit checks
+  /// only touch the detectors that hold a performer.
+  private: std::unordered_map<Entity, std::vector<std::size_t>> detectedBy;
+
+  /// \brief Per-detector stamp of the last query that visited it, used to
+  /// deduplicate candidates across cells.
+  private: std::vector<uint64_t> visitStamps;
+
+  /// \brief Token of the current candidate query.
+  private: uint64_t visitToken{0};
+
+  /// \brief Iteration of the last update, used to run once per step.
+  private: uint64_t lastIteration{std::numeric_limits<uint64_t>::max()};
+};
+}
+
+/////////////////////////////////////////////////
+PerformerDetector::~PerformerDetector()
+{
+  if (this->registryIndex != PerformerDetectorRegistry::kInvalidIndex)
+    PerformerDetectorRegistry::Instance().Unregister(this->registryIndex);
+}
+
 /////////////////////////////////////////////////
 void PerformerDetector::Configure(const Entity &_entity,
                const std::shared_ptr<const sdf::Element> &_sdf,
@@ -86,6 +493,11 @@ void PerformerDetector::Configure(const Entity &_entity,
 
   transport::Node node;
   this->pub = node.Advertise<msgs::Pose>(topic);
+
+  this->registryIndex = PerformerDetectorRegistry::Instance().Register(
+      this->model.Entity(), this->detectorGeometry, this->detectorName,
+      this->pub);
+
   this->initialized = true;
 }
 
@@ -104,98 +516,9 @@ void PerformerDetector::PostUpdate(
     return;
   }
 
-  auto modelPose =
-      _ecm.Component<components::Pose>(this->model.Entity())->Data();
-
-  // Double negative because AxisAlignedBox does not currently have operator+
-  // that takes a position
-  auto region = this->detectorGeometry - (-modelPose.Pos());
-
-  _ecm.Each<components::Performer, components::Geometry,
-            components::ParentEntity>(
-      [&](const Entity &_entity, const components::Performer *,
-          const components::Geometry *_geometry,
-          const components::ParentEntity *_parent) -> bool
-      {
-        auto pose = _ecm.Component<components::Pose>(_parent->Data())->Data();
-        auto name = _ecm.Component<components::Name>(_parent->Data())->Data();
-        const math::Pose3d relPose = modelPose.Inverse() * pose;
-
-        // We assume the geometry contains a box.
-        auto perfBox = _geometry->Data().BoxShape();
-        if (nullptr == perfBox)
-        {
-          ignerr << "Internal error: geometry of performer [" << _entity
-                 << "] missing box." << std::endl;
-          return true;
-        }
-
-        math::AxisAlignedBox performerVolume{pose.Pos() - perfBox->Size() / 2,
-                                             pose.Pos() + perfBox->Size() / 2};
-
-        bool alreadyDetected = this->IsAlreadyDetected(_entity);
-        if (region.Intersects(performerVolume))
-        {
-          if (!alreadyDetected)
-          {
-            this->AddToDetected(_entity);
-            this->Publish(_entity, name, true, relPose, _info.simTime);
-          }
-        }
-        else if (alreadyDetected)
-        {
-          this->RemoveFromDetected(_entity);
-          this->Publish(_entity, name, false, relPose, _info.simTime);
-        }
-
-        return true;
-      });
-}
-
-//////////////////////////////////////////////////
-bool PerformerDetector::IsAlreadyDetected(const Entity &_entity) const
-{
-  return this->detectedEntities.find(_entity) != this->detectedEntities.end();
-}
-
-//////////////////////////////////////////////////
-void PerformerDetector::AddToDetected(const Entity &_entity)
-{
-  this->detectedEntities.insert(_entity);
-}
-
-//////////////////////////////////////////////////
-void PerformerDetector::RemoveFromDetected(const Entity &_entity)
-{
-  this->detectedEntities.erase(_entity);
-}
-
-//////////////////////////////////////////////////
-void PerformerDetector::Publish(
-    const Entity &_entity, const std::string &_name, bool _state,
-    const math::Pose3d &_pose,
-    const std::chrono::steady_clock::duration &_stamp)
-{
-  msgs::Pose msg = msgs::Convert(_pose);
-  msg.set_name(_name);
-  msg.set_id(_entity);
-
-  auto stamp = math::durationToSecNsec(_stamp);
-  msg.mutable_header()->mutable_stamp()->set_sec(stamp.first);
-  msg.mutable_header()->mutable_stamp()->set_nsec(stamp.second);
-
-  {
-    auto *headerData = msg.mutable_header()->add_data();
-    headerData->set_key("frame_id");
-    headerData->add_value(this->detectorName);
-  }
-  {
-    auto *headerData = msg.mutable_header()->add_data();
-    headerData->set_key("state");
-    headerData->add_value(std::to_string(_state));
-  }
-
-  this->pub.Publish(msg);
+  // The first detector to run in a step updates every detector through the
+  // shared registry.
+  PerformerDetectorRegistry::Instance().UpdateAll(_info, _ecm);
 }
 
 IGNITION_ADD_PLUGIN(PerformerDetector,
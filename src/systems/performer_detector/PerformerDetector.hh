@@ -18,9 +18,10 @@
 #ifndef IGNITION_GAZEBO_SYSTEMS_PERFORMERDETECTOR_HH_
 #define IGNITION_GAZEBO_SYSTEMS_PERFORMERDETECTOR_HH_
 
+#include <cstddef>
+#include <limits>
 #include <memory>
 #include <string>
-#include <unordered_set>
 
 #include <ignition/transport/Node.hh>
 
@@ -76,6 +77,9 @@ namespace systems
     /// Documentation inherited
     public: PerformerDetector() = default;
 
+    /// \brief Destructor. Removes the detector from the shared registry.
+    public: ~PerformerDetector() override;
+
     /// Documentation inherited
     public: void Configure(const Entity &_entity,
                            const std::shared_ptr<const sdf::Element> &_sdf,
@@ -87,33 +91,6 @@ namespace systems
                 const ignition::gazebo::UpdateInfo &_info,
                 const ignition::gazebo::EntityComponentManager &_ecm) final;
 
-    /// \brief Check if the entity has already been detected
-    /// \param [in] _entity The entity to test
-    /// \returns True if the entity has already been detected
-    private: bool IsAlreadyDetected(const Entity &_entity) const;
-
-    /// \brief Add the entity to the list of detected entities
-    /// \param [in] _entity The entity to add
-    private: void AddToDetected(const Entity &_entity);
-
-    /// \brief Remove the entity from the list of detected entities
-    /// \param [in] _entity The entity to remove
-    private: void RemoveFromDetected(const Entity &_entity);
-
-    /// \brief Publish the event that the entity is detected or no longer
-    /// detected.
-    /// \param [in] _entity The entity to report
-    /// \param [in] _name The name of the entity that triggered the event
-    /// \param [in] _state The new state of the detector
-    /// \param [in] _pose The pose of the entity that triggered the event
-    /// \param [in] _stamp Time stamp of the event
-    private: void Publish(const Entity &_entity, const std::string &_name,
-                          bool _state, const math::Pose3d &_pose,
-                          const std::chrono::steady_clock::duration &_stamp);
-
-    /// \brief Keeps a set of detected entities
-    private: std::unordered_set<Entity> detectedEntities;
-
     /// \brief The model associated with this system.
     private: Model model;
 
@@ -128,6 +105,13 @@ namespace systems
 
     /// \brief Whether the system has been initialized
     private: bool initialized{false};
+
+    /// \brief Index of this detector in the shared registry, or the
+    /// registry's invalid index while it is not registered. All detection
+    /// state lives in the registry so performers query detectors through
+    /// one spatial hash instead of every detector scanning every performer.
+    private: std::size_t registryIndex{
+                 std::numeric_limits<std::size_t>::max()};
   };
 
   }
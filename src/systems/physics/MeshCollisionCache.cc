@@ -0,0 +1,338 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "MeshCollisionCache.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/MeshManager.hh>
+#include <ignition/common/SubMesh.hh>
+#include <ignition/common/Util.hh>
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+/// \brief Format version, bumped whenever the binary layout changes so
+/// stale entries are ignored rather than misread.
+static constexpr uint32_t kCacheFormatVersion{1};
+
+/// \brief Magic bytes identifying a cached collision mesh file.
+static constexpr char kCacheMagic[] = "IGNCOLMESH";
+
+/////////////////////////////////////////////////
+/// \brief FNV-1a hash of a buffer.
+/// \param[in] _data Buffer to hash.
+/// \return 64-bit hash.
+static uint64_t HashContents(const std::string &_data)
+{
+  uint64_t hash = 0xcbf29ce484222325u;
+  for (const unsigned char c : _data)
+  {
+    hash ^= c;
+    hash *= 0x100000001b3u;
+  }
+  return hash;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a whole file into a string.
+/// \param[in] _path Path to the file to read.
+/// \param[out] _contents Contents of the file.
+/// \return True if the file could be read.
+static bool ReadFileContents(const std::string &_path, std::string &_contents)
+{
+  std::ifstream in(_path, std::ios::binary);
+  if (!in)
+    return false;
+
+  std::ostringstream stream;
+  stream << in.rdbuf();
+  _contents = stream.str();
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the directory holding cached collision meshes.
+/// \return Path to the mesh cache directory, or empty if the home
+/// directory can't be resolved.
+static std::string MeshCacheDirectory()
+{
+  std::string home;
+  if (!common::env(IGN_HOMEDIR, home))
+    return "";
+  return common::joinPaths(home, ".ignition", "gazebo", "meshcache");
+}
+
+/////////////////////////////////////////////////
+/// \brief Write one plain value in binary.
+template <typename T>
+static void WriteValue(std::ofstream &_out, const T &_value)
+{
+  _out.write(reinterpret_cast<const char *>(&_value), sizeof(_value));
+}
+
+/////////////////////////////////////////////////
+/// \brief Read one plain value in binary.
+template <typename T>
+static void ReadValue(std::ifstream &_in, T &_value)
+{
+  _in.read(reinterpret_cast<char *>(&_value), sizeof(_value));
+}
+
+/////////////////////////////////////////////////
+/// \brief Serialize the collision-relevant part of a mesh: per submesh,
+/// its primitive type, vertex positions and indices. Normals, texture
+/// coordinates and materials are not stored; physics doesn't read them.
+/// \param[in] _path Path to write to.
+/// \param[in] _mesh Mesh to serialize.
+static void WriteCachedMesh(const std::string &_path,
+    const common::Mesh &_mesh)
+{
+  std::ofstream out(_path, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    ignwarn << "Failed to write collision mesh cache entry ["
+            << _path << "].\n";
+    return;
+  }
+
+  out.write(kCacheMagic, sizeof(kCacheMagic));
+  WriteValue(out, kCacheFormatVersion);
+
+  const uint32_t subMeshCount = _mesh.SubMeshCount();
+  WriteValue(out, subMeshCount);
+  for (uint32_t s = 0; s < subMeshCount; ++s)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(s).lock();
+
+    const uint32_t primitiveType =
+        static_cast<uint32_t>(subMesh->SubMeshPrimitiveType());
+    WriteValue(out, primitiveType);
+
+    const uint64_t vertexCount = subMesh->VertexCount();
+    WriteValue(out, vertexCount);
+    for (uint64_t v = 0; v < vertexCount; ++v)
+    {
+      const math::Vector3d vertex = subMesh->Vertex(v);
+      WriteValue(out, vertex.X());
+      WriteValue(out, vertex.Y());
+      WriteValue(out, vertex.Z());
+    }
+
+    const uint64_t indexCount = subMesh->IndexCount();
+    WriteValue(out, indexCount);
+    for (uint64_t i = 0; i < indexCount; ++i)
+    {
+      const uint32_t index = subMesh->Index(i);
+      WriteValue(out, index);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Reconstruct a mesh from a cache entry.
+/// \param[in] _path Path to read from.
+/// \return The mesh, or nullptr if the entry is corrupt or from another
+/// format version.
+static std::unique_ptr<common::Mesh> ReadCachedMesh(const std::string &_path)
+{
+  std::ifstream in(_path, std::ios::binary);
+  if (!in)
+    return nullptr;
+
+  char magic[sizeof(kCacheMagic)];
+  in.read(magic, sizeof(magic));
+  uint32_t version{0};
+  ReadValue(in, version);
+  if (!in.good() || 0 != std::memcmp(magic, kCacheMagic, sizeof(magic)) ||
+      kCacheFormatVersion != version)
+  {
+    return nullptr;
+  }
+
+  auto mesh = std::make_unique<common::Mesh>();
+
+  uint32_t subMeshCount{0};
+  ReadValue(in, subMeshCount);
+  for (uint32_t s = 0; s < subMeshCount && in.good(); ++s)
+  {
+    common::SubMesh subMesh;
+
+    uint32_t primitiveType{0};
+    ReadValue(in, primitiveType);
+    subMesh.SetPrimitiveType(
+        static_cast<common::SubMesh::PrimitiveType>(primitiveType));
+
+    uint64_t vertexCount{0};
+    ReadValue(in, vertexCount);
+    for (uint64_t v = 0; v < vertexCount && in.good(); ++v)
+    {
+      double x{0}, y{0}, z{0};
+      ReadValue(in, x);
+      ReadValue(in, y);
+      ReadValue(in, z);
+      subMesh.AddVertex(x, y, z);
+    }
+
+    uint64_t indexCount{0};
+    ReadValue(in, indexCount);
+    for (uint64_t i = 0; i < indexCount && in.good(); ++i)
+    {
+      uint32_t index{0};
+      ReadValue(in, index);
+      subMesh.AddIndex(index);
+    }
+
+    mesh->AddSubMesh(subMesh);
+  }
+
+  // A short read means a truncated entry; treat it like a miss so the
+  // mesh gets reparsed and the entry rewritten.
+  if (!in.good())
+    return nullptr;
+
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+const common::Mesh *MeshCollisionCache::Load(const std::string &_path)
+{
+  auto &meshManager = *common::MeshManager::Instance();
+
+  // Already parsed in this process, by us or by anyone else.
+  if (meshManager.HasMesh(_path))
+    return meshManager.MeshByName(_path);
+
+  {
+    std::lock_guard<std::mutex> lock(this->meshesMutex);
+    auto cachedIt = this->meshes.find(_path);
+    if (cachedIt != this->meshes.end())
+      return cachedIt->second.get();
+  }
+
+  std::string contents;
+  if (!ReadFileContents(_path, contents))
+  {
+    // Let the mesh manager produce its usual error.
+    return meshManager.Load(_path);
+  }
+
+  std::string cacheDir = MeshCacheDirectory();
+  if (cacheDir.empty())
+    return meshManager.Load(_path);
+
+  std::ostringstream fileName;
+  fileName << std::hex << HashContents(contents) << ".colmesh";
+  std::string cachePath = common::joinPaths(cacheDir, fileName.str());
+
+  if (common::exists(cachePath))
+  {
+    auto mesh = ReadCachedMesh(cachePath);
+    if (nullptr != mesh)
+    {
+      igndbg << "Loaded collision mesh [" << _path << "] from cache ["
+             << cachePath << "].\n";
+      mesh->SetName(_path);
+
+      // If a concurrent prefetch thread reconstructed the same entry
+      // first, keep its copy: its pointer may already be in use.
+      std::lock_guard<std::mutex> lock(this->meshesMutex);
+      auto &slot = this->meshes[_path];
+      if (nullptr == slot)
+        slot = std::move(mesh);
+      return slot.get();
+    }
+    ignwarn << "Ignoring unreadable collision mesh cache entry ["
+            << cachePath << "].\n";
+  }
+
+  auto *mesh = meshManager.Load(_path);
+  if (nullptr == mesh)
+    return nullptr;
+
+  if (common::exists(cacheDir) || common::createDirectories(cacheDir))
+    WriteCachedMesh(cachePath, *mesh);
+  else
+    ignwarn << "Failed to create mesh cache directory [" << cacheDir << "].\n";
+
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+void MeshCollisionCache::Prefetch(const std::vector<std::string> &_paths)
+{
+  // Fold duplicates and drop what is already resident, so threads are
+  // only spent on distinct cold files.
+  std::vector<std::string> pending;
+  {
+    auto &meshManager = *common::MeshManager::Instance();
+    std::unordered_set<std::string> seen;
+    std::lock_guard<std::mutex> lock(this->meshesMutex);
+    for (const auto &path : _paths)
+    {
+      if (!seen.insert(path).second)
+        continue;
+      if (meshManager.HasMesh(path) ||
+          this->meshes.find(path) != this->meshes.end())
+      {
+        continue;
+      }
+      pending.push_back(path);
+    }
+  }
+
+  if (pending.empty())
+    return;
+  if (pending.size() == 1)
+  {
+    this->Load(pending.front());
+    return;
+  }
+
+  const unsigned int threadCount = std::min<unsigned int>(
+      {static_cast<unsigned int>(pending.size()), 8u,
+       std::max(1u, std::thread::hardware_concurrency())});
+
+  // Threads claim paths off a shared cursor, so a batch of small meshes
+  // doesn't idle behind one giant one.
+  std::atomic<std::size_t> next{0};
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < threadCount; ++t)
+  {
+    threads.push_back(std::thread([this, &pending, &next]()
+    {
+      for (std::size_t i = next.fetch_add(1); i < pending.size();
+          i = next.fetch_add(1))
+      {
+        this->Load(pending[i]);
+      }
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMS_PHYSICS_MESHCOLLISIONCACHE_HH_
+#define IGNITION_GAZEBO_SYSTEMS_PHYSICS_MESHCOLLISIONCACHE_HH_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/common/Mesh.hh>
+
+#include "ignition/gazebo/config.hh"
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems
+{
+  /// \brief On-disk cache for collision meshes.
+  ///
+  /// Parsing collision meshes (DAE/OBJ/STL) dominates load time for worlds
+  /// that spawn many copies of the same models, and the result never changes
+  /// for a given file. This cache stores the parsed triangle data (vertex
+  /// positions and indices, all a physics engine consumes) in a compact
+  /// binary file keyed by a hash of the mesh file contents, next to the
+  /// world cache under `~/.ignition/gazebo/`. Subsequent loads of the same
+  /// file, in this or any later process, skip the mesh parser entirely.
+  ///
+  /// Scale and pose are not part of the key: they are applied when the
+  /// shape is attached to the engine, not baked into the mesh.
+  class MeshCollisionCache
+  {
+    /// \brief Load a collision mesh, consulting the caches first.
+    ///
+    /// Lookup order: meshes already parsed by common::MeshManager in this
+    /// process, meshes reconstructed earlier by this cache, the on-disk
+    /// cache, and finally the mesh parser (whose result is then written to
+    /// disk for the next load).
+    /// \param[in] _path Full path to the mesh file.
+    /// \return The mesh, or nullptr if it could not be loaded. The pointer
+    /// remains valid for the lifetime of this cache.
+    public: const common::Mesh *Load(const std::string &_path);
+
+    /// \brief Load a batch of collision meshes across a pool of IO
+    /// threads, deduplicating the list first so repeated paths load
+    /// once. Mesh IO is independent per file, so a world spawning many
+    /// distinct meshes loads them in the time of the slowest one instead
+    /// of their sum. Loads that fall through every cache funnel into the
+    /// mesh parser, which serializes behind common::MeshManager's lock;
+    /// those overlap their file reads but not their parses.
+    ///
+    /// Failures are not reported here: the per-collision Load that
+    /// follows finds the miss and warns with its usual context.
+    /// \param[in] _paths Full paths of the mesh files, duplicates welcome.
+    public: void Prefetch(const std::vector<std::string> &_paths);
+
+    /// \brief Meshes reconstructed from the on-disk cache, which
+    /// common::MeshManager never sees. Keyed by mesh file path.
+    private: std::unordered_map<std::string,
+                 std::unique_ptr<common::Mesh>> meshes;
+
+    /// \brief Protects `meshes` from concurrent prefetch threads. File
+    /// reads and parses run outside it.
+    private: std::mutex meshesMutex;
+  };
+}
+}
+}
+}
+#endif
@@ -21,12 +21,18 @@
 #include <ignition/msgs/Utility.hh>
 
 #include <iostream>
+#include <algorithm>
 #include <deque>
+#include <future>
+#include <stdexcept>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
-#include <ignition/common/MeshManager.hh>
 #include <ignition/common/Profiler.hh>
 #include <ignition/common/SystemPaths.hh>
+#include <ignition/common/Util.hh>
 #include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/eigen3/Conversions.hh>
 #include <ignition/physics/config.hh>
@@ -70,6 +76,8 @@
 #include <sdf/World.hh>
 
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/StaticSystemRegistry.hh"
+#include "ignition/gazebo/StepArena.hh"
 #include "ignition/gazebo/Util.hh"
 
 // Components
@@ -80,6 +88,7 @@
 #include "ignition/gazebo/components/CanonicalLink.hh"
 #include "ignition/gazebo/components/ChildLinkName.hh"
 #include "ignition/gazebo/components/Collision.hh"
+#include "ignition/gazebo/components/ContactPairFilter.hh"
 #include "ignition/gazebo/components/ContactSensorData.hh"
 #include "ignition/gazebo/components/Geometry.hh"
 #include "ignition/gazebo/components/Gravity.hh"
@@ -103,6 +112,7 @@
 #include "ignition/gazebo/components/ExternalWorldWrenchCmd.hh"
 #include "ignition/gazebo/components/JointForceCmd.hh"
 #include "ignition/gazebo/components/PhysicsEnginePlugin.hh"
+#include "ignition/gazebo/components/PhysicsSleeping.hh"
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/PoseCmd.hh"
 #include "ignition/gazebo/components/SelfCollide.hh"
@@ -110,12 +120,116 @@
 #include "ignition/gazebo/components/ThreadPitch.hh"
 #include "ignition/gazebo/components/World.hh"
 
+#include "MeshCollisionCache.hh"
 #include "Physics.hh"
 
 using namespace ignition;
 using namespace ignition::gazebo::systems;
 namespace components = ignition::gazebo::components;
 
+namespace
+{
+/// \brief A map from ECM entities to physics objects, backed by a dense
+/// vector indexed directly by entity id. Entity ids are compact —
+/// removed ids are recycled before new ones are minted — so the vector
+/// stays dense and the per-entity lookups in the 1 kHz UpdatePhysics
+/// and UpdateSim loops become direct indexing instead of hash probing.
+/// The interface mirrors the subset of std::unordered_map used in this
+/// file, so call sites read the same.
+template <typename ValueT>
+class EntityIndexedMap
+{
+  /// \brief Iterators are pointers into the dense storage; end() is
+  /// nullptr.
+  public: using iterator = std::pair<gazebo::Entity, ValueT> *;
+  public: using const_iterator = const std::pair<gazebo::Entity, ValueT> *;
+
+  /// \brief Find the entry for an entity.
+  /// \param[in] _entity Entity to look up.
+  /// \return Iterator to the entry, or end() if the entity has no entry.
+  public: iterator find(const gazebo::Entity _entity)
+  {
+    if (_entity < this->occupied.size() && this->occupied[_entity])
+      return &this->storage[_entity];
+    return nullptr;
+  }
+
+  /// \brief Const version of find().
+  public: const_iterator find(const gazebo::Entity _entity) const
+  {
+    if (_entity < this->occupied.size() && this->occupied[_entity])
+      return &this->storage[_entity];
+    return nullptr;
+  }
+
+  /// \brief Past-the-end iterator.
+  public: iterator end()
+  {
+    return nullptr;
+  }
+
+  /// \brief Const version of end().
+  public: const_iterator end() const
+  {
+    return nullptr;
+  }
+
+  /// \brief Get the value stored for an entity.
+  /// \param[in] _entity Entity to look up.
+  /// \return Reference to the stored value.
+  /// \throws std::out_of_range if the entity has no entry.
+  public: ValueT &at(const gazebo::Entity _entity)
+  {
+    auto iter = this->find(_entity);
+    if (nullptr == iter)
+      throw std::out_of_range("EntityIndexedMap: no entry for entity");
+    return iter->second;
+  }
+
+  /// \brief Insert an entry. Like std::unordered_map, an existing entry
+  /// for the same entity is left untouched.
+  /// \param[in] _value Entity and value pair to insert.
+  public: void insert(const std::pair<gazebo::Entity, ValueT> &_value)
+  {
+    const auto entity = _value.first;
+    if (entity >= this->occupied.size())
+    {
+      this->occupied.resize(entity + 1, false);
+      this->storage.resize(entity + 1);
+    }
+    if (!this->occupied[entity])
+    {
+      this->occupied[entity] = true;
+      this->storage[entity] = _value;
+    }
+  }
+
+  /// \brief Remove the entry for an entity, if any.
+  /// \param[in] _entity Entity whose entry is removed.
+  public: void erase(const gazebo::Entity _entity)
+  {
+    if (_entity < this->occupied.size() && this->occupied[_entity])
+    {
+      this->occupied[_entity] = false;
+      this->storage[_entity] = {};
+    }
+  }
+
+  /// \brief Remove the entry an iterator points to.
+  /// \param[in] _iter Iterator returned by find(). end() is ignored.
+  public: void erase(iterator _iter)
+  {
+    if (nullptr != _iter)
+      this->erase(_iter->first);
+  }
+
+  /// \brief Dense storage, indexed by entity id.
+  private: std::vector<std::pair<gazebo::Entity, ValueT>> storage;
+
+  /// \brief Which slots currently hold an entry.
+  private: std::vector<bool> occupied;
+};
+}
 
 // Private data class.
 class ignition::gazebo::systems::PhysicsPrivate
@@ -168,6 +282,11 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// \param[in] _ecm Constant reference to ECM.
   public: void UpdatePhysics(EntityComponentManager &_ecm);
 
+  /// \brief Restore the initial state (model poses, velocities, joint
+  /// states) into the existing engine objects, without destroying them.
+  /// \param[in] _ecm Mutable reference to ECM.
+  public: void Reset(EntityComponentManager &_ecm);
+
   /// \brief Step the simulationrfor each world
   /// \param[in] _dt Duration
   public: void Step(const std::chrono::steady_clock::duration &_dt);
@@ -187,17 +306,60 @@ class ignition::gazebo::systems::PhysicsPrivate
   public: physics::FrameData3d LinkFrameDataAtOffset(
       const LinkPtrType &_link, const math::Pose3d &_pose) const;
 
+  /// \brief Frame data of one link, pulled from the physics engine
+  /// before being applied to the ECM in UpdateSim.
+  public: struct LinkFrameUpdate
+  {
+    /// \brief Link entity in the ECM.
+    Entity entity;
+
+    /// \brief Parent model entity.
+    Entity parent;
+
+    /// \brief The link's local pose component.
+    components::Pose *pose;
+
+    /// \brief The parent model's pose component.
+    components::Pose *parentPose;
+
+    /// \brief Whether this is the model's canonical link.
+    bool canonical;
+
+    /// \brief Frame data reported by the physics engine.
+    physics::FrameData3d frameData;
+  };
+
+  /// \brief Scratch buffer for the pose write-back, reused across steps
+  /// to avoid per-step allocations.
+  public: std::vector<LinkFrameUpdate> linkFrameBuffer;
+
+  /// \brief Scratch buffer of entities whose Pose component changed in
+  /// the current step, used to mark the changes in one batch.
+  public: std::vector<Entity> changedPoseEntities;
+
+  /// \brief Number of consecutive steps each link has spent at rest,
+  /// used to decide when to tag it with PhysicsSleeping.
+  public: EntityIndexedMap<uint32_t> linkRestSteps;
+
+  /// \brief Squared velocity magnitude below which a link counts as at
+  /// rest for sleep tracking.
+  public: double sleepVelocitySq{1e-6};
+
+  /// \brief Number of consecutive at-rest steps before a link is tagged
+  /// with PhysicsSleeping and its write-back is skipped.
+  public: uint32_t sleepSteps{100};
+
   /// \brief A map between world entity ids in the ECM to World Entities in
   /// ign-physics.
   public: std::unordered_map<Entity, WorldPtrType> entityWorldMap;
 
   /// \brief A map between model entity ids in the ECM to Model Entities in
-  /// ign-physics.
-  public: std::unordered_map<Entity, ModelPtrType> entityModelMap;
+  /// ign-physics, consulted per entity per step.
+  public: EntityIndexedMap<ModelPtrType> entityModelMap;
 
   /// \brief A map between link entity ids in the ECM to Link Entities in
-  /// ign-physics.
-  public: std::unordered_map<Entity, LinkPtrType> entityLinkMap;
+  /// ign-physics, consulted per entity per step.
+  public: EntityIndexedMap<LinkPtrType> entityLinkMap;
 
   /// \brief Reverse of entityLinkMap. This is used for finding the Entity
   /// associated with a physics Link
@@ -263,8 +425,8 @@ class ignition::gazebo::systems::PhysicsPrivate
             ignition::physics::FeaturePolicy3d, JointFeatureList>;
 
   /// \brief A map between joint entity ids in the ECM to Joint Entities in
-  /// ign-physics
-  public: std::unordered_map<Entity, JointPtrType> entityJointMap;
+  /// ign-physics, consulted per entity per step.
+  public: EntityIndexedMap<JointPtrType> entityJointMap;
 
   /// \brief A map between model entity ids in the ECM to Model Entities in
   /// ign-physics, with attach feature.
@@ -330,8 +492,8 @@ class ignition::gazebo::systems::PhysicsPrivate
             ignition::physics::FeaturePolicy3d, CollisionFeatureList>;
 
   /// \brief A map between collision entity ids in the ECM to Shape Entities in
-  /// ign-physics.
-  public: std::unordered_map<Entity, ShapePtrType> entityCollisionMap;
+  /// ign-physics, consulted per entity per step.
+  public: EntityIndexedMap<ShapePtrType> entityCollisionMap;
 
   /// \brief A map between shape entities in ign-physics to collision entities
   /// in the ECM. This is the reverse map of entityCollisionMap.
@@ -441,6 +603,128 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// that here they've been casted for `MeshFeatureList`.
   public: std::unordered_map<Entity, LinkMeshPtrType>
       entityLinkMeshMap;
+
+  /// \brief On-disk cache of parsed collision meshes, so repeated loads
+  /// of the same mesh files skip the mesh parser.
+  public: MeshCollisionCache meshCache;
+
+  //////////////////////////////////////////////////
+  // World reset
+
+  /// \brief Feature list for zeroing free group velocities on reset.
+  public: using FreeGroupVelocityFeatureList = physics::FeatureList<
+            MinimumFeatureList,
+            physics::SetFreeGroupWorldVelocity>;
+
+  /// \brief Free group type with world velocity feature.
+  public: using FreeGroupVelocityPtrType = physics::FreeGroupPtr<
+            physics::FeaturePolicy3d, FreeGroupVelocityFeatureList>;
+
+  /// \brief A map between model entity ids in the ECM and their free
+  /// groups casted for `FreeGroupVelocityFeatureList`.
+  public: std::unordered_map<Entity, FreeGroupVelocityPtrType>
+      freeGroupVelocityMap;
+
+  /// \brief Raw pose each model was constructed with, so a rewind can
+  /// restore it into the existing engine objects. Tearing the objects
+  /// down and reconstructing them dominates reset latency, so they are
+  /// reused instead.
+  public: std::unordered_map<Entity, math::Pose3d> initialModelPoses;
+
+  /// \brief Arena of the current update phase, refreshed from
+  /// UpdateInfo each Update call. Backs the per-step temporary
+  /// containers below, so their storage is recycled in bulk instead of
+  /// going through the heap every step. Null until the first Update.
+  public: StepArena *arena{nullptr};
+
+  //////////////////////////////////////////////////
+  // Physics islands
+
+  /// \brief True if each non-static model is placed in its own engine
+  /// world so the worlds can be stepped in parallel. Enabled with the
+  /// IGN_GAZEBO_PHYSICS_ISLANDS environment variable. The engine can't
+  /// move entities between worlds, so contacts and joints between two
+  /// non-static models are not resolved in this mode.
+  public: bool islandMode{false};
+
+  /// \brief Copy of the world SDF DOM, used to construct island worlds.
+  public: sdf::World islandWorldSdf;
+
+  /// \brief Engine worlds holding one non-static model each, plus
+  /// replicas of the static environment. Stepped in parallel.
+  public: std::vector<WorldPtrType> islandWorlds;
+
+  /// \brief Each island world casted for `CollisionFeatureList`, indexed
+  /// like `islandWorlds`. Entries are null if the engine doesn't support
+  /// collision features.
+  public: std::vector<WorldShapePtrType> islandWorldCollisionCasts;
+
+  /// \brief Indices into `islandWorlds` whose model has been removed.
+  /// The engine can't remove worlds, so they are kept and reused for the
+  /// next model.
+  public: std::vector<std::size_t> freeIslands;
+
+  /// \brief A map between non-static model entity ids in the ECM and the
+  /// index of the island world that holds them.
+  public: std::unordered_map<Entity, std::size_t> modelIslandMap;
+
+  /// \brief One collision of a static model, kept to replicate it into
+  /// island worlds created after the model.
+  public: struct StaticCollisionRecord
+  {
+    /// \brief Collision entity in the ECM.
+    Entity entity;
+
+    /// \brief Parent link entity in the ECM.
+    Entity linkEntity;
+
+    /// \brief The collision SDF DOM, with its pose already resolved
+    /// w.r.t. the parent link.
+    sdf::Collision collision;
+  };
+
+  /// \brief Everything needed to replicate one static model into each
+  /// island world, so every island sees the full static environment.
+  public: struct StaticModelRecord
+  {
+    /// \brief The model SDF DOM as constructed in the main world.
+    sdf::Model model;
+
+    /// \brief Link entity and SDF DOM of each of the model's links.
+    std::vector<std::pair<Entity, sdf::Link>> links;
+
+    /// \brief The model's collisions.
+    std::vector<StaticCollisionRecord> collisions;
+
+    /// \brief Replica of the model in each island world, indexed like
+    /// `islandWorlds`.
+    std::vector<ModelPtrType> modelReplicas;
+
+    /// \brief Replicas of each link, indexed like `islandWorlds`.
+    std::unordered_map<Entity, std::vector<LinkPtrType>> linkReplicas;
+
+    /// \brief All the replica shapes, kept so they can be removed from
+    /// `collisionEntityMap` with the model.
+    std::vector<ShapePtrType> shapeReplicas;
+  };
+
+  /// \brief A map between static model entity ids in the ECM and their
+  /// replication records.
+  public: std::unordered_map<Entity, StaticModelRecord> staticModelRecords;
+
+  /// \brief Get an island world for a newly created model, either by
+  /// reusing a freed one or by constructing a new world seeded with the
+  /// static environment.
+  /// \return Index of the island in `islandWorlds`.
+  public: std::size_t AcquireIslandWorld();
+
+  /// \brief Construct one collision on an island replica of a static
+  /// link, mirroring how the original collision was constructed.
+  /// \param[in] _link Replica of the collision's parent link.
+  /// \param[in] _collision Collision SDF DOM, pose already resolved.
+  /// \return The constructed shape, or nullptr on failure.
+  public: ShapePtrType ConstructReplicaCollision(const LinkPtrType &_link,
+      const sdf::Collision &_collision);
 };
 
 //////////////////////////////////////////////////
@@ -558,6 +842,21 @@ void Physics::Configure(const Entity &_entity,
     ignerr << "Failed to load a valid physics engine from [" << pathToLib
            << "]."
            << std::endl;
+    return;
+  }
+
+  std::string islandsValue;
+  if (common::env("IGN_GAZEBO_PHYSICS_ISLANDS", islandsValue))
+  {
+    std::transform(islandsValue.begin(), islandsValue.end(),
+        islandsValue.begin(), ::tolower);
+    this->dataPtr->islandMode = islandsValue == "1" || islandsValue == "true";
+    if (this->dataPtr->islandMode)
+    {
+      ignmsg << "Physics island partitioning enabled. Each model is stepped "
+             << "in its own engine world; contacts and joints between "
+             << "non-static models won't be resolved." << std::endl;
+    }
   }
 }
 
@@ -569,12 +868,28 @@ void Physics::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
 {
   IGN_PROFILE("Physics::Update");
 
-  // \TODO(anyone) Support rewind
+  // Per-step temporaries below draw from the phase arena; it is valid
+  // for this Update call only.
+  this->dataPtr->arena = _info.arena;
+
   if (_info.dt < std::chrono::steady_clock::duration::zero())
   {
-    ignwarn << "Detected jump back in time ["
-        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
-        << "s]. System may not work properly." << std::endl;
+    // A jump back to time zero is a world reset: restore the initial
+    // state into the existing engine objects, which is much cheaper
+    // than tearing them down and reconstructing them.
+    if (std::chrono::steady_clock::duration::zero() == _info.simTime &&
+        this->dataPtr->engine)
+    {
+      this->dataPtr->Reset(_ecm);
+    }
+    else
+    {
+      // \TODO(anyone) Support seeking to other times
+      ignwarn << "Detected jump back in time ["
+          << std::chrono::duration_cast<std::chrono::seconds>(
+          _info.dt).count()
+          << "s]. System may not work properly." << std::endl;
+    }
   }
 
   if (this->dataPtr->engine)
@@ -620,6 +935,12 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
         auto worldPtrPhys = this->engine->ConstructWorld(world);
         this->entityWorldMap.insert(std::make_pair(_entity, worldPtrPhys));
 
+        // Keep the DOM around to construct island worlds from
+        if (this->islandMode)
+        {
+          this->islandWorldSdf = world;
+        }
+
         return true;
       });
 
@@ -659,7 +980,8 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
         model.SetRawPose(_pose->Data());
 
         auto staticComp = _ecm.Component<components::Static>(_entity);
-        if (staticComp && staticComp->Data())
+        bool isStatic = staticComp && staticComp->Data();
+        if (isStatic)
         {
           model.SetStatic(staticComp->Data());
         }
@@ -670,9 +992,35 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
           model.SetSelfCollide(selfCollideComp->Data());
         }
 
+        // Each non-static model goes into its own island world, so the
+        // islands can be stepped in parallel.
+        if (this->islandMode && !isStatic)
+        {
+          auto island = this->AcquireIslandWorld();
+          worldPtrPhys = this->islandWorlds[island];
+          this->modelIslandMap[_entity] = island;
+        }
+
         auto modelPtrPhys = worldPtrPhys->ConstructModel(model);
         this->entityModelMap.insert(std::make_pair(_entity, modelPtrPhys));
 
+        // Capture the initial pose so a rewind can restore it into the
+        // engine objects instead of reconstructing them.
+        this->initialModelPoses[_entity] = _pose->Data();
+
+        // Record static models and replicate them into every island, so
+        // each island sees the full static environment.
+        if (this->islandMode && isStatic)
+        {
+          auto &record = this->staticModelRecords[_entity];
+          record.model = model;
+          for (auto &islandWorld : this->islandWorlds)
+          {
+            record.modelReplicas.push_back(
+                islandWorld->ConstructModel(model));
+          }
+        }
+
         return true;
       });
 
@@ -720,11 +1068,49 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
         this->entityLinkMap.insert(std::make_pair(_entity, linkPtrPhys));
         this->linkEntityMap.insert(std::make_pair(linkPtrPhys, _entity));
 
+        // Replicate links of static models into each island world
+        if (this->islandMode)
+        {
+          auto recordIt = this->staticModelRecords.find(_parent->Data());
+          if (recordIt != this->staticModelRecords.end())
+          {
+            auto &record = recordIt->second;
+            record.links.push_back(std::make_pair(_entity, link));
+            auto &replicas = record.linkReplicas[_entity];
+            for (auto &modelReplica : record.modelReplicas)
+            {
+              replicas.push_back(modelReplica->ConstructLink(link));
+            }
+          }
+        }
+
         return true;
       });
 
   // We don't need to add visuals to the physics engine.
 
+  // Warm the mesh cache for every new collision in one parallel batch
+  // before the shapes are attached one by one below, so a world with
+  // many distinct meshes pays for its mesh IO once, in the time of the
+  // slowest file. The prefetch deduplicates repeated URIs itself.
+  {
+    std::vector<std::string> meshPaths;
+    _ecm.EachNew<components::Collision, components::Geometry>(
+        [&](const Entity &, const components::Collision *,
+            const components::Geometry *_geom) -> bool
+        {
+          if (_geom->Data().Type() == sdf::GeometryType::MESH &&
+              nullptr != _geom->Data().MeshShape())
+          {
+            const sdf::Mesh *meshSdf = _geom->Data().MeshShape();
+            meshPaths.push_back(
+                asFullPath(meshSdf->Uri(), meshSdf->FilePath()));
+          }
+          return true;
+        });
+    this->meshCache.Prefetch(meshPaths);
+  }
+
   // collisions
   _ecm.EachNew<components::Collision, components::Name, components::Pose,
             components::Geometry, components::CollisionElement,
@@ -775,9 +1161,8 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
             return true;
           }
 
-          auto &meshManager = *ignition::common::MeshManager::Instance();
           auto fullPath = asFullPath(meshSdf->Uri(), meshSdf->FilePath());
-          auto *mesh = meshManager.Load(fullPath);
+          const auto *mesh = this->meshCache.Load(fullPath);
           if (nullptr == mesh)
           {
             ignwarn << "Failed to load mesh from [" << fullPath
@@ -851,6 +1236,34 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
             std::make_pair(_entity, collisionPtrPhys));
         this->collisionEntityMap.insert(
             std::make_pair(collisionPtrPhys, _entity));
+
+        // Replicate collisions of static models into each island world.
+        // The replicas map back to this collision's entity, so contacts
+        // against them resolve like contacts in the main world.
+        if (this->islandMode)
+        {
+          auto linkModel =
+              _ecm.Component<components::ParentEntity>(_parent->Data());
+          auto recordIt = linkModel == nullptr ?
+              this->staticModelRecords.end() :
+              this->staticModelRecords.find(linkModel->Data());
+          if (recordIt != this->staticModelRecords.end())
+          {
+            auto &record = recordIt->second;
+            record.collisions.push_back({_entity, _parent->Data(), collision});
+            for (auto &linkReplica : record.linkReplicas[_parent->Data()])
+            {
+              auto shapeReplica =
+                  this->ConstructReplicaCollision(linkReplica, collision);
+              if (shapeReplica)
+              {
+                record.shapeReplicas.push_back(shapeReplica);
+                this->collisionEntityMap.insert(
+                    std::make_pair(shapeReplica, _entity));
+              }
+            }
+          }
+        }
         return true;
       });
 
@@ -988,6 +1401,32 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
           return true;
         }
 
+        // Both links must live in the same engine world. The engine
+        // can't join bodies across worlds, so a joint between two
+        // islands can't be created.
+        if (this->islandMode)
+        {
+          auto parentModel = _ecm.Component<components::ParentEntity>(
+              _jointInfo->Data().parentLink);
+          auto childModel =
+              _ecm.Component<components::ParentEntity>(childLinkEntity);
+          auto parentIslandIt = parentModel == nullptr ?
+              this->modelIslandMap.end() :
+              this->modelIslandMap.find(parentModel->Data());
+          auto childIslandIt = childModel == nullptr ?
+              this->modelIslandMap.end() :
+              this->modelIslandMap.find(childModel->Data());
+          if (parentIslandIt == this->modelIslandMap.end() ||
+              childIslandIt == this->modelIslandMap.end() ||
+              parentIslandIt->second != childIslandIt->second)
+          {
+            ignwarn << "Cannot create detachable joint [" << _entity
+                    << "]: the parent and child links are in different "
+                    << "physics islands." << std::endl;
+            return true;
+          }
+        }
+
         auto childLinkDetachableJointFeature = entityCast(childLinkEntity,
             childLinkIt->second, this->entityLinkDetachableJointMap);
         if (!childLinkDetachableJointFeature)
@@ -1072,6 +1511,7 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
               this->linkEntityMap.erase(linkPhysIt->second);
             }
             this->entityLinkMap.erase(childLink);
+            this->linkRestSteps.erase(childLink);
           }
 
           for (const auto &childJoint :
@@ -1083,6 +1523,35 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
           // Remove the model from the physics engine
           modelIt->second->Remove();
           this->entityModelMap.erase(_entity);
+          this->freeGroupVelocityMap.erase(_entity);
+          this->initialModelPoses.erase(_entity);
+
+          if (this->islandMode)
+          {
+            // The model's island world is kept and reused for the next
+            // model, since the engine can't remove worlds.
+            auto islandIt = this->modelIslandMap.find(_entity);
+            if (islandIt != this->modelIslandMap.end())
+            {
+              this->freeIslands.push_back(islandIt->second);
+              this->modelIslandMap.erase(islandIt);
+            }
+
+            // Remove the replicas of a static model from all the islands
+            auto recordIt = this->staticModelRecords.find(_entity);
+            if (recordIt != this->staticModelRecords.end())
+            {
+              for (const auto &shapeReplica : recordIt->second.shapeReplicas)
+              {
+                this->collisionEntityMap.erase(shapeReplica);
+              }
+              for (const auto &modelReplica : recordIt->second.modelReplicas)
+              {
+                modelReplica->Remove();
+              }
+              this->staticModelRecords.erase(recordIt);
+            }
+          }
         }
         return true;
       });
@@ -1122,6 +1591,85 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
       });
 }
 
+//////////////////////////////////////////////////
+std::size_t PhysicsPrivate::AcquireIslandWorld()
+{
+  if (!this->freeIslands.empty())
+  {
+    auto index = this->freeIslands.back();
+    this->freeIslands.pop_back();
+    return index;
+  }
+
+  sdf::World world = this->islandWorldSdf;
+  world.SetName(world.Name() + "::island::" +
+      std::to_string(this->islandWorlds.size()));
+  auto worldPtrPhys = this->engine->ConstructWorld(world);
+
+  // Seed the new island with the static environment
+  for (auto &recordIt : this->staticModelRecords)
+  {
+    auto &record = recordIt.second;
+    auto modelReplica = worldPtrPhys->ConstructModel(record.model);
+    record.modelReplicas.push_back(modelReplica);
+    for (const auto &[linkEntity, linkSdf] : record.links)
+    {
+      record.linkReplicas[linkEntity].push_back(
+          modelReplica->ConstructLink(linkSdf));
+    }
+    for (const auto &collisionRecord : record.collisions)
+    {
+      auto shapeReplica = this->ConstructReplicaCollision(
+          record.linkReplicas[collisionRecord.linkEntity].back(),
+          collisionRecord.collision);
+      if (shapeReplica)
+      {
+        record.shapeReplicas.push_back(shapeReplica);
+        this->collisionEntityMap.insert(
+            std::make_pair(shapeReplica, collisionRecord.entity));
+      }
+    }
+  }
+
+  this->islandWorlds.push_back(worldPtrPhys);
+  this->islandWorldCollisionCasts.push_back(
+      physics::RequestFeatures<CollisionFeatureList>::From(worldPtrPhys));
+  return this->islandWorlds.size() - 1;
+}
+
+//////////////////////////////////////////////////
+PhysicsPrivate::ShapePtrType PhysicsPrivate::ConstructReplicaCollision(
+    const LinkPtrType &_link, const sdf::Collision &_collision)
+{
+  if (_collision.Geom()->Type() == sdf::GeometryType::MESH)
+  {
+    const sdf::Mesh *meshSdf = _collision.Geom()->MeshShape();
+    if (nullptr == meshSdf)
+      return nullptr;
+
+    auto fullPath = asFullPath(meshSdf->Uri(), meshSdf->FilePath());
+    const auto *mesh = this->meshCache.Load(fullPath);
+    if (nullptr == mesh)
+      return nullptr;
+
+    auto linkMeshFeature =
+        physics::RequestFeatures<MeshFeatureList>::From(_link);
+    if (!linkMeshFeature)
+      return nullptr;
+
+    return linkMeshFeature->AttachMeshShape(_collision.Name(), *mesh,
+        math::eigen3::convert(_collision.RawPose()),
+        math::eigen3::convert(meshSdf->Scale()));
+  }
+
+  auto linkCollisionFeature =
+      physics::RequestFeatures<CollisionFeatureList>::From(_link);
+  if (!linkCollisionFeature)
+    return nullptr;
+
+  return linkCollisionFeature->ConstructCollision(_collision);
+}
+
 //////////////////////////////////////////////////
 void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
 {
@@ -1345,6 +1893,20 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
         freeGroup->SetWorldPose(math::eigen3::convert(_poseCmd->Data() *
                                 canonicalPoseComp->Data()));
 
+        // A commanded pose has to wake the model, otherwise the
+        // write-back would keep skipping it while it's at rest.
+        for (const auto &childLink :
+             _ecm.ChildrenByComponents(_entity, components::Link()))
+        {
+          auto restIt = this->linkRestSteps.find(childLink);
+          if (restIt != this->linkRestSteps.end())
+            restIt->second = 0;
+          if (_ecm.Component<components::PhysicsSleeping>(childLink))
+            _ecm.RemoveComponent<components::PhysicsSleeping>(childLink);
+        }
+        if (_ecm.Component<components::PhysicsSleeping>(_entity))
+          _ecm.RemoveComponent<components::PhysicsSleeping>(_entity);
+
         // Process pose commands for static models here, as one-time changes
         const components::Static *staticComp =
           _ecm.Component<components::Static>(_entity);
@@ -1368,7 +1930,8 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
   // Note: Removing components from inside an Each call can be dangerous.
   // Instead, we collect all the entities that have the desired components and
   // remove the component from them afterward.
-  std::vector<Entity> entitiesWorldCmd;
+  ArenaVector<Entity> entitiesWorldCmd{
+      StepArenaAllocator<Entity>{this->arena}};
   _ecm.Each<components::WorldPoseCmd>(
       [&](const Entity &_entity, components::WorldPoseCmd*) -> bool
       {
@@ -1380,46 +1943,108 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
   {
     _ecm.RemoveComponent<components::WorldPoseCmd>(entity);
   }
+}
 
-  // Populate bounding box info
-  // Only compute bounding box if component exists to avoid unnecessary
-  // computations
-  _ecm.Each<components::Model, components::AxisAlignedBox>(
-      [&](const Entity &_entity, const components::Model *,
-          components::AxisAlignedBox *_bbox)
-      {
-        auto modelIt = this->entityModelMap.find(_entity);
-        if (modelIt == this->entityModelMap.end())
-        {
-          ignwarn << "Failed to find model [" << _entity << "]." << std::endl;
-          return true;
-        }
-
-        auto bbModel = entityCast(_entity, modelIt->second,
-            this->entityModelBoundingBoxMap);
-        if (!bbModel)
-        {
-          static bool informed{false};
-          if (!informed)
-          {
-            igndbg << "Attempting to get a bounding box, but the physics "
-                   << "engine doesn't support feature "
-                   << "[GetModelBoundingBox]. Bounding box won't be populated."
-                   << std::endl;
-            informed = true;
-          }
+//////////////////////////////////////////////////
+void PhysicsPrivate::Reset(EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("PhysicsPrivate::Reset");
 
-          // Break Each call since no AxisAlignedBox'es can be processed
-          return false;
-        }
+  for (const auto &[entity, initialPose] : this->initialModelPoses)
+  {
+    auto modelIt = this->entityModelMap.find(entity);
+    if (modelIt == this->entityModelMap.end())
+      continue;
 
-        math::AxisAlignedBox bbox =
-            math::eigen3::convert(bbModel->GetAxisAlignedBoundingBox());
-        auto state = _bbox->SetData(bbox, this->axisAlignedBoxEql) ?
+    // Static models never moved, so their engine pose is still the
+    // initial one. Commanded poses on them are restored through the Pose
+    // component below.
+    const components::Static *staticComp =
+        _ecm.Component<components::Static>(entity);
+    if (staticComp && staticComp->Data())
+    {
+      auto poseComp = _ecm.Component<components::Pose>(entity);
+      if (poseComp)
+      {
+        auto state = poseComp->SetData(initialPose, this->pose3Eql) ?
             ComponentState::OneTimeChange :
             ComponentState::NoChange;
-        _ecm.SetChanged(_entity, components::AxisAlignedBox::typeId, state);
+        _ecm.SetChanged(entity, components::Pose::typeId, state);
+      }
+      continue;
+    }
+
+    auto freeGroup = modelIt->second->FindFreeGroup();
+    if (!freeGroup)
+      continue;
+
+    // Get canonical link offset
+    auto linkEntityIt =
+        this->linkEntityMap.find(freeGroup->CanonicalLink());
+    if (linkEntityIt == this->linkEntityMap.end())
+      continue;
+
+    auto canonicalPoseComp =
+        _ecm.Component<components::Pose>(linkEntityIt->second);
+    if (nullptr == canonicalPoseComp)
+      continue;
 
+    // Models are only constructed as children of the world, so the raw
+    // pose captured at construction is the initial world pose.
+    freeGroup->SetWorldPose(math::eigen3::convert(initialPose *
+        canonicalPoseComp->Data()));
+
+    auto freeGroupVel = entityCast(entity, freeGroup,
+        this->freeGroupVelocityMap);
+    if (freeGroupVel)
+    {
+      freeGroupVel->SetWorldLinearVelocity(Eigen::Vector3d::Zero());
+      freeGroupVel->SetWorldAngularVelocity(Eigen::Vector3d::Zero());
+    }
+    else
+    {
+      static bool informed{false};
+      if (!informed)
+      {
+        igndbg << "Attempting to reset model velocities, but the physics "
+               << "engine doesn't support feature "
+               << "[SetFreeGroupWorldVelocity]. Velocities will keep their "
+               << "current values." << std::endl;
+        informed = true;
+      }
+    }
+
+    // The restored pose has to wake the model, otherwise the write-back
+    // would keep skipping it while it's at rest.
+    for (const auto &childLink :
+         _ecm.ChildrenByComponents(entity, components::Link()))
+    {
+      auto restIt = this->linkRestSteps.find(childLink);
+      if (restIt != this->linkRestSteps.end())
+        restIt->second = 0;
+      if (_ecm.Component<components::PhysicsSleeping>(childLink))
+        _ecm.RemoveComponent<components::PhysicsSleeping>(childLink);
+    }
+    if (_ecm.Component<components::PhysicsSleeping>(entity))
+      _ecm.RemoveComponent<components::PhysicsSleeping>(entity);
+  }
+
+  // Joints go back to zero displacement and zero velocity. SDF has no
+  // initial joint state, so zero is the state they were constructed in.
+  _ecm.Each<components::Joint>(
+      [&](const Entity &_entity, const components::Joint *) -> bool
+      {
+        auto jointIt = this->entityJointMap.find(_entity);
+        if (jointIt == this->entityJointMap.end())
+          return true;
+
+        std::size_t nDofs = jointIt->second->GetDegreesOfFreedom();
+        for (std::size_t i = 0; i < nDofs; ++i)
+        {
+          jointIt->second->SetForce(i, 0);
+          jointIt->second->SetVelocity(i, 0);
+          jointIt->second->SetPosition(i, 0);
+        }
         return true;
       });
 }
@@ -1428,6 +2053,26 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
 void PhysicsPrivate::Step(const std::chrono::steady_clock::duration &_dt)
 {
   IGN_PROFILE("PhysicsPrivate::Step");
+
+  // Step the island worlds in parallel tasks. The islands hold
+  // kinematically independent models, so the tasks share no state.
+  std::vector<std::future<void>> islandTasks;
+  islandTasks.reserve(this->islandWorlds.size());
+  for (auto &islandWorld : this->islandWorlds)
+  {
+    islandTasks.push_back(std::async(std::launch::async,
+        [&islandWorld, &_dt]()
+        {
+          ignition::physics::ForwardStep::Input input;
+          ignition::physics::ForwardStep::State state;
+          ignition::physics::ForwardStep::Output output;
+
+          input.Get<std::chrono::steady_clock::duration>() = _dt;
+
+          islandWorld->Step(output, state, input);
+        }));
+  }
+
   ignition::physics::ForwardStep::Input input;
   ignition::physics::ForwardStep::State state;
   ignition::physics::ForwardStep::Output output;
@@ -1438,6 +2083,11 @@ void PhysicsPrivate::Step(const std::chrono::steady_clock::duration &_dt)
   {
     world.second->Step(output, state, input);
   }
+
+  for (auto &task : islandTasks)
+  {
+    task.wait();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -1446,6 +2096,13 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm)
   IGN_PROFILE("PhysicsPrivate::UpdateSim");
 
   // local pose
+  // Pull the frame data of every link from the physics engine first,
+  // then apply it to the ECM in a second pass. The engine offers no
+  // bulk frame data request, but splitting the pull from the apply
+  // keeps each pass on one data structure, and lets the Pose dirty
+  // flags be raised in a single batch below instead of per link.
+  this->linkFrameBuffer.clear();
+  this->changedPoseEntities.clear();
   _ecm.Each<components::Link, components::Pose, components::ParentEntity>(
       [&](const Entity &_entity, components::Link * /*_link*/,
           components::Pose *_pose,
@@ -1459,190 +2116,241 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm)
           return true;
 
         auto linkIt = this->entityLinkMap.find(_entity);
-        if (linkIt != this->entityLinkMap.end())
+        if (linkIt == this->entityLinkMap.end())
         {
-          auto canonicalLink =
-              _ecm.Component<components::CanonicalLink>(_entity);
+          ignwarn << "Unknown link with id " << _entity << " found\n";
+          return true;
+        }
 
-          // get the pose component of the parent model
-          const components::Pose *parentPose =
-              _ecm.Component<components::Pose>(_parent->Data());
+        // get the pose component of the parent model
+        auto parentPose = _ecm.Component<components::Pose>(_parent->Data());
 
-          auto frameData = linkIt->second->FrameDataRelativeToWorld();
-          const auto &worldPose = frameData.pose;
+        // if the parentPose is a nullptr, something is wrong with ECS
+        // creation
+        if (!parentPose)
+        {
+          ignerr << "The pose component of " << _parent->Data()
+                 << " could not be found. This should never happen!\n";
+          return true;
+        }
 
-          // if the parentPose is a nullptr, something is wrong with ECS
-          // creation
-          if (!parentPose)
-          {
-            ignerr << "The pose component of " << _parent->Data()
-                   << " could not be found. This should never happen!\n";
-            return true;
-          }
-          if (canonicalLink)
-          {
-            // This is the canonical link, update the model
-            // The Pose component, _pose, of this link is the initial
-            // transform of the link w.r.t its model. This component never
-            // changes because it's "fixed" to the model. Instead, we change
-            // the model's pose here. The physics engine gives us the pose of
-            // this link relative to world so to set the model's pose, we have
-            // to post-multiply it by the inverse of the initial transform of
-            // the link w.r.t to its model.
-            auto mutableParentPose =
-              _ecm.Component<components::Pose>(_parent->Data());
-            *(mutableParentPose) = components::Pose(_pose->Data().Inverse() +
-                                           math::eigen3::convert(worldPose));
-            _ecm.SetChanged(_parent->Data(), components::Pose::typeId,
-                ComponentState::PeriodicChange);
-          }
-          else
-          {
-            // Compute the relative pose of this link from the model
-            *_pose = components::Pose(math::eigen3::convert(worldPose) +
-                                      parentPose->Data().Inverse());
-            _ecm.SetChanged(_entity, components::Pose::typeId,
-                ComponentState::PeriodicChange);
-          }
+        this->linkFrameBuffer.push_back({_entity, _parent->Data(), _pose,
+            parentPose,
+            nullptr != _ecm.Component<components::CanonicalLink>(_entity),
+            linkIt->second->FrameDataRelativeToWorld()});
+        return true;
+      });
 
-          // Populate world poses, velocities and accelerations of the link. For
-          // now these components are updated only if another system has created
-          // the corresponding component on the entity.
-          auto worldPoseComp = _ecm.Component<components::WorldPose>(_entity);
-          if (worldPoseComp)
-          {
-            auto state =
-                worldPoseComp->SetData(math::eigen3::convert(frameData.pose),
-                this->pose3Eql) ?
-                ComponentState::PeriodicChange :
-                ComponentState::NoChange;
-            _ecm.SetChanged(_entity, components::WorldPose::typeId, state);
-          }
+  for (const auto &update : this->linkFrameBuffer)
+  {
+    const Entity entity = update.entity;
+    const auto &frameData = update.frameData;
+    const auto &worldPose = frameData.pose;
+
+    // Track engine sleep: once a link has been at rest long enough it
+    // is tagged with PhysicsSleeping and its write-back is skipped
+    // until it moves again. The model is tagged along with its
+    // canonical link.
+    {
+      auto restIt = this->linkRestSteps.find(entity);
+      if (restIt == this->linkRestSteps.end())
+      {
+        this->linkRestSteps.insert(std::make_pair(entity, 0u));
+        restIt = this->linkRestSteps.find(entity);
+      }
+      const bool atRest =
+          frameData.linearVelocity.squaredNorm() < this->sleepVelocitySq &&
+          frameData.angularVelocity.squaredNorm() < this->sleepVelocitySq;
+      if (atRest)
+      {
+        if (restIt->second < this->sleepSteps)
+          ++restIt->second;
+      }
+      else
+      {
+        restIt->second = 0;
+      }
+      const bool sleeping = restIt->second >= this->sleepSteps;
+      const bool wasSleeping = nullptr !=
+          _ecm.Component<components::PhysicsSleeping>(entity);
+      if (sleeping && !wasSleeping)
+      {
+        _ecm.CreateComponent(entity, components::PhysicsSleeping());
+        if (update.canonical)
+          _ecm.CreateComponent(update.parent, components::PhysicsSleeping());
+      }
+      else if (!sleeping && wasSleeping)
+      {
+        _ecm.RemoveComponent<components::PhysicsSleeping>(entity);
+        if (update.canonical)
+          _ecm.RemoveComponent<components::PhysicsSleeping>(update.parent);
+      }
+      else if (sleeping)
+      {
+        // Still asleep and the pose is already written: skip the link
+        continue;
+      }
+    }
 
-          // Velocity in world coordinates
-          auto worldLinVelComp =
-              _ecm.Component<components::WorldLinearVelocity>(_entity);
-          if (worldLinVelComp)
-          {
-            auto state = worldLinVelComp->SetData(
-                  math::eigen3::convert(frameData.linearVelocity),
-                  this->vec3Eql) ?
-                  ComponentState::PeriodicChange :
-                  ComponentState::NoChange;
-            _ecm.SetChanged(_entity,
-                components::WorldLinearVelocity::typeId, state);
-          }
+    if (update.canonical)
+    {
+      // This is the canonical link, update the model
+      // The Pose component, update.pose, of this link is the initial
+      // transform of the link w.r.t its model. This component never
+      // changes because it's "fixed" to the model. Instead, we change
+      // the model's pose here. The physics engine gives us the pose of
+      // this link relative to world so to set the model's pose, we have
+      // to post-multiply it by the inverse of the initial transform of
+      // the link w.r.t to its model.
+      *(update.parentPose) = components::Pose(update.pose->Data().Inverse() +
+                                     math::eigen3::convert(worldPose));
+      this->changedPoseEntities.push_back(update.parent);
+    }
+    else
+    {
+      // Compute the relative pose of this link from the model
+      *(update.pose) = components::Pose(math::eigen3::convert(worldPose) +
+                                update.parentPose->Data().Inverse());
+      this->changedPoseEntities.push_back(entity);
+    }
 
-          // Angular velocity in world frame coordinates
-          auto worldAngVelComp =
-              _ecm.Component<components::WorldAngularVelocity>(_entity);
-          if (worldAngVelComp)
-          {
-            auto state = worldAngVelComp->SetData(
-                math::eigen3::convert(frameData.angularVelocity),
-                this->vec3Eql) ?
-                ComponentState::PeriodicChange :
-                ComponentState::NoChange;
-            _ecm.SetChanged(_entity,
-                components::WorldAngularVelocity::typeId, state);
-          }
+    // Populate world poses, velocities and accelerations of the link. For
+    // now these components are updated only if another system has created
+    // the corresponding component on the entity.
+    auto worldPoseComp = _ecm.Component<components::WorldPose>(entity);
+    if (worldPoseComp)
+    {
+      auto state =
+          worldPoseComp->SetData(math::eigen3::convert(frameData.pose),
+          this->pose3Eql) ?
+          ComponentState::PeriodicChange :
+          ComponentState::NoChange;
+      _ecm.SetChanged(entity, components::WorldPose::typeId, state);
+    }
 
-          // Acceleration in world frame coordinates
-          auto worldLinAccelComp =
-              _ecm.Component<components::WorldLinearAcceleration>(_entity);
-          if (worldLinAccelComp)
-          {
-            auto state = worldLinAccelComp->SetData(
-                math::eigen3::convert(frameData.linearAcceleration),
-                this->vec3Eql) ?
-                ComponentState::PeriodicChange :
-                ComponentState::NoChange;
-            _ecm.SetChanged(_entity,
-                components::WorldLinearAcceleration::typeId, state);
-          }
+    // Velocity in world coordinates
+    auto worldLinVelComp =
+        _ecm.Component<components::WorldLinearVelocity>(entity);
+    if (worldLinVelComp)
+    {
+      auto state = worldLinVelComp->SetData(
+            math::eigen3::convert(frameData.linearVelocity),
+            this->vec3Eql) ?
+            ComponentState::PeriodicChange :
+            ComponentState::NoChange;
+      _ecm.SetChanged(entity,
+          components::WorldLinearVelocity::typeId, state);
+    }
 
-          // Angular acceleration in world frame coordinates
-          auto worldAngAccelComp =
-              _ecm.Component<components::WorldAngularAcceleration>(_entity);
+    // Angular velocity in world frame coordinates
+    auto worldAngVelComp =
+        _ecm.Component<components::WorldAngularVelocity>(entity);
+    if (worldAngVelComp)
+    {
+      auto state = worldAngVelComp->SetData(
+          math::eigen3::convert(frameData.angularVelocity),
+          this->vec3Eql) ?
+          ComponentState::PeriodicChange :
+          ComponentState::NoChange;
+      _ecm.SetChanged(entity,
+          components::WorldAngularVelocity::typeId, state);
+    }
 
-          if (worldAngAccelComp)
-          {
-            auto state = worldAngAccelComp->SetData(
-                math::eigen3::convert(frameData.angularAcceleration),
-                this->vec3Eql) ?
-                ComponentState::PeriodicChange :
-                ComponentState::NoChange;
-            _ecm.SetChanged(_entity,
-                components::WorldAngularAcceleration::typeId, state);
-          }
+    // Acceleration in world frame coordinates
+    auto worldLinAccelComp =
+        _ecm.Component<components::WorldLinearAcceleration>(entity);
+    if (worldLinAccelComp)
+    {
+      auto state = worldLinAccelComp->SetData(
+          math::eigen3::convert(frameData.linearAcceleration),
+          this->vec3Eql) ?
+          ComponentState::PeriodicChange :
+          ComponentState::NoChange;
+      _ecm.SetChanged(entity,
+          components::WorldLinearAcceleration::typeId, state);
+    }
 
-          const Eigen::Matrix3d R_bs = worldPose.linear().transpose(); // NOLINT
+    // Angular acceleration in world frame coordinates
+    auto worldAngAccelComp =
+        _ecm.Component<components::WorldAngularAcceleration>(entity);
 
-          // Velocity in body-fixed frame coordinates
-          auto bodyLinVelComp =
-              _ecm.Component<components::LinearVelocity>(_entity);
-          if (bodyLinVelComp)
-          {
-            Eigen::Vector3d bodyLinVel = R_bs * frameData.linearVelocity;
-            auto state =
-                bodyLinVelComp->SetData(math::eigen3::convert(bodyLinVel),
-                this->vec3Eql) ?
-                ComponentState::PeriodicChange :
-                ComponentState::NoChange;
-            _ecm.SetChanged(_entity, components::LinearVelocity::typeId, state);
-          }
+    if (worldAngAccelComp)
+    {
+      auto state = worldAngAccelComp->SetData(
+          math::eigen3::convert(frameData.angularAcceleration),
+          this->vec3Eql) ?
+          ComponentState::PeriodicChange :
+          ComponentState::NoChange;
+      _ecm.SetChanged(entity,
+          components::WorldAngularAcceleration::typeId, state);
+    }
 
-          // Angular velocity in body-fixed frame coordinates
-          auto bodyAngVelComp =
-              _ecm.Component<components::AngularVelocity>(_entity);
-          if (bodyAngVelComp)
-          {
-            Eigen::Vector3d bodyAngVel = R_bs * frameData.angularVelocity;
-            auto state =
-                bodyAngVelComp->SetData(math::eigen3::convert(bodyAngVel),
-                this->vec3Eql) ?
-                ComponentState::PeriodicChange :
-                ComponentState::NoChange;
-            _ecm.SetChanged(_entity, components::AngularVelocity::typeId,
-                state);
-          }
+    const Eigen::Matrix3d R_bs = worldPose.linear().transpose(); // NOLINT
 
-          // Acceleration in body-fixed frame coordinates
-          auto bodyLinAccelComp =
-              _ecm.Component<components::LinearAcceleration>(_entity);
-          if (bodyLinAccelComp)
-          {
-            Eigen::Vector3d bodyLinAccel = R_bs * frameData.linearAcceleration;
-            auto state =
-                bodyLinAccelComp->SetData(math::eigen3::convert(bodyLinAccel),
-                this->vec3Eql)?
-                ComponentState::PeriodicChange :
-                ComponentState::NoChange;
-            _ecm.SetChanged(_entity, components::LinearAcceleration::typeId,
-                state);
-          }
+    // Velocity in body-fixed frame coordinates
+    auto bodyLinVelComp =
+        _ecm.Component<components::LinearVelocity>(entity);
+    if (bodyLinVelComp)
+    {
+      Eigen::Vector3d bodyLinVel = R_bs * frameData.linearVelocity;
+      auto state =
+          bodyLinVelComp->SetData(math::eigen3::convert(bodyLinVel),
+          this->vec3Eql) ?
+          ComponentState::PeriodicChange :
+          ComponentState::NoChange;
+      _ecm.SetChanged(entity, components::LinearVelocity::typeId, state);
+    }
 
-          // Angular acceleration in world frame coordinates
-          auto bodyAngAccelComp =
-              _ecm.Component<components::AngularAcceleration>(_entity);
-          if (bodyAngAccelComp)
-          {
-            Eigen::Vector3d bodyAngAccel = R_bs * frameData.angularAcceleration;
-            auto state =
-                bodyAngAccelComp->SetData(math::eigen3::convert(bodyAngAccel),
-                this->vec3Eql) ?
-                ComponentState::PeriodicChange :
-                ComponentState::NoChange;
-            _ecm.SetChanged(_entity, components::AngularAcceleration::typeId,
-                state);
-          }
-        }
-        else
-        {
-          ignwarn << "Unknown link with id " << _entity << " found\n";
-        }
-        return true;
-      });
+    // Angular velocity in body-fixed frame coordinates
+    auto bodyAngVelComp =
+        _ecm.Component<components::AngularVelocity>(entity);
+    if (bodyAngVelComp)
+    {
+      Eigen::Vector3d bodyAngVel = R_bs * frameData.angularVelocity;
+      auto state =
+          bodyAngVelComp->SetData(math::eigen3::convert(bodyAngVel),
+          this->vec3Eql) ?
+          ComponentState::PeriodicChange :
+          ComponentState::NoChange;
+      _ecm.SetChanged(entity, components::AngularVelocity::typeId,
+          state);
+    }
+
+    // Acceleration in body-fixed frame coordinates
+    auto bodyLinAccelComp =
+        _ecm.Component<components::LinearAcceleration>(entity);
+    if (bodyLinAccelComp)
+    {
+      Eigen::Vector3d bodyLinAccel = R_bs * frameData.linearAcceleration;
+      auto state =
+          bodyLinAccelComp->SetData(math::eigen3::convert(bodyLinAccel),
+          this->vec3Eql)?
+          ComponentState::PeriodicChange :
+          ComponentState::NoChange;
+      _ecm.SetChanged(entity, components::LinearAcceleration::typeId,
+          state);
+    }
+
+    // Angular acceleration in world frame coordinates
+    auto bodyAngAccelComp =
+        _ecm.Component<components::AngularAcceleration>(entity);
+    if (bodyAngAccelComp)
+    {
+      Eigen::Vector3d bodyAngAccel = R_bs * frameData.angularAcceleration;
+      auto state =
+          bodyAngAccelComp->SetData(math::eigen3::convert(bodyAngAccel),
+          this->vec3Eql) ?
+          ComponentState::PeriodicChange :
+          ComponentState::NoChange;
+      _ecm.SetChanged(entity, components::AngularAcceleration::typeId,
+          state);
+    }
+  }
+
+  // Raise the Pose dirty flags for all the moved links and models in
+  // one batch.
+  _ecm.SetChanged(this->changedPoseEntities, components::Pose::typeId,
+      ComponentState::PeriodicChange);
 
   // pose/velocity/acceleration of non-link entities such as sensors /
   // collisions. These get updated only if another system has created a
@@ -1751,7 +2459,8 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm)
       });
 
   // Clear reset components
-  std::vector<Entity> entitiesPositionReset;
+  ArenaVector<Entity> entitiesPositionReset{
+      StepArenaAllocator<Entity>{this->arena}};
   _ecm.Each<components::JointPositionReset>(
       [&](const Entity &_entity, components::JointPositionReset *) -> bool
       {
@@ -1764,7 +2473,8 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm)
     _ecm.RemoveComponent<components::JointPositionReset>(entity);
   }
 
-  std::vector<Entity> entitiesVelocityReset;
+  ArenaVector<Entity> entitiesVelocityReset{
+      StepArenaAllocator<Entity>{this->arena}};
   _ecm.Each<components::JointVelocityReset>(
       [&](const Entity &_entity, components::JointVelocityReset *) -> bool
       {
@@ -1799,39 +2509,110 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm)
         return true;
       });
 
-  // Update joint positions
-  _ecm.Each<components::Joint, components::JointPosition>(
-      [&](const Entity &_entity, components::Joint *,
-          components::JointPosition *_jointPos) -> bool
+  // Update joint positions and velocities in one sweep, resolving each
+  // joint and its degrees of freedom once and fanning the state out to
+  // whichever components exist.
+  _ecm.Each<components::Joint>(
+      [&](const Entity &_entity, components::Joint *) -> bool
       {
+        auto jointPos = _ecm.Component<components::JointPosition>(_entity);
+        auto jointVel = _ecm.Component<components::JointVelocity>(_entity);
+        if (nullptr == jointPos && nullptr == jointVel)
+          return true;
+
         auto jointIt = this->entityJointMap.find(_entity);
-        if (jointIt != this->entityJointMap.end())
+        if (jointIt == this->entityJointMap.end())
+          return true;
+
+        const std::size_t dof = jointIt->second->GetDegreesOfFreedom();
+        if (jointPos)
+        {
+          jointPos->Data().resize(dof);
+          for (std::size_t i = 0; i < dof; ++i)
+          {
+            jointPos->Data()[i] = jointIt->second->GetPosition(i);
+          }
+        }
+        if (jointVel)
         {
-          _jointPos->Data().resize(jointIt->second->GetDegreesOfFreedom());
-          for (std::size_t i = 0; i < jointIt->second->GetDegreesOfFreedom();
-               ++i)
+          jointVel->Data().resize(dof);
+          for (std::size_t i = 0; i < dof; ++i)
           {
-            _jointPos->Data()[i] = jointIt->second->GetPosition(i);
+            jointVel->Data()[i] = jointIt->second->GetVelocity(i);
           }
         }
         return true;
       });
 
-  // Update joint Velocities
-  _ecm.Each<components::Joint, components::JointVelocity>(
-      [&](const Entity &_entity, components::Joint *,
-          components::JointVelocity *_jointVel) -> bool
+  // Populate bounding box info
+  // Only compute bounding box if component exists to avoid unnecessary
+  // computations.
+  //
+  // A model's box is a function of its pose and its links' poses, so
+  // the box of a model that hasn't moved this step is still valid.
+  // Gather the models above each changed Pose into a dirty set and
+  // recompute only those, keeping the cached component value for the
+  // rest. This runs after the pose write-back so the batch SetChanged
+  // above already covers the engine-moved links and models.
+  std::unordered_set<Entity> dirtyBoxEntities;
+  for (const Entity changed :
+       _ecm.ChangedEntities(components::Pose::typeId))
+  {
+    Entity entity = changed;
+    while (entity != kNullEntity)
+    {
+      if (nullptr != _ecm.Component<components::Model>(entity))
+        dirtyBoxEntities.insert(entity);
+      auto parentComp = _ecm.Component<components::ParentEntity>(entity);
+      entity = parentComp ? parentComp->Data() : kNullEntity;
+    }
+  }
+
+  _ecm.Each<components::Model, components::AxisAlignedBox>(
+      [&](const Entity &_entity, const components::Model *,
+          components::AxisAlignedBox *_bbox)
       {
-        auto jointIt = this->entityJointMap.find(_entity);
-        if (jointIt != this->entityJointMap.end())
+        // A default-constructed box marks a component that has never
+        // been computed, e.g. one just requested by the GUI; always
+        // fill those in.
+        if (dirtyBoxEntities.find(_entity) == dirtyBoxEntities.end() &&
+            _bbox->Data() != math::AxisAlignedBox())
         {
-          _jointVel->Data().resize(jointIt->second->GetDegreesOfFreedom());
-          for (std::size_t i = 0; i < jointIt->second->GetDegreesOfFreedom();
-               ++i)
+          return true;
+        }
+
+        auto modelIt = this->entityModelMap.find(_entity);
+        if (modelIt == this->entityModelMap.end())
+        {
+          ignwarn << "Failed to find model [" << _entity << "]." << std::endl;
+          return true;
+        }
+
+        auto bbModel = entityCast(_entity, modelIt->second,
+            this->entityModelBoundingBoxMap);
+        if (!bbModel)
+        {
+          static bool informed{false};
+          if (!informed)
           {
-            _jointVel->Data()[i] = jointIt->second->GetVelocity(i);
+            igndbg << "Attempting to get a bounding box, but the physics "
+                   << "engine doesn't support feature "
+                   << "[GetModelBoundingBox]. Bounding box won't be populated."
+                   << std::endl;
+            informed = true;
           }
+
+          // Break Each call since no AxisAlignedBox'es can be processed
+          return false;
         }
+
+        math::AxisAlignedBox bbox =
+            math::eigen3::convert(bbModel->GetAxisAlignedBoundingBox());
+        auto state = _bbox->SetData(bbox, this->axisAlignedBoxEql) ?
+            ComponentState::OneTimeChange :
+            ComponentState::NoChange;
+        _ecm.SetChanged(_entity, components::AxisAlignedBox::typeId, state);
+
         return true;
       });
 
@@ -1893,10 +2674,45 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
   // create msgs::Contact objects conveniently later on.
   std::unordered_map<Entity, EntityContactMap> entityContactMap;
 
+  // Collisions that registered a pair filter only keep contacts with the
+  // partners they subscribed to, so the message building below doesn't
+  // pay for manifolds nobody reads.
+  std::unordered_map<Entity, const std::vector<Entity> *> pairFilters;
+  _ecm.Each<components::ContactPairFilter>(
+      [&](const Entity &_entity,
+          const components::ContactPairFilter *_filter) -> bool
+      {
+        pairFilters[_entity] = &_filter->Data();
+        return true;
+      });
+
+  auto admitsContact = [&pairFilters](const Entity _coll, const Entity _other)
+  {
+    auto filterIt = pairFilters.find(_coll);
+    if (filterIt == pairFilters.end())
+      return true;
+    return std::binary_search(filterIt->second->begin(),
+        filterIt->second->end(), _other);
+  };
+
   // Note that we are temporarily storing pointers to elements in this
   // ("allContacts") container. Thus, we must make sure it doesn't get destroyed
   // until the end of this function.
   auto allContacts = worldCollisionFeature->GetContactsFromLastStep();
+
+  // In island mode the non-static models live in the island worlds, so
+  // collect their contacts too. Island replicas of static collisions are
+  // registered in collisionEntityMap, so the lookups below resolve them
+  // to the right entities.
+  for (const auto &islandWorldCollision : this->islandWorldCollisionCasts)
+  {
+    if (!islandWorldCollision)
+      continue;
+    auto islandContacts = islandWorldCollision->GetContactsFromLastStep();
+    allContacts.insert(allContacts.end(), islandContacts.begin(),
+        islandContacts.end());
+  }
+
   for (const auto &contactComposite : allContacts)
   {
     const auto &contact = contactComposite.Get<WorldShapeType::ContactPoint>();
@@ -1906,8 +2722,14 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
     if ((coll1It != this->collisionEntityMap.end()) &&
         (coll2It != this->collisionEntityMap.end()))
     {
-      entityContactMap[coll1It->second][coll2It->second].push_back(&contact);
-      entityContactMap[coll2It->second][coll1It->second].push_back(&contact);
+      if (admitsContact(coll1It->second, coll2It->second))
+      {
+        entityContactMap[coll1It->second][coll2It->second].push_back(&contact);
+      }
+      if (admitsContact(coll2It->second, coll1It->second))
+      {
+        entityContactMap[coll2It->second][coll1It->second].push_back(&contact);
+      }
     }
   }
 
@@ -1963,3 +2785,5 @@ IGNITION_ADD_PLUGIN(Physics,
                     Physics::ISystemUpdate)
 
 IGNITION_ADD_PLUGIN_ALIAS(Physics, "ignition::gazebo::systems::Physics")
+
+IGNITION_GAZEBO_ADD_STATIC_SYSTEM(ignition::gazebo::systems::Physics)
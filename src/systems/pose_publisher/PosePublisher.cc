@@ -24,6 +24,7 @@
 
 #include <ignition/common/Profiler.hh>
 #include <ignition/common/Time.hh>
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/transport/Node.hh>
@@ -63,9 +64,12 @@ class ignition::gazebo::systems::PosePublisherPrivate
   /// \param[out] _poses Pose vector to be filled
   /// \param[in] _static True to fill only static transforms,
   /// false to fill only dynamic transforms
+  /// \param[in] _simTime Current simulation time, used to enforce per-entity
+  /// publication intervals when publish_on_change is enabled
   public: void FillPoses(const EntityComponentManager &_ecm,
       std::vector<std::pair<Entity, math::Pose3d>> &_poses,
-      bool _static);
+      bool _static,
+      const std::chrono::steady_clock::duration &_simTime);
 
   /// \brief Publishes poses collected by FillPoses with the provided time
   /// stamp.
@@ -125,6 +129,26 @@ class ignition::gazebo::systems::PosePublisherPrivate
   /// static_update_frequency parameter
   public: std::chrono::steady_clock::duration staticUpdatePeriod{0};
 
+  /// \brief True to publish an entity's pose only when it has changed beyond
+  /// changeTolerance since its last publication
+  public: bool publishOnChange = false;
+
+  /// \brief Tolerance used to detect pose changes when publishOnChange is
+  /// enabled
+  public: double changeTolerance = 1e-6;
+
+  /// \brief Minimum simulation time between two publications of the same
+  /// entity when publishOnChange is enabled. Calculated from the
+  /// min_publish_interval parameter
+  public: std::chrono::steady_clock::duration minEntityPubPeriod{0};
+
+  /// \brief Pose of each entity as last published, used to detect changes
+  public: std::unordered_map<Entity, math::Pose3d> lastPublishedPoses;
+
+  /// \brief Last simulation time each entity's pose was published
+  public: std::unordered_map<Entity, std::chrono::steady_clock::duration>
+              lastEntityPubTimes;
+
   /// \brief Cache of entities, their frame names and their child frame names.
   /// The key is the entity whose pose is to be published.
   /// The frame name is the scoped name of the parent entity.
@@ -214,6 +238,23 @@ void PosePublisher::Configure(const Entity &_entity,
         std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
   }
 
+  this->dataPtr->publishOnChange =
+    _sdf->Get<bool>("publish_on_change",
+        this->dataPtr->publishOnChange).first;
+
+  this->dataPtr->changeTolerance =
+    _sdf->Get<double>("change_tolerance",
+        this->dataPtr->changeTolerance).first;
+
+  double minPublishInterval =
+      _sdf->Get<double>("min_publish_interval", 0.0).first;
+  if (minPublishInterval > 0)
+  {
+    std::chrono::duration<double> period{minPublishInterval};
+    this->dataPtr->minEntityPubPeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+  }
+
   this->dataPtr->staticPosePublisher =
     _sdf->Get<bool>("static_publisher",
         this->dataPtr->staticPosePublisher).first;
@@ -312,6 +353,9 @@ void PosePublisher::PostUpdate(const UpdateInfo &_info,
     this->dataPtr->initialized = true;
   }
 
+  // Set the time stamp once and reuse it for every publication below
+  msgs::Time stampMsg;
+  set(&stampMsg, _info.simTime);
 
   // if static transforms are published through a different topic
   if (this->dataPtr->staticPosePublisher)
@@ -319,18 +363,20 @@ void PosePublisher::PostUpdate(const UpdateInfo &_info,
     if (publishStatic)
     {
       this->dataPtr->staticPoses.clear();
-      this->dataPtr->FillPoses(_ecm, this->dataPtr->staticPoses, true);
+      this->dataPtr->FillPoses(_ecm, this->dataPtr->staticPoses, true,
+          _info.simTime);
       this->dataPtr->PublishPoses(this->dataPtr->staticPoses,
-          convert<msgs::Time>(_info.simTime), this->dataPtr->poseStaticPub);
+          stampMsg, this->dataPtr->poseStaticPub);
       this->dataPtr->lastStaticPosePubTime = _info.simTime;
     }
 
     if (publish)
     {
       this->dataPtr->poses.clear();
-      this->dataPtr->FillPoses(_ecm, this->dataPtr->poses, false);
+      this->dataPtr->FillPoses(_ecm, this->dataPtr->poses, false,
+          _info.simTime);
       this->dataPtr->PublishPoses(this->dataPtr->poses,
-          convert<msgs::Time>(_info.simTime), this->dataPtr->posePub);
+          stampMsg, this->dataPtr->posePub);
       this->dataPtr->lastPosePubTime = _info.simTime;
     }
   }
@@ -338,10 +384,12 @@ void PosePublisher::PostUpdate(const UpdateInfo &_info,
   else if (publish)
   {
     this->dataPtr->poses.clear();
-    this->dataPtr->FillPoses(_ecm, this->dataPtr->poses, true);
-    this->dataPtr->FillPoses(_ecm, this->dataPtr->poses, false);
+    this->dataPtr->FillPoses(_ecm, this->dataPtr->poses, true,
+        _info.simTime);
+    this->dataPtr->FillPoses(_ecm, this->dataPtr->poses, false,
+        _info.simTime);
     this->dataPtr->PublishPoses(this->dataPtr->poses,
-        convert<msgs::Time>(_info.simTime), this->dataPtr->posePub);
+        stampMsg, this->dataPtr->posePub);
     this->dataPtr->lastPosePubTime = _info.simTime;
   }
 }
@@ -466,7 +514,8 @@ void PosePublisherPrivate::InitializeEntitiesToPublish(
 
 //////////////////////////////////////////////////
 void PosePublisherPrivate::FillPoses(const EntityComponentManager &_ecm,
-    std::vector<std::pair<Entity, math::Pose3d>> &_poses, bool _static)
+    std::vector<std::pair<Entity, math::Pose3d>> &_poses, bool _static,
+    const std::chrono::steady_clock::duration &_simTime)
 {
   IGN_PROFILE("PosePublisher::FillPose");
 
@@ -479,8 +528,48 @@ void PosePublisherPrivate::FillPoses(const EntityComponentManager &_ecm,
     bool isStatic = this->dynamicEntities.find(entity.first) ==
           this->dynamicEntities.end();
 
-    if (_static == isStatic)
-      _poses.emplace_back(entity.first, pose->Data());
+    if (_static != isStatic)
+      continue;
+
+    if (this->publishOnChange)
+    {
+      auto lastPoseIt = this->lastPublishedPoses.find(entity.first);
+      if (lastPoseIt != this->lastPublishedPoses.end())
+      {
+        if (this->minEntityPubPeriod >
+            std::chrono::steady_clock::duration::zero())
+        {
+          auto entityDiff = _simTime - this->lastEntityPubTimes[entity.first];
+          if ((entityDiff > std::chrono::steady_clock::duration::zero()) &&
+              (entityDiff < this->minEntityPubPeriod))
+            continue;
+        }
+        // Without a per-entity interval, an unchanged Pose component means
+        // the comparison below would skip the entity as well, so use the
+        // change flag to avoid comparing poses every step.
+        else if (ComponentState::NoChange ==
+            _ecm.ComponentState(entity.first, components::Pose::typeId))
+        {
+          continue;
+        }
+
+        const math::Pose3d &last = lastPoseIt->second;
+        const math::Pose3d &current = pose->Data();
+        const double tol = this->changeTolerance;
+        if (current.Pos().Equal(last.Pos(), tol) &&
+            math::equal(current.Rot().X(), last.Rot().X(), tol) &&
+            math::equal(current.Rot().Y(), last.Rot().Y(), tol) &&
+            math::equal(current.Rot().Z(), last.Rot().Z(), tol) &&
+            math::equal(current.Rot().W(), last.Rot().W(), tol))
+        {
+          continue;
+        }
+      }
+      this->lastPublishedPoses[entity.first] = pose->Data();
+      this->lastEntityPubTimes[entity.first] = _simTime;
+    }
+
+    _poses.emplace_back(entity.first, pose->Data());
   }
 }
 
@@ -63,6 +63,17 @@ namespace systems
   ///                             negative frequency publishes as fast as
   ///                             possible (i.e, at the rate of the simulation
   ///                             step).
+  /// publish_on_change         : Set to true to publish an entity's pose only
+  ///                             when it differs from the last published pose
+  ///                             by more than change_tolerance. Entities that
+  ///                             do not move are published once and then stay
+  ///                             quiet.
+  /// change_tolerance          : Tolerance used to detect pose changes when
+  ///                             publish_on_change is true. Defaults to 1e-6.
+  /// min_publish_interval      : Minimum simulation time in seconds between
+  ///                             two publications of the same entity when
+  ///                             publish_on_change is true. Defaults to 0,
+  ///                             i.e. changed poses are published every step.
   class IGNITION_GAZEBO_VISIBLE PosePublisher
       : public System,
         public ISystemConfigure,
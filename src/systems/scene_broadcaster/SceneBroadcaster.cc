@@ -15,12 +15,28 @@
  *
 */
 
+#include <ignition/msgs/bytes.pb.h>
+#include <ignition/msgs/double_v.pb.h>
 #include <ignition/msgs/scene.pb.h>
+#include <ignition/msgs/uint64_v.pb.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/graph/Graph.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/transport/Node.hh>
@@ -33,12 +49,16 @@
 #include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/ParentEntity.hh"
+#include "ignition/gazebo/components/PhysicsSleeping.hh"
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/Static.hh"
 #include "ignition/gazebo/components/Visual.hh"
 #include "ignition/gazebo/components/World.hh"
+#include "ignition/gazebo/BoundedPublisher.hh"
 #include "ignition/gazebo/Conversions.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/ShmStateChannel.hh"
+#include "ignition/gazebo/StaticSystemRegistry.hh"
 
 #include "SceneBroadcaster.hh"
 
@@ -64,6 +84,22 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   /// \return True if successful.
   public: bool SceneInfoService(ignition::msgs::Scene &_res);
 
+  /// \brief Callback for the paged scene info service. Large worlds
+  /// make the full scene message expensive to build and serialize in
+  /// one response, so this variant returns the scene in chunks that a
+  /// client can request in sequence and assemble progressively.
+  /// \param[in] _req Page to return: data(0) is the index of the first
+  /// top-level model and data(1) the maximum number of top-level
+  /// models in the page, 0 or absent meaning all remaining. Each
+  /// returned model carries its full subtree, so every page is
+  /// self-contained. Lights are all returned with the first page.
+  /// \param[out] _res Response containing the requested chunk. When
+  /// more pages remain, the response header carries a "next" entry
+  /// with the index to request next.
+  /// \return True if successful.
+  public: bool SceneInfoPagedService(const ignition::msgs::UInt32_V &_req,
+    ignition::msgs::Scene &_res);
+
   /// \brief Callback for scene graph service.
   /// \param[out] _res Response containing the the scene graph in DOT format.
   /// \return True if successful.
@@ -74,6 +110,19 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   /// \return True if successful.
   public: bool StateService(ignition::msgs::SerializedStepMap &_res);
 
+  /// \brief Callback for the filtered state service. Returns the state
+  /// of a single entity's subtree instead of the whole world, so a
+  /// client interested in one model doesn't pay for serializing
+  /// everything else.
+  /// \param[in] _req Filter: data(0) is the entity whose descendants
+  /// (itself included) should be returned, with a null entity meaning
+  /// all entities. Any further values are component type ids to
+  /// include, none meaning all types.
+  /// \param[out] _res Response containing the filtered state.
+  /// \return True if successful.
+  public: bool StateFilteredService(const ignition::msgs::UInt64_V &_req,
+              ignition::msgs::SerializedStepMap &_res);
+
   /// \brief Updates the scene graph when entities are added
   /// \param[in] _manager The entity component manager
   public: void SceneGraphAddEntities(const EntityComponentManager &_manager);
@@ -130,14 +179,225 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   public: void PoseUpdate(const UpdateInfo &_info,
     const EntityComponentManager &_manager);
 
+  /// \brief Record an entity's name in the interned dictionary, marking
+  /// the dictionary dirty when the entry is new or renamed. Only called
+  /// while name interning is enabled.
+  /// \param[in] _entity The entity.
+  /// \param[in] _name Its current name.
+  public: void InternName(const Entity _entity, const std::string &_name);
+
+  /// \brief Build the full dictionary message: one entry per interned
+  /// entity, carrying only its id and name.
+  /// \return The dictionary message.
+  public: msgs::Pose_V NamesMessage();
+
+  /// \brief Callback for the pose names dictionary service, for
+  /// subscribers that joined after the dictionary was last published.
+  /// \param[out] _res Response containing the full dictionary.
+  /// \return True if successful.
+  public: bool PoseNamesService(ignition::msgs::Pose_V &_res);
+
+  /// \brief Callback for the pose filter registration service. Creates a
+  /// publisher that carries only the poses matching the requested names.
+  /// \param[in] _req Entity names to match; a trailing '*' makes an entry
+  /// a name prefix.
+  /// \param[out] _res Response containing the filtered topic name.
+  /// \return True if the filter was created.
+  public: bool PoseFilterAddService(const ignition::msgs::StringMsg_V &_req,
+    ignition::msgs::StringMsg &_res);
+
+  /// \brief Callback for the area pose filter registration service.
+  /// Creates a publisher that carries only the models inside the given
+  /// world-frame box, and their links. Clients watching one corner of a
+  /// large world (e.g. a GUI reporting its area of interest) subscribe
+  /// to the returned topic instead of the full dynamic pose stream.
+  /// \param[in] _req Axis-aligned region of interest.
+  /// \param[out] _res Response containing the filtered topic name.
+  /// \return True if the filter was created.
+  public: bool PoseFilterAddAreaService(
+    const ignition::msgs::AxisAlignedBox &_req,
+    ignition::msgs::StringMsg &_res);
+
+  /// \brief Callback for the pose filter removal service.
+  /// \param[in] _req Topic name returned by the registration service.
+  /// \param[out] _res True if a filter was removed.
+  /// \return True if successful.
+  public: bool PoseFilterRemoveService(const ignition::msgs::StringMsg &_req,
+    ignition::msgs::Boolean &_res);
+
+  /// \brief Whether any pose filters are registered.
+  /// \return True if at least one filter exists.
+  public: bool HasPoseFilters();
+
+  /// \brief Callback for the quantized pose stream registration service.
+  /// Creates a topic carrying the dynamic poses quantized to the
+  /// requested resolution and encoded as varint-packed deltas, for
+  /// bandwidth-constrained subscribers.
+  /// \param[in] _req data(0) is the position resolution in meters and
+  /// data(1) the rotation resolution in radians. Missing or non-positive
+  /// values default to 1 mm and 1 mrad.
+  /// \param[out] _res Response containing the stream's topic name.
+  /// \return True if the stream was created.
+  public: bool QuantizedPoseAddService(const ignition::msgs::Double_V &_req,
+    ignition::msgs::StringMsg &_res);
+
+  /// \brief Callback for the quantized pose stream removal service.
+  /// \param[in] _req Topic name returned by the registration service.
+  /// \param[out] _res True if a stream was removed.
+  /// \return True if successful.
+  public: bool QuantizedPoseRemoveService(const ignition::msgs::StringMsg &_req,
+    ignition::msgs::Boolean &_res);
+
+  /// \brief Whether any quantized pose streams are registered.
+  /// \return True if at least one stream exists.
+  public: bool HasQuantizedPoseStreams();
+
+  /// \brief Callback for the component change feed registration service.
+  /// Creates a topic carrying per-step change batches restricted to the
+  /// requested component types, generated from the ECM change trackers.
+  /// A client mirroring a few component types subscribes to the returned
+  /// topic instead of consuming the full state stream, and the server
+  /// stops serializing what nobody reads.
+  /// \param[in] _req Component type ids the feed should carry. At least
+  /// one is required; an unfiltered feed is just the state topic.
+  /// \param[out] _res Response containing the feed's topic name.
+  /// \return True if the feed was created.
+  public: bool ChangeFeedAddService(const ignition::msgs::UInt64_V &_req,
+    ignition::msgs::StringMsg &_res);
+
+  /// \brief Callback for the change feed removal service.
+  /// \param[in] _req Topic name returned by the registration service.
+  /// \param[out] _res True if a feed was removed.
+  /// \return True if successful.
+  public: bool ChangeFeedRemoveService(const ignition::msgs::StringMsg &_req,
+    ignition::msgs::Boolean &_res);
+
+  /// \brief Publish this cycle's change batches on the registered
+  /// feeds. Entities are enumerated from the dirty trackers, so the
+  /// cost tracks the amount of change, and feeds without subscribers
+  /// skip serialization entirely.
+  /// \param[in] _info Update info of the current cycle.
+  /// \param[in] _manager The entity component manager.
+  public: void PublishChangeFeeds(const UpdateInfo &_info,
+    const EntityComponentManager &_manager);
+
+  /// \brief Callback for consumption acks on the state ack topic.
+  /// \param[in] _msg data(0) is an id the client picked for itself,
+  /// data(1) the "seq" header value of the last state message the client
+  /// finished processing.
+  public: void OnStateAck(const ignition::msgs::UInt64_V &_msg);
+
+  /// \brief Adapt the state publish period to subscriber feedback: halve
+  /// the rate while the slowest acking subscriber keeps falling behind,
+  /// recover toward the configured rate once everyone caught up. Clients
+  /// that never ack leave the rate at the configured value.
+  public: void AdaptStatePublishPeriod();
+
+  /// \brief A client-registered pose filter. Model and link poses that
+  /// pass the filter are published on the filter's own topic, filled
+  /// during the same sweep as the full pose topics. A filter constrains
+  /// by name, by a world-frame region, or both.
+  public: struct PoseFilter
+  {
+    /// \brief Exact entity names accepted by the filter.
+    std::unordered_set<std::string> names;
+
+    /// \brief Entity name prefixes accepted by the filter.
+    std::vector<std::string> prefixes;
+
+    /// \brief Whether the filter constrains by position.
+    bool hasRegion{false};
+
+    /// \brief Axis-aligned region models must be inside. Links of a
+    /// model inside the region are included with it.
+    math::AxisAlignedBox region;
+
+    /// \brief Publisher for the filter's topic.
+    transport::Node::Publisher pub;
+
+    /// \brief Check a name against the filter.
+    /// \param[in] _name Entity name.
+    /// \return True if the name passes.
+    public: bool Matches(const std::string &_name) const
+    {
+      if (this->names.find(_name) != this->names.end())
+        return true;
+      for (const auto &prefix : this->prefixes)
+      {
+        if (_name.compare(0, prefix.size(), prefix) == 0)
+          return true;
+      }
+      return false;
+    }
+  };
+
+  /// \brief Register a pose filter and create its topic.
+  /// \param[in] _filter Filter to register.
+  /// \return The scoped topic name the filter publishes on.
+  public: std::string AddPoseFilter(PoseFilter &&_filter);
+
+  /// \brief A client-negotiated quantized dynamic pose stream. Poses
+  /// are quantized to the stream's resolution and published as
+  /// varint-packed deltas against each entity's previous sample, which
+  /// cuts dynamic pose bandwidth roughly eightfold at millimeter and
+  /// milliradian precision. Deltas are taken in quantized tick space,
+  /// so the reconstruction error is bounded by half a tick and never
+  /// accumulates. The payload is a msgs::Bytes whose data is a
+  /// concatenation, per entity that moved at least one tick, of a
+  /// varint entity id followed by six zigzag varints: the x, y, z
+  /// position deltas in position ticks and the roll, pitch, yaw deltas
+  /// in rotation ticks. An entity's first sample is a delta against
+  /// zero, i.e. its absolute quantized pose.
+  public: struct QuantizedPoseStream
+  {
+    /// \brief Meters per position tick.
+    double posResolution{0.001};
+
+    /// \brief Radians per rotation tick.
+    double rotResolution{0.001};
+
+    /// \brief Previous published sample per entity: x, y, z in
+    /// position ticks, then roll, pitch, yaw in rotation ticks.
+    std::unordered_map<Entity, std::array<int64_t, 6>> prev;
+
+    /// \brief Publisher for the stream's topic.
+    transport::Node::Publisher pub;
+  };
+
   /// \brief Transport node.
   public: std::unique_ptr<transport::Node> node{nullptr};
 
-  /// \brief Pose publisher.
-  public: transport::Node::Publisher posePub;
+  /// \brief Pose publisher. Bounded and coalescing: only the latest
+  /// poses matter, so a stalled subscriber costs one queued message,
+  /// not unbounded buffer growth.
+  public: BoundedPublisher posePub;
+
+  /// \brief Dynamic pose publisher, for non-static model poses.
+  /// Bounded and coalescing, like posePub.
+  public: BoundedPublisher dyPosePub;
 
-  /// \brief Dynamic pose publisher, for non-static model poses
-  public: transport::Node::Publisher dyPosePub;
+  /// \brief Whether entity names are interned: pose and dynamic pose
+  /// messages then carry ids only, and the id-to-name dictionary is
+  /// published separately whenever it changes. Names repeat in every
+  /// pose message but almost never change, so steady-state bandwidth
+  /// drops to the numeric payload. Enabled with <interned_names> on the
+  /// plugin SDF.
+  public: bool internNames{false};
+
+  /// \brief Interned names by entity id. Protected by
+  /// internedNamesMutex.
+  public: std::unordered_map<Entity, std::string> internedNames;
+
+  /// \brief Whether the dictionary changed since it was last published.
+  /// Protected by internedNamesMutex.
+  public: bool internedNamesDirty{false};
+
+  /// \brief Protects internedNames, which the dictionary service reads
+  /// from a transport thread.
+  public: std::mutex internedNamesMutex;
+
+  /// \brief Publisher of the dictionary messages.
+  public: transport::Node::Publisher namesPub;
 
   /// \brief Rate at which to publish dynamic poses
   public: int dyPoseHertz{60};
@@ -152,6 +412,13 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   /// \brief State publisher
   public: transport::Node::Publisher statePub;
 
+  /// \brief Shared memory state channel, written next to the state topic.
+  /// Created when the launcher exports IGN_GAZEBO_STATE_SHM, which it
+  /// does when the same `ign gazebo` invocation forks both the server
+  /// and the GUI: the GUI then maps this channel instead of subscribing,
+  /// and the 60 Hz state stream skips the transport stack entirely.
+  public: std::unique_ptr<ShmStateChannel> stateShm;
+
   /// \brief Graph containing latest information from entities.
   /// The data in each node is the message associated with that entity only.
   /// i.e, a model node only has a message about the model. It will not
@@ -179,16 +446,112 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   /// \brief Filled on demand for the state service.
   public: msgs::SerializedStepMap stepMsg;
 
+  /// \brief Filled on demand for the filtered state service. Kept
+  /// separate from stepMsg so a filtered request doesn't disturb the
+  /// state stream or a concurrent full state request.
+  public: msgs::SerializedStepMap filteredStepMsg;
+
   /// \brief Last time the state was published.
   public: std::chrono::time_point<std::chrono::system_clock>
       lastStatePubTime{std::chrono::system_clock::now()};
 
-  /// \brief Period to publish state, defaults to 60 Hz.
+  /// \brief Period currently used to publish state. Adapted by
+  /// AdaptStatePublishPeriod between baseStatePublishPeriod and 1 s
+  /// according to subscriber consumption acks.
   public: std::chrono::duration<int64_t, std::ratio<1, 1000>>
       statePublishPeriod{std::chrono::milliseconds(1000/60)};
 
+  /// \brief Configured state publish period, the rate recovered to when
+  /// every acking subscriber keeps up. Defaults to 60 Hz.
+  public: std::chrono::duration<int64_t, std::ratio<1, 1000>>
+      baseStatePublishPeriod{std::chrono::milliseconds(1000/60)};
+
+  /// \brief Latest consumption ack per client: the last state sequence
+  /// number the client reported processing, and when the ack arrived.
+  public: struct StateAck
+  {
+    /// \brief Last state sequence number the client processed.
+    uint64_t seq{0};
+
+    /// \brief When the ack arrived.
+    std::chrono::time_point<std::chrono::system_clock> time;
+  };
+
+  /// \brief Acks keyed by the id each client picked for itself.
+  public: std::map<uint64_t, StateAck> stateAcks;
+
+  /// \brief Protects stateAcks, which is filled from a transport callback.
+  public: std::mutex stateAcksMutex;
+
   /// \brief Flag used to indicate if the state service was called.
   public: bool stateServiceRequest{false};
+
+  /// \brief Flag used to indicate if the filtered state service was
+  /// called.
+  public: bool stateFilterRequest{false};
+
+  /// \brief Root entity of the pending filtered state request. The
+  /// response covers this entity and all its descendants.
+  public: Entity stateFilterEntity{kNullEntity};
+
+  /// \brief Component types of the pending filtered state request.
+  /// Empty means all types.
+  public: std::unordered_set<ComponentTypeId> stateFilterTypes;
+
+  /// \brief Number of delta state messages published since the last
+  /// keyframe.
+  public: int statePubCount{0};
+
+  /// \brief Number of delta messages between keyframes (full states) on
+  /// the state topic. Read from <state_keyframe_period>; zero or less
+  /// disables periodic keyframes, leaving only the ones forced by change
+  /// events.
+  public: int stateKeyframePeriod{300};
+
+  /// \brief Sequence number stamped on state messages so subscribers can
+  /// detect a gap and request a keyframe through the state service.
+  public: uint64_t stateSeq{0};
+
+  /// \brief Registered pose filters, keyed by their topic name.
+  public: std::map<std::string, PoseFilter> poseFilters;
+
+  /// \brief Protects poseFilters and quantizedPoseStreams, which are
+  /// modified from service callbacks.
+  public: std::mutex poseFiltersMutex;
+
+  /// \brief Number of filters created so far, used to name their topics.
+  public: unsigned int poseFilterCount{0};
+
+  /// \brief Registered quantized pose streams, keyed by their topic
+  /// name.
+  public: std::map<std::string, QuantizedPoseStream> quantizedPoseStreams;
+
+  /// \brief Number of quantized streams created so far, used to name
+  /// their topics.
+  public: unsigned int quantizedStreamCount{0};
+
+  /// \brief One registered component change feed.
+  public: struct ChangeFeed
+  {
+    /// \brief Publisher for the feed's topic.
+    transport::Node::Publisher pub;
+
+    /// \brief Component types the feed carries.
+    std::unordered_set<ComponentTypeId> types;
+  };
+
+  /// \brief Registered change feeds, keyed by their topic name.
+  public: std::map<std::string, ChangeFeed> changeFeeds;
+
+  /// \brief Protects changeFeeds, which is modified from service
+  /// callbacks.
+  public: std::mutex changeFeedsMutex;
+
+  /// \brief Number of feeds created so far, used to name their topics.
+  public: unsigned int changeFeedCount{0};
+
+  /// \brief Message reused across change feed publications.
+  public: msgs::SerializedStepMap feedMsg;
 };
 
 //////////////////////////////////////////////////
@@ -217,6 +580,14 @@ void SceneBroadcaster::Configure(
   auto readHertz = _sdf->Get<int>("dynamic_pose_hertz", 60);
   this->dataPtr->dyPoseHertz = readHertz.first;
 
+  this->dataPtr->stateKeyframePeriod =
+      _sdf->Get<int>("state_keyframe_period",
+      this->dataPtr->stateKeyframePeriod).first;
+
+  this->dataPtr->internNames =
+      _sdf->Get<bool>("interned_names",
+      this->dataPtr->internNames).first;
+
   // Add to graph
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->graphMutex);
@@ -240,7 +611,9 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
 
   // Create and send pose update if transport connections exist.
   if (this->dataPtr->dyPosePub.HasConnections() ||
-      this->dataPtr->posePub.HasConnections())
+      this->dataPtr->posePub.HasConnections() ||
+      this->dataPtr->HasPoseFilters() ||
+      this->dataPtr->HasQuantizedPoseStreams())
   {
     this->dataPtr->PoseUpdate(_info, _manager);
   }
@@ -262,10 +635,12 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
   bool changeEvent = _manager.HasEntitiesMarkedForRemoval() ||
         _manager.HasNewEntities() || _manager.HasOneTimeComponentChanges() ||
         jumpBackInTime;
+  // Feedback from acking subscribers adjusts the publish period first.
+  this->dataPtr->AdaptStatePublishPeriod();
   bool itsPubTime = now - this->dataPtr->lastStatePubTime >
        this->dataPtr->statePublishPeriod;
-  auto shouldPublish = this->dataPtr->statePub.HasConnections() &&
-       (changeEvent || itsPubTime);
+  auto shouldPublish = (this->dataPtr->statePub.HasConnections() ||
+       nullptr != this->dataPtr->stateShm) && (changeEvent || itsPubTime);
 
   if (this->dataPtr->stateServiceRequest || shouldPublish)
   {
@@ -273,17 +648,23 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
 
     set(this->dataPtr->stepMsg.mutable_stats(), _info);
 
-    // Publish full state if there are change events
-    if (changeEvent || this->dataPtr->stateServiceRequest)
+    // The stream alternates keyframes and deltas: a keyframe carries the
+    // full state and is forced by change events and by the configured
+    // period, everything in between is just what the ECM change trackers
+    // flagged this cycle. Late joiners and subscribers that detect a
+    // sequence gap request a keyframe through the state service.
+    bool keyframe = changeEvent || this->dataPtr->stateServiceRequest ||
+        (this->dataPtr->stateKeyframePeriod > 0 &&
+        this->dataPtr->statePubCount >= this->dataPtr->stateKeyframePeriod);
+
+    if (keyframe)
     {
       _manager.State(*this->dataPtr->stepMsg.mutable_state(), {}, {}, true);
     }
-    // Otherwise publish just selected components
     else
     {
       IGN_PROFILE("SceneBroadcast::PostUpdate UpdateState");
-      _manager.State(*this->dataPtr->stepMsg.mutable_state(),
-          {}, {components::Pose::typeId});
+      _manager.ChangedState(*this->dataPtr->stepMsg.mutable_state());
     }
 
     // Full state on demand
@@ -293,16 +674,96 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
       this->dataPtr->stateCv.notify_all();
     }
 
-    // Poses periodically + change events
-    // TODO(louise) Send changed state periodically instead, once it reflects
-    // changed components
     if (shouldPublish)
     {
       IGN_PROFILE("SceneBroadcast::PoseUpdate Publish State");
-      this->dataPtr->statePub.Publish(this->dataPtr->stepMsg);
+
+      // Tag the message so subscribers can tell deltas from keyframes
+      // and detect gaps.
+      auto header = this->dataPtr->stepMsg.mutable_state()->mutable_header();
+      auto seqData = header->add_data();
+      seqData->set_key("seq");
+      seqData->add_value(std::to_string(this->dataPtr->stateSeq++));
+      auto keyframeData = header->add_data();
+      keyframeData->set_key("keyframe");
+      keyframeData->add_value(keyframe ? "true" : "false");
+
+      // A same-launch GUI consumes the stream through the shared memory
+      // channel; the topic only carries it for other subscribers.
+      if (this->dataPtr->statePub.HasConnections())
+        this->dataPtr->statePub.Publish(this->dataPtr->stepMsg);
+      if (nullptr != this->dataPtr->stateShm)
+        this->dataPtr->stateShm->Write(this->dataPtr->stepMsg);
       this->dataPtr->lastStatePubTime = now;
+      this->dataPtr->statePubCount =
+          keyframe ? 0 : this->dataPtr->statePubCount + 1;
     }
   }
+
+  // Registered change feeds get their per-cycle batches from the same
+  // change-tracking data, restricted to the component types each
+  // subscriber asked for.
+  this->dataPtr->PublishChangeFeeds(_info, _manager);
+
+  // Filtered state on demand. The subtree is resolved with the ECM's
+  // descendant machinery and only those entities are serialized, so the
+  // response cost tracks the size of the requested subtree, not the
+  // world.
+  if (this->dataPtr->stateFilterRequest)
+  {
+    IGN_PROFILE("SceneBroadcast::PostUpdate FilteredState");
+
+    this->dataPtr->filteredStepMsg.Clear();
+    set(this->dataPtr->filteredStepMsg.mutable_stats(), _info);
+
+    if (kNullEntity == this->dataPtr->stateFilterEntity)
+    {
+      _manager.State(*this->dataPtr->filteredStepMsg.mutable_state(), {},
+          this->dataPtr->stateFilterTypes, true);
+    }
+    else if (_manager.HasEntity(this->dataPtr->stateFilterEntity))
+    {
+      _manager.State(*this->dataPtr->filteredStepMsg.mutable_state(),
+          _manager.Descendants(this->dataPtr->stateFilterEntity),
+          this->dataPtr->stateFilterTypes, true);
+    }
+    else
+    {
+      // Unknown entity: respond with an empty state rather than time out.
+      this->dataPtr->filteredStepMsg.mutable_state();
+    }
+
+    this->dataPtr->stateFilterRequest = false;
+    this->dataPtr->stateCv.notify_all();
+  }
+}
+
+namespace
+{
+//////////////////////////////////////////////////
+/// \brief Append an unsigned value as a base-128 varint.
+/// \param[in, out] _out Buffer to append to.
+/// \param[in] _value Value to encode.
+void AppendVarint(std::string &_out, uint64_t _value)
+{
+  while (_value >= 0x80)
+  {
+    _out.push_back(static_cast<char>(_value | 0x80));
+    _value >>= 7;
+  }
+  _out.push_back(static_cast<char>(_value));
+}
+
+//////////////////////////////////////////////////
+/// \brief Append a signed value as a zigzag-encoded varint, so small
+/// deltas of either sign stay one byte.
+/// \param[in, out] _out Buffer to append to.
+/// \param[in] _value Value to encode.
+void AppendZigzag(std::string &_out, int64_t _value)
+{
+  AppendVarint(_out, (static_cast<uint64_t>(_value) << 1) ^
+      static_cast<uint64_t>(_value >> 63));
+}
 }
 
 //////////////////////////////////////////////////
@@ -315,6 +776,39 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
   bool dyPoseConnections = this->dyPosePub.HasConnections();
   bool poseConnections = this->posePub.HasConnections();
 
+  // Quantized streams are encoded from the dynamic pose sweep, so it
+  // has to run whenever one of them has a subscriber.
+  std::lock_guard<std::mutex> filterLock(this->poseFiltersMutex);
+  std::vector<QuantizedPoseStream *> quantizedStreams;
+  for (auto &stream : this->quantizedPoseStreams)
+  {
+    if (stream.second.pub.HasConnections())
+      quantizedStreams.push_back(&stream.second);
+  }
+  bool fillDyPose = dyPoseConnections || !quantizedStreams.empty();
+
+  // Filtered topics are filled from the same sweep as the full topics, so
+  // each registered filter costs one name or containment check per
+  // entity, not another pass over the ECM.
+  struct FilterEntry
+  {
+    /// \brief The registered filter.
+    PoseFilter *filter;
+
+    /// \brief Message being filled for this cycle.
+    msgs::Pose_V msg;
+
+    /// \brief Models that passed the filter's region this cycle, so
+    /// their links can be included in the link sweep below.
+    std::unordered_set<Entity> models;
+  };
+  std::vector<FilterEntry> filterMsgs;
+  for (auto &filter : this->poseFilters)
+  {
+    if (filter.second.pub.HasConnections())
+      filterMsgs.push_back({&filter.second, msgs::Pose_V(), {}});
+  }
+
   // Models
   _manager.Each<components::Model, components::Name, components::Pose,
                 components::Static>(
@@ -323,23 +817,61 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
           const components::Pose *_poseComp,
           const components::Static *_staticComp) -> bool
       {
+        // Sleeping models haven't moved since their pose was last
+        // published, so skip them
+        if (nullptr != _manager.Component<components::PhysicsSleeping>(_entity))
+          return true;
+
+        if (this->internNames)
+          this->InternName(_entity, _nameComp->Data());
+
         if (poseConnections)
         {
           // Add to pose msg
           auto pose = poseMsg.add_pose();
           msgs::Set(pose, _poseComp->Data());
-          pose->set_name(_nameComp->Data());
+          if (!this->internNames)
+            pose->set_name(_nameComp->Data());
           pose->set_id(_entity);
         }
 
-        if (dyPoseConnections && !_staticComp->Data())
+        if (fillDyPose && !_staticComp->Data())
         {
           // Add to dynamic pose msg
           auto dyPose = dyPoseMsg.add_pose();
           msgs::Set(dyPose, _poseComp->Data());
-          dyPose->set_name(_nameComp->Data());
+          if (!this->internNames)
+            dyPose->set_name(_nameComp->Data());
           dyPose->set_id(_entity);
         }
+
+        for (auto &entry : filterMsgs)
+        {
+          bool match;
+          if (entry.filter->hasRegion)
+          {
+            // Model poses are world poses for top level models, which is
+            // what area-of-interest clients watch.
+            match = entry.filter->region.Contains(_poseComp->Data().Pos()) &&
+                (entry.filter->names.empty() &&
+                 entry.filter->prefixes.empty() ?
+                 true : entry.filter->Matches(_nameComp->Data()));
+          }
+          else
+          {
+            match = entry.filter->Matches(_nameComp->Data());
+          }
+
+          if (match)
+          {
+            auto pose = entry.msg.add_pose();
+            msgs::Set(pose, _poseComp->Data());
+            pose->set_name(_nameComp->Data());
+            pose->set_id(_entity);
+            if (entry.filter->hasRegion)
+              entry.models.insert(_entity);
+          }
+        }
         return true;
       });
 
@@ -351,54 +883,120 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
           const components::Pose *_poseComp,
           const components::ParentEntity *_parentComp) -> bool
       {
+        // Sleeping links haven't moved since their pose was last
+        // published, so skip them
+        if (nullptr != _manager.Component<components::PhysicsSleeping>(_entity))
+          return true;
+
+        if (this->internNames)
+          this->InternName(_entity, _nameComp->Data());
+
         // Add to pose msg
         if (poseConnections)
         {
           auto pose = poseMsg.add_pose();
           msgs::Set(pose, _poseComp->Data());
-          pose->set_name(_nameComp->Data());
+          if (!this->internNames)
+            pose->set_name(_nameComp->Data());
           pose->set_id(_entity);
         }
 
         // Check whether parent model is static
         auto staticComp = _manager.Component<components::Static>(
           _parentComp->Data());
-        if (dyPoseConnections && !staticComp->Data())
+        if (fillDyPose && !staticComp->Data())
         {
           // Add to dynamic pose msg
           auto dyPose = dyPoseMsg.add_pose();
           msgs::Set(dyPose, _poseComp->Data());
-          dyPose->set_name(_nameComp->Data());
+          if (!this->internNames)
+            dyPose->set_name(_nameComp->Data());
           dyPose->set_id(_entity);
         }
 
+        for (auto &entry : filterMsgs)
+        {
+          // Links ride along with a model that passed an area filter;
+          // their own poses are model-relative so they are not tested
+          // against the region directly.
+          if (entry.models.find(_parentComp->Data()) != entry.models.end() ||
+              (!entry.filter->hasRegion &&
+               entry.filter->Matches(_nameComp->Data())))
+          {
+            auto pose = entry.msg.add_pose();
+            msgs::Set(pose, _poseComp->Data());
+            pose->set_name(_nameComp->Data());
+            pose->set_id(_entity);
+          }
+        }
+
         return true;
       });
 
   if (dyPoseConnections)
   {
     // Set the time stamp in the header
-    dyPoseMsg.mutable_header()->mutable_stamp()->CopyFrom(
-        convert<msgs::Time>(_info.simTime));
+    set(dyPoseMsg.mutable_header()->mutable_stamp(), _info.simTime);
 
     this->dyPosePub.Publish(dyPoseMsg);
   }
 
+  // Quantized streams, encoded from the same dynamic sweep. Deltas are
+  // computed in tick space against the previously published sample, so
+  // quantization error never accumulates, and an entity that hasn't
+  // moved a full tick costs no bytes at all.
+  for (auto *stream : quantizedStreams)
+  {
+    msgs::Bytes quantMsg;
+    std::string &bytes = *quantMsg.mutable_data();
+    for (const auto &pose : dyPoseMsg.pose())
+    {
+      const math::Pose3d p = msgs::Convert(pose);
+      const math::Vector3d euler = p.Rot().Euler();
+      const std::array<int64_t, 6> ticks =
+      {
+        std::llround(p.Pos().X() / stream->posResolution),
+        std::llround(p.Pos().Y() / stream->posResolution),
+        std::llround(p.Pos().Z() / stream->posResolution),
+        std::llround(euler.X() / stream->rotResolution),
+        std::llround(euler.Y() / stream->rotResolution),
+        std::llround(euler.Z() / stream->rotResolution)
+      };
+
+      // A new entity's previous sample is all zeros, which makes its
+      // first delta the absolute quantized pose.
+      auto &prev = stream->prev[pose.id()];
+      if (ticks == prev)
+        continue;
+
+      AppendVarint(bytes, pose.id());
+      for (std::size_t i = 0; i < ticks.size(); ++i)
+        AppendZigzag(bytes, ticks[i] - prev[i]);
+      prev = ticks;
+    }
+
+    set(quantMsg.mutable_header()->mutable_stamp(), _info.simTime);
+    stream->pub.Publish(quantMsg);
+  }
+
   // Visuals
   if (poseConnections)
   {
-    poseMsg.mutable_header()->mutable_stamp()->CopyFrom(
-        convert<msgs::Time>(_info.simTime));
+    set(poseMsg.mutable_header()->mutable_stamp(), _info.simTime);
 
     _manager.Each<components::Visual, components::Name, components::Pose>(
       [&](const Entity &_entity, const components::Visual *,
           const components::Name *_nameComp,
           const components::Pose *_poseComp) -> bool
       {
+        if (this->internNames)
+          this->InternName(_entity, _nameComp->Data());
+
         // Add to pose msg
         auto pose = poseMsg.add_pose();
         msgs::Set(pose, _poseComp->Data());
-        pose->set_name(_nameComp->Data());
+        if (!this->internNames)
+          pose->set_name(_nameComp->Data());
         pose->set_id(_entity);
         return true;
       });
@@ -409,16 +1007,79 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
             const components::Name *_nameComp,
             const components::Pose *_poseComp) -> bool
         {
+          if (this->internNames)
+            this->InternName(_entity, _nameComp->Data());
+
           // Add to pose msg
           auto pose = poseMsg.add_pose();
           msgs::Set(pose, _poseComp->Data());
-          pose->set_name(_nameComp->Data());
+          if (!this->internNames)
+            pose->set_name(_nameComp->Data());
           pose->set_id(_entity);
           return true;
         });
 
     this->posePub.Publish(poseMsg);
   }
+
+  for (auto &entry : filterMsgs)
+  {
+    set(entry.msg.mutable_header()->mutable_stamp(), _info.simTime);
+    entry.filter->pub.Publish(entry.msg);
+  }
+
+  // Republish the name dictionary when this sweep added or changed an
+  // entry, so subscribers can resolve the ids above.
+  if (this->internNames)
+  {
+    bool publishNames = false;
+    {
+      std::lock_guard<std::mutex> nameLock(this->internedNamesMutex);
+      publishNames = this->internedNamesDirty;
+      this->internedNamesDirty = false;
+    }
+
+    if (publishNames)
+    {
+      auto namesMsg = this->NamesMessage();
+      set(namesMsg.mutable_header()->mutable_stamp(), _info.simTime);
+      this->namesPub.Publish(namesMsg);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::InternName(const Entity _entity,
+    const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->internedNamesMutex);
+  auto iter = this->internedNames.find(_entity);
+  if (iter != this->internedNames.end() && iter->second == _name)
+    return;
+
+  this->internedNames[_entity] = _name;
+  this->internedNamesDirty = true;
+}
+
+//////////////////////////////////////////////////
+msgs::Pose_V SceneBroadcasterPrivate::NamesMessage()
+{
+  msgs::Pose_V msg;
+  std::lock_guard<std::mutex> lock(this->internedNamesMutex);
+  for (const auto &entry : this->internedNames)
+  {
+    auto pose = msg.add_pose();
+    pose->set_id(entry.first);
+    pose->set_name(entry.second);
+  }
+  return msg;
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::PoseNamesService(ignition::msgs::Pose_V &_res)
+{
+  _res = this->NamesMessage();
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -437,6 +1098,15 @@ void SceneBroadcasterPrivate::SetupTransport(const std::string &_worldName)
   ignmsg << "Serving scene information on [" << opts.NameSpace() << "/"
          << infoService << "]" << std::endl;
 
+  // Paged scene info service
+  std::string infoPagedService{"scene/info/paged"};
+
+  this->node->Advertise(infoPagedService,
+      &SceneBroadcasterPrivate::SceneInfoPagedService, this);
+
+  ignmsg << "Serving paged scene information on [" << opts.NameSpace() << "/"
+         << infoPagedService << "]" << std::endl;
+
   // Scene graph service
   std::string graphService{"scene/graph"};
 
@@ -455,6 +1125,15 @@ void SceneBroadcasterPrivate::SetupTransport(const std::string &_worldName)
   ignmsg << "Serving full state on [" << opts.NameSpace() << "/"
          << stateService << "]" << std::endl;
 
+  // Filtered state service
+  std::string stateFilteredService{"state/filtered"};
+
+  this->node->Advertise(stateFilteredService,
+      &SceneBroadcasterPrivate::StateFilteredService, this);
+
+  ignmsg << "Serving filtered state on [" << opts.NameSpace() << "/"
+         << stateFilteredService << "]" << std::endl;
+
   // Scene info topic
   std::string sceneTopic{"/world/" + _worldName + "/scene/info"};
 
@@ -481,13 +1160,38 @@ void SceneBroadcasterPrivate::SetupTransport(const std::string &_worldName)
   ignmsg << "Publishing state changes on [" << stateTopic << "]"
       << std::endl;
 
+  // Shared memory state channel. The launcher exports the name when it
+  // forks the server and the GUI from the same invocation; the world
+  // name keeps channels apart when several worlds run under one launch.
+  const char *shmName = std::getenv("IGN_GAZEBO_STATE_SHM");
+  if (nullptr != shmName && '\0' != shmName[0])
+  {
+    std::string channelName = std::string(shmName) + "-" + _worldName;
+    this->stateShm = ShmStateChannel::Create(channelName);
+    if (nullptr != this->stateShm)
+    {
+      ignmsg << "Serving state through shared memory channel ["
+             << channelName << "]" << std::endl;
+    }
+  }
+
+  // State consumption acks, used to adapt the state publish rate to what
+  // subscribers actually sustain.
+  std::string stateAckTopic{"/world/" + _worldName + "/state/ack"};
+
+  this->node->Subscribe(stateAckTopic, &SceneBroadcasterPrivate::OnStateAck,
+      this);
+
+  ignmsg << "Listening to state acks on [" << stateAckTopic << "]"
+      << std::endl;
+
   // Pose info publisher
   std::string poseTopic{"pose/info"};
 
   transport::AdvertiseMessageOptions poseAdvertOpts;
   poseAdvertOpts.SetMsgsPerSec(60);
-  this->posePub = this->node->Advertise<msgs::Pose_V>(poseTopic,
-      poseAdvertOpts);
+  this->posePub.Init<msgs::Pose_V>(*this->node, poseTopic, 1,
+      BoundedPublisher::DropPolicy::kCoalesce, poseAdvertOpts);
 
   ignmsg << "Publishing pose messages on [" << opts.NameSpace() << "/"
          << poseTopic << "]" << std::endl;
@@ -497,11 +1201,228 @@ void SceneBroadcasterPrivate::SetupTransport(const std::string &_worldName)
 
   transport::AdvertiseMessageOptions dyPoseAdvertOpts;
   dyPoseAdvertOpts.SetMsgsPerSec(this->dyPoseHertz);
-  this->dyPosePub = this->node->Advertise<msgs::Pose_V>(dyPoseTopic,
-      dyPoseAdvertOpts);
+  this->dyPosePub.Init<msgs::Pose_V>(*this->node, dyPoseTopic, 1,
+      BoundedPublisher::DropPolicy::kCoalesce, dyPoseAdvertOpts);
 
   ignmsg << "Publishing dynamic pose messages on [" << opts.NameSpace() << "/"
          << dyPoseTopic << "]" << std::endl;
+
+  if (this->internNames)
+  {
+    // Interned name dictionary: pose messages carry ids only, and this
+    // topic maps the ids back to names. The service serves subscribers
+    // that joined after the last dictionary publication.
+    std::string namesTopic{"pose/names"};
+
+    this->namesPub = this->node->Advertise<msgs::Pose_V>(namesTopic);
+    this->node->Advertise(namesTopic,
+        &SceneBroadcasterPrivate::PoseNamesService, this);
+
+    ignmsg << "Publishing interned entity names on [" << opts.NameSpace()
+           << "/" << namesTopic << "]" << std::endl;
+  }
+
+  // Pose filter services. Clients that only care about a few entities can
+  // register a name filter and subscribe to the returned topic instead of
+  // the full pose stream.
+  this->node->Advertise("pose/filter/add",
+      &SceneBroadcasterPrivate::PoseFilterAddService, this);
+  this->node->Advertise("pose/filter/add_area",
+      &SceneBroadcasterPrivate::PoseFilterAddAreaService, this);
+  this->node->Advertise("pose/filter/remove",
+      &SceneBroadcasterPrivate::PoseFilterRemoveService, this);
+
+  ignmsg << "Serving pose filters on [" << opts.NameSpace()
+         << "/pose/filter/add]" << std::endl;
+
+  // Quantized pose stream services, for bandwidth-constrained
+  // subscribers that negotiate their own precision.
+  this->node->Advertise("dynamic_pose/quantized/add",
+      &SceneBroadcasterPrivate::QuantizedPoseAddService, this);
+  this->node->Advertise("dynamic_pose/quantized/remove",
+      &SceneBroadcasterPrivate::QuantizedPoseRemoveService, this);
+
+  ignmsg << "Serving quantized pose streams on [" << opts.NameSpace()
+         << "/dynamic_pose/quantized/add]" << std::endl;
+
+  // Component change feed services. Clients that mirror a few component
+  // types register a feed and subscribe to the returned topic instead of
+  // the full state stream.
+  this->node->Advertise("state/feed/add",
+      &SceneBroadcasterPrivate::ChangeFeedAddService, this);
+  this->node->Advertise("state/feed/remove",
+      &SceneBroadcasterPrivate::ChangeFeedRemoveService, this);
+
+  ignmsg << "Serving component change feeds on [" << opts.NameSpace()
+         << "/state/feed/add]" << std::endl;
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::PoseFilterAddService(
+    const ignition::msgs::StringMsg_V &_req, ignition::msgs::StringMsg &_res)
+{
+  std::lock_guard<std::mutex> lock(this->poseFiltersMutex);
+
+  PoseFilter filter;
+  for (int i = 0; i < _req.data_size(); ++i)
+  {
+    const std::string &entry = _req.data(i);
+    if (entry.empty())
+      continue;
+
+    // A trailing '*' makes the entry a name prefix.
+    if (entry.back() == '*')
+      filter.prefixes.push_back(entry.substr(0, entry.size() - 1));
+    else
+      filter.names.insert(entry);
+  }
+
+  if (filter.names.empty() && filter.prefixes.empty())
+    return false;
+
+  _res.set_data(this->AddPoseFilter(std::move(filter)));
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::PoseFilterAddAreaService(
+    const ignition::msgs::AxisAlignedBox &_req, ignition::msgs::StringMsg &_res)
+{
+  std::lock_guard<std::mutex> lock(this->poseFiltersMutex);
+
+  PoseFilter filter;
+  filter.hasRegion = true;
+  filter.region = msgs::Convert(_req);
+  if (filter.region.Min() == filter.region.Max())
+    return false;
+
+  _res.set_data(this->AddPoseFilter(std::move(filter)));
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::string SceneBroadcasterPrivate::AddPoseFilter(PoseFilter &&_filter)
+{
+  std::string topic{"pose/filter/" + std::to_string(this->poseFilterCount++)};
+  _filter.pub = this->node->Advertise<msgs::Pose_V>(topic);
+
+  std::string scopedTopic{this->node->Options().NameSpace() + "/" + topic};
+  this->poseFilters[scopedTopic] = std::move(_filter);
+  return scopedTopic;
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::PoseFilterRemoveService(
+    const ignition::msgs::StringMsg &_req, ignition::msgs::Boolean &_res)
+{
+  std::lock_guard<std::mutex> lock(this->poseFiltersMutex);
+  _res.set_data(this->poseFilters.erase(_req.data()) > 0);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::HasPoseFilters()
+{
+  std::lock_guard<std::mutex> lock(this->poseFiltersMutex);
+  return !this->poseFilters.empty();
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::QuantizedPoseAddService(
+    const ignition::msgs::Double_V &_req, ignition::msgs::StringMsg &_res)
+{
+  std::lock_guard<std::mutex> lock(this->poseFiltersMutex);
+
+  QuantizedPoseStream stream;
+  if (_req.data_size() > 0 && _req.data(0) > 0.0)
+    stream.posResolution = _req.data(0);
+  if (_req.data_size() > 1 && _req.data(1) > 0.0)
+    stream.rotResolution = _req.data(1);
+
+  std::string topic{"dynamic_pose/quantized/" +
+      std::to_string(this->quantizedStreamCount++)};
+  stream.pub = this->node->Advertise<msgs::Bytes>(topic);
+
+  std::string scopedTopic{this->node->Options().NameSpace() + "/" + topic};
+  this->quantizedPoseStreams[scopedTopic] = std::move(stream);
+  _res.set_data(scopedTopic);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::QuantizedPoseRemoveService(
+    const ignition::msgs::StringMsg &_req, ignition::msgs::Boolean &_res)
+{
+  std::lock_guard<std::mutex> lock(this->poseFiltersMutex);
+  _res.set_data(this->quantizedPoseStreams.erase(_req.data()) > 0);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::HasQuantizedPoseStreams()
+{
+  std::lock_guard<std::mutex> lock(this->poseFiltersMutex);
+  return !this->quantizedPoseStreams.empty();
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::ChangeFeedAddService(
+    const ignition::msgs::UInt64_V &_req, ignition::msgs::StringMsg &_res)
+{
+  // An unfiltered feed is just the state topic; refuse it instead of
+  // serializing the whole world a second time.
+  if (_req.data().empty())
+    return false;
+
+  ChangeFeed feed;
+  for (const auto type : _req.data())
+    feed.types.insert(type);
+
+  std::lock_guard<std::mutex> lock(this->changeFeedsMutex);
+
+  std::string topic{"state/feed/" + std::to_string(this->changeFeedCount++)};
+  feed.pub = this->node->Advertise<msgs::SerializedStepMap>(topic);
+
+  std::string scopedTopic{this->node->Options().NameSpace() + "/" + topic};
+  this->changeFeeds[scopedTopic] = std::move(feed);
+  _res.set_data(scopedTopic);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::ChangeFeedRemoveService(
+    const ignition::msgs::StringMsg &_req, ignition::msgs::Boolean &_res)
+{
+  std::lock_guard<std::mutex> lock(this->changeFeedsMutex);
+  _res.set_data(this->changeFeeds.erase(_req.data()) > 0);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::PublishChangeFeeds(const UpdateInfo &_info,
+    const EntityComponentManager &_manager)
+{
+  std::lock_guard<std::mutex> lock(this->changeFeedsMutex);
+  if (this->changeFeeds.empty())
+    return;
+
+  IGN_PROFILE("SceneBroadcast::PostUpdate ChangeFeeds");
+  for (auto &[topic, feed] : this->changeFeeds)
+  {
+    if (!feed.pub.HasConnections())
+      continue;
+
+    this->feedMsg.Clear();
+    set(this->feedMsg.mutable_stats(), _info);
+    _manager.State(*this->feedMsg.mutable_state(), {}, feed.types, false);
+
+    // Nothing the feed covers changed this cycle; don't wake the
+    // subscriber for an empty batch.
+    if (this->feedMsg.state().entities().empty())
+      continue;
+
+    feed.pub.Publish(this->feedMsg);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -522,6 +1443,65 @@ bool SceneBroadcasterPrivate::SceneInfoService(ignition::msgs::Scene &_res)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::SceneInfoPagedService(
+    const ignition::msgs::UInt32_V &_req, ignition::msgs::Scene &_res)
+{
+  std::lock_guard<std::mutex> lock(this->graphMutex);
+
+  _res.Clear();
+
+  const uint32_t start = _req.data_size() > 0 ? _req.data(0) : 0u;
+  const uint32_t count = _req.data_size() > 1 ? _req.data(1) : 0u;
+
+  // Lights are few, so ship them all with the first page and let the
+  // client light the scene before the models finish arriving.
+  if (0u == start)
+    AddLights(&_res, this->worldEntity, this->sceneGraph);
+
+  uint32_t index = 0;
+  uint32_t next = 0;
+  bool more = false;
+  for (const auto &vertex : this->sceneGraph.AdjacentsFrom(this->worldEntity))
+  {
+    auto modelMsg = std::dynamic_pointer_cast<msgs::Model>(
+        vertex.second.get().Data());
+    if (!modelMsg)
+      continue;
+
+    const uint32_t current = index++;
+    if (current < start)
+      continue;
+
+    if (count > 0u && static_cast<uint32_t>(_res.model_size()) >= count)
+    {
+      next = current;
+      more = true;
+      break;
+    }
+
+    auto msgOut = _res.add_model();
+    msgOut->CopyFrom(*modelMsg);
+
+    // Nested models
+    AddModels(msgOut, vertex.first, this->sceneGraph);
+
+    // Links
+    AddLinks(msgOut, vertex.first, this->sceneGraph);
+  }
+
+  // Tell the client where to resume. The entry is absent on the last
+  // page, which is how the client knows the scene is complete.
+  if (more)
+  {
+    auto headerData = _res.mutable_header()->add_data();
+    headerData->set_key("next");
+    headerData->add_value(std::to_string(next));
+  }
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool SceneBroadcasterPrivate::StateService(
     ignition::msgs::SerializedStepMap &_res)
@@ -544,6 +1524,104 @@ bool SceneBroadcasterPrivate::StateService(
   return success;
 }
 
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::StateFilteredService(
+    const ignition::msgs::UInt64_V &_req,
+    ignition::msgs::SerializedStepMap &_res)
+{
+  _res.Clear();
+
+  // Lock and wait for an iteration to be run and fill the state
+  std::unique_lock<std::mutex> lock(this->stateMutex);
+  this->stateFilterEntity = _req.data_size() > 0 ?
+      static_cast<Entity>(_req.data(0)) : kNullEntity;
+  this->stateFilterTypes.clear();
+  for (int i = 1; i < _req.data_size(); ++i)
+    this->stateFilterTypes.insert(static_cast<ComponentTypeId>(_req.data(i)));
+  this->stateFilterRequest = true;
+  auto success = this->stateCv.wait_for(lock, 5s, [&]
+  {
+    return this->filteredStepMsg.has_state() && !this->stateFilterRequest;
+  });
+
+  if (success)
+    _res.CopyFrom(this->filteredStepMsg);
+  else
+    ignerr << "Timed out waiting for filtered state" << std::endl;
+
+  return success;
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::OnStateAck(const ignition::msgs::UInt64_V &_msg)
+{
+  if (_msg.data_size() < 2)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->stateAcksMutex);
+  auto &ack = this->stateAcks[_msg.data(0)];
+  ack.seq = std::max(ack.seq, _msg.data(1));
+  ack.time = std::chrono::system_clock::now();
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::AdaptStatePublishPeriod()
+{
+  // Acks older than this belong to clients that disconnected or stopped
+  // acking; they shouldn't hold the rate down forever.
+  constexpr auto kAckTimeout = 5s;
+
+  // Lag, in state messages, beyond which the rate is halved, and at or
+  // below which it recovers toward the configured rate.
+  constexpr uint64_t kSlowLag = 15;
+  constexpr uint64_t kRecoveredLag = 2;
+
+  // Never adapt below 1 Hz. Change events still publish off-rate, so
+  // even the slowest client stays consistent at the floor.
+  constexpr std::chrono::milliseconds kMaxPeriod{1000};
+
+  auto now = std::chrono::system_clock::now();
+
+  uint64_t maxLag = 0;
+  bool anyAcks = false;
+  {
+    std::lock_guard<std::mutex> lock(this->stateAcksMutex);
+    for (auto iter = this->stateAcks.begin();
+         iter != this->stateAcks.end();)
+    {
+      if (now - iter->second.time > kAckTimeout)
+      {
+        iter = this->stateAcks.erase(iter);
+        continue;
+      }
+      anyAcks = true;
+      if (this->stateSeq > iter->second.seq)
+        maxLag = std::max(maxLag, this->stateSeq - iter->second.seq);
+      ++iter;
+    }
+  }
+
+  // Without feedback, stick to the configured rate.
+  if (!anyAcks)
+  {
+    this->statePublishPeriod = this->baseStatePublishPeriod;
+    return;
+  }
+
+  if (maxLag > kSlowLag)
+  {
+    this->statePublishPeriod =
+        std::min<std::chrono::milliseconds>(this->statePublishPeriod * 2,
+        kMaxPeriod);
+  }
+  else if (maxLag <= kRecoveredLag)
+  {
+    this->statePublishPeriod =
+        std::max<std::chrono::milliseconds>(this->statePublishPeriod / 2,
+        this->baseStatePublishPeriod);
+  }
+}
+
 //////////////////////////////////////////////////
 bool SceneBroadcasterPrivate::SceneGraphService(ignition::msgs::StringMsg &_res)
 {
@@ -645,8 +1723,7 @@ void SceneBroadcasterPrivate::SceneGraphAddEntities(
         auto geometryComp = _manager.Component<components::Geometry>(_entity);
         if (geometryComp)
         {
-          visualMsg->mutable_geometry()->CopyFrom(
-              convert<msgs::Geometry>(geometryComp->Data()));
+          set(visualMsg->mutable_geometry(), geometryComp->Data());
         }
 
         // Material is optional
@@ -762,6 +1839,18 @@ void SceneBroadcasterPrivate::SceneGraphRemoveEntities(
       deletionMsg.mutable_data()->Add(entity);
     }
     this->deletionPub.Publish(deletionMsg);
+
+    // Drop the removed entities from the name dictionary; the next pose
+    // sweep republishes it without them.
+    if (this->internNames)
+    {
+      std::lock_guard<std::mutex> nameLock(this->internedNamesMutex);
+      for (const auto &entity : removedEntities)
+      {
+        if (this->internedNames.erase(entity) > 0)
+          this->internedNamesDirty = true;
+      }
+    }
   }
 }
 
@@ -872,3 +1961,5 @@ IGNITION_ADD_PLUGIN(SceneBroadcaster,
 // namespace
 IGNITION_ADD_PLUGIN_ALIAS(SceneBroadcaster,
                           "ignition::gazebo::systems::SceneBroadcaster")
+
+IGNITION_GAZEBO_ADD_STATIC_SYSTEM(ignition::gazebo::systems::SceneBroadcaster)
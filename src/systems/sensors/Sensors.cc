@@ -15,9 +15,30 @@
  *
  */
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
 #include <set>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <ignition/msgs/pointcloud_packed.pb.h>
+#include <ignition/msgs/stringmsg.pb.h>
 
 #include <ignition/common/Profiler.hh>
+#include <ignition/common/Util.hh>
 #include <ignition/plugin/Register.hh>
 
 #include <sdf/Sensor.hh>
@@ -27,14 +48,19 @@
 
 #include <ignition/rendering/Scene.hh>
 #include <ignition/sensors/CameraSensor.hh>
+#include <ignition/sensors/GpuLidarSensor.hh>
 #include <ignition/sensors/RenderingSensor.hh>
 #include <ignition/sensors/ThermalCameraSensor.hh>
 #include <ignition/sensors/Manager.hh>
 
+#include <ignition/transport/Node.hh>
+
 #include "ignition/gazebo/components/Atmosphere.hh"
 #include "ignition/gazebo/components/Camera.hh"
 #include "ignition/gazebo/components/DepthCamera.hh"
 #include "ignition/gazebo/components/GpuLidar.hh"
+#include "ignition/gazebo/components/ParentEntity.hh"
+#include "ignition/gazebo/components/Performer.hh"
 #include "ignition/gazebo/components/RgbdCamera.hh"
 #include "ignition/gazebo/components/ThermalCamera.hh"
 #include "ignition/gazebo/components/World.hh"
@@ -122,6 +148,215 @@ class ignition::gazebo::systems::SensorsPrivate
   /// \brief Mask sensor updates for sensors currently being rendered
   public: std::map<sensors::SensorId, ignition::common::Time> sensorMask;
 
+  /// \brief Batch sensors that share an update period into the same
+  /// rendered frame. The scene graph update (PreRender) runs once per
+  /// frame, so rendering all same-rate sensors together shares that cost
+  /// instead of paying it on a different step for each sensor whose
+  /// schedule drifted. Set via <batch_sensor_updates> on the plugin SDF.
+  public: bool batchSensorUpdates{true};
+
+  /// \brief Spread sensors that share an update rate over different
+  /// frames instead of batching them. Rendering many sensors on the same
+  /// frame can blow the frame budget (8 lidars at 10 Hz render as one
+  /// large spike); staggering gives each sensor a phase offset within the
+  /// shared period so GPU work stays even across frames. Set via
+  /// <stagger_sensor_updates> on the plugin SDF; takes precedence over
+  /// batching since the two are opposites.
+  public: bool staggerSensorUpdates{false};
+
+  /// \brief Next scheduled update of each staggered sensor. Replaces the
+  /// sensor's own schedule while staggering is enabled. Protected by
+  /// sensorMaskMutex.
+  public: std::map<sensors::SensorId, ignition::common::Time>
+      nextStaggeredUpdate;
+
+  /// \brief Number of sensors seen per update rate, used to pick each
+  /// new sensor's phase offset within the shared period. Protected by
+  /// sensorMaskMutex.
+  public: std::map<double, int> rateGroupCounts;
+
+  /// \brief Whether pipeline stage latencies are being tracked. Opt-in
+  /// via <track_latency> on the plugin SDF; the cost is a few clock
+  /// reads per sensor per frame.
+  public: bool trackLatency{false};
+
+  /// \brief Latency aggregate of one pipeline stage. Alongside count,
+  /// mean and max, samples are bucketed against fixed thresholds so a
+  /// camera-to-consumer budget such as 50 ms can be checked as a
+  /// simple ratio.
+  public: struct StageLatency
+  {
+    /// \brief Number of recorded samples.
+    public: uint64_t count{0};
+
+    /// \brief Sum of all samples in nanoseconds.
+    public: uint64_t totalNs{0};
+
+    /// \brief Largest sample in nanoseconds.
+    public: uint64_t maxNs{0};
+
+    /// \brief Samples under 10, 20 and 50 ms, and at or over 50 ms.
+    public: std::array<uint64_t, 4> buckets{};
+
+    /// \brief Record one sample.
+    /// \param[in] _duration The measured duration.
+    public: void Record(const std::chrono::steady_clock::duration _duration)
+    {
+      const uint64_t ns = static_cast<uint64_t>(std::max<int64_t>(0,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+          _duration).count()));
+      this->count++;
+      this->totalNs += ns;
+      this->maxNs = std::max(this->maxNs, ns);
+      if (ns < 10000000u)
+        this->buckets[0]++;
+      else if (ns < 20000000u)
+        this->buckets[1]++;
+      else if (ns < 50000000u)
+        this->buckets[2]++;
+      else
+        this->buckets[3]++;
+    }
+  };
+
+  /// \brief Stage latencies of one sensor's pipeline.
+  public: struct SensorLatency
+  {
+    /// \brief Name of the sensor, set on the first recording.
+    public: std::string name;
+
+    /// \brief From the step that triggered the frame to the rendering
+    /// thread picking it up: time spent queued behind the previous
+    /// frame.
+    public: StageLatency queueWait;
+
+    /// \brief The sensor's own update. Render, GPU readback, encode
+    /// and publish all happen inside it.
+    public: StageLatency update;
+
+    /// \brief From the triggering step to the sensor's data being
+    /// published.
+    public: StageLatency endToEnd;
+  };
+
+  /// \brief Stage latencies per sensor. Written by the rendering
+  /// thread, read by the latency service. Protected by latencyMutex.
+  public: std::map<sensors::SensorId, SensorLatency> sensorLatencies;
+
+  /// \brief Mutex protecting sensorLatencies.
+  public: std::mutex latencyMutex;
+
+  /// \brief Wall-clock time at which the current frame was triggered
+  /// from PostUpdate. Protected by renderMutex, like updateTime.
+  public: std::chrono::steady_clock::time_point triggerTime;
+
+  /// \brief Service handler producing a per-sensor latency report.
+  /// \param[out] _res Report, one block per sensor.
+  /// \return True.
+  public: bool LatencyService(msgs::StringMsg &_res);
+
+  /// \brief True when this process is the primary of a distributed
+  /// simulation.
+  public: bool distributedPrimary{false};
+
+  /// \brief True when this process is a secondary of a distributed
+  /// simulation.
+  public: bool distributedSecondary{false};
+
+  /// \brief Mutex to protect remoteSensorEntities, which is written from
+  /// PostUpdate and read from the rendering thread.
+  public: std::mutex remoteSensorMutex;
+
+  /// \brief Sensor entities that another process of a distributed
+  /// simulation is responsible for. They are skipped at creation time,
+  /// so this process never renders them.
+  public: std::unordered_set<Entity> remoteSensorEntities;
+
+  /// \brief Whether the initial batch of sensor entities has been
+  /// classified. Their newness is long gone by the time rendering is
+  /// initialized, so the first classification scans all sensors.
+  public: bool ownershipInitialized{false};
+
+  /// \brief Record which of the newly created sensor entities belong to
+  /// another process of a distributed simulation. Secondaries own the
+  /// sensors mounted on their performers, the primary owns the rest.
+  /// \param[in] _ecm Entity component manager to query.
+  public: void UpdateSensorOwnership(const EntityComponentManager &_ecm);
+
+  /// \brief Mirror GPU lidar frames into shared memory for same-host
+  /// consumers. Opt-in via <shm_lidar_output> on the plugin SDF. The
+  /// per-point protobuf pack and serialize of a large scan costs far
+  /// more than the scan itself; a co-located consumer maps the region
+  /// once and reads each frame in place.
+  public: bool shmLidarEnabled{false};
+
+#ifndef _WIN32
+  /// \brief Shared-memory mirror of one GPU lidar's frames. The region
+  /// is a small ring of frame-sized slots; every new frame is copied
+  /// into the next slot and announced with a handle message on
+  /// <lidar topic>/shm. The handle is a PointCloudPacked carrying the
+  /// field layout of the raw scan but no data; header entries "shm",
+  /// "offset" and "frame" tell the consumer where to read. Overwrites
+  /// are detected by re-checking the announced frame number after
+  /// reading.
+  public: struct ShmLidarMirror
+  {
+    /// \brief Name of the shared-memory region, as given to shm_open.
+    public: std::string shmName;
+
+    /// \brief File descriptor of the region, -1 before the first frame.
+    public: int fd{-1};
+
+    /// \brief Mapped region, null before the first frame sizes it.
+    public: uint8_t *region{nullptr};
+
+    /// \brief Bytes per frame slot.
+    public: std::size_t slotSize{0};
+
+    /// \brief Frames the ring holds before overwriting.
+    public: std::size_t slotCount{4};
+
+    /// \brief Monotonic frame counter.
+    public: uint64_t frame{0};
+
+    /// \brief Publisher of the handle messages.
+    public: transport::Node::Publisher pub;
+
+    /// \brief Connection to the lidar's new-frame event.
+    public: common::ConnectionPtr frameConn;
+  };
+
+  /// \brief Shared-memory mirrors, keyed by sensor id.
+  public: std::map<sensors::SensorId,
+      std::shared_ptr<ShmLidarMirror>> lidarMirrors;
+
+  /// \brief Start mirroring a GPU lidar's frames into shared memory.
+  /// \param[in] _id Sensor id of the lidar.
+  /// \param[in] _lidar The lidar sensor.
+  public: void AddLidarMirror(const sensors::SensorId _id,
+      sensors::GpuLidarSensor *_lidar);
+
+  /// \brief Copy one rendered frame into the ring and announce it.
+  /// Runs on the rendering thread, right after the lidar's GPU
+  /// readback.
+  /// \param[in] _mirror Mirror of the lidar that produced the frame.
+  /// \param[in] _scan Raw scan buffer.
+  /// \param[in] _width Scan width in points.
+  /// \param[in] _height Scan height in points.
+  /// \param[in] _channels Floats per point.
+  public: void OnLidarFrame(const std::shared_ptr<ShmLidarMirror> &_mirror,
+      const float *_scan, unsigned int _width, unsigned int _height,
+      unsigned int _channels);
+
+  /// \brief Tear down one lidar's mirror, unmapping and unlinking the
+  /// region.
+  /// \param[in] _id Sensor id of the lidar.
+  public: void RemoveLidarMirror(const sensors::SensorId _id);
+#endif
+
+  /// \brief Transport node for the shared-memory handle topics.
+  public: transport::Node node;
+
   /// \brief Wait for initialization to happen
   private: void WaitForInit();
 
@@ -148,12 +383,11 @@ class ignition::gazebo::systems::SensorsPrivate
   /// updateAvailable to true, and notifying via the renderCv.
   /// The rendering operation is done in `RunOnce`.
   ///
-  /// The caller of PostUpdate will not be blocked if there is no
-  /// rendering operation currently ongoing. Rendering will occur
-  /// asyncronously.
-  //
-  /// The caller of PostUpdate will be blocked if there is a rendering
-  /// operation currently ongoing, until that completes.
+  /// The caller of PostUpdate is never blocked by an ongoing rendering
+  /// operation. State deltas accumulate in the render util's staging
+  /// buffers every step, and if the rendering thread is still busy with
+  /// the previous frame the trigger for a new one is simply dropped;
+  /// the due sensors render with up-to-date state on a later frame.
   private: void RenderThread();
 
   /// \brief Launch the rendering thread
@@ -205,6 +439,9 @@ void SensorsPrivate::RunOnce()
     return;
 
   IGN_PROFILE("SensorsPrivate::RunOnce");
+
+  // Render start stamp: everything before this was queueing
+  const auto renderStart = std::chrono::steady_clock::now();
   {
     IGN_PROFILE("Update");
     this->renderUtil.Update();
@@ -242,7 +479,53 @@ void SensorsPrivate::RunOnce()
     {
       // publish data
       IGN_PROFILE("RunOnce");
-      this->sensorManager.RunOnce(this->updateTime);
+      if (this->batchSensorUpdates || this->staggerSensorUpdates)
+      {
+        // Force exactly the selected set. Batched and staggered sensors
+        // run on this system's schedule, not their own; the manager would
+        // re-check each sensor's internal schedule and skip them.
+        for (const auto &rs : this->activeSensors)
+        {
+          if (!this->trackLatency)
+          {
+            rs->Update(this->updateTime, true);
+            continue;
+          }
+
+          const auto start = std::chrono::steady_clock::now();
+          rs->Update(this->updateTime, true);
+          const auto end = std::chrono::steady_clock::now();
+
+          std::lock_guard<std::mutex> statLock(this->latencyMutex);
+          auto &stats = this->sensorLatencies[rs->Id()];
+          if (stats.name.empty())
+            stats.name = rs->Name();
+          stats.queueWait.Record(renderStart - this->triggerTime);
+          stats.update.Record(end - start);
+          stats.endToEnd.Record(end - this->triggerTime);
+        }
+      }
+      else
+      {
+        const auto start = std::chrono::steady_clock::now();
+        this->sensorManager.RunOnce(this->updateTime);
+        if (this->trackLatency)
+        {
+          // The manager updates the whole batch in one call, so each
+          // sensor in it is attributed the batch timings.
+          const auto end = std::chrono::steady_clock::now();
+          std::lock_guard<std::mutex> statLock(this->latencyMutex);
+          for (const auto &rs : this->activeSensors)
+          {
+            auto &stats = this->sensorLatencies[rs->Id()];
+            if (stats.name.empty())
+              stats.name = rs->Name();
+            stats.queueWait.Record(renderStart - this->triggerTime);
+            stats.update.Record(end - start);
+            stats.endToEnd.Record(end - this->triggerTime);
+          }
+        }
+      }
     }
 
     this->activeSensors.clear();
@@ -303,8 +586,271 @@ void SensorsPrivate::Stop()
   {
     this->renderThread.join();
   }
+
+#ifndef _WIN32
+  // The rendering thread is gone, so no frame callback can race this.
+  while (!this->lidarMirrors.empty())
+    this->RemoveLidarMirror(this->lidarMirrors.begin()->first);
+#endif
+}
+
+//////////////////////////////////////////////////
+bool SensorsPrivate::LatencyService(msgs::StringMsg &_res)
+{
+  std::ostringstream report;
+  report << std::fixed << std::setprecision(2);
+
+  auto line = [&report](const char *_stage, const StageLatency &_stats)
+  {
+    report << "  " << _stage << ": samples " << _stats.count;
+    if (_stats.count > 0)
+    {
+      report << ", mean "
+             << 1e-6 * static_cast<double>(_stats.totalNs) / _stats.count
+             << " ms, max " << 1e-6 * static_cast<double>(_stats.maxNs)
+             << " ms, <10ms " << _stats.buckets[0]
+             << ", <20ms " << _stats.buckets[1]
+             << ", <50ms " << _stats.buckets[2]
+             << ", >=50ms " << _stats.buckets[3];
+    }
+    report << std::endl;
+  };
+
+  std::lock_guard<std::mutex> lock(this->latencyMutex);
+  for (const auto &entry : this->sensorLatencies)
+  {
+    report << entry.second.name << ":" << std::endl;
+    line("queue wait", entry.second.queueWait);
+    line("update", entry.second.update);
+    line("end to end", entry.second.endToEnd);
+  }
+
+  _res.set_data(report.str());
+  return true;
 }
 
+//////////////////////////////////////////////////
+void SensorsPrivate::UpdateSensorOwnership(const EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("SensorsPrivate::UpdateSensorOwnership");
+
+  // Models that carry a performer. A performer entity is created as a
+  // child of its model.
+  std::unordered_set<Entity> performerModels;
+  _ecm.Each<components::Performer, components::ParentEntity>(
+      [&](const Entity &, const components::Performer *,
+          const components::ParentEntity *_parent) -> bool
+      {
+        performerModels.insert(_parent->Data());
+        return true;
+      });
+
+  auto classify = [&](const Entity &_entity) -> bool
+  {
+    // Walk up the tree looking for a performer model.
+    bool onPerformer = false;
+    auto current = _entity;
+    while (current != kNullEntity)
+    {
+      if (performerModels.find(current) != performerModels.end())
+      {
+        onPerformer = true;
+        break;
+      }
+      auto parent = _ecm.Component<components::ParentEntity>(current);
+      current = nullptr != parent ? parent->Data() : kNullEntity;
+    }
+
+    // Secondaries own the sensors mounted on their performers; models of
+    // performers assigned to other secondaries are not even loaded here.
+    // The primary keeps the sensors that don't ride on any performer.
+    const bool owned =
+        this->distributedSecondary ? onPerformer : !onPerformer;
+    if (!owned)
+    {
+      std::lock_guard<std::mutex> lock(this->remoteSensorMutex);
+      this->remoteSensorEntities.insert(_entity);
+    }
+    return true;
+  };
+
+  // Sensors loaded before rendering was initialized have lost their
+  // newness by the time this first runs, so scan all of them once and
+  // rely on newness afterwards, like RenderUtil does.
+  if (!this->ownershipInitialized)
+  {
+    this->ownershipInitialized = true;
+    _ecm.Each<components::Camera>(
+        [&](const Entity &_entity, const components::Camera *) -> bool
+        { return classify(_entity); });
+    _ecm.Each<components::DepthCamera>(
+        [&](const Entity &_entity, const components::DepthCamera *) -> bool
+        { return classify(_entity); });
+    _ecm.Each<components::GpuLidar>(
+        [&](const Entity &_entity, const components::GpuLidar *) -> bool
+        { return classify(_entity); });
+    _ecm.Each<components::RgbdCamera>(
+        [&](const Entity &_entity, const components::RgbdCamera *) -> bool
+        { return classify(_entity); });
+    _ecm.Each<components::ThermalCamera>(
+        [&](const Entity &_entity, const components::ThermalCamera *) -> bool
+        { return classify(_entity); });
+    return;
+  }
+
+  _ecm.EachNew<components::Camera>(
+      [&](const Entity &_entity, const components::Camera *) -> bool
+      { return classify(_entity); });
+  _ecm.EachNew<components::DepthCamera>(
+      [&](const Entity &_entity, const components::DepthCamera *) -> bool
+      { return classify(_entity); });
+  _ecm.EachNew<components::GpuLidar>(
+      [&](const Entity &_entity, const components::GpuLidar *) -> bool
+      { return classify(_entity); });
+  _ecm.EachNew<components::RgbdCamera>(
+      [&](const Entity &_entity, const components::RgbdCamera *) -> bool
+      { return classify(_entity); });
+  _ecm.EachNew<components::ThermalCamera>(
+      [&](const Entity &_entity, const components::ThermalCamera *) -> bool
+      { return classify(_entity); });
+}
+
+#ifndef _WIN32
+//////////////////////////////////////////////////
+void SensorsPrivate::AddLidarMirror(const sensors::SensorId _id,
+    sensors::GpuLidarSensor *_lidar)
+{
+  auto mirror = std::make_shared<ShmLidarMirror>();
+  mirror->shmName = "/ign-gazebo-lidar-" +
+      std::to_string(getpid()) + "-" + std::to_string(_id);
+  mirror->pub = this->node.Advertise<msgs::PointCloudPacked>(
+      _lidar->Topic() + "/shm");
+  mirror->frameConn = _lidar->ConnectNewLidarFrame(
+      [this, mirror](const float *_scan, unsigned int _width,
+          unsigned int _height, unsigned int _channels,
+          const std::string &)
+      {
+        this->OnLidarFrame(mirror, _scan, _width, _height, _channels);
+      });
+  this->lidarMirrors[_id] = mirror;
+
+  ignmsg << "Mirroring lidar [" << _lidar->Name() << "] frames into ["
+         << mirror->shmName << "]" << std::endl;
+}
+
+//////////////////////////////////////////////////
+void SensorsPrivate::OnLidarFrame(
+    const std::shared_ptr<ShmLidarMirror> &_mirror, const float *_scan,
+    unsigned int _width, unsigned int _height, unsigned int _channels)
+{
+  const std::size_t bytes =
+      std::size_t(_width) * _height * _channels * sizeof(float);
+  if (0 == bytes || nullptr == _scan)
+    return;
+
+  // Size the ring on the first frame; a resolution change remaps it.
+  if (nullptr == _mirror->region || _mirror->slotSize != bytes)
+  {
+    if (nullptr != _mirror->region)
+    {
+      munmap(_mirror->region, _mirror->slotSize * _mirror->slotCount);
+      _mirror->region = nullptr;
+    }
+
+    if (_mirror->fd < 0)
+    {
+      _mirror->fd = shm_open(_mirror->shmName.c_str(),
+          O_CREAT | O_RDWR, 0600);
+      if (_mirror->fd < 0)
+      {
+        ignerr << "Failed to open shared memory region ["
+               << _mirror->shmName << "]" << std::endl;
+        return;
+      }
+    }
+
+    const std::size_t total = bytes * _mirror->slotCount;
+    if (ftruncate(_mirror->fd, total) < 0)
+    {
+      ignerr << "Failed to size shared memory region ["
+             << _mirror->shmName << "]" << std::endl;
+      return;
+    }
+
+    void *mem = mmap(nullptr, total, PROT_READ | PROT_WRITE,
+        MAP_SHARED, _mirror->fd, 0);
+    if (MAP_FAILED == mem)
+    {
+      ignerr << "Failed to map shared memory region ["
+             << _mirror->shmName << "]" << std::endl;
+      return;
+    }
+    _mirror->region = static_cast<uint8_t *>(mem);
+    _mirror->slotSize = bytes;
+  }
+
+  const std::size_t slot = _mirror->frame % _mirror->slotCount;
+  std::memcpy(_mirror->region + slot * bytes, _scan, bytes);
+
+  // The handle carries the scan layout but no data. The first channel
+  // of a GPU lidar frame is range, the second intensity; any further
+  // channels are engine specific and left unnamed.
+  msgs::PointCloudPacked msg;
+  msg.set_width(_width);
+  msg.set_height(_height);
+  msg.set_point_step(_channels * sizeof(float));
+  msg.set_row_step(_width * _channels * sizeof(float));
+  msg.set_is_dense(true);
+
+  auto *rangeField = msg.add_field();
+  rangeField->set_name("range");
+  rangeField->set_offset(0);
+  rangeField->set_datatype(msgs::PointCloudPacked::Field::FLOAT32);
+  rangeField->set_count(1);
+  if (_channels > 1)
+  {
+    auto *intensityField = msg.add_field();
+    intensityField->set_name("intensity");
+    intensityField->set_offset(sizeof(float));
+    intensityField->set_datatype(msgs::PointCloudPacked::Field::FLOAT32);
+    intensityField->set_count(1);
+  }
+
+  auto *header = msg.mutable_header();
+  auto *shmEntry = header->add_data();
+  shmEntry->set_key("shm");
+  shmEntry->add_value(_mirror->shmName);
+  auto *offsetEntry = header->add_data();
+  offsetEntry->set_key("offset");
+  offsetEntry->add_value(std::to_string(slot * bytes));
+  auto *frameEntry = header->add_data();
+  frameEntry->set_key("frame");
+  frameEntry->add_value(std::to_string(_mirror->frame));
+
+  _mirror->pub.Publish(msg);
+  ++_mirror->frame;
+}
+
+//////////////////////////////////////////////////
+void SensorsPrivate::RemoveLidarMirror(const sensors::SensorId _id)
+{
+  auto iter = this->lidarMirrors.find(_id);
+  if (iter == this->lidarMirrors.end())
+    return;
+
+  auto &mirror = iter->second;
+  mirror->frameConn.reset();
+  if (nullptr != mirror->region)
+    munmap(mirror->region, mirror->slotSize * mirror->slotCount);
+  if (mirror->fd >= 0)
+  {
+    close(mirror->fd);
+    shm_unlink(mirror->shmName.c_str());
+  }
+  this->lidarMirrors.erase(iter);
+}
+#endif
+
 //////////////////////////////////////////////////
 void Sensors::RemoveSensor(const Entity &_entity)
 {
@@ -324,6 +870,14 @@ void Sensors::RemoveSensor(const Entity &_entity)
       {
         this->dataPtr->activeSensors.erase(activeSensorIt);
       }
+      this->dataPtr->nextStaggeredUpdate.erase(idIter->second);
+    }
+#ifndef _WIN32
+    this->dataPtr->RemoveLidarMirror(idIter->second);
+#endif
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->latencyMutex);
+      this->dataPtr->sensorLatencies.erase(idIter->second);
     }
     this->dataPtr->sensorIds.erase(idIter->second);
     this->dataPtr->sensorManager.Remove(idIter->second);
@@ -353,6 +907,48 @@ void Sensors::Configure(const Entity &/*_id*/,
   std::string engineName =
       _sdf->Get<std::string>("render_engine", "ogre2").first;
 
+  this->dataPtr->batchSensorUpdates =
+      _sdf->Get<bool>("batch_sensor_updates",
+      this->dataPtr->batchSensorUpdates).first;
+
+  this->dataPtr->staggerSensorUpdates =
+      _sdf->Get<bool>("stagger_sensor_updates",
+      this->dataPtr->staggerSensorUpdates).first;
+
+  // Staggering deliberately spreads same-rate sensors over different
+  // frames, which is the opposite of batching, so it takes precedence.
+  if (this->dataPtr->staggerSensorUpdates)
+    this->dataPtr->batchSensorUpdates = false;
+
+  this->dataPtr->trackLatency =
+      _sdf->Get<bool>("track_latency",
+      this->dataPtr->trackLatency).first;
+  if (this->dataPtr->trackLatency)
+  {
+    this->dataPtr->node.Advertise("sensors/latency",
+        &SensorsPrivate::LatencyService, this->dataPtr.get());
+    ignmsg << "Serving sensor pipeline latencies on [/sensors/latency]"
+           << std::endl;
+  }
+
+  this->dataPtr->shmLidarEnabled =
+      _sdf->Get<bool>("shm_lidar_output",
+      this->dataPtr->shmLidarEnabled).first;
+#ifdef _WIN32
+  if (this->dataPtr->shmLidarEnabled)
+  {
+    ignwarn << "<shm_lidar_output> is not supported on this platform."
+            << std::endl;
+    this->dataPtr->shmLidarEnabled = false;
+  }
+#endif
+
+  // Depth-only profile for lidar-heavy deployments: the sensor scene is
+  // built without materials, shadows or lights, roughly halving GPU time
+  // per frame. Only valid when no color or thermal cameras are used.
+  this->dataPtr->renderUtil.SetDepthOnlyProfile(
+      _sdf->Get<bool>("depth_only_profile", false).first);
+
   this->dataPtr->renderUtil.SetEngineName(engineName);
   this->dataPtr->renderUtil.SetEnableSensors(true,
       std::bind(&Sensors::CreateSensor, this,
@@ -373,6 +969,20 @@ void Sensors::Configure(const Entity &/*_id*/,
     }
   }
 
+  // In a distributed run, partition the sensors across the processes:
+  // each secondary renders only the sensors mounted on its performers
+  // and publishes their data locally, while the primary keeps the
+  // sensors that aren't tied to any performer.
+  std::string role;
+  if (common::env("IGN_GAZEBO_NETWORK_ROLE", role))
+  {
+    std::transform(role.begin(), role.end(), role.begin(), ::toupper);
+    this->dataPtr->distributedPrimary =
+        role == "PRIMARY" || role == "SIMULATION_PRIMARY";
+    this->dataPtr->distributedSecondary =
+        role == "SECONDARY" || role == "SIMULATION_SECONDARY";
+  }
+
   this->dataPtr->stopConn = _eventMgr.Connect<events::Stop>(
       std::bind(&SensorsPrivate::Stop, this->dataPtr.get()));
 
@@ -409,12 +1019,28 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
 
   if (this->dataPtr->running && this->dataPtr->initialized)
   {
+    // Classify newly created sensors before the render util queues them
+    // for creation, so remote ones can be skipped.
+    if (this->dataPtr->distributedPrimary ||
+        this->dataPtr->distributedSecondary)
+    {
+      this->dataPtr->UpdateSensorOwnership(_ecm);
+    }
+
     this->dataPtr->renderUtil.UpdateFromECM(_info, _ecm);
 
+    // Keep a short world pose history for every sensor entity, so
+    // consumers can interpolate the pose at a sensor's exact exposure
+    // time instead of settling for the latest step's pose.
+    for (const auto &entry : this->dataPtr->entityToIdMap)
+      _ecm.TrackPoseHistory(entry.first);
+
     auto time = math::durationToSecNsec(_info.simTime);
     auto t = common::Time(time.first, time.second);
 
     std::vector<sensors::RenderingSensor *> activeSensors;
+    std::vector<sensors::RenderingSensor *> candidateSensors;
+    std::set<double> dueRates;
 
     this->dataPtr->sensorMaskMutex.lock();
     for (auto id : this->dataPtr->sensorIds)
@@ -435,9 +1061,58 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
         }
       }
 
-      if (rs && rs->NextUpdateTime() <= t)
+      if (nullptr == rs)
+        continue;
+
+      // Staggered scheduling replaces the sensor's own schedule so that
+      // sensors sharing an update rate fire on different frames.
+      if (this->dataPtr->staggerSensorUpdates && rs->UpdateRate() > 0)
+      {
+        auto nextIt = this->dataPtr->nextStaggeredUpdate.find(id);
+        if (nextIt == this->dataPtr->nextStaggeredUpdate.end())
+        {
+          // Pick the phase offset from a low-discrepancy sequence so any
+          // number of sensors in the group spreads evenly over the period
+          // without knowing the group size up front.
+          const double period = 1.0 / rs->UpdateRate();
+          const double phase = std::fmod(
+              this->dataPtr->rateGroupCounts[rs->UpdateRate()]++ *
+              0.618033988749895, 1.0) * period;
+          nextIt = this->dataPtr->nextStaggeredUpdate.insert(
+              {id, t + ignition::common::Time(phase)}).first;
+        }
+
+        if (nextIt->second <= t)
+        {
+          const ignition::common::Time period(1.0 / rs->UpdateRate());
+          while (nextIt->second <= t)
+            nextIt->second += period;
+          activeSensors.push_back(rs);
+        }
+        continue;
+      }
+
+      if (rs->NextUpdateTime() <= t)
       {
         activeSensors.push_back(rs);
+        dueRates.insert(rs->UpdateRate());
+      }
+      else
+      {
+        candidateSensors.push_back(rs);
+      }
+    }
+
+    // Pull sensors that share an update period with a due sensor into this
+    // frame. Rendering them a little early aligns their schedules, so the
+    // whole group keeps sharing one scene graph update per period instead
+    // of each sensor paying for its own on a drifted step.
+    if (this->dataPtr->batchSensorUpdates && !activeSensors.empty())
+    {
+      for (auto rs : candidateSensors)
+      {
+        if (dueRates.find(rs->UpdateRate()) != dueRates.end())
+          activeSensors.push_back(rs);
       }
     }
     this->dataPtr->sensorMaskMutex.unlock();
@@ -445,9 +1120,19 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
     if (!activeSensors.empty() ||
         this->dataPtr->renderUtil.PendingSensors() > 0)
     {
-      std::unique_lock<std::mutex> lock(this->dataPtr->renderMutex);
-      this->dataPtr->renderCv.wait(lock, [this] {
-        return !this->dataPtr->running || !this->dataPtr->updateAvailable; });
+      // The ECM deltas were already folded into the render util's staging
+      // buffers by UpdateFromECM above, and those buffers accumulate until
+      // the rendering thread consumes them: newer poses overwrite older
+      // ones, creations and removals queue up. So when the rendering
+      // thread is still busy with the previous frame, drop this trigger
+      // instead of blocking the simulation step. The sensors stay due and
+      // will render with up-to-date state on a later frame.
+      std::unique_lock<std::mutex> lock(this->dataPtr->renderMutex,
+          std::try_to_lock);
+      if (!lock.owns_lock() || this->dataPtr->updateAvailable)
+      {
+        return;
+      }
 
       if (!this->dataPtr->running)
       {
@@ -456,6 +1141,7 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
 
       this->dataPtr->activeSensors = std::move(activeSensors);
       this->dataPtr->updateTime = t;
+      this->dataPtr->triggerTime = std::chrono::steady_clock::now();
       this->dataPtr->updateAvailable = true;
       this->dataPtr->renderCv.notify_one();
     }
@@ -472,6 +1158,19 @@ std::string Sensors::CreateSensor(const Entity &_entity,
     return std::string();
   }
 
+  // Another process of a distributed simulation owns this sensor; it is
+  // rendered and published there.
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->remoteSensorMutex);
+    if (this->dataPtr->remoteSensorEntities.find(_entity) !=
+        this->dataPtr->remoteSensorEntities.end())
+    {
+      igndbg << "Sensor [" << _sdf.Name() << "] is owned by another "
+             << "process, skipping creation." << std::endl;
+      return std::string();
+    }
+  }
+
   // Create within ign-sensors
   auto sensorId = this->dataPtr->sensorManager.CreateSensor(_sdf);
   auto sensor = this->dataPtr->sensorManager.Sensor(sensorId);
@@ -540,6 +1239,16 @@ std::string Sensors::CreateSensor(const Entity &_entity,
     thermalSensor->SetAmbientTemperature(this->dataPtr->ambientTemperature);
   }
 
+#ifndef _WIN32
+  // Mirror GPU lidar frames into shared memory for same-host consumers.
+  if (this->dataPtr->shmLidarEnabled)
+  {
+    auto lidarSensor = dynamic_cast<sensors::GpuLidarSensor *>(sensor);
+    if (nullptr != lidarSensor)
+      this->dataPtr->AddLidarMirror(sensorId, lidarSensor);
+  }
+#endif
+
   return sensor->Name();
 }
 
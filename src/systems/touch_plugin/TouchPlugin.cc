@@ -25,6 +25,7 @@
 
 #include <sdf/Element.hh>
 
+#include "ignition/gazebo/components/ContactPairFilter.hh"
 #include "ignition/gazebo/components/ContactSensor.hh"
 #include "ignition/gazebo/components/ContactSensorData.hh"
 #include "ignition/gazebo/components/Collision.hh"
@@ -63,6 +64,12 @@ class ignition::gazebo::systems::TouchPluginPrivate
   public: void AddTargetEntities(const EntityComponentManager &_ecm,
                                  const std::vector<Entity> &_entities);
 
+  /// \brief Subscribe the sensor collisions to contacts with the target
+  /// entities, so the physics system doesn't copy manifolds this plugin
+  /// never reads.
+  /// \param[in] _ecm Mutable reference to the EntityComponentManager
+  public: void UpdatePairFilters(EntityComponentManager &_ecm);
+
   /// \brief Model interface
   public: Model model{kNullEntity};
 
@@ -346,6 +353,27 @@ void TouchPluginPrivate::AddTargetEntities(const EntityComponentManager &_ecm,
   std::sort(this->targetEntities.begin(), this->targetEntities.end());
 }
 
+//////////////////////////////////////////////////
+void TouchPluginPrivate::UpdatePairFilters(EntityComponentManager &_ecm)
+{
+  // This plugin only ever reads contacts between its sensor collisions
+  // and the target entities, so subscribe to exactly those pairs.
+  // targetEntities is already sorted, as the filter requires.
+  for (const Entity colEntity : this->collisionEntities)
+  {
+    auto *filter = _ecm.Component<components::ContactPairFilter>(colEntity);
+    if (nullptr == filter)
+    {
+      _ecm.CreateComponent(colEntity,
+          components::ContactPairFilter(this->targetEntities));
+    }
+    else
+    {
+      filter->Data() = this->targetEntities;
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void TouchPlugin::Configure(const Entity &_entity,
                             const std::shared_ptr<const sdf::Element> &_sdf,
@@ -370,6 +398,7 @@ void TouchPlugin::PreUpdate(const UpdateInfo &, EntityComponentManager &_ecm)
     // We call Load here instead of Configure because we can't be guaranteed
     // that all entities have been created when Configure is called
     this->dataPtr->Load(_ecm, this->dataPtr->sdfConfig);
+    this->dataPtr->UpdatePairFilters(_ecm);
     this->dataPtr->initialized = true;
   }
 
@@ -385,7 +414,11 @@ void TouchPlugin::PreUpdate(const UpdateInfo &, EntityComponentManager &_ecm)
           potentialEntities.push_back(_entity);
           return true;
         });
-    this->dataPtr->AddTargetEntities(_ecm, potentialEntities);
+    if (!potentialEntities.empty())
+    {
+      this->dataPtr->AddTargetEntities(_ecm, potentialEntities);
+      this->dataPtr->UpdatePairFilters(_ecm);
+    }
   }
 }
 
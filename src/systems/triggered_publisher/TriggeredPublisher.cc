@@ -20,6 +20,7 @@
 
 #include <ignition/common/Profiler.hh>
 #include <ignition/common/Util.hh>
+#include <ignition/math/Helpers.hh>
 #include <ignition/plugin/Register.hh>
 
 #include "TriggeredPublisher.hh"
@@ -76,6 +77,10 @@ class systems::InputMatcher
   /// \brief Protobuf message for matching against input
   protected: std::unique_ptr<transport::ProtoMsg> matchMsg;
 
+  /// \brief Tolerance for float comparisons, mirrored from the comparator so
+  /// matchers with compiled comparisons can use it directly
+  protected: double tolerance{1e-8};
+
   /// \brief State of the matcher
   protected: bool valid{false};
 
@@ -172,6 +177,11 @@ class FieldMatcher : public InputMatcher
   /// \brief Field descriptor of the field compared by this matcher
   protected: std::vector<const google::protobuf::FieldDescriptor *>
                  fieldDescMatcher;
+
+  /// \brief True when the compared field is a singular scalar. Detected once
+  /// at construction so that DoMatch can compare values directly through
+  /// reflection instead of running a MessageDifferencer on every input.
+  protected: bool scalarField{false};
 };
 
 //////////////////////////////////////////////////
@@ -196,6 +206,7 @@ bool InputMatcher::Match(const transport::ProtoMsg &_input) const
 
 void InputMatcher::SetTolerance(double _tol)
 {
+  this->tolerance = _tol;
   this->comparator.SetDefaultFractionAndMargin(
       std::numeric_limits<double>::min(), _tol);
 }
@@ -288,6 +299,10 @@ FieldMatcher::FieldMatcher(const std::string &_msgType, bool _logicType,
     return;
   }
 
+  this->scalarField = !this->fieldDescMatcher.back()->is_repeated() &&
+      google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE !=
+          this->fieldDescMatcher.back()->cpp_type();
+
   this->valid = true;
 }
 
@@ -371,8 +386,6 @@ bool FieldMatcher::FindFieldSubMessage(
 bool FieldMatcher::DoMatch(
     const transport::ProtoMsg &_input) const
 {
-  google::protobuf::util::DefaultFieldComparator comp;
-
   auto *matcherRefl = this->matchMsg->GetReflection();
   auto *inputRefl = _input.GetReflection();
   const transport::ProtoMsg *subMsgMatcher = this->matchMsg.get();
@@ -393,10 +406,72 @@ bool FieldMatcher::DoMatch(
     }
   }
 
+  const auto *leafDesc = this->fieldDescMatcher.back();
+
+  // Singular scalars are compared directly through reflection. This avoids
+  // setting up a MessageDifferencer for every input message, which dominates
+  // the matching cost on high-rate topics.
+  if (this->scalarField)
+  {
+    using FieldDescriptor = google::protobuf::FieldDescriptor;
+    bool equal{false};
+    switch (leafDesc->cpp_type())
+    {
+      case FieldDescriptor::CPPTYPE_DOUBLE:
+        equal = math::equal(matcherRefl->GetDouble(*subMsgMatcher, leafDesc),
+            inputRefl->GetDouble(*subMsgInput, leafDesc), this->tolerance);
+        break;
+      case FieldDescriptor::CPPTYPE_FLOAT:
+        equal = math::equal(
+            static_cast<double>(matcherRefl->GetFloat(*subMsgMatcher,
+                leafDesc)),
+            static_cast<double>(inputRefl->GetFloat(*subMsgInput, leafDesc)),
+            this->tolerance);
+        break;
+      case FieldDescriptor::CPPTYPE_INT32:
+        equal = matcherRefl->GetInt32(*subMsgMatcher, leafDesc) ==
+            inputRefl->GetInt32(*subMsgInput, leafDesc);
+        break;
+      case FieldDescriptor::CPPTYPE_INT64:
+        equal = matcherRefl->GetInt64(*subMsgMatcher, leafDesc) ==
+            inputRefl->GetInt64(*subMsgInput, leafDesc);
+        break;
+      case FieldDescriptor::CPPTYPE_UINT32:
+        equal = matcherRefl->GetUInt32(*subMsgMatcher, leafDesc) ==
+            inputRefl->GetUInt32(*subMsgInput, leafDesc);
+        break;
+      case FieldDescriptor::CPPTYPE_UINT64:
+        equal = matcherRefl->GetUInt64(*subMsgMatcher, leafDesc) ==
+            inputRefl->GetUInt64(*subMsgInput, leafDesc);
+        break;
+      case FieldDescriptor::CPPTYPE_BOOL:
+        equal = matcherRefl->GetBool(*subMsgMatcher, leafDesc) ==
+            inputRefl->GetBool(*subMsgInput, leafDesc);
+        break;
+      case FieldDescriptor::CPPTYPE_ENUM:
+        equal = matcherRefl->GetEnumValue(*subMsgMatcher, leafDesc) ==
+            inputRefl->GetEnumValue(*subMsgInput, leafDesc);
+        break;
+      case FieldDescriptor::CPPTYPE_STRING:
+      {
+        std::string scratchMatcher, scratchInput;
+        equal = matcherRefl->GetStringReference(*subMsgMatcher, leafDesc,
+            &scratchMatcher) ==
+            inputRefl->GetStringReference(*subMsgInput, leafDesc,
+                &scratchInput);
+        break;
+      }
+      default:
+        return this->logicType ==
+               this->diff.CompareWithFields(*subMsgMatcher, *subMsgInput,
+                                            {leafDesc}, {leafDesc});
+    }
+    return this->logicType == equal;
+  }
+
   return this->logicType ==
          this->diff.CompareWithFields(*subMsgMatcher, *subMsgInput,
-                                      {this->fieldDescMatcher.back()},
-                                      {this->fieldDescMatcher.back()});
+                                      {leafDesc}, {leafDesc});
 }
 
 //////////////////////////////////////////////////
@@ -572,16 +647,31 @@ void TriggeredPublisher::Configure(const Entity &,
     return;
   }
 
+  this->batchSize = static_cast<std::size_t>(
+      sdfClone->Get<unsigned int>("batch_size", 1u).first);
+  if (0 == this->batchSize)
+  {
+    ignwarn << "<batch_size> must be positive. Defaulting to 1\n";
+    this->batchSize = 1;
+  }
+
   auto msgCb = std::function<void(const transport::ProtoMsg &)>(
       [this](const auto &_msg)
       {
         if (this->MatchInput(_msg))
         {
+          bool batchReady{false};
           {
             std::lock_guard<std::mutex> lock(this->publishCountMutex);
-            ++this->publishCount;
+            if (++this->matchCount >= this->batchSize)
+            {
+              this->matchCount = 0;
+              ++this->publishCount;
+              batchReady = true;
+            }
           }
-          this->newMatchSignal.notify_one();
+          if (batchReady)
+            this->newMatchSignal.notify_one();
         }
       });
   if (!this->node.Subscribe(this->inputTopic, msgCb))
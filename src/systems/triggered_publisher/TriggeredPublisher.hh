@@ -73,6 +73,12 @@ namespace systems
   ///     the human-readable representation of a protobuf message as used by
   ///     `ign topic` for publishing messages
   ///
+  /// `<batch_size>`: Optional number of matched input messages to coalesce
+  /// into a single output publish. Each output topic publishes once for every
+  /// `batch_size` inputs that match, which keeps high-rate triggers from
+  /// producing an equally high-rate output stream. Defaults to 1, i.e. one
+  /// publish per match.
+  ///
   /// Examples:
   /// 1. Any receipt of a Boolean messages on the input topic triggers an output
   /// \code{.xml}
@@ -211,7 +217,13 @@ namespace systems
     /// \brief Counter that tells the publisher how many times to publish
     private: std::size_t publishCount{0};
 
-    /// \brief Mutex to synchronize access to publishCount
+    /// \brief Number of matched inputs coalesced into one publish
+    private: std::size_t batchSize{1};
+
+    /// \brief Matches accumulated toward the next batch
+    private: std::size_t matchCount{0};
+
+    /// \brief Mutex to synchronize access to publishCount and matchCount
     private: std::mutex publishCountMutex;
 
     /// \brief Condition variable to signal that new matches have occured
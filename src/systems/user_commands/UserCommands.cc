@@ -19,25 +19,56 @@
 #include <ignition/msgs/boolean.pb.h>
 #include <ignition/msgs/entity_factory.pb.h>
 #include <ignition/msgs/pose.pb.h>
+#include <ignition/msgs/pose_v.pb.h>
+#include <ignition/msgs/uint64_v.pb.h>
 #include <ignition/msgs/Utility.hh>
 
-#include <sdf/Root.hh>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <sdf/Collision.hh>
 #include <sdf/Error.hh>
+#include <sdf/Geometry.hh>
+#include <sdf/Link.hh>
+#include <sdf/Material.hh>
+#include <sdf/Model.hh>
+#include <sdf/Root.hh>
+#include <sdf/Visual.hh>
 
 #include <ignition/plugin/Register.hh>
 #include <ignition/transport/Node.hh>
 
 #include "ignition/common/Profiler.hh"
+#include "ignition/common/WorkerPool.hh"
 
+#include "ignition/gazebo/components/Collision.hh"
+#include "ignition/gazebo/components/Geometry.hh"
+#include "ignition/gazebo/components/Joint.hh"
 #include "ignition/gazebo/components/Light.hh"
+#include "ignition/gazebo/components/Link.hh"
+#include "ignition/gazebo/components/Material.hh"
 #include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/PoseCmd.hh"
+#include "ignition/gazebo/components/Visibility.hh"
+#include "ignition/gazebo/components/Visual.hh"
 #include "ignition/gazebo/components/World.hh"
+#include "ignition/gazebo/Conversions.hh"
+#include "ignition/gazebo/detail/MpscQueue.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/SdfEntityCreator.hh"
+#include "ignition/gazebo/StaticSystemRegistry.hh"
 
 #include "UserCommands.hh"
 
@@ -52,6 +83,49 @@ namespace gazebo
 inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
 namespace systems
 {
+/// \brief Process-level registry of parsed spawn templates, shared by
+/// every world in the server. Multi-world setups spawn the same model
+/// descriptions into each world, so the XML parsing and validation cost
+/// is paid once per process instead of once per world. Entries are
+/// immutable once inserted; spawns copy the model before renaming it.
+class SdfTemplateRegistry
+{
+  /// \brief Get the process-wide instance.
+  public: static SdfTemplateRegistry &Instance()
+  {
+    static SdfTemplateRegistry instance;
+    return instance;
+  }
+
+  /// \brief Look up a parsed template.
+  /// \param[in] _key The spawn request's SDF string or filename.
+  /// \return The parsed root, or nullptr if not cached yet.
+  public: std::shared_ptr<const sdf::Root> Find(
+              const std::string &_key) const
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->templates.find(_key);
+    return it != this->templates.end() ? it->second : nullptr;
+  }
+
+  /// \brief Insert a parsed template.
+  /// \param[in] _key The spawn request's SDF string or filename.
+  /// \param[in] _root The parsed root.
+  public: void Insert(const std::string &_key,
+              std::shared_ptr<const sdf::Root> _root)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->templates[_key] = std::move(_root);
+  }
+
+  /// \brief Guards templates; each world steps on its own thread.
+  private: mutable std::mutex mutex;
+
+  /// \brief Parsed templates keyed by SDF string or filename.
+  private: std::unordered_map<std::string,
+      std::shared_ptr<const sdf::Root>> templates;
+};
+
 /// \brief This class is passed to every command and contains interfaces that
 /// can be shared among all commands. For example, all create and remove
 /// commands can use the `creator` object.
@@ -101,8 +175,20 @@ class CreateCommand : public UserCommandBase
   public: CreateCommand(msgs::EntityFactory *_msg,
       std::shared_ptr<UserCommandsInterface> &_iface);
 
+  /// \brief Start parsing the request's SDF on a worker thread. Called
+  /// from the service callback, so by the time the command executes the
+  /// parsed result is usually ready and the step loop only pays for ECM
+  /// insertion. Malformed SDF is rejected on the worker, too, without
+  /// ever charging a simulation step for it.
+  /// \param[in] _pool Worker pool to parse on.
+  public: void ParseAsync(common::WorkerPool &_pool);
+
   // Documentation inherited
   public: bool Execute() final;
+
+  /// \brief Parsed SDF root, set by ParseAsync. A null result means the
+  /// SDF failed to parse; the worker already logged the errors.
+  private: std::shared_future<std::shared_ptr<const sdf::Root>> root;
 };
 
 /// \brief Command to remove an entity from simulation.
@@ -141,6 +227,59 @@ class PoseCommand : public UserCommandBase
                          math::equal(_a.Rot().W(), _b.Rot().W(), 1e-6);
                      }};
 };
+
+/// \brief Command to patch a live model from an SDF fragment. The
+/// fragment is diffed against the live components and only the
+/// differences are written, so engine-side objects of everything
+/// unchanged survive the edit: a pose change goes through the pose
+/// command component, a changed visual churns only its own entity, and
+/// the physics engine never tears anything down. Changes the engines
+/// can't absorb in place (links, collisions or joints added, removed or
+/// reshaped) are reported and skipped; those still need a remove and
+/// respawn.
+class PatchCommand : public UserCommandBase
+{
+  /// \brief Constructor
+  /// \param[in] _msg Factory message carrying the SDF fragment. The
+  /// model to patch is found by the message name, or the fragment's
+  /// model name if unset.
+  /// \param[in] _iface Pointer to user commands interface.
+  public: PatchCommand(msgs::EntityFactory *_msg,
+      std::shared_ptr<UserCommandsInterface> &_iface);
+
+  // Documentation inherited
+  public: bool Execute() final;
+
+  /// \brief Pose3d equality comparison function.
+  public: std::function<bool(const math::Pose3d &, const math::Pose3d &)>
+          pose3Eql { [](const math::Pose3d &_a, const math::Pose3d &_b)
+                     {
+                       return _a.Pos().Equal(_b.Pos(), 1e-6) &&
+                         math::equal(_a.Rot().X(), _b.Rot().X(), 1e-6) &&
+                         math::equal(_a.Rot().Y(), _b.Rot().Y(), 1e-6) &&
+                         math::equal(_a.Rot().Z(), _b.Rot().Z(), 1e-6) &&
+                         math::equal(_a.Rot().W(), _b.Rot().W(), 1e-6);
+                     }};
+};
+
+/// \brief Command to set the visibility flags of entity subtrees. The
+/// request packs (entity id, flags) pairs into a msgs::UInt64_V, so one
+/// call can retarget any number of subtrees, e.g. everything a given
+/// sensor should stop seeing. For each pair, every visual under the
+/// entity gets its VisibilityFlags component updated; the GUI scene and
+/// the sensor scene both apply the change on their next update, so no
+/// per-sensor model duplication is needed.
+class VisibilityCommand : public UserCommandBase
+{
+  /// \brief Constructor
+  /// \param[in] _msg Message holding (entity id, flags) pairs.
+  /// \param[in] _iface Pointer to user commands interface.
+  public: VisibilityCommand(msgs::UInt64_V *_msg,
+      std::shared_ptr<UserCommandsInterface> &_iface);
+
+  // Documentation inherited
+  public: bool Execute() final;
+};
 }
 }
 }
@@ -165,6 +304,15 @@ class ignition::gazebo::systems::UserCommandsPrivate
   public: bool CreateServiceMultiple(
               const msgs::EntityFactory_V &_req, msgs::Boolean &_res);
 
+  /// \brief Callback for patch service
+  /// \param[in] _req Request containing an SDF fragment to diff against
+  /// a live model.
+  /// \param[in] _res True if message successfully received and queued.
+  /// It does not mean that the patch will be successfully applied.
+  /// \return True if successful.
+  public: bool PatchService(const msgs::EntityFactory &_req,
+      msgs::Boolean &_res);
+
   /// \brief Callback for remove service
   /// \param[in] _req Request containing identification of entity to be removed.
   /// \param[in] _res True if message successfully received and queued.
@@ -180,17 +328,48 @@ class ignition::gazebo::systems::UserCommandsPrivate
   /// \return True if successful.
   public: bool PoseService(const msgs::Pose &_req, msgs::Boolean &_res);
 
-  /// \brief Queue of commands pending execution.
-  public: std::vector<std::unique_ptr<UserCommandBase>> pendingCmds;
+  /// \brief Callback for multiple pose service
+  /// \param[in] _req Request containing pose updates for one or more
+  /// entities, queued as one batch so callers pay a single round trip.
+  /// \param[in] _res True if message successfully received and queued.
+  /// It does not mean that the entities will be successfully moved.
+  /// \return True if successful.
+  public: bool PoseVectorService(const msgs::Pose_V &_req,
+      msgs::Boolean &_res);
+
+  /// \brief Callback for visibility service
+  /// \param[in] _req Request holding (entity id, flags) pairs.
+  /// \param[in] _res True if message successfully received and queued.
+  /// \return True if successful.
+  public: bool VisibilityService(const msgs::UInt64_V &_req,
+      msgs::Boolean &_res);
+
+  /// \brief Queue of commands pending execution. Service callback
+  /// threads push without blocking, and PreUpdate drains the queue once
+  /// per step.
+  public: detail::MpscQueue<std::unique_ptr<UserCommandBase>> pendingCmds;
+
+  /// \brief Commands held over from previous steps because the execution
+  /// budget ran out. They run ahead of newly received commands so
+  /// execution stays in order of reception.
+  public: std::vector<std::unique_ptr<UserCommandBase>> deferredCmds;
+
+  /// \brief Wall-clock time PreUpdate may spend executing commands in one
+  /// step. Commands beyond the budget are carried over to following
+  /// steps, so a burst of creates or removes cannot stall the step loop.
+  /// Zero or negative executes everything queued in the same step.
+  public: std::chrono::steady_clock::duration executionBudget =
+      std::chrono::milliseconds(5);
 
   /// \brief Ignition communication node.
   public: transport::Node node;
 
+  /// \brief Worker used to parse and validate spawn SDF off the step
+  /// loop. A single thread keeps parses in order of reception.
+  public: common::WorkerPool sdfParsePool{1};
+
   /// \brief Object holding several interfaces that can be used by any command.
   public: std::shared_ptr<UserCommandsInterface> iface{nullptr};
-
-  /// \brief Mutex to protect pending queue.
-  public: std::mutex pendingMutex;
 };
 
 //////////////////////////////////////////////////
@@ -204,10 +383,18 @@ UserCommands::~UserCommands() = default;
 
 //////////////////////////////////////////////////
 void UserCommands::Configure(const Entity &_entity,
-    const std::shared_ptr<const sdf::Element> &,
+    const std::shared_ptr<const sdf::Element> &_sdf,
     EntityComponentManager &_ecm,
     EventManager &_eventManager)
 {
+  if (_sdf->HasElement("execution_budget"))
+  {
+    this->dataPtr->executionBudget =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(
+        _sdf->Get<double>("execution_budget")));
+  }
+
   // Create interfaces shared among commands
   this->dataPtr->iface = std::make_shared<UserCommandsInterface>();
   this->dataPtr->iface->worldEntity = _entity;
@@ -230,6 +417,13 @@ void UserCommands::Configure(const Entity &_entity,
 
   ignmsg << "Create service on [" << createService << "]" << std::endl;
 
+  // Patch service
+  std::string patchService{"/world/" + worldName + "/patch"};
+  this->dataPtr->node.Advertise(patchService,
+      &UserCommandsPrivate::PatchService, this->dataPtr.get());
+
+  ignmsg << "Patch service on [" << patchService << "]" << std::endl;
+
   // Remove service
   std::string removeService{"/world/" + worldName + "/remove"};
   this->dataPtr->node.Advertise(removeService,
@@ -243,6 +437,21 @@ void UserCommands::Configure(const Entity &_entity,
       &UserCommandsPrivate::PoseService, this->dataPtr.get());
 
   ignmsg << "Pose service on [" << poseService << "]" << std::endl;
+
+  // Pose service for Pose_V
+  std::string poseVectorService{"/world/" + worldName + "/set_pose_vector"};
+  this->dataPtr->node.Advertise(poseVectorService,
+      &UserCommandsPrivate::PoseVectorService, this->dataPtr.get());
+
+  ignmsg << "Pose service on [" << poseVectorService << "]" << std::endl;
+
+  // Visibility service
+  std::string visibilityService{"/world/" + worldName + "/set_visibility"};
+  this->dataPtr->node.Advertise(visibilityService,
+      &UserCommandsPrivate::VisibilityService, this->dataPtr.get());
+
+  ignmsg << "Visibility service on [" << visibilityService << "]"
+         << std::endl;
 }
 
 //////////////////////////////////////////////////
@@ -250,29 +459,52 @@ void UserCommands::PreUpdate(const UpdateInfo &/*_info*/,
     EntityComponentManager &)
 {
   IGN_PROFILE("UserCommands::PreUpdate");
-  // make a copy the cmds so execution does not block receiving other
+  // Take the pending commands so execution does not block receiving other
   // incoming cmds
-  std::vector<std::unique_ptr<UserCommandBase>> cmds;
+  auto cmds = this->dataPtr->pendingCmds.DrainAll();
+
+  // Commands carried over from the previous step run first so execution
+  // stays in order of reception.
+  if (!this->dataPtr->deferredCmds.empty())
   {
-    std::lock_guard<std::mutex> lock(this->dataPtr->pendingMutex);
-    if (this->dataPtr->pendingCmds.empty())
-      return;
-    cmds = std::move(this->dataPtr->pendingCmds);
-    this->dataPtr->pendingCmds.clear();
+    cmds.insert(cmds.begin(),
+        std::make_move_iterator(this->dataPtr->deferredCmds.begin()),
+        std::make_move_iterator(this->dataPtr->deferredCmds.end()));
+    this->dataPtr->deferredCmds.clear();
   }
 
+  if (cmds.empty())
+    return;
+
   // TODO(louise) Record current world state for undo
 
-  // Execute pending commands
-  for (auto &cmd : cmds)
+  // Execute pending commands, spreading bursts larger than the execution
+  // budget over subsequent steps.
+  const bool bounded = this->dataPtr->executionBudget >
+      std::chrono::steady_clock::duration::zero();
+  const auto deadline = std::chrono::steady_clock::now() +
+      this->dataPtr->executionBudget;
+  for (std::size_t i = 0; i < cmds.size(); ++i)
   {
     // Execute
-    if (!cmd->Execute())
-      continue;
+    if (cmds[i]->Execute())
+    {
+      // TODO(louise) Update command with current world state
 
-    // TODO(louise) Update command with current world state
+      // TODO(louise) Move to undo list
+    }
 
-    // TODO(louise) Move to undo list
+    if (bounded && i + 1 < cmds.size() &&
+        std::chrono::steady_clock::now() >= deadline)
+    {
+      this->dataPtr->deferredCmds.assign(
+          std::make_move_iterator(cmds.begin() + i + 1),
+          std::make_move_iterator(cmds.end()));
+      igndbg << "Execution budget reached, deferring "
+             << this->dataPtr->deferredCmds.size()
+             << " user commands to the next step." << std::endl;
+      break;
+    }
   }
 
   // TODO(louise) Clear redo list
@@ -282,7 +514,6 @@ void UserCommands::PreUpdate(const UpdateInfo &/*_info*/,
 bool UserCommandsPrivate::CreateServiceMultiple(
     const msgs::EntityFactory_V &_req, msgs::Boolean &_res)
 {
-  std::lock_guard<std::mutex> lock(this->pendingMutex);
   for (int i = 0; i < _req.data_size(); ++i)
   {
     const msgs::EntityFactory &msg = _req.data(i);
@@ -290,7 +521,8 @@ bool UserCommandsPrivate::CreateServiceMultiple(
     auto msgCopy = msg.New();
     msgCopy->CopyFrom(msg);
     auto cmd = std::make_unique<CreateCommand>(msgCopy, this->iface);
-    this->pendingCmds.push_back(std::move(cmd));
+    cmd->ParseAsync(this->sdfParsePool);
+    this->pendingCmds.Push(std::move(cmd));
   }
 
   _res.set_data(true);
@@ -305,12 +537,26 @@ bool UserCommandsPrivate::CreateService(const msgs::EntityFactory &_req,
   auto msg = _req.New();
   msg->CopyFrom(_req);
   auto cmd = std::make_unique<CreateCommand>(msg, this->iface);
+  cmd->ParseAsync(this->sdfParsePool);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
+
+  _res.set_data(true);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool UserCommandsPrivate::PatchService(const msgs::EntityFactory &_req,
+    msgs::Boolean &_res)
+{
+  // Create command and push it to queue
+  auto msg = _req.New();
+  msg->CopyFrom(_req);
+  auto cmd = std::make_unique<PatchCommand>(msg, this->iface);
+
+  // Push to pending
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -326,10 +572,7 @@ bool UserCommandsPrivate::RemoveService(const msgs::Entity &_req,
   auto cmd = std::make_unique<RemoveCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -345,15 +588,46 @@ bool UserCommandsPrivate::PoseService(const msgs::Pose &_req,
   auto cmd = std::make_unique<PoseCommand>(msg, this->iface);
 
   // Push to pending
+  this->pendingCmds.Push(std::move(cmd));
+
+  _res.set_data(true);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool UserCommandsPrivate::PoseVectorService(const msgs::Pose_V &_req,
+    msgs::Boolean &_res)
+{
+  for (int i = 0; i < _req.pose_size(); ++i)
   {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
+    const msgs::Pose &msg = _req.pose(i);
+    // Create command and push it to queue
+    auto msgCopy = msg.New();
+    msgCopy->CopyFrom(msg);
+    auto cmd = std::make_unique<PoseCommand>(msgCopy, this->iface);
+    this->pendingCmds.Push(std::move(cmd));
   }
 
   _res.set_data(true);
   return true;
 }
 
+//////////////////////////////////////////////////
+bool UserCommandsPrivate::VisibilityService(const msgs::UInt64_V &_req,
+    msgs::Boolean &_res)
+{
+  // Create command and push it to queue
+  auto msg = _req.New();
+  msg->CopyFrom(_req);
+  auto cmd = std::make_unique<VisibilityCommand>(msg, this->iface);
+
+  // Push to pending
+  this->pendingCmds.Push(std::move(cmd));
+
+  _res.set_data(true);
+  return true;
+}
+
 //////////////////////////////////////////////////
 UserCommandBase::UserCommandBase(google::protobuf::Message *_msg,
     std::shared_ptr<UserCommandsInterface> &_iface)
@@ -377,62 +651,118 @@ CreateCommand::CreateCommand(msgs::EntityFactory *_msg,
 }
 
 //////////////////////////////////////////////////
-bool CreateCommand::Execute()
+/// \brief Resolve the parsed SDF root for a spawn request, going through
+/// the template registry so repeated spawns of the same description are
+/// parsed only once. Parse errors are logged here.
+/// \param[in] _msg The factory message.
+/// \return The parsed root, or nullptr if the request can't be parsed.
+static std::shared_ptr<const sdf::Root> LoadFactorySdf(
+    const msgs::EntityFactory &_msg)
 {
-  auto createMsg = dynamic_cast<const msgs::EntityFactory *>(this->msg);
-  if (nullptr == createMsg)
-  {
-    ignerr << "Internal error, null create message" << std::endl;
-    return false;
-  }
-
-  // Load SDF
-  sdf::Root root;
-  sdf::Errors errors;
-  switch (createMsg->from_case())
+  std::string templateKey;
+  switch (_msg.from_case())
   {
     case msgs::EntityFactory::kSdf:
     {
-      errors = root.LoadSdfString(createMsg->sdf());
+      templateKey = "sdf:" + _msg.sdf();
       break;
     }
     case msgs::EntityFactory::kSdfFilename:
     {
-      errors = root.Load(createMsg->sdf_filename());
+      templateKey = "file:" + _msg.sdf_filename();
       break;
     }
     case msgs::EntityFactory::kModel:
     {
       // TODO(louise) Support model msg
       ignerr << "model field not yet supported." << std::endl;
-      return false;
+      return nullptr;
     }
     case msgs::EntityFactory::kLight:
     {
       // TODO(louise) Support light msg
       ignerr << "light field not yet supported." << std::endl;
-      return false;
+      return nullptr;
     }
     case msgs::EntityFactory::kCloneName:
     {
       // TODO(louise) Implement clone
       ignerr << "Cloning an entity is not yet supported." << std::endl;
-      return false;
+      return nullptr;
     }
     default:
     {
       ignerr << "Missing [from] field in create message." << std::endl;
-      return false;
+      return nullptr;
+    }
+  }
+
+  auto &registry = SdfTemplateRegistry::Instance();
+  auto rootPtr = registry.Find(templateKey);
+  if (nullptr == rootPtr)
+  {
+    auto newRoot = std::make_shared<sdf::Root>();
+    sdf::Errors errors;
+    if (_msg.from_case() == msgs::EntityFactory::kSdf)
+      errors = newRoot->LoadSdfString(_msg.sdf());
+    else
+      errors = newRoot->Load(_msg.sdf_filename());
+
+    if (!errors.empty())
+    {
+      for (auto &err : errors)
+        ignerr << err << std::endl;
+      return nullptr;
     }
+    rootPtr = newRoot;
+    registry.Insert(templateKey, rootPtr);
   }
+  return rootPtr;
+}
 
-  if (!errors.empty())
+//////////////////////////////////////////////////
+void CreateCommand::ParseAsync(common::WorkerPool &_pool)
+{
+  auto createMsg = dynamic_cast<const msgs::EntityFactory *>(this->msg);
+  if (nullptr == createMsg)
+    return;
+
+  auto promise =
+      std::make_shared<std::promise<std::shared_ptr<const sdf::Root>>>();
+  this->root = promise->get_future().share();
+
+  // Copy the message so the worker doesn't depend on this command still
+  // being alive when it runs.
+  msgs::EntityFactory msgCopy(*createMsg);
+  _pool.AddWork([promise, msgCopy]()
+  {
+    promise->set_value(LoadFactorySdf(msgCopy));
+  });
+}
+
+//////////////////////////////////////////////////
+bool CreateCommand::Execute()
+{
+  auto createMsg = dynamic_cast<const msgs::EntityFactory *>(this->msg);
+  if (nullptr == createMsg)
   {
-    for (auto &err : errors)
-      ignerr << err << std::endl;
+    ignerr << "Internal error, null create message" << std::endl;
     return false;
   }
 
+  // The service callback handed the SDF to a worker thread, so by now
+  // the parsed template is usually ready and the step only pays for the
+  // ECM insertion below. Commands queued without ParseAsync parse here.
+  std::shared_ptr<const sdf::Root> rootPtr;
+  if (this->root.valid())
+    rootPtr = this->root.get();
+  else
+    rootPtr = LoadFactorySdf(*createMsg);
+
+  if (nullptr == rootPtr)
+    return false;
+  const sdf::Root &root = *rootPtr;
+
   bool isModel{false};
   bool isLight{false};
   bool isActor{false};
@@ -515,9 +845,10 @@ bool CreateCommand::Execute()
   }
   else if (isLight)
   {
-    auto light = root.LightByIndex(0);
-    light->SetName(desiredName);
-    entity = this->iface->creator->CreateEntities(light);
+    // Copy so the renaming doesn't leak into the cached template
+    auto light = *root.LightByIndex(0);
+    light.SetName(desiredName);
+    entity = this->iface->creator->CreateEntities(&light);
   }
   else if (isActor)
   {
@@ -683,6 +1014,342 @@ bool PoseCommand::Execute()
   return true;
 }
 
+//////////////////////////////////////////////////
+VisibilityCommand::VisibilityCommand(msgs::UInt64_V *_msg,
+    std::shared_ptr<UserCommandsInterface> &_iface)
+    : UserCommandBase(_msg, _iface)
+{
+}
+
+//////////////////////////////////////////////////
+bool VisibilityCommand::Execute()
+{
+  auto visibilityMsg = dynamic_cast<const msgs::UInt64_V *>(this->msg);
+  if (nullptr == visibilityMsg)
+  {
+    ignerr << "Internal error, null visibility message" << std::endl;
+    return false;
+  }
+
+  if (visibilityMsg->data_size() % 2 != 0)
+  {
+    ignerr << "Visibility request must hold (entity, flags) pairs, got ["
+           << visibilityMsg->data_size() << "] values." << std::endl;
+    return false;
+  }
+
+  bool result = true;
+  for (int i = 0; i < visibilityMsg->data_size(); i += 2)
+  {
+    Entity entity = visibilityMsg->data(i);
+    auto flags = static_cast<uint32_t>(visibilityMsg->data(i + 1));
+
+    if (!this->iface->ecm->HasEntity(entity))
+    {
+      ignerr << "Unable to update visibility for entity id:[" << entity
+             << "]" << std::endl;
+      result = false;
+      continue;
+    }
+
+    // Apply to every visual in the subtree, so hiding a model or link
+    // takes all its visuals along.
+    for (const auto &descendant : this->iface->ecm->Descendants(entity))
+    {
+      if (!this->iface->ecm->Component<components::Visual>(descendant))
+        continue;
+
+      auto flagsComp =
+          this->iface->ecm->Component<components::VisibilityFlags>(descendant);
+      if (!flagsComp)
+      {
+        this->iface->ecm->CreateComponent(descendant,
+            components::VisibilityFlags(flags));
+      }
+      else
+      {
+        auto state = flagsComp->SetData(flags,
+            [](const uint32_t &_a, const uint32_t &_b){return _a == _b;}) ?
+            ComponentState::OneTimeChange : ComponentState::NoChange;
+        this->iface->ecm->SetChanged(descendant,
+            components::VisibilityFlags::typeId, state);
+      }
+    }
+  }
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+PatchCommand::PatchCommand(msgs::EntityFactory *_msg,
+    std::shared_ptr<UserCommandsInterface> &_iface)
+    : UserCommandBase(_msg, _iface)
+{
+}
+
+//////////////////////////////////////////////////
+/// \brief Compare two SDF DOM pieces through their message form. The
+/// conversion covers every field the simulation consumes, so equal
+/// messages mean there is nothing to patch.
+/// \param[in] _a First piece.
+/// \param[in] _b Second piece.
+/// \return True if the pieces convert to the same message.
+template <typename MsgT, typename SdfT>
+static bool SameSdf(const SdfT &_a, const SdfT &_b)
+{
+  std::string a, b;
+  convert<MsgT>(_a).SerializeToString(&a);
+  convert<MsgT>(_b).SerializeToString(&b);
+  return a == b;
+}
+
+//////////////////////////////////////////////////
+bool PatchCommand::Execute()
+{
+  auto patchMsg = dynamic_cast<const msgs::EntityFactory *>(this->msg);
+  if (nullptr == patchMsg)
+  {
+    ignerr << "Internal error, null patch message" << std::endl;
+    return false;
+  }
+
+  auto *ecm = this->iface->ecm;
+
+  // Parse the fragment through the template registry, like create does;
+  // designers iterate on the same handful of fragments.
+  std::string templateKey;
+  if (patchMsg->from_case() == msgs::EntityFactory::kSdf)
+    templateKey = "sdf:" + patchMsg->sdf();
+  else if (patchMsg->from_case() == msgs::EntityFactory::kSdfFilename)
+    templateKey = "file:" + patchMsg->sdf_filename();
+  else
+  {
+    ignerr << "Patch requires an SDF string or filename." << std::endl;
+    return false;
+  }
+
+  auto &registry = SdfTemplateRegistry::Instance();
+  auto rootPtr = registry.Find(templateKey);
+  if (nullptr == rootPtr)
+  {
+    auto newRoot = std::make_shared<sdf::Root>();
+    sdf::Errors errors;
+    if (patchMsg->from_case() == msgs::EntityFactory::kSdf)
+      errors = newRoot->LoadSdfString(patchMsg->sdf());
+    else
+      errors = newRoot->Load(patchMsg->sdf_filename());
+
+    if (!errors.empty())
+    {
+      for (auto &err : errors)
+        ignerr << err << std::endl;
+      return false;
+    }
+    rootPtr = newRoot;
+    registry.Insert(templateKey, rootPtr);
+  }
+
+  if (rootPtr->ModelCount() == 0)
+  {
+    ignerr << "Patching only supports <model> fragments." << std::endl;
+    return false;
+  }
+  const sdf::Model &model = *rootPtr->ModelByIndex(0);
+
+  const std::string name =
+      patchMsg->name().empty() ? model.Name() : patchMsg->name();
+  Entity modelEntity = ecm->EntityByComponents(components::Name(name),
+      components::ParentEntity(this->iface->worldEntity));
+  if (kNullEntity == modelEntity ||
+      nullptr == ecm->Component<components::Model>(modelEntity))
+  {
+    ignerr << "No model named [" << name << "] to patch." << std::endl;
+    return false;
+  }
+
+  bool applied = false;
+  std::vector<std::string> unpatchable;
+
+  // A model pose change goes through the pose command component, which
+  // physics applies to the existing engine objects.
+  auto modelPose = ecm->Component<components::Pose>(modelEntity);
+  if (modelPose && !this->pose3Eql(model.RawPose(), modelPose->Data()))
+  {
+    auto poseCmdComp = ecm->Component<components::WorldPoseCmd>(modelEntity);
+    if (!poseCmdComp)
+    {
+      ecm->CreateComponent(modelEntity,
+          components::WorldPoseCmd(model.RawPose()));
+    }
+    else
+    {
+      poseCmdComp->SetData(model.RawPose(), this->pose3Eql);
+      ecm->SetChanged(modelEntity, components::WorldPoseCmd::typeId,
+          ComponentState::OneTimeChange);
+    }
+    applied = true;
+  }
+
+  std::unordered_set<std::string> patchedLinks;
+  for (uint64_t li = 0; li < model.LinkCount(); ++li)
+  {
+    const sdf::Link *link = model.LinkByIndex(li);
+    patchedLinks.insert(link->Name());
+
+    Entity linkEntity = ecm->EntityByComponents(
+        components::Name(link->Name()),
+        components::ParentEntity(modelEntity), components::Link());
+    if (kNullEntity == linkEntity)
+    {
+      unpatchable.push_back("new link [" + link->Name() + "]");
+      continue;
+    }
+
+    // Physics owns link poses; moving one link inside a model can't be
+    // done in place.
+    auto linkPose = ecm->Component<components::Pose>(linkEntity);
+    if (linkPose && !this->pose3Eql(link->RawPose(), linkPose->Data()))
+      unpatchable.push_back("pose of link [" + link->Name() + "]");
+
+    // Visuals only live in the render engines, which follow component
+    // changes and entity churn, so they can be patched per entity.
+    std::unordered_set<std::string> patchedVisuals;
+    for (uint64_t vi = 0; vi < link->VisualCount(); ++vi)
+    {
+      const sdf::Visual *visual = link->VisualByIndex(vi);
+      patchedVisuals.insert(visual->Name());
+
+      Entity visualEntity = ecm->EntityByComponents(
+          components::Name(visual->Name()),
+          components::ParentEntity(linkEntity), components::Visual());
+      if (kNullEntity == visualEntity)
+      {
+        auto newVisual = this->iface->creator->CreateEntities(visual);
+        this->iface->creator->SetParent(newVisual, linkEntity);
+        applied = true;
+        continue;
+      }
+
+      auto geomComp = ecm->Component<components::Geometry>(visualEntity);
+      if (geomComp && visual->Geom() &&
+          !SameSdf<msgs::Geometry>(*visual->Geom(), geomComp->Data()))
+      {
+        // A reshaped visual is recreated; only this one entity churns.
+        this->iface->creator->RequestRemoveEntity(visualEntity);
+        auto newVisual = this->iface->creator->CreateEntities(visual);
+        this->iface->creator->SetParent(newVisual, linkEntity);
+        applied = true;
+        continue;
+      }
+
+      auto visualPose = ecm->Component<components::Pose>(visualEntity);
+      if (visualPose &&
+          !this->pose3Eql(visual->RawPose(), visualPose->Data()))
+      {
+        visualPose->SetData(visual->RawPose(), this->pose3Eql);
+        ecm->SetChanged(visualEntity, components::Pose::typeId,
+            ComponentState::OneTimeChange);
+        applied = true;
+      }
+
+      auto materialComp = ecm->Component<components::Material>(visualEntity);
+      const sdf::Material material =
+          visual->Material() ? *visual->Material() : sdf::Material();
+      if (materialComp &&
+          !SameSdf<msgs::Material>(material, materialComp->Data()))
+      {
+        materialComp->Data() = material;
+        ecm->SetChanged(visualEntity, components::Material::typeId,
+            ComponentState::OneTimeChange);
+        applied = true;
+      }
+    }
+
+    // Visuals dropped from the fragment are removed.
+    for (const Entity visualEntity : ecm->ChildrenByComponents(
+        linkEntity, components::Visual()))
+    {
+      auto visualName = ecm->Component<components::Name>(visualEntity);
+      if (visualName && patchedVisuals.count(visualName->Data()) == 0)
+      {
+        this->iface->creator->RequestRemoveEntity(visualEntity);
+        applied = true;
+      }
+    }
+
+    // Collisions can't be added to or removed from an engine model, so
+    // any difference needs a remove and respawn.
+    std::unordered_set<std::string> patchedCollisions;
+    for (uint64_t ci = 0; ci < link->CollisionCount(); ++ci)
+    {
+      const sdf::Collision *collision = link->CollisionByIndex(ci);
+      patchedCollisions.insert(collision->Name());
+
+      Entity collisionEntity = ecm->EntityByComponents(
+          components::Name(collision->Name()),
+          components::ParentEntity(linkEntity), components::Collision());
+      if (kNullEntity == collisionEntity)
+      {
+        unpatchable.push_back("new collision [" + collision->Name() + "]");
+        continue;
+      }
+
+      auto geomComp = ecm->Component<components::Geometry>(collisionEntity);
+      auto collisionPose = ecm->Component<components::Pose>(collisionEntity);
+      if ((geomComp && collision->Geom() &&
+           !SameSdf<msgs::Geometry>(*collision->Geom(), geomComp->Data())) ||
+          (collisionPose && !this->pose3Eql(collision->RawPose(),
+           collisionPose->Data())))
+      {
+        unpatchable.push_back("collision [" + collision->Name() + "]");
+      }
+    }
+    for (const Entity collisionEntity : ecm->ChildrenByComponents(
+        linkEntity, components::Collision()))
+    {
+      auto collisionName = ecm->Component<components::Name>(collisionEntity);
+      if (collisionName &&
+          patchedCollisions.count(collisionName->Data()) == 0)
+      {
+        unpatchable.push_back(
+            "removed collision [" + collisionName->Data() + "]");
+      }
+    }
+  }
+
+  // Links dropped from the fragment.
+  for (const Entity linkEntity : ecm->ChildrenByComponents(
+      modelEntity, components::Link()))
+  {
+    auto linkName = ecm->Component<components::Name>(linkEntity);
+    if (linkName && patchedLinks.count(linkName->Data()) == 0)
+      unpatchable.push_back("removed link [" + linkName->Data() + "]");
+  }
+
+  // Joints aren't diffed; flag when the fragment disagrees with the
+  // live model so the edit isn't lost silently.
+  if (model.JointCount() !=
+      ecm->ChildrenByComponents(modelEntity, components::Joint()).size())
+  {
+    unpatchable.push_back("joints");
+  }
+
+  if (!unpatchable.empty())
+  {
+    std::string changes;
+    for (const auto &change : unpatchable)
+      changes += "\n  - " + change;
+    ignwarn << "Some changes to model [" << name << "] can't be applied in "
+            << "place and were skipped; remove and respawn the model to "
+            << "apply them:" << changes << std::endl;
+  }
+
+  if (applied)
+    igndbg << "Patched model [" << name << "] in place." << std::endl;
+
+  return applied || unpatchable.empty();
+}
+
 
 IGNITION_ADD_PLUGIN(UserCommands, System,
   UserCommands::ISystemConfigure,
@@ -691,3 +1358,5 @@ IGNITION_ADD_PLUGIN(UserCommands, System,
 
 IGNITION_ADD_PLUGIN_ALIAS(UserCommands,
                           "ignition::gazebo::systems::UserCommands")
+
+IGNITION_GAZEBO_ADD_STATIC_SYSTEM(ignition::gazebo::systems::UserCommands)
@@ -54,6 +54,15 @@ namespace systems
   /// * **Request type*: ignition.msgs.EntityFactory_V
   /// * **Response type*: ignition.msgs.Boolean
   ///
+  /// # System parameters
+  ///
+  /// `<execution_budget>`: Wall-clock time in seconds that may be spent
+  /// executing queued commands in one simulation step. Commands that do
+  /// not fit are carried over to following steps in order of reception,
+  /// so a burst of commands cannot stall the step loop. Defaults to
+  /// 0.005. Zero or a negative value executes everything queued in the
+  /// same step.
+  ///
   /// Try some examples described on examples/worlds/empty.sdf
   class IGNITION_GAZEBO_VISIBLE UserCommands:
     public System,
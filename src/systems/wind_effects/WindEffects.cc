@@ -19,6 +19,17 @@
 #include <ignition/msgs/boolean.pb.h>
 #include <ignition/msgs/entity_factory.pb.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
 #include <sdf/Root.hh>
 #include <sdf/Error.hh>
 
@@ -76,6 +87,35 @@ class ignition::gazebo::systems::WindEffectsPrivate
   public: void ApplyWindForce(const UpdateInfo &_info,
                               EntityComponentManager &_ecm);
 
+  /// \brief Stage the current wind velocity for the field worker thread and
+  /// signal it when a grid refresh is due. No-op when no wind field is
+  /// configured.
+  /// \param[in] _info Simulation update info.
+  /// \param[in] _ecm Mutable reference to the EntityComponentManager.
+  public: void UpdateWindField(const UpdateInfo &_info,
+                               EntityComponentManager &_ecm);
+
+  /// \brief Start the wind field worker thread.
+  public: void StartFieldThread();
+
+  /// \brief Stop and join the wind field worker thread.
+  public: void StopFieldThread();
+
+  /// \brief Loop run by the wind field worker thread: waits for a refresh
+  /// request, recomputes every grid node's velocity from the staged wind and
+  /// the persistent per-node gust states, and swaps the result in as the
+  /// front buffer.
+  public: void FieldThread();
+
+  /// \brief Sample the wind field with trilinear interpolation.
+  /// \param[in] _field Front buffer of grid node velocities.
+  /// \param[in] _pos World position to sample at. Positions outside the grid
+  /// are clamped to its boundary.
+  /// \return Interpolated wind velocity.
+  public: math::Vector3d SampleField(
+      const std::vector<math::Vector3d> &_field,
+      const math::Vector3d &_pos) const;
+
   /// \brief Callback for topic for setting the wind seed velocity and enabling
   /// this system.
   /// \param[in] _msg msgs::Wind message.
@@ -162,6 +202,64 @@ class ignition::gazebo::systems::WindEffectsPrivate
   /// \brief Current wind velocity seed and global enable/disable state.
   /// This is set by a transport message.
   public: msgs::Wind currentWindInfo;
+
+  /// \brief True when a <wind_field> grid is configured.
+  public: bool useWindField{false};
+
+  /// \brief Center of the wind field grid in world coordinates.
+  public: math::Vector3d fieldCenter{math::Vector3d::Zero};
+
+  /// \brief Dimensions of the wind field grid in meters.
+  public: math::Vector3d fieldSize{math::Vector3d::Zero};
+
+  /// \brief Minimum corner of the wind field grid, derived from the center
+  /// and size.
+  public: math::Vector3d fieldMin{math::Vector3d::Zero};
+
+  /// \brief Distance between wind field grid nodes in meters.
+  public: double fieldResolution{10.0};
+
+  /// \brief Fraction of the wind speed used as gust amplitude.
+  public: double fieldVariation{0.1};
+
+  /// \brief Number of grid nodes along each axis.
+  public: std::size_t fieldNx{0};
+  public: std::size_t fieldNy{0};
+  public: std::size_t fieldNz{0};
+
+  /// \brief Simulation time between grid refreshes.
+  public: std::chrono::steady_clock::duration fieldUpdatePeriod{
+              std::chrono::seconds(1)};
+
+  /// \brief Simulation time of the last grid refresh request.
+  public: std::chrono::steady_clock::duration lastFieldUpdateTime{0};
+
+  /// \brief Whether a grid refresh has ever been requested. The first
+  /// request is issued immediately instead of waiting a full period.
+  public: bool fieldEverRequested{false};
+
+  /// \brief Protects fieldFront, fieldBaseWind and fieldRefreshRequested.
+  public: std::mutex fieldMutex;
+
+  /// \brief Notifies the field thread of refresh requests.
+  public: std::condition_variable fieldCv;
+
+  /// \brief Wind velocity staged for the next grid refresh.
+  public: math::Vector3d fieldBaseWind{math::Vector3d::Zero};
+
+  /// \brief True while a staged refresh has not been consumed yet.
+  public: bool fieldRefreshRequested{false};
+
+  /// \brief Front buffer of grid node velocities, swapped in whole by the
+  /// field thread so the simulation thread never samples a half-written
+  /// grid.
+  public: std::shared_ptr<const std::vector<math::Vector3d>> fieldFront;
+
+  /// \brief True while the field thread should keep running.
+  public: std::atomic<bool> fieldThreadRunning{false};
+
+  /// \brief Worker thread that recomputes the wind field grid.
+  public: std::thread fieldThread;
 };
 
 /////////////////////////////////////////////////
@@ -295,6 +393,64 @@ void WindEffectsPrivate::Load(EntityComponentManager &_ecm,
     return;
   }
 
+  if (_sdf->HasElement("wind_field"))
+  {
+    auto sdfField = _sdf->GetElementImpl("wind_field");
+
+    this->fieldSize =
+        sdfField->Get<math::Vector3d>("size", this->fieldSize).first;
+    if (this->fieldSize.Min() <= 0.0)
+    {
+      ignerr << "Please set all components of <wind_field><size> to values "
+             << "greater than 0" << std::endl;
+      return;
+    }
+
+    this->fieldCenter =
+        sdfField->Get<math::Vector3d>("center", this->fieldCenter).first;
+
+    this->fieldResolution =
+        sdfField->Get<double>("resolution", this->fieldResolution).first;
+    if (this->fieldResolution <= 0.0)
+    {
+      ignerr << "Please set <wind_field><resolution> to a value greater "
+             << "than 0" << std::endl;
+      return;
+    }
+
+    this->fieldVariation =
+        sdfField->Get<double>("variation", this->fieldVariation).first;
+
+    double period = sdfField->Get<double>("update_period", 1.0).first;
+    if (period > 0.0)
+    {
+      std::chrono::duration<double> periodSecs{period};
+      this->fieldUpdatePeriod =
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          periodSecs);
+    }
+
+    this->fieldNx = static_cast<std::size_t>(
+        std::ceil(this->fieldSize.X() / this->fieldResolution)) + 1;
+    this->fieldNy = static_cast<std::size_t>(
+        std::ceil(this->fieldSize.Y() / this->fieldResolution)) + 1;
+    this->fieldNz = static_cast<std::size_t>(
+        std::ceil(this->fieldSize.Z() / this->fieldResolution)) + 1;
+
+    const std::size_t nodeCount = this->fieldNx * this->fieldNy * this->fieldNz;
+    const std::size_t maxNodeCount{1000000u};
+    if (nodeCount > maxNodeCount)
+    {
+      ignerr << "The <wind_field> grid would have " << nodeCount
+             << " nodes, which exceeds the limit of " << maxNodeCount
+             << ". Please increase <resolution> or decrease <size>."
+             << std::endl;
+      return;
+    }
+
+    this->fieldMin = this->fieldCenter - this->fieldSize / 2.0;
+    this->useWindField = true;
+  }
 
   this->validConfig = true;
 }
@@ -404,13 +560,25 @@ void WindEffectsPrivate::ApplyWindForce(const UpdateInfo &,
 
   Link link;
 
-  _ecm.Each<components::Link, components::Inertial, components::WindMode,
-            components::WorldLinearVelocity>(
+  // Grab the latest wind field buffer, if any. The field thread swaps whole
+  // buffers, so the one sampled here stays consistent for the entire sweep.
+  std::shared_ptr<const std::vector<math::Vector3d>> field;
+  if (this->useWindField)
+  {
+    std::lock_guard<std::mutex> lock(this->fieldMutex);
+    field = this->fieldFront;
+  }
+
+  // Links in levels that are loaded only as buffer zones don't need wind
+  // forces, so iterate the active partition only.
+  _ecm.EachActive<components::Link, components::Inertial, components::WindMode,
+            components::WorldLinearVelocity, components::WorldPose>(
       [&](const Entity &_entity,
           components::Link *,
           components::Inertial *_inertial,
           components::WindMode *_windMode,
-          components::WorldLinearVelocity *_linkVel) -> bool
+          components::WorldLinearVelocity *_linkVel,
+          components::WorldPose *_linkPose) -> bool
       {
         // Skip links for which the wind is disabled
         if (!_windMode->Data())
@@ -420,9 +588,15 @@ void WindEffectsPrivate::ApplyWindForce(const UpdateInfo &,
 
         link.ResetEntity(_entity);
 
+        // Sample the wind field at the link position, or fall back to the
+        // uniform wind velocity while no buffer is available yet.
+        math::Vector3d localWindVel = field ?
+            this->SampleField(*field, _linkPose->Data().Pos()) :
+            windVel->Data();
+
         math::Vector3d windForce = _inertial->Data().MassMatrix().Mass() *
                                    this->forceApproximationScalingFactor *
-                                   (windVel->Data() - _linkVel->Data());
+                                   (localWindVel - _linkVel->Data());
 
         // Apply force at center of mass
         link.AddWorldForce(_ecm, windForce);
@@ -431,6 +605,152 @@ void WindEffectsPrivate::ApplyWindForce(const UpdateInfo &,
       });
 }
 
+//////////////////////////////////////////////////
+void WindEffectsPrivate::UpdateWindField(const UpdateInfo &_info,
+                                         EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("WindEffectsPrivate::UpdateWindField");
+
+  auto windVel =
+      _ecm.Component<components::WorldLinearVelocity>(this->windEntity);
+  if (!windVel)
+    return;
+
+  // Refresh the grid at a low rate; the uniform wind velocity is still
+  // filtered every step and feeds into the next refresh.
+  if (this->fieldEverRequested &&
+      _info.simTime - this->lastFieldUpdateTime < this->fieldUpdatePeriod)
+  {
+    return;
+  }
+
+  this->lastFieldUpdateTime = _info.simTime;
+  this->fieldEverRequested = true;
+
+  {
+    std::lock_guard<std::mutex> lock(this->fieldMutex);
+    this->fieldBaseWind = windVel->Data();
+    this->fieldRefreshRequested = true;
+  }
+  this->fieldCv.notify_one();
+}
+
+//////////////////////////////////////////////////
+void WindEffectsPrivate::StartFieldThread()
+{
+  this->fieldThreadRunning = true;
+  this->fieldThread = std::thread(&WindEffectsPrivate::FieldThread, this);
+}
+
+//////////////////////////////////////////////////
+void WindEffectsPrivate::StopFieldThread()
+{
+  this->fieldThreadRunning = false;
+  this->fieldCv.notify_all();
+  if (this->fieldThread.joinable())
+    this->fieldThread.join();
+}
+
+//////////////////////////////////////////////////
+void WindEffectsPrivate::FieldThread()
+{
+  const std::size_t nodeCount =
+      this->fieldNx * this->fieldNy * this->fieldNz;
+
+  // Per-node gust states, owned by this thread. Low-pass filtering the
+  // random samples keeps the gusts coherent between refreshes.
+  std::vector<math::Vector3d> variations(nodeCount, math::Vector3d::Zero);
+  std::mt19937 gen(std::random_device{}());
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  const double alpha{0.5};
+
+  while (this->fieldThreadRunning)
+  {
+    math::Vector3d baseWind;
+    {
+      std::unique_lock<std::mutex> lock(this->fieldMutex);
+      this->fieldCv.wait(lock, [this]
+          {
+            return this->fieldRefreshRequested || !this->fieldThreadRunning;
+          });
+      if (!this->fieldThreadRunning)
+        break;
+      this->fieldRefreshRequested = false;
+      baseWind = this->fieldBaseWind;
+    }
+
+    const double gustAmplitude = this->fieldVariation * baseWind.Length();
+
+    auto back = std::make_shared<std::vector<math::Vector3d>>(nodeCount);
+    for (std::size_t i = 0; i < nodeCount; ++i)
+    {
+      variations[i] = (1.0 - alpha) * variations[i] +
+          alpha * math::Vector3d(dist(gen), dist(gen), dist(gen));
+      (*back)[i] = baseWind + gustAmplitude * variations[i];
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->fieldMutex);
+      this->fieldFront = back;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+math::Vector3d WindEffectsPrivate::SampleField(
+    const std::vector<math::Vector3d> &_field,
+    const math::Vector3d &_pos) const
+{
+  // Clamp the position into the grid so links outside it use the nearest
+  // node instead of extrapolating.
+  auto clampAxis = [](double _v, std::size_t _n) -> double
+  {
+    return math::clamp(_v, 0.0, static_cast<double>(_n - 1));
+  };
+  const double x =
+      clampAxis((_pos.X() - this->fieldMin.X()) / this->fieldResolution,
+                this->fieldNx);
+  const double y =
+      clampAxis((_pos.Y() - this->fieldMin.Y()) / this->fieldResolution,
+                this->fieldNy);
+  const double z =
+      clampAxis((_pos.Z() - this->fieldMin.Z()) / this->fieldResolution,
+                this->fieldNz);
+
+  const std::size_t ix = std::min(static_cast<std::size_t>(x),
+                                  this->fieldNx - 2);
+  const std::size_t iy = std::min(static_cast<std::size_t>(y),
+                                  this->fieldNy - 2);
+  const std::size_t iz = std::min(static_cast<std::size_t>(z),
+                                  this->fieldNz - 2);
+
+  const double fx = x - static_cast<double>(ix);
+  const double fy = y - static_cast<double>(iy);
+  const double fz = z - static_cast<double>(iz);
+
+  auto node = [&](std::size_t _ix, std::size_t _iy, std::size_t _iz)
+      -> const math::Vector3d &
+  {
+    return _field[_ix + this->fieldNx * (_iy + this->fieldNy * _iz)];
+  };
+
+  // Trilinear interpolation over the eight surrounding nodes.
+  const math::Vector3d c00 =
+      node(ix, iy, iz) * (1.0 - fx) + node(ix + 1, iy, iz) * fx;
+  const math::Vector3d c10 =
+      node(ix, iy + 1, iz) * (1.0 - fx) + node(ix + 1, iy + 1, iz) * fx;
+  const math::Vector3d c01 =
+      node(ix, iy, iz + 1) * (1.0 - fx) + node(ix + 1, iy, iz + 1) * fx;
+  const math::Vector3d c11 =
+      node(ix, iy + 1, iz + 1) * (1.0 - fx) +
+      node(ix + 1, iy + 1, iz + 1) * fx;
+
+  const math::Vector3d c0 = c00 * (1.0 - fy) + c10 * fy;
+  const math::Vector3d c1 = c01 * (1.0 - fy) + c11 * fy;
+
+  return c0 * (1.0 - fz) + c1 * fz;
+}
+
 
 //////////////////////////////////////////////////
 void WindEffectsPrivate::OnWindMsg(const msgs::Wind &_msg)
@@ -482,7 +802,10 @@ WindEffects::WindEffects() : System(),
 }
 
 //////////////////////////////////////////////////
-WindEffects::~WindEffects() = default;
+WindEffects::~WindEffects()
+{
+  this->dataPtr->StopFieldThread();
+}
 
 //////////////////////////////////////////////////
 void WindEffects::Configure(const Entity &_entity,
@@ -519,6 +842,9 @@ void WindEffects::Configure(const Entity &_entity,
       msgs::Set(this->dataPtr->currentWindInfo.mutable_linear_velocity(),
                 windLinVelSeed->Data());
     }
+
+    if (this->dataPtr->useWindField)
+      this->dataPtr->StartFieldThread();
   }
 }
 
@@ -575,6 +901,8 @@ void WindEffects::PreUpdate(const UpdateInfo &_info,
         return;
 
       this->dataPtr->UpdateWindVelocity(_info, _ecm);
+      if (this->dataPtr->useWindField)
+        this->dataPtr->UpdateWindField(_info, _ecm);
       this->dataPtr->ApplyWindForce(_info, _ecm);
     }
   }
@@ -87,6 +87,22 @@ namespace systems
   /// <vertical><noise>
   /// Parameters for the noise that is added to the vertical wind velocity
   /// magnitude.
+  ///
+  /// <wind_field>
+  /// Optional. When present, the uniform wind velocity is expanded into a 3D
+  /// grid of node velocities with smoothly varying local gusts. The grid is
+  /// recomputed at a low rate on a worker thread and links sample it with
+  /// trilinear interpolation at their world position, so spatial variation
+  /// costs the simulation thread only one interpolation per link. Links
+  /// outside the grid use the nearest node. Child elements:
+  ///   <size>: Grid dimensions in meters (required, all components > 0).
+  ///   <center>: Center of the grid in world coordinates. Defaults to the
+  ///       origin.
+  ///   <resolution>: Distance between grid nodes in meters. Defaults to 10.
+  ///   <update_period>: Simulation time in seconds between grid refreshes.
+  ///       Defaults to 1.
+  ///   <variation>: Fraction of the wind speed used as the amplitude of the
+  ///       per-node gusts. Defaults to 0.1.
   class IGNITION_GAZEBO_VISIBLE WindEffects:
     public System,
     public ISystemConfigure,
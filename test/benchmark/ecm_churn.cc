@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/EntityComponentManager.hh"
+
+#include "ignition/gazebo/components/LinearVelocity.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/Pose.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace components;
+
+constexpr const int kEachIterations {100};
+
+/// \brief Expose the protected step-boundary methods so churn can be
+/// benchmarked the same way SimulationRunner drives the manager.
+class EntityCompMgrBenchmark : public EntityComponentManager
+{
+  public: void RunClearNewlyCreatedEntities()
+  {
+    this->ClearNewlyCreatedEntities();
+  }
+  public: void ProcessEntityRemovals()
+  {
+    this->ProcessRemoveEntityRequests();
+  }
+};
+
+// NOLINTNEXTLINE
+void BM_CreateEntities(benchmark::State &_st)
+{
+  auto entityCount = _st.range(0);
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    auto mgr = std::make_unique<EntityCompMgrBenchmark>();
+    _st.ResumeTiming();
+
+    for (int i = 0; i < entityCount; ++i)
+    {
+      Entity entity = mgr->CreateEntity();
+      mgr->CreateComponent(entity, Name("entity_name"));
+      mgr->CreateComponent(entity, Pose());
+      mgr->CreateComponent(entity, LinearVelocity());
+    }
+  }
+  _st.counters["num_entities"] = entityCount;
+}
+
+// NOLINTNEXTLINE
+void BM_CreateRemoveChurn(benchmark::State &_st)
+{
+  auto entityCount = _st.range(0);
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    auto mgr = std::make_unique<EntityCompMgrBenchmark>();
+    _st.ResumeTiming();
+
+    for (int i = 0; i < entityCount; ++i)
+    {
+      Entity entity = mgr->CreateEntity();
+      mgr->CreateComponent(entity, Name("entity_name"));
+      mgr->CreateComponent(entity, Pose());
+      mgr->CreateComponent(entity, LinearVelocity());
+    }
+    mgr->RunClearNewlyCreatedEntities();
+
+    mgr->Each<Name>(
+        [&](const Entity &_entity, const Name *)->bool
+        {
+          mgr->RequestRemoveEntity(_entity);
+          return true;
+        });
+    mgr->ProcessEntityRemovals();
+  }
+  _st.counters["num_entities"] = entityCount;
+}
+
+class ChurnFixture: public benchmark::Fixture
+{
+  protected: void SetUp(const ::benchmark::State &_state) override
+  {
+    this->mgr = std::make_unique<EntityCompMgrBenchmark>();
+    auto entityCount = _state.range(0);
+    for (int i = 0; i < entityCount; ++i)
+    {
+      Entity entity = this->mgr->CreateEntity();
+      this->mgr->CreateComponent(entity, Name("entity_name"));
+      this->mgr->CreateComponent(entity, Pose());
+      this->mgr->CreateComponent(entity, LinearVelocity());
+    }
+  }
+
+  protected: std::unique_ptr<EntityCompMgrBenchmark> mgr;
+};
+
+// All entities are newly created, so every EachNew call visits all of them.
+BENCHMARK_DEFINE_F(ChurnFixture, EachNewAllNew)
+(benchmark::State &_st)
+{
+  auto entityCount = _st.range(0);
+  for (auto _ : _st)
+  {
+    for (int eachIter = 0; eachIter < kEachIterations; ++eachIter)
+    {
+      int entitiesMatched = 0;
+      mgr->EachNew<Name, Pose>(
+          [&](const Entity &, const Name *, const Pose *)->bool
+          {
+            entitiesMatched++;
+            return true;
+          });
+
+      if (entitiesMatched != entityCount)
+      {
+        _st.SkipWithError("Failed to match correct number of entities");
+      }
+    }
+  }
+}
+
+// The newly created list has been cleared, so EachNew only pays the cost of
+// finding nothing to do. This is the per-step overhead every system with an
+// EachNew query pays on quiescent worlds.
+BENCHMARK_DEFINE_F(ChurnFixture, EachNewNoneNew)
+(benchmark::State &_st)
+{
+  mgr->RunClearNewlyCreatedEntities();
+  for (auto _ : _st)
+  {
+    for (int eachIter = 0; eachIter < kEachIterations; ++eachIter)
+    {
+      int entitiesMatched = 0;
+      mgr->EachNew<Name, Pose>(
+          [&](const Entity &, const Name *, const Pose *)->bool
+          {
+            entitiesMatched++;
+            return true;
+          });
+
+      if (entitiesMatched != 0)
+      {
+        _st.SkipWithError("Expected no newly created entities");
+      }
+    }
+  }
+}
+
+// All entities have a pending removal request, so every EachRemoved call
+// visits all of them.
+BENCHMARK_DEFINE_F(ChurnFixture, EachRemovedAllRemoved)
+(benchmark::State &_st)
+{
+  auto entityCount = _st.range(0);
+  mgr->Each<Name>(
+      [&](const Entity &_entity, const Name *)->bool
+      {
+        mgr->RequestRemoveEntity(_entity);
+        return true;
+      });
+
+  for (auto _ : _st)
+  {
+    for (int eachIter = 0; eachIter < kEachIterations; ++eachIter)
+    {
+      int entitiesMatched = 0;
+      mgr->EachRemoved<Name, Pose>(
+          [&](const Entity &, const Name *, const Pose *)->bool
+          {
+            entitiesMatched++;
+            return true;
+          });
+
+      if (entitiesMatched != entityCount)
+      {
+        _st.SkipWithError("Failed to match correct number of entities");
+      }
+    }
+  }
+}
+
+// No removal requests are pending, the common case on quiescent worlds.
+BENCHMARK_DEFINE_F(ChurnFixture, EachRemovedNoneRemoved)
+(benchmark::State &_st)
+{
+  for (auto _ : _st)
+  {
+    for (int eachIter = 0; eachIter < kEachIterations; ++eachIter)
+    {
+      int entitiesMatched = 0;
+      mgr->EachRemoved<Name, Pose>(
+          [&](const Entity &, const Name *, const Pose *)->bool
+          {
+            entitiesMatched++;
+            return true;
+          });
+
+      if (entitiesMatched != 0)
+      {
+        _st.SkipWithError("Expected no removed entities");
+      }
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_CreateEntities)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_CreateRemoveChurn)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(ChurnFixture, EachNewAllNew)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(ChurnFixture, EachNewNoneNew)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(ChurnFixture, EachRemovedAllRemoved)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(ChurnFixture, EachRemovedNoneRemoved)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Unit(benchmark::kMillisecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
+#pragma GCC diagnostic pop
@@ -130,6 +130,50 @@ void BM_Serialize5Component(benchmark::State &_st)
   _st.counters["num_components"] = 5;
 }
 
+// NOLINTNEXTLINE
+void BM_StateRoundTrip5Component(benchmark::State &_st)
+{
+  size_t serializedSize = 0;
+  auto entityCount = _st.range(0);
+
+  auto mgr = std::make_unique<EntityComponentManager>();
+  for (int ii = 0; ii < entityCount; ++ii)
+  {
+    auto e = mgr->CreateEntity();
+    mgr->CreateComponent(e, IntComponent(ii));
+    mgr->CreateComponent(e, UIntComponent(ii));
+    mgr->CreateComponent(e, DoubleComponent(ii));
+    mgr->CreateComponent(e, StringComponent("foobar"));
+    mgr->CreateComponent(e, BoolComponent(ii%2));
+  }
+
+  // Serialize the full state and apply it to a second manager, the same
+  // path taken when a GUI or recorder consumes the state topic.
+  for (auto _: _st)
+  {
+    auto stateMsg = mgr->State();
+#if GOOGLE_PROTOBUF_VERSION >= 3004000
+    serializedSize = stateMsg.ByteSizeLong();
+#else
+    serializedSize = stateMsg.ByteSize();
+#endif
+
+    _st.PauseTiming();
+    auto receiver = std::make_unique<EntityComponentManager>();
+    _st.ResumeTiming();
+
+    receiver->SetState(stateMsg);
+
+    if (receiver->EntityCount() != static_cast<size_t>(entityCount))
+    {
+      _st.SkipWithError("Failed to restore correct number of entities");
+    }
+  }
+  _st.counters["serialized_size"] = serializedSize;
+  _st.counters["num_entities"] = entityCount;
+  _st.counters["num_components"] = 5;
+}
+
 // NOLINTNEXTLINE
 BENCHMARK(BM_Serialize1Component)
   ->Arg(10)
@@ -148,6 +192,15 @@ BENCHMARK(BM_Serialize5Component)
   ->Arg(1000)
   ->Unit(benchmark::kMillisecond);
 
+// NOLINTNEXTLINE
+BENCHMARK(BM_StateRoundTrip5Component)
+  ->Arg(10)
+  ->Arg(50)
+  ->Arg(100)
+  ->Arg(500)
+  ->Arg(1000)
+  ->Unit(benchmark::kMillisecond);
+
 // OSX needs the semicolon, Ubuntu complains that there's an extra ';'
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpedantic"
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/ServerConfig.hh"
+#include "ignition/gazebo/test_config.hh"  // NOLINT(build/include)
+
+using namespace ignition;
+using namespace gazebo;
+
+constexpr const uint64_t kStepsPerIteration {1000};
+
+/// \brief Generate a world with _modelCount box models. When _broadcast is
+/// true the scene broadcaster system is the only system in the world, so
+/// the difference to the plugin-free variant is the cost of maintaining and
+/// publishing the scene graph and pose updates.
+std::string GenerateWorld(int _modelCount, bool _broadcast)
+{
+  std::ostringstream world;
+  world << "<?xml version=\"1.0\"?>"
+        << "<sdf version=\"1.6\">"
+        << "<world name=\"bench\">";
+  if (_broadcast)
+  {
+    world << "<plugin "
+          << "filename=\"ignition-gazebo-scene-broadcaster-system\" "
+          << "name=\"ignition::gazebo::systems::SceneBroadcaster\">"
+          << "</plugin>";
+  }
+  for (int i = 0; i < _modelCount; ++i)
+  {
+    world << "<model name=\"box_" << i << "\">"
+          << "<pose>" << i << " 0 0.5 0 0 0</pose>"
+          << "<link name=\"link\">"
+          << "<visual name=\"visual\">"
+          << "<geometry><box><size>1 1 1</size></box></geometry>"
+          << "</visual>"
+          << "</link>"
+          << "</model>";
+  }
+  world << "</world>"
+        << "</sdf>";
+  return world.str();
+}
+
+void RunServer(benchmark::State &_st, bool _broadcast)
+{
+  setenv("IGN_GAZEBO_SYSTEM_PLUGIN_PATH",
+         (std::string(PROJECT_BINARY_PATH) + "/lib").c_str(), 1);
+
+  auto modelCount = _st.range(0);
+
+  ServerConfig serverConfig;
+  if (!serverConfig.SetSdfString(GenerateWorld(modelCount, _broadcast)))
+  {
+    _st.SkipWithError("Failed to load generated world");
+    return;
+  }
+
+  Server server(serverConfig);
+  server.SetUpdatePeriod(std::chrono::nanoseconds(1));
+
+  for (auto _ : _st)
+  {
+    if (!server.Run(true, kStepsPerIteration, false))
+    {
+      _st.SkipWithError("Failed to run server");
+      break;
+    }
+  }
+  _st.counters["num_models"] = modelCount;
+  _st.counters["steps_per_iteration"] = kStepsPerIteration;
+}
+
+// NOLINTNEXTLINE
+void BM_StepsWithSceneBroadcaster(benchmark::State &_st)
+{
+  RunServer(_st, true);
+}
+
+// Baseline without any systems. Subtract this from the benchmark above to
+// isolate the scene broadcaster publish cost.
+// NOLINTNEXTLINE
+void BM_StepsWithoutSystems(benchmark::State &_st)
+{
+  RunServer(_st, false);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_StepsWithSceneBroadcaster)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(500)
+  ->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_StepsWithoutSystems)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(500)
+  ->Unit(benchmark::kMillisecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
+#pragma GCC diagnostic pop
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <sdf/Root.hh>
+#include <sdf/World.hh>
+
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/EventManager.hh"
+#include "ignition/gazebo/SdfEntityCreator.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Generate a world with _modelCount box models, each with one link,
+/// one collision and one visual. This approximates the entity mix of our
+/// canonical large worlds without depending on files on disk.
+std::string GenerateWorld(int _modelCount)
+{
+  std::ostringstream world;
+  world << "<?xml version=\"1.0\"?>"
+        << "<sdf version=\"1.6\">"
+        << "<world name=\"bench\">";
+  for (int i = 0; i < _modelCount; ++i)
+  {
+    world << "<model name=\"box_" << i << "\">"
+          << "<pose>" << i << " 0 0.5 0 0 0</pose>"
+          << "<link name=\"link\">"
+          << "<collision name=\"collision\">"
+          << "<geometry><box><size>1 1 1</size></box></geometry>"
+          << "</collision>"
+          << "<visual name=\"visual\">"
+          << "<geometry><box><size>1 1 1</size></box></geometry>"
+          << "</visual>"
+          << "</link>"
+          << "</model>";
+  }
+  world << "</world>"
+        << "</sdf>";
+  return world.str();
+}
+
+// NOLINTNEXTLINE
+void BM_CreateEntitiesFromSdf(benchmark::State &_st)
+{
+  auto modelCount = _st.range(0);
+
+  sdf::Root root;
+  auto errors = root.LoadSdfString(GenerateWorld(modelCount));
+  if (!errors.empty() || nullptr == root.WorldByIndex(0))
+  {
+    _st.SkipWithError("Failed to load generated world");
+    return;
+  }
+
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    auto mgr = std::make_unique<EntityComponentManager>();
+    auto eventMgr = std::make_unique<EventManager>();
+    _st.ResumeTiming();
+
+    SdfEntityCreator creator(*mgr, *eventMgr);
+    creator.CreateEntities(root.WorldByIndex(0));
+
+    _st.PauseTiming();
+    // Each model contributes a model, link, collision and visual entity on
+    // top of the world entity.
+    if (mgr->EntityCount() != static_cast<size_t>(4 * modelCount + 1))
+    {
+      _st.SkipWithError("Failed to create correct number of entities");
+    }
+    _st.ResumeTiming();
+  }
+  _st.counters["num_models"] = modelCount;
+}
+
+// NOLINTNEXTLINE
+BENCHMARK(BM_CreateEntitiesFromSdf)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(500)
+  ->Arg(1000)
+  ->Unit(benchmark::kMillisecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
+#pragma GCC diagnostic pop
@@ -17,10 +17,14 @@
 
 #include <gtest/gtest.h>
 
+#include <ignition/msgs/boolean.pb.h>
+#include <ignition/msgs/world_control.pb.h>
+
 #include <algorithm>
 #include <vector>
 
 #include <ignition/common/Console.hh>
+#include <ignition/transport/Node.hh>
 #include <sdf/Collision.hh>
 #include <sdf/Cylinder.hh>
 #include <sdf/Geometry.hh>
@@ -159,6 +163,77 @@ TEST_F(PhysicsSystemFixture, FallingObject)
   EXPECT_NEAR(spherePoses.back().Pos().Z(), zStopped, 5e-2);
 }
 
+/////////////////////////////////////////////////
+// Rewinding to time zero should restore the initial model poses without
+// recreating the engine objects.
+TEST_F(PhysicsSystemFixture, WorldReset)
+{
+  ignition::gazebo::ServerConfig serverConfig;
+
+  const auto sdfFile = std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/falling.sdf";
+  serverConfig.SetSdfFile(sdfFile);
+
+  sdf::Root root;
+  root.Load(sdfFile);
+  const sdf::World *world = root.WorldByIndex(0);
+  const sdf::Model *model = world->ModelByIndex(0);
+
+  gazebo::Server server(serverConfig);
+
+  server.SetUpdatePeriod(1us);
+
+  const std::string modelName = "sphere";
+  std::vector<ignition::math::Pose3d> spherePoses;
+
+  // Create a system that records the poses of the sphere
+  test::Relay testSystem;
+
+  testSystem.OnPostUpdate(
+    [modelName, &spherePoses](const gazebo::UpdateInfo &,
+    const gazebo::EntityComponentManager &_ecm)
+    {
+      _ecm.Each<components::Model, components::Name, components::Pose>(
+        [&](const ignition::gazebo::Entity &, const components::Model *,
+        const components::Name *_name, const components::Pose *_pose)->bool
+        {
+          if (_name->Data() == modelName) {
+            spherePoses.push_back(_pose->Data());
+          }
+          return true;
+        });
+    });
+
+  server.AddSystem(testSystem.systemPtr);
+
+  // Let the sphere fall for a while.
+  server.Run(true, 100, false);
+  ASSERT_FALSE(spherePoses.empty());
+  EXPECT_LT(spherePoses.back().Pos().Z(), model->RawPose().Pos().Z());
+
+  // Request a reset
+  msgs::WorldControl req;
+  msgs::Boolean res;
+  bool result{false};
+  const unsigned int timeout{5000};
+  req.mutable_reset()->set_all(true);
+
+  transport::Node node;
+  EXPECT_TRUE(node.Request("/world/default/control", req, timeout, res,
+      result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data());
+
+  // Run 2 iterations because control messages are processed in the end of an
+  // update cycle
+  spherePoses.clear();
+  server.Run(true, 2, false);
+
+  // The sphere is back at its initial pose and falls again from there.
+  ASSERT_FALSE(spherePoses.empty());
+  EXPECT_NEAR(spherePoses.back().Pos().Z(), model->RawPose().Pos().Z(), 1e-4);
+}
+
 /////////////////////////////////////////////////
 // This tests whether links with fixed joints keep their relative transforms
 // after physics. For that to work properly, the canonical link implementation
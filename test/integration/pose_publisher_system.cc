@@ -696,3 +696,39 @@ TEST_F(PosePublisherTest, StaticPoseUpdateFrequency)
     EXPECT_NEAR(100.0, freq, 10.0);
   }
 }
+
+/////////////////////////////////////////////////
+TEST_F(PosePublisherTest, PublishOnChange)
+{
+  // Start server
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/pose_publisher.sdf");
+
+  Server server(serverConfig);
+  EXPECT_FALSE(server.Running());
+  EXPECT_FALSE(*server.Running(0));
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    poseMsgs.clear();
+  }
+
+  // subscribe to the pose publisher
+  transport::Node node;
+  node.Subscribe(std::string("/model/test_publish_on_change/pose"), &poseCb);
+
+  // Run server
+  unsigned int iters = 1000u;
+  server.Run(true, iters, false);
+
+  // Wait for the single expected message and make sure no more arrive
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    // The model never moves, so its link pose should be published exactly
+    // once despite the server running many iterations
+    EXPECT_EQ(1u, poseMsgs.size());
+  }
+}
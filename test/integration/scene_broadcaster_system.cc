@@ -18,14 +18,22 @@
 #include <gtest/gtest.h>
 #include <google/protobuf/util/message_differencer.h>
 
+#include <set>
+#include <string>
 #include <thread>
+#include <unordered_set>
 
 #include <ignition/common/Console.hh>
 #include <ignition/transport/Node.hh>
 
+#include "ignition/gazebo/components/Model.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/Server.hh"
 #include "ignition/gazebo/test_config.hh"
 
+#include "../helpers/Relay.hh"
+
 using namespace ignition;
 
 /// \brief Test SceneBroadcaster system
@@ -134,6 +142,81 @@ TEST_P(SceneBroadcasterTest, SceneInfo)
   EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(res, res2));
 }
 
+/////////////////////////////////////////////////
+TEST_P(SceneBroadcasterTest, SceneInfoPaged)
+{
+  // Start server
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  gazebo::Server server(serverConfig);
+  EXPECT_FALSE(server.Running());
+  EXPECT_FALSE(*server.Running(0));
+  EXPECT_EQ(16u, *server.EntityCount());
+
+  // Run server
+  server.Run(true, 1, false);
+
+  // Create requester
+  transport::Node node;
+
+  bool result{false};
+  unsigned int timeout{5000};
+
+  // Full scene for reference
+  ignition::msgs::Scene full;
+  EXPECT_TRUE(node.Request("/world/default/scene/info", timeout, full,
+      result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ(3, full.model_size());
+
+  // First page: models 0 and 1, plus all the lights
+  ignition::msgs::UInt32_V req;
+  req.add_data(0);
+  req.add_data(2);
+
+  ignition::msgs::Scene page1;
+  EXPECT_TRUE(node.Request("/world/default/scene/info/paged", req, timeout,
+      page1, result));
+  EXPECT_TRUE(result);
+
+  EXPECT_EQ(2, page1.model_size());
+  EXPECT_EQ(full.light_size(), page1.light_size());
+
+  // More models remain, so the header points at the next page
+  ASSERT_EQ(1, page1.header().data_size());
+  EXPECT_EQ("next", page1.header().data(0).key());
+  ASSERT_EQ(1, page1.header().data(0).value_size());
+  EXPECT_EQ("2", page1.header().data(0).value(0));
+
+  // Second page: the last model, no lights, no next marker
+  req.set_data(0, 2);
+
+  ignition::msgs::Scene page2;
+  EXPECT_TRUE(node.Request("/world/default/scene/info/paged", req, timeout,
+      page2, result));
+  EXPECT_TRUE(result);
+
+  EXPECT_EQ(1, page2.model_size());
+  EXPECT_EQ(0, page2.light_size());
+  EXPECT_EQ(0, page2.header().data_size());
+
+  // The pages assemble into the full scene
+  std::set<std::string> names;
+  for (auto m = 0; m < page1.model_size(); ++m)
+    names.insert(page1.model(m).name());
+  for (auto m = 0; m < page2.model_size(); ++m)
+    names.insert(page2.model(m).name());
+
+  for (auto m = 0; m < full.model_size(); ++m)
+  {
+    EXPECT_NE(names.end(), names.find(full.model(m).name()));
+    ASSERT_EQ(1, full.model(m).link_size());
+  }
+  EXPECT_EQ(3u, names.size());
+}
+
 /////////////////////////////////////////////////
 TEST_P(SceneBroadcasterTest, SceneGraph)
 {
@@ -360,6 +443,103 @@ TEST_P(SceneBroadcasterTest, State)
   EXPECT_TRUE(received);
 }
 
+/////////////////////////////////////////////////
+TEST_P(SceneBroadcasterTest, StateFiltered)
+{
+  // Start server
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  gazebo::Server server(serverConfig);
+  EXPECT_EQ(16u, *server.EntityCount());
+
+  // Find the box model and its subtree
+  gazebo::Entity boxEntity{gazebo::kNullEntity};
+  std::unordered_set<gazebo::Entity> boxSubtree;
+  gazebo::test::Relay testSystem;
+  testSystem.OnPostUpdate([&](const gazebo::UpdateInfo &,
+      const gazebo::EntityComponentManager &_ecm)
+      {
+        boxEntity = _ecm.EntityByComponents(gazebo::components::Model(),
+            gazebo::components::Name("box"));
+        if (gazebo::kNullEntity != boxEntity)
+          boxSubtree = _ecm.Descendants(boxEntity);
+      });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+  ASSERT_NE(gazebo::kNullEntity, boxEntity);
+  EXPECT_EQ(4u, boxSubtree.size());
+
+  transport::Node node;
+  bool received{false};
+  std::function<void(const msgs::SerializedStepMap &, const bool)> cb;
+
+  // The request is blocking even though it's meant to be async, so we spin a
+  // thread
+  auto runRequest = [&](const msgs::UInt64_V &_req)
+  {
+    received = false;
+    auto request = [&]()
+    {
+      EXPECT_TRUE(node.Request("/world/default/state/filtered", _req, cb));
+    };
+    auto requestThread = std::thread(request);
+
+    unsigned int sleep{0u};
+    unsigned int maxSleep{10u};
+    while (!received && sleep++ < maxSleep)
+    {
+      IGN_SLEEP_MS(100);
+      server.Run(true, 1, false);
+    }
+    EXPECT_TRUE(received);
+    requestThread.join();
+  };
+
+  // Only the box subtree is returned
+  msgs::UInt64_V req;
+  req.add_data(boxEntity);
+  cb = [&](const msgs::SerializedStepMap &_res, const bool _success)
+  {
+    EXPECT_TRUE(_success);
+    ASSERT_TRUE(_res.has_state());
+    EXPECT_EQ(4, _res.state().entities_size());
+    for (const auto &entity : _res.state().entities())
+      EXPECT_NE(boxSubtree.end(), boxSubtree.find(entity.first));
+    received = true;
+  };
+  runRequest(req);
+
+  // Component type filter: only poses come back
+  req.add_data(gazebo::components::Pose::typeId);
+  cb = [&](const msgs::SerializedStepMap &_res, const bool _success)
+  {
+    EXPECT_TRUE(_success);
+    ASSERT_TRUE(_res.has_state());
+    EXPECT_EQ(4, _res.state().entities_size());
+    for (const auto &entity : _res.state().entities())
+    {
+      for (const auto &comp : entity.second.components())
+        EXPECT_EQ(gazebo::components::Pose::typeId, comp.second.type());
+    }
+    received = true;
+  };
+  runRequest(req);
+
+  // Unknown entities produce an empty state, not a timeout
+  msgs::UInt64_V badReq;
+  badReq.add_data(999999u);
+  cb = [&](const msgs::SerializedStepMap &_res, const bool _success)
+  {
+    EXPECT_TRUE(_success);
+    ASSERT_TRUE(_res.has_state());
+    EXPECT_EQ(0, _res.state().entities_size());
+    received = true;
+  };
+  runRequest(badReq);
+}
+
 /////////////////////////////////////////////////
 TEST_P(SceneBroadcasterTest, StateStatic)
 {
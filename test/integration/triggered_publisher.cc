@@ -531,6 +531,31 @@ TEST_F(TriggeredPublisherTest, FieldMatchersAcceptToleranceParam)
   EXPECT_EQ(3u, recvCount);
 }
 
+TEST_F(TriggeredPublisherTest, BatchSizeCoalescesInputsIntoOneOutput)
+{
+  transport::Node node;
+  auto inputPub = node.Advertise<msgs::Empty>("/in_13");
+  std::atomic<std::size_t> recvCount{0};
+  auto msgCb = std::function<void(const msgs::Empty &)>(
+      [&recvCount](const auto &)
+      {
+        ++recvCount;
+      });
+  node.Subscribe("/out_13", msgCb);
+  IGN_SLEEP_MS(100ms);
+
+  const std::size_t pubCount{10};
+  for (std::size_t i = 0; i < pubCount; ++i)
+  {
+    EXPECT_TRUE(inputPub.Publish(msgs::Empty()));
+    IGN_SLEEP_MS(10);
+  }
+
+  // The batch size is 5, so 10 inputs should produce 2 outputs
+  waitUntil(5000, [&]{return 2u == recvCount;});
+  EXPECT_EQ(2u, recvCount);
+}
+
 TEST_F(TriggeredPublisherTest, SubfieldsOfRepeatedFieldsNotSupported)
 {
   transport::Node node;
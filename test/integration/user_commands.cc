@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 
 #include <ignition/msgs/entity_factory.pb.h>
+#include <ignition/msgs/pose_v.pb.h>
 
 #include <ignition/common/Console.hh>
 #include <ignition/math/Pose3.hh>
@@ -25,9 +26,12 @@
 
 #include "ignition/gazebo/components/Light.hh"
 #include "ignition/gazebo/components/Link.hh"
+#include "ignition/gazebo/components/Material.hh"
 #include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/components/Visual.hh"
 #include "ignition/gazebo/Server.hh"
 #include "ignition/gazebo/SystemLoader.hh"
 #include "ignition/gazebo/test_config.hh"
@@ -311,6 +315,118 @@ TEST_F(UserCommandsTest, Create)
       components::Name("test_model")));
 }
 
+/////////////////////////////////////////////////
+TEST_F(UserCommandsTest, Patch)
+{
+  // Start server
+  ServerConfig serverConfig;
+  const auto sdfFile = std::string(PROJECT_SOURCE_PATH) +
+    "/examples/worlds/empty.sdf";
+  serverConfig.SetSdfFile(sdfFile);
+
+  Server server(serverConfig);
+
+  // Create a system just to get the ECM
+  EntityComponentManager *ecm{nullptr};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const gazebo::UpdateInfo &,
+                             gazebo::EntityComponentManager &_ecm)
+      {
+        ecm = &_ecm;
+      });
+
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+  ASSERT_NE(nullptr, ecm);
+
+  auto modelStr = std::string("<?xml version=\"1.0\" ?>") +
+      "<sdf version='1.6'>" +
+      "<model name='patched_model'>" +
+      "<pose>0 0 0.5 0 0 0</pose>" +
+      "<link name='link'>" +
+      "<visual name='visual'>" +
+      "<geometry><box><size>1 1 1</size></box></geometry>" +
+      "<material><diffuse>1 0 0 1</diffuse></material>" +
+      "</visual>" +
+      "<collision name='collision'>" +
+      "<geometry><box><size>1 1 1</size></box></geometry>" +
+      "</collision>" +
+      "</link>" +
+      "</model>" +
+      "</sdf>";
+
+  // Spawn the model
+  msgs::EntityFactory req;
+  req.set_sdf(modelStr);
+
+  msgs::Boolean res;
+  bool result;
+  unsigned int timeout = 5000;
+
+  transport::Node node;
+  EXPECT_TRUE(node.Request("/world/empty/create", req, timeout, res, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data());
+
+  server.Run(true, 1, false);
+
+  auto model = ecm->EntityByComponents(components::Model(),
+      components::Name("patched_model"));
+  ASSERT_NE(kNullEntity, model);
+
+  auto link = ecm->EntityByComponents(components::Name("link"),
+      components::ParentEntity(model));
+  ASSERT_NE(kNullEntity, link);
+
+  auto visual = ecm->EntityByComponents(components::Name("visual"),
+      components::ParentEntity(link), components::Visual());
+  ASSERT_NE(kNullEntity, visual);
+
+  // Patch the model: new pose and a new diffuse color, same structure
+  auto patchStr = std::string("<?xml version=\"1.0\" ?>") +
+      "<sdf version='1.6'>" +
+      "<model name='patched_model'>" +
+      "<pose>0 0 5 0 0 0</pose>" +
+      "<link name='link'>" +
+      "<visual name='visual'>" +
+      "<geometry><box><size>1 1 1</size></box></geometry>" +
+      "<material><diffuse>0 1 0 1</diffuse></material>" +
+      "</visual>" +
+      "<collision name='collision'>" +
+      "<geometry><box><size>1 1 1</size></box></geometry>" +
+      "</collision>" +
+      "</link>" +
+      "</model>" +
+      "</sdf>";
+
+  req.Clear();
+  req.set_sdf(patchStr);
+
+  EXPECT_TRUE(node.Request("/world/empty/patch", req, timeout, res, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data());
+
+  // Run a couple of iterations so the patch executes and physics applies
+  // the pose command
+  server.Run(true, 2, false);
+
+  // The model and visual entities didn't churn
+  EXPECT_EQ(model, ecm->EntityByComponents(components::Model(),
+      components::Name("patched_model")));
+  EXPECT_EQ(visual, ecm->EntityByComponents(components::Name("visual"),
+      components::ParentEntity(link), components::Visual()));
+
+  // The pose was applied through the pose command
+  auto poseComp = ecm->Component<components::Pose>(model);
+  ASSERT_NE(nullptr, poseComp);
+  EXPECT_NEAR(5.0, poseComp->Data().Pos().Z(), 0.1);
+
+  // The material was updated in place
+  auto materialComp = ecm->Component<components::Material>(visual);
+  ASSERT_NE(nullptr, materialComp);
+  EXPECT_EQ(math::Color(0, 1, 0), materialComp->Data().Diffuse());
+}
+
 /////////////////////////////////////////////////
 TEST_F(UserCommandsTest, Remove)
 {
@@ -671,3 +787,73 @@ TEST_F(UserCommandsTest, Pose)
   ASSERT_NE(nullptr, poseComp);
   EXPECT_NEAR(500.0, poseComp->Data().Pos().Y(), 0.2);
 }
+
+/////////////////////////////////////////////////
+TEST_F(UserCommandsTest, PoseVector)
+{
+  // Start server
+  ServerConfig serverConfig;
+  const auto sdfFile = std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/shapes.sdf";
+  serverConfig.SetSdfFile(sdfFile);
+
+  Server server(serverConfig);
+  EXPECT_FALSE(server.Running());
+  EXPECT_FALSE(*server.Running(0));
+
+  // Create a system just to get the ECM
+  EntityComponentManager *ecm{nullptr};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const gazebo::UpdateInfo &,
+                             gazebo::EntityComponentManager &_ecm)
+      {
+        ecm = &_ecm;
+      });
+
+  server.AddSystem(testSystem.systemPtr);
+
+  // Run server and check we have the ECM
+  EXPECT_EQ(nullptr, ecm);
+  server.Run(true, 1, false);
+  EXPECT_NE(nullptr, ecm);
+
+  // Move two entities with a single request
+  msgs::Pose_V req;
+  auto boxPose = req.add_pose();
+  boxPose->set_name("box");
+  boxPose->mutable_position()->set_y(123.0);
+  auto spherePose = req.add_pose();
+  spherePose->set_name("sphere");
+  spherePose->mutable_position()->set_y(456.0);
+
+  msgs::Boolean res;
+  bool result;
+  unsigned int timeout = 5000;
+  std::string service{"/world/default/set_pose_vector"};
+
+  transport::Node node;
+  EXPECT_TRUE(node.Request(service, req, timeout, res, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data());
+
+  auto boxEntity = ecm->EntityByComponents(components::Name("box"));
+  EXPECT_NE(kNullEntity, boxEntity);
+  auto sphereEntity = ecm->EntityByComponents(components::Name("sphere"));
+  EXPECT_NE(kNullEntity, sphereEntity);
+
+  // Check entities have not been moved yet
+  auto poseComp = ecm->Component<components::Pose>(boxEntity);
+  ASSERT_NE(nullptr, poseComp);
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 1), poseComp->Data());
+
+  // Run an iteration and check both were moved
+  server.Run(true, 1, false);
+
+  poseComp = ecm->Component<components::Pose>(boxEntity);
+  ASSERT_NE(nullptr, poseComp);
+  EXPECT_NEAR(123.0, poseComp->Data().Pos().Y(), 0.2);
+
+  poseComp = ecm->Component<components::Pose>(sphereEntity);
+  ASSERT_NE(nullptr, poseComp);
+  EXPECT_NEAR(456.0, poseComp->Data().Pos().Y(), 0.2);
+}
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+# Copyright (C) 2020 Open Source Robotics Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Diff two state checksum logs and pinpoint the first divergence.
+
+The server writes one line per unpaused step with a checksum of every
+component type that changed during the step (see
+ServerConfig::SetStateChecksumPath, or set the
+IGN_GAZEBO_STATE_CHECKSUM_PATH environment variable). Run the same world
+twice, then:
+
+    ./diff_state_checksums.py run_a.txt run_b.txt
+
+Identical runs produce identical logs. On divergence the tool reports
+the first differing step and the component types whose checksums differ,
+which is usually enough to name the system that stopped being
+deterministic.
+"""
+
+import argparse
+import sys
+
+
+def parse_log(path):
+    """Parse a checksum log.
+
+    Returns (steps, names): steps is a list of (iteration, {type: sum})
+    in file order, names maps component type ids to registered names.
+    """
+    steps = []
+    names = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            if line.startswith('#'):
+                fields = line.split(None, 3)
+                if len(fields) == 4 and fields[1] == 'type':
+                    names[int(fields[2])] = fields[3]
+                continue
+            fields = line.split()
+            sums = {}
+            for pair in fields[1:]:
+                type_id, _, checksum = pair.partition(':')
+                sums[int(type_id)] = checksum
+            steps.append((int(fields[0]), sums))
+    return steps, names
+
+
+def type_name(type_id, names):
+    return names.get(type_id, 'unknown type %d' % type_id)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('log_a', help='checksum log from the first run')
+    parser.add_argument('log_b', help='checksum log from the second run')
+    args = parser.parse_args()
+
+    steps_a, names_a = parse_log(args.log_a)
+    steps_b, names_b = parse_log(args.log_b)
+    names = dict(names_a)
+    names.update(names_b)
+
+    for (it_a, sums_a), (it_b, sums_b) in zip(steps_a, steps_b):
+        if it_a != it_b:
+            print('Step sequences diverge: iteration %d vs %d. Were both '
+                  'runs stepped the same way?' % (it_a, it_b))
+            return 1
+        if sums_a == sums_b:
+            continue
+        print('First divergence at iteration %d:' % it_a)
+        for type_id in sorted(set(sums_a) | set(sums_b)):
+            a = sums_a.get(type_id)
+            b = sums_b.get(type_id)
+            if a == b:
+                continue
+            print('  %s (type %d): %s vs %s' %
+                  (type_name(type_id, names), type_id,
+                   a or 'not changed', b or 'not changed'))
+        return 1
+
+    if len(steps_a) != len(steps_b):
+        print('Runs are identical over the common %d steps, but one log '
+              'has %d steps and the other %d.' %
+              (min(len(steps_a), len(steps_b)), len(steps_a), len(steps_b)))
+        return 1
+
+    print('Runs are identical over %d steps.' % len(steps_a))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())